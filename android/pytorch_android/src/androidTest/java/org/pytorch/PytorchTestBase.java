@@ -7,6 +7,7 @@ import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertTrue;
 
 import java.io.IOException;
+import java.nio.FloatBuffer;
 import java.util.HashMap;
 import java.util.Map;
 import org.junit.Test;
@@ -229,6 +230,29 @@ public abstract class PytorchTestBase {
     }
   }
 
+  @Test
+  public void testTensorDataBufferNoCopy() {
+    long[] shape = new long[] {2, 3};
+    final int numel = (int) Tensor.numel(shape);
+    final FloatBuffer inputBuffer = Tensor.allocateFloatBuffer(numel);
+    for (int i = 0; i < numel; i++) {
+      inputBuffer.put(i, i / 10.f);
+    }
+
+    Tensor tensor = Tensor.fromBlob(inputBuffer, shape);
+    FloatBuffer outputBuffer = tensor.getDataAsFloatBuffer();
+    assertTrue(outputBuffer.isDirect());
+    for (int i = 0; i < numel; i++) {
+      assertTrue(outputBuffer.get(i) == i / 10.f);
+    }
+
+    // The buffer aliases the tensor memory, so writes are visible both ways.
+    outputBuffer.put(0, 42.f);
+    assertTrue(tensor.getDataAsFloatArray()[0] == 42.f);
+    inputBuffer.put(1, 43.f);
+    assertTrue(outputBuffer.get(1) == 43.f);
+  }
+
   @Test(expected = IllegalStateException.class)
   public void testTensorIllegalStateOnWrongType() {
     long[] shape = new long[] {1, 3, 224, 224};
@@ -20,7 +20,8 @@ import java.util.Locale;
  * to allocate buffers properly.
  *
  * <p>To access Tensor data, see {@link #dtype()}, {@link #shape()}, and various {@code getDataAs*}
- * methods.
+ * methods. The {@code getDataAs*Array} methods copy the data into a Java array; the {@code
+ * getDataAs*Buffer} methods return a direct buffer view of the tensor memory without copying.
  *
  * <p>When constructing {@code Tensor} objects with {@code data} as an array, it is not specified
  * whether this data is is copied or retained as a reference so it is recommended not to modify it
@@ -417,6 +418,69 @@ public abstract class Tensor {
         "Tensor of type " + getClass().getSimpleName() + " cannot return data as double array.");
   }
 
+  /**
+   * @return a direct buffer view of the tensor data, without copying. For tensors returned from a
+   *     {@link Module} call this is a view of the native tensor memory; it stays valid only while
+   *     this {@code Tensor} is referenced, and subsequent calls to the same {@code Module} may
+   *     reuse the memory. Copy the data out (e.g. {@link #getDataAsByteArray()}) if it must outlive
+   *     the tensor or the next call. The returned buffer has its own position and limit.
+   * @throws IllegalStateException if it is called for a non-int8 tensor.
+   */
+  public ByteBuffer getDataAsByteBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as byte buffer.");
+  }
+
+  /**
+   * @return a direct buffer view of the tensor data, without copying. See {@link
+   *     #getDataAsByteBuffer()} for the lifetime of the view.
+   * @throws IllegalStateException if it is called for a non-uint8 tensor.
+   */
+  public ByteBuffer getDataAsUnsignedByteBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as byte buffer.");
+  }
+
+  /**
+   * @return a direct buffer view of the tensor data, without copying. See {@link
+   *     #getDataAsByteBuffer()} for the lifetime of the view.
+   * @throws IllegalStateException if it is called for a non-int32 tensor.
+   */
+  public IntBuffer getDataAsIntBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as int buffer.");
+  }
+
+  /**
+   * @return a direct buffer view of the tensor data, without copying. See {@link
+   *     #getDataAsByteBuffer()} for the lifetime of the view.
+   * @throws IllegalStateException if it is called for a non-float32 tensor.
+   */
+  public FloatBuffer getDataAsFloatBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as float buffer.");
+  }
+
+  /**
+   * @return a direct buffer view of the tensor data, without copying. See {@link
+   *     #getDataAsByteBuffer()} for the lifetime of the view.
+   * @throws IllegalStateException if it is called for a non-int64 tensor.
+   */
+  public LongBuffer getDataAsLongBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as long buffer.");
+  }
+
+  /**
+   * @return a direct buffer view of the tensor data, without copying. See {@link
+   *     #getDataAsByteBuffer()} for the lifetime of the view.
+   * @throws IllegalStateException if it is called for a non-float64 tensor.
+   */
+  public DoubleBuffer getDataAsDoubleBuffer() {
+    throw new IllegalStateException(
+        "Tensor of type " + getClass().getSimpleName() + " cannot return data as double buffer.");
+  }
+
   @DoNotStrip
   Buffer getRawDataBuffer() {
     throw new IllegalStateException(
@@ -449,6 +513,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public ByteBuffer getDataAsUnsignedByteBuffer() {
+      ByteBuffer buffer = data.duplicate().order(ByteOrder.nativeOrder());
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public String toString() {
       return String.format("Tensor(%s, dtype=torch.uint8)", Arrays.toString(shape));
@@ -481,6 +552,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public ByteBuffer getDataAsByteBuffer() {
+      ByteBuffer buffer = data.duplicate().order(ByteOrder.nativeOrder());
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public String toString() {
       return String.format("Tensor(%s, dtype=torch.int8)", Arrays.toString(shape));
@@ -513,6 +591,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public IntBuffer getDataAsIntBuffer() {
+      IntBuffer buffer = data.duplicate();
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public String toString() {
       return String.format("Tensor(%s, dtype=torch.int32)", Arrays.toString(shape));
@@ -535,6 +620,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public FloatBuffer getDataAsFloatBuffer() {
+      FloatBuffer buffer = data.duplicate();
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public DType dtype() {
       return DType.FLOAT32;
@@ -577,6 +669,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public LongBuffer getDataAsLongBuffer() {
+      LongBuffer buffer = data.duplicate();
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public String toString() {
       return String.format("Tensor(%s, dtype=torch.int64)", Arrays.toString(shape));
@@ -609,6 +708,13 @@ public abstract class Tensor {
       return arr;
     }
 
+    @Override
+    public DoubleBuffer getDataAsDoubleBuffer() {
+      DoubleBuffer buffer = data.duplicate();
+      buffer.rewind();
+      return buffer;
+    }
+
     @Override
     public String toString() {
       return String.format("Tensor(%s, dtype=torch.float64)", Arrays.toString(shape));
@@ -1,5 +1,7 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Functions.h>
+#include <c10/core/Event.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
 
 #include <iostream>
 #include <sstream>
@@ -148,20 +150,61 @@ ScalarType toScalarType(const DLDataType& dtype) {
   return stype;
 }
 
+// Makes `consumer` wait for all work currently enqueued on `producer`
+// without synchronizing the host. This is the zero-copy handoff primitive
+// for stream-aware DLPack exchange: a recorded event instead of a
+// cudaDeviceSynchronize.
+static void joinStreams(const c10::Stream& producer, const c10::Stream& consumer) {
+  if (producer == consumer) {
+    return;
+  }
+  c10::Event event(producer.device_type());
+  event.record(producer);
+  event.block(consumer);
+}
+
 struct ATenDLMTensor {
   Tensor handle;
+  // Set by the stream-aware toDLPack overload so the deleter can fence the
+  // consumer's pending work back to the stream that produced the tensor.
+  c10::optional<c10::Stream> producer_stream;
+  c10::optional<c10::Stream> consumer_stream;
   DLManagedTensor tensor;
 };
 
 void deleter(DLManagedTensor* arg) {
-  delete static_cast<ATenDLMTensor*>(arg->manager_ctx);
+  auto* owner = static_cast<ATenDLMTensor*>(arg->manager_ctx);
+  // The consumer calls the deleter when it no longer needs the tensor, but
+  // work it enqueued on its stream may still be in flight. Record an event
+  // on the consumer stream and make the producer stream wait on it, so the
+  // storage cannot be reused before the consumer's kernels have finished.
+  if (owner->consumer_stream) {
+    joinStreams(*owner->consumer_stream, *owner->producer_stream);
+  }
+  delete owner;
 }
 
 // This function returns a shared_ptr to memory managed DLpack tensor
 // constructed out of ATen tensor
 DLManagedTensor* toDLPack(const Tensor& src) {
+  return toDLPack(src, c10::nullopt);
+}
+
+DLManagedTensor* toDLPack(
+    const Tensor& src,
+    c10::optional<c10::Stream> consumer_stream) {
   ATenDLMTensor* atDLMTensor(new ATenDLMTensor);
   atDLMTensor->handle = src;
+  if (consumer_stream.has_value() && src.is_cuda()) {
+    // Producer handoff: the consumer's stream waits for everything this
+    // side has queued on the tensor's current stream; neither side blocks
+    // the host.
+    c10::impl::VirtualGuardImpl impl(src.device().type());
+    c10::Stream producer_stream = impl.getStream(src.device());
+    joinStreams(producer_stream, *consumer_stream);
+    atDLMTensor->producer_stream = producer_stream;
+    atDLMTensor->consumer_stream = consumer_stream;
+  }
   atDLMTensor->tensor.manager_ctx = atDLMTensor;
   atDLMTensor->tensor.deleter = &deleter;
   atDLMTensor->tensor.dl_tensor.data = src.data_ptr();
@@ -200,4 +243,17 @@ Tensor fromDLPack(const DLManagedTensor* src) {
       deleter,
       at::device(device).dtype(stype));
 }
+
+Tensor fromDLPack(
+    const DLManagedTensor* src,
+    c10::optional<c10::Stream> producer_stream) {
+  Device device = getATenDevice(src->dl_tensor.ctx);
+  if (producer_stream.has_value() && device.is_cuda()) {
+    // Consumer handoff: our current stream waits for the producer's pending
+    // work before any kernel here may touch the shared storage.
+    c10::impl::VirtualGuardImpl impl(device.type());
+    joinStreams(*producer_stream, impl.getStream(device));
+  }
+  return fromDLPack(src);
+}
 } // namespace at
@@ -3,6 +3,7 @@
 #include <ATen/Tensor.h>
 #include <ATen/ATen.h>
 #include <ATen/dlpack.h>
+#include <c10/core/Stream.h>
 
 // this convertor will:
 // 1) take a Tensor object and wrap it in the DLPack tensor
@@ -12,7 +13,22 @@ namespace at {
 
 CAFFE2_API ScalarType toScalarType(const DLDataType& dtype);
 CAFFE2_API DLManagedTensor* toDLPack(const Tensor& src);
+// Stream-aware export: makes `consumer_stream` wait (on-device, via a
+// recorded event) for all producer-side work on `src` that is pending on
+// its current stream, and fences the consumer's work back to the producer
+// stream when the returned capsule's deleter runs. The consumer may then
+// use the tensor on `consumer_stream` with no host synchronization and no
+// copy. Only meaningful for devices with streams; on CPU it behaves like
+// the plain overload.
+CAFFE2_API DLManagedTensor* toDLPack(
+    const Tensor& src,
+    c10::optional<c10::Stream> consumer_stream);
 CAFFE2_API Tensor fromDLPack(const DLManagedTensor* src);
+// Stream-aware import: the current stream of the tensor's device waits for
+// work the producer enqueued on `producer_stream` before the handoff.
+CAFFE2_API Tensor fromDLPack(
+    const DLManagedTensor* src,
+    c10::optional<c10::Stream> producer_stream);
 CAFFE2_API DLDataType getDLDataType(const Tensor& t);
 CAFFE2_API DLContext getDLContext(const Tensor& tensor, const int64_t& device_id);
 
@@ -2,6 +2,9 @@
 
 #include <ATen/Parallel.h>
 #include <c10/core/thread_pool.h>
+#include <c10/util/numa.h>
+
+#include <atomic>
 
 namespace at {
 
@@ -10,8 +13,22 @@ public:
   explicit PTThreadPool(
       int pool_size,
       int numa_node_id = -1)
-    : c10::ThreadPool(pool_size, numa_node_id, [](){
+    : c10::ThreadPool(pool_size, numa_node_id, [numa_node_id](){
         c10::setThreadName("PTThreadPool");
+        if (numa_node_id >= 0) {
+          c10::NUMABind(numa_node_id);
+        } else if (c10::IsNUMAEnabled()) {
+          // No explicit node requested: spread the workers round-robin
+          // across the NUMA nodes. alloc_cpu moves fresh pages to the
+          // calling thread's node, so a pinned worker gets first-touch
+          // locality for the tensors it fills instead of whatever
+          // interleave the scheduler's thread migration produces.
+          const int num_nodes = c10::GetNumNUMANodes();
+          if (num_nodes > 1) {
+            static std::atomic<int> next_node{0};
+            c10::NUMABind(next_node++ % num_nodes);
+          }
+        }
         at::init_num_threads();
       }) {}
 };
@@ -32,6 +32,44 @@ CAFFE2_API int get_thread_num();
 // Checks whether the code runs in parallel region
 CAFFE2_API bool in_parallel_region();
 
+// Returns the default grain size (number of elements per task) used when a
+// parallel_for/parallel_reduce caller does not provide one: the calibrated
+// or user-set value if any, internal::GRAIN_SIZE otherwise
+CAFFE2_API int64_t default_grain_size();
+
+// Overrides the default grain size; pass 0 to restore internal::GRAIN_SIZE
+CAFFE2_API void set_grain_size(int64_t grain_size);
+
+// Measures the fork/join overhead of the parallel backend and the
+// throughput of a reference elementwise loop on this machine, and sets the
+// default grain size so that a task's work amortizes the overhead;
+// returns the new default grain size
+CAFFE2_API int64_t calibrate_grain_size();
+
+namespace internal {
+// Grain size for a kernel whose per-element work is roughly `relative_cost`
+// times that of a vectorizable elementwise op. Centralizes the ad-hoc
+// GRAIN_SIZE / cost divisions in the cpu kernels and picks up a calibrated
+// default grain size when one is set.
+inline int64_t grain_size_for_cost(int64_t relative_cost) {
+  return std::max(
+      at::default_grain_size() / std::max(relative_cost, (int64_t)1),
+      (int64_t)1);
+}
+} // namespace internal
+
+// Restricts the intra-op thread pool workers (and, on first parallel use,
+// the calling thread) to the given NUMA node so that parallel regions and
+// their first-touched pages stay on one socket; -1 removes the restriction.
+// Like set_num_threads, it only takes effect before the first parallel work
+// is executed; only supported by the native parallel backend with NUMA
+// support, a no-op otherwise.
+CAFFE2_API void set_intraop_numa_node(int node);
+
+// Returns the NUMA node the intra-op thread pool is restricted to,
+// or -1 if unrestricted
+CAFFE2_API int get_intraop_numa_node();
+
 /*
 parallel_for
 
@@ -115,6 +153,20 @@ CAFFE2_API int get_num_interop_threads();
 // Launches inter-op parallel task
 CAFFE2_API void launch(std::function<void()> func);
 
+// Launches inter-op parallel task, returns a future completed when the task
+// finishes (or fails; the error is propagated through the future).
+// Continuations added via Future::addCallback run inline on the completing
+// thread, or immediately if the future is already done.
+CAFFE2_API std::shared_ptr<c10::ivalue::Future> launch_future(
+    std::function<void()> func);
+
+// Blocks until `future` completes, running pending inter-op tasks on the
+// calling thread while it waits. Use this instead of Future::wait when
+// waiting from inside an inter-op task, so that high fan-out fork/join
+// patterns cannot park every pool thread on a future.
+CAFFE2_API void wait_for_future(
+    const std::shared_ptr<c10::ivalue::Future>& future);
+
 // Launches intra-op parallel task
 CAFFE2_API void intraop_launch(std::function<void()> func);
 
@@ -4,8 +4,11 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 #ifdef TH_BLAS_MKL
 #include <mkl.h>
@@ -40,8 +43,67 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+// Calibrated/user-set default grain size; 0 means internal::GRAIN_SIZE.
+std::atomic<int64_t> user_grain_size{0};
+
 } // namespace
 
+int64_t default_grain_size() {
+  int64_t grain_size = user_grain_size.load(std::memory_order_relaxed);
+  return grain_size > 0 ? grain_size : internal::GRAIN_SIZE;
+}
+
+void set_grain_size(int64_t grain_size) {
+  TORCH_CHECK(grain_size >= 0, "Expected a non-negative grain size");
+  user_grain_size.store(grain_size, std::memory_order_relaxed);
+}
+
+int64_t calibrate_grain_size() {
+  using clock = std::chrono::steady_clock;
+
+  // measure the fork/join overhead of a parallel region; the first region
+  // also warms up the thread pool and is not timed
+  std::atomic<int64_t> sink{0};
+  auto fork_join = [&]() {
+    at::parallel_for(0, at::get_num_threads(), 1, [&](int64_t begin, int64_t end) {
+      sink.fetch_add(end - begin, std::memory_order_relaxed);
+    });
+  };
+  fork_join();
+  constexpr int64_t fork_reps = 50;
+  auto fork_start = clock::now();
+  for (int64_t i = 0; i < fork_reps; i++) {
+    fork_join();
+  }
+  const double fork_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::now() - fork_start).count() / (double)fork_reps;
+
+  // measure the throughput of a reference elementwise loop
+  std::vector<float> buf(internal::GRAIN_SIZE, 1.0f);
+  constexpr int64_t loop_reps = 20;
+  auto loop_start = clock::now();
+  for (int64_t rep = 0; rep < loop_reps; rep++) {
+    for (size_t i = 0; i < buf.size(); i++) {
+      buf[i] = buf[i] * 0.9f + 0.1f;
+    }
+  }
+  const double elem_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::now() - loop_start).count() /
+      (double)(loop_reps * internal::GRAIN_SIZE);
+  volatile float guard = buf[0] + buf[buf.size() - 1]; // keep the loop alive
+  (void)guard;
+
+  // pick the grain size so that a task's work keeps the per-task overhead
+  // around or below 1%, clamped to a sane range
+  int64_t grain_size = internal::GRAIN_SIZE;
+  if (elem_ns > 0) {
+    grain_size = static_cast<int64_t>(100.0 * fork_ns / elem_ns);
+    grain_size = std::max((int64_t)1024, std::min(grain_size, (int64_t)1 << 22));
+  }
+  set_grain_size(grain_size);
+  return grain_size;
+}
+
 std::string get_parallel_info() {
   std::ostringstream ss;
 
@@ -49,6 +111,14 @@ std::string get_parallel_info() {
      << at::get_num_threads() << std::endl;
   ss << "\tat::get_num_interop_threads() : "
      << at::get_num_interop_threads() << std::endl;
+  if (at::default_grain_size() != internal::GRAIN_SIZE) {
+    ss << "\tat::default_grain_size() : "
+       << at::default_grain_size() << std::endl;
+  }
+  if (at::get_intraop_numa_node() >= 0) {
+    ss << "\tat::get_intraop_numa_node() : "
+       << at::get_intraop_numa_node() << std::endl;
+  }
 
   ss << at::get_openmp_version() << std::endl;
 #ifdef _OPENMP
@@ -65,6 +135,8 @@ std::string get_parallel_info() {
   ss << "std::thread::hardware_concurrency() : "
      << std::thread::hardware_concurrency() << std::endl;
 
+  ss << "Thread budget: " << c10::GetThreadBudget() << std::endl;
+
   ss << "Environment variables:" << std::endl;
   ss << "\tOMP_NUM_THREADS : "
      << get_env_var("OMP_NUM_THREADS", "[not set]") << std::endl;
@@ -101,7 +173,7 @@ int intraop_default_num_threads() {
   size_t nthreads = get_env_num_threads("OMP_NUM_THREADS", 0);
   nthreads = get_env_num_threads("MKL_NUM_THREADS", nthreads);
   if (nthreads == 0) {
-    nthreads = TaskThreadPoolBase::defaultNumThreads();
+    nthreads = c10::GetBudgetedNumThreads("intraop", /* default_share */ 1.0);
   }
   return nthreads;
 #endif
@@ -55,6 +55,11 @@ const int CONSUMED = -2;
 //  - CONSUMED - pool is initialized
 std::atomic<int> num_intraop_threads{NOT_SET};
 
+// NUMA node the intra-op pool is restricted to, -1 means unrestricted.
+// Follows the same lifecycle as num_intraop_threads: it can only be
+// changed before the pool is created.
+std::atomic<int> intraop_numa_node{-1};
+
 int _num_pool_threads(int nthreads) {
   if (nthreads == NOT_SET) {
     nthreads = intraop_default_num_threads();
@@ -67,11 +72,21 @@ int _num_pool_threads(int nthreads) {
 
 TaskThreadPoolBase& _get_intraop_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
-          /* create_new */ true); // create a separate thread pool for intra-op
+      []() -> std::shared_ptr<TaskThreadPoolBase> {
+    int pool_size = _num_pool_threads(num_intraop_threads.exchange(CONSUMED));
+    int numa_node = intraop_numa_node.load();
+    if (numa_node >= 0) {
+      // the registry creator cannot pass a node through, construct directly;
+      // also bind the caller: it runs the first task of every parallel region
+      c10::NUMABind(numa_node);
+      return std::make_shared<PTThreadPool>(pool_size, numa_node);
+    }
+    return ThreadPoolRegistry()->Create(
+        "C10",
+        /* device_id */ 0,
+        /* pool_size */ pool_size,
+        /* create_new */ true); // create a separate thread pool for intra-op
+  }();
   return *pool;
 }
 
@@ -209,6 +224,33 @@ void set_num_threads(int nthreads) {
 #endif // C10_MOBILE
 }
 
+void set_intraop_numa_node(int node) {
+#ifndef C10_MOBILE
+  TORCH_CHECK(node >= -1, "Expected a NUMA node id or -1, got ", node);
+  if (node >= 0 && !c10::IsNUMAEnabled()) {
+    TORCH_WARN("set_intraop_numa_node: NUMA is not enabled, ignoring");
+    return;
+  }
+  if (num_intraop_threads.load() == CONSUMED) {
+    TORCH_WARN(
+      "Cannot set intra-op NUMA node after parallel work "
+      "has started when using native parallel backend");
+    return;
+  }
+  intraop_numa_node.store(node);
+#else
+  TORCH_CHECK(false, "set_intraop_numa_node is not supported for mobile.");
+#endif // C10_MOBILE
+}
+
+int get_intraop_numa_node() {
+#ifndef C10_MOBILE
+  return intraop_numa_node.load();
+#else
+  return -1;
+#endif // C10_MOBILE
+}
+
 int get_num_threads() {
 #ifndef C10_MOBILE
   // not initializing pool unnecessarily,
@@ -64,6 +64,17 @@ void set_num_threads(int nthreads) {
   _internal_set_num_threads(nthreads);
 }
 
+void set_intraop_numa_node(int node) {
+  if (node != -1) {
+    TORCH_WARN(
+      "set_intraop_numa_node is not supported with TBB parallel backend");
+  }
+}
+
+int get_intraop_numa_node() {
+  return -1;
+}
+
 int get_num_threads() {
   return tbb::this_task_arena::max_concurrency();
 }
@@ -50,6 +50,17 @@ void set_num_threads(int nthreads) {
 #endif
 }
 
+void set_intraop_numa_node(int node) {
+  if (node != -1) {
+    TORCH_WARN(
+      "set_intraop_numa_node is not supported with OpenMP parallel backend");
+  }
+}
+
+int get_intraop_numa_node() {
+  return -1;
+}
+
 // Explicitly calling omp_get_max_threads() as the size of the parallel
 // region might be different in the new thread;
 // Use init_num_threads() during thread initialization to ensure
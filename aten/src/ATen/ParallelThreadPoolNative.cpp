@@ -4,6 +4,9 @@
 #include <ATen/ThreadLocalState.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace at {
 
@@ -21,12 +24,19 @@ std::atomic<int> num_interop_threads{NOT_SET};
 // thread pool global instance is hidden,
 // users should use at::launch and get/set_num_interop_threads interface
 TaskThreadPoolBase& get_pool() {
-  static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ num_interop_threads.exchange(CONSUMED),
-          /* create_new */ true);
+  static std::shared_ptr<TaskThreadPoolBase> pool = []() {
+    int pool_size = num_interop_threads.exchange(CONSUMED);
+    if (pool_size < 0) {
+      // No explicit size was requested; take the inter-op share of the
+      // process-wide thread budget.
+      pool_size = c10::GetBudgetedNumThreads("interop", /* default_share */ 1.0);
+    }
+    return ThreadPoolRegistry()->Create(
+        "C10",
+        /* device_id */ 0,
+        /* pool_size */ pool_size,
+        /* create_new */ true);
+  }();
   return *pool;
 }
 
@@ -61,7 +71,7 @@ int get_num_interop_threads() {
     return nthreads;
   } else if (nthreads == NOT_SET) {
     // return default value
-    return TaskThreadPoolBase::defaultNumThreads();
+    return c10::GetBudgetedNumThreads("interop", /* default_share */ 1.0);
   } else {
     return get_pool().size();
   }
@@ -84,5 +94,50 @@ void launch(std::function<void()> func) {
 #endif
 }
 
+std::shared_ptr<c10::ivalue::Future> launch_future(
+    std::function<void()> func) {
+  auto future = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
+  launch([func, future]() {
+    try {
+      func();
+      future->markCompleted();
+    } catch (const std::exception& e) {
+      future->setError(e.what());
+    } catch (...) {
+      future->setError("Unknown error in launch_future task");
+    }
+  });
+  return future;
+}
+
+void wait_for_future(
+    const std::shared_ptr<c10::ivalue::Future>& future) {
+  TORCH_CHECK(future, "Expected a future to wait on");
+  // Shared so that a completion callback firing after we return cannot
+  // outlive the condition variable it notifies.
+  struct Sync {
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+  auto sync = std::make_shared<Sync>();
+  future->addCallback([sync]() {
+    std::lock_guard<std::mutex> lock(sync->mutex);
+    sync->cv.notify_all();
+  });
+
+  auto& pool = get_pool();
+  while (!future->completed()) {
+    if (pool.tryRunTask()) {
+      continue;
+    }
+    // Nothing runnable right now; park briefly and re-check for newly
+    // submitted work so we can keep helping the pool.
+    std::unique_lock<std::mutex> lock(sync->mutex);
+    sync->cv.wait_for(lock, std::chrono::milliseconds(1), [&future]() {
+      return future->completed();
+    });
+  }
+}
+
 } // namespace at
 #endif
@@ -5,6 +5,7 @@
 #include <c10/util/TypeList.h>
 #include <c10/util/intrusive_ptr.h>
 #include <c10/util/ArrayRef.h>
+#include <c10/util/FreeList.h>
 #include <c10/util/Optional.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <vector>
@@ -34,6 +35,17 @@ struct ListImpl final : public c10::intrusive_ptr_target {
   intrusive_ptr<ListImpl> copy() const {
     return make_intrusive<ListImpl>(list, elementType);
   }
+
+  // Lists are built and torn down at interpreter rate; the impl node is
+  // fixed-size, so recycle it through a per-thread free list and only pay
+  // the allocator for the element buffer.
+  static void* operator new(std::size_t) {
+    return FreeList<ListImpl>::get().allocate();
+  }
+  static void operator delete(void* ptr) {
+    FreeList<ListImpl>::get().deallocate(ptr);
+  }
+
   friend TORCH_API bool operator==(const ListImpl& lhs, const ListImpl& rhs);
 };
 }
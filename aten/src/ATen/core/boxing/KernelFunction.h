@@ -35,6 +35,16 @@ public:
   bool isValid() const;
   bool isFallthrough() const;
 
+  /**
+   * Returns true iff this kernel was created from an unboxed
+   * function/functor/lambda. For such a kernel, calling it unboxed is a
+   * direct call, while calling it boxed goes through an unboxing wrapper;
+   * for a natively boxed kernel it is the other way around. Used by the
+   * dispatch trace to attribute boxing overhead (see
+   * Dispatcher::setDispatchTraceEnabled()).
+   */
+  bool hasUnboxedKernel() const;
+
   /**
    * Call the function in a boxed way.
    * If the kernel function was created with an unboxed function,
@@ -31,6 +31,10 @@ inline bool KernelFunction::isFallthrough() const {
     return boxed_kernel_func_ == &fallthrough_kernel;
 }
 
+inline bool KernelFunction::hasUnboxedKernel() const {
+    return unboxed_kernel_func_ != nullptr;
+}
+
 inline void KernelFunction::callBoxed(const OperatorHandle& opHandle, Stack* stack) const {
     if (C10_UNLIKELY(boxed_kernel_func_ == nullptr)) {
         if (unboxed_kernel_func_ == nullptr) {
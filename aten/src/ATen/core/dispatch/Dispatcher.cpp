@@ -1,6 +1,8 @@
 #include <ATen/core/dispatch/Dispatcher.h>
+#include <algorithm>
 #include <list>
 #include <sstream>
+#include <vector>
 
 namespace c10 {
 
@@ -34,9 +36,100 @@ private:
 
 OpRegistrationListener::~OpRegistrationListener() {}
 
+// Starts at 1 so that a zero-initialized OperatorCallCache never matches.
+// See Note [Per-call-site inline cache]
+std::atomic<uint64_t> Dispatcher::registrationSequence_{1};
+
+std::atomic<bool> Dispatcher::dispatchTraceEnabled_{false};
+
+namespace {
+
+// Counters for the dispatch trace (see DispatchTraceEntry). Guarded by a
+// mutex rather than per-operator atomics; tracing is a diagnostic mode, so
+// we keep the disabled path free instead of optimizing the enabled one.
+struct DispatchTraceState final {
+  std::mutex mutex;
+  std::unordered_map<std::string, DispatchTraceEntry> entries;
+};
+
+DispatchTraceState& dispatchTraceState() {
+  static DispatchTraceState state;
+  return state;
+}
+
+} // namespace
+
+void Dispatcher::setDispatchTraceEnabled(bool enabled) {
+  dispatchTraceEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+std::unordered_map<std::string, DispatchTraceEntry> Dispatcher::dispatchTraceResults() {
+  auto& state = dispatchTraceState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.entries;
+}
+
+void Dispatcher::resetDispatchTrace() {
+  auto& state = dispatchTraceState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.entries.clear();
+}
+
+std::string Dispatcher::dumpDispatchTrace() {
+  auto results = dispatchTraceResults();
+  std::vector<std::pair<std::string, DispatchTraceEntry>> sorted(
+      results.begin(), results.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second.boxing_wrapper_calls > b.second.boxing_wrapper_calls;
+  });
+  std::ostringstream oss;
+  for (const auto& kv : sorted) {
+    const auto& e = kv.second;
+    oss << kv.first << " boxed=" << e.boxed_calls
+        << " unboxed=" << e.unboxed_calls
+        << " boxing_wrapper=" << e.boxing_wrapper_calls
+        << " fallback=" << e.fallback_hits
+        << " catchall=" << e.catchall_hits << "\n";
+  }
+  return oss.str();
+}
+
+void Dispatcher::traceDispatch_(
+    const OperatorHandle& op,
+    const DispatchTable& dispatchTable,
+    DispatchKey dispatchKey,
+    const KernelFunction& kernel,
+    bool boxed) const {
+  auto& state = dispatchTraceState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto& entry = state.entries[toString(op.operator_name())];
+  if (boxed) {
+    entry.boxed_calls++;
+  } else {
+    entry.unboxed_calls++;
+  }
+  // The call crosses the (un)boxing wrapper whenever the calling convention
+  // does not match the convention the kernel was registered with.
+  if (boxed == kernel.hasUnboxedKernel()) {
+    entry.boxing_wrapper_calls++;
+  }
+  // Classify how the kernel was resolved, mirroring dispatch_: anything not
+  // found in the per-operator backend table came from the fallback table or
+  // the catchall slot.
+  if (dispatchTable.lookup(dispatchKey) != &kernel) {
+    if (&backendFallbackKernels_[dispatchKey] == &kernel) {
+      entry.fallback_hits++;
+    } else {
+      entry.catchall_hits++;
+    }
+  }
+}
+
 Dispatcher::Dispatcher()
 : operators_()
 , operatorLookupTable_()
+, sealedLookupTable_(nullptr)
+, retiredLookupTables_()
 , backendFallbackKernels_()
 , backendsWithoutFallthrough_(DispatchKeySet::FULL)
 , listeners_(std::make_unique<detail::RegistrationListenerList>())
@@ -50,6 +143,15 @@ C10_EXPORT Dispatcher& Dispatcher::singleton() {
 }
 
 c10::optional<OperatorHandle> Dispatcher::findOp(const OperatorName& overload_name) {
+  // See Note [Sealed operator lookup table]
+  const auto* sealed = sealedLookupTable_.load(std::memory_order_acquire);
+  if (sealed != nullptr) {
+    auto found = sealed->find(overload_name);
+    if (found == sealed->end()) {
+      return c10::nullopt;
+    }
+    return found->second;
+  }
   return operatorLookupTable_.read([&] (const ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) -> c10::optional<OperatorHandle> {
     auto found = operatorLookupTable.find(overload_name);
     if (found == operatorLookupTable.end()) {
@@ -59,6 +161,26 @@ c10::optional<OperatorHandle> Dispatcher::findOp(const OperatorName& overload_na
   });
 }
 
+void Dispatcher::sealOperatorLookupTable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto snapshot = operatorLookupTable_.read(
+      [] (const ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
+        return std::make_unique<ska::flat_hash_map<OperatorName, OperatorHandle>>(operatorLookupTable);
+      });
+  unsealOperatorLookupTable_();
+  sealedLookupTable_.store(snapshot.release(), std::memory_order_release);
+}
+
+void Dispatcher::unsealOperatorLookupTable_() {
+  const auto* sealed = sealedLookupTable_.load(std::memory_order_relaxed);
+  if (sealed != nullptr) {
+    sealedLookupTable_.store(nullptr, std::memory_order_release);
+    // A concurrent reader may still be inside the snapshot, so park it
+    // instead of freeing it. See Note [Sealed operator lookup table].
+    retiredLookupTables_.emplace_back(sealed);
+  }
+}
+
 c10::optional<OperatorHandle> Dispatcher::findSchema(const OperatorName& overload_name) {
   auto it = findOp(overload_name);
   if (it.has_value()) {
@@ -98,6 +220,8 @@ OperatorHandle Dispatcher::findOrRegisterName_(const OperatorName& op_name) {
 
   operators_.emplace_back(OperatorName(op_name));
   OperatorHandle handle(--operators_.end());
+  // A sealed snapshot would keep answering nullopt for the new name.
+  unsealOperatorLookupTable_();
   operatorLookupTable_.write([&] (ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
     operatorLookupTable.emplace(op_name, handle);
   });
@@ -186,6 +310,7 @@ RegistrationHandleRAII Dispatcher::registerImpl(
   auto handle = op.operatorIterator_->op.registerKernel(dispatch_key, std::move(kernel), std::move(inferred_function_schema), std::move(debug));
 
   ++op.operatorIterator_->def_and_impl_count;
+  bumpRegistrationSequence_();
 
   return RegistrationHandleRAII([this, op, op_name, dispatch_key, handle] {
     deregisterImpl_(op, op_name, dispatch_key, handle);
@@ -196,6 +321,7 @@ void Dispatcher::deregisterImpl_(const OperatorHandle& op, const OperatorName& o
   std::lock_guard<std::mutex> lock(mutex_);
 
   op.operatorIterator_->op.deregisterKernel_(dispatch_key, handle);
+  bumpRegistrationSequence_();
 
   TORCH_INTERNAL_ASSERT(op.operator_name() == op_name);
 
@@ -208,6 +334,8 @@ void Dispatcher::deregisterImpl_(const OperatorHandle& op, const OperatorName& o
 // Test if the operator entry is completely dead, and if so remove it completely
 void Dispatcher::cleanup(const OperatorHandle& op, const OperatorName& op_name) {
   if (0 == op.operatorIterator_->def_and_impl_count) {
+    // Unpublish the snapshot before the handle it hands out goes dangling.
+    unsealOperatorLookupTable_();
     // TODO: rename this to "assert deregistration invariants"
     op.operatorIterator_->op.prepareForDeregistration();
     operators_.erase(op.operatorIterator_);
@@ -224,6 +352,7 @@ RegistrationHandleRAII Dispatcher::registerFallback(DispatchKey dispatchKey, Ker
   if (kernel.isFallthrough()) {
     backendsWithoutFallthrough_ = backendsWithoutFallthrough_.remove(dispatchKey);
   }
+  bumpRegistrationSequence_();
 
   return RegistrationHandleRAII([this, dispatchKey] {
     deregisterFallback_(dispatchKey);
@@ -233,6 +362,7 @@ RegistrationHandleRAII Dispatcher::registerFallback(DispatchKey dispatchKey, Ker
 void Dispatcher::deregisterFallback_(DispatchKey dispatchKey) {
   backendFallbackKernels_.removeKernelIfExists(dispatchKey);
   backendsWithoutFallthrough_ = backendsWithoutFallthrough_.add(dispatchKey);
+  bumpRegistrationSequence_();
 }
 
 
@@ -284,6 +414,7 @@ void Dispatcher::checkInvariants() const {
 
 void Dispatcher::setManuallyBoxedKernelFor_(const OperatorHandle& op, KernelFunction::InternalBoxedKernelFunction* func) {
   op.operatorIterator_->op.setManuallyBoxedKernel_(func);
+  bumpRegistrationSequence_();
 }
 
 bool Dispatcher::isValid(const OperatorHandle& op) const {
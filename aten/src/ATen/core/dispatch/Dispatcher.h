@@ -4,13 +4,54 @@
 #include <ATen/core/dispatch/RegistrationHandleRAII.h>
 #include <c10/util/Exception.h>
 #include <c10/util/LeftRight.h>
+#include <atomic>
 #include <mutex>
 #include <list>
+#include <string>
+#include <unordered_map>
 
 namespace c10 {
 
 class CAFFE2_API OperatorHandle;
 
+/**
+ * Note [Per-call-site inline cache]
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Small-tensor eager workloads are dominated by dispatch overhead rather than
+ * kernel time. A call site that invokes the same operator over and over
+ * (typically with the same backend) can keep an OperatorCallCache next to its
+ * OperatorHandle and go through callUnboxedCached(). The cache memoizes the
+ * KernelFunction that a dispatch key resolved to, so the steady-state path is
+ * one predictable branch plus an indirect call instead of chasing the
+ * per-operator dispatch table and the fallback tables.
+ *
+ * Kernel (de)registration can invalidate the memoized pointer; every mutation
+ * of dispatch state bumps a global sequence number and the cache re-resolves
+ * whenever the number it recorded no longer matches. The cache itself is not
+ * synchronized -- declare it thread_local at the call site.
+ */
+struct OperatorCallCache final {
+  const KernelFunction* kernel = nullptr;
+  DispatchKey dispatch_key = DispatchKey::Undefined;
+  uint64_t sequence = 0;
+};
+
+/**
+ * Per-operator counters collected while dispatch tracing is enabled. They
+ * answer two questions that flamegraphs only answer indirectly: which calls
+ * paid boxing/unboxing overhead because the calling convention did not match
+ * the registered kernel, and which calls were served by a backend fallback or
+ * the catchall kernel instead of a kernel registered for their dispatch key.
+ * See Dispatcher::setDispatchTraceEnabled().
+ */
+struct DispatchTraceEntry final {
+  int64_t boxed_calls = 0;   // calls made via the boxed calling convention
+  int64_t unboxed_calls = 0; // calls made via the unboxed calling convention
+  int64_t boxing_wrapper_calls = 0; // calls that crossed the (un)boxing wrapper
+  int64_t fallback_hits = 0; // calls resolved to a backend fallback kernel
+  int64_t catchall_hits = 0; // calls resolved to the catchall kernel
+};
+
 /**
  * Implement this interface and register your instance with the dispatcher
  * to get notified when operators are registered or deregistered with
@@ -103,6 +144,18 @@ public:
   // Like findSchema, but also returns OperatorHandle even if there is no schema
   c10::optional<OperatorHandle> findOp(const OperatorName& operator_name);
 
+  /**
+   * Publish an immutable snapshot of the operator lookup table, so that
+   * findSchema/findOp serve reads from it with a single atomic load instead
+   * of going through LeftRight's reader counting. Intended for servers that
+   * finish loading all libraries before serving: call it once after startup.
+   * A later registration or deregistration that changes the set of operator
+   * names silently drops the snapshot and falls back to the synchronized
+   * table; call this again afterwards to re-seal.
+   * See Note [Sealed operator lookup table].
+   */
+  void sealOperatorLookupTable();
+
   // ------------------------------------------------------------------------
   //
   // Invoking operators
@@ -112,6 +165,11 @@ public:
   template<class Return, class... Args>
   Return callUnboxed(const OperatorHandle& op, Args... args) const;
 
+  // Like callUnboxed, but memoizes the resolved KernelFunction in `cache`.
+  // See Note [Per-call-site inline cache].
+  template<class Return, class... Args>
+  Return callUnboxedCached(const OperatorHandle& op, OperatorCallCache& cache, Args... args) const;
+
   // Like callUnboxed, but override the default DispatchKey calculation code,
   // instead dispatching straight to the provided DispatchKey
   template<class Return, class... Args>
@@ -191,6 +249,34 @@ public:
 
   void checkInvariants() const;
 
+  // Bumped on every mutation of dispatch state; used to invalidate
+  // OperatorCallCache instances. See Note [Per-call-site inline cache].
+  static uint64_t registrationSequence() {
+    return registrationSequence_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * When enabled, every dispatcher call records per-operator counters of
+   * boxed vs unboxed invocations, boxing-wrapper crossings and fallback /
+   * catchall hits (see DispatchTraceEntry). Off by default; the disabled
+   * cost is one relaxed atomic load per call. Counters accumulate across
+   * enable/disable cycles until resetDispatchTrace().
+   */
+  static void setDispatchTraceEnabled(bool enabled);
+  static bool isDispatchTraceEnabled() {
+    return dispatchTraceEnabled_.load(std::memory_order_relaxed);
+  }
+
+  // Snapshot of the counters collected so far, keyed by operator name
+  // (including the overload name, schema style).
+  static std::unordered_map<std::string, DispatchTraceEntry> dispatchTraceResults();
+  static void resetDispatchTrace();
+
+  // Human-readable rendering of dispatchTraceResults(), one operator per
+  // line, sorted by boxing-wrapper crossings so the ops paying the most
+  // boxing overhead come first.
+  static std::string dumpDispatchTrace();
+
 private:
   Dispatcher();
 
@@ -211,8 +297,40 @@ private:
 
   const KernelFunction& dispatch_(const DispatchTable& dispatchTable, DispatchKey dispatch_key) const;
 
+  // Slow path of dispatch tracing; only called when tracing is enabled.
+  // Classifies how `kernel' was resolved and how it will be invoked, and
+  // bumps the operator's counters.
+  void traceDispatch_(
+      const OperatorHandle& op,
+      const DispatchTable& dispatchTable,
+      DispatchKey dispatchKey,
+      const KernelFunction& kernel,
+      bool boxed) const;
+
+  // Drops the sealed snapshot (if any) because the set of operator names is
+  // about to change. Must be called with mutex_ held.
+  void unsealOperatorLookupTable_();
+
   std::list<OperatorDef> operators_;
   LeftRight<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
+  // Note [Sealed operator lookup table]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // LeftRight gives readers wait-freedom, but every read still does a
+  // fetch_add/fetch_sub on a shared counter, which ping-pongs a cache line
+  // between all cores doing operator lookups. Registration is effectively
+  // frozen once a process finishes loading its libraries, so after startup
+  // a caller may sealOperatorLookupTable(): we copy the table into an
+  // immutable snapshot and publish a pointer to it, and findOp serves reads
+  // with one atomic load (no stores to shared state at all). Any mutation of
+  // the name set unpublishes the snapshot before touching the real table and
+  // parks it in retiredLookupTables_ rather than freeing it, because a
+  // concurrent reader may still be using it; this is RCU without a grace
+  // period, trading a bounded leak (one table per seal) for not making
+  // readers announce themselves. Kernel (re)registration on an existing
+  // operator does not affect the snapshot since it only maps names to
+  // handles, not to kernels.
+  std::atomic<const ska::flat_hash_map<OperatorName, OperatorHandle>*> sealedLookupTable_;
+  std::vector<std::unique_ptr<const ska::flat_hash_map<OperatorName, OperatorHandle>>> retiredLookupTables_;
   impl::KernelFunctionTable backendFallbackKernels_;
   // Set of backends which have specified they do NOT want fallthrough behavior
   // (we store the inverse because it avoids a negation when we use this for
@@ -220,6 +338,12 @@ private:
   DispatchKeySet backendsWithoutFallthrough_;
   std::unique_ptr<detail::RegistrationListenerList> listeners_;
   std::mutex mutex_;
+
+  static void bumpRegistrationSequence_() {
+    registrationSequence_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  static std::atomic<uint64_t> registrationSequence_;
+  static std::atomic<bool> dispatchTraceEnabled_;
 };
 
 /**
@@ -269,6 +393,12 @@ public:
     return c10::Dispatcher::singleton().callUnboxed<Return, Args...>(*this, std::forward<Args>(args)...);
   }
 
+  // See Note [Per-call-site inline cache]
+  template<class Return, class... Args>
+  Return callUnboxedCached(OperatorCallCache& cache, Args... args) const {
+    return c10::Dispatcher::singleton().callUnboxedCached<Return, Args...>(*this, cache, std::forward<Args>(args)...);
+  }
+
   template<class Return, class... Args>
   Return callUnboxedWithDispatchKey(DispatchKey dispatchKey, Args... args) const {
     return c10::Dispatcher::singleton().callUnboxedWithDispatchKey<Return, Args...>(*this, dispatchKey, std::forward<Args>(args)...);
@@ -295,6 +425,9 @@ inline Return Dispatcher::callUnboxedWithDispatchKey(const OperatorHandle& op, D
   detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
   const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  if (C10_UNLIKELY(isDispatchTraceEnabled())) {
+    traceDispatch_(op, dispatchTable, dispatchKey, kernel, /*boxed=*/false);
+  }
   return kernel.template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
 }
 
@@ -306,6 +439,28 @@ inline Return Dispatcher::callUnboxed(const OperatorHandle& op, Args... args) co
   return callUnboxedWithDispatchKey<Return, Args...>(op, dispatchKey, args...);
 }
 
+template<class Return, class... Args>
+inline Return Dispatcher::callUnboxedCached(const OperatorHandle& op, OperatorCallCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+  const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
+  auto dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyUnboxed<Args...>(backendsWithoutFallthrough_, DispatchKeySet::FULL, args...);
+  const uint64_t sequence = registrationSequence();
+  if (C10_LIKELY(cache.kernel != nullptr && cache.dispatch_key == dispatchKey && cache.sequence == sequence)) {
+    if (C10_UNLIKELY(isDispatchTraceEnabled())) {
+      traceDispatch_(op, dispatchTable, dispatchKey, *cache.kernel, /*boxed=*/false);
+    }
+    return cache.kernel->template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+  }
+  const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  cache.kernel = &kernel;
+  cache.dispatch_key = dispatchKey;
+  cache.sequence = sequence;
+  if (C10_UNLIKELY(isDispatchTraceEnabled())) {
+    traceDispatch_(op, dispatchTable, dispatchKey, kernel, /*boxed=*/false);
+  }
+  return kernel.template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+}
+
 template<class Return, class... Args>
 inline Return Dispatcher::callUnboxedRedispatch(const OperatorHandle& op, DispatchKey currentDispatchKey, Args... args) const {
   detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
@@ -315,6 +470,9 @@ inline Return Dispatcher::callUnboxedRedispatch(const OperatorHandle& op, Dispat
     DispatchKeySet(DispatchKeySet::FULL_AFTER, currentDispatchKey),
     args...);
   const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  if (C10_UNLIKELY(isDispatchTraceEnabled())) {
+    traceDispatch_(op, dispatchTable, dispatchKey, kernel, /*boxed=*/false);
+  }
   return kernel.template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
 }
 
@@ -323,6 +481,9 @@ inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
   auto dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyBoxed(backendsWithoutFallthrough_, stack);
   const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  if (C10_UNLIKELY(isDispatchTraceEnabled())) {
+    traceDispatch_(op, dispatchTable, dispatchKey, kernel, /*boxed=*/true);
+  }
   kernel.callBoxed(op, stack);
 }
 
@@ -10,6 +10,7 @@
 #include <c10/core/UndefinedTensorImpl.h>
 #include <ATen/core/Dict.h>
 #include <ATen/core/List.h>
+#include <c10/util/FreeList.h>
 #include <ATen/core/rref_interface.h>
 
 namespace torch {
@@ -157,6 +158,16 @@ struct CAFFE2_API ConstantString final : c10::intrusive_ptr_target {
   operator const std::string & () const {
     return string();
   }
+  // Scripted code materializes string constants at instruction rate; the
+  // node is fixed-size (the character data has its own SSO/heap storage in
+  // str_), so recycle it through a per-thread free list instead of paying
+  // a malloc/free pair per value.
+  static void* operator new(std::size_t) {
+    return c10::FreeList<ConstantString>::get().allocate();
+  }
+  static void operator delete(void* ptr) {
+    c10::FreeList<ConstantString>::get().deallocate(ptr);
+  }
   CAFFE2_API friend std::ostream& operator<<(
       std::ostream& out,
       const ConstantString& v);
@@ -164,7 +175,7 @@ struct CAFFE2_API ConstantString final : c10::intrusive_ptr_target {
 
 struct Future;
 
-struct CAFFE2_API Tuple : c10::intrusive_ptr_target {
+struct CAFFE2_API Tuple final : c10::intrusive_ptr_target {
  private:
   std::vector<IValue> elements_;
   mutable std::shared_ptr<TupleType> type_; // lazily computed for unnamed tuples
@@ -203,6 +214,19 @@ struct CAFFE2_API Tuple : c10::intrusive_ptr_target {
   std::vector<IValue>&& elements() && {
     return std::move(elements_);
   }
+
+  // TUPLE_CONSTRUCT runs once per executed tuple expression, so the Tuple
+  // node itself is the hottest allocation in control-flow-heavy scripts;
+  // recycle it through a per-thread free list. (The elements_ vector still
+  // allocates its buffer for non-empty tuples, but the caller typically
+  // built that vector already and moves it in.)
+  static void* operator new(std::size_t) {
+    return c10::FreeList<Tuple>::get().allocate();
+  }
+  static void operator delete(void* ptr) {
+    c10::FreeList<Tuple>::get().deallocate(ptr);
+  }
+
   std::shared_ptr<TupleType> type() const;
 
   friend bool operator==(const ivalue::Tuple& lhs, const ivalue::Tuple& rhs);
@@ -248,6 +272,12 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
    * Wait on the future until it completes.
    */
   void wait() {
+    // Fast path: a completed future never becomes incomplete again, and the
+    // release store in markCompleted()/setError() makes value_/error_ visible
+    // to anyone observing completed_ with acquire ordering.
+    if (completed()) {
+      return;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     while (!completed_) {
       finished_cv_.wait(lock);
@@ -256,12 +286,16 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
 
   /**
    * Explicitly mark the future as completed with the output value.
+   *
+   * Completion itself still takes the mutex (to serialize with pending
+   * addCallback() calls), but value_ is published with a release store to
+   * completed_ so that all completed-state accessors can go lock-free.
    */
   void markCompleted(IValue value) {
     std::unique_lock<std::mutex> lock(mutex_);
     AT_ASSERT(!completed());
-    completed_ = true;
     value_ = std::move(value);
+    completed_.store(true, std::memory_order_release);
 
     std::vector<std::function<void(void)>> cbs;
     cbs.swap(callbacks_);
@@ -284,8 +318,8 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
   void setError(FutureError&& error) {
     std::unique_lock<std::mutex> lock(mutex_);
     AT_ASSERT(!completed());
-    completed_ = true;
     error_ = std::move(error);
+    completed_.store(true, std::memory_order_release);
 
     std::vector<std::function<void(void)>> cbs;
     cbs.swap(callbacks_);
@@ -297,9 +331,9 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
     }
   }
 
-  // Get the result of the current future.
+  // Get the result of the current future. Lock-free: value_ and error_ are
+  // immutable once completed_ is set.
   IValue value() {
-    std::unique_lock<std::mutex> lock(mutex_);
     AT_ASSERT(completed());
     if (error_) {
       throw *error_;
@@ -310,11 +344,18 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
   /**
    * Add a callback to the future.
    * The callbacks will be executed once the future completes.
-   * If the future has already completed,
-   * this function will execute the callback immediately.
+   * If the future has already completed, this function will execute the
+   * callback immediately, inline, without touching the mutex.
    */
   void addCallback(std::function<void(void)> callback) {
+    if (completed()) {
+      callback();
+      return;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
+    // Re-check under the lock: the future may have completed while we were
+    // acquiring it, and markCompleted() has already swapped out the callback
+    // list in that case.
     if (completed()) {
       lock.unlock();
       callback();
@@ -325,16 +366,17 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
 
   // Check if the current future has completed
   bool completed() const{
-    return completed_;
+    return completed_.load(std::memory_order_acquire);
   }
 
   bool hasError() const {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return error_ ? true : false;
+    return completed() && error_.has_value();
   }
 
   c10::optional<FutureError> error() const {
-    std::unique_lock<std::mutex> lock(mutex_);
+    if (!completed()) {
+      return c10::nullopt;
+    }
     return error_;
   }
 
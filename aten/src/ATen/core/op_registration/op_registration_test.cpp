@@ -1518,6 +1518,53 @@ TEST(NewOperatorRegistrationTest, testDelayedListener) {
   EXPECT_EQ(initial_num_deregisters + 1, listener_ptr->num_deregisters_);
 }
 
+TEST(OperatorRegistrationTest, givenDispatchTraceEnabled_whenCallingOp_thenCountsCallingConventions) {
+  auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().kernel<DummyKernel>(c10::DispatchKey::CPU));
+
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  Dispatcher::resetDispatchTrace();
+  Dispatcher::setDispatchTraceEnabled(true);
+  callOpUnboxed<void, Tensor>(*op, dummyTensor(c10::DispatchKey::CPU));
+  callOp(*op, dummyTensor(c10::DispatchKey::CPU));
+  Dispatcher::setDispatchTraceEnabled(false);
+  callOp(*op, dummyTensor(c10::DispatchKey::CPU)); // not counted
+
+  auto results = Dispatcher::dispatchTraceResults();
+  const auto& entry = results.at("_test::dummy");
+  EXPECT_EQ(1, entry.unboxed_calls);
+  EXPECT_EQ(1, entry.boxed_calls);
+  // Only the boxed call into the unboxed kernel crossed the unboxing wrapper.
+  EXPECT_EQ(1, entry.boxing_wrapper_calls);
+  EXPECT_EQ(0, entry.fallback_hits);
+  EXPECT_EQ(0, entry.catchall_hits);
+  EXPECT_NE(std::string::npos, Dispatcher::dumpDispatchTrace().find("_test::dummy"));
+
+  Dispatcher::resetDispatchTrace();
+  EXPECT_EQ(0, Dispatcher::dispatchTraceResults().count("_test::dummy"));
+}
+
+TEST(OperatorRegistrationTest, givenDispatchTraceEnabled_whenCallingCatchallKernel_thenCountsCatchallHit) {
+  auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().catchAllKernel<DummyKernel>());
+
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  Dispatcher::resetDispatchTrace();
+  Dispatcher::setDispatchTraceEnabled(true);
+  callOpUnboxed<void, Tensor>(*op, dummyTensor(c10::DispatchKey::CPU));
+  Dispatcher::setDispatchTraceEnabled(false);
+
+  auto results = Dispatcher::dispatchTraceResults();
+  const auto& entry = results.at("_test::dummy");
+  EXPECT_EQ(1, entry.unboxed_calls);
+  EXPECT_EQ(1, entry.catchall_hits);
+  EXPECT_EQ(0, entry.fallback_hits);
+
+  Dispatcher::resetDispatchTrace();
+}
+
 TEST(OperatorRegistrationTest, whenDeregisteringOp_thenHandleBecomesInvalid) {
   c10::optional<OperatorHandle> handle;
   {
@@ -20,6 +20,12 @@ static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
   o2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(hi), 16));
 }
 static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
+#if defined(__AVX512BF16__) && defined(__AVX512F__)
+  // single-instruction round-to-nearest-even conversion on CPUs with
+  // AVX512-BF16 (Cooper Lake+); also quiets NaNs like the emulation below
+  __m512 full = _mm512_insertf32x8(_mm512_castps256_ps512(a), b, 1);
+  return (__m256i)_mm512_cvtneps_pbh(full);
+#else
   __m256i lo = _mm256_castps_si256(a);
   __m256i hi = _mm256_castps_si256(b);
   __m256i nan = _mm256_set1_epi32(0x7fc0);
@@ -45,6 +51,7 @@ static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
 
   t_lo = _mm256_packus_epi32(t_lo, t_hi);      // t_hi[4-7] t_lo[4-7] t_hi[0-4] t_lo[0-4]
   return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11        01        10        00
+#endif
 }
 
 template <> class Vec256<BFloat16> {
@@ -232,12 +239,17 @@ public:
     return map(Sleef_erfcf8_u15);
   }
   Vec256<BFloat16> erfinv() const {
-    __at_align32__ int16_t tmp[size()];
-    store(tmp);
+    __m256 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    __at_align32__ float tmp[size()];
+    _mm256_storeu_ps(tmp, lo);
+    _mm256_storeu_ps(tmp + 8, hi);
     for (int64_t i = 0; i < size(); i++) {
-      tmp[i] = calc_erfinv((float)tmp[i]);
+      tmp[i] = calc_erfinv(tmp[i]);
     }
-    return loadu(tmp);
+    auto o1 = _mm256_loadu_ps(tmp);
+    auto o2 = _mm256_loadu_ps(tmp + 8);
+    return cvtfp32_bf16(o1, o2);
   }
   Vec256<BFloat16> exp() const {
     return map(Sleef_expf8_u10);
@@ -545,6 +557,38 @@ inline void convert(const BFloat16* src, BFloat16* dst, int64_t n) {
   }
 }
 
+template <>
+inline void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    __m256 o1, o2;
+    cvtbf16_fp32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), o1, o2);
+    _mm256_storeu_ps(dst + i, o1);
+    _mm256_storeu_ps(dst + i + 8, o2);
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    __m256 a = _mm256_loadu_ps(src + i);
+    __m256 b = _mm256_loadu_ps(src + i + 8);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i), cvtfp32_bf16(a, b));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = static_cast<BFloat16>(src[i]);
+  }
+}
+
 template <>
 Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a,
     const Vec256<BFloat16>& b, const Vec256<BFloat16>& c) {
@@ -219,16 +219,53 @@ public:
     AT_ERROR("not supported for complex numbers");
   }
   Vec256<std::complex<double>> sin() const {
-    return map(std::sin);
+    //sin(a + bi)
+    // = sin(a)*cosh(b) + cos(a)*sinh(b)i
+    auto sin_cos = Sleef_sincosd4_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhd4_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshd4_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_pd(sin_cos.x,
+                            _mm256_permute_pd(cosh, 0x05));           //sin(a)*cosh(b)
+    auto im = _mm256_mul_pd(_mm256_permute_pd(sin_cos.y, 0x05),
+                            sinh);                                    //                 cos(a)*sinh(b)
+    return _mm256_blend_pd(re, im, 0x0A);
   }
   Vec256<std::complex<double>> sinh() const {
-    return map(std::sinh);
+    //sinh(a + bi)
+    // = sinh(a)*cos(b) + cosh(a)*sin(b)i
+    auto sin_cos = Sleef_sincosd4_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhd4_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshd4_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_pd(sinh,
+                            _mm256_permute_pd(sin_cos.y, 0x05));      //sinh(a)*cos(b)
+    auto im = _mm256_mul_pd(_mm256_permute_pd(cosh, 0x05),
+                            sin_cos.x);                               //                 cosh(a)*sin(b)
+    return _mm256_blend_pd(re, im, 0x0A);
   }
   Vec256<std::complex<double>> cos() const {
-    return map(std::cos);
+    //cos(a + bi)
+    // = cos(a)*cosh(b) - sin(a)*sinh(b)i
+    const __m256d sign_mask = _mm256_setr_pd(0.0, -0.0, 0.0, -0.0);
+    auto sin_cos = Sleef_sincosd4_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhd4_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshd4_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_pd(sin_cos.y,
+                            _mm256_permute_pd(cosh, 0x05));           //cos(a)*cosh(b)
+    auto im = _mm256_mul_pd(_mm256_permute_pd(sin_cos.x, 0x05),
+                            sinh);                                    //                 sin(a)*sinh(b)
+    return _mm256_blend_pd(re, _mm256_xor_pd(im, sign_mask), 0x0A);
   }
   Vec256<std::complex<double>> cosh() const {
-    return map(std::cosh);
+    //cosh(a + bi)
+    // = cosh(a)*cos(b) + sinh(a)*sin(b)i
+    auto sin_cos = Sleef_sincosd4_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhd4_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshd4_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_pd(cosh,
+                            _mm256_permute_pd(sin_cos.y, 0x05));      //cosh(a)*cos(b)
+    auto im = _mm256_mul_pd(_mm256_permute_pd(sinh, 0x05),
+                            sin_cos.x);                               //                 sinh(a)*sin(b)
+    return _mm256_blend_pd(re, im, 0x0A);
   }
   Vec256<std::complex<double>> ceil() const {
     return _mm256_ceil_pd(values);
@@ -257,16 +257,53 @@ public:
     AT_ERROR("not supported for complex numbers");
   }
   Vec256<std::complex<float>> sin() const {
-    return map(std::sin);
+    //sin(a + bi)
+    // = sin(a)*cosh(b) + cos(a)*sinh(b)i
+    auto sin_cos = Sleef_sincosf8_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhf8_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshf8_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_ps(sin_cos.x,
+                            _mm256_permute_ps(cosh, 0xB1));           //sin(a)*cosh(b)
+    auto im = _mm256_mul_ps(_mm256_permute_ps(sin_cos.y, 0xB1),
+                            sinh);                                    //                 cos(a)*sinh(b)
+    return _mm256_blend_ps(re, im, 0xAA);
   }
   Vec256<std::complex<float>> sinh() const {
-    return map(std::sinh);
+    //sinh(a + bi)
+    // = sinh(a)*cos(b) + cosh(a)*sin(b)i
+    auto sin_cos = Sleef_sincosf8_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhf8_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshf8_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_ps(sinh,
+                            _mm256_permute_ps(sin_cos.y, 0xB1));      //sinh(a)*cos(b)
+    auto im = _mm256_mul_ps(_mm256_permute_ps(cosh, 0xB1),
+                            sin_cos.x);                               //                 cosh(a)*sin(b)
+    return _mm256_blend_ps(re, im, 0xAA);
   }
   Vec256<std::complex<float>> cos() const {
-    return map(std::cos);
+    //cos(a + bi)
+    // = cos(a)*cosh(b) - sin(a)*sinh(b)i
+    const __m256 sign_mask = _mm256_setr_ps(0.0, -0.0, 0.0, -0.0, 0.0, -0.0, 0.0, -0.0);
+    auto sin_cos = Sleef_sincosf8_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhf8_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshf8_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_ps(sin_cos.y,
+                            _mm256_permute_ps(cosh, 0xB1));           //cos(a)*cosh(b)
+    auto im = _mm256_mul_ps(_mm256_permute_ps(sin_cos.x, 0xB1),
+                            sinh);                                    //                 sin(a)*sinh(b)
+    return _mm256_blend_ps(re, _mm256_xor_ps(im, sign_mask), 0xAA);
   }
   Vec256<std::complex<float>> cosh() const {
-    return map(std::cosh);
+    //cosh(a + bi)
+    // = cosh(a)*cos(b) + sinh(a)*sin(b)i
+    auto sin_cos = Sleef_sincosf8_u10(values);                        //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto sinh = Sleef_sinhf8_u10(values);                             //sinh(a)          sinh(b)
+    auto cosh = Sleef_coshf8_u10(values);                             //cosh(a)          cosh(b)
+    auto re = _mm256_mul_ps(cosh,
+                            _mm256_permute_ps(sin_cos.y, 0xB1));      //cosh(a)*cos(b)
+    auto im = _mm256_mul_ps(_mm256_permute_ps(sinh, 0xB1),
+                            sin_cos.x);                               //                 sinh(a)*sin(b)
+    return _mm256_blend_ps(re, im, 0xAA);
   }
   Vec256<std::complex<float>> ceil() const {
     return _mm256_ceil_ps(values);
@@ -9,11 +9,76 @@
 
 #include <cuda_runtime_api.h>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <utility>
 
 namespace at { namespace cuda {
 
+namespace detail {
+
+/*
+* Pool of warm cudaEvent_t handles, one set of slots per device.
+*
+* Workloads that synchronize across streams at a high rate (dataloader
+* prefetching, communication/compute overlap) create and destroy thousands
+* of short-lived CUDAEvents per second, and cudaEventCreate is expensive
+* enough to show up in profiles. Events created with the default
+* cudaEventDisableTiming flags are interchangeable, so CUDAEvent returns
+* them here on destruction and reuses them on the next record().
+*
+* The pool is lock-free: each slot is an atomic handle that is claimed with
+* an exchange and refilled with a compare-exchange, so acquire/release never
+* block and there is no ABA hazard. If all slots of a device are full the
+* excess event is simply destroyed. Pooled events are intentionally leaked
+* at process exit; destroying them from a static destructor races with CUDA
+* context teardown.
+*/
+struct CUDAEventPool {
+  static constexpr size_t kMaxEventsPerDevice = 64;
+
+  static CUDAEventPool& instance() {
+    // Leaky singleton, see above.
+    static CUDAEventPool* pool = new CUDAEventPool();
+    return *pool;
+  }
+
+  // Returns a warm event for `device_index`, or nullptr if the pool is empty.
+  cudaEvent_t acquire(DeviceIndex device_index) {
+    for (auto& slot : slots_[device_index]) {
+      cudaEvent_t event = slot.exchange(nullptr, std::memory_order_acq_rel);
+      if (event != nullptr) {
+        return event;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of `event` if a free slot is available. Returns false if
+  // the pool is full, in which case the caller must destroy the event.
+  bool release(DeviceIndex device_index, cudaEvent_t event) {
+    for (auto& slot : slots_[device_index]) {
+      cudaEvent_t expected = nullptr;
+      if (slot.compare_exchange_strong(
+              expected, event, std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  CUDAEventPool() = default;
+
+  std::array<
+      std::array<std::atomic<cudaEvent_t>, kMaxEventsPerDevice>,
+      C10_COMPILE_TIME_MAX_GPUS>
+      slots_{};
+};
+
+} // namespace detail
+
 /*
 * CUDAEvents are movable not copyable wrappers around CUDA's events.
 *
@@ -38,6 +103,8 @@ struct TORCH_CUDA_API CUDAEvent {
 
       AT_CUDA_CHECK(cudaIpcOpenEventHandle(&event_, *handle));
       is_created_ = true;
+      // Events opened from another process must not enter the event pool.
+      external_ = true;
     #else
       AT_ERROR("cuIpcOpenEventHandle with HIP is not supported");
     #endif
@@ -48,6 +115,13 @@ struct TORCH_CUDA_API CUDAEvent {
   ~CUDAEvent() {
     try {
       if (is_created_) {
+        // Warm default-flag events go back to the per-device pool for reuse;
+        // IPC-imported events and events with non-default flags (e.g. timing
+        // enabled) are destroyed as before.
+        if (!external_ && flags_ == cudaEventDisableTiming &&
+            detail::CUDAEventPool::instance().release(device_index_, event_)) {
+          return;
+        }
         CUDAGuard guard(device_index_);
         cudaEventDestroy(event_);
       }
@@ -162,11 +236,21 @@ private:
   unsigned int flags_ = cudaEventDisableTiming;
   bool is_created_ = false;
   bool was_recorded_ = false;
+  // True if the event was opened from an IPC handle, i.e. created by another
+  // process; such events cannot be recycled through the event pool.
+  bool external_ = false;
   DeviceIndex device_index_ = -1;
   cudaEvent_t event_;
 
   void createEvent(DeviceIndex device_index) {
     device_index_ = device_index;
+    if (flags_ == cudaEventDisableTiming) {
+      event_ = detail::CUDAEventPool::instance().acquire(device_index_);
+      if (event_ != nullptr) {
+        is_created_ = true;
+        return;
+      }
+    }
     CUDAGuard guard(device_index_);
     AT_CUDA_CHECK(cudaEventCreateWithFlags(&event_, flags_));
     is_created_ = true;
@@ -176,6 +260,7 @@ private:
     std::swap(flags_, other.flags_);
     std::swap(is_created_, other.is_created_);
     std::swap(was_recorded_, other.was_recorded_);
+    std::swap(external_, other.external_);
     std::swap(device_index_, other.device_index_);
     std::swap(event_, other.event_);
   }
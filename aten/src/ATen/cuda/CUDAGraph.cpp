@@ -0,0 +1,144 @@
+#include <ATen/cuda/CUDAGraph.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAGuard.h>
+
+#include <atomic>
+
+namespace at { namespace cuda {
+
+#if !defined(__HIP_PLATFORM_HCC__) && defined(CUDA_VERSION) && \
+    CUDA_VERSION >= 10010
+#define AT_CUDA_GRAPHS_SUPPORTED 1
+#endif
+
+#ifdef AT_CUDA_GRAPHS_SUPPORTED
+namespace {
+
+// Capture ids double as private memory pool ids in the caching allocator;
+// 0 is reserved to mean "no pool".
+std::atomic<c10::cuda::CUDACachingAllocator::CaptureId_t> next_capture_id{1};
+
+} // namespace
+#endif
+
+void CUDAGraph::capture_begin() {
+#ifdef AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(
+      !capture_underway_, "capture_begin: a capture is already underway");
+  TORCH_CHECK(
+      !has_graph_exec_,
+      "capture_begin: this CUDAGraph already holds a captured graph, "
+      "call reset() first");
+
+  auto stream = at::cuda::getCurrentCUDAStream();
+  TORCH_CHECK(
+      stream != at::cuda::getDefaultCUDAStream(stream.device_index()),
+      "CUDA graphs must be captured on a non-default stream; set one with "
+      "at::cuda::CUDAStreamGuard and at::cuda::getStreamFromPool()");
+
+  capture_stream_ = stream;
+  id_ = next_capture_id++;
+
+  // Route allocations to this graph's private pool before any captured
+  // work can allocate.
+  c10::cuda::CUDACachingAllocator::notifyCaptureBegin(id_);
+
+  // Relaxed mode: the caching allocator must be able to call cudaMalloc
+  // while the capture is underway, which stricter modes prohibit.
+  cudaError_t err =
+      cudaStreamBeginCapture(stream, cudaStreamCaptureModeRelaxed);
+  if (err != cudaSuccess) {
+    // Unwind the allocator state before surfacing the error, so ordinary
+    // allocations are not routed to the dead private pool.
+    c10::cuda::CUDACachingAllocator::notifyCaptureEnd(id_);
+    c10::cuda::CUDACachingAllocator::notifyCaptureDestroy(id_);
+    id_ = 0;
+    AT_CUDA_CHECK(err);
+  }
+  TORCH_INTERNAL_ASSERT(stream.isCapturing());
+  capture_underway_ = true;
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA 10.1 or later");
+#endif
+}
+
+void CUDAGraph::capture_end() {
+#ifdef AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(
+      capture_underway_, "capture_end called without a matching capture_begin");
+  auto stream = at::cuda::getCurrentCUDAStream();
+  TORCH_CHECK(
+      stream == *capture_stream_,
+      "capture_end must be called on the same stream as capture_begin");
+
+  // Stop routing allocations to the private pool whether or not the
+  // capture itself succeeded.
+  cudaError_t err = cudaStreamEndCapture(stream, &graph_);
+  c10::cuda::CUDACachingAllocator::notifyCaptureEnd(id_);
+  capture_underway_ = false;
+  AT_CUDA_CHECK(err);
+
+  TORCH_CHECK(graph_ != nullptr, "capture_end: capture produced no graph");
+  AT_CUDA_CHECK(cudaGraphInstantiate(&graph_exec_, graph_, nullptr, nullptr, 0));
+  has_graph_exec_ = true;
+
+  // Only the instantiated graph is needed for replay.
+  AT_CUDA_CHECK(cudaGraphDestroy(graph_));
+  graph_ = nullptr;
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA 10.1 or later");
+#endif
+}
+
+void CUDAGraph::replay() {
+#ifdef AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(
+      has_graph_exec_, "replay called before any graph has been captured");
+  c10::cuda::CUDAGuard guard(capture_stream_->device());
+  AT_CUDA_CHECK(cudaGraphLaunch(
+      graph_exec_,
+      at::cuda::getCurrentCUDAStream(capture_stream_->device_index())));
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA 10.1 or later");
+#endif
+}
+
+void CUDAGraph::reset() {
+#ifdef AT_CUDA_GRAPHS_SUPPORTED
+  if (capture_underway_) {
+    // Abort a half-finished capture so the allocator stops routing
+    // allocations to the private pool. Errors are cleared, not raised:
+    // reset() runs from the destructor.
+    cudaGraph_t graph = nullptr;
+    cudaStreamEndCapture(*capture_stream_, &graph);
+    cudaGetLastError();
+    if (graph != nullptr) {
+      cudaGraphDestroy(graph);
+    }
+    c10::cuda::CUDACachingAllocator::notifyCaptureEnd(id_);
+    capture_underway_ = false;
+  }
+  if (graph_ != nullptr) {
+    cudaGraphDestroy(graph_);
+    graph_ = nullptr;
+  }
+  if (has_graph_exec_) {
+    cudaGraphExecDestroy(graph_exec_);
+    graph_exec_ = nullptr;
+    has_graph_exec_ = false;
+  }
+  if (id_ != 0) {
+    c10::cuda::CUDACachingAllocator::notifyCaptureDestroy(id_);
+    id_ = 0;
+  }
+#endif
+}
+
+CUDAGraph::~CUDAGraph() {
+  reset();
+}
+
+}} // namespace at::cuda
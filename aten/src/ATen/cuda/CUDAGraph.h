@@ -0,0 +1,77 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAStream.h>
+#include <c10/util/Optional.h>
+
+namespace at { namespace cuda {
+
+/*
+* CUDAGraph captures the work submitted to the current CUDA stream between
+* capture_begin() and capture_end() into a CUDA graph, which replay()
+* re-submits in a single launch. For workloads that run an identical kernel
+* sequence every iteration (e.g. steady-state inference at small batch
+* sizes), replaying the graph removes nearly all per-kernel launch overhead:
+*
+*   // warm up, then:
+*   at::cuda::CUDAGraph graph;
+*   {
+*     at::cuda::CUDAStreamGuard guard(at::cuda::getStreamFromPool());
+*     graph.capture_begin();
+*     output = module.forward(static_input);
+*     graph.capture_end();
+*   }
+*   ...
+*   static_input.copy_(new_input);
+*   graph.replay();  // recomputes output in place
+*
+* A replay re-issues kernels against the raw pointers observed during
+* capture, so every tensor consumed or produced inside the capture must keep
+* a stable address for the life of the graph. The caching allocator
+* guarantees this for allocations made during capture by serving them from
+* a graph-private memory pool (see Note [Graph-private memory pools] in
+* CUDACachingAllocator.cpp); inputs must therefore be copied into
+* pre-allocated tensors rather than reallocated between replays.
+*
+* Requires CUDA 10.1 or later; capture must happen on a non-default stream.
+*/
+struct TORCH_CUDA_API CUDAGraph {
+  CUDAGraph() = default;
+  ~CUDAGraph();
+
+  CUDAGraph(const CUDAGraph&) = delete;
+  CUDAGraph& operator=(const CUDAGraph&) = delete;
+
+  // Begins capture on the current stream. Allocations made between
+  // capture_begin and capture_end come from a graph-private memory pool.
+  void capture_begin();
+
+  // Ends capture on the current stream and instantiates the graph.
+  void capture_end();
+
+  // Re-submits the captured work to the current stream of the capture
+  // device.
+  void replay();
+
+  // Frees the instantiated graph and drops the reference on the private
+  // memory pool. Called by the destructor.
+  void reset();
+
+ protected:
+#if !defined(__HIP_PLATFORM_HCC__) && defined(CUDA_VERSION) && \
+    CUDA_VERSION >= 10010
+  cudaGraph_t graph_ = nullptr;
+  cudaGraphExec_t graph_exec_ = nullptr;
+#endif
+  bool capture_underway_ = false;
+  bool has_graph_exec_ = false;
+
+  // id of this graph's private memory pool in the caching allocator
+  c10::cuda::CUDACachingAllocator::CaptureId_t id_ = 0;
+
+  // stream the graph was captured on
+  c10::optional<c10::cuda::CUDAStream> capture_stream_;
+};
+
+}} // namespace at::cuda
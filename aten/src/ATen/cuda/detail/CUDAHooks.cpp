@@ -100,6 +100,38 @@ bool CUDAHooks::isPinnedPtr(void* data) const {
 #endif
 }
 
+bool CUDAHooks::registerPinnedMemory(void* data, size_t size) const {
+  if (!CUDAHooks::hasCUDA()) {
+    return false;
+  }
+  // Like cudaPointerGetAttributes above, cudaHostRegister grabs context on
+  // the current device, so we set device to one that already has context, if
+  // exists.
+  at::OptionalDeviceGuard device_guard;
+  auto primary_ctx_device_index = CUDAHooks::getDevceIndexWithPrimaryContext();
+  if (primary_ctx_device_index.has_value()) {
+    device_guard.reset_device(at::Device(at::DeviceType::CUDA, *primary_ctx_device_index));
+  }
+  cudaError_t err = cudaHostRegister(data, size, cudaHostRegisterDefault);
+  if (err != cudaSuccess) {
+    // Registration can fail for exotic mappings or buffers that are already
+    // registered; report failure so the caller falls back to a pinned copy.
+    cudaGetLastError();
+    return false;
+  }
+  return true;
+}
+
+void CUDAHooks::unregisterPinnedMemory(void* data) const {
+  // This runs from storage deleters, possibly during process teardown when
+  // the driver is already shutting down, so errors are swallowed rather than
+  // thrown.
+  cudaError_t err = cudaHostUnregister(data);
+  if (err != cudaSuccess) {
+    cudaGetLastError();
+  }
+}
+
 bool CUDAHooks::hasCUDA() const {
   return at::cuda::is_available();
 }
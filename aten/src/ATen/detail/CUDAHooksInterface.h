@@ -75,6 +75,14 @@ struct CAFFE2_API CUDAHooksInterface {
     return false;
   }
 
+  virtual bool registerPinnedMemory(void* data, size_t size) const {
+    return false;
+  }
+
+  virtual void unregisterPinnedMemory(void* data) const {
+    TORCH_CHECK(false, "Cannot unregister pinned memory without ATen_cuda library. ", CUDA_HELP);
+  }
+
   virtual bool hasCUDA() const {
     return false;
   }
@@ -190,6 +190,16 @@ case Backend::${backend}:
     ${return_call} ${backend}Type::${type_wrapper_name}(${native_arguments});
     break;
 """)
+# When only a single static dispatch backend provides a kernel for an op we
+# can skip the runtime backend switch entirely and call the backend wrapper
+# directly; the compiler can then inline through to at::native::, which
+# matters for deep internal call chains (e.g. layer_norm calling empty/mul/
+# add_).  The backend wrapper is responsible for rejecting tensors it cannot
+# handle, just as the switch's default case would have.
+STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY = CodeTemplate("""\
+at::AutoNonVariableTypeMode _var_guard(true);
+${return_call} ${backend}Type::${type_wrapper_name}(${native_arguments});
+""")
 
 # add a native declaration for a native function
 NATIVE_DECLARATION = CodeTemplate("""\
@@ -632,7 +642,8 @@ def is_mutable_formal_argument(argument, option):
 
 def check_methods_do_not_start_with_underscore(name, is_method):
     if name in {'_values', '_indices', '_nnz', '_dimI', '_dimV', '_coalesced_',
-                '_version'}:
+                '_version', '_resize_amortized_', '_shrink_to_fit_',
+                '_pin_memory_inplace_'}:
         return
     if is_method and name.startswith('_') and not name.startswith('__') and not name.startswith('_th_'):
         message = "Function '{}' starts with a single underscore and is ".format(name)
@@ -1091,17 +1102,24 @@ def create_generic(top_env, declarations):
                 # enabled, this switch will fail.  This is intentional: you
                 # probably need to disable variable globally in the mobile
                 # calling code.
-                for backend in static_dispatch_backends:
-                    if backend in type_method_dispatch:
-                        static_dispatch_function_switches.append(STATIC_DISPATCH_FUNCTION_SWITCH_STATEMENT.substitute(
-                            option,
-                            backend=backend,
-                            backend_function=type_method_dispatch[backend],
-                            native_arguments=option['method_actuals']))
-                static_dispatch_method_body = STATIC_DISPATCH_FUNCTION_SWITCH_BODY.substitute(
-                    option,
-                    key_set='key_set()',
-                    static_dispatch_function_switches=static_dispatch_function_switches)
+                static_dispatch_present_backends = [backend for backend in static_dispatch_backends
+                                                    if backend in type_method_dispatch]
+                for backend in static_dispatch_present_backends:
+                    static_dispatch_function_switches.append(STATIC_DISPATCH_FUNCTION_SWITCH_STATEMENT.substitute(
+                        option,
+                        backend=backend,
+                        backend_function=type_method_dispatch[backend],
+                        native_arguments=option['method_actuals']))
+                if len(static_dispatch_present_backends) == 1:
+                    static_dispatch_method_body = STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY.substitute(
+                        option,
+                        backend=static_dispatch_present_backends[0],
+                        native_arguments=option['method_actuals'])
+                else:
+                    static_dispatch_method_body = STATIC_DISPATCH_FUNCTION_SWITCH_BODY.substitute(
+                        option,
+                        key_set='key_set()',
+                        static_dispatch_function_switches=static_dispatch_function_switches)
             else:
                 static_dispatch_method_body = STATIC_DISPATCH_FUNCTION_DEFAULT_BODY.substitute(
                     option, native_arguments=option['method_actuals'])
@@ -1122,17 +1140,24 @@ def create_generic(top_env, declarations):
 
             if isinstance(type_method_dispatch, dict):
                 static_dispatch_function_switches = []
-                for backend in static_dispatch_backends:
-                    if backend in type_method_dispatch:
-                        static_dispatch_function_switches.append(STATIC_DISPATCH_FUNCTION_SWITCH_STATEMENT.substitute(
-                            option,
-                            backend=backend,
-                            backend_function=type_method_dispatch[backend],
-                            native_arguments=option['native_actuals']))
-                static_dispatch_function_body = STATIC_DISPATCH_FUNCTION_SWITCH_BODY.substitute(
-                    option,
-                    key_set=option['inferred_key_set'],
-                    static_dispatch_function_switches=static_dispatch_function_switches)
+                static_dispatch_present_backends = [backend for backend in static_dispatch_backends
+                                                    if backend in type_method_dispatch]
+                for backend in static_dispatch_present_backends:
+                    static_dispatch_function_switches.append(STATIC_DISPATCH_FUNCTION_SWITCH_STATEMENT.substitute(
+                        option,
+                        backend=backend,
+                        backend_function=type_method_dispatch[backend],
+                        native_arguments=option['native_actuals']))
+                if len(static_dispatch_present_backends) == 1:
+                    static_dispatch_function_body = STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY.substitute(
+                        option,
+                        backend=static_dispatch_present_backends[0],
+                        native_arguments=option['native_actuals'])
+                else:
+                    static_dispatch_function_body = STATIC_DISPATCH_FUNCTION_SWITCH_BODY.substitute(
+                        option,
+                        key_set=option['inferred_key_set'],
+                        static_dispatch_function_switches=static_dispatch_function_switches)
             else:
                 static_dispatch_function_body = STATIC_DISPATCH_FUNCTION_DEFAULT_BODY.substitute(
                     option, native_arguments=option['native_actuals'])
@@ -87,6 +87,83 @@ static void avg_pool2d_out_frame(
   });
 }
 
+/// Channels-last variant: the channel dimension is innermost and contiguous,
+/// so every window position reads and writes full channel rows and the inner
+/// loop over channels vectorizes without any layout transposes. Follows the
+/// structure of the batch norm channels-last fast path in Normalization.cpp.
+template <typename scalar_t>
+static void avg_pool2d_out_frame_nhwc(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t nbatch,
+          int64_t nInputPlane,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          bool count_include_pad,
+          c10::optional<int64_t> divisor_override)
+{
+  at::parallel_for(0, nbatch*outputHeight, 0, [&](int64_t start, int64_t end) {
+    for (auto i = start; i < end; i++)
+    {
+      const int64_t p = i / outputHeight;
+      const int64_t yy = i % outputHeight;
+      const scalar_t *batch_input = input_data + p*inputHeight*inputWidth*nInputPlane;
+      scalar_t *ptr_output = output_data + i*outputWidth*nInputPlane;
+
+      int64_t xx;
+      for(xx = 0; xx < outputWidth; xx++)
+      {
+        int64_t hstart = yy * dH - padH;
+        int64_t wstart = xx * dW - padW;
+        int64_t hend = std::min(hstart + kH, inputHeight + padH);
+        int64_t wend = std::min(wstart + kW, inputWidth + padW);
+        int pool_size = (hend - hstart) * (wend - wstart);
+        hstart = std::max(hstart, (int64_t) 0);
+        wstart = std::max(wstart, (int64_t) 0);
+        hend = std::min(hend, inputHeight);
+        wend = std::min(wend, inputWidth);
+
+        int divide_factor;
+        if (divisor_override.has_value()) {
+          divide_factor = divisor_override.value();
+        } else {
+          if(count_include_pad) {
+            divide_factor = pool_size;
+          } else {
+            divide_factor = (hend - hstart) * (wend - wstart);
+          }
+        }
+
+        scalar_t *out = ptr_output + xx*nInputPlane;
+        int64_t c;
+        for(c = 0; c < nInputPlane; c++)
+          out[c] = 0;
+
+        int64_t kx, ky;
+        for(ky = hstart; ky < hend; ky++)
+        {
+          for(kx = wstart; kx < wend; kx++)
+          {
+            const scalar_t *in = batch_input + (ky*inputWidth + kx)*nInputPlane;
+            for(c = 0; c < nInputPlane; c++)
+              out[c] += in[c];
+          }
+        }
+        for(c = 0; c < nInputPlane; c++)
+          out[c] /= divide_factor;
+      }
+    }
+  });
+}
+
 void avg_pool2d_out_cpu_template(
           Tensor &output,
           const Tensor &input_,
@@ -136,6 +213,36 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  /* channels-last fast path: keep the input layout and propagate it to the
+     output instead of forcing a transpose to NCHW and back */
+  if (input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast) &&
+      !input_.is_contiguous()) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+        at::MemoryFormat::ChannelsLast);
+    TORCH_CHECK(output.is_contiguous(at::MemoryFormat::ChannelsLast),
+        "avg_pool2d: output must be channels-last contiguous");
+
+    AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::Long, input_.scalar_type(),
+      "avg_pool2d_out_frame_nhwc",
+      [&] {
+        avg_pool2d_out_frame_nhwc<scalar_t>(
+          input_.data_ptr<scalar_t>(),
+          output.data_ptr<scalar_t>(),
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH,
+          dW, dH,
+          padW, padH,
+          count_include_pad,
+          divisor_override);
+      }
+    );
+    return;
+  }
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
@@ -318,19 +318,19 @@ static void apply_solve(Tensor& b, Tensor& A, std::vector<int64_t>& infos) {
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  auto ipiv = at::empty({n}, b.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
-
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv_data, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  // The per-matrix LAPACK calls are independent, so the batch loop is
+  // parallelized with a per-thread pivot buffer; each entry of infos is
+  // written exactly once and checked afterwards by batchCheckErrors.
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    std::vector<int> ipiv(n);
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv.data(), b_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -381,9 +381,6 @@ static void apply_inverse(Tensor& self, std::vector<int64_t>& infos) {
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  auto ipiv = at::empty({n}, self.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
-
   int info;
   // Run once, first to get the optimum work size
   // Since we deal with batches of matrices with the same dimensions, doing this outside
@@ -391,26 +388,28 @@ static void apply_inverse(Tensor& self, std::vector<int64_t>& infos) {
   // and (batch_size - 1) calls to allocate and deallocate workspace using at::empty()
   int lwork = -1;
   scalar_t wkopt;
-  lapackGetri<scalar_t>(n, self_data, n, ipiv_data, &wkopt, lwork, &info);
+  std::vector<int> ipiv_query(n);
+  lapackGetri<scalar_t>(n, self_data, n, ipiv_query.data(), &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-  auto work_data = work.data_ptr<scalar_t>();
 
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackLu<scalar_t>(n, n, self_working_ptr, n, ipiv_data, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
-    }
+  // Each thread factors and inverts with its own pivot and work buffers
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    std::vector<int> ipiv(n);
+    std::vector<scalar_t> work(lwork);
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      lapackLu<scalar_t>(n, n, self_working_ptr, n, ipiv.data(), &info);
+      infos[i] = info;
+      if (info != 0) {
+        continue;
+      }
 
-    // now compute the actual inverse
-    lapackGetri<scalar_t>(n, self_working_ptr, n, ipiv_data, work_data, lwork, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+      // now compute the actual inverse
+      lapackGetri<scalar_t>(n, self_working_ptr, n, ipiv.data(), work.data(), lwork, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -461,16 +460,15 @@ static void apply_cholesky_solve(Tensor& b, Tensor& A, bool upper, std::vector<i
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -521,15 +519,14 @@ static void apply_cholesky(Tensor& self, bool upper, std::vector<int64_t>& infos
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -585,12 +582,14 @@ static void apply_lu(Tensor& self, Tensor& pivots, Tensor& infos) {
   auto m = self.size(-2);
   auto n = self.size(-1);
 
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
-    int* infos_working_ptr = &infos_data[i];
-    lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
-  }
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
+      int* infos_working_ptr = &infos_data[i];
+      lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
+    }
+  });
 #endif
 }
 
@@ -646,12 +645,14 @@ static void apply_triangular_solve(Tensor& b, Tensor& A, bool upper, bool transp
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-  }
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+    }
+  });
 #endif
 }
 
@@ -1069,18 +1070,17 @@ static void apply_lu_solve(Tensor& b, const Tensor& lu, const Tensor& pivots, st
   auto n = lu.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* b_working_ptr = &b_data[i * b_stride];
-    scalar_t* lu_working_ptr = &lu_data[i * lu_stride];
-    int* pivots_working_ptr = &pivots_data[i * pivots_stride];
-    lapackLuSolve<scalar_t>('N', n, nrhs, lu_working_ptr, n, pivots_working_ptr,
-                            b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    int info;
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* b_working_ptr = &b_data[i * b_stride];
+      scalar_t* lu_working_ptr = &lu_data[i * lu_stride];
+      int* pivots_working_ptr = &pivots_data[i * pivots_stride];
+      lapackLuSolve<scalar_t>('N', n, nrhs, lu_working_ptr, n, pivots_working_ptr,
+                              b_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <type_traits>
 #include <ATen/native/BinaryOps.h>
 
@@ -262,7 +263,58 @@ Tensor& atan2_(Tensor& self, const Tensor& other) {
 // types (int, float, etc.) to Tensor (only to Scalar). They're not exposed
 // to Python.
 
+namespace {
+
+// Models are full of scalar-constant ops (x * 2.0, x + 1), and every one of
+// them used to materialize a fresh 0-dim TensorImpl/StorageImpl pair before
+// TensorIterator even ran. Wrapped scalar tensors are never written to (they
+// only ever appear as a non-out operand), so a small per-thread cache keyed
+// by the scalar's tag and bit pattern can hand the same tensor back.
+// Complex scalars are rare and keep the allocating path.
+constexpr size_t kWrappedScalarCacheSize = 8;
+
+struct WrappedScalarCacheEntry {
+  bool valid = false;
+  ScalarType dtype = ScalarType::Undefined;
+  int64_t bits = 0;
+  Tensor tensor;
+};
+
+thread_local WrappedScalarCacheEntry wrapped_scalar_cache[kWrappedScalarCacheSize];
+thread_local size_t wrapped_scalar_cache_next = 0;
+
+} // namespace
+
 static Tensor wrapped_scalar_tensor(Scalar scalar) {
+  if (!scalar.isComplex()) {
+    // The dtype scalar_to_tensor would pick doubles as the cache key tag.
+    const ScalarType dtype = scalar.isFloatingPoint()
+        ? ScalarType::Double
+        : (scalar.isBoolean() ? ScalarType::Bool : ScalarType::Long);
+    int64_t bits = 0;
+    if (dtype == ScalarType::Double) {
+      const double value = scalar.toDouble();
+      std::memcpy(&bits, &value, sizeof(bits));
+    } else if (dtype == ScalarType::Bool) {
+      bits = scalar.toBool() ? 1 : 0;
+    } else {
+      bits = scalar.toLong();
+    }
+    for (auto& entry : wrapped_scalar_cache) {
+      if (entry.valid && entry.dtype == dtype && entry.bits == bits) {
+        return entry.tensor;
+      }
+    }
+    auto tensor = scalar_to_tensor(scalar);
+    tensor.unsafeGetTensorImpl()->set_wrapped_number(true);
+    auto& entry =
+        wrapped_scalar_cache[wrapped_scalar_cache_next++ % kWrappedScalarCacheSize];
+    entry.valid = true;
+    entry.dtype = dtype;
+    entry.bits = bits;
+    entry.tensor = tensor;
+    return tensor;
+  }
   auto tensor = scalar_to_tensor(scalar);
   tensor.unsafeGetTensorImpl()->set_wrapped_number(true);
   return tensor;
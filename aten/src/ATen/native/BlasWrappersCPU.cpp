@@ -1,12 +1,30 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/LegacyTHFunctionsCPU.h>
+#include <ATen/native/LinearAlgebra.h>
 
 // These are wrappers around the TH Linear Algebra / BLAS wrappers (mv, mm, bmm).
 
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(small_gemm_stub);
+
+// True for matrix multiplies small enough that BLAS dispatch and threading
+// overhead dwarfs the arithmetic; those go through the vectorized
+// single-threaded micro-kernel instead of a BLAS call.
+static bool use_small_gemm(
+    const Tensor& result, const Tensor& self, const Tensor& mat2) {
+  return (self.scalar_type() == kFloat || self.scalar_type() == kDouble) &&
+      self.scalar_type() == mat2.scalar_type() &&
+      self.scalar_type() == result.scalar_type() &&
+      self.size(0) > 0 && self.size(1) > 0 && mat2.size(1) > 0 &&
+      self.size(0) <= kSmallGemmMaxDim &&
+      self.size(1) <= kSmallGemmMaxDim &&
+      mat2.size(1) <= kSmallGemmMaxDim &&
+      self.is_contiguous() && mat2.is_contiguous() && result.is_contiguous();
+}
+
 Tensor & mv_cpu_out(Tensor & result, const Tensor & self, const Tensor & vec) {
   result.resize_({ self.size(0) });
   return legacy::cpu::_th_addmv_out(result, result, self, vec, 0, 1);
@@ -18,7 +36,15 @@ Tensor mv_cpu(const Tensor & self, const Tensor & vec) {
 }
 
 Tensor & mm_cpu_out(Tensor & result, const Tensor & self, const Tensor & mat2) {
+  TORCH_CHECK(self.dim() == 2 && mat2.dim() == 2, "matrices expected, got ",
+      self.dim(), " and ", mat2.dim(), " dimensional tensors");
+  TORCH_CHECK(self.size(1) == mat2.size(0), "size mismatch, m1: ",
+      self.sizes(), ", m2: ", mat2.sizes());
   result.resize_({ self.size(0), mat2.size(1) });
+  if (use_small_gemm(result, self, mat2)) {
+    small_gemm_stub(kCPU, result, self, mat2);
+    return result;
+  }
   return legacy::cpu::_th_addmm_out(result, result, self, mat2, 0, 1);
 }
 
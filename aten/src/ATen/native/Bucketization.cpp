@@ -0,0 +1,154 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+
+/* Implement a numpy-like searchsorted and a TF-like bucketize on the CPU.
+ *
+ * - torch.searchsorted(sorted_sequence, values, right=False, out_int32=False)
+ *   sorted_sequence: N-D or 1-D tensor, sorted along its innermost dimension
+ *   values: N-D tensor or a Scalar containing the search values
+ *   right: if false, return the first suitable location that is found (the
+ *          lower bound); if true, return the last such location (the upper
+ *          bound)
+ *   out_int32: if true, the output dtype is int32 instead of int64
+ *
+ * - torch.bucketize(values, boundaries, right=False, out_int32=False)
+ *   boundaries: 1-D tensor, must be sorted
+ *   values: N-D tensor or a Scalar containing the search values
+ *   right/out_int32: as above
+ *
+ * When sorted_sequence is 1-D every value is searched in the whole sequence;
+ * otherwise values and sorted_sequence must have the same leading dimensions
+ * and each innermost row of values is searched in the matching row of
+ * sorted_sequence.
+ */
+
+namespace at { namespace native {
+
+namespace {
+
+constexpr int64_t SEARCHSORTED_GRAIN_SIZE = 200;
+
+// Branch-free binary search over `len` sorted elements starting at `data`.
+// Returns the lower bound of `value` (first index whose element compares >=)
+// or, when `right` is set, the upper bound (first index whose element
+// compares >). The probe-and-shift in the loop compiles to a conditional
+// move, so the search pipeline is not limited by branch mispredictions the
+// way a scripted bisection is.
+template <typename input_t>
+int64_t bound_search(const input_t* data, int64_t len, input_t value, bool right) {
+  int64_t base = 0;
+  while (len > 1) {
+    const int64_t half = len >> 1;
+    const input_t probe = data[base + half - 1];
+    const bool advance = right ? !(value < probe) : (probe < value);
+    base += advance ? half : 0;
+    len -= half;
+  }
+  if (len == 1) {
+    const bool advance = right ? !(value < data[base]) : (data[base] < value);
+    base += advance ? 1 : 0;
+  }
+  return base;
+}
+
+template <typename input_t, typename output_t>
+void searchsorted_cpu_contiguous(Tensor& result, const Tensor& input, const Tensor& boundaries, bool right) {
+  int64_t numel_in = input.numel();
+  // inner most dim size of input and boundaries
+  int64_t idim_in = input.dim() == 0 ? 1 : input.sizes().back();
+  int64_t idim_bd = boundaries.sizes().back();
+
+  const input_t* data_in = input.data_ptr<input_t>();
+  const input_t* data_bd = boundaries.data_ptr<input_t>();
+  output_t* data_out = result.data_ptr<output_t>();
+
+  bool is_1d_boundaries = boundaries.dim() == 1;
+  at::parallel_for(0, numel_in, SEARCHSORTED_GRAIN_SIZE, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      // If boundaries tensor is 1d, we always search the entire boundary
+      // tensor; otherwise each row of values searches its own row
+      const int64_t start_bd = is_1d_boundaries ? 0 : i / idim_in * idim_bd;
+      data_out[i] = static_cast<output_t>(
+          bound_search(data_bd + start_bd, idim_bd, data_in[i], right));
+    }
+  });
+}
+
+void searchsorted_pre_check(const Tensor& boundaries, const Tensor& input, const Tensor& output, bool out_int32) {
+  TORCH_CHECK(boundaries.dim() >= 1,
+      "searchsorted(): sorted_sequence must be at least 1 dimension, but got 0 dimension");
+  TORCH_CHECK(boundaries.dim() == 1 ||
+      (boundaries.dim() == input.dim() &&
+       boundaries.sizes().slice(0, boundaries.dim() - 1) ==
+           input.sizes().slice(0, input.dim() - 1)),
+      "searchsorted(): sorted_sequence must be 1 dimension, or have the same leading "
+      "dimensions as self when it is more than 1 dimension, but got sorted_sequence "
+      "with sizes ", boundaries.sizes(), " and self with sizes ", input.sizes());
+  TORCH_CHECK(input.dim() > 0 || boundaries.dim() == 1,
+      "searchsorted(): sorted_sequence must be 1 dimension when self is a scalar, "
+      "but got ", boundaries.dim(), " dimensions");
+  TORCH_CHECK(boundaries.scalar_type() == input.scalar_type(),
+      "searchsorted(): sorted_sequence and self must have the same dtype, but got ",
+      boundaries.scalar_type(), " and ", input.scalar_type());
+  const ScalarType out_type = out_int32 ? ScalarType::Int : ScalarType::Long;
+  TORCH_CHECK(output.scalar_type() == out_type,
+      "searchsorted(): output tensor must be of dtype ", out_type,
+      " (set by out_int32), but got ", output.scalar_type());
+}
+
+} // namespace
+
+Tensor& searchsorted_out_cpu(Tensor& result, const Tensor& sorted_sequence, const Tensor& self, bool out_int32, bool right) {
+  searchsorted_pre_check(sorted_sequence, self, result, out_int32);
+  result.resize_(self.sizes());
+  if (self.numel() == 0) {
+    return result;
+  }
+  // The kernel indexes both operands densely along the innermost dimension.
+  const Tensor seq = sorted_sequence.contiguous();
+  const Tensor values = self.contiguous();
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "searchsorted_out_cpu", [&] {
+    if (out_int32) {
+      searchsorted_cpu_contiguous<scalar_t, int32_t>(result, values, seq, right);
+    } else {
+      searchsorted_cpu_contiguous<scalar_t, int64_t>(result, values, seq, right);
+    }
+  });
+  return result;
+}
+
+Tensor searchsorted_cpu(const Tensor& sorted_sequence, const Tensor& self, bool out_int32, bool right) {
+  const ScalarType out_type = out_int32 ? ScalarType::Int : ScalarType::Long;
+  Tensor result = at::empty({0}, self.options().dtype(out_type));
+  return searchsorted_out_cpu(result, sorted_sequence, self, out_int32, right);
+}
+
+Tensor searchsorted_cpu(const Tensor& sorted_sequence, Scalar self, bool out_int32, bool right) {
+  return searchsorted_cpu(
+      sorted_sequence,
+      at::scalar_tensor(self, sorted_sequence.options()),
+      out_int32,
+      right);
+}
+
+Tensor& bucketize_out_cpu(Tensor& result, const Tensor& self, const Tensor& boundaries, bool out_int32, bool right) {
+  TORCH_CHECK(boundaries.dim() == 1,
+      "bucketize(): boundaries tensor must be 1 dimension, but got ",
+      boundaries.dim(), " dimensions");
+  return searchsorted_out_cpu(result, boundaries, self, out_int32, right);
+}
+
+Tensor bucketize_cpu(const Tensor& self, const Tensor& boundaries, bool out_int32, bool right) {
+  const ScalarType out_type = out_int32 ? ScalarType::Int : ScalarType::Long;
+  Tensor result = at::empty({0}, self.options().dtype(out_type));
+  return bucketize_out_cpu(result, self, boundaries, out_int32, right);
+}
+
+Tensor bucketize_cpu(Scalar self, const Tensor& boundaries, bool out_int32, bool right) {
+  return bucketize_cpu(
+      at::scalar_tensor(self, boundaries.options()), boundaries, out_int32, right);
+}
+
+}} // namespace at::native
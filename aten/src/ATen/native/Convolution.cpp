@@ -1,9 +1,18 @@
 #include <limits>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
+#include <ATen/native/utils/ParamsHash.h>
 #include <ATen/native/ConvUtils.h>
+#include <ATen/native/xnnpack/Engine.h>
 
 #include <ATen/Config.h>
 #if AT_NNPACK_ENABLED()
@@ -493,6 +502,294 @@ static at::Tensor subtensor(at::Tensor& tensor, int dim, int groups, int g) {
   return tensor.narrow(dim, n * g, n).contiguous();
 }
 
+#if AT_MKLDNN_ENABLED()
+static at::Tensor _convolution_mkldnn(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  return at::mkldnn_convolution(
+      input.contiguous(), weight.contiguous(),
+      bias.defined() ? bias.contiguous() : bias,
+      params.padding, params.stride, params.dilation, params.groups);
+}
+#endif
+
+// The im2col/nnpack path, with the optional depthwise 3x3 winograd fast path
+// in front. Shared between the static dispatch in _convolution and the
+// auto-tuner below (which times the winograd kernel separately and therefore
+// skips it here).
+static at::Tensor _convolution_cpu_fallback(
+    Tensor input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params, bool try_winograd) {
+  if (try_winograd && params.use_cpu_depthwise3x3_winograd(input, weight)) {
+    return convolution_depthwise3x3_winograd_stub(
+        input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+  }
+  if (params.groups == 1) {
+    return at::_convolution_nogroup(
+        input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
+  }
+  std::vector<Tensor> outputs(params.groups);
+  input = input.contiguous();
+  for (int g = 0; g < params.groups; ++g) {
+    auto input_g = subtensor(input, 1, params.groups, g);
+    auto weight_g = subtensor(weight, 0, params.groups, g);
+    auto bias_g = subtensor(bias, 0, params.groups, g);
+    outputs[g] = at::_convolution_nogroup(
+        input_g, weight_g, bias_g, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
+  }
+  return at::cat(outputs, 1);
+}
+
+// Note [CPU convolution auto-tuning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The CPU dispatch below picks between mkldnn, the depthwise 3x3 winograd
+// kernel and the im2col/nnpack fallback with static heuristics, which are
+// wrong for some networks (depthwise-heavy models on servers in particular).
+// With PYTORCH_CPU_CONV_BENCHMARK=1, convolutions for which more than one of
+// those backends is eligible are instead timed once per
+// (shape, dtype, layout, conv params) configuration -- each candidate gets a
+// warm-up run and a timed run -- and the winner is reused for every later
+// call with the same configuration, like cudnn benchmark mode but for the
+// CPU dispatch. With PYTORCH_CPU_CONV_BENCHMARK_CACHE_DIR additionally set
+// to a writable directory, winners are loaded from and appended to a file
+// there, so restarted processes skip the timing runs for shapes already
+// tuned; a file with a mismatching format is simply ignored (see
+// Note [Persistent cudnn benchmark cache] for the file handling rationale).
+namespace {
+
+enum class CpuConvBackend : int32_t {
+  Mkldnn = 0,
+  DepthwiseWinograd = 1,
+  Fallback = 2,
+};
+
+constexpr int kCpuConvTunerSpatialDim = 3;
+constexpr uint32_t kCpuConvTunerCacheMagic = 0x50544354; // "PTCT"
+constexpr uint32_t kCpuConvTunerCacheVersion = 1;
+
+struct CpuConvTunerKey {
+  int64_t input_sizes[kCpuConvTunerSpatialDim + 2];
+  int64_t weight_sizes[kCpuConvTunerSpatialDim + 2];
+  int64_t stride[kCpuConvTunerSpatialDim];
+  int64_t padding[kCpuConvTunerSpatialDim];
+  int64_t dilation[kCpuConvTunerSpatialDim];
+  int64_t groups;
+  int32_t dim;
+  int32_t dtype;
+  int32_t channels_last;
+};
+
+bool cpu_conv_benchmark_enabled() {
+  static const bool enabled = []() {
+    const char* flag = std::getenv("PYTORCH_CPU_CONV_BENCHMARK");
+    return flag != nullptr && flag[0] != '0';
+  }();
+  return enabled;
+}
+
+const char* cpu_conv_tuner_cache_dir() {
+  static const char* dir = std::getenv("PYTORCH_CPU_CONV_BENCHMARK_CACHE_DIR");
+  return dir;
+}
+
+struct CpuConvTunerCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t key_size;
+};
+
+struct CpuConvTunerCache {
+  std::mutex mutex;
+  std::unordered_map<CpuConvTunerKey, CpuConvBackend,
+      ParamsHash<CpuConvTunerKey>, ParamsEqual<CpuConvTunerKey>> map;
+  std::once_flag load_flag;
+
+  std::string persistentCacheFile() const {
+    std::ostringstream oss;
+    oss << cpu_conv_tuner_cache_dir() << "/cpu_conv_benchmark_v"
+        << kCpuConvTunerCacheVersion << ".bin";
+    return oss.str();
+  }
+
+  // Must be called with `mutex` held.
+  void loadPersistent() {
+    FILE* f = std::fopen(persistentCacheFile().c_str(), "rb");
+    if (f == nullptr) {
+      return;
+    }
+    CpuConvTunerCacheHeader header;
+    if (std::fread(&header, sizeof(header), 1, f) == 1 &&
+        header.magic == kCpuConvTunerCacheMagic &&
+        header.version == kCpuConvTunerCacheVersion &&
+        header.key_size == sizeof(CpuConvTunerKey)) {
+      CpuConvTunerKey key;
+      int32_t backend;
+      while (std::fread(&key, sizeof(key), 1, f) == 1 &&
+             std::fread(&backend, sizeof(backend), 1, f) == 1) {
+        map.emplace(key, static_cast<CpuConvBackend>(backend));
+      }
+    }
+    std::fclose(f);
+  }
+
+  // Must be called with `mutex` held.
+  void appendPersistent(const CpuConvTunerKey& key, CpuConvBackend backend) {
+    auto file = persistentCacheFile();
+    FILE* probe = std::fopen(file.c_str(), "rb");
+    const bool fresh = (probe == nullptr);
+    if (probe != nullptr) {
+      std::fclose(probe);
+    }
+    FILE* f = std::fopen(file.c_str(), "ab");
+    if (f == nullptr) {
+      return; // directory missing or not writable; stay in-memory only
+    }
+    if (fresh) {
+      CpuConvTunerCacheHeader header;
+      header.magic = kCpuConvTunerCacheMagic;
+      header.version = kCpuConvTunerCacheVersion;
+      header.key_size = sizeof(CpuConvTunerKey);
+      std::fwrite(&header, sizeof(header), 1, f);
+    }
+    int32_t backend_value = static_cast<int32_t>(backend);
+    std::fwrite(&key, sizeof(key), 1, f);
+    std::fwrite(&backend_value, sizeof(backend_value), 1, f);
+    std::fclose(f);
+  }
+
+  bool find(const CpuConvTunerKey& key, CpuConvBackend* backend) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (cpu_conv_tuner_cache_dir() != nullptr) {
+      std::call_once(load_flag, [&] { loadPersistent(); });
+    }
+    auto it = map.find(key);
+    if (it == map.end()) {
+      return false;
+    }
+    *backend = it->second;
+    return true;
+  }
+
+  void insert(const CpuConvTunerKey& key, CpuConvBackend backend) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (map.emplace(key, backend).second &&
+        cpu_conv_tuner_cache_dir() != nullptr) {
+      appendPersistent(key, backend);
+    }
+  }
+};
+
+CpuConvTunerCache& cpu_conv_tuner_cache() {
+  static CpuConvTunerCache cache;
+  return cache;
+}
+
+CpuConvTunerKey make_cpu_conv_tuner_key(
+    const Tensor& input, const Tensor& weight, const ConvParams& params) {
+  CpuConvTunerKey key;
+  // The key is hashed and compared bytewise, so padding must be zeroed.
+  std::memset(&key, 0, sizeof(key));
+  for (int64_t d = 0; d < input.dim(); ++d) {
+    key.input_sizes[d] = input.size(d);
+  }
+  for (int64_t d = 0; d < weight.dim(); ++d) {
+    key.weight_sizes[d] = weight.size(d);
+  }
+  for (size_t d = 0; d < params.stride.size(); ++d) {
+    key.stride[d] = params.stride[d];
+    key.padding[d] = params.padding[d];
+    key.dilation[d] = params.dilation[d];
+  }
+  key.groups = params.groups;
+  key.dim = static_cast<int32_t>(input.dim());
+  key.dtype = static_cast<int32_t>(input.scalar_type());
+  key.channels_last = input.dim() == 4 &&
+      input.is_contiguous(at::MemoryFormat::ChannelsLast);
+  return key;
+}
+
+Tensor run_cpu_conv_backend(
+    CpuConvBackend backend, const Tensor& input, const Tensor& weight,
+    const Tensor& bias, const ConvParams& params) {
+  switch (backend) {
+    case CpuConvBackend::Mkldnn:
+#if AT_MKLDNN_ENABLED()
+      return _convolution_mkldnn(input, weight, bias, params);
+#else
+      break;
+#endif
+    case CpuConvBackend::DepthwiseWinograd:
+      return convolution_depthwise3x3_winograd_stub(
+          input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+    case CpuConvBackend::Fallback:
+      return _convolution_cpu_fallback(
+          input, weight, bias, params, /*try_winograd=*/false);
+  }
+  TORCH_INTERNAL_ASSERT(false, "unexpected CPU convolution backend");
+}
+
+// True when auto-tuning is on and this convolution has more than one eligible
+// CPU backend, so timing them can actually change the dispatch.
+bool use_cpu_conv_tuner(
+    const Tensor& input, const Tensor& weight, const ConvParams& params,
+    bool input_is_mkldnn) {
+  if (!cpu_conv_benchmark_enabled() || input_is_mkldnn ||
+      input.options().backend() != at::Backend::CPU) {
+    return false;
+  }
+  int candidates = 1; // the fallback handles everything the CPU path accepts
+  if (params.use_mkldnn(input)) {
+    ++candidates;
+  }
+  if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
+    ++candidates;
+  }
+  return candidates > 1;
+}
+
+Tensor tune_cpu_convolution(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  const auto key = make_cpu_conv_tuner_key(input, weight, params);
+  auto& cache = cpu_conv_tuner_cache();
+
+  CpuConvBackend backend;
+  if (cache.find(key, &backend)) {
+    return run_cpu_conv_backend(backend, input, weight, bias, params);
+  }
+
+  // First encounter of this configuration: time every eligible backend and
+  // remember the winner. Each candidate gets one warm-up run so the timed run
+  // measures steady state rather than one-time weight packing.
+  c10::SmallVector<CpuConvBackend, 3> candidates;
+  if (params.use_mkldnn(input)) {
+    candidates.push_back(CpuConvBackend::Mkldnn);
+  }
+  if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
+    candidates.push_back(CpuConvBackend::DepthwiseWinograd);
+  }
+  candidates.push_back(CpuConvBackend::Fallback);
+
+  Tensor best_output;
+  CpuConvBackend best_backend = CpuConvBackend::Fallback;
+  double best_time = std::numeric_limits<double>::infinity();
+  for (const auto candidate : candidates) {
+    run_cpu_conv_backend(candidate, input, weight, bias, params);
+    const auto start = std::chrono::steady_clock::now();
+    auto output = run_cpu_conv_backend(candidate, input, weight, bias, params);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best_time) {
+      best_time = elapsed.count();
+      best_backend = candidate;
+      best_output = std::move(output);
+    }
+  }
+  cache.insert(key, best_backend);
+  return best_output;
+}
+
+} // namespace
 
 at::Tensor conv1d(
     const Tensor& input, const Tensor& weight, const Tensor& bias,
@@ -678,6 +975,9 @@ at::Tensor _convolution(
           input.contiguous(), weight, bias,
           params.padding, params.stride, params.dilation, params.groups, params.benchmark, params.deterministic);
     }
+  } else if (use_cpu_conv_tuner(input, weight, params, input_is_mkldnn)) {
+    // See Note [CPU convolution auto-tuning].
+    output = tune_cpu_convolution(input, weight, bias, params);
   } else if (params.use_mkldnn(input)) {
 #if AT_MKLDNN_ENABLED()
     TORCH_CHECK(input.options().type_equal(weight.options()),
@@ -687,8 +987,7 @@ at::Tensor _convolution(
              "Input type (", input.toString(), ") and bias type (", bias.toString(),
              ") should be the same");
     if (!input_is_mkldnn) {
-      output = at::mkldnn_convolution(input.contiguous(), weight.contiguous(), bias.defined() ? bias.contiguous() : bias,
-                                      params.padding, params.stride, params.dilation, params.groups);
+      output = _convolution_mkldnn(input, weight, bias, params);
     } else {
       // do not call contiguous on mkldnn tensor
       output = at::mkldnn_convolution(input, weight, bias,
@@ -696,23 +995,31 @@ at::Tensor _convolution(
     }
 #endif
   } else if (input.device().type() == c10::DeviceType::CPU || input.device().type() == c10::DeviceType::CUDA) {
-    if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
-      output = convolution_depthwise3x3_winograd_stub(
-        input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
-    } else if (params.groups == 1) {
-      output = at::_convolution_nogroup(
-          input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
-    } else {
-      std::vector<Tensor> outputs(params.groups);
-      input = input.contiguous();
-      for (int g = 0; g < params.groups; ++g) {
-        auto input_g = subtensor(input, 1, params.groups, g);
-        auto weight_g = subtensor(weight, 0, params.groups, g);
-        auto bias_g = subtensor(bias, 0, params.groups, g);
-        outputs[g] = at::_convolution_nogroup(
-            input_g, weight_g, bias_g, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
-      }
-      output = at::cat(outputs, 1);
+    // On mobile, route fp32 convolutions through XNNPACK's NHWC direct and
+    // indirect kernels instead of the im2col + gemm fallback below.
+#if defined(C10_MOBILE)
+    if (xnnpack::use_convolution2d(
+            input,
+            weight,
+            bias,
+            params.padding,
+            params.stride,
+            params.dilation,
+            params.groups,
+            params.transposed)) {
+      output = xnnpack::convolution2d(
+          input,
+          weight,
+          bias,
+          params.padding,
+          params.stride,
+          params.dilation,
+          params.groups);
+    } else
+#endif
+    {
+      output = _convolution_cpu_fallback(
+          input, weight, bias, params, /*try_winograd=*/true);
     }
   } else {
     // Only reach here when input is backend with out-of-source implementation.
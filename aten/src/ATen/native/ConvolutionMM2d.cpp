@@ -6,6 +6,10 @@
 #include <ATen/core/grad_mode.h>
 #include <ATen/div_rtn.h>
 #include <ATen/native/Unfold2d.h>
+#include <TH/THBlasUtils.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace at {
 namespace native {
@@ -182,6 +186,79 @@ static void slow_conv2d_update_output_frame(
   output2d.addmm_(weight, finput, 1, 1);
 }
 
+// Workspace bound for the fused im2col+GEMM path below. Each thread unfolds
+// one panel of output columns at a time into a buffer of at most this size
+// and feeds it straight into GEMM, instead of materializing the full
+// [n_input_plane * kh * kw, output_height * output_width] column matrix,
+// which for large images is kh * kw times the activation size and spills L3.
+constexpr int64_t kFusedConv2dPanelBytes = 256 * 1024;
+
+template <typename scalar_t>
+static void slow_conv2d_fused_output_frame(
+    const scalar_t* input_p,
+    scalar_t* output_p,
+    const scalar_t* weight_p,
+    scalar_t* columns_p,
+    int64_t panel_cols,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width,
+    int64_t n_input_plane,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t n_output_plane,
+    int64_t output_height,
+    int64_t output_width) {
+  const int64_t k = n_input_plane * kernel_height * kernel_width;
+  const int64_t n = output_height * output_width;
+
+  for (int64_t col_begin = 0; col_begin < n; col_begin += panel_cols) {
+    const int64_t cols = std::min(panel_cols, n - col_begin);
+
+    // Unfold just this panel of output positions into the workspace.
+    for (int64_t r = 0; r < k; r++) {
+      const int64_t c = r / (kernel_height * kernel_width);
+      const int64_t kh = (r / kernel_width) % kernel_height;
+      const int64_t kw = r % kernel_width;
+      const scalar_t* src_plane = input_p + c * input_height * input_width;
+      scalar_t* dst = columns_p + r * cols;
+      for (int64_t j = 0; j < cols; j++) {
+        const int64_t col = col_begin + j;
+        const int64_t ih =
+            (col / output_width) * stride_height - pad_height + kh;
+        const int64_t iw =
+            (col % output_width) * stride_width - pad_width + kw;
+        dst[j] =
+            (ih >= 0 && ih < input_height && iw >= 0 && iw < input_width)
+            ? src_plane[ih * input_width + iw]
+            : scalar_t(0);
+      }
+    }
+
+    // output_panel[n_output_plane, cols] += weight[n_output_plane, k] *
+    // columns[k, cols]. gemm is column-major, so compute the transpose:
+    // the row-major panel with leading dimension n is a cols x
+    // n_output_plane column-major matrix.
+    THBlas_gemm<scalar_t>(
+        'n',
+        'n',
+        cols,
+        n_output_plane,
+        k,
+        1,
+        columns_p,
+        cols,
+        weight_p,
+        k,
+        1,
+        output_p + col_begin,
+        n);
+  }
+}
+
 void slow_conv2d_backward_update_grad_input_frame(
     Tensor& grad_input,
     const Tensor& grad_output,
@@ -418,10 +495,74 @@ std::tuple<Tensor&, Tensor&, Tensor&> slow_conv2d_forward_out_cpu(
 
   const int64_t batch_size = input.size(0);
 
+  output.resize_({batch_size, n_output_plane, output_height, output_width});
+
+  // The full column matrix (finput) is an op output that only the backward
+  // pass consumes. When no backward will run, unfold and multiply one
+  // cache-sized panel at a time instead of materializing it, saving a full
+  // write+read of a buffer kh * kw times the activation size.
+  const bool requires_columns = at::GradMode::is_enabled() &&
+      (self.requires_grad() || weight_.requires_grad() ||
+       (bias.defined() && bias.requires_grad()));
+
+  if (!requires_columns &&
+      (input.scalar_type() == kFloat || input.scalar_type() == kDouble)) {
+    finput.resize_({0});
+    AT_DISPATCH_FLOATING_TYPES(
+        input.scalar_type(), "slow_conv2d_fused_cpu", [&] {
+          const int64_t k = n_input_plane * kernel_height * kernel_width;
+          const int64_t n = output_height * output_width;
+          const int64_t panel_cols = std::max<int64_t>(
+              1,
+              std::min(
+                  n,
+                  kFusedConv2dPanelBytes /
+                      (static_cast<int64_t>(sizeof(scalar_t)) * k)));
+          const Tensor bias_c = bias.defined() ? bias.contiguous() : bias;
+          const scalar_t* input_p = input.data_ptr<scalar_t>();
+          const scalar_t* weight_p = weight_2d.data_ptr<scalar_t>();
+          const scalar_t* bias_p =
+              bias_c.defined() ? bias_c.data_ptr<scalar_t>() : nullptr;
+          scalar_t* output_p = output.data_ptr<scalar_t>();
+
+          at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+            // Per-thread panel workspace, bounded by kFusedConv2dPanelBytes.
+            std::vector<scalar_t> columns(k * panel_cols);
+            for (int64_t t = start; t < end; t++) {
+              scalar_t* output_t = output_p + t * n_output_plane * n;
+              for (int64_t i = 0; i < n_output_plane; i++) {
+                std::fill(
+                    output_t + i * n,
+                    output_t + (i + 1) * n,
+                    bias_p ? bias_p[i] : scalar_t(0));
+              }
+              slow_conv2d_fused_output_frame<scalar_t>(
+                  input_p + t * n_input_plane * input_height * input_width,
+                  output_t,
+                  weight_p,
+                  columns.data(),
+                  panel_cols,
+                  kernel_height,
+                  kernel_width,
+                  stride_height,
+                  stride_width,
+                  pad_height,
+                  pad_width,
+                  n_input_plane,
+                  input_height,
+                  input_width,
+                  n_output_plane,
+                  output_height,
+                  output_width);
+            }
+          });
+        });
+    return std::tuple<Tensor&, Tensor&, Tensor&>(output, finput, fgrad_input);
+  }
+
   finput.resize_({batch_size,
                   n_input_plane * kernel_height * kernel_width,
                   output_height * output_width});
-  output.resize_({batch_size, n_output_plane, output_height, output_width});
 
   at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
     NoGradGuard no_grad;
@@ -118,6 +118,84 @@ static void max_pool2d_with_indices_out_frame(
   });
 }
 
+/// Channels-last variant: the channel dimension is innermost and contiguous,
+/// so each window position updates full channel rows of the running max and
+/// the inner loop over channels vectorizes without any layout transposes.
+/// Indices keep the same semantics as the NCHW kernel (offset into the H*W
+/// plane), so the backward pass works unchanged on either layout.
+template <typename scalar_t>
+static void max_pool2d_with_indices_out_frame_nhwc(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t *indices_data,
+          int64_t nbatch,
+          int64_t nInputPlane,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          int dilationW,
+          int dilationH)
+{
+  at::parallel_for(0, nbatch*outputHeight, 0, [&](int64_t start, int64_t end) {
+    for (auto it = start; it < end; it++)
+    {
+      const int64_t p = it / outputHeight;
+      const int64_t i = it % outputHeight;
+      const scalar_t *batch_input = input_data + p*inputHeight*inputWidth*nInputPlane;
+      scalar_t *ptr_output = output_data + it*outputWidth*nInputPlane;
+      int64_t *ptr_ind = indices_data + it*outputWidth*nInputPlane;
+
+      int64_t j;
+      for(j = 0; j < outputWidth; j++)
+      {
+        int64_t hstart = i * dH - padH;
+        int64_t wstart = j * dW - padW;
+        int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, inputHeight);
+        int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, inputWidth);
+        while(hstart < 0)
+          hstart += dilationH;
+        while(wstart < 0)
+          wstart += dilationW;
+
+        scalar_t *op = ptr_output + j*nInputPlane;
+        int64_t *indp = ptr_ind + j*nInputPlane;
+
+        int64_t c;
+        for(c = 0; c < nInputPlane; c++)
+        {
+          op[c] = -std::numeric_limits<scalar_t>::infinity();
+          indp[c] = hstart*inputWidth + wstart;
+        }
+
+        for(int64_t y = hstart; y < hend; y += dilationH)
+        {
+          for(int64_t x = wstart; x < wend; x += dilationW)
+          {
+            int64_t tcntr = y*inputWidth + x;
+            const scalar_t *in = batch_input + tcntr*nInputPlane;
+            for(c = 0; c < nInputPlane; c++)
+            {
+              scalar_t val = in[c];
+              if ((val > op[c]) || std::isnan(val))
+              {
+                op[c] = val;
+                indp[c] = tcntr;
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 void max_pool2d_with_indices_out_cpu_template(
           Tensor& output,
           Tensor& indices,
@@ -171,6 +249,35 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  /* channels-last fast path: keep the input layout and propagate it to the
+     output instead of forcing a transpose to NCHW and back */
+  if (input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast) &&
+      !input_.is_contiguous()) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+        at::MemoryFormat::ChannelsLast);
+    indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+        at::MemoryFormat::ChannelsLast);
+
+    AT_DISPATCH_FLOATING_TYPES(input_.scalar_type(),
+      "max_pool2d_with_indices_cpu",
+      [&] {
+        max_pool2d_with_indices_out_frame_nhwc<scalar_t>(
+          input_.data_ptr<scalar_t>(),
+          output.data_ptr<scalar_t>(),
+          indices.data_ptr<int64_t>(),
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH, dW, dH,
+          padW, padH,
+          dilationW, dilationH);
+      }
+    );
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -299,7 +406,7 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
           Tensor& gradInput,
           const Tensor& gradOutput_,
           const Tensor& input,
-          const Tensor& indices,
+          const Tensor& indices_,
           IntArrayRef kernel_size,
           IntArrayRef stride,
           IntArrayRef padding,
@@ -333,8 +440,10 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
   TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
     "non-empty 3D or 4D (batch mode) tensor expected for input");
 
-  /* get contiguous gradOutput */
+  /* get contiguous gradOutput and indices; a channels-last forward produces
+     channels-last indices, but their values are plane offsets either way */
   const Tensor gradOutput = gradOutput_.contiguous();
+  const Tensor indices = indices_.contiguous();
 
   /* resize */
   gradInput.resize_as_(input);
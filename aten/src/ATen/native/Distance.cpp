@@ -4,6 +4,10 @@
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/native/Distance.h>
+#include <c10/core/GradMode.h>
+
+#include <algorithm>
+#include <cmath>
 
 namespace at { namespace native {
 
@@ -16,13 +20,70 @@ Tensor pairwise_distance(const Tensor& x1, const Tensor& x2, double p, double ep
   return at::norm(x1 - x2 + eps, p, 1, keepdim);
 }
 
+// Euclidean pdist through the ||a - b||^2 = ||a||^2 + ||b||^2 - 2ab
+// decomposition, processed in row blocks so both operand blocks and their
+// GEMM product stay cache resident. The elementwise kernel in
+// cpu/DistanceOpsKernel.cpp re-reads one full operand row per output entry,
+// which falls off a cliff once the point set outgrows L2; here the dot
+// products come from a blocked mm and the norms, clamp and sqrt are fused
+// into the single pass that writes the condensed output.
+static Tensor pdist_euclidean_blocked(const Tensor& self) {
+  const int64_t n = self.size(0);
+  Tensor result = at::empty({n * (n - 1) / 2}, self.options());
+  Tensor norms = self.mul(self).sum(1);
+  // 128 rows of a few-hundred-dimensional float block weigh in around 256KB,
+  // so two operand blocks plus the block product fit typical L2 sizes.
+  constexpr int64_t kRowsPerBlock = 128;
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "pdist_euclidean_blocked", [&] {
+    const scalar_t* norms_data = norms.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    for (int64_t i = 0; i < n; i += kRowsPerBlock) {
+      const int64_t bi = std::min(kRowsPerBlock, n - i);
+      auto xi = self.narrow(0, i, bi);
+      for (int64_t j = i; j < n; j += kRowsPerBlock) {
+        const int64_t bj = std::min(kRowsPerBlock, n - j);
+        Tensor prod = at::mm(xi, self.narrow(0, j, bj).t());
+        const scalar_t* prod_data = prod.data_ptr<scalar_t>();
+        for (int64_t r = 0; r < bi; r++) {
+          const int64_t row = i + r;
+          const int64_t col_begin = std::max(j, row + 1);
+          const int64_t cols = j + bj - col_begin;
+          if (cols <= 0) {
+            continue;
+          }
+          scalar_t* out =
+              result_data + row * n - row * (row + 1) / 2 + (col_begin - row - 1);
+          const scalar_t* prod_row = prod_data + r * bj + (col_begin - j);
+          const scalar_t row_norm = norms_data[row];
+          for (int64_t s = 0; s < cols; s++) {
+            const scalar_t d =
+                row_norm + norms_data[col_begin + s] - scalar_t(2) * prod_row[s];
+            out[s] = std::sqrt(std::max(d, scalar_t(0)));
+          }
+        }
+      }
+    }
+  });
+  return result;
+}
+
 // This is to guarantee that the contiguous memory is passed to the backward pass
 Tensor pdist(const Tensor& self, const double p) {
   TORCH_CHECK(self.dim() == 2,
       "pdist only supports 2D tensors, got: ", self.dim(), "D");
   TORCH_CHECK(at::isFloatingType(self.scalar_type()), "pdist only supports floating-point dtypes");
   TORCH_CHECK(p >= 0, "pdist only supports non-negative p values");
-  return at::_pdist_forward(self.contiguous(), p);
+  auto self_ = self.contiguous();
+  // Same r > 25 cutover as cdist_impl below; forward only, since the
+  // decomposition does not share _pdist_backward's subgradient at zero
+  // distance (and loses a little precision for nearly identical rows).
+  if (p == 2 && !(at::GradMode::is_enabled() && self_.requires_grad()) &&
+      self_.device().is_cpu() &&
+      self_.size(0) > 25 && self_.size(1) > 0 &&
+      (self_.scalar_type() == kFloat || self_.scalar_type() == kDouble)) {
+    return pdist_euclidean_blocked(self_);
+  }
+  return at::_pdist_forward(self_, p);
 }
 
 Tensor euclidean_dist_out(const Tensor& x1, const Tensor& x2) {
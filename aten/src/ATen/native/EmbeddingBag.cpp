@@ -7,6 +7,7 @@
 
 #include <caffe2/perfkernels/embedding_lookup_idx.h>
 
+#include <cmath>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -775,5 +776,94 @@ Tensor _embedding_bag_sparse_backward(
   return native::embedding_backward(index_grad, indices, num_weights, -1,
                                     scale_grad_by_freq, true);
 }
+
+// Fused rowwise-sparse Adagrad step for embedding tables trained with
+// embedding_bag(mode='sum'). The gradient of row indices[i] is the bag
+// gradient grad[offset2bag[i]], so the update can be applied row by row
+// straight from the forward outputs without ever materializing (let alone
+// coalescing) the replicated sparse gradient that
+// _embedding_bag_sparse_backward builds. The optimizer keeps a single
+// accumulator per row -- the mean of the squared gradient entries -- which
+// shrinks the Adagrad state to 1/embedding_dim of its usual size; for the
+// very large tables this is intended for, that is the difference between
+// the state fitting in memory or not.
+void _embedding_bag_rowwise_adagrad_update_cpu_(
+    Tensor& weight, Tensor& state_sum, const Tensor& grad,
+    const Tensor& indices, const Tensor& offset2bag,
+    double lr, double eps) {
+  auto indices_arg = TensorArg(indices, "indices", 1);
+  checkScalarType("_embedding_bag_rowwise_adagrad_update_", indices_arg, kLong);
+  checkContiguous("_embedding_bag_rowwise_adagrad_update_", indices_arg);
+  auto offset2bag_arg = TensorArg(offset2bag, "offset2bag", 1);
+  checkScalarType(
+      "_embedding_bag_rowwise_adagrad_update_", offset2bag_arg, kLong);
+  checkContiguous("_embedding_bag_rowwise_adagrad_update_", offset2bag_arg);
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.is_contiguous(),
+      "_embedding_bag_rowwise_adagrad_update_: weight must be a contiguous "
+      "2d tensor");
+  TORCH_CHECK(
+      state_sum.dim() == 1 && state_sum.size(0) == weight.size(0) &&
+          state_sum.is_contiguous() &&
+          state_sum.scalar_type() == weight.scalar_type(),
+      "_embedding_bag_rowwise_adagrad_update_: state_sum must be a "
+      "contiguous 1d tensor with one entry per embedding row");
+  TORCH_CHECK(
+      grad.dim() == 2 && grad.size(1) == weight.size(1) &&
+          grad.scalar_type() == weight.scalar_type(),
+      "_embedding_bag_rowwise_adagrad_update_: grad must be the 2d bag "
+      "gradient matching weight's embedding dimension");
+  TORCH_CHECK(
+      indices.numel() == offset2bag.numel(),
+      "_embedding_bag_rowwise_adagrad_update_: indices and offset2bag must "
+      "have the same number of elements");
+
+  const int64_t num_samples = indices.numel();
+  const int64_t num_rows = weight.size(0);
+  const int64_t num_bags = grad.size(0);
+  const int64_t ddim = weight.size(1);
+  auto grad_contig = grad.contiguous();
+  auto* indices_data = indices.data_ptr<int64_t>();
+  auto* offset2bag_data = offset2bag.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES(
+      weight.scalar_type(), "_embedding_bag_rowwise_adagrad_update_", [&] {
+    auto* weight_data = weight.data_ptr<scalar_t>();
+    auto* state_sum_data = state_sum.data_ptr<scalar_t>();
+    auto* grad_data = grad_contig.data_ptr<scalar_t>();
+
+    // Duplicate indices have to see each other's state updates, so the
+    // samples are processed sequentially (the same choice caffe2's
+    // RowWiseSparseAdagrad makes). The per-row inner loops are dense and
+    // vectorize.
+    for (int64_t i = 0; i < num_samples; i++) {
+      auto row = indices_data[i];
+      auto bag = offset2bag_data[i];
+      TORCH_CHECK(
+          row >= 0 && row < num_rows,
+          "_embedding_bag_rowwise_adagrad_update_: index ", row,
+          " is out of bounds for a table with ", num_rows, " rows");
+      TORCH_CHECK(
+          bag >= 0 && bag < num_bags,
+          "_embedding_bag_rowwise_adagrad_update_: offset2bag entry ", bag,
+          " is out of bounds for a gradient with ", num_bags, " bags");
+      const scalar_t* grad_row = grad_data + bag * ddim;
+      scalar_t* weight_row = weight_data + row * ddim;
+
+      scalar_t grad_sq_sum = 0;
+      for (int64_t j = 0; j < ddim; j++) {
+        grad_sq_sum += grad_row[j] * grad_row[j];
+      }
+      const scalar_t moment = state_sum_data[row] + grad_sq_sum / ddim;
+      state_sum_data[row] = moment;
+      const scalar_t step =
+          static_cast<scalar_t>(lr) /
+          (std::sqrt(moment) + static_cast<scalar_t>(eps));
+      for (int64_t j = 0; j < ddim; j++) {
+        weight_row[j] -= step * grad_row[j];
+      }
+    }
+  });
+}
 }
 } // namespace at::native
@@ -0,0 +1,374 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/ForeachUtils.h>
+
+#include <cmath>
+
+namespace at {
+namespace native {
+
+// Reference implementations of the _foreach_* ops: a plain per-tensor loop.
+// These serve as the CPU kernels and as the fallback the CUDA kernels use
+// when a tensor list does not qualify for the fused multi-tensor path
+// (see ForeachUtils.h).
+
+void foreach_tensor_add_scalar_kernel_slow_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  for (auto& t : self) {
+    t.add_(scalar);
+  }
+}
+
+void foreach_tensor_mul_scalar_kernel_slow_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  for (auto& t : self) {
+    t.mul_(scalar);
+  }
+}
+
+void foreach_tensor_div_scalar_kernel_slow_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  for (auto& t : self) {
+    t.div_(scalar);
+  }
+}
+
+void foreach_tensor_add_list_kernel_slow_(
+    TensorList self,
+    TensorList other,
+    Scalar alpha) {
+  check_foreach_api_restrictions(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    self[i].add_(other[i], alpha);
+  }
+}
+
+std::vector<Tensor> foreach_tensor_add_list_kernel_slow(
+    TensorList tensors,
+    TensorList other,
+    Scalar alpha) {
+  check_foreach_api_restrictions(tensors, other);
+  std::vector<Tensor> result;
+  result.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    result.emplace_back(tensors[i].add(other[i], alpha));
+  }
+  return result;
+}
+
+std::vector<Tensor> foreach_tensor_sqrt_kernel_slow(TensorList tensors) {
+  check_foreach_api_restrictions(tensors);
+  std::vector<Tensor> result;
+  result.reserve(tensors.size());
+  for (const auto& t : tensors) {
+    result.emplace_back(t.sqrt());
+  }
+  return result;
+}
+
+void foreach_tensor_addcmul_kernel_slow_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  for (size_t i = 0; i < self.size(); i++) {
+    self[i].addcmul_(tensor1[i], tensor2[i], value);
+  }
+}
+
+void foreach_tensor_addcdiv_kernel_slow_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  for (size_t i = 0; i < self.size(); i++) {
+    self[i].addcdiv_(tensor1[i], tensor2[i], value);
+  }
+}
+
+// Global-norm gradient clipping over a tensor list: accumulate the squared
+// L2 norm of every tensor, and scale them all in place when the norm exceeds
+// max_norm. Returns the pre-clipping norm as a double scalar tensor. The
+// per-tensor-op version below doubles as the CUDA kernel.
+
+Tensor foreach_tensor_clip_grad_norm_kernel_slow_(TensorList self, double max_norm) {
+  check_foreach_api_restrictions(self);
+  double total_sq = 0;
+  for (const auto& t : self) {
+    total_sq += t.pow(2).sum().item<double>();
+  }
+  const double total_norm = std::sqrt(total_sq);
+  const double clip_coef = max_norm / (total_norm + 1e-6);
+  if (clip_coef < 1.0) {
+    for (const auto& t : self) {
+      t.mul_(clip_coef);
+    }
+  }
+  return at::scalar_tensor(total_norm, self[0].options().dtype(kDouble));
+}
+
+Tensor foreach_tensor_clip_grad_norm_kernel_cpu_(TensorList self, double max_norm) {
+  check_foreach_api_restrictions(self);
+  bool fused = self[0].scalar_type() == kFloat || self[0].scalar_type() == kDouble;
+  for (const auto& t : self) {
+    fused = fused && t.layout() == at::kStrided && t.is_non_overlapping_and_dense();
+  }
+  if (!fused) {
+    return foreach_tensor_clip_grad_norm_kernel_slow_(self, max_norm);
+  }
+  // One fused traversal per pass, parallel within each tensor; both loops
+  // are plain elementwise code the compiler vectorizes.
+  double total_sq = 0;
+  AT_DISPATCH_FLOATING_TYPES(self[0].scalar_type(), "clip_grad_norm_cpu", [&] {
+    for (const auto& t : self) {
+      const scalar_t* data = t.data_ptr<scalar_t>();
+      total_sq += at::parallel_reduce(
+          0, t.numel(), internal::GRAIN_SIZE, 0.0,
+          [data](int64_t begin, int64_t end, double acc) {
+            for (int64_t i = begin; i < end; i++) {
+              const double v = static_cast<double>(data[i]);
+              acc += v * v;
+            }
+            return acc;
+          },
+          std::plus<double>());
+    }
+    const double clip_coef = max_norm / (std::sqrt(total_sq) + 1e-6);
+    if (clip_coef < 1.0) {
+      const scalar_t coef = static_cast<scalar_t>(clip_coef);
+      for (const auto& t : self) {
+        scalar_t* data = t.data_ptr<scalar_t>();
+        at::parallel_for(0, t.numel(), internal::GRAIN_SIZE,
+            [data, coef](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            data[i] *= coef;
+          }
+        });
+      }
+    }
+  });
+  return at::scalar_tensor(std::sqrt(total_sq), self[0].options().dtype(kDouble));
+}
+
+// Fused optimizer steps: the whole parameter update runs as one
+// read-modify-write traversal per tensor instead of one full memory pass
+// per elementwise op. The `_slow_' versions express the update with regular
+// tensor ops; they define the reference semantics and serve as the fallback
+// for tensors that don't qualify for the fused path (here and in the CUDA
+// kernels).
+
+namespace {
+
+// True if every tensor in every list is dense float/double and corresponding
+// tensors across the lists share sizes and strides, i.e. the whole step can
+// run through raw data pointers indexed by one flat offset. Individually
+// dense is not enough: a channels-last grad against a contiguous param would
+// pair up the wrong elements.
+bool can_fuse_cpu_step(std::initializer_list<TensorList> lists) {
+  const auto& first = *lists.begin();
+  const auto st = first.front().scalar_type();
+  bool fused = st == kFloat || st == kDouble;
+  for (const auto& list : lists) {
+    for (size_t i = 0; i < list.size(); i++) {
+      const auto& t = list[i];
+      fused = fused && t.layout() == at::kStrided &&
+          t.is_non_overlapping_and_dense() &&
+          t.sizes() == first[i].sizes() && t.strides() == first[i].strides();
+    }
+  }
+  return fused;
+}
+
+} // namespace
+
+void fused_adam_kernel_slow_(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    int64_t step) {
+  check_foreach_api_restrictions(params, grads);
+  check_foreach_api_restrictions(params, exp_avgs, exp_avg_sqs);
+  const double bias_correction1 = 1 - std::pow(beta1, step);
+  const double bias_correction2 = 1 - std::pow(beta2, step);
+  const double step_size = lr / bias_correction1;
+  for (size_t i = 0; i < params.size(); i++) {
+    auto grad =
+        weight_decay != 0 ? grads[i].add(params[i], weight_decay) : grads[i];
+    exp_avgs[i].mul_(beta1).add_(grad, 1 - beta1);
+    exp_avg_sqs[i].mul_(beta2).addcmul_(grad, grad, 1 - beta2);
+    auto denom =
+        exp_avg_sqs[i].sqrt().div_(std::sqrt(bias_correction2)).add_(eps);
+    params[i].addcdiv_(exp_avgs[i], denom, -step_size);
+  }
+}
+
+void fused_adam_kernel_cpu_(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    int64_t step) {
+  check_foreach_api_restrictions(params, grads);
+  check_foreach_api_restrictions(params, exp_avgs, exp_avg_sqs);
+  if (!can_fuse_cpu_step({params, grads, exp_avgs, exp_avg_sqs})) {
+    return fused_adam_kernel_slow_(
+        params, grads, exp_avgs, exp_avg_sqs,
+        lr, beta1, beta2, weight_decay, eps, step);
+  }
+  const double bias_correction1 = 1 - std::pow(beta1, step);
+  const double bias_correction2 = 1 - std::pow(beta2, step);
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_adam_cpu", [&] {
+    const scalar_t b1 = static_cast<scalar_t>(beta1);
+    const scalar_t b2 = static_cast<scalar_t>(beta2);
+    const scalar_t wd = static_cast<scalar_t>(weight_decay);
+    const scalar_t e = static_cast<scalar_t>(eps);
+    const scalar_t step_size = static_cast<scalar_t>(lr / bias_correction1);
+    const scalar_t bc2_sqrt =
+        static_cast<scalar_t>(std::sqrt(bias_correction2));
+    for (size_t t = 0; t < params.size(); t++) {
+      scalar_t* p = params[t].data_ptr<scalar_t>();
+      const scalar_t* g = grads[t].data_ptr<scalar_t>();
+      scalar_t* m = exp_avgs[t].data_ptr<scalar_t>();
+      scalar_t* v = exp_avg_sqs[t].data_ptr<scalar_t>();
+      at::parallel_for(0, params[t].numel(), internal::GRAIN_SIZE,
+          [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          const scalar_t grad = g[i] + wd * p[i];
+          m[i] = b1 * m[i] + (1 - b1) * grad;
+          v[i] = b2 * v[i] + (1 - b2) * grad * grad;
+          const scalar_t denom = std::sqrt(v[i]) / bc2_sqrt + e;
+          p[i] -= step_size * m[i] / denom;
+        }
+      });
+    }
+  });
+}
+
+void fused_sgd_kernel_slow_(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  check_foreach_api_restrictions(params, grads, momentum_buffers);
+  for (size_t i = 0; i < params.size(); i++) {
+    auto d_p =
+        weight_decay != 0 ? grads[i].add(params[i], weight_decay) : grads[i];
+    const auto& buf = momentum_buffers[i];
+    buf.mul_(momentum).add_(d_p, 1 - dampening);
+    if (nesterov) {
+      d_p = d_p.add(buf, momentum);
+    } else {
+      d_p = buf;
+    }
+    params[i].add_(d_p, -lr);
+  }
+}
+
+void fused_sgd_kernel_cpu_(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  check_foreach_api_restrictions(params, grads, momentum_buffers);
+  if (!can_fuse_cpu_step({params, grads, momentum_buffers})) {
+    return fused_sgd_kernel_slow_(
+        params, grads, momentum_buffers,
+        lr, momentum, dampening, weight_decay, nesterov);
+  }
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_sgd_cpu", [&] {
+    const scalar_t mom = static_cast<scalar_t>(momentum);
+    const scalar_t damp = static_cast<scalar_t>(dampening);
+    const scalar_t wd = static_cast<scalar_t>(weight_decay);
+    const scalar_t step_size = static_cast<scalar_t>(lr);
+    for (size_t t = 0; t < params.size(); t++) {
+      scalar_t* p = params[t].data_ptr<scalar_t>();
+      const scalar_t* g = grads[t].data_ptr<scalar_t>();
+      scalar_t* buf = momentum_buffers[t].data_ptr<scalar_t>();
+      at::parallel_for(0, params[t].numel(), internal::GRAIN_SIZE,
+          [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          const scalar_t d_p = g[i] + wd * p[i];
+          buf[i] = mom * buf[i] + (1 - damp) * d_p;
+          p[i] -= step_size * (nesterov ? d_p + mom * buf[i] : buf[i]);
+        }
+      });
+    }
+  });
+}
+
+void fused_rmsprop_kernel_slow_(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    double lr,
+    double alpha,
+    double eps,
+    double weight_decay) {
+  check_foreach_api_restrictions(params, grads, square_avgs);
+  for (size_t i = 0; i < params.size(); i++) {
+    auto grad =
+        weight_decay != 0 ? grads[i].add(params[i], weight_decay) : grads[i];
+    square_avgs[i].mul_(alpha).addcmul_(grad, grad, 1 - alpha);
+    auto avg = square_avgs[i].sqrt().add_(eps);
+    params[i].addcdiv_(grad, avg, -lr);
+  }
+}
+
+void fused_rmsprop_kernel_cpu_(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    double lr,
+    double alpha,
+    double eps,
+    double weight_decay) {
+  check_foreach_api_restrictions(params, grads, square_avgs);
+  if (!can_fuse_cpu_step({params, grads, square_avgs})) {
+    return fused_rmsprop_kernel_slow_(
+        params, grads, square_avgs, lr, alpha, eps, weight_decay);
+  }
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_rmsprop_cpu", [&] {
+    const scalar_t a = static_cast<scalar_t>(alpha);
+    const scalar_t e = static_cast<scalar_t>(eps);
+    const scalar_t wd = static_cast<scalar_t>(weight_decay);
+    const scalar_t step_size = static_cast<scalar_t>(lr);
+    for (size_t t = 0; t < params.size(); t++) {
+      scalar_t* p = params[t].data_ptr<scalar_t>();
+      const scalar_t* g = grads[t].data_ptr<scalar_t>();
+      scalar_t* sa = square_avgs[t].data_ptr<scalar_t>();
+      at::parallel_for(0, params[t].numel(), internal::GRAIN_SIZE,
+          [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          const scalar_t grad = g[i] + wd * p[i];
+          sa[i] = a * sa[i] + (1 - a) * grad * grad;
+          p[i] -= step_size * grad / (std::sqrt(sa[i]) + e);
+        }
+      });
+    }
+  });
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at {
+namespace native {
+namespace {
+
+// Shared argument checks for the _foreach_* ops. All tensors within one list
+// (and across corresponding lists) must share a dtype, and corresponding
+// tensors must have matching sizes.
+void check_foreach_api_restrictions(TensorList tensors) {
+  TORCH_CHECK(tensors.size() > 0, "Tensor list must have at least one tensor.");
+  const auto expected_dtype = tensors[0].dtype();
+  for (const auto& t : tensors) {
+    TORCH_CHECK(
+        t.dtype() == expected_dtype,
+        "All tensors in the tensor list must have the same dtype.");
+  }
+}
+
+void check_foreach_api_restrictions(TensorList tensors1, TensorList tensors2) {
+  TORCH_CHECK(
+      tensors1.size() == tensors2.size(),
+      "Tensor lists must have the same number of tensors, got ",
+      tensors1.size(), " and ", tensors2.size());
+  check_foreach_api_restrictions(tensors1);
+  check_foreach_api_restrictions(tensors2);
+  TORCH_CHECK(
+      tensors1[0].dtype() == tensors2[0].dtype(),
+      "All tensor lists must have the same dtype.");
+  for (size_t i = 0; i < tensors1.size(); i++) {
+    TORCH_CHECK(
+        tensors1[i].sizes() == tensors2[i].sizes(),
+        "Corresponding tensors in the tensor lists must have the same size, got ",
+        tensors1[i].sizes(), " and ", tensors2[i].sizes());
+  }
+}
+
+void check_foreach_api_restrictions(
+    TensorList tensors1,
+    TensorList tensors2,
+    TensorList tensors3) {
+  check_foreach_api_restrictions(tensors1, tensors2);
+  check_foreach_api_restrictions(tensors1, tensors3);
+}
+
+// To fuse a tensor list into single kernel launches, all tensors must live
+// on the same CUDA device and be dense and non-overlapping, so a chunk of a
+// tensor is a contiguous range of memory. Callers fall back to a per-tensor
+// loop when this returns false.
+bool can_use_fast_route(TensorList tensors) {
+  const auto expected_device = tensors[0].device();
+  for (const auto& t : tensors) {
+    if (!t.device().is_cuda() || t.device() != expected_device) {
+      return false;
+    }
+    if (t.layout() != at::kStrided || !t.is_non_overlapping_and_dense()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The fused kernels pair elements of corresponding tensors by flat offset,
+// so paired tensors must agree on their full layout, not just be dense
+// individually: a channels-last tensor in one list combined with a
+// contiguous one in the other would silently mix up elements.
+bool have_same_layout(TensorList tensors1, TensorList tensors2) {
+  for (size_t i = 0; i < tensors1.size(); i++) {
+    if (tensors1[i].sizes() != tensors2[i].sizes() ||
+        tensors1[i].strides() != tensors2[i].strides()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool can_use_fast_route(TensorList tensors1, TensorList tensors2) {
+  return can_use_fast_route(tensors1) && can_use_fast_route(tensors2) &&
+      have_same_layout(tensors1, tensors2);
+}
+
+bool can_use_fast_route(
+    TensorList tensors1,
+    TensorList tensors2,
+    TensorList tensors3) {
+  return can_use_fast_route(tensors1) && can_use_fast_route(tensors2) &&
+      can_use_fast_route(tensors3) &&
+      have_same_layout(tensors1, tensors2) &&
+      have_same_layout(tensors1, tensors3);
+}
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -1,12 +1,19 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/WrapDimUtilsMulti.h>
+#include <ATen/native/Linear.h>
+#include <ATen/native/xnnpack/Engine.h>
 
 #include <array>
 #include <cctype>
 #include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace at { namespace native {
@@ -15,7 +22,11 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   if (input.is_mkldnn()) {
     return at::mkldnn_linear(input, weight, bias);
   }
-
+#if defined(C10_MOBILE)
+  if (xnnpack::use_linear(input, weight, bias)) {
+    return xnnpack::linear(input, weight, bias);
+  }
+#endif
   if (input.dim() == 2 && bias.defined()) {
     // Fused op is marginally faster.
     return at::addmm(bias, input, weight.t());
@@ -27,6 +38,48 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   return output;
 }
 
+DEFINE_DISPATCH(linear_activation_stub);
+
+// Linear with a fused activation epilogue. Emitted by the JIT for inference
+// graphs (see FuseLinearActivation in torch/csrc/jit/passes/fuse_linear.cpp);
+// the activation is applied in place on the linear output instead of going
+// through a separate dispatched op and, for out-of-place activations like
+// gelu, a second allocation.
+Tensor _linear_with_activation(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    std::string activation) {
+  if (input.is_mkldnn()) {
+    return at::_mkldnn_linear_with_activation(input, weight, bias, activation);
+  }
+  LinearActivation kind;
+  if (activation == "relu") {
+    kind = LinearActivation::ReLU;
+  } else if (activation == "gelu") {
+    kind = LinearActivation::GELU;
+  } else if (activation == "sigmoid") {
+    kind = LinearActivation::Sigmoid;
+  } else {
+    AT_ERROR("_linear_with_activation: unsupported activation: ", activation);
+  }
+  auto output = at::linear(input, weight, bias);
+  if (output.device().is_cpu() && output.is_contiguous() &&
+      (output.scalar_type() == kFloat || output.scalar_type() == kDouble)) {
+    linear_activation_stub(kCPU, output, kind);
+    return output;
+  }
+  switch (kind) {
+    case LinearActivation::ReLU:
+      return output.relu_();
+    case LinearActivation::GELU:
+      return at::gelu(output);
+    case LinearActivation::Sigmoid:
+      return output.sigmoid_();
+  }
+  TORCH_INTERNAL_ASSERT(false);
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
@@ -130,6 +183,95 @@ static Tensor sumproduct_pair(const Tensor& left_, const Tensor& right_, IntArra
   return result;
 }
 
+// Chooses a pairwise contraction order for einsum by dynamic programming over
+// operand subsets, minimizing the estimated multiply-add count of each
+// pairwise contraction (the product of the sizes of all indices taking part
+// in it) -- the same objective np.einsum's optimize=True uses. Contracting in
+// argument order can build intermediates far larger than necessary; for
+// multi-operand expressions the optimal order is often orders of magnitude
+// cheaper.
+//
+// `op_idx_sets[i]` has bit `idx` set iff operand i uses index idx,
+// `output_set` marks the output indices (which must never be summed), and
+// `idx_sizes[idx]` is the extent of index idx. Operands are identified by
+// position; the k-th returned pair contracts two live operands and produces a
+// new operand with id n + k, so the last pair yields the final result.
+static std::vector<std::pair<int64_t, int64_t>> plan_einsum_contraction(
+    const std::vector<uint64_t>& op_idx_sets,
+    uint64_t output_set,
+    const std::vector<int64_t>& idx_sizes) {
+  const int64_t n = op_idx_sets.size();
+  const uint64_t full = ((uint64_t)1 << n) - 1;
+
+  // union of the index sets of every subset of operands
+  std::vector<uint64_t> idx_union(full + 1, 0);
+  for (uint64_t s = 1; s <= full; s++) {
+    uint64_t low = s & ~(s - 1);
+    int64_t low_i = 0;
+    while (((uint64_t)1 << low_i) != low) {
+      low_i++;
+    }
+    idx_union[s] = idx_union[s ^ low] | op_idx_sets[low_i];
+  }
+  // indices the contraction of a subset still has to carry: those needed by
+  // the output or by an operand outside the subset
+  auto live = [&](uint64_t s) -> uint64_t {
+    return idx_union[s] & (output_set | idx_union[full & ~s]);
+  };
+  auto set_size = [&](uint64_t s) -> double {
+    double size = 1;
+    for (size_t idx = 0; idx < idx_sizes.size(); idx++) {
+      if (s & ((uint64_t)1 << idx)) {
+        size *= idx_sizes[idx];
+      }
+    }
+    return size;
+  };
+
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> best_cost(full + 1, inf);
+  std::vector<uint64_t> best_split(full + 1, 0);
+  for (int64_t i = 0; i < n; i++) {
+    best_cost[(uint64_t)1 << i] = 0;
+  }
+  // iterating subsets in numerical order visits every proper subset before
+  // its superset
+  for (uint64_t s = 1; s <= full; s++) {
+    if ((s & (s - 1)) == 0) { // singletons are free
+      continue;
+    }
+    uint64_t low = s & ~(s - 1);
+    for (uint64_t l = (s - 1) & s; l > 0; l = (l - 1) & s) {
+      if (!(l & low)) { // canonical splits: the left part holds the lowest bit
+        continue;
+      }
+      uint64_t r = s ^ l;
+      double cost = best_cost[l] + best_cost[r] + set_size(live(l) | live(r));
+      if (cost < best_cost[s]) {
+        best_cost[s] = cost;
+        best_split[s] = l;
+      }
+    }
+  }
+
+  std::vector<std::pair<int64_t, int64_t>> merges;
+  std::function<int64_t(uint64_t)> emit = [&](uint64_t s) -> int64_t {
+    if ((s & (s - 1)) == 0) {
+      int64_t i = 0;
+      while (((uint64_t)1 << i) != s) {
+        i++;
+      }
+      return i;
+    }
+    int64_t left = emit(best_split[s]);
+    int64_t right = emit(s ^ best_split[s]);
+    merges.emplace_back(left, right);
+    return n + (int64_t)merges.size() - 1;
+  };
+  emit(full);
+  return merges;
+}
+
 Tensor einsum(std::string eqn, TensorList tensors) {
   constexpr size_t number_of_letters = 26;
   std::string in_eqn;
@@ -334,29 +476,109 @@ Tensor einsum(std::string eqn, TensorList tensors) {
     preprocessed_operands.push_back(std::move(preprocessed_op));
   }
 
-  // now we reduce the indices from left to right
-  // numpy allows to optimize the path using various
-  // algorithms (see eigen_path in numpy docs)
-  // we start with the leftmost operator and reduce indices that
-  // appear only there
-  Tensor result = std::move(preprocessed_operands[0]);
-  for (int64_t idx = 0; idx < num_total_idxes; idx++) {
-    if ((last_idx_occurrence[idx] == 0)
-        && (idxes_to_preprocessed_dims[idx]>=num_output_dims)) {
-      result = result.sum(idxes_to_preprocessed_dims[idx], true);
+  // now we reduce the indices: with three or more operands we pick the
+  // pairwise contraction order by dynamic programming (like np.einsum's
+  // optimize=True) instead of reducing in argument order, which can build
+  // intermediates far larger than necessary. Plans only depend on the
+  // equation and operand shapes, so they are cached per signature.
+  const int64_t num_ops = preprocessed_operands.size();
+  std::vector<std::pair<int64_t, int64_t>> merges;
+  if (num_ops >= 3 && num_ops <= 10 && num_total_idxes <= 63) {
+    std::ostringstream key_stream;
+    key_stream << eqn;
+    for (auto& tensor : tensors) {
+      key_stream << '|';
+      for (auto size : tensor.sizes()) {
+        key_stream << size << 'x';
+      }
+    }
+    std::string key = key_stream.str();
+
+    static std::mutex plan_cache_mutex;
+    static std::unordered_map<std::string, std::vector<std::pair<int64_t, int64_t>>> plan_cache;
+    std::lock_guard<std::mutex> guard(plan_cache_mutex);
+    auto it = plan_cache.find(key);
+    if (it != plan_cache.end()) {
+      merges = it->second;
+    } else {
+      std::vector<uint64_t> op_idx_sets(num_ops, 0);
+      for (int64_t op = 0; op < num_ops; op++) {
+        for (auto idx : input_op_idxes[op]) {
+          op_idx_sets[op] |= (uint64_t)1 << idx;
+        }
+      }
+      uint64_t output_set = 0;
+      for (int64_t idx = 0; idx < num_total_idxes; idx++) {
+        if (idxes_to_preprocessed_dims[idx] < num_output_dims) {
+          output_set |= (uint64_t)1 << idx;
+        }
+      }
+      merges = plan_einsum_contraction(op_idx_sets, output_set, size_of_dims);
+      plan_cache.emplace(std::move(key), merges);
     }
   }
 
-  // now we process each tensor using sumproduct_pair
-  for (int64_t i = 1; i < (int64_t) preprocessed_operands.size(); i++) {
-    std::vector<int64_t> sum_dims;
+  Tensor result;
+  if (! merges.empty()) {
+    // idx_users[idx] = bitmask of live operands (original or intermediate)
+    // that still use the index; once the last users are contracted together
+    // the index is summed out in that contraction.
+    std::vector<uint64_t> idx_users(num_total_idxes, 0);
+    for (int64_t op = 0; op < num_ops; op++) {
+      for (auto idx : input_op_idxes[op]) {
+        idx_users[idx] |= (uint64_t)1 << op;
+      }
+    }
+    std::vector<Tensor> ops(num_ops + merges.size());
+    for (int64_t op = 0; op < num_ops; op++) {
+      ops[op] = std::move(preprocessed_operands[op]);
+    }
+    for (size_t k = 0; k < merges.size(); k++) {
+      int64_t left = merges[k].first;
+      int64_t right = merges[k].second;
+      int64_t id = num_ops + k;
+      uint64_t pair_mask = ((uint64_t)1 << left) | ((uint64_t)1 << right);
+      std::vector<int64_t> sum_dims;
+      for (int64_t idx = 0; idx < num_total_idxes; idx++) {
+        if (!(idx_users[idx] & pair_mask)) {
+          continue;
+        }
+        if ((idx_users[idx] & ~pair_mask) == 0
+            && (idxes_to_preprocessed_dims[idx] >= num_output_dims)) {
+          sum_dims.push_back(idxes_to_preprocessed_dims[idx]);
+          idx_users[idx] = 0;
+        } else {
+          idx_users[idx] = (idx_users[idx] & ~pair_mask) | ((uint64_t)1 << id);
+        }
+      }
+      ops[id] = at::native::sumproduct_pair(ops[left], ops[right], sum_dims, true);
+      ops[left] = Tensor(); // free intermediates as soon as possible
+      ops[right] = Tensor();
+    }
+    result = std::move(ops.back());
+  } else {
+    // two or fewer operands (or too many indices to plan): reduce from left
+    // to right, starting with the indices that appear in the first operand
+    // only
+    result = std::move(preprocessed_operands[0]);
     for (int64_t idx = 0; idx < num_total_idxes; idx++) {
-      if ((last_idx_occurrence[idx] == i)
+      if ((last_idx_occurrence[idx] == 0)
           && (idxes_to_preprocessed_dims[idx]>=num_output_dims)) {
-        sum_dims.push_back(idxes_to_preprocessed_dims[idx]);
+        result = result.sum(idxes_to_preprocessed_dims[idx], true);
+      }
+    }
+
+    // now we process each tensor using sumproduct_pair
+    for (int64_t i = 1; i < num_ops; i++) {
+      std::vector<int64_t> sum_dims;
+      for (int64_t idx = 0; idx < num_total_idxes; idx++) {
+        if ((last_idx_occurrence[idx] == i)
+            && (idxes_to_preprocessed_dims[idx]>=num_output_dims)) {
+          sum_dims.push_back(idxes_to_preprocessed_dims[idx]);
+        }
       }
+      result = at::native::sumproduct_pair(result, std::move(preprocessed_operands[i]), sum_dims, true);
     }
-    result = at::native::sumproduct_pair(result, std::move(preprocessed_operands[i]), sum_dims, true);
   }
   // finally, we squeeze out all non-result dimensions
   auto sizes = result.sizes().vec();
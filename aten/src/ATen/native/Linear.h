@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Activations that can be fused into the epilogue of a linear layer
+// (see _linear_with_activation in Linear.cpp).
+enum class LinearActivation : int8_t { ReLU, GELU, Sigmoid };
+
+// Applies the activation in place to the (contiguous) linear output, so the
+// epilogue is a single vectorized sweep instead of a separate activation op.
+using linear_activation_fn = void (*)(Tensor&, LinearActivation);
+DECLARE_DISPATCH(linear_activation_fn, linear_activation_stub);
+
+}} // namespace at::native
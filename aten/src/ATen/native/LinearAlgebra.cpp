@@ -5,6 +5,7 @@
 #include <ATen/native/LinearAlgebraUtils.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/LegacyTHFunctionsCPU.h>
 #include <ATen/core/grad_mode.h>
 #include <functional>
@@ -181,6 +182,57 @@ inline void baddbmm_cpu_kernel(const Tensor& result, const Tensor& self, const T
   scalar_t alpha = alpha_.to<scalar_t>();
   scalar_t beta = beta_.to<scalar_t>();
 
+  // When the result and mat2 rows are contiguous (the common case for bmm on
+  // contiguous batches), run a vectorized micro-kernel over the flattened
+  // batch*row space instead of the scalar j/k loops below: the k-loop streams
+  // rows of mat2 through the result row, which stays in L1, and the j-loop
+  // maps onto vec256. The accumulation order per output element is unchanged.
+  if (result.stride(2) == 1 && mat2.stride(2) == 1) {
+    using Vec = vec256::Vec256<scalar_t>;
+    scalar_t* r_data = result.data_ptr<scalar_t>();
+    const scalar_t* s_data = self.data_ptr<scalar_t>();
+    const scalar_t* m_data = mat2.data_ptr<scalar_t>();
+    const int64_t r_sb = result.stride(0);
+    const int64_t r_si = result.stride(1);
+    const int64_t s_sb = self.stride(0);
+    const int64_t s_si = self.stride(1);
+    const int64_t s_sk = self.stride(2);
+    const int64_t m_sb = mat2.stride(0);
+    const int64_t m_sk = mat2.stride(1);
+    int64_t grain_size = std::max(internal::GRAIN_SIZE / (js * ks), (int64_t)1);
+    parallel_for(0, bs * is, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t bi = begin; bi < end; bi++) {
+        const int64_t b = bi / is;
+        const int64_t i = bi % is;
+        scalar_t* r_row = r_data + b * r_sb + i * r_si;
+        const scalar_t* s_row = s_data + b * s_sb + i * s_si;
+        const scalar_t* m_batch = m_data + b * m_sb;
+        if (is_bmm) {
+          std::fill(r_row, r_row + js, static_cast<scalar_t>(0));
+        } else if (beta != static_cast<scalar_t>(1)) {
+          for (int64_t j = 0; j < js; j++) {
+            r_row[j] *= beta;
+          }
+        }
+        for (int64_t k = 0; k < ks; k++) {
+          const scalar_t a =
+              is_bmm ? s_row[k * s_sk] : alpha * s_row[k * s_sk];
+          const scalar_t* m_row = m_batch + k * m_sk;
+          const Vec a_vec(a);
+          int64_t j = 0;
+          for (; j + Vec::size() <= js; j += Vec::size()) {
+            (Vec::loadu(r_row + j) + a_vec * Vec::loadu(m_row + j))
+                .store(r_row + j);
+          }
+          for (; j < js; j++) {
+            r_row[j] += a * m_row[j];
+          }
+        }
+      }
+    });
+    return;
+  }
+
   auto r0 = result.accessor<scalar_t, 3>();
   auto s0 = self.accessor<scalar_t, 3>();
   auto m0 = mat2.accessor<scalar_t, 3>();
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// (result, self, mat2) -> result = self @ mat2 for small contiguous matrices
+using small_gemm_fn = void(*)(Tensor&, const Tensor&, const Tensor&);
+DECLARE_DISPATCH(small_gemm_fn, small_gemm_stub);
+
+// Matrix multiplies up to this size per dimension go through the vectorized
+// single-threaded micro-kernel instead of BLAS, whose dispatch and threading
+// overhead dwarfs the arithmetic at these sizes.
+constexpr int64_t kSmallGemmMaxDim = 64;
+
+}} // namespace at::native
@@ -10,6 +10,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 #include <numeric>
 #include <type_traits>
@@ -29,6 +30,42 @@ static inline int64_t get_target_prime(target_t* target, int64_t offset, int64_t
   }
 }
 
+// Vectorized log-sum-exp over the three transition summands of eq (6) / (10).
+// Within a time step the recursion only reads the neighbouring time step, so
+// the loop over s vectorizes; p0, p1, p2 point into that row, pre-offset so
+// that the three summands are p0[s], p1[s] and p2[s]. skip[s] is 0 where the
+// third (skip) transition is allowed and -inf where it is not, so adding it
+// knocks the summand out of the sum. lp[s] is the gathered log_prob of the
+// target prime at s. Computes, for s in [begin, end):
+//   out[s] = logsumexp(p0[s], p1[s], p2[s] + skip[s]) + lp[s]
+template<typename scalar_t>
+static inline void ctc_logsumexp_transitions(scalar_t* out, const scalar_t* p0, const scalar_t* p1, const scalar_t* p2,
+                                             const scalar_t* skip, const scalar_t* lp, int64_t begin, int64_t end) {
+  constexpr scalar_t neginf = -std::numeric_limits<scalar_t>::infinity();
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec neginf_vec(neginf);
+  const Vec zero_vec(0);
+  int64_t s = begin;
+  for (; s + Vec::size() <= end; s += Vec::size()) {
+    Vec l1 = Vec::loadu(p0 + s);
+    Vec l2 = Vec::loadu(p1 + s);
+    Vec l3 = Vec::loadu(p2 + s) + Vec::loadu(skip + s);
+    Vec lmax = vec256::maximum(vec256::maximum(l1, l2), l3);
+    lmax = Vec::blendv(lmax, zero_vec, lmax == neginf_vec); // cannot do neginf-neginf
+    Vec lse = ((l1 - lmax).exp() + (l2 - lmax).exp() + (l3 - lmax).exp()).log() + lmax;
+    (lse + Vec::loadu(lp + s)).store(out + s);
+  }
+  for (; s < end; s++) {
+    scalar_t l1 = p0[s];
+    scalar_t l2 = p1[s];
+    scalar_t l3 = p2[s] + skip[s];
+    scalar_t lmax = std::max(std::max(l1, l2), l3);
+    if (lmax == neginf)
+      lmax = 0;
+    out[s] = std::log(std::exp(l1-lmax)+std::exp(l2-lmax)+std::exp(l3-lmax))+lmax + lp[s];
+  }
+}
+
 // This kernel is a relatively straightforward implementation of the alpha calculation in the forward backward algorithm (section 4.1).
 // A (minor) twist is that we are using log-calculations to enhance numerical stability (log_probs and log_alpha).
 // The function returns the loss and the alphas, the alphas are kept for the backward step. The wrapper (ctc_loss below) hides
@@ -113,38 +150,39 @@ std::tuple<Tensor, Tensor> ctc_loss_cpu_template(const Tensor& log_probs, const
       if (target_length > 0)
         log_alpha_a[0][1] = log_probs_a[0][get_target_prime(targets_data, tg_batch_offset, tg_target_stride, 1, BLANK)];
 
-      // now the loop over the inputs
+      // the target primes and the skip-transition mask are constant over time,
+      // so gather them once per batch element (eq (6) vs eq (7))
+      int64_t s_len = 2*target_length+1;
+      std::vector<int64_t> target_primes(s_len);
+      for (int64_t s=0; s<s_len; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+      }
+      std::vector<scalar_t> skip(s_len, neginf);
+      for (int64_t s=2; s<s_len; s++) {
+        if (target_primes[s-2] != target_primes[s])
+          skip[s] = 0;
+      }
+      std::vector<scalar_t> lp(s_len);
+
+      // now the loop over the inputs; within a time step the recursion only
+      // reads row t-1, so the loop over s is vectorized (eq (6) and (7))
       for (int64_t t=1; t<input_length; t++) {
-        for (int64_t s=0; s<2*target_length+1; s++) {
-          auto current_target_prime = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
-          // this loop over s could be parallel/vectorized, too, but the required items are one index apart
-          // alternatively, one might consider moving s to the outer loop to cache current_target_prime more (but then it needs to be descending)
-          // for the cuda implementation, that gave a speed boost.
-          // This is eq (6) and (7), la1,2,3 are the three summands. We keep track of the maximum for the logsumexp calculation.
-
-          scalar_t la1 = log_alpha_a[t-1][s];
-          scalar_t lamax = la1;
-          scalar_t la2, la3;
-          if (s > 0) {
-            la2 = log_alpha_a[t-1][s-1];
-            if (la2 > lamax)
-              lamax = la2;
-          } else {
-            la2 = neginf;
-          }
-          if ((s > 1) && (get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s-2, BLANK) !=
-                          current_target_prime)) {
-            la3 = log_alpha_a[t-1][s-2];
-            if (la3 > lamax)
-              lamax = la3;
-          } else {
-            la3 = neginf;
-          }
+        for (int64_t s=0; s<s_len; s++) {
+          lp[s] = log_probs_a[t][target_primes[s]];
+        }
+        const scalar_t* prev = log_alpha_a[t-1].data();
+        scalar_t* row = log_alpha_a[t].data();
+        // s = 0 and s = 1 have no (full) predecessor window
+        row[0] = prev[0] + lp[0];
+        if (s_len > 1) {
+          scalar_t la1 = prev[1];
+          scalar_t la2 = prev[0];
+          scalar_t lamax = std::max(la1, la2);
           if (lamax == neginf) // cannot do neginf-neginf
             lamax = 0;
-          // this is the assignment of eq (6)
-          log_alpha_a[t][s] = std::log(std::exp(la1-lamax)+std::exp(la2-lamax)+std::exp(la3-lamax))+lamax + log_probs_a[t][current_target_prime];
+          row[1] = std::log(std::exp(la1-lamax)+std::exp(la2-lamax))+lamax + lp[1];
         }
+        ctc_logsumexp_transitions(row, prev, prev-1, prev-2, skip.data(), lp.data(), 2, s_len);
       }
       // the likelihood is the the sum of the last two alphas, eq (8), the loss is the negative log likelihood
       if (target_length == 0) {
@@ -245,42 +283,48 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
         }
       }
 
-      // now loop applying eq (10) / (11)
+      // as in the forward, the target primes and the skip-transition mask are
+      // constant over time, so gather them once per batch element
+      int64_t s_len = 2*target_length+1;
+      std::vector<int64_t> target_primes(s_len);
+      for (int64_t s=0; s<s_len; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+      }
+      std::vector<scalar_t> skip(s_len, neginf);
+      for (int64_t s=0; s<s_len-2; s++) {
+        if (target_primes[s+2] != target_primes[s])
+          skip[s] = 0;
+      }
+      std::vector<scalar_t> lp(s_len);
+
+      // now loop applying eq (10) / (11); the recursion only reads row t+1,
+      // so the loop over s is vectorized
       for (int64_t t=input_length-2; t>=0; t--) {
-        // this loop over s could be parallel/vectorized and doesn't really need to be descending...
-        // alternatively, one might consider moving s to the outer loop to cache current_target_prime more (but then it needs to be descending)
-        // for the cuda implementation, that gave a speed boost.
-        for (int64_t s=2*target_length; s>=0; s--) {
-          scalar_t lb1 = log_beta_a[t+1][s];
-          scalar_t lbmax = lb1;
-          scalar_t lb2, lb3;
-          auto current_target_prime = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
-          if (s < 2*target_length) {
-            lb2 = log_beta_a[t+1][s+1];
-            if (lb2 > lbmax)
-              lbmax = lb2;
-          } else {
-            lb2 = neginf;
-          }
-          if ((s < 2*target_length-1) && (get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s+2, BLANK) !=
-                                          current_target_prime)) {
-            lb3 = log_beta_a[t+1][s+2];
-            if (lb3 > lbmax)
-              lbmax = lb3;
-          } else {
-            lb3 = neginf;
-          }
+        for (int64_t s=0; s<s_len; s++) {
+          lp[s] = log_probs_a[t][target_primes[s]];
+        }
+        const scalar_t* next = log_beta_a[t+1].data();
+        scalar_t* row = log_beta_a[t].data();
+        ctc_logsumexp_transitions(row, next, next+1, next+2, skip.data(), lp.data(), 0, std::max<int64_t>(s_len-2, 0));
+        // the last two s have no (full) successor window
+        if (s_len > 1) {
+          int64_t s = s_len-2;
+          scalar_t lb1 = next[s];
+          scalar_t lb2 = next[s+1];
+          scalar_t lbmax = std::max(lb1, lb2);
           if (lbmax == neginf)
             lbmax = 0;
-
-          log_beta_a[t][s] = std::log(std::exp(lb1-lbmax)+std::exp(lb2-lbmax)+std::exp(lb3-lbmax))+lbmax + log_probs_a[t][current_target_prime];
-          // one might check whether one can vectorize this better when done after the t-loop...
-          // now that we have beta, we fill in the sum of alpha*beta in eq (16)
-          // in contrast to the cuda implementation, we only parallelize over the batch, so we don't have a concurrency
-          // issue (several s can map to the same target character)
-          // collected[b, t, target'[s]] "log+=" log_alpha[t, s]+log_beta[t, s]
-          scalar_t log_alpha_beta =  log_alpha_a[t][s] + log_beta_a[t][s];
-          scalar_t &lcab = grad_a[t][current_target_prime];
+          row[s] = std::log(std::exp(lb1-lbmax)+std::exp(lb2-lbmax))+lbmax + lp[s];
+        }
+        row[s_len-1] = next[s_len-1] + lp[s_len-1];
+
+        // now that we have beta, we fill in the sum of alpha*beta in eq (16)
+        // in contrast to the cuda implementation, we only parallelize over the batch, so we don't have a concurrency
+        // issue (several s can map to the same target character)
+        // collected[b, t, target'[s]] "log+=" log_alpha[t, s]+log_beta[t, s]
+        for (int64_t s=s_len-1; s>=0; s--) {
+          scalar_t log_alpha_beta =  log_alpha_a[t][s] + row[s];
+          scalar_t &lcab = grad_a[t][target_primes[s]];
           if (lcab == neginf) {
             lcab = log_alpha_beta;
           } else {
@@ -292,14 +336,34 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
 
       // now grad has the sum of eq (16)
       // now we wrap up the calculation by adding in the remaining items of eq (16)
-      // this could be a great target for further vectorization.
       // grad is the output gradient, nll is the loss. Note that the likelihood -nll is the Z of eq (16)
+      // the grad rows are contiguous by construction, so this vectorizes
+      // whenever the log_probs rows are too
       scalar_t gr =  grad_out.accessor<scalar_t, 1>()[b];
-      for (int64_t t = 0; t < input_length; t++) { // or go for the full thing?
-        for (int64_t c = 0; c < num_labels; c++) {
-          scalar_t& res = grad_a[t][c];
-          scalar_t lp = log_probs_a[t][c];
-          res = (std::exp(lp)-std::exp(res + nll - lp)) * gr;
+      if (lpp.stride(2) == 1) {
+        using Vec = vec256::Vec256<scalar_t>;
+        const Vec gr_vec(gr);
+        const Vec nll_vec(nll);
+        for (int64_t t = 0; t < input_length; t++) {
+          const scalar_t* lp_row = log_probs_a[t].data();
+          scalar_t* res_row = grad_a[t].data();
+          int64_t c = 0;
+          for (; c + Vec::size() <= num_labels; c += Vec::size()) {
+            Vec lpc = Vec::loadu(lp_row + c);
+            Vec res = Vec::loadu(res_row + c);
+            ((lpc.exp() - (res + nll_vec - lpc).exp()) * gr_vec).store(res_row + c);
+          }
+          for (; c < num_labels; c++) {
+            res_row[c] = (std::exp(lp_row[c])-std::exp(res_row[c] + nll - lp_row[c])) * gr;
+          }
+        }
+      } else {
+        for (int64_t t = 0; t < input_length; t++) { // or go for the full thing?
+          for (int64_t c = 0; c < num_labels; c++) {
+            scalar_t& res = grad_a[t][c];
+            scalar_t lpc = log_probs_a[t][c];
+            res = (std::exp(lpc)-std::exp(res + nll - lpc)) * gr;
+          }
         }
       }
       // zero the remainder
@@ -4,6 +4,8 @@
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 
+#include <cmath>
+
 namespace at {
 namespace native {
 
@@ -323,6 +325,216 @@ void nll_loss_backward_out_cpu_template(
       });
 }
 
+// Fused cross entropy (log_softmax followed by nll_loss) over a 2D input.
+// Each row is traversed twice (max, then sum of exponentials), both passes
+// vectorizable, instead of materializing the full log-softmax output and
+// walking it again in nll_loss. Accumulation happens in acc_type.
+
+template <typename scalar_t>
+static void cross_entropy_loss_out_frame(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  const auto batch_size = input.size(0);
+  const auto n_classes = input.size(1);
+
+  auto input_acc = input.accessor<scalar_t, 2>();
+  auto target_acc = target.accessor<int64_t, 1>();
+
+  auto weight_contiguous = optional_contiguous(weight);
+  const scalar_t* weight_data = optional_data<scalar_t>(weight_contiguous);
+
+  // Per-row losses and weights; the reduction over the batch is cheap
+  // compared to the per-row traversals, so it stays serial.
+  std::vector<accscalar_t> losses(batch_size);
+  std::vector<accscalar_t> row_weights(batch_size);
+
+  at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+    for (auto i = start; i < end; i++) {
+      const auto cur_target = target_acc[i];
+
+      if (cur_target == ignore_index) {
+        losses[i] = 0;
+        row_weights[i] = 0;
+        continue;
+      }
+
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+
+      const auto row = input_acc[i];
+      accscalar_t max_input = row[0];
+      for (int64_t j = 1; j < n_classes; j++) {
+        max_input = std::max(max_input, static_cast<accscalar_t>(row[j]));
+      }
+      accscalar_t sum_exp = 0;
+      for (int64_t j = 0; j < n_classes; j++) {
+        sum_exp += std::exp(static_cast<accscalar_t>(row[j]) - max_input);
+      }
+
+      const accscalar_t cur_weight = weight_data != nullptr
+          ? static_cast<accscalar_t>(weight_data[cur_target])
+          : static_cast<accscalar_t>(1);
+      losses[i] =
+          (max_input + std::log(sum_exp) -
+           static_cast<accscalar_t>(row[cur_target])) *
+          cur_weight;
+      row_weights[i] = cur_weight;
+    }
+  });
+
+  if (reduction == Reduction::None) {
+    output.resize_({batch_size});
+    auto output_acc = output.accessor<scalar_t, 1>();
+    for (int64_t i = 0; i < batch_size; i++) {
+      output_acc[i] = static_cast<scalar_t>(losses[i]);
+    }
+    return;
+  }
+
+  accscalar_t output_val = 0;
+  accscalar_t total_weight_val = 0;
+  for (int64_t i = 0; i < batch_size; i++) {
+    output_val += losses[i];
+    total_weight_val += row_weights[i];
+  }
+
+  if (reduction == Reduction::Mean &&
+      (total_weight_val != 0 || input.numel() == 0)) {
+    // allow NaN result for total_weight_val == 0 case, see #15870
+    output_val /= total_weight_val;
+  }
+
+  output.resize_({});
+  *output.data_ptr<scalar_t>() = static_cast<scalar_t>(output_val);
+}
+
+template <typename scalar_t>
+static void cross_entropy_loss_backward_out_frame(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  const auto batch_size = input.size(0);
+  const auto n_classes = input.size(1);
+
+  auto grad_input_acc = grad_input.accessor<scalar_t, 2>();
+  auto input_acc = input.accessor<scalar_t, 2>();
+  auto target_acc = target.accessor<int64_t, 1>();
+
+  auto weight_contiguous = optional_contiguous(weight);
+  const scalar_t* weight_data = optional_data<scalar_t>(weight_contiguous);
+
+  // Recompute the total weight for the mean reduction; an O(batch) pass is
+  // cheaper than carrying it through as nll_loss does.
+  accscalar_t total_weight_val = 0;
+  if (reduction == Reduction::Mean) {
+    for (int64_t i = 0; i < batch_size; i++) {
+      const auto cur_target = target_acc[i];
+      if (cur_target == ignore_index) {
+        continue;
+      }
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+      total_weight_val += weight_data != nullptr
+          ? static_cast<accscalar_t>(weight_data[cur_target])
+          : static_cast<accscalar_t>(1);
+    }
+    if (total_weight_val <= 0) {
+      grad_input.zero_();
+      return;
+    }
+  }
+
+  auto grad_output_contiguous = grad_output.contiguous();
+  const scalar_t* grad_output_data = grad_output_contiguous.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+    for (auto i = start; i < end; i++) {
+      const auto cur_target = target_acc[i];
+      auto grad_row = grad_input_acc[i];
+
+      if (cur_target == ignore_index) {
+        for (int64_t j = 0; j < n_classes; j++) {
+          grad_row[j] = 0;
+        }
+        continue;
+      }
+
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+
+      const auto row = input_acc[i];
+      accscalar_t max_input = row[0];
+      for (int64_t j = 1; j < n_classes; j++) {
+        max_input = std::max(max_input, static_cast<accscalar_t>(row[j]));
+      }
+      accscalar_t sum_exp = 0;
+      for (int64_t j = 0; j < n_classes; j++) {
+        sum_exp += std::exp(static_cast<accscalar_t>(row[j]) - max_input);
+      }
+
+      accscalar_t coeff = reduction == Reduction::None
+          ? static_cast<accscalar_t>(grad_output_data[i])
+          : static_cast<accscalar_t>(grad_output_data[0]);
+      if (weight_data != nullptr) {
+        coeff *= static_cast<accscalar_t>(weight_data[cur_target]);
+      }
+      if (reduction == Reduction::Mean) {
+        coeff /= total_weight_val;
+      }
+
+      // grad = coeff * (softmax(input) - onehot(target)) in a single pass
+      const accscalar_t inv_sum = static_cast<accscalar_t>(1) / sum_exp;
+      for (int64_t j = 0; j < n_classes; j++) {
+        grad_row[j] = static_cast<scalar_t>(
+            coeff * std::exp(static_cast<accscalar_t>(row[j]) - max_input) *
+            inv_sum);
+      }
+      grad_row[cur_target] = static_cast<scalar_t>(
+          static_cast<accscalar_t>(grad_row[cur_target]) - coeff);
+    }
+  });
+}
+
+static void cross_entropy_loss_check_args(
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight) {
+  TORCH_CHECK(
+      input.dim() == 2, "_cross_entropy_loss: expected a 2D input tensor");
+  TORCH_CHECK(
+      target.dim() == 1,
+      "1D target tensor expected, multi-target not supported");
+  TORCH_CHECK(
+      input.size(0) == target.size(0),
+      "size mismatch (got input: ",
+      input.sizes(),
+      ", target: ",
+      target.sizes(),
+      ")");
+  TORCH_CHECK(
+      !weight.defined() || weight.numel() == input.size(1),
+      "weight tensor should be defined either for all or no classes");
+}
+
 } // namespace
 
 std::tuple<Tensor&, Tensor&> nll_loss_forward_out_cpu(
@@ -393,5 +605,40 @@ Tensor nll_loss_backward_cpu(
   return grad_input;
 }
 
+Tensor cross_entropy_loss_cpu(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  cross_entropy_loss_check_args(self, target, weight);
+
+  auto output = at::empty({0}, self.options());
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "cross_entropy_loss_out_frame", [&] {
+        cross_entropy_loss_out_frame<scalar_t>(
+            output, self, target, weight, reduction, ignore_index);
+      });
+  return output;
+}
+
+Tensor cross_entropy_loss_backward_cpu(
+    const Tensor& grad_output,
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  cross_entropy_loss_check_args(self, target, weight);
+
+  auto grad_input = at::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "cross_entropy_loss_backward_out_frame", [&] {
+        cross_entropy_loss_backward_out_frame<scalar_t>(
+            grad_input, grad_output, self, target, weight, reduction, ignore_index);
+      });
+  return grad_input;
+}
+
 } // namespace native
 } // namespace at
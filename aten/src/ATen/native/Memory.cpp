@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/MemoryOverlap.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/detail/CUDAHooksInterface.h>
 #include <c10/util/Exception.h>
@@ -9,6 +10,52 @@
 namespace at {
 namespace native {
 
+namespace {
+
+// Buffers at least this large are pinned by registering their existing pages
+// with the driver instead of copying into a freshly allocated pinned block.
+// The registration has a fixed driver call cost plus per-page work, so for
+// small tensors a copy into a (cached) pinned allocation is faster.
+constexpr size_t kMinBytesToRegisterPinned = 1024 * 1024;
+
+// Deleter context for a storage whose pages were pinned in place: undoes the
+// registration right before the original deleter releases the memory.
+struct RegisteredPinnedContext {
+  at::DataPtr original;
+};
+
+void deleteRegisteredPinnedContext(void* raw_ctx) {
+  auto* ctx = static_cast<RegisteredPinnedContext*>(raw_ctx);
+  detail::getCUDAHooks().unregisterPinnedMemory(ctx->original.get());
+  delete ctx;
+}
+
+// Tries to pin `self`'s storage in place via host memory registration.
+// Returns false when the buffer is too small, CUDA is unavailable, or the
+// driver rejects the registration; the caller then falls back to a pinned
+// copy.
+bool pin_storage_by_registration(const Tensor& self, size_t min_bytes) {
+  const auto& storage = self.storage();
+  if (storage.capacity() < min_bytes || !storage.data()) {
+    return false;
+  }
+  if (!detail::getCUDAHooks().registerPinnedMemory(
+          storage.data(), storage.capacity())) {
+    return false;
+  }
+  // Wrap the storage's data pointer so the registration is undone right
+  // before whichever allocator owns the memory frees it.
+  at::DataPtr original = storage.set_data_ptr(at::DataPtr());
+  void* data = original.get();
+  Device device = original.device();
+  auto* ctx = new RegisteredPinnedContext{std::move(original)};
+  storage.set_data_ptr(
+      at::DataPtr(data, ctx, &deleteRegisteredPinnedContext, device));
+  return true;
+}
+
+} // namespace
+
 bool is_pinned(const Tensor& self) {
   return detail::getCUDAHooks().isPinnedPtr(self.storage().data());
 }
@@ -32,6 +79,69 @@ Tensor pin_memory(const Tensor& self) {
   return tensor;
 }
 
+// Pins `self`'s storage in place by registering its existing pages with the
+// driver: no pinned allocation, no copy, and every view of the storage
+// becomes pinned. Unlike the size-gated heuristic in _pin_memory_batch this
+// is an explicit opt-in, so registration is attempted regardless of size and
+// a driver rejection is an error rather than a silent fallback.
+Tensor& _pin_memory_inplace_(Tensor& self) {
+  if (self.options().backend() != Backend::CPU) {
+    AT_ERROR("cannot pin '", self.toString(), "' only dense CPU tensors can be pinned");
+  }
+  if (self.is_pinned()) {
+    return self;
+  }
+  TORCH_CHECK(
+      pin_storage_by_registration(self, /*min_bytes=*/1),
+      "_pin_memory_inplace_: registering the tensor's memory with the driver "
+      "failed; use pin_memory() to pin a copy instead");
+  return self;
+}
+
+// Pins every tensor of a sample in one pass. Used by the DataLoader pin
+// thread, where pinning tensors one at a time on one thread is the input
+// bottleneck on multi-GPU nodes. Large tensors may be pinned in place by
+// registering their existing pages with the driver (in which case the input
+// tensor itself is returned, now pinned); the remaining tensors are copied
+// into pinned allocations, with the copies spread across the intra-op thread
+// pool.
+std::vector<Tensor> _pin_memory_batch(TensorList tensors) {
+  std::vector<Tensor> pinned(tensors.size());
+  std::vector<size_t> copies;
+  copies.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const auto& tensor = tensors[i];
+    if (tensor.options().backend() != Backend::CPU) {
+      AT_ERROR("cannot pin '", tensor.toString(), "' only dense CPU tensors can be pinned");
+    }
+    if (tensor.is_pinned()) {
+      pinned[i] = tensor;
+      continue;
+    }
+    if (pin_storage_by_registration(tensor, kMinBytesToRegisterPinned)) {
+      pinned[i] = tensor;
+      continue;
+    }
+    auto* allocator = detail::getCUDAHooks().getPinnedMemoryAllocator();
+    auto storage = Storage(
+        tensor.dtype(),
+        detail::computeStorageSize(tensor.sizes(), tensor.strides()),
+        allocator,
+        /*resizable=*/false
+    );
+    pinned[i] = at::empty({0}, tensor.options())
+                    .set_(storage, 0, tensor.sizes(), tensor.strides());
+    copies.push_back(i);
+  }
+  // The copies dominate the cost; run one per task so they overlap.
+  at::parallel_for(0, copies.size(), 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      pinned[copies[i]].copy_(tensors[copies[i]]);
+    }
+  });
+  return pinned;
+}
+
 // Exposes at::has_internal_overlap as an operator for testing purposes
 int64_t _debug_has_internal_overlap(const Tensor& self) {
   return static_cast<int64_t>(at::has_internal_overlap(self));
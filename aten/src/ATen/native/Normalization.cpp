@@ -17,6 +17,7 @@ static const int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(batch_norm_cpu_inference_contiguous_stub);
+DEFINE_DISPATCH(batch_norm_cpu_collect_stats_contiguous_stub);
 
 namespace {
   void check_dims_match_num_input_features(const char* arg_name, int64_t expected, int64_t actual){
@@ -230,6 +231,32 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
+  if (input.is_contiguous()) {
+    // collect mean and M2 (sum of squared deviations from the mean) for all
+    // channels in a single vectorized pass over the input
+    Tensor var_sum = at::empty({n_input}, input.options());
+    batch_norm_cpu_collect_stats_contiguous_stub(kCPU, save_mean, var_sum, input);
+    auto var_sum_a = var_sum.accessor<scalar_t, 1>();
+    parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
+      for (int64_t f = b_begin; f < b_end; ++f) {
+        save_var_transform_a[f] =
+            VarTransform<accscalar_t>{}(accscalar_t(var_sum_a[f]) / n, eps);
+
+        // update running averages
+        if (running_mean.defined()) {
+          running_mean_a[f] =
+              momentum * save_mean_a[f] + (1 - momentum) * running_mean_a[f];
+        }
+        if (running_var.defined()) {
+          accscalar_t unbiased_var = accscalar_t(var_sum_a[f]) / (n - 1);
+          running_var_a[f] =
+              momentum * unbiased_var + (1 - momentum) * running_var_a[f];
+        }
+      }
+    });
+    return std::make_tuple(save_mean, save_var_transform);
+  }
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
     for (int64_t f = b_begin; f < b_end; ++f) {
       Tensor in = input.select(1, f);
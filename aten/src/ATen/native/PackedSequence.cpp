@@ -181,4 +181,109 @@ std::tuple<Tensor, Tensor> _pad_packed_sequence(const Tensor& data, const Tensor
   return std::make_tuple(output, lengths_t);
 }
 
+// NOTE [ ragged sequence batches ]
+//
+// A PackedSequence is time-major: step t of every sequence is stored before
+// step t+1 of any sequence, which is the order RNN kernels consume. A ragged
+// batch is the batch-major counterpart: all tokens of sequence b are stored
+// contiguously, followed by the tokens of sequence b+1, with an exclusive
+// prefix-sum `offsets` tensor (length batch_size + 1) recording where each
+// sequence starts. Because the layout is just a concatenation of the real
+// tokens, token-wise ops (embedding lookup, linear, pointwise activations)
+// apply to `data` directly with no padding FLOPs, and per-sequence reductions
+// (e.g. _ragged_softmax) only need `offsets`. Unlike _pack_padded_sequence,
+// the lengths do not have to be sorted.
+//
+// `data` can be on arbitrary device and of arbitrary dtype, but `lengths` and
+// `offsets` must be CPU int64 tensors, matching `batch_sizes` above.
+
+std::tuple<Tensor, Tensor> _pack_ragged_sequence(const Tensor& input, const Tensor& _lengths, bool batch_first) {
+  auto lengths_t = _lengths.contiguous();
+  checkLongTensor(lengths_t);
+
+  auto padded = batch_first ? input : input.transpose(0, 1); // (B, T, *)
+  int64_t batch_size = padded.size(0);
+  int64_t max_length = padded.size(1);
+  int64_t* lengths = lengths_t.data_ptr<int64_t>();
+  TORCH_CHECK(input.numel() > 0, "Cannot pack empty tensors.");
+  TORCH_CHECK(lengths_t.size(0) == batch_size,
+           "Expected `len(lengths)` to be equal to batch_size, but got ", lengths_t.size(0),
+           " (batch_size=", batch_size, ")");
+
+  at::Tensor offsets_t = at::empty(batch_size + 1, lengths_t.options());
+  int64_t* offsets = offsets_t.data_ptr<int64_t>();
+  offsets[0] = 0;
+
+  std::vector<at::Tensor> steps;
+  steps.reserve(batch_size);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    int64_t l = lengths[b];
+    TORCH_CHECK(l > 0 && l <= max_length,
+             "Length of all samples has to be in [1, ", max_length, "], but found ", l,
+             " in 'lengths'");
+    steps.push_back(padded.select(0, b).slice(0, 0, l));
+    offsets[b + 1] = offsets[b] + l;
+  }
+
+  return std::make_tuple(at::cat(steps), offsets_t);
+}
+
+Tensor _pack_ragged_sequence_backward(const Tensor& grad, at::IntArrayRef input_size, const Tensor& _offsets, bool batch_first) {
+  auto offsets_t = _offsets.contiguous();
+  checkLongTensor(offsets_t);
+
+  auto grad_input = at::zeros(input_size, grad.options());
+  auto grad_padded = batch_first ? grad_input : grad_input.transpose(0, 1);
+  int64_t batch_size = offsets_t.size(0) - 1;
+  int64_t* offsets = offsets_t.data_ptr<int64_t>();
+  for (int64_t b = 0; b < batch_size; ++b) {
+    grad_padded.select(0, b).slice(0, 0, offsets[b + 1] - offsets[b])
+        .copy_(grad.slice(0, offsets[b], offsets[b + 1]));
+  }
+  return grad_input;
+}
+
+std::tuple<Tensor, Tensor> _pad_ragged_sequence(const Tensor& data, const Tensor& _offsets, bool batch_first, Scalar padding_value, int64_t total_length) {
+  auto offsets_t = _offsets.contiguous();
+  checkLongTensor(offsets_t);
+  TORCH_CHECK(offsets_t.size(0) >= 1, "'offsets' argument should have at least one element");
+
+  int64_t batch_size = offsets_t.size(0) - 1;
+  int64_t* offsets = offsets_t.data_ptr<int64_t>();
+  at::Tensor lengths_t = at::empty(batch_size, offsets_t.options());
+  int64_t* lengths = lengths_t.data_ptr<int64_t>();
+  int64_t max_length = 0;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    lengths[b] = offsets[b + 1] - offsets[b];
+    max_length = std::max(max_length, lengths[b]);
+  }
+  if (total_length > 0) {
+    TORCH_CHECK(total_length >= max_length,
+             "Expected total_length to be at least the length of the longest "
+             "sequence in input, but got total_length=", total_length, " and "
+             "max sequence length being ", max_length);
+    max_length = total_length;
+  }
+
+  std::vector<int64_t> output_size; // == [batch_size, max_length, *data.size()[1:]]
+  {
+    output_size.reserve(data.dim() + 1);
+    output_size.push_back(batch_size);
+    output_size.push_back(max_length);
+    auto s_data_size = data.sizes().slice(1);
+    output_size.insert(output_size.end(), s_data_size.begin(), s_data_size.end());
+  }
+  auto output = at::full(output_size, padding_value, data.options());
+
+  for (int64_t b = 0; b < batch_size; ++b) {
+    output.select(0, b).slice(0, 0, lengths[b]).copy_(data.slice(0, offsets[b], offsets[b + 1]));
+  }
+
+  if (!batch_first) {
+    output = output.transpose(0, 1);
+  }
+
+  return std::make_tuple(output, lengths_t);
+}
+
 }} // namespace at::native
@@ -6,6 +6,7 @@
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/native/c10_utils.h>
+#include <c10/core/GradMode.h>
 
 namespace at { namespace native {
 
@@ -443,6 +444,22 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
 
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
+
+    // Inference fast path: one fused vectorized pass over the gate buffer
+    // producing hy/cy, instead of materializing every activation and product
+    // in its own temporary. The fused kernel saves no intermediates, so it is
+    // only taken when no gradient can be required.
+    if (!at::GradMode::is_enabled() && gates.dim() == 2 && cx.dim() == 2 &&
+        gates.is_contiguous() && gates.size(1) == 4 * cx.size(1) &&
+        gates.scalar_type() == cx.scalar_type() &&
+        (gates.scalar_type() == kFloat || gates.scalar_type() == kDouble)) {
+      auto cx_contig = cx.contiguous();
+      auto hy = at::empty_like(cx_contig);
+      auto cy = at::empty_like(cx_contig);
+      fused_lstm_cell_cpu_stub(kCPU, hy, cy, gates, cx_contig);
+      return std::make_tuple(std::move(hy), std::move(cy));
+    }
+
     auto chunked_gates = gates.chunk(4, 1);
     auto ingate = chunked_gates[0].sigmoid_();
     auto forgetgate = chunked_gates[1].sigmoid_();
@@ -937,65 +954,13 @@ std::tuple<Tensor, Tensor> NAME(                                               \
   return std::make_tuple(std::move(packed_output.data), std::move(std::get<1>(result)));             \
 }
 
-#define ONE_HIDDEN_QRNN(NAME, CELL)                                             \
-std::tuple<Tensor, Tensor> NAME(                                               \
-    const Tensor& _input, \
-    const Tensor& hx, \
-    TensorList _params, \
-    bool has_biases, \
-    int64_t num_layers, \
-    double dropout_p,  \
-    bool train, \
-    bool bidirectional, \
-    bool batch_first) { \
-  if (at::cudnn_is_acceptable(_input)) {                                       \
-    Tensor output, hy;                                                         \
-    gru_cudnn_stub(_input.device().type(), output, hy, _input, hx, _params, has_biases, \
-            num_layers, dropout_p, train, bidirectional, batch_first);         \
-    return std::make_tuple(std::move(output), std::move(hy));                  \
-  }                                                                            \
-  check_device(_input, _params, hx); \
-  auto input = batch_first ? _input.transpose(0, 1) : _input;                  \
-  auto params = gather_quantized_params(_params);                            \
-  auto results = _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>( \
-      input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional); \
-  if (batch_first) {                                                           \
-    std::get<0>(results).transpose_(0, 1);               \
-  }                                                                            \
-  return results;                                                              \
-}                                                                              \
-                                                                               \
-std::tuple<Tensor, Tensor> NAME(                                               \
-    const Tensor& data, \
-    const Tensor& batch_sizes, \
-    const Tensor& hx, \
-    TensorList _params, \
-    bool has_biases, \
-    int64_t num_layers, \
-    double dropout_p, \
-    bool train, \
-    bool bidirectional) {  \
-  if (at::cudnn_is_acceptable(data)) {                                         \
-    Tensor output, hy;                                                         \
-    gru_packed_cudnn_stub(data.device().type(), output, hy, data, batch_sizes, hx, \
-            _params, has_biases, num_layers, dropout_p, train, bidirectional); \
-    return std::make_tuple(std::move(output), std::move(hy));                                        \
-  }                                                                            \
-  PackedSequence input { data, batch_sizes };                                  \
-  auto params = gather_quantized_params(_params);                            \
-  auto result = _rnn_impl_with_concat<CELL, PackedLayer, PackedBidirectionalLayer>( \
-          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional); \
-  auto & packed_output = std::get<0>(result);                                  \
-  return std::make_tuple(std::move(packed_output.data), std::move(std::get<1>(result)));             \
-}
-
 ONE_HIDDEN_RNN(gru, GRUCell<CellParams>)
-ONE_HIDDEN_QRNN(quantized_gru, GRUCell<QuantizedCellParams>)
 using tanf_cell_type = SimpleCell<tanh_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_tanh, tanf_cell_type)
 using relu_cell_type = SimpleCell<relu_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_relu, relu_cell_type);
 
+DEFINE_DISPATCH(fused_lstm_cell_cpu_stub);
 DEFINE_DISPATCH(lstm_cudnn_stub);
 DEFINE_DISPATCH(lstm_packed_cudnn_stub);
 DEFINE_DISPATCH(lstm_miopen_stub);
@@ -1271,6 +1236,89 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm(
                          std::move(std::get<2>(results)));
 }
 
+std::tuple<Tensor, Tensor> quantized_gru(
+      const Tensor& _input, const Tensor& hx,
+      TensorList _params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional,
+      bool batch_first, c10::optional<ScalarType> dtype, bool use_dynamic) {
+  if (at::cudnn_is_acceptable(_input)) {
+    Tensor output, hy;
+    gru_cudnn_stub(_input.device().type(), output, hy, _input, hx, _params, has_biases,
+                   num_layers, dropout_p, train, bidirectional, batch_first);
+    return std::make_tuple(std::move(output), std::move(hy));
+  }
+  auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
+  check_device(_input, _params, hx);
+  auto input = batch_first ? _input.transpose(0, 1) : _input;
+  TORCH_CHECK(has_biases, "quantized GRU requires biases");
+  TORCH_CHECK(
+      result_dtype == at::kChar || result_dtype == at::kQInt8 ||
+          result_dtype == at::kHalf,
+      "dtype is not supported");
+
+  std::tuple<Tensor, Tensor> results;
+  if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
+    if (use_dynamic) {
+      auto params = gather_quantized_params_dynamic(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsDynamic>, FullLayer, FullBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    } else {
+      auto params = gather_quantized_params(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParams>, FullLayer, FullBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    }
+  } else {
+    auto params = gather_quantized_params_fp16(_params);
+    results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsFP16>, FullLayer, FullBidirectionalLayer>(
+        input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+  }
+
+  if (batch_first) {
+    std::get<0>(results).transpose_(0, 1);
+  }
+  return results;
+}
+
+std::tuple<Tensor, Tensor> quantized_gru(
+      const Tensor& data, const Tensor& batch_sizes, const Tensor& hx,
+      TensorList _params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional,
+      c10::optional<ScalarType> dtype, bool use_dynamic) {
+  if (at::cudnn_is_acceptable(data)) {
+    Tensor output, hy;
+    gru_packed_cudnn_stub(data.device().type(), output, hy, data, batch_sizes, hx,
+            _params, has_biases, num_layers, dropout_p, train, bidirectional);
+    return std::make_tuple(std::move(output), std::move(hy));
+  }
+  auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
+  TORCH_CHECK(has_biases, "quantized GRU requires biases");
+  TORCH_CHECK(
+      result_dtype == at::kChar || result_dtype == at::kQInt8 ||
+          result_dtype == at::kHalf,
+      "dtype is not supported");
+
+  PackedSequence input { data, batch_sizes };
+  std::tuple<PackedSequence, Tensor> results;
+  if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
+    if (use_dynamic) {
+      auto params = gather_quantized_params_dynamic(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsDynamic>, PackedLayer, PackedBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    } else {
+      auto params = gather_quantized_params(_params);
+      results = _rnn_impl_with_concat<GRUCell<QuantizedCellParams>, PackedLayer, PackedBidirectionalLayer>(
+          input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+    }
+  } else {
+    auto params = gather_quantized_params_fp16(_params);
+    results = _rnn_impl_with_concat<GRUCell<QuantizedCellParamsFP16>, PackedLayer, PackedBidirectionalLayer>(
+        input, params, hx.unbind(0), num_layers, dropout_p, train, bidirectional);
+  }
+  auto & packed_output = std::get<0>(results);
+  return std::make_tuple(std::move(packed_output.data),
+                         std::move(std::get<1>(results)));
+}
+
 #define DEFINE_QUANTIZED_RNN_CELL(name, hx_type, cell_type, return_type, prepare_hx_fn) \
 return_type name( \
     const Tensor& input, \
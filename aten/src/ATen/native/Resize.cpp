@@ -79,11 +79,54 @@ Tensor& resize_(
   return self;
 }
 
+// Opt-in variant of resize_ for append-heavy workloads: same semantics, but
+// when the backing storage has to grow it is over-allocated geometrically, so
+// the storage capacity becomes distinct from the tensor size (as in
+// std::vector) and building a tensor by repeated row appends is amortized
+// O(n) instead of O(n^2). The excess capacity can be released with
+// _shrink_to_fit_.
+Tensor& _resize_amortized_(Tensor& self, IntArrayRef size) {
+  TORCH_CHECK(
+      !self.has_names(),
+      "_resize_amortized_ is not supported for named tensors");
+  auto* self_ = self.unsafeGetTensorImpl();
+  if (self_->sizes() != size) {
+    self_->set_sizes_contiguous(size);
+    maybe_resize_storage_cpu_amortized(self_, self_->numel());
+  }
+  return self;
+}
+
+// Reallocates the backing storage down to exactly the elements reachable
+// through this tensor, dropping capacity left behind by _resize_amortized_ or
+// by a shrinking resize_ (which never releases storage). Like resize_, this
+// affects every tensor sharing the storage.
+Tensor& _shrink_to_fit_(Tensor& self) {
+  auto* self_ = self.unsafeGetTensorImpl();
+  if (!THTensor_getStoragePtr(self_)) {
+    return self;
+  }
+  const int64_t used = self_->storage_offset() +
+      detail::computeStorageSize(self_->sizes(), self_->strides());
+  if (used < self_->storage().numel()) {
+    THStorage_resize(THTensor_getStoragePtr(self_), used);
+  }
+  return self;
+}
+
 static auto registry = torch::RegisterOperators()
   .op(torch::RegisterOperators::options()
     .schema("aten::resize_(Tensor(a!) self, int[] size, *, MemoryFormat? memory_format=None) -> Tensor(a!)")
     .aliasAnalysis(AliasAnalysisKind::FROM_SCHEMA)
     .impl_unboxedOnlyKernel<decltype(resize_), &resize_>(DispatchKey::CPU))
+  .op(torch::RegisterOperators::options()
+    .schema("aten::_resize_amortized_(Tensor(a!) self, int[] size) -> Tensor(a!)")
+    .aliasAnalysis(AliasAnalysisKind::FROM_SCHEMA)
+    .impl_unboxedOnlyKernel<decltype(_resize_amortized_), &_resize_amortized_>(DispatchKey::CPU))
+  .op(torch::RegisterOperators::options()
+    .schema("aten::_shrink_to_fit_(Tensor(a!) self) -> Tensor(a!)")
+    .aliasAnalysis(AliasAnalysisKind::FROM_SCHEMA)
+    .impl_unboxedOnlyKernel<decltype(_shrink_to_fit_), &_shrink_to_fit_>(DispatchKey::CPU))
   .op(torch::RegisterOperators::options()
     .schema("aten::resize_as_(Tensor(a!) self, Tensor the_template, *, MemoryFormat? memory_format=None) -> Tensor(a!)")
     .aliasAnalysis(AliasAnalysisKind::FROM_SCHEMA)
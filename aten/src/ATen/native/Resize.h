@@ -27,6 +27,29 @@ static inline void maybe_resize_storage_cpu(TensorImpl* self, int64_t new_size)
   }
 }
 
+// Growth-policy variant used by _resize_amortized_: when the storage has to
+// grow, over-allocate geometrically (at least double the current capacity,
+// like std::vector) so that appending row-by-row with repeated resizes
+// reallocates O(log n) times instead of on every call. Capacity in excess of
+// the tensor's size is invisible to readers and can be dropped again with
+// _shrink_to_fit_.
+static inline void maybe_resize_storage_cpu_amortized(
+    TensorImpl* self,
+    int64_t new_size) {
+  if (new_size > 0) {
+    if (!THTensor_getStoragePtr(self)) {
+      THTensor_stealAndSetStoragePtr(self, THStorage_new(self->dtype()));
+    }
+    const int64_t needed = new_size + self->storage_offset();
+    const int64_t capacity = self->storage().numel();
+    if (needed > capacity) {
+      THStorage_resize(
+          THTensor_getStoragePtr(self),
+          std::max(needed, 2 * capacity));
+    }
+  }
+}
+
 inline TensorImpl* resize_impl_cpu_(
     TensorImpl* self,
     IntArrayRef size,
@@ -115,6 +115,103 @@ void host_softmax_backward(
         }
       });
 }
+
+// Checks the `offsets` tensor of a ragged batch (see NOTE [ ragged sequence
+// batches ] in PackedSequence.cpp) against the packed data tensor and returns
+// the number of segments.
+int64_t check_ragged_offsets(const Tensor& offsets, const Tensor& data) {
+  TORCH_CHECK(offsets.dim() == 1 && offsets.device().type() == at::kCPU &&
+          offsets.scalar_type() == at::kLong && offsets.numel() >= 1,
+      "'offsets' argument should be a non-empty 1D CPU int64 tensor");
+  TORCH_CHECK(data.dim() >= 1, "ragged data must be at least 1-dimensional");
+  int64_t num_segments = offsets.size(0) - 1;
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  TORCH_CHECK(offsets_data[0] == 0, "offsets must start at 0");
+  for (int64_t s = 0; s < num_segments; ++s) {
+    TORCH_CHECK(offsets_data[s + 1] >= offsets_data[s],
+        "offsets must be non-decreasing");
+  }
+  TORCH_CHECK(offsets_data[num_segments] == data.size(0),
+      "last offset (", offsets_data[num_segments],
+      ") must equal the number of packed rows (", data.size(0), ")");
+  return num_segments;
+}
+
+// Softmax over the rows of each segment of a ragged batch, computed
+// independently for every trailing (inner) position. This is the softmax an
+// attention scorer needs on packed scores: each sequence is normalized over
+// its own length only, with no padding positions to mask out.
+template <typename scalar_t>
+void host_ragged_softmax(Tensor& output, const Tensor& input, const int64_t* offsets, int64_t num_segments) {
+  int64_t inner_size = 1;
+  for (int64_t i = 1; i < input.dim(); ++i)
+    inner_size *= input.size(i);
+  const scalar_t* input_data_base = input.data_ptr<scalar_t>();
+  scalar_t* output_data_base = output.data_ptr<scalar_t>();
+  parallel_for(0, num_segments, 1, [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> max_input(inner_size);
+    std::vector<acc_type<scalar_t, false>> tmpsum(inner_size);
+    for (int64_t s = begin; s < end; s++) {
+      int64_t row_begin = offsets[s];
+      int64_t row_end = offsets[s + 1];
+      if (row_begin == row_end) {
+        continue;
+      }
+      const scalar_t* input_data = input_data_base + row_begin * inner_size;
+      scalar_t* output_data = output_data_base + row_begin * inner_size;
+      int64_t rows = row_end - row_begin;
+      std::fill(max_input.begin(), max_input.end(),
+                -std::numeric_limits<scalar_t>::infinity());
+      for (int64_t r = 0; r < rows; r++)
+        for (int64_t i = 0; i < inner_size; i++)
+          max_input[i] = std::max(max_input[i], input_data[r * inner_size + i]);
+      std::fill(tmpsum.begin(), tmpsum.end(), 0);
+      for (int64_t r = 0; r < rows; r++) {
+        for (int64_t i = 0; i < inner_size; i++) {
+          scalar_t z = std::exp(input_data[r * inner_size + i] - max_input[i]);
+          output_data[r * inner_size + i] = z;
+          tmpsum[i] += z;
+        }
+      }
+      for (int64_t r = 0; r < rows; r++)
+        for (int64_t i = 0; i < inner_size; i++)
+          output_data[r * inner_size + i] /= tmpsum[i];
+    }
+  });
+}
+
+template <typename scalar_t>
+void host_ragged_softmax_backward(Tensor& gradInput, const Tensor& grad, const Tensor& output, const int64_t* offsets, int64_t num_segments) {
+  int64_t inner_size = 1;
+  for (int64_t i = 1; i < grad.dim(); ++i)
+    inner_size *= grad.size(i);
+  scalar_t* gradInput_data_base = gradInput.data_ptr<scalar_t>();
+  const scalar_t* gradOutput_data_base = grad.data_ptr<scalar_t>();
+  const scalar_t* output_data_base = output.data_ptr<scalar_t>();
+  parallel_for(0, num_segments, 1, [&](int64_t begin, int64_t end) {
+    std::vector<acc_type<scalar_t, false>> sum(inner_size);
+    for (int64_t s = begin; s < end; s++) {
+      int64_t row_begin = offsets[s];
+      int64_t row_end = offsets[s + 1];
+      if (row_begin == row_end) {
+        continue;
+      }
+      scalar_t* gradInput_data = gradInput_data_base + row_begin * inner_size;
+      const scalar_t* gradOutput_data = gradOutput_data_base + row_begin * inner_size;
+      const scalar_t* output_data = output_data_base + row_begin * inner_size;
+      int64_t rows = row_end - row_begin;
+      std::fill(sum.begin(), sum.end(), 0);
+      for (int64_t r = 0; r < rows; r++)
+        for (int64_t i = 0; i < inner_size; i++)
+          sum[i] += gradOutput_data[r * inner_size + i] *
+              output_data[r * inner_size + i];
+      for (int64_t r = 0; r < rows; r++)
+        for (int64_t i = 0; i < inner_size; i++)
+          gradInput_data[r * inner_size + i] = output_data[r * inner_size + i] *
+              (gradOutput_data[r * inner_size + i] - sum[i]);
+    }
+  });
+}
 } // namespace
 
 Tensor softmax_cpu(const Tensor& input_, const int64_t dim_, const bool half_to_float) {
@@ -231,6 +328,42 @@ Tensor log_softmax_backward_cpu(
   return grad_input;
 }
 
+Tensor ragged_softmax_cpu(const Tensor& input_, const Tensor& offsets_) {
+  auto input = input_.contiguous();
+  auto offsets = offsets_.contiguous();
+  int64_t num_segments = check_ragged_offsets(offsets, input);
+  Tensor output = at::native::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  if (input.numel() == 0) {
+    return output;
+  }
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "ragged_softmax", [&] {
+    host_ragged_softmax<scalar_t>(
+        output, input, offsets.data_ptr<int64_t>(), num_segments);
+  });
+  return output;
+}
+
+Tensor ragged_softmax_backward_cpu(
+    const Tensor& grad_,
+    const Tensor& output_,
+    const Tensor& offsets_) {
+  TensorArg grad_arg{grad_, "grad", 1}, output_arg{output_, "output", 2};
+  checkSameSize("ragged_softmax_backward", grad_arg, output_arg);
+  auto grad = grad_.contiguous();
+  auto output = output_.contiguous();
+  auto offsets = offsets_.contiguous();
+  int64_t num_segments = check_ragged_offsets(offsets, grad);
+  Tensor grad_input = at::native::empty_like(grad, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  if (output.numel() == 0) {
+    return grad_input;
+  }
+  AT_DISPATCH_FLOATING_TYPES(grad.scalar_type(), "ragged_softmax_backward", [&] {
+    host_ragged_softmax_backward<scalar_t>(
+        grad_input, grad, output, offsets.data_ptr<int64_t>(), num_segments);
+  });
+  return grad_input;
+}
+
 Tensor softmax(const Tensor& input_, const int64_t dim_) {
   auto result = [&]() {
     NoNamesGuard guard;
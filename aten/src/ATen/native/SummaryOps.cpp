@@ -2,14 +2,77 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
+#include <vector>
 
 namespace at { namespace native {
 
-///////////////// bincount /////////////////
 namespace {
 
+// Number of private histograms to fill in parallel. One per thread, but no
+// more than one per GRAIN_SIZE elements so small inputs stay on one thread.
+int64_t histogram_num_chunks(int64_t numel) {
+  int64_t n_chunks = at::get_num_threads();
+  n_chunks = std::min(n_chunks, (numel + at::internal::GRAIN_SIZE - 1) / at::internal::GRAIN_SIZE);
+  return std::max(n_chunks, (int64_t)1);
+}
+
+// Accumulates the histogram of `self_p` into `output_p`. `bin_of` maps an
+// element to its bin (or -1 to skip it); `weights_p` may be null for unit
+// weights. Each chunk fills a private histogram and the private histograms
+// are summed bin-by-bin at the end, so no two threads ever write the same
+// counter. Privatization only pays off while the histograms are small next
+// to the input, so wide histograms fall back to one serial pass.
+template <typename input_t, typename weights_t, typename bin_fn_t>
+void histogram_accumulate(
+    const input_t* self_p,
+    const weights_t* weights_p,
+    weights_t* output_p,
+    int64_t self_size,
+    int64_t nbins,
+    const bin_fn_t& bin_of) {
+  const int64_t n_chunks = histogram_num_chunks(self_size);
+  if (n_chunks <= 1 || nbins * n_chunks > self_size) {
+    for (int64_t i = 0; i < self_size; i++) {
+      const int64_t bin = bin_of(self_p[i]);
+      if (bin >= 0) {
+        output_p[bin] += weights_p ? weights_p[i] : static_cast<weights_t>(1);
+      }
+    }
+    return;
+  }
+  std::vector<weights_t> partial(n_chunks * nbins, static_cast<weights_t>(0));
+  const int64_t chunk_size = (self_size + n_chunks - 1) / n_chunks;
+  at::parallel_for(0, n_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      weights_t* local_p = partial.data() + c * nbins;
+      const int64_t begin = c * chunk_size;
+      const int64_t end = std::min(begin + chunk_size, self_size);
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t bin = bin_of(self_p[i]);
+        if (bin >= 0) {
+          local_p[bin] += weights_p ? weights_p[i] : static_cast<weights_t>(1);
+        }
+      }
+    }
+  });
+  at::parallel_for(0, nbins, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      weights_t sum = output_p[b];
+      for (int64_t c = 0; c < n_chunks; c++) {
+        sum += partial[c * nbins + b];
+      }
+      output_p[b] = sum;
+    }
+  });
+}
+
+///////////////// bincount /////////////////
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -35,23 +98,50 @@ Tensor _bincount_cpu_template(
   int64_t nbins = static_cast<int64_t>(*self.max().data_ptr<input_t>()) + 1L;
   nbins = std::max(nbins, minlength); // at least minlength # of bins
 
+  // The input is non-negative and nbins covers its max, so every element
+  // lands in a valid bin.
+  auto bin_of = [](input_t value) -> int64_t {
+    return static_cast<int64_t>(value);
+  };
+
   const input_t* self_p = self.data_ptr<input_t>();
   if (has_weights) {
     output = native::zeros({nbins}, weights.options());
     weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (int64_t i = 0; i < self_size; i++) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    histogram_accumulate(self_p, weights_p, output_p, self_size, nbins, bin_of);
   } else {
     output = native::zeros({nbins}, kLong);
     int64_t* output_p = output.data_ptr<int64_t>();
-    for (int64_t i = 0; i < self_size; i++) {
-      output_p[self_p[i]] += 1L;
-    }
+    histogram_accumulate(
+        self_p, static_cast<const int64_t*>(nullptr), output_p, self_size, nbins, bin_of);
   }
   return output;
 }
+
+///////////////// histc /////////////////
+
+template <typename scalar_t>
+void histc_cpu_kernel(
+    scalar_t* hist_p,
+    const scalar_t* self_p,
+    int64_t self_size,
+    int64_t nbins,
+    scalar_t minval,
+    scalar_t maxval) {
+  // A single multiply per element instead of a divide keeps the bin
+  // computation cheap and lets the compiler vectorize it.
+  const scalar_t scale = static_cast<scalar_t>(nbins) / (maxval - minval);
+  auto bin_of = [=](scalar_t value) -> int64_t {
+    if (!(value >= minval && value <= maxval)) {
+      return -1;
+    }
+    return std::min(static_cast<int64_t>((value - minval) * scale), nbins - 1);
+  };
+  histogram_accumulate(
+      self_p, static_cast<const scalar_t*>(nullptr), hist_p, self_size, nbins, bin_of);
+}
+
 } // namespace
 
 Tensor
@@ -65,4 +155,76 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+Tensor& _histc_out_cpu(Tensor& result, const Tensor& self, int64_t bins, Scalar min, Scalar max) {
+  TORCH_CHECK(bins > 0, "bins must be > 0");
+  TORCH_CHECK(result.scalar_type() == self.scalar_type(),
+      "histc: output tensor must have the same dtype as the input, but got ",
+      result.scalar_type(), " and ", self.scalar_type());
+  result.resize_({bins});
+  result.zero_();
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    scalar_t minval = min.to<scalar_t>();
+    scalar_t maxval = max.to<scalar_t>();
+    if (minval == maxval) {
+      minval = *self.min().data_ptr<scalar_t>();
+      maxval = *self.max().data_ptr<scalar_t>();
+    }
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(
+        !(std::isinf(minval) || std::isinf(maxval) || std::isnan(minval) ||
+          std::isnan(maxval)),
+        "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+    const Tensor input = self.contiguous();
+    histc_cpu_kernel<scalar_t>(
+        result.data_ptr<scalar_t>(),
+        input.data_ptr<scalar_t>(),
+        input.numel(),
+        bins,
+        minval,
+        maxval);
+  });
+  return result;
+}
+
+Tensor _histc_cpu(const Tensor& self, int64_t bins, Scalar min, Scalar max) {
+  Tensor result = at::empty({0}, self.options());
+  return _histc_out_cpu(result, self, bins, min, max);
+}
+
+// Accumulates the histogram of `values` over [min, max) into `self` without
+// zeroing it first, with bins = self.numel(). Lets streaming monitors
+// histogram an unbounded stream chunk by chunk into one counts tensor
+// without materializing and summing per-chunk results. The range must be
+// given explicitly: a chunk's own min/max would put the same value in
+// different bins in different chunks.
+Tensor& _histc_accumulate_cpu_(Tensor& self, const Tensor& values, Scalar min, Scalar max) {
+  TORCH_CHECK(self.dim() == 1 && self.numel() > 0 && self.is_contiguous(),
+      "_histc_accumulate_: histogram must be a non-empty contiguous 1-d tensor");
+  TORCH_CHECK(self.scalar_type() == values.scalar_type(),
+      "_histc_accumulate_: histogram must have the same dtype as values, but got ",
+      self.scalar_type(), " and ", values.scalar_type());
+  AT_DISPATCH_FLOATING_TYPES(values.scalar_type(), "_histc_accumulate_cpu_", [&] {
+    const scalar_t minval = min.to<scalar_t>();
+    const scalar_t maxval = max.to<scalar_t>();
+    TORCH_CHECK(
+        !(std::isinf(minval) || std::isinf(maxval) || std::isnan(minval) ||
+          std::isnan(maxval)),
+        "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+    const Tensor input = values.contiguous();
+    histc_cpu_kernel<scalar_t>(
+        self.data_ptr<scalar_t>(),
+        input.data_ptr<scalar_t>(),
+        input.numel(),
+        self.numel(),
+        minval,
+        maxval);
+  });
+  return self;
+}
+
 }} // namespace at::native
@@ -54,6 +54,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/ExpandUtils.h>
+#include <ATen/NamedTensorUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/Copy.h>
@@ -400,6 +401,24 @@ Tensor index_add(const Tensor & self, int64_t dim, const Tensor & index, const T
   return self.clone(at::MemoryFormat::Preserve).index_add_(dim, index, source);
 }
 
+// Prefetches the source row a few indices ahead of the gather loop, so the
+// per-row copy is not stalled on a cache miss for every index. The number of
+// touched lines is bounded so very wide rows do not monopolize the prefetch
+// queue; their tail misses overlap with the copy itself.
+static inline void prefetch_index_select_row(const char* row, int64_t bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  constexpr int64_t kCacheLineSize = 64;
+  constexpr int64_t kMaxPrefetchBytes = 512;
+  bytes = std::min(bytes, kMaxPrefetchBytes);
+  for (int64_t offset = 0; offset < bytes; offset += kCacheLineSize) {
+    __builtin_prefetch(row + offset);
+  }
+#else
+  (void)row;
+  (void)bytes;
+#endif
+}
+
 Tensor & index_select_out_cpu_(Tensor & result, const Tensor & self, int64_t dim, const Tensor & index) {
   dim = maybe_wrap_dim(dim, self.dim());
 
@@ -455,26 +474,41 @@ Tensor & index_select_out_cpu_(Tensor & result, const Tensor & self, int64_t dim
       }
     };
 
-    // parallel on inner loop in case the slice is large enough;
-    // otherwise parallel on outer loop
-    if (slice_size >= grain_size) {
+    // use a fast loop when self and result are contiguous and of the same data type
+    // (with a handful of large slices, the per-slice copy_stub call below
+    // parallelizes internally and is the better split of the work)
+    if (iter.is_contiguous() && self.scalar_type() == result.scalar_type() &&
+        (slice_size < grain_size || numel >= at::get_num_threads())) {
+      auto slice_size_bytes = slice_size * elementSize(self.scalar_type());
+      // Parallelize over the index tensor; the gather is bandwidth bound, and
+      // for embedding-style reads (many rows, random order) each thread
+      // additionally prefetches the row it will copy a few iterations from
+      // now to hide the pointer-chase latency.
+      auto grain = std::max(int64_t(1), grain_size / slice_size);
+      at::parallel_for(0, numel, grain, [&](int64_t start, int64_t end) {
+        constexpr int64_t kPrefetchDistance = 8;
+        for (int64_t i = start; i < end; i++) {
+          if (i + kPrefetchDistance < end) {
+            auto prefetch_i = index_data[i + kPrefetchDistance];
+            if ((prefetch_i >= 0) && (prefetch_i < self_dim_size)) {
+              prefetch_index_select_row(
+                  static_cast<char*>(selfSlice_data) + prefetch_i * self_stride_bytes,
+                  slice_size_bytes);
+            }
+          }
+          auto self_i = index_data[i];
+          TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
+          auto self_data = static_cast<char*>(selfSlice_data) + self_i * self_stride_bytes;
+          auto result_data = static_cast<char*>(resultSlice_data) + i * result_stride_bytes;
+          memcpy(result_data, self_data, slice_size_bytes);
+        }
+      });
+    } else if (slice_size >= grain_size) {
+      // non-contiguous with large slices: the per-slice copy_stub call
+      // parallelizes internally, so run the outer loop serially
       outer_loop(0, numel);
     } else {
-      // use a fast loop when self and result are contiguous and of the same data type
-      if (iter.is_contiguous() && self.scalar_type() == result.scalar_type()) {
-        auto slice_size_bytes = slice_size * elementSize(self.scalar_type());
-        at::parallel_for(0, numel, grain_size / slice_size, [&](int64_t start, int64_t end) {
-          for (int64_t i = start; i < end; i++) {
-            auto self_i = index_data[i];
-            TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
-            auto self_data = static_cast<char*>(selfSlice_data) + self_i * self_stride_bytes;
-            auto result_data = static_cast<char*>(resultSlice_data) + i * result_stride_bytes;
-            memcpy(result_data, self_data, slice_size_bytes);
-          }
-        });
-      } else {
-        at::parallel_for(0, numel, grain_size / slice_size, outer_loop);
-      }
+      at::parallel_for(0, numel, grain_size / slice_size, outer_loop);
     }
   } else {
     TORCH_CHECK(result.dim() <= 1, "result.dim() (", result.dim(), ") must one or zero for given self.dim() (", self.dim(), ")");
@@ -645,6 +679,193 @@ Tensor _gather_sparse_backward(const Tensor& self, int64_t dim, const Tensor& in
     return at::_sparse_coo_tensor_unsafe(sparse_ind, grad.reshape(-1), self.sizes());
 }
 
+// Shared chunking for the two-pass (count, prefix-sum, fill) selection
+// kernels below: split [0, numel) into at most num_threads chunks of at
+// least GRAIN_SIZE elements, so the prefix sum over per-chunk counts stays
+// trivially small and each chunk writes one dense output range.
+static int64_t two_pass_num_chunks(int64_t numel) {
+  const int64_t max_chunks =
+      std::min<int64_t>(at::get_num_threads(),
+          (numel + at::internal::GRAIN_SIZE - 1) / at::internal::GRAIN_SIZE);
+  return std::max<int64_t>(max_chunks, 1);
+}
+
+Tensor& nonzero_out_cpu(Tensor& result, const Tensor& self) {
+  TORCH_CHECK(result.scalar_type() == kLong,
+      "nonzero: the datatype of out must be Long but is ", result.scalar_type());
+
+  auto self_c = self.contiguous();
+  const int64_t numel = self_c.numel();
+  const int64_t ndim = self.dim();
+  const int64_t n_chunks = two_pass_num_chunks(numel);
+  const int64_t chunk_size = (numel + n_chunks - 1) / n_chunks;
+
+  AT_DISPATCH_ALL_TYPES_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "nonzero_cpu", [&] {
+    const scalar_t* data = numel > 0 ? self_c.data_ptr<scalar_t>() : nullptr;
+
+    // Pass 1: per-chunk nonzero counts.
+    std::vector<int64_t> offsets(n_chunks, 0);
+    at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (auto chunk = begin; chunk < end; chunk++) {
+        const int64_t start = chunk * chunk_size;
+        const int64_t stop = std::min(start + chunk_size, numel);
+        int64_t count = 0;
+        for (int64_t i = start; i < stop; i++) {
+          count += (data[i] != scalar_t(0));
+        }
+        offsets[chunk] = count;
+      }
+    });
+
+    // Exclusive prefix sum turns the counts into output row offsets.
+    int64_t total = 0;
+    for (int64_t chunk = 0; chunk < n_chunks; chunk++) {
+      const int64_t count = offsets[chunk];
+      offsets[chunk] = total;
+      total += count;
+    }
+
+    result.resize_({total, ndim});
+    if (total == 0) {
+      return;
+    }
+    int64_t* out = result.data_ptr<int64_t>();
+    IntArrayRef sizes = self.sizes();
+
+    // Pass 2: each chunk fills its own dense output range, unravelling the
+    // linear position with an odometer instead of per-element div/mod.
+    at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (auto chunk = begin; chunk < end; chunk++) {
+        const int64_t start = chunk * chunk_size;
+        const int64_t stop = std::min(start + chunk_size, numel);
+        int64_t* out_row = out + offsets[chunk] * ndim;
+        c10::SmallVector<int64_t, 8> idx(ndim, 0);
+        int64_t remaining = start;
+        for (int64_t dim = ndim - 1; dim >= 0; dim--) {
+          idx[dim] = remaining % sizes[dim];
+          remaining /= sizes[dim];
+        }
+        for (int64_t i = start; i < stop; i++) {
+          if (data[i] != scalar_t(0)) {
+            for (int64_t dim = 0; dim < ndim; dim++) {
+              out_row[dim] = idx[dim];
+            }
+            out_row += ndim;
+          }
+          for (int64_t dim = ndim - 1; dim >= 0; dim--) {
+            if (++idx[dim] < sizes[dim]) {
+              break;
+            }
+            idx[dim] = 0;
+          }
+        }
+      }
+    });
+  });
+
+  return result;
+}
+
+Tensor nonzero_cpu(const Tensor& self) {
+  Tensor result = at::empty({0}, self.options().dtype(kLong));
+  nonzero_out_cpu(result, self);
+  return result;
+}
+
+static Tensor& masked_select_out_cpu_impl(Tensor& result, const Tensor& self, const Tensor& mask) {
+  NoNamesGuard guard;
+
+  TORCH_CHECK(mask.scalar_type() == ScalarType::Byte || mask.scalar_type() == ScalarType::Bool,
+      "masked_select: expected BoolTensor or ByteTensor for mask");
+  TORCH_CHECK(self.scalar_type() == result.scalar_type(),
+      "masked_select(): self and result must have the same scalar type");
+  TORCH_CHECK(self.scalar_type() != ScalarType::Half,
+      "masked_select: Half not supported for CPU implementation");
+  if (mask.scalar_type() == at::ScalarType::Byte) {
+    TORCH_WARN("masked_select received a mask with dtype torch.uint8, this behavior is now deprecated," \
+            "please use a mask with dtype torch.bool instead.");
+  }
+
+  Tensor _mask = (mask.dim() == 0) ? mask.unsqueeze(0) : mask;
+  Tensor _self = (self.dim() == 0) ? self.unsqueeze(0) : self;
+  std::tie(_mask, _self) = expand_outplace(_mask, _self);
+
+  auto mask_c = _mask.contiguous();
+  auto self_c = _self.contiguous();
+  const int64_t numel = mask_c.numel();
+  const int64_t n_chunks = two_pass_num_chunks(numel);
+  const int64_t chunk_size = (numel + n_chunks - 1) / n_chunks;
+  const bool mask_is_bool = mask.scalar_type() == ScalarType::Bool;
+  // Byte and bool masks are both one byte per element.
+  const unsigned char* mask_data =
+      numel > 0 ? static_cast<const unsigned char*>(mask_c.data_ptr()) : nullptr;
+
+  // Pass 1: per-chunk counts of selected elements; the byte-mask validity
+  // check rides along with the scan.
+  std::vector<int64_t> offsets(n_chunks, 0);
+  at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (auto chunk = begin; chunk < end; chunk++) {
+      const int64_t start = chunk * chunk_size;
+      const int64_t stop = std::min(start + chunk_size, numel);
+      int64_t count = 0;
+      for (int64_t i = start; i < stop; i++) {
+        const unsigned char m = mask_data[i];
+        TORCH_CHECK(mask_is_bool || m <= 1, "Mask tensor can take 0 and 1 values only");
+        count += (m != 0);
+      }
+      offsets[chunk] = count;
+    }
+  });
+
+  int64_t total = 0;
+  for (int64_t chunk = 0; chunk < n_chunks; chunk++) {
+    const int64_t count = offsets[chunk];
+    offsets[chunk] = total;
+    total += count;
+  }
+
+  result.resize_({total});
+  if (total == 0) {
+    return result;
+  }
+
+  // Pass 2: each chunk compacts its selected elements into its own dense
+  // output range.
+  // Half is deliberately not supported, matching the TH kernels this
+  // replaces.
+  AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "masked_select", [&] {
+    const scalar_t* src = self_c.data_ptr<scalar_t>();
+    scalar_t* dst = result.data_ptr<scalar_t>();
+    at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (auto chunk = begin; chunk < end; chunk++) {
+        const int64_t start = chunk * chunk_size;
+        const int64_t stop = std::min(start + chunk_size, numel);
+        int64_t out = offsets[chunk];
+        for (int64_t i = start; i < stop; i++) {
+          if (mask_data[i]) {
+            dst[out++] = src[i];
+          }
+        }
+      }
+    });
+  });
+
+  return result;
+}
+
+Tensor masked_select_cpu(const Tensor& self, const Tensor& mask) {
+  namedinference::compute_broadcast_outnames(self, mask);
+  Tensor result = at::empty({0}, self.options());
+  return masked_select_out_cpu_impl(result, self, mask);
+}
+
+Tensor& masked_select_out_cpu(Tensor& result, const Tensor& self, const Tensor& mask) {
+  namedinference::compute_broadcast_outnames(self, mask);
+  return masked_select_out_cpu_impl(result, self, mask);
+}
+
 std::vector<Tensor> nonzero_numpy(const Tensor& self) {
   // special case scalar for compatibility with numpy:
   //
@@ -4,6 +4,7 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/TypeProperties.h>
+#include <c10/util/flat_hash_map.h>
 
 namespace at {
 
@@ -534,7 +535,7 @@ void TensorIterator::for_each(loop2d_t loop, int64_t grain_size) {
   int64_t numel = this->numel();
   if (numel == 0) {
     return;
-  } else if (numel < internal::GRAIN_SIZE || at::get_num_threads() == 1) {
+  } else if (numel < at::default_grain_size() || at::get_num_threads() == 1) {
     return serial_for_each(loop, {0, numel});
   } else {
     at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
@@ -1040,7 +1041,158 @@ FastSetupType TensorIterator::compute_fast_setup_type() {
   return FastSetupType::NONE;
 }
 
+namespace {
+
+// Thread-local storage for the build plan cache.
+// See Note [TensorIterator plan cache]
+constexpr size_t kMaxCachedPlans = 256;
+
+uint64_t hash_fingerprint(const SmallVector<int64_t, 32>& fingerprint) {
+  // FNV-1a over the fingerprint words
+  uint64_t hash = 14695981039346656037ull;
+  for (int64_t word : fingerprint) {
+    hash = (hash ^ static_cast<uint64_t>(word)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+ska::flat_hash_map<uint64_t, internal::TensorIteratorPlan>& plan_cache() {
+  static thread_local ska::flat_hash_map<uint64_t, internal::TensorIteratorPlan> cache;
+  return cache;
+}
+
+thread_local bool plan_cache_enabled_ = true;
+
+} // namespace
+
+bool TensorIterator::plan_cache_enabled() {
+  return plan_cache_enabled_;
+}
+
+void TensorIterator::set_plan_cache_enabled(bool enabled) {
+  plan_cache_enabled_ = enabled;
+  if (!enabled) {
+    plan_cache().clear();
+  }
+}
+
+bool TensorIterator::plan_cacheable() const {
+  // Reductions configure outputs through a separate path; keep them on the
+  // full build. Named tensors require name inference, which the cached plan
+  // does not replay.
+  if (is_reduction_) {
+    return false;
+  }
+  for (int i = 0; i < ntensors(); i++) {
+    auto& op = operands_[i];
+    // outputs come first in operands_; only they may be undefined
+    if (!op.tensor.defined() && i >= num_outputs_) {
+      return false;
+    }
+    if (op.tensor.defined() && op.tensor.has_names()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TensorIterator::compute_plan_fingerprint(SmallVector<int64_t, 32>& fingerprint) const {
+  fingerprint.push_back(ntensors());
+  fingerprint.push_back(num_outputs_);
+  fingerprint.push_back(
+      (static_cast<int64_t>(common_dtype_strategy_) << 8) |
+      (static_cast<int64_t>(resize_outputs_) << 4) |
+      (static_cast<int64_t>(allow_cpu_scalars_) << 3) |
+      (static_cast<int64_t>(promote_gpu_output_dtypes_) << 2) |
+      (static_cast<int64_t>(check_mem_overlap_) << 1));
+  for (int i = 0; i < ntensors(); i++) {
+    auto& op = operands_[i];
+    bool defined = op.tensor.defined();
+    bool wrapped = defined && op.tensor.unsafeGetTensorImpl()->is_wrapped_number();
+    fingerprint.push_back(
+        (static_cast<int64_t>(defined) << 1) | static_cast<int64_t>(wrapped));
+    fingerprint.push_back(static_cast<int64_t>(op.target_dtype));
+    fingerprint.push_back(static_cast<int64_t>(op.current_dtype));
+    fingerprint.push_back(
+        (static_cast<int64_t>(op.device.type()) << 8) |
+        (static_cast<int64_t>(op.device.index()) & 0xff));
+    if (defined) {
+      auto sizes = op.tensor.sizes();
+      auto strides = op.tensor.strides();
+      fingerprint.push_back(sizes.size());
+      fingerprint.append(sizes.begin(), sizes.end());
+      fingerprint.append(strides.begin(), strides.end());
+    }
+  }
+}
+
+bool TensorIterator::apply_cached_plan(const internal::TensorIteratorPlan& plan) {
+  mark_outputs();
+  // overlap checks depend on data pointers, so they are not part of the plan
+  check_mem_overlaps();
+  shape_ = plan.shape;
+  perm_ = plan.perm;
+  common_dtype_ = plan.common_dtype;
+  has_coalesced_dimensions_ = plan.has_coalesced_dimensions;
+  all_ops_same_shape_ = plan.all_ops_same_shape;
+  for (int i = 0; i < ntensors(); i++) {
+    auto& op = operands_[i];
+    auto& op_plan = plan.operands[i];
+    op.stride_bytes = op_plan.stride_bytes;
+    op.target_dtype = op_plan.target_dtype;
+    if (op_plan.needs_allocation) {
+      TORCH_INTERNAL_ASSERT(!op.tensor.defined());
+      op.tensor = at::empty_strided(op_plan.alloc_sizes, op_plan.alloc_strides, op.options());
+    }
+    op.current_dtype = op_plan.current_dtype;
+    op.data = op.tensor.data_ptr();
+  }
+  view_offsets_ = DimVector(ndim(), 0);
+  return true;
+}
+
+void TensorIterator::record_plan(internal::TensorIteratorPlan& plan) const {
+  plan.shape = shape_;
+  plan.perm = perm_;
+  plan.common_dtype = common_dtype_;
+  plan.has_coalesced_dimensions = has_coalesced_dimensions_;
+  plan.all_ops_same_shape = all_ops_same_shape_;
+  for (int i = 0; i < ntensors(); i++) {
+    auto& op = operands_[i];
+    plan.operands.emplace_back();
+    auto& op_plan = plan.operands.back();
+    op_plan.stride_bytes = op.stride_bytes;
+    op_plan.target_dtype = op.target_dtype;
+    op_plan.current_dtype = op.current_dtype;
+  }
+}
+
 void TensorIterator::build() {
+  SmallVector<int64_t, 32> fingerprint;
+  uint64_t fingerprint_hash = 0;
+  // remember the geometry of caller-provided outputs so that a plan is only
+  // recorded when build() left them untouched
+  SmallVector<c10::optional<std::pair<DimVector, DimVector>>, 4> output_geometry;
+  if (plan_cache_enabled() && plan_cacheable()) {
+    compute_plan_fingerprint(fingerprint);
+    fingerprint_hash = hash_fingerprint(fingerprint);
+    auto it = plan_cache().find(fingerprint_hash);
+    if (it != plan_cache().end() && it->second.fingerprint == fingerprint) {
+      if (apply_cached_plan(it->second)) {
+        return;
+      }
+    }
+    for (int i = 0; i < num_outputs_; i++) {
+      auto& op = operands_[i];
+      if (op.tensor.defined()) {
+        output_geometry.emplace_back(std::make_pair(
+            DimVector(op.tensor.sizes()), DimVector(op.tensor.strides())));
+      } else {
+        output_geometry.emplace_back(c10::nullopt);
+      }
+    }
+  }
+
   // check input tensors memory format to use it during output allocation
   analyze_memory_format();
   // set is_output and is_read_write flags on appropriate tensors
@@ -1075,6 +1227,40 @@ void TensorIterator::build() {
 
   // zero out offsets
   view_offsets_ = DimVector(ndim(), 0);
+
+  if (!fingerprint.empty()) {
+    // don't record plans for builds that did anything pointer-dependent:
+    // casted operands via temporaries or resized/restrided a provided output
+    bool recordable = names_.empty();
+    for (int i = 0; recordable && i < ntensors(); i++) {
+      recordable = !operands_[i].original_tensor.defined();
+    }
+    for (int i = 0; recordable && i < num_outputs_; i++) {
+      auto& op = operands_[i];
+      if (output_geometry[i].has_value()) {
+        recordable = op.tensor.sizes().equals(output_geometry[i]->first) &&
+            op.tensor.strides().equals(output_geometry[i]->second);
+      }
+    }
+    if (recordable) {
+      if (plan_cache().size() >= kMaxCachedPlans) {
+        plan_cache().clear();
+      }
+      auto& plan = plan_cache()[fingerprint_hash];
+      plan = internal::TensorIteratorPlan();
+      plan.fingerprint = std::move(fingerprint);
+      record_plan(plan);
+      for (int i = 0; i < num_outputs_; i++) {
+        if (!output_geometry[i].has_value()) {
+          auto& op = operands_[i];
+          auto& op_plan = plan.operands[i];
+          op_plan.needs_allocation = true;
+          op_plan.alloc_sizes = DimVector(op.tensor.sizes());
+          op_plan.alloc_strides = DimVector(op.tensor.strides());
+        }
+      }
+    }
+  }
 }
 
 SplitUntil32Bit TensorIterator::with_32bit_indexing() const {
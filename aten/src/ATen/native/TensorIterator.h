@@ -140,6 +140,45 @@ enum class FastSetupType : uint8_t {
   NON_OVERLAPPING_DENSE
 };
 
+namespace internal {
+
+// Note [TensorIterator plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The result of TensorIterator::build() depends only on the geometry of the
+// operands (sizes, strides, dtypes, devices, wrapped-number-ness) and on the
+// iterator configuration flags, not on the data pointers. Eager-mode loops
+// frequently rebuild iterators for identical geometries, so build() memoizes
+// its output in a small thread-local cache keyed on that geometry. A cached
+// plan records the broadcasted shape, the dimension permutation, the
+// coalesced per-operand strides, the promoted dtypes and an allocation recipe
+// for outputs that were undefined at build time. Plans are only recorded for
+// builds that did not touch anything pointer-dependent: no named tensors, no
+// temporary casted operands and no resizing or restriding of caller-provided
+// outputs. Memory overlap checks are re-run on every cache hit because they
+// depend on data pointers.
+struct TensorIteratorPlan {
+  struct OperandPlan {
+    SmallVector<int64_t, 6> stride_bytes;
+    ScalarType target_dtype = ScalarType::Undefined;
+    ScalarType current_dtype = ScalarType::Undefined;
+    /// set if the operand was an undefined output allocated by build()
+    bool needs_allocation = false;
+    DimVector alloc_sizes;
+    DimVector alloc_strides;
+  };
+  /// flattened encoding of the operand geometry and config flags; doubles as
+  /// the cache key (the map is keyed on its hash, this disambiguates)
+  SmallVector<int64_t, 32> fingerprint;
+  DimVector shape;
+  DimVector perm;
+  ScalarType common_dtype = ScalarType::Undefined;
+  bool has_coalesced_dimensions = false;
+  bool all_ops_same_shape = false;
+  SmallVector<OperandPlan, 4> operands;
+};
+
+} // namespace internal
+
 enum class CommonDTypeStrategy : uint8_t {
   NONE, // Do not compute a common dtype
   CHECK, // Compute and validate a common dtype but don't promote.
@@ -264,8 +303,8 @@ struct CAFFE2_API TensorIterator {
     return c10::fetch_and_cast<T>(op.tensor.scalar_type(), op.data);
   }
 
-  void for_each(loop_t loop, int64_t grain_size = at::internal::GRAIN_SIZE);
-  void for_each(loop2d_t loop, int64_t grain_size = at::internal::GRAIN_SIZE);
+  void for_each(loop_t loop, int64_t grain_size = at::default_grain_size());
+  void for_each(loop2d_t loop, int64_t grain_size = at::default_grain_size());
 
   void parallel_reduce(loop2d_t loop);
 
@@ -359,7 +398,18 @@ struct CAFFE2_API TensorIterator {
 
   void build();
 
+  /// Controls the thread-local build plan cache.
+  /// See Note [TensorIterator plan cache]
+  static bool plan_cache_enabled();
+  static void set_plan_cache_enabled(bool enabled);
+
 protected:
+  /// See Note [TensorIterator plan cache]
+  bool plan_cacheable() const;
+  void compute_plan_fingerprint(SmallVector<int64_t, 32>& fingerprint) const;
+  bool apply_cached_plan(const internal::TensorIteratorPlan& plan);
+  void record_plan(internal::TensorIteratorPlan& plan) const;
+
   void mark_outputs();
   void check_mem_overlaps();
   void compute_shape();
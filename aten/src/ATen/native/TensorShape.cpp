@@ -20,7 +20,7 @@
 namespace at {
 namespace native {
 
-DEFINE_DISPATCH(cat_serial_stub);
+DEFINE_DISPATCH(cat_contig_stub);
 
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
   TORCH_CHECK(shape_tensor.dim() == 1);
@@ -164,12 +164,14 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
   result_size[dim] = cat_dim_size;
   result.resize_(result_size);
 
-  // fast path for single thread when both inputs and result are contiguous and not empty
-  bool use_serial_kernel = result.numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1;
+  // fast path when both inputs and result are contiguous; the kernel
+  // parallelizes internally (and degenerates to the serial copy loop for
+  // small results via the parallel_for grain size)
   allContiguous = allContiguous && result.is_contiguous();
   ScalarType dtype = notSkippedTensor.scalar_type();
-  if (use_serial_kernel && allContiguous && (dtype == ScalarType::Double || dtype == ScalarType::Float)) {
-    cat_serial_stub(kCPU, result, tensors, dim);
+  if (allContiguous &&
+      (at::isFloatingType(dtype) || at::isIntegralType(dtype, /*includeBool=*/true))) {
+    cat_contig_stub(kCPU, result, tensors, dim);
     return result;
   }
 
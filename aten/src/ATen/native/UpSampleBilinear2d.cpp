@@ -188,15 +188,24 @@ static void upsample_bilinear2d_out_cpu_template(
       output_height,
       output_width);
 
+  AT_ASSERT(
+      input_height > 0 && input_width > 0 && output_height > 0 &&
+      output_width > 0);
+
+  if (input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    output.resize_(
+        {nbatch, channels, output_height, output_width},
+        at::MemoryFormat::ChannelsLast);
+    upsample_bilinear2d_channels_last_kernel(
+        kCPU, output, input_, align_corners, scales_h, scales_w);
+    return;
+  }
+
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
   output.zero_();
 
-  AT_ASSERT(
-      input_height > 0 && input_width > 0 && output_height > 0 &&
-      output_width > 0);
-
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bilinear2d", [&] {
     auto* idata = input.data_ptr<scalar_t>();
     auto* odata = output.data_ptr<scalar_t>();
@@ -328,5 +337,7 @@ Tensor upsample_bilinear2d_backward_cpu(
   return grad_input;
 }
 
+DEFINE_DISPATCH(upsample_bilinear2d_channels_last_kernel);
+
 } // namespace native
 } // namespace at
@@ -12,6 +12,12 @@ using batch_norm_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
 
 DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_contiguous_stub);
 
+// Computes per-channel mean and the sum of squared deviations from the mean
+// (M2 in Welford's terms) in a single pass over a contiguous input.
+using batch_norm_collect_stats_fn = void (*)(Tensor&, Tensor&, const Tensor&);
+
+DECLARE_DISPATCH(batch_norm_collect_stats_fn, batch_norm_cpu_collect_stats_contiguous_stub);
+
 } // namespace native
 
 } // namespace at
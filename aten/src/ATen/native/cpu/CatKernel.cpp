@@ -1,9 +1,11 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/cpu/CatKernel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <cstring>
 
 namespace at { namespace native {
 
@@ -12,14 +14,41 @@ namespace {
 struct InputMeta {
   void* data_ptr;
   int64_t inner_size;
+  int64_t row_offset; // offset of this input inside one output row
 
-  InputMeta(const Tensor& t, int64_t dim, int64_t inner)
+  InputMeta(const Tensor& t, int64_t dim, int64_t inner, int64_t offset)
     : data_ptr(t.data_ptr())
-    , inner_size(t.size(dim) * inner) {}
+    , inner_size(t.size(dim) * inner)
+    , row_offset(offset) {}
 };
 
+// Rows at least this large are copied with memcpy, which switches to
+// non-temporal stores for spans that would otherwise wipe out the caches.
+constexpr int64_t kLargeRowBytes = 256 * 1024;
+
 template <typename scalar_t>
-void cat_serial_kernel_impl(Tensor& result, TensorList tensors, int64_t dim) {
+inline void copy_span(scalar_t* result_ptr, const scalar_t* input_ptr, int64_t size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  if (size < Vec::size()) {
+    #ifndef _MSC_VER
+    # pragma unroll
+    #endif
+    for (int64_t k = 0; k < size; k++) {
+      result_ptr[k] = input_ptr[k];
+    }
+  } else if (size * (int64_t)sizeof(scalar_t) >= kLargeRowBytes) {
+    std::memcpy(result_ptr, input_ptr, size * sizeof(scalar_t));
+  } else {
+    vec256::map(
+        [](Vec x) { return x; },
+        result_ptr,
+        input_ptr,
+        size);
+  }
+}
+
+template <typename scalar_t>
+void cat_contig_kernel_impl(Tensor& result, TensorList tensors, int64_t dim) {
   auto size = result.sizes().vec();
   int64_t outer = 1, inner = 1;
   for (int64_t i = 0; i < dim; i++) {
@@ -32,44 +61,53 @@ void cat_serial_kernel_impl(Tensor& result, TensorList tensors, int64_t dim) {
   int64_t ninputs = tensors.size();
   std::vector<InputMeta> inputs;
   inputs.reserve(ninputs);
+  int64_t row_size = 0;
   for (auto const &tensor : tensors) {
-    inputs.emplace_back(tensor, dim, inner);
+    inputs.emplace_back(tensor, dim, inner, row_size);
+    row_size += inputs.back().inner_size;
   }
- 
-  using Vec = vec256::Vec256<scalar_t>;
-  int64_t offset = 0;
-  for (int64_t i = 0; i < outer; i++) {
-    for (int64_t j = 0; j < ninputs; j++) {
-      scalar_t* result_ptr = result_data + offset;
-      int64_t local_inner = inputs[j].inner_size;
-      scalar_t* input_ptr = (scalar_t*)(inputs[j].data_ptr) + i * local_inner;
-      if (local_inner < Vec::size()) {
-        #ifndef _MSC_VER
-        # pragma unroll
-        #endif
-        for (int64_t k = 0; k < local_inner; k++) {
-          result_ptr[k] = input_ptr[k];
+
+  if (outer > 1) {
+    // partition the output rows across workers; each worker copies the slice
+    // of every input belonging to its rows
+    int64_t grain = std::max(
+        (int64_t)1, at::internal::GRAIN_SIZE / std::max(row_size, (int64_t)1));
+    at::parallel_for(0, outer, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        scalar_t* result_row = result_data + i * row_size;
+        for (int64_t j = 0; j < ninputs; j++) {
+          int64_t local_inner = inputs[j].inner_size;
+          copy_span(
+              result_row + inputs[j].row_offset,
+              (scalar_t*)(inputs[j].data_ptr) + i * local_inner,
+              local_inner);
         }
-      } else {
-        vec256::map(
-            [](Vec x) { return x; },
-            result_ptr,
-            input_ptr,
-            local_inner);
       }
-      offset += local_inner;
-    }
+    });
+  } else {
+    // dim 0 (or effectively 1-d): partition across the input list, the common
+    // shape for `cat` over many small feature tensors
+    at::parallel_for(0, ninputs, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t j = begin; j < end; j++) {
+        copy_span(
+            result_data + inputs[j].row_offset,
+            (scalar_t*)(inputs[j].data_ptr),
+            inputs[j].inner_size);
+      }
+    });
   }
 }
 
-void cat_serial_kernel(Tensor& result, TensorList tensors, int64_t dim) {
-  AT_DISPATCH_FLOATING_TYPES(result.scalar_type(), "cat_serial_kernel", [&]() {
-    cat_serial_kernel_impl<scalar_t>(result, tensors, dim);
+void cat_contig_kernel(Tensor& result, TensorList tensors, int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND3(
+      ScalarType::Bool, ScalarType::Half, ScalarType::BFloat16,
+      result.scalar_type(), "cat_contig_kernel", [&]() {
+    cat_contig_kernel_impl<scalar_t>(result, tensors, dim);
   });
 }
 
 } // anonymous namespace
 
-REGISTER_DISPATCH(cat_serial_stub, &cat_serial_kernel);
+REGISTER_DISPATCH(cat_contig_stub, &cat_contig_kernel);
 
 }} // at::native
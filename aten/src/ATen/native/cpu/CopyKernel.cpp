@@ -1,18 +1,77 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <c10/util/TypeCast.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 namespace {
 
+// Contiguous same-dtype copies at least this large bypass the cache with
+// non-temporal stores: a multi-GB checkpoint or optimizer-state copy is
+// consumed exactly once, and letting it stream through L1/L2/L3 would evict
+// the whole working set.
+constexpr int64_t kNonTemporalCopyBytes = 16 * 1024 * 1024;
+
+static void memcpy_nontemporal(char* dst, const char* src, int64_t bytes) {
+#if defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2)
+  // Align the destination so the streaming stores hit full cache lines;
+  // the unaligned head and tail go through a plain memcpy.
+  const int64_t head =
+      std::min(bytes, (-reinterpret_cast<intptr_t>(dst)) & int64_t(31));
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  bytes -= head;
+  const int64_t vec_bytes = bytes & ~int64_t(31);
+  for (int64_t i = 0; i < vec_bytes; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+  }
+  _mm_sfence();
+  std::memcpy(dst + vec_bytes, src + vec_bytes, bytes - vec_bytes);
+#else
+  std::memcpy(dst, src, bytes);
+#endif
+}
+
+// Contiguous dtype-converting copy through the vec256 conversion routines
+// (vcvtph2ps/vcvtps2ph for Half, the bf16 shifts for BFloat16, vectorized
+// static_cast loops otherwise), split across threads. The generic
+// cpu_kernel cast path converts scalar by scalar.
+template <typename dest_t, typename src_t>
+static void direct_convert_copy(TensorIterator& iter) {
+  dest_t* dst = static_cast<dest_t*>(iter.data_ptr(0));
+  const src_t* src = static_cast<const src_t*>(iter.data_ptr(1));
+  at::parallel_for(
+      0, iter.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        at::vec256::convert(src + begin, dst + begin, end - begin);
+      });
+}
+
 static void copy_kernel(TensorIterator& iter, bool non_blocking) {
   ScalarType dtype = iter.dtype(0);
   if (dtype == iter.dtype(1)) {
+    if (iter.is_contiguous() &&
+        iter.numel() * iter.element_size(0) >= kNonTemporalCopyBytes) {
+      char* dst = static_cast<char*>(iter.data_ptr(0));
+      const char* src = static_cast<const char*>(iter.data_ptr(1));
+      if (dst != src) {
+        const int64_t bytes = iter.numel() * iter.element_size(0);
+        at::parallel_for(
+            0, bytes, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+              memcpy_nontemporal(dst + begin, src + begin, end - begin);
+            });
+      }
+      return;
+    }
     if (dtype == ScalarType::Half) {
       cpu_kernel(iter, [=](at::Half a) -> at::Half { return a; });
     } else if (dtype == ScalarType::BFloat16) {
@@ -40,6 +99,22 @@ static void copy_kernel(TensorIterator& iter, bool non_blocking) {
           });
     }
   } else {
+    if (iter.is_contiguous()) {
+      const ScalarType src_dtype = iter.dtype(1);
+      if (dtype == kFloat && src_dtype == kHalf) {
+        return direct_convert_copy<float, at::Half>(iter);
+      } else if (dtype == kHalf && src_dtype == kFloat) {
+        return direct_convert_copy<at::Half, float>(iter);
+      } else if (dtype == kFloat && src_dtype == kBFloat16) {
+        return direct_convert_copy<float, at::BFloat16>(iter);
+      } else if (dtype == kBFloat16 && src_dtype == kFloat) {
+        return direct_convert_copy<at::BFloat16, float>(iter);
+      } else if (dtype == kFloat && src_dtype == kInt) {
+        return direct_convert_copy<float, int32_t>(iter);
+      } else if (dtype == kInt && src_dtype == kFloat) {
+        return direct_convert_copy<int32_t, float>(iter);
+      }
+    }
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(ScalarType::Half, ScalarType::Bool, ScalarType::BFloat16, dtype, "copy_", [&] {
       using dest_t = scalar_t;
       AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(ScalarType::Half, ScalarType::Bool, ScalarType::BFloat16, iter.dtype(1), "copy_", [&] {
@@ -151,7 +151,7 @@ struct Dist {
     // vector from the input, j is the second, and k is the result index. This
     // parallelizes over the range of k and infers what i and j are from the
     // value of k.
-    parallel_for(0, combs, internal::GRAIN_SIZE / (16 * m), [p, self_start, self_end, n, m, res_start](int64_t k, int64_t end) {
+    parallel_for(0, combs, internal::grain_size_for_cost(16 * m), [p, self_start, self_end, n, m, res_start](int64_t k, int64_t end) {
       const Vec pvec(p);
       double n2 = n - .5;
       // The -1 accounts for floating point truncation issues
@@ -207,7 +207,7 @@ struct Dist {
     int64_t size1 = r1 * m;
     int64_t size2 = r2 * m;
 
-    parallel_for(0, combs * d, internal::GRAIN_SIZE / (16 * m), [=](int64_t start, int64_t end) {
+    parallel_for(0, combs * d, internal::grain_size_for_cost(16 * m), [=](int64_t start, int64_t end) {
       scalar_t * res = res_start + start;
       const scalar_t * const res_end = res_start + end;
       int64_t l = start / combs;
@@ -296,7 +296,7 @@ struct Dist {
     // The only way to parallelize and avoid locking requires parallelizing
     // over the columns of the input, i.e. we compute the gradient for the
     // first section of each vector independentaly of the second section, etc.
-    at::parallel_for(0, m / Vec::size(), internal::GRAIN_SIZE / (8 * n * n), [p, n, m, gs, grad_start, dist_start, self_start, res_start](int64_t l, int64_t end) {
+    at::parallel_for(0, m / Vec::size(), internal::grain_size_for_cost(8 * n * n), [p, n, m, gs, grad_start, dist_start, self_start, res_start](int64_t l, int64_t end) {
       const Vec pvec(p);
 
       const scalar_t * self_l = self_start + l * Vec::size();
@@ -365,7 +365,7 @@ struct Dist {
     const scalar_t * const t2_start = t2.data_ptr<scalar_t>();
     scalar_t * const res_start = result.data_ptr<scalar_t>();
 
-    at::parallel_for(0, m / Vec::size(), internal::GRAIN_SIZE / (16 * r1), [=](int64_t l, int64_t end) {
+    at::parallel_for(0, m / Vec::size(), internal::grain_size_for_cost(16 * r1), [=](int64_t l, int64_t end) {
       const Vec pvec(p);
 
       const scalar_t * i = t1_start + l * Vec::size();
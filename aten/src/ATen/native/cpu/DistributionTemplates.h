@@ -113,6 +113,51 @@ struct RandomKernel {
   }
 };
 
+// ============================================== Bulk uniform fill ===================================================
+
+// Bulk generation for contiguous buffers. The raw engine words are drawn into
+// the destination buffer first (the narrow, strictly serial part), and the
+// conversion to [from, to) runs as a second pass in wide registers. The
+// callers hold the generator mutex. Both overloads produce bit-identical
+// values to drawing at::uniform_real_distribution one element at a time, so
+// the stream observed for a given seed does not change.
+template <typename RNG>
+void uniform_bulk_fill(float* data, int64_t size, float from, float to, RNG generator) {
+  uint32_t* bits = reinterpret_cast<uint32_t*>(data);
+  for (int64_t i = 0; i < size; ++i) {
+    bits[i] = generator->random();
+  }
+  int64_t i = 0;
+#ifdef __AVX2__
+  // mul and add are kept separate (no fmadd) to match the scalar rounding
+  const __m256i mask = _mm256_set1_epi32(FLOAT_MASK);
+  const __m256 divisor = _mm256_set1_ps(FLOAT_DIVISOR);
+  const __m256 range = _mm256_set1_ps(to - from);
+  const __m256 from_v = _mm256_set1_ps(from);
+  for (; i + 8 <= size; i += 8) {
+    const __m256i x = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i)), mask);
+    const __m256 u = _mm256_mul_ps(_mm256_cvtepi32_ps(x), divisor);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_mul_ps(u, range), from_v));
+  }
+#endif
+  for (; i < size; ++i) {
+    const float u = (bits[i] & FLOAT_MASK) * FLOAT_DIVISOR;
+    data[i] = u * (to - from) + from;
+  }
+}
+
+template <typename RNG>
+void uniform_bulk_fill(double* data, int64_t size, double from, double to, RNG generator) {
+  uint64_t* bits = reinterpret_cast<uint64_t*>(data);
+  for (int64_t i = 0; i < size; ++i) {
+    bits[i] = generator->random64();
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    const double u = (bits[i] & DOUBLE_MASK) * DOUBLE_DIVISOR;
+    data[i] = u * (to - from) + from;
+  }
+}
+
 // ==================================================== Normal ========================================================
 
 #ifdef __AVX2__
@@ -140,10 +185,7 @@ void normal_fill_AVX2(Tensor& self, const float mean, const float std, RNG gener
   float *data = self.data_ptr<float>();
   auto size = self.numel();
   std::lock_guard<std::mutex> lock(generator->mutex_);
-  for (int64_t i = 0; i < size; ++i) {
-    at::uniform_real_distribution<float> uniform(0, 1);
-    data[i] = uniform(generator);
-  }
+  uniform_bulk_fill(data, size, 0.0f, 1.0f, generator);
   const __m256 two_pi = _mm256_set1_ps(2.0f * M_PI);
   const __m256 one = _mm256_set1_ps(1.0f);
   const __m256 minus_two = _mm256_set1_ps(-2.0f);
@@ -183,10 +225,7 @@ void normal_fill(Tensor& self, const scalar_t mean, const scalar_t std, RNG gene
   scalar_t *data = self.data_ptr<scalar_t>();
   auto size = self.numel();
   std::lock_guard<std::mutex> lock(generator->mutex_);
-  for (int64_t i = 0; i < size; ++i) {
-    at::uniform_real_distribution<scalar_t> uniform(0, 1);
-    data[i] = uniform(generator);
-  }
+  uniform_bulk_fill(data, size, static_cast<scalar_t>(0), static_cast<scalar_t>(1), generator);
 
   for (int64_t i = 0; i < size - 15; i += 16) {
     normal_fill_16<scalar_t>(data + i, mean, std);
@@ -242,10 +281,15 @@ template<typename RNG>
 void uniform_kernel(TensorIterator& iter, double from, double to, RNG generator) {
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "uniform_kernel_cpu", [&]() {
     std::lock_guard<std::mutex> lock(generator->mutex_);
-    at::uniform_real_distribution<scalar_t> uniform(static_cast<scalar_t>(from), static_cast<scalar_t>(to));
-    cpu_serial_kernel(iter, [&uniform, generator]() -> scalar_t {
-      return static_cast<scalar_t>(uniform(generator));
-    });
+    if (iter.is_contiguous() && iter.numel() >= 16) {
+      uniform_bulk_fill(static_cast<scalar_t*>(iter.data_ptr(0)), iter.numel(),
+                        static_cast<scalar_t>(from), static_cast<scalar_t>(to), generator);
+    } else {
+      at::uniform_real_distribution<scalar_t> uniform(static_cast<scalar_t>(from), static_cast<scalar_t>(to));
+      cpu_serial_kernel(iter, [&uniform, generator]() -> scalar_t {
+        return static_cast<scalar_t>(uniform(generator));
+      });
+    }
   });
 }
 
@@ -6,7 +6,6 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
-#include <ATen/native/cpu/AtomicAddFloat.h>
 
 namespace at { namespace native {
 namespace {
@@ -97,6 +96,41 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   }
 }
 
+// Parallel deterministic accumulation for index_put_(accumulate=true).
+// Duplicate indices make the plain loop a data race, so the destination
+// address space is binned by cache line across threads: every thread scans
+// the full element sequence but applies only the elements whose destination
+// falls in its own bins. Each destination is therefore updated by exactly
+// one thread, in the original element order, so the result is bitwise
+// identical to serial execution regardless of the thread count. The index
+// scan is duplicated per thread, which is why this path is only taken for
+// large problems (the writes dominate there).
+template <typename scalar_t>
+void cpu_index_kernel_accumulate(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride)
+{
+  int ntensor = iter.ntensors();
+  const int num_threads = at::get_num_threads();
+  // Bin by cache line rather than by element to avoid false sharing between
+  // threads updating neighboring destinations.
+  constexpr uintptr_t kBinShift = 6;
+  at::parallel_for(0, num_threads, 1, [&](int64_t begin, int64_t end) {
+    for (auto thread_id = begin; thread_id < end; thread_id++) {
+      auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+        auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
+        char* dst = data[0];
+        char* src = data[1];
+        for (int64_t i = 0; i < n; i++) {
+          char* out = dst + strides[0] * i + indexer.get(i);
+          if ((reinterpret_cast<uintptr_t>(out) >> kBinShift) % num_threads == static_cast<uintptr_t>(thread_id)) {
+            *(scalar_t*)out += *(scalar_t*)(src + strides[1] * i);
+          }
+        }
+      };
+      iter.serial_for_each(loop, {0, iter.numel()});
+    }
+  });
+}
+
 void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride) {
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_cpu", [&] {
@@ -112,13 +146,9 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
     iter.dtype(), "index_put", [&] {
     if (accumulate) {
       bool use_parallel_for = ((iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1));
-      if (iter.dtype() == at::ScalarType::Float && use_parallel_for) {
-        cpu_index_kernel<float>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-          cpu_atomic_add_float((float*)(dst + offset), *(float*)src);
-        });
+      if (use_parallel_for) {
+        cpu_index_kernel_accumulate<scalar_t>(iter, index_size, index_stride);
       } else {
-        // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-        // this needs to be thread-safe.
         cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
           *(scalar_t*)(dst + offset) += *(scalar_t*)src;
         }, /*serial_execution=*/true);
@@ -0,0 +1,77 @@
+#include <ATen/native/Linear.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+
+namespace at {
+namespace native {
+
+namespace {
+
+template <typename scalar_t>
+void linear_activation_impl(Tensor& output, LinearActivation activation) {
+  using Vec = Vec256<scalar_t>;
+  scalar_t* data = output.data_ptr<scalar_t>();
+  at::parallel_for(0, output.numel(), 2048, [&](int64_t begin, int64_t end) {
+    const int64_t size = end - begin;
+    int64_t d = 0;
+    scalar_t* chunk = data + begin;
+    switch (activation) {
+      case LinearActivation::ReLU: {
+        const Vec zero(scalar_t(0));
+        for (; d < size - (size % Vec::size()); d += Vec::size()) {
+          maximum(Vec::loadu(chunk + d), zero).store(chunk + d);
+        }
+        for (; d < size; d++) {
+          chunk[d] = std::max(chunk[d], scalar_t(0));
+        }
+        break;
+      }
+      case LinearActivation::GELU: {
+        const Vec kAlphaVec(M_SQRT1_2);
+        const Vec kOneVec(1);
+        const Vec kPointFiveVec(0.5);
+        for (; d < size - (size % Vec::size()); d += Vec::size()) {
+          const Vec x = Vec::loadu(chunk + d);
+          (x * kPointFiveVec * (kOneVec + (x * kAlphaVec).erf()))
+              .store(chunk + d);
+        }
+        for (; d < size; d++) {
+          constexpr scalar_t kAlpha = M_SQRT1_2;
+          const scalar_t x = chunk[d];
+          chunk[d] = x * scalar_t(0.5) * (scalar_t(1) + std::erf(x * kAlpha));
+        }
+        break;
+      }
+      case LinearActivation::Sigmoid: {
+        const Vec one(scalar_t(1));
+        for (; d < size - (size % Vec::size()); d += Vec::size()) {
+          const Vec x = Vec::loadu(chunk + d);
+          (one + x.neg().exp()).reciprocal().store(chunk + d);
+        }
+        for (; d < size; d++) {
+          chunk[d] = scalar_t(1) / (scalar_t(1) + std::exp(-chunk[d]));
+        }
+        break;
+      }
+    }
+  });
+}
+
+void linear_activation_kernel(Tensor& output, LinearActivation activation) {
+  AT_DISPATCH_FLOATING_TYPES(
+      output.scalar_type(), "linear_activation_cpu", [&] {
+    linear_activation_impl<scalar_t>(output, activation);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(linear_activation_stub, &linear_activation_kernel);
+
+} // namespace native
+} // namespace at
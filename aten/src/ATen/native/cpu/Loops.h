@@ -1,9 +1,10 @@
 #pragma once
 
-// This file provides two functions to help write elementwise kernels:
+// This file provides three functions to help write elementwise kernels:
 //
 //   cpu_kernel(TensorIterator iter, <lambda>)
 //   cpu_kernel_vec(TensorIterator iter, <lambda>, <vec_lambda>)
+//   cpu_kernel_multiple_outputs(TensorIterator iter, <lambda>)
 //
 // Both functions may generate vectorized code. The cpu_kernel implementation
 // relies on the compiler's auto-vectorization. The cpu_kernel_vec
@@ -24,6 +25,13 @@
 //
 // See BinaryOpsKernel.cpp for the complete implementation
 //
+// cpu_kernel_multiple_outputs is for operations that produce several outputs
+// from a single traversal of the inputs (e.g. min+max, mean+var). The lambda
+// returns a std::tuple with one element per output:
+//
+//   cpu_kernel_multiple_outputs(iter, [](float a, float b) {
+//     return std::tuple<float, float>(a + b, a - b);
+//   });
 //
 
 #include <stdint.h>
@@ -108,6 +116,47 @@ execute_op(char* C10_RESTRICT data[], const int64_t* strides, int64_t i, int64_t
   }
 }
 
+// Writes each element of a tuple returned by the op to its corresponding
+// output tensor.
+template <typename tuple_t, std::size_t... INDEX>
+static inline void handle_tuple_outputs(char* C10_RESTRICT data[],
+                                        const int64_t* strides,
+                                        int64_t i,
+                                        const tuple_t& tuple,
+                                        std::index_sequence<INDEX...>) {
+  (void)std::initializer_list<int>{
+      (*(typename std::tuple_element<INDEX, tuple_t>::type*)
+           (data[INDEX] + i * strides[INDEX]) = std::get<INDEX>(tuple), 0)...};
+}
+
+// Loop operation for `cpu_kernel_multiple_outputs`. The outputs come first in
+// `data` and `strides` (matching TensorIterator's operand order); the op
+// returns one std::tuple element per output.
+template <typename func_t>
+static inline void
+multiple_outputs_loop(char* C10_RESTRICT data[], const int64_t* strides_, int64_t i, int64_t n, func_t&& op) {
+  using traits = function_traits<func_t>;
+  using result_type = typename traits::result_type;
+  constexpr int num_outputs = std::tuple_size<result_type>::value;
+  constexpr int ntensors = traits::arity + num_outputs;
+
+  // Copying strides to temporary array helps auto vectorization in older GCC
+  // versions.
+  int64_t strides[ntensors];
+  for (int arg = 0; arg < ntensors; arg++) {
+    strides[arg] = strides_[arg];
+  }
+
+  for (; i < n; i++) {
+    auto output = c10::guts::apply(std::forward<func_t>(op), dereference<traits>(
+        &data[num_outputs],
+        &strides[num_outputs],
+        i));
+    handle_tuple_outputs(data, strides, i, output,
+        std::make_index_sequence<num_outputs>{});
+  }
+}
+
 // Basic loop operation (one output, N inputs). May be auto-vectorized
 // by the compiler. Supports inputs and outputs of different types.
 template <typename func_t>
@@ -201,6 +250,19 @@ void cpu_kernel(TensorIterator& iter, func_t&& op) {
   iter.cast_outputs();
 }
 
+template <typename func_t>
+void cpu_kernel_multiple_outputs(TensorIterator& iter, func_t&& op) {
+  using traits = function_traits<func_t>;
+  constexpr int num_outputs = std::tuple_size<typename traits::result_type>::value;
+  TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity);
+  TORCH_INTERNAL_ASSERT(iter.noutputs() == num_outputs);
+
+  iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
+    multiple_outputs_loop(data, strides, 0, n, std::forward<func_t>(op));
+  });
+  iter.cast_outputs();
+}
+
 template <typename func_t, typename vec_func_t>
 void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<func_t>;
@@ -11,6 +11,58 @@ namespace at {
 namespace native {
 namespace {
 
+// Alias-method sampling (Vose's variant) for drawing with replacement:
+// the distribution is preprocessed in O(n_categories) into buckets where
+// bucket j is split between category j (with probability prob[j]) and a
+// single alias category, after which every draw costs one uniform and one
+// table lookup instead of an O(log n) binary search over the CDF.
+template <typename scalar_t>
+void multinomial_alias_draw(
+    int64_t* result_row,
+    int64_t result_stride,
+    int64_t n_sample,
+    const scalar_t* self_row,
+    int64_t self_stride,
+    int64_t n_categories,
+    double sum,
+    CPUGeneratorImpl* gen) {
+  std::vector<double> prob(n_categories);
+  std::vector<int64_t> alias(n_categories);
+  std::vector<int64_t> small, large;
+  small.reserve(n_categories);
+  large.reserve(n_categories);
+  for (int64_t j = 0; j < n_categories; j++) {
+    prob[j] = static_cast<double>(self_row[j * self_stride]) * n_categories / sum;
+    (prob[j] < 1.0 ? small : large).push_back(j);
+  }
+  while (!small.empty() && !large.empty()) {
+    const int64_t s = small.back();
+    small.pop_back();
+    const int64_t l = large.back();
+    large.pop_back();
+    alias[s] = l;
+    prob[l] = (prob[l] + prob[s]) - 1.0;
+    (prob[l] < 1.0 ? small : large).push_back(l);
+  }
+  // Buckets left over from floating-point rounding own their full column
+  for (const int64_t j : small) {
+    prob[j] = 1.0;
+    alias[j] = j;
+  }
+  for (const int64_t j : large) {
+    prob[j] = 1.0;
+    alias[j] = j;
+  }
+
+  at::uniform_real_distribution<double> uniform(0, 1);
+  for (int64_t j = 0; j < n_sample; j++) {
+    const double u = uniform(gen) * n_categories;
+    const int64_t bucket = std::min(static_cast<int64_t>(u), n_categories - 1);
+    const double frac = u - bucket;
+    result_row[j * result_stride] = frac < prob[bucket] ? bucket : alias[bucket];
+  }
+}
+
 template<typename scalar_t>
 void multinomial_apply(Tensor& result, const Tensor& self, const int64_t n_sample, const bool with_replacement, c10::optional<Generator> generator) {
   auto gen = get_generator_or_default<CPUGeneratorImpl>(generator, detail::getDefaultCPUGenerator());
@@ -64,6 +116,22 @@ void multinomial_apply(Tensor& result, const Tensor& self, const int64_t n_sampl
     TORCH_CHECK(with_replacement || (n_categories - n_zeros >= n_sample),
         "invalid multinomial distribution (with replacement=False, not enough non-negative category to sample)");
 
+    /* with replacement and enough draws to amortize the O(n_categories)
+    table build, switch to the alias method: each draw is then O(1)
+    instead of an O(log n_categories) search over the CDF */
+    if (with_replacement && n_sample >= 64 && n_sample * 16 >= n_categories) {
+      multinomial_alias_draw(
+          result_ptr + i * result_dist_stride_0,
+          result_dist_stride_1,
+          n_sample,
+          self_ptr + i * self_stride_0,
+          self_stride_1,
+          n_categories,
+          static_cast<double>(sum),
+          gen);
+      continue;
+    }
+
     /* normalize cumulative probability distribution so that last val is 1
     i.e. doesn't assume original self row sums to one */
     if ((sum > 0) || ((sum < 1.00001) && (sum > 0.99999))) {
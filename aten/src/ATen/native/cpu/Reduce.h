@@ -218,7 +218,7 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
     };
     acc_t total_acc = init;
     auto numel = sub_iter.numel();
-    if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
+    if (numel < at::default_grain_size() || at::get_num_threads() == 1 ||
         at::in_parallel_region()) {
       total_acc = reduction_body(total_acc, 0, numel);
     } else {
@@ -229,7 +229,7 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
         "Concurrently modifying different references into std::vector<bool> is UB."
       );
       std::vector<acc_t> buffer((unsigned)max_threads, init);
-      at::parallel_for(0, numel, internal::GRAIN_SIZE,
+      at::parallel_for(0, numel, at::default_grain_size(),
         [&](int64_t begin, int64_t end) {
           auto& acc = buffer[at::get_thread_num()];
           acc = reduction_body(acc, begin, end);
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/ReduceOpsUtils.h>
@@ -69,11 +70,80 @@ static inline void cpu_cum_base_kernel(Tensor& result,
   iter.for_each(loop);
 }
 
+// Two-pass blocked scan over a single long contiguous line. Pass one scans
+// each block locally, the per-block totals are scanned serially (num_blocks
+// elements), and pass two folds each block's carry into its results; that
+// fix-up loop is an elementwise combine the compiler can vectorize. Used when
+// the whole tensor is one scan line, where the line-level parallelism of the
+// generic path has nothing to distribute.
+template <typename scalar_t, typename func_t>
+static void cpu_blocked_scan_kernel(Tensor& result, const Tensor& self,
+    const func_t& op, scalar_t init_val) {
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  scalar_t* result_data = result.data_ptr<scalar_t>();
+  const scalar_t* self_data = self.data_ptr<scalar_t>();
+  const int64_t size = self.numel();
+  const int64_t num_blocks = std::max(
+      (int64_t)1,
+      std::min((int64_t)at::get_num_threads(), divup(size, internal::GRAIN_SIZE)));
+  const int64_t block_size = divup(size, num_blocks);
+
+  std::vector<accscalar_t> carry(num_blocks);
+  at::parallel_for(0, num_blocks, 1, [&](int64_t block_begin, int64_t block_end) {
+    for (int64_t b = block_begin; b < block_end; b++) {
+      const int64_t begin = b * block_size;
+      const int64_t end = std::min(begin + block_size, size);
+      accscalar_t acc = init_val;
+      for (int64_t i = begin; i < end; i++) {
+        acc = op(acc, (accscalar_t)self_data[i]);
+        result_data[i] = (scalar_t)acc;
+      }
+      carry[b] = acc;
+    }
+  });
+  // exclusive scan of the block totals: carry[b] becomes the prefix of block b
+  accscalar_t running = init_val;
+  for (int64_t b = 0; b < num_blocks; b++) {
+    const accscalar_t block_total = carry[b];
+    carry[b] = running;
+    running = op(running, block_total);
+  }
+  at::parallel_for(1, num_blocks, 1, [&](int64_t block_begin, int64_t block_end) {
+    for (int64_t b = block_begin; b < block_end; b++) {
+      const int64_t begin = b * block_size;
+      const int64_t end = std::min(begin + block_size, size);
+      const accscalar_t prefix = carry[b];
+      for (int64_t i = begin; i < end; i++) {
+        result_data[i] = (scalar_t)op(prefix, (accscalar_t)result_data[i]);
+      }
+    }
+  });
+}
+
+static bool cpu_scan_is_single_long_line(Tensor& result, const Tensor& self,
+    int64_t dim_size) {
+  if (self.numel() != dim_size || dim_size < 2 * internal::GRAIN_SIZE) {
+    return false;
+  }
+  if (result.sizes() != self.sizes()) {
+    result.resize_as_(self);
+  }
+  return self.is_contiguous() && result.is_contiguous() &&
+      result.scalar_type() == self.scalar_type();
+}
+
 static void cumsum_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
   int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "cumsum_out_cpu", [&] {
+    using accscalar_t = at::acc_type<scalar_t, false>;
+    if (cpu_scan_is_single_long_line(result, self, self_dim_size)) {
+      cpu_blocked_scan_kernel<scalar_t>(result, self,
+        [](accscalar_t a, accscalar_t b) -> accscalar_t { return a + b; },
+        /*init_val=*/ 0);
+      return;
+    }
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
       scalar_t* result_data, auto result_dim_stride,
       const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
@@ -92,6 +162,13 @@ static void cumprod_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim)
   int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "cumprod_out_cpu", [&] {
+    using accscalar_t = at::acc_type<scalar_t, false>;
+    if (cpu_scan_is_single_long_line(result, self, self_dim_size)) {
+      cpu_blocked_scan_kernel<scalar_t>(result, self,
+        [](accscalar_t a, accscalar_t b) -> accscalar_t { return a * b; },
+        /*init_val=*/ 1);
+      return;
+    }
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
       scalar_t* result_data, auto result_dim_stride,
       const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
@@ -265,7 +342,144 @@ static void max_values_kernel_impl(TensorIterator& iter) {
   });
 }
 
+// Reduces a contiguous run to its extremum with Vec256 lanes; the lanes are
+// combined horizontally at the end. maximum()/minimum() propagate NaNs, so a
+// NaN anywhere in the run wins like in GreaterOrNan/LessOrNan.
+template <typename scalar_t, bool is_max>
+static inline scalar_t reduce_extremum_contiguous(const scalar_t* data, int64_t n) {
+  using Vec = Vec256<scalar_t>;
+  using comp_t = typename std::conditional<is_max,
+      detail::GreaterOrNan<scalar_t>, detail::LessOrNan<scalar_t>>::type;
+  constexpr int64_t W = Vec::size();
+  scalar_t best = data[0];
+  int64_t d = 0;
+  if (n >= W) {
+    Vec acc = Vec::loadu(data);
+    for (d = W; d + W <= n; d += W) {
+      Vec values = Vec::loadu(data + d);
+      acc = is_max ? maximum(acc, values) : minimum(acc, values);
+    }
+    scalar_t lanes[Vec::size()];
+    acc.store(lanes);
+    best = lanes[0];
+    for (int64_t j = 1; j < W; j++) {
+      best = comp_t{}(best, lanes[j]) ? best : lanes[j];
+    }
+  }
+  for (; d < n; d++) {
+    best = comp_t{}(best, data[d]) ? best : data[d];
+  }
+  return best;
+}
+
+// Finds the first position of `best` (or of any NaN, when `best` is NaN) in a
+// contiguous run, scanning a whole vector of lanes per comparison and only
+// dropping to scalar inside the block that contains the hit.
+template <typename scalar_t>
+static inline int64_t find_extremum_index(const scalar_t* data, int64_t n, scalar_t best) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  int64_t d = 0;
+  if (_isnan<scalar_t>(best)) {
+    for (; d + W <= n; d += W) {
+      Vec values = Vec::loadu(data + d);
+      if ((values == values).zero_mask()) { // some lane is NaN
+        break;
+      }
+    }
+    for (; d < n; d++) {
+      if (_isnan<scalar_t>(data[d])) {
+        return d;
+      }
+    }
+  } else {
+    const Vec best_vec(best);
+    for (; d + W <= n; d += W) {
+      Vec values = Vec::loadu(data + d);
+      if ((values != best_vec).zero_mask()) { // some lane equals best
+        break;
+      }
+    }
+    for (; d < n; d++) {
+      if (data[d] == best) {
+        return d;
+      }
+    }
+  }
+  return n - 1; // unreachable when `best` came from this run
+}
+
+// argmax/argmin with a vectorized inner loop: when the reduced slice is
+// contiguous, the extremum is found with Vec256 compares and its index with a
+// vectorized scan, instead of carrying the running index through a scalar
+// loop. The parallelization structure (one thread per output element, or
+// chunked with a final combine for a single output) mirrors
+// binary_kernel_reduce; strided slices keep the scalar reduce.
+template <typename scalar_t, bool is_max>
+static void arg_reduce_kernel_vec(TensorIterator& iter) {
+  using ops_t = typename std::conditional<is_max,
+      ArgMaxOps<scalar_t>, ArgMinOps<scalar_t>>::type;
+  using comp_t = typename std::conditional<is_max,
+      detail::GreaterOrNan<scalar_t>, detail::LessOrNan<scalar_t>>::type;
+  using arg_t = std::pair<scalar_t, int64_t>;
+  using r_traits = binary_function_traits<decltype(&ops_t::reduce)>;
+  ops_t ops;
+  const arg_t init(is_max ? lower_bound<scalar_t>() : upper_bound<scalar_t>(), -1);
+  const int num_outputs = iter.noutputs();
+  iter.foreach_reduced_elt([&](TensorIterator& sub_iter) {
+    auto reduction_body = [&](arg_t acc, int64_t begin, int64_t end) -> arg_t {
+      int ntensors = sub_iter.ntensors();
+      int64_t k = begin;
+      sub_iter.serial_for_each([&](char** data, const int64_t* strides, int64_t size) {
+        const char* in_bytes = data[ntensors - 1];
+        int64_t stride = strides[ntensors - 1];
+        if (stride == (int64_t)sizeof(scalar_t)) {
+          const scalar_t* in = (const scalar_t*)in_bytes;
+          scalar_t best = reduce_extremum_contiguous<scalar_t, is_max>(in, size);
+          if (!comp_t{}(acc.first, best)) {
+            acc = arg_t(best, k + find_extremum_index(in, size, best));
+          }
+        } else {
+          for (int64_t i = 0; i < size; ++i) {
+            acc = ops.reduce(acc, *(const scalar_t*)(in_bytes + i * stride), k + i);
+          }
+        }
+        k += size;
+      }, {begin, end});
+      return ops.translate_idx(acc, sub_iter.view_offsets()[0]);
+    };
+    arg_t total_acc = init;
+    auto numel = sub_iter.numel();
+    if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
+        at::in_parallel_region()) {
+      total_acc = reduction_body(total_acc, 0, numel);
+    } else {
+      int max_threads = at::get_num_threads();
+      std::vector<arg_t> buffer((unsigned)max_threads, init);
+      at::parallel_for(0, numel, internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          auto& acc = buffer[at::get_thread_num()];
+          acc = reduction_body(acc, begin, end);
+        });
+      for (int i = 0; i < max_threads; ++i) {
+        total_acc = ops.combine(total_acc, buffer[i]);
+      }
+    }
+    set_results<r_traits>(ops.project(total_acc), sub_iter, num_outputs);
+  });
+}
+
 static void argmax_kernel_impl(TensorIterator &iter) {
+  // the vectorized kernel is only worthwhile for dtypes with wide Vec256
+  // comparisons and a NaN-aware maximum
+  switch (iter.dtype(1)) {
+    case ScalarType::Float:
+      return arg_reduce_kernel_vec<float, /*is_max=*/true>(iter);
+    case ScalarType::Double:
+      return arg_reduce_kernel_vec<double, /*is_max=*/true>(iter);
+    default:
+      break;
+  }
   AT_DISPATCH_ALL_TYPES(iter.dtype(1), "argmax_cpu", [&] {
     binary_kernel_reduce(
       iter,
@@ -275,6 +489,14 @@ static void argmax_kernel_impl(TensorIterator &iter) {
 }
 
 static void argmin_kernel_impl(TensorIterator &iter) {
+  switch (iter.dtype(1)) {
+    case ScalarType::Float:
+      return arg_reduce_kernel_vec<float, /*is_max=*/false>(iter);
+    case ScalarType::Double:
+      return arg_reduce_kernel_vec<double, /*is_max=*/false>(iter);
+    default:
+      break;
+  }
   AT_DISPATCH_ALL_TYPES(iter.dtype(1), "argmin_cpu", [&] {
     binary_kernel_reduce(
       iter,
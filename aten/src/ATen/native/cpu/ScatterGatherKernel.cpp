@@ -275,7 +275,135 @@ void scatter_fill_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, Sca
   );
 }
 
+// Note [Binned parallel scatter_add]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// scatter_add_ cannot use iter.for_each directly because two elements may
+// target the same output slot. Instead of serializing, the fast path below
+// makes the conflicts impossible: the output rows are split into one
+// partition per thread, the input elements are radix-binned by the partition
+// that owns their target row (parallel per-chunk histogram + prefix sum +
+// parallel fill), and then each partition accumulates its own bin. Since a
+// partition is touched by exactly one thread, no locking is needed, and
+// because bins are filled in (partition, chunk, element) order the
+// accumulation order per output slot is deterministic.
+//
+// The fast path covers the common aggregation layout: dim == 0, all three
+// tensors contiguous, index.sizes() == src.sizes() and the trailing
+// dimensions matching self. Everything else falls back to the serial kernel.
+template <typename scalar_t>
+void scatter_add_binned_impl(Tensor& self, const Tensor& index, const Tensor& src) {
+  int64_t index_upper_bound = self.size(0);
+  int64_t inner = index.numel() / ensure_nonempty_size(index, 0);
+  int64_t nelem = index.numel();
+
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  const scalar_t* src_data = src.data_ptr<scalar_t>();
+  scalar_t* self_data = self.data_ptr<scalar_t>();
+
+  const int64_t num_partitions = at::get_num_threads();
+  const int64_t rows_per_partition =
+      (index_upper_bound + num_partitions - 1) / num_partitions;
+  const int64_t chunk_size = std::max(
+      (int64_t)at::internal::GRAIN_SIZE, (nelem + num_partitions - 1) / num_partitions);
+  const int64_t num_chunks = (nelem + chunk_size - 1) / chunk_size;
+
+  // per-chunk histogram over the owning partitions
+  std::vector<int64_t> counts(num_chunks * num_partitions, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t c_begin, int64_t c_end) {
+    for (int64_t c = c_begin; c < c_end; ++c) {
+      int64_t* chunk_counts = counts.data() + c * num_partitions;
+      int64_t e_end = std::min(nelem, (c + 1) * chunk_size);
+      for (int64_t e = c * chunk_size; e < e_end; ++e) {
+        int64_t idx_dim = index_data[e];
+        TORCH_CHECK(idx_dim >= 0 && idx_dim < index_upper_bound,
+          "index ", index_data[e],
+          " is out of bounds for dimension ", 0,
+          " with size ", index_upper_bound
+        );
+        chunk_counts[idx_dim / rows_per_partition]++;
+      }
+    }
+  });
+
+  // prefix sum in (partition, chunk) order so that each (chunk, partition)
+  // pair gets a disjoint slice of the bin array
+  std::vector<int64_t> offsets(num_chunks * num_partitions);
+  std::vector<int64_t> partition_begin(num_partitions + 1);
+  int64_t running = 0;
+  for (int64_t p = 0; p < num_partitions; ++p) {
+    partition_begin[p] = running;
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      offsets[c * num_partitions + p] = running;
+      running += counts[c * num_partitions + p];
+    }
+  }
+  partition_begin[num_partitions] = running;
+
+  // scatter the element positions into their partition's bin
+  std::vector<int64_t> bins(nelem);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t c_begin, int64_t c_end) {
+    for (int64_t c = c_begin; c < c_end; ++c) {
+      int64_t* chunk_offsets = offsets.data() + c * num_partitions;
+      int64_t e_end = std::min(nelem, (c + 1) * chunk_size);
+      for (int64_t e = c * chunk_size; e < e_end; ++e) {
+        bins[chunk_offsets[index_data[e] / rows_per_partition]++] = e;
+      }
+    }
+  });
+
+  // each partition accumulates its bin; partitions own disjoint output rows
+  at::parallel_for(0, num_partitions, 1, [&](int64_t p_begin, int64_t p_end) {
+    for (int64_t p = p_begin; p < p_end; ++p) {
+      for (int64_t pos = partition_begin[p]; pos < partition_begin[p + 1]; ++pos) {
+        int64_t e = bins[pos];
+        self_data[index_data[e] * inner + e % inner] += src_data[e];
+      }
+    }
+  });
+}
+
+bool try_scatter_add_binned(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (dim != 0 || at::get_num_threads() == 1 ||
+      index.numel() < at::internal::GRAIN_SIZE) {
+    return false;
+  }
+  if (self.dim() == 0 || self.size(0) == 0) {
+    return false;
+  }
+  if (!self.is_contiguous() || !index.is_contiguous() || !src.is_contiguous()) {
+    return false;
+  }
+  if (index.scalar_type() != ScalarType::Long ||
+      self.scalar_type() != src.scalar_type()) {
+    return false;
+  }
+  // the binned kernel addresses elements linearly, so the iteration domain
+  // must cover src entirely and the trailing dims must match self
+  if (!index.sizes().equals(src.sizes()) || index.dim() != self.dim()) {
+    return false;
+  }
+  for (int64_t d = 1; d < self.dim(); ++d) {
+    if (index.size(d) != self.size(d)) {
+      return false;
+    }
+  }
+  AT_DISPATCH_ALL_TYPES_AND2(
+    ScalarType::Bool, ScalarType::Half, self.scalar_type(),
+    "scatter_add_binned", [&] {
+      scatter_add_binned_impl<scalar_t>(self, index, src);
+    }
+  );
+  return true;
+}
+
 void scatter_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (index.numel() != 0) {
+    int64_t wrapped_dim = maybe_wrap_dim(dim, self.dim());
+    scatter_shape_check(self, wrapped_dim, index, src);
+    if (try_scatter_add_binned(self, wrapped_dim, index, src)) {
+      return;
+    }
+  }
   cpu_scatter_gather_base_kernel<>()(
     self, dim, index, src,
     "scatter_add_", [] (auto* lhs, const auto* rhs) {
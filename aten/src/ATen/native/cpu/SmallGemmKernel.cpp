@@ -0,0 +1,59 @@
+#include <ATen/native/LinearAlgebra.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Plain register-blocked GEMM for matrices of at most kSmallGemmMaxDim per
+// dimension: one thread, no packing, no heuristics. The full right-hand side
+// fits in L1/L2 at these sizes, so a single accumulate-over-k sweep per
+// output row block is already bandwidth-optimal; everything BLAS adds on top
+// (thread pool wake-up, kernel selection, packing) only costs time here.
+template <typename scalar_t>
+void small_gemm_impl(Tensor& result, const Tensor& self, const Tensor& mat2) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t m = self.size(0);
+  const int64_t k = self.size(1);
+  const int64_t n = mat2.size(1);
+  const scalar_t* a = self.data_ptr<scalar_t>();
+  const scalar_t* b = mat2.data_ptr<scalar_t>();
+  scalar_t* c = result.data_ptr<scalar_t>();
+
+  for (int64_t i = 0; i < m; ++i) {
+    const scalar_t* a_row = a + i * k;
+    scalar_t* c_row = c + i * n;
+    int64_t j = 0;
+    for (; j < n - (n % Vec::size()); j += Vec::size()) {
+      Vec acc(scalar_t(0));
+      for (int64_t p = 0; p < k; ++p) {
+        acc = acc + Vec(a_row[p]) * Vec::loadu(b + p * n + j);
+      }
+      acc.store(c_row + j);
+    }
+    for (; j < n; ++j) {
+      scalar_t acc = scalar_t(0);
+      for (int64_t p = 0; p < k; ++p) {
+        acc += a_row[p] * b[p * n + j];
+      }
+      c_row[j] = acc;
+    }
+  }
+}
+
+void small_gemm_kernel(Tensor& result, const Tensor& self, const Tensor& mat2) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "small_gemm_cpu", [&] {
+    small_gemm_impl<scalar_t>(result, self, mat2);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(small_gemm_stub, &small_gemm_kernel);
+
+} // namespace native
+} // namespace at
@@ -9,6 +9,99 @@ namespace at { namespace native {
 
 namespace {
 
+// Like dim_apply, but iterating the slices on the calling thread so that the
+// parallelism can go inside the (few, long) slices instead.
+template <typename Fn>
+void dim_apply_serial(TensorList tensors, int64_t dim, Fn f) {
+  auto t = tensors[0];
+  auto sizes = t.sizes();
+  int64_t ndim = t.dim();
+  int64_t itersize = 1;
+  for (int64_t i = 0; i < ndim; i++) {
+    if (i != dim) {
+      itersize *= t.size(i);
+    }
+  }
+  std::vector<Tensor> narrowed_tensors;
+  narrowed_tensors.reserve(tensors.size());
+  for (int64_t it = 0; it < itersize; it++) {
+    narrowed_tensors.clear();
+    for (auto ti : tensors) {
+      int64_t i = it;
+      Tensor nt = ti;
+      for (int64_t d = 0; d < ndim; d++) {
+        if (d != dim) {
+          nt = nt.select((d > dim ? 1 : 0), i % sizes[d]);
+          i = i / sizes[d];
+        }
+      }
+      narrowed_tensors.emplace_back(nt);
+    }
+    f(it, narrowed_tensors);
+  }
+}
+
+// Parallel top-k within one long slice: each chunk selects its own top-k
+// candidates with nth_element on one thread, and the final top-k is then
+// selected from the O(num_chunks * k) survivors. The per-element work is a
+// chunk-local scan-and-select, so a single huge slice scales with cores
+// instead of pinning one.
+template <typename scalar_t, typename Comp>
+void topk_within_slice(
+    TensorAccessor<scalar_t, 1> row,
+    TensorAccessor<scalar_t, 1> mode_values,
+    TensorAccessor<int64_t, 1> mode_indices,
+    int64_t k,
+    bool sorted,
+    const Comp& comp) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  const int64_t n = row.size(0);
+  const int64_t num_chunks = std::max(
+      (int64_t)1,
+      std::min(
+          (int64_t)at::get_num_threads(),
+          (n + internal::GRAIN_SIZE - 1) / internal::GRAIN_SIZE));
+  const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+  std::vector<elem_t> candidates(num_chunks * k);
+  std::vector<int64_t> counts(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    std::vector<elem_t> queue;
+    for (int64_t c = chunk_begin; c < chunk_end; c++) {
+      const int64_t begin = c * chunk_size;
+      const int64_t end = std::min(begin + chunk_size, n);
+      queue.resize(end - begin);
+      for (int64_t j = begin; j < end; j++) {
+        queue[j - begin].first = row[j];
+        queue[j - begin].second = j;
+      }
+      const int64_t kc = std::min(k, end - begin);
+      if (kc < (int64_t)queue.size()) {
+        std::nth_element(queue.begin(), queue.begin() + kc - 1, queue.end(), comp);
+      }
+      std::copy(queue.begin(), queue.begin() + kc, candidates.begin() + c * k);
+      counts[c] = kc;
+    }
+  });
+  // compact the survivors (short chunks may contribute fewer than k)
+  std::vector<elem_t> merged;
+  merged.reserve(num_chunks * k);
+  for (int64_t c = 0; c < num_chunks; c++) {
+    merged.insert(
+        merged.end(),
+        candidates.begin() + c * k,
+        candidates.begin() + c * k + counts[c]);
+  }
+  if (sorted) {
+    std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), comp);
+  } else if (k < (int64_t)merged.size()) {
+    std::nth_element(merged.begin(), merged.begin() + k - 1, merged.end(), comp);
+  }
+  for (int64_t j = 0; j < k; j++) {
+    mode_values[j] = merged[j].first;
+    mode_indices[j] = merged[j].second;
+  }
+}
+
 static void topk_kernel(
     Tensor& values,
     Tensor& indices,
@@ -18,6 +111,39 @@ static void topk_kernel(
     bool largest,
     bool sorted) {
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "topk_cpu", [&] {
+    using elem_t = std::pair<scalar_t, int64_t>;
+    // we want NaN to be sorted as top for numpy compatibility
+    auto comp_largest = [](const elem_t& x, const elem_t& y) -> bool {
+      return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
+    };
+    auto comp_smallest = [](const elem_t& x, const elem_t& y) -> bool {
+      return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
+    };
+
+    // When there are fewer slices than threads but the slices are long (one
+    // 10M-score row is the retrieval-service shape), slice-level parallelism
+    // leaves most cores idle; parallelize the selection within each slice
+    // instead.
+    const int64_t slice_size = self.dim() > 0 ? self.size(dim) : 1;
+    const int64_t num_slices = self.numel() / std::max<int64_t>(slice_size, 1);
+    if (k > 0 && num_slices < at::get_num_threads() &&
+        slice_size >= 2 * internal::GRAIN_SIZE) {
+      dim_apply_serial(
+          {self, values, indices},
+          dim,
+          [&](int64_t i, TensorList tl) {
+            auto row = tl[0].accessor<scalar_t, 1>();
+            auto mode_values = tl[1].accessor<scalar_t, 1>();
+            auto mode_indices = tl[2].accessor<int64_t, 1>();
+            if (largest) {
+              topk_within_slice(row, mode_values, mode_indices, k, sorted, comp_largest);
+            } else {
+              topk_within_slice(row, mode_values, mode_indices, k, sorted, comp_smallest);
+            }
+          });
+      return;
+    }
+
     dim_apply(
         {self, values, indices},
         dim,
@@ -29,48 +155,28 @@ static void topk_kernel(
           auto n = tmp_values.size(0);
           auto use_partial_sort = k * 64 <= n;
 
-          using elem_t = std::pair<scalar_t, int64_t>;
           std::vector<elem_t> queue(n);
           for (int64_t j = 0; j < n; j++) {
             queue[j].first = tmp_values[j];
             queue[j].second = j;
           }
 
-          // we want NaN to be sorted as top for numpy compatibility
           if (use_partial_sort) {
             if (largest) {
-              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                });
+              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(), comp_largest);
             } else {
-              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                });
+              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(), comp_smallest);
             }
           } else {
             if (largest) {
-              std::nth_element(queue.begin(), queue.begin() + k - 1, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                });
+              std::nth_element(queue.begin(), queue.begin() + k - 1, queue.end(), comp_largest);
               if (sorted) {
-                std::sort(queue.begin(), queue.begin() + k - 1,
-                  [](const elem_t& x, const elem_t& y) -> bool {
-                    return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                  });
+                std::sort(queue.begin(), queue.begin() + k - 1, comp_largest);
               }
             } else {
-              std::nth_element(queue.begin(), queue.begin() + k -1, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                });
+              std::nth_element(queue.begin(), queue.begin() + k -1, queue.end(), comp_smallest);
               if (sorted) {
-                std::sort(queue.begin(), queue.begin() + k -1,
-                  [](const elem_t& x, const elem_t& y) -> bool {
-                    return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                  });
+                std::sort(queue.begin(), queue.begin() + k -1, comp_smallest);
               }
             }
           }
@@ -179,7 +179,16 @@ static void sign_kernel(TensorIterator& iter){
 }
 
 static void sinh_kernel(TensorIterator& iter) {
-  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(iter.dtype(), "sinh_cpu", [&]() {
+  if (isComplexType(iter.dtype())) {
+    AT_DISPATCH_COMPLEX_TYPES(iter.dtype(), "sinh_cpu", [&]() {
+      cpu_kernel_vec(
+          iter,
+          [=](scalar_t a) -> scalar_t { return std::sinh(a); },
+          [=](Vec256<scalar_t> a) { return a.sinh(); });
+    });
+    return;
+  }
+  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sinh_cpu", [&]() {
     cpu_kernel(
         iter,
         [=](scalar_t a) -> scalar_t { return std::sinh(a); });
@@ -187,7 +196,16 @@ static void sinh_kernel(TensorIterator& iter) {
 }
 
 static void cosh_kernel(TensorIterator& iter) {
-  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(iter.dtype(), "cosh_cpu", [&]() {
+  if (isComplexType(iter.dtype())) {
+    AT_DISPATCH_COMPLEX_TYPES(iter.dtype(), "cosh_cpu", [&]() {
+      cpu_kernel_vec(
+          iter,
+          [=](scalar_t a) -> scalar_t { return std::cosh(a); },
+          [=](Vec256<scalar_t> a) { return a.cosh(); });
+    });
+    return;
+  }
+  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "cosh_cpu", [&]() {
     cpu_kernel(
         iter,
         [=](scalar_t a) -> scalar_t { return std::cosh(a); });
@@ -196,9 +214,52 @@ static void cosh_kernel(TensorIterator& iter) {
 
 static void digamma_kernel(TensorIterator& iter) {
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "digamma", [&]() {
-    cpu_kernel(
+    using Vec = Vec256<scalar_t>;
+    cpu_kernel_vec(
         iter,
-        [=](scalar_t a) -> scalar_t { return calc_digamma(a); });
+        [=](scalar_t a) -> scalar_t { return calc_digamma(a); },
+        [=](Vec x) {
+          // Vectorized Cephes digamma for the positive domain: masked
+          // recurrence pushing x to >= 10 followed by the asymptotic
+          // series. Lanes needing the reflection formula or the pole at
+          // zero (x <= 0) are patched up with the scalar routine.
+          const Vec zero(scalar_t(0));
+          const Vec one(scalar_t(1));
+          const Vec ten(scalar_t(10));
+          Vec result = zero;
+          Vec xx = x;
+          // Push x to be >= 10 (at most 10 masked steps).
+          for (int64_t i = 0; i < 10; i++) {
+            auto mask = xx < ten;
+            result = result - Vec::blendv(zero, one / xx, mask);
+            xx = xx + Vec::blendv(zero, one, mask);
+          }
+          const Vec z = one / (xx * xx);
+          Vec y = Vec(scalar_t(8.33333333333333333333E-2));
+          y = fmadd(y, z, Vec(scalar_t(-2.10927960927960927961E-2)));
+          y = fmadd(y, z, Vec(scalar_t(7.57575757575757575758E-3)));
+          y = fmadd(y, z, Vec(scalar_t(-4.16666666666666666667E-3)));
+          y = fmadd(y, z, Vec(scalar_t(3.96825396825396825397E-3)));
+          y = fmadd(y, z, Vec(scalar_t(-8.33333333333333333333E-3)));
+          y = fmadd(y, z, Vec(scalar_t(8.33333333333333333333E-2)));
+          Vec out = result + xx.log() - Vec(scalar_t(0.5)) / xx - y * z;
+          // x that lands exactly on 10 takes the tabulated psi(10),
+          // matching the scalar routine bit for bit.
+          out = Vec::blendv(
+              out,
+              result + Vec(scalar_t(2.25175258906672110764)),
+              xx == ten);
+          __at_align32__ scalar_t in_buf[Vec::size()];
+          __at_align32__ scalar_t out_buf[Vec::size()];
+          x.store(in_buf);
+          out.store(out_buf);
+          for (int64_t i = 0; i < Vec::size(); i++) {
+            if (in_buf[i] <= scalar_t(0)) {
+              out_buf[i] = calc_digamma(in_buf[i]);
+            }
+          }
+          return Vec::loadu(out_buf);
+        });
   });
 }
 
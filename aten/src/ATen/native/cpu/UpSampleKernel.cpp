@@ -3,6 +3,11 @@
 #include <ATen/Dispatch.h>
 #include <ATen/native/UpSample.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace at {
 namespace native {
@@ -50,6 +55,129 @@ static inline int64_t nearest_idx(
   }
 }
 
+// Note [Upsample coefficient cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Video and detection pipelines resize long streams of frames that all share
+// the same (input, output) geometry, so the per-output-index source indices
+// and interpolation weights are identical from call to call. They are cached
+// here keyed on the geometry and handed out as shared_ptr to immutable
+// tables, so concurrent callers only contend on the lookup lock and the
+// kernel inner loops are reduced to gathers and FMAs.
+struct CoeffKey {
+  int64_t input_size;
+  int64_t output_size;
+  bool align_corners;
+  bool has_scale;
+  double scale;
+
+  bool operator==(const CoeffKey& other) const {
+    return input_size == other.input_size && output_size == other.output_size &&
+        align_corners == other.align_corners && has_scale == other.has_scale &&
+        scale == other.scale;
+  }
+};
+
+constexpr size_t kMaxCoeffCacheEntries = 64;
+
+template <typename coeff_t, typename fill_fn_t>
+std::shared_ptr<const coeff_t> lookup_coeffs(
+    std::mutex& cache_mutex,
+    std::vector<std::pair<CoeffKey, std::shared_ptr<const coeff_t>>>& cache,
+    const CoeffKey& key,
+    const fill_fn_t& fill_fn) {
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    for (auto& entry : cache) {
+      if (entry.first == key) {
+        return entry.second;
+      }
+    }
+  }
+  auto coeffs = std::make_shared<coeff_t>();
+  fill_fn(*coeffs);
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  if (cache.size() >= kMaxCoeffCacheEntries) {
+    cache.erase(cache.begin());
+  }
+  cache.emplace_back(key, coeffs);
+  return coeffs;
+}
+
+std::shared_ptr<const std::vector<int64_t>> get_nearest_indices(
+    int64_t input_size,
+    int64_t output_size,
+    c10::optional<double> scales) {
+  static std::mutex cache_mutex;
+  static std::vector<std::pair<CoeffKey, std::shared_ptr<const std::vector<int64_t>>>> cache;
+  CoeffKey key{input_size, output_size, /*align_corners=*/false,
+               scales.has_value(), scales.value_or(0.0)};
+  return lookup_coeffs(cache_mutex, cache, key,
+      [&](std::vector<int64_t>& indices) {
+    indices.resize(output_size);
+    for (int64_t i = 0; i < output_size; i++) {
+      indices[i] = nearest_idx(i, input_size, output_size, scales);
+    }
+  });
+}
+
+// Source indices of the two neighbours and their interpolation weights for
+// every output index along one dimension.
+template <typename scalar_t>
+struct LinearCoeffs {
+  std::vector<int64_t> idx0;
+  std::vector<int64_t> idx1;
+  std::vector<scalar_t> lambda0;
+  std::vector<scalar_t> lambda1;
+};
+
+template <typename scalar_t>
+std::shared_ptr<const LinearCoeffs<scalar_t>> get_linear_coeffs(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    c10::optional<double> scales) {
+  static std::mutex cache_mutex;
+  static std::vector<std::pair<CoeffKey, std::shared_ptr<const LinearCoeffs<scalar_t>>>> cache;
+  CoeffKey key{input_size, output_size, align_corners,
+               scales.has_value(), scales.value_or(0.0)};
+  return lookup_coeffs(cache_mutex, cache, key,
+      [&](LinearCoeffs<scalar_t>& coeffs) {
+    coeffs.idx0.resize(output_size);
+    coeffs.idx1.resize(output_size);
+    coeffs.lambda0.resize(output_size);
+    coeffs.lambda1.resize(output_size);
+    const scalar_t rscale = area_pixel_compute_scale<scalar_t>(
+        input_size, output_size, align_corners, scales);
+    for (int64_t i = 0; i < output_size; i++) {
+      const scalar_t real_idx = area_pixel_compute_source_index<scalar_t>(
+          rscale, i, align_corners, /*cubic=*/false);
+      const int64_t idx0 = real_idx;
+      const int64_t idxp = (idx0 < input_size - 1) ? 1 : 0;
+      coeffs.idx0[i] = idx0;
+      coeffs.idx1[i] = idx0 + idxp;
+      coeffs.lambda1[i] = real_idx - idx0;
+      coeffs.lambda0[i] = static_cast<scalar_t>(1.) - coeffs.lambda1[i];
+    }
+  });
+}
+
+// Copy one C-contiguous channel vector of a NHWC (NDHWC) tensor. Channels
+// are loaded and stored with Vec256, with a masked load/store for the tail.
+template <typename scalar_t>
+static inline void copy_channels(
+    scalar_t* output_ptr,
+    const scalar_t* input_ptr,
+    int64_t channels) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t d = 0;
+  for (; d < channels - (channels % Vec::size()); d += Vec::size()) {
+    Vec::loadu(input_ptr + d).store(output_ptr + d);
+  }
+  if (channels - d > 0) {
+    Vec::loadu(input_ptr + d, channels - d).store(output_ptr + d, channels - d);
+  }
+}
+
 template <typename scalar_t, typename scale_type>
 void cpu_upsample_nearest(
     Tensor& output_,
@@ -76,12 +204,22 @@ void cpu_upsample_nearest(
   int64_t input_width = input_sizes[ndim - 1];
   int64_t output_width = output_sizes[ndim - 1];
 
+  // See Note [Upsample coefficient cache]
+  std::shared_ptr<const std::vector<int64_t>> d_indices, h_indices, w_indices;
+  w_indices = get_nearest_indices(input_width, output_width, scales[ndim - 3]);
+  if (ndim >= 4) {
+    h_indices = get_nearest_indices(input_height, output_height, scales[ndim - 4]);
+  }
+  if (ndim == 5) {
+    d_indices = get_nearest_indices(input_depth, output_depth, scales[0]);
+  }
+
   auto loop1d = [&](int64_t start, int64_t end) {
     int64_t c = 0;
     int64_t ow = 0;
     data_index_init(start, c, channels, ow, output_width);
     for (int64_t i = start; i < end; i++) {
-      int64_t iw = nearest_idx(ow, input_width, output_width, scales[0]);
+      int64_t iw = (*w_indices)[ow];
       output_data[i] = input_data[c * input_width + iw];
       data_index_step(c, channels, ow, output_width);
     }
@@ -94,8 +232,8 @@ void cpu_upsample_nearest(
     data_index_init(start, c, channels, oh, output_height, ow, output_width);
 
     for (int64_t i = start; i < end; i++) {
-      int64_t ih = nearest_idx(oh, input_height, output_height, scales[0]);
-      int64_t iw = nearest_idx(ow, input_width, output_width, scales[1]);
+      int64_t ih = (*h_indices)[oh];
+      int64_t iw = (*w_indices)[ow];
       output_data[i] = input_data[c * input_height * input_width + ih * input_width + iw];
       data_index_step(c, channels, oh, output_height, ow, output_width);
     }
@@ -109,9 +247,9 @@ void cpu_upsample_nearest(
     data_index_init(start, c, channels, od, output_depth, oh, output_height, ow, output_width);
 
     for (int64_t i = start; i < end; i++) {
-      int64_t id = nearest_idx(od, input_depth, output_depth, scales[0]);
-      int64_t ih = nearest_idx(oh, input_height, output_height, scales[1]);
-      int64_t iw = nearest_idx(ow, input_width, output_width, scales[2]);
+      int64_t id = (*d_indices)[od];
+      int64_t ih = (*h_indices)[oh];
+      int64_t iw = (*w_indices)[ow];
       int64_t j = c * input_depth * input_height * input_width +
                   id * input_height * input_width + ih * input_width + iw;
       output_data[i] = input_data[j];
@@ -170,23 +308,28 @@ void cpu_upsample_nearest_channels_last(
                       * output_width
                       ;
 
+  // See Note [Upsample coefficient cache]
+  std::shared_ptr<const std::vector<int64_t>> d_indices, h_indices, w_indices;
+  w_indices = get_nearest_indices(input_width, output_width, scales[ndim - 3]);
+  h_indices = get_nearest_indices(input_height, output_height, scales[ndim - 4]);
+  if (ndim == 5) {
+    d_indices = get_nearest_indices(input_depth, output_depth, scales[0]);
+  }
+
   auto loop2d = [&](int64_t start, int64_t end) {
     int64_t n = 0;
     int64_t oh = 0;
     int64_t ow = 0;
     data_index_init(start, n, num_batches, oh, output_height, ow, output_width);
 
-    // We can unroll this loop by some factor. Perhaps by 4 or something.
-    // But if we are doing memcpy then it may not help.
-    // Then we need custom sort of memcpy.
     for (int64_t i = start; i < end; i++) {
-      int64_t ih = nearest_idx(oh, input_height, output_height, scales[0]);
-      int64_t iw = nearest_idx(ow, input_width, output_width, scales[1]);
+      int64_t ih = (*h_indices)[oh];
+      int64_t iw = (*w_indices)[ow];
       auto input_data_ptr = input_data + n * (input_height * input_width * channels)
         + ih * (input_width * channels) + iw * channels;
       auto output_data_ptr = output_data + n * (output_height * output_width * channels)
         + oh * (output_width * channels) + ow * channels;
-      std::memcpy(output_data_ptr, input_data_ptr, sizeof(scalar_t) * channels);
+      copy_channels(output_data_ptr, input_data_ptr, channels);
       data_index_step(n, num_batches, oh, output_height, ow, output_width);
     }
   };
@@ -199,13 +342,10 @@ void cpu_upsample_nearest_channels_last(
     data_index_init(start, n, num_batches, oh, output_height, ow, output_width);
     data_index_init(start, n, num_batches, od, output_depth, oh, output_height, ow, output_width);
 
-    // We need to unroll this loop by some factor. Perhaps by 4 or something.
-    // But we are doing memcpy then it may not help.
-    // Then we need custom sort of memcpy.
     for (int64_t i = start; i < end; i++) {
-      int64_t id = nearest_idx(od, input_depth, output_depth, scales[0]);
-      int64_t ih = nearest_idx(oh, input_height, output_height, scales[1]);
-      int64_t iw = nearest_idx(ow, input_width, output_width, scales[2]);
+      int64_t id = (*d_indices)[od];
+      int64_t ih = (*h_indices)[oh];
+      int64_t iw = (*w_indices)[ow];
       auto input_data_ptr = input_data
         + n * (input_depth * input_height * input_width * channels)
         + id * (input_height * input_width * channels)
@@ -214,7 +354,7 @@ void cpu_upsample_nearest_channels_last(
         + n * (output_depth * output_height * output_width * channels)
         + od * (output_height * output_width * channels)
         + oh * (output_width * channels) + ow * channels;
-      std::memcpy(output_data_ptr, input_data_ptr, sizeof(scalar_t) * channels);
+      copy_channels(output_data_ptr, input_data_ptr, channels);
       data_index_step(n, num_batches, od, output_depth, oh, output_height, ow, output_width);
     }
   };
@@ -233,6 +373,99 @@ void cpu_upsample_nearest_channels_last(
   }
 }
 
+// Bilinear interpolation over a NHWC input. For every output pixel the four
+// neighbouring source pixels are C-contiguous, so the interpolation weights
+// are broadcast once per pixel and the channel dimension is blended with
+// Vec256 loads/stores instead of the strided scalar gathers of the NCHW path.
+template <typename scalar_t>
+void cpu_upsample_bilinear_channels_last(
+    Tensor& output_,
+    const Tensor& input_,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  TORCH_CHECK(input_.dtype() == output_.dtype(), "expected dtype ", input_.dtype(),
+              " for `output` but got dtype ", output_.dtype());
+  TORCH_INTERNAL_ASSERT(input_.dim() == 4);
+
+  auto input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+  auto output = output_.contiguous(at::MemoryFormat::ChannelsLast);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+
+  int64_t num_batches = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+  int64_t num_work_items = num_batches * output_height * output_width;
+
+  using Vec = vec256::Vec256<scalar_t>;
+  // See Note [Upsample coefficient cache]
+  auto h_coeffs = get_linear_coeffs<scalar_t>(
+      input_height, output_height, align_corners, scales_h);
+  auto w_coeffs = get_linear_coeffs<scalar_t>(
+      input_width, output_width, align_corners, scales_w);
+
+  auto loop2d = [&](int64_t start, int64_t end) {
+    int64_t n = 0;
+    int64_t oh = 0;
+    int64_t ow = 0;
+    data_index_init(start, n, num_batches, oh, output_height, ow, output_width);
+
+    for (int64_t i = start; i < end; i++) {
+      const int64_t ih0 = h_coeffs->idx0[oh];
+      const int64_t ih1 = h_coeffs->idx1[oh];
+      const scalar_t h0lambda = h_coeffs->lambda0[oh];
+      const scalar_t h1lambda = h_coeffs->lambda1[oh];
+
+      const int64_t iw0 = w_coeffs->idx0[ow];
+      const int64_t iw1 = w_coeffs->idx1[ow];
+      const scalar_t w0lambda = w_coeffs->lambda0[ow];
+      const scalar_t w1lambda = w_coeffs->lambda1[ow];
+
+      const scalar_t* input_base = input_data + n * (input_height * input_width * channels);
+      const scalar_t* i00 = input_base + ih0 * (input_width * channels) + iw0 * channels;
+      const scalar_t* i01 = input_base + ih0 * (input_width * channels) + iw1 * channels;
+      const scalar_t* i10 = input_base + ih1 * (input_width * channels) + iw0 * channels;
+      const scalar_t* i11 = input_base + ih1 * (input_width * channels) + iw1 * channels;
+      scalar_t* o = output_data + n * (output_height * output_width * channels)
+          + oh * (output_width * channels) + ow * channels;
+
+      const Vec w00(h0lambda * w0lambda);
+      const Vec w01(h0lambda * w1lambda);
+      const Vec w10(h1lambda * w0lambda);
+      const Vec w11(h1lambda * w1lambda);
+
+      int64_t d = 0;
+      for (; d < channels - (channels % Vec::size()); d += Vec::size()) {
+        Vec result = Vec::loadu(i00 + d) * w00 + Vec::loadu(i01 + d) * w01 +
+            Vec::loadu(i10 + d) * w10 + Vec::loadu(i11 + d) * w11;
+        result.store(o + d);
+      }
+      if (channels - d > 0) {
+        int64_t count = channels - d;
+        Vec result = Vec::loadu(i00 + d, count) * w00 +
+            Vec::loadu(i01 + d, count) * w01 +
+            Vec::loadu(i10 + d, count) * w10 +
+            Vec::loadu(i11 + d, count) * w11;
+        result.store(o + d, count);
+      }
+      data_index_step(n, num_batches, oh, output_height, ow, output_width);
+    }
+  };
+
+  at::parallel_for(0, num_work_items,
+      std::max((int64_t)1, at::internal::GRAIN_SIZE / std::max(channels, (int64_t)1)),
+      loop2d);
+
+  if (!output_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    output_.copy_(output);
+  }
+}
+
 template <typename scalar_t, typename scale_type>
 void cpu_upsample_nearest_backward(
     Tensor& grad_input_,
@@ -262,10 +495,20 @@ void cpu_upsample_nearest_backward(
   int64_t output_slice_size = output_depth * output_height * output_width;
   int64_t input_slice_size = input_depth * input_height * input_width;
 
+  // See Note [Upsample coefficient cache]
+  std::shared_ptr<const std::vector<int64_t>> d_indices, h_indices, w_indices;
+  w_indices = get_nearest_indices(input_width, output_width, scales[ndim - 3]);
+  if (ndim >= 4) {
+    h_indices = get_nearest_indices(input_height, output_height, scales[ndim - 4]);
+  }
+  if (ndim == 5) {
+    d_indices = get_nearest_indices(input_depth, output_depth, scales[0]);
+  }
+
   auto loop1d = [&](int64_t begin, int64_t end) {
     for (int64_t c = begin; c < end; c++){
       for (int64_t ow = 0; ow < output_width; ow++) {
-        int64_t iw = nearest_idx(ow, input_width, output_width, scales[0]);
+        int64_t iw = (*w_indices)[ow];
         int64_t output_offset = c * output_slice_size + ow;
         int64_t input_offset = c * input_slice_size + iw;
         grad_input_data[input_offset] += grad_output_data[output_offset];
@@ -276,9 +519,9 @@ void cpu_upsample_nearest_backward(
   auto loop2d = [&](int64_t begin, int64_t end) {
     for (int64_t c = begin; c < end; c++) {
       for (int64_t oh = 0; oh < output_height; oh++) {
-        int64_t ih = nearest_idx(oh, input_height, output_height, scales[0]);
+        int64_t ih = (*h_indices)[oh];
         for (int64_t ow = 0; ow < output_width; ow++) {
-          int64_t iw = nearest_idx(ow, input_width, output_width, scales[1]);
+          int64_t iw = (*w_indices)[ow];
           int64_t output_offset = c * output_slice_size + oh * output_width + ow;
           int64_t input_offset = c * input_slice_size + ih * input_width + iw;
           grad_input_data[input_offset] += grad_output_data[output_offset];
@@ -290,11 +533,11 @@ void cpu_upsample_nearest_backward(
   auto loop3d = [&](int64_t begin, int64_t end) {
     for (int64_t c = begin; c < end; c++) {
       for (int64_t od = 0; od < output_depth; od++) {
-        int64_t id = nearest_idx(od, input_depth, output_depth, scales[0]);
+        int64_t id = (*d_indices)[od];
         for (int64_t oh = 0; oh < output_height; oh++) {
-          int64_t ih = nearest_idx(oh, input_height, output_height, scales[1]);
+          int64_t ih = (*h_indices)[oh];
           for (int64_t ow = 0; ow < output_width; ow++) {
-            int64_t iw = nearest_idx(ow, input_width, output_width, scales[2]);
+            int64_t iw = (*w_indices)[ow];
             int64_t output_offset = c * output_slice_size +
                 od *  output_height * output_width + oh * output_width + ow;
             int64_t input_offset = c * input_slice_size +
@@ -367,6 +610,17 @@ void upsample_nearest3d_kernel_impl(
   }
 }
 
+void upsample_bilinear2d_channels_last_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bilinear2d_channels_last", [&] {
+    cpu_upsample_bilinear_channels_last<scalar_t>(output, input, align_corners, scales_h, scales_w);
+  });
+}
+
 void upsample_nearest1d_backward_kernel_impl(
     Tensor& grad_input,
     const Tensor& grad_output,
@@ -403,6 +657,7 @@ void upsample_nearest3d_backward_kernel_impl(
 REGISTER_DISPATCH(upsample_nearest1d_kernel, &upsample_nearest1d_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest2d_kernel, &upsample_nearest2d_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest3d_kernel, &upsample_nearest3d_kernel_impl);
+REGISTER_DISPATCH(upsample_bilinear2d_channels_last_kernel, &upsample_bilinear2d_channels_last_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest1d_backward_kernel, &upsample_nearest1d_backward_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest2d_backward_kernel, &upsample_nearest2d_backward_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest3d_backward_kernel, &upsample_nearest3d_backward_kernel_impl);
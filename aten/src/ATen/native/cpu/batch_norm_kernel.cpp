@@ -1,6 +1,7 @@
 #include <ATen/native/batch_norm.h>
 
 #include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
@@ -107,8 +108,90 @@ void batch_norm_cpu_inference_contiguous_kernel(Tensor& output, const Tensor& in
   });
 }
 
+/// Single-pass Welford mean/M2 collection over a contiguous (N, C, *) input.
+/// Each SIMD lane runs an independent Welford recurrence over a strided
+/// subsequence of the channel; the lanes (and the scalar tail accumulator)
+/// are merged at the end with the standard parallel-variance combination.
+template<typename scalar_t>
+void batch_norm_cpu_collect_stats_contiguous_impl(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+
+  using Vec = Vec256<scalar_t>;
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  int64_t n_batch = input.size(0);
+  int64_t n_channel = input.size(1);
+  int64_t image_size = input.numel() / n_batch / n_channel;
+
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  auto mean_a = mean.accessor<scalar_t, 1>();
+  auto var_sum_a = var_sum.accessor<scalar_t, 1>();
+
+  parallel_for(0, n_channel, 1, [&](int64_t b_begin, int64_t b_end) {
+    for (int64_t c = b_begin; c < b_end; c++) {
+      Vec lane_mean = Vec(scalar_t(0));
+      Vec lane_m2 = Vec(scalar_t(0));
+      // number of elements accumulated per lane; identical for all lanes
+      int64_t lane_n = 0;
+      accscalar_t tail_mean = 0;
+      accscalar_t tail_m2 = 0;
+      int64_t tail_n = 0;
+
+      const int64_t loop_size = image_size - (image_size % Vec::size());
+      for (int64_t n = 0; n < n_batch; n++) {
+        const scalar_t* ptr = input_data + (n * n_channel + c) * image_size;
+        int64_t d = 0;
+        for (; d < loop_size; d += Vec::size()) {
+          lane_n++;
+          Vec data = Vec::loadu(ptr + d);
+          Vec delta = data - lane_mean;
+          lane_mean = lane_mean + delta / Vec(scalar_t(lane_n));
+          lane_m2 = lane_m2 + delta * (data - lane_mean);
+        }
+        for (; d < image_size; d++) {
+          tail_n++;
+          accscalar_t data = ptr[d];
+          accscalar_t delta = data - tail_mean;
+          tail_mean += delta / tail_n;
+          tail_m2 += delta * (data - tail_mean);
+        }
+      }
+
+      // merge (mean_a, m2_a, n_a) and (mean_b, m2_b, n_b) partial results
+      accscalar_t total_mean = tail_mean;
+      accscalar_t total_m2 = tail_m2;
+      int64_t total_n = tail_n;
+      __at_align32__ scalar_t lane_mean_arr[Vec::size()];
+      __at_align32__ scalar_t lane_m2_arr[Vec::size()];
+      lane_mean.store(lane_mean_arr);
+      lane_m2.store(lane_m2_arr);
+      for (int i = 0; i < Vec::size(); i++) {
+        if (lane_n == 0) {
+          break;
+        }
+        accscalar_t delta = lane_mean_arr[i] - total_mean;
+        int64_t new_n = total_n + lane_n;
+        total_mean += delta * lane_n / new_n;
+        total_m2 += lane_m2_arr[i] +
+            delta * delta * (accscalar_t)total_n * lane_n / new_n;
+        total_n = new_n;
+      }
+
+      mean_a[c] = total_mean;
+      var_sum_a[c] = total_m2;
+    }
+  });
+}
+
+void batch_norm_cpu_collect_stats_contiguous_kernel(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_collect_stats_contiguous", [&] {
+    batch_norm_cpu_collect_stats_contiguous_impl<scalar_t>(mean, var_sum, input);
+  });
+}
+
 }// anonymous namespace
 
 REGISTER_DISPATCH(batch_norm_cpu_inference_contiguous_stub, &batch_norm_cpu_inference_contiguous_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_collect_stats_contiguous_stub, &batch_norm_cpu_collect_stats_contiguous_kernel);
 
 }} // namespace at::native
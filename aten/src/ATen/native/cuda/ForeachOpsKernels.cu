@@ -0,0 +1,494 @@
+#include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/ForeachUtils.h>
+#include <ATen/native/cuda/MultiTensorApply.cuh>
+
+#include <cmath>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Elementwise ops applied by the functors below. Kept as static apply
+// methods so one functor template covers add/mul/div variants.
+struct Add {
+  template <typename T>
+  __device__ static T apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct Mul {
+  template <typename T>
+  __device__ static T apply(T a, T b) {
+    return a * b;
+  }
+};
+
+struct Div {
+  template <typename T>
+  __device__ static T apply(T a, T b) {
+    return a / b;
+  }
+};
+
+// Common prologue: locate this block's chunk within its tensor. Chunks are
+// contiguous because can_use_fast_route requires dense tensors.
+#define FOREACH_CHUNK_PROLOGUE(depth, ptr_index, ptr_name)       \
+  const int tensor_loc = tl.block_to_tensor[blockIdx.x];         \
+  const int chunk_idx = tl.block_to_chunk[blockIdx.x];           \
+  int n = tl.sizes[tensor_loc] - chunk_idx * chunk_size;         \
+  if (n > chunk_size) {                                          \
+    n = chunk_size;                                              \
+  }                                                              \
+  T* ptr_name = (T*)tl.addresses[ptr_index][tensor_loc] +        \
+      chunk_idx * chunk_size;
+
+// self op= scalar
+template <typename T, typename Op>
+struct BinaryOpScalarFunctor_ {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<1>& tl,
+      T scalar) {
+    FOREACH_CHUNK_PROLOGUE(1, 0, x)
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      x[i] = Op::apply(x[i], scalar);
+    }
+  }
+};
+
+// self += alpha * other
+template <typename T>
+struct AddListAlphaFunctor_ {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<2>& tl,
+      T alpha) {
+    FOREACH_CHUNK_PROLOGUE(2, 0, x)
+    T* y = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      x[i] += alpha * y[i];
+    }
+  }
+};
+
+// out = tensors + alpha * other
+template <typename T>
+struct AddListAlphaFunctor {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<3>& tl,
+      T alpha) {
+    FOREACH_CHUNK_PROLOGUE(3, 0, x)
+    T* y = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    T* out = (T*)tl.addresses[2][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      out[i] = x[i] + alpha * y[i];
+    }
+  }
+};
+
+// out = sqrt(tensors), computed in the accumulate type so half inputs
+// don't lose precision in the intermediate.
+template <typename T>
+struct SqrtFunctor {
+  __device__ void operator()(int chunk_size, TensorListMetadata<2>& tl) {
+    using accscalar_t = acc_type<T, true>;
+    FOREACH_CHUNK_PROLOGUE(2, 0, x)
+    T* out = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      out[i] = static_cast<T>(::sqrt(static_cast<accscalar_t>(x[i])));
+    }
+  }
+};
+
+// self += value * (tensor1 op tensor2), op in {Mul, Div}
+template <typename T, typename Op>
+struct PointwiseOpFunctor_ {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<3>& tl,
+      T value) {
+    FOREACH_CHUNK_PROLOGUE(3, 0, x)
+    T* a = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    T* b = (T*)tl.addresses[2][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      x[i] += value * Op::apply(a[i], b[i]);
+    }
+  }
+};
+
+// Fused optimizer steps (see ForeachOpsKernels.cpp for the reference
+// semantics): the whole update for a chunk runs in registers, so param,
+// grad and optimizer state are each read and written exactly once. All
+// intermediate math happens in the accumulate type.
+
+// Adam: params, grads, exp_avgs, exp_avg_sqs.
+template <typename T>
+struct FusedAdamFunctor_ {
+  using accscalar_t = acc_type<T, true>;
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<4>& tl,
+      accscalar_t step_size,
+      accscalar_t beta1,
+      accscalar_t beta2,
+      accscalar_t weight_decay,
+      accscalar_t eps,
+      accscalar_t bias_correction2_sqrt) {
+    FOREACH_CHUNK_PROLOGUE(4, 0, p)
+    T* g = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    T* m = (T*)tl.addresses[2][tensor_loc] + chunk_idx * chunk_size;
+    T* v = (T*)tl.addresses[3][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      const accscalar_t grad = static_cast<accscalar_t>(g[i]) +
+          weight_decay * static_cast<accscalar_t>(p[i]);
+      const accscalar_t exp_avg =
+          beta1 * static_cast<accscalar_t>(m[i]) + (1 - beta1) * grad;
+      const accscalar_t exp_avg_sq =
+          beta2 * static_cast<accscalar_t>(v[i]) + (1 - beta2) * grad * grad;
+      m[i] = static_cast<T>(exp_avg);
+      v[i] = static_cast<T>(exp_avg_sq);
+      const accscalar_t denom =
+          ::sqrt(exp_avg_sq) / bias_correction2_sqrt + eps;
+      p[i] = static_cast<T>(
+          static_cast<accscalar_t>(p[i]) - step_size * exp_avg / denom);
+    }
+  }
+};
+
+// SGD with momentum: params, grads, momentum_buffers.
+template <typename T>
+struct FusedSgdFunctor_ {
+  using accscalar_t = acc_type<T, true>;
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<3>& tl,
+      accscalar_t lr,
+      accscalar_t momentum,
+      accscalar_t dampening,
+      accscalar_t weight_decay,
+      bool nesterov) {
+    FOREACH_CHUNK_PROLOGUE(3, 0, p)
+    T* g = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    T* buf = (T*)tl.addresses[2][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      const accscalar_t d_p = static_cast<accscalar_t>(g[i]) +
+          weight_decay * static_cast<accscalar_t>(p[i]);
+      const accscalar_t new_buf =
+          momentum * static_cast<accscalar_t>(buf[i]) + (1 - dampening) * d_p;
+      buf[i] = static_cast<T>(new_buf);
+      const accscalar_t update = nesterov ? d_p + momentum * new_buf : new_buf;
+      p[i] = static_cast<T>(static_cast<accscalar_t>(p[i]) - lr * update);
+    }
+  }
+};
+
+// RMSprop (plain, no momentum/centering): params, grads, square_avgs.
+template <typename T>
+struct FusedRmspropFunctor_ {
+  using accscalar_t = acc_type<T, true>;
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<3>& tl,
+      accscalar_t lr,
+      accscalar_t alpha,
+      accscalar_t eps,
+      accscalar_t weight_decay) {
+    FOREACH_CHUNK_PROLOGUE(3, 0, p)
+    T* g = (T*)tl.addresses[1][tensor_loc] + chunk_idx * chunk_size;
+    T* sa = (T*)tl.addresses[2][tensor_loc] + chunk_idx * chunk_size;
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      const accscalar_t grad = static_cast<accscalar_t>(g[i]) +
+          weight_decay * static_cast<accscalar_t>(p[i]);
+      const accscalar_t square_avg =
+          alpha * static_cast<accscalar_t>(sa[i]) + (1 - alpha) * grad * grad;
+      sa[i] = static_cast<T>(square_avg);
+      p[i] = static_cast<T>(
+          static_cast<accscalar_t>(p[i]) -
+          lr * grad / (::sqrt(square_avg) + eps));
+    }
+  }
+};
+
+#undef FOREACH_CHUNK_PROLOGUE
+
+} // namespace
+
+template <typename Op>
+static void foreach_binary_op_scalar_cuda_(TensorList self, Scalar scalar) {
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(self.vec());
+
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, self[0].scalar_type(), "foreach_binary_op_scalar_cuda_", [&]() {
+        multi_tensor_apply<1>(
+            tensor_lists,
+            BinaryOpScalarFunctor_<scalar_t, Op>(),
+            scalar.to<scalar_t>());
+      });
+}
+
+void foreach_tensor_add_scalar_kernel_cuda_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  if (!can_use_fast_route(self)) {
+    return foreach_tensor_add_scalar_kernel_slow_(self, scalar);
+  }
+  foreach_binary_op_scalar_cuda_<Add>(self, scalar);
+}
+
+void foreach_tensor_mul_scalar_kernel_cuda_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  if (!can_use_fast_route(self)) {
+    return foreach_tensor_mul_scalar_kernel_slow_(self, scalar);
+  }
+  foreach_binary_op_scalar_cuda_<Mul>(self, scalar);
+}
+
+void foreach_tensor_div_scalar_kernel_cuda_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  if (!can_use_fast_route(self)) {
+    return foreach_tensor_div_scalar_kernel_slow_(self, scalar);
+  }
+  foreach_binary_op_scalar_cuda_<Div>(self, scalar);
+}
+
+void foreach_tensor_add_list_kernel_cuda_(
+    TensorList self,
+    TensorList other,
+    Scalar alpha) {
+  check_foreach_api_restrictions(self, other);
+  if (!can_use_fast_route(self, other)) {
+    return foreach_tensor_add_list_kernel_slow_(self, other, alpha);
+  }
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(self.vec());
+  tensor_lists.emplace_back(other.vec());
+
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, self[0].scalar_type(), "foreach_tensor_add_list_cuda_", [&]() {
+        multi_tensor_apply<2>(
+            tensor_lists,
+            AddListAlphaFunctor_<scalar_t>(),
+            alpha.to<scalar_t>());
+      });
+}
+
+std::vector<Tensor> foreach_tensor_add_list_kernel_cuda(
+    TensorList tensors,
+    TensorList other,
+    Scalar alpha) {
+  check_foreach_api_restrictions(tensors, other);
+  if (!can_use_fast_route(tensors, other)) {
+    return foreach_tensor_add_list_kernel_slow(tensors, other, alpha);
+  }
+
+  std::vector<Tensor> result;
+  result.reserve(tensors.size());
+  for (const auto& t : tensors) {
+    result.emplace_back(at::empty_like(t));
+  }
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(tensors.vec());
+  tensor_lists.emplace_back(other.vec());
+  tensor_lists.emplace_back(result);
+
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, tensors[0].scalar_type(), "foreach_tensor_add_list_cuda", [&]() {
+        multi_tensor_apply<3>(
+            tensor_lists,
+            AddListAlphaFunctor<scalar_t>(),
+            alpha.to<scalar_t>());
+      });
+  return result;
+}
+
+std::vector<Tensor> foreach_tensor_sqrt_kernel_cuda(TensorList tensors) {
+  check_foreach_api_restrictions(tensors);
+  if (!can_use_fast_route(tensors)) {
+    return foreach_tensor_sqrt_kernel_slow(tensors);
+  }
+
+  std::vector<Tensor> result;
+  result.reserve(tensors.size());
+  for (const auto& t : tensors) {
+    result.emplace_back(at::empty_like(t));
+  }
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(tensors.vec());
+  tensor_lists.emplace_back(result);
+
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::Half, tensors[0].scalar_type(), "foreach_tensor_sqrt_cuda", [&]() {
+        multi_tensor_apply<2>(tensor_lists, SqrtFunctor<scalar_t>());
+      });
+  return result;
+}
+
+template <typename Op>
+static void foreach_pointwise_op_cuda_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value,
+    const char* name) {
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(self.vec());
+  tensor_lists.emplace_back(tensor1.vec());
+  tensor_lists.emplace_back(tensor2.vec());
+
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::Half, self[0].scalar_type(), name, [&]() {
+        multi_tensor_apply<3>(
+            tensor_lists,
+            PointwiseOpFunctor_<scalar_t, Op>(),
+            value.to<scalar_t>());
+      });
+}
+
+void foreach_tensor_addcmul_kernel_cuda_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  if (!can_use_fast_route(self, tensor1, tensor2)) {
+    return foreach_tensor_addcmul_kernel_slow_(self, tensor1, tensor2, value);
+  }
+  foreach_pointwise_op_cuda_<Mul>(
+      self, tensor1, tensor2, value, "foreach_tensor_addcmul_cuda_");
+}
+
+void foreach_tensor_addcdiv_kernel_cuda_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  if (!can_use_fast_route(self, tensor1, tensor2)) {
+    return foreach_tensor_addcdiv_kernel_slow_(self, tensor1, tensor2, value);
+  }
+  foreach_pointwise_op_cuda_<Div>(
+      self, tensor1, tensor2, value, "foreach_tensor_addcdiv_cuda_");
+}
+
+void fused_adam_kernel_cuda_(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps,
+    int64_t step) {
+  check_foreach_api_restrictions(params, grads);
+  check_foreach_api_restrictions(params, exp_avgs, exp_avg_sqs);
+  if (!can_use_fast_route(params, grads, exp_avgs) ||
+      !can_use_fast_route(params, exp_avg_sqs)) {
+    return fused_adam_kernel_slow_(
+        params, grads, exp_avgs, exp_avg_sqs,
+        lr, beta1, beta2, weight_decay, eps, step);
+  }
+
+  const double bias_correction1 = 1 - std::pow(beta1, step);
+  const double bias_correction2 = 1 - std::pow(beta2, step);
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(params.vec());
+  tensor_lists.emplace_back(grads.vec());
+  tensor_lists.emplace_back(exp_avgs.vec());
+  tensor_lists.emplace_back(exp_avg_sqs.vec());
+
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::Half, params[0].scalar_type(), "fused_adam_cuda_", [&]() {
+        using accscalar_t = acc_type<scalar_t, true>;
+        multi_tensor_apply<4>(
+            tensor_lists,
+            FusedAdamFunctor_<scalar_t>(),
+            static_cast<accscalar_t>(lr / bias_correction1),
+            static_cast<accscalar_t>(beta1),
+            static_cast<accscalar_t>(beta2),
+            static_cast<accscalar_t>(weight_decay),
+            static_cast<accscalar_t>(eps),
+            static_cast<accscalar_t>(std::sqrt(bias_correction2)));
+      });
+}
+
+void fused_sgd_kernel_cuda_(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  check_foreach_api_restrictions(params, grads, momentum_buffers);
+  if (!can_use_fast_route(params, grads, momentum_buffers)) {
+    return fused_sgd_kernel_slow_(
+        params, grads, momentum_buffers,
+        lr, momentum, dampening, weight_decay, nesterov);
+  }
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(params.vec());
+  tensor_lists.emplace_back(grads.vec());
+  tensor_lists.emplace_back(momentum_buffers.vec());
+
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::Half, params[0].scalar_type(), "fused_sgd_cuda_", [&]() {
+        using accscalar_t = acc_type<scalar_t, true>;
+        multi_tensor_apply<3>(
+            tensor_lists,
+            FusedSgdFunctor_<scalar_t>(),
+            static_cast<accscalar_t>(lr),
+            static_cast<accscalar_t>(momentum),
+            static_cast<accscalar_t>(dampening),
+            static_cast<accscalar_t>(weight_decay),
+            nesterov);
+      });
+}
+
+void fused_rmsprop_kernel_cuda_(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    double lr,
+    double alpha,
+    double eps,
+    double weight_decay) {
+  check_foreach_api_restrictions(params, grads, square_avgs);
+  if (!can_use_fast_route(params, grads, square_avgs)) {
+    return fused_rmsprop_kernel_slow_(
+        params, grads, square_avgs, lr, alpha, eps, weight_decay);
+  }
+
+  std::vector<std::vector<Tensor>> tensor_lists;
+  tensor_lists.emplace_back(params.vec());
+  tensor_lists.emplace_back(grads.vec());
+  tensor_lists.emplace_back(square_avgs.vec());
+
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::Half, params[0].scalar_type(), "fused_rmsprop_cuda_", [&]() {
+        using accscalar_t = acc_type<scalar_t, true>;
+        multi_tensor_apply<3>(
+            tensor_lists,
+            FusedRmspropFunctor_<scalar_t>(),
+            static_cast<accscalar_t>(lr),
+            static_cast<accscalar_t>(alpha),
+            static_cast<accscalar_t>(eps),
+            static_cast<accscalar_t>(weight_decay));
+      });
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAGuard.h>
+
+namespace at {
+namespace native {
+namespace {
+
+// multi_tensor_apply fuses an elementwise operation over many (lists of)
+// tensors into a handful of kernel launches: tensors are cut into fixed-size
+// chunks, each chunk is assigned to one block, and the tensor addresses and
+// block->chunk mapping travel to the device in the kernel argument space.
+// With hundreds of small tensors (e.g. optimizer state updates) this
+// replaces one launch per tensor per op with one launch per ~320 chunks.
+
+static constexpr int64_t kChunkSize = 65536;
+static constexpr int64_t kBlockSize = 512;
+
+// Kernel arguments are limited to 4KB, so the address table size depends on
+// how many tensor lists (`depth`) an op touches at once.
+static constexpr int depth_to_max_tensors[5] = {110, 64, 48, 36, 30};
+static constexpr int depth_to_max_blocks[5] = {320, 320, 320, 320, 320};
+
+template <int n>
+struct TensorListMetadata {
+  void* addresses[n][depth_to_max_tensors[n - 1]];
+  int sizes[depth_to_max_tensors[n - 1]];
+  unsigned char block_to_tensor[depth_to_max_blocks[n - 1]];
+  int block_to_chunk[depth_to_max_blocks[n - 1]];
+};
+
+template <typename T, typename U, typename... ArgTypes>
+C10_LAUNCH_BOUNDS_1(kBlockSize)
+__global__ void multi_tensor_apply_kernel(
+    T tensorListMeta,
+    U callable,
+    ArgTypes... args) {
+  callable(kChunkSize, tensorListMeta, args...);
+}
+
+// `tensor_lists` holds `depth` lists of equal length; corresponding tensors
+// across the lists must have the same numel. The callable is invoked on the
+// device with the chunk size, the metadata struct and `args`.
+template <int depth, typename T, typename... ArgTypes>
+void multi_tensor_apply(
+    std::vector<std::vector<at::Tensor>>& tensor_lists,
+    T callable,
+    ArgTypes... args) {
+  TORCH_CHECK(
+      tensor_lists.size() == depth,
+      "Number of tensor lists has to match the depth.");
+  const cuda::OptionalCUDAGuard device_guard(device_of(tensor_lists[0][0]));
+
+  const size_t n_tensors = tensor_lists[0].size();
+  TensorListMetadata<depth> tensorListMeta;
+
+  int loc_block_info = 0;
+  int loc_tensor_info = 0;
+  for (size_t t = 0; t < n_tensors; t++) {
+    tensorListMeta.sizes[loc_tensor_info] = tensor_lists[0][t].numel();
+    for (int d = 0; d < depth; d++) {
+      tensorListMeta.addresses[d][loc_tensor_info] =
+          tensor_lists[d][t].data_ptr();
+    }
+    loc_tensor_info++;
+
+    const int chunks =
+        (tensor_lists[0][t].numel() + kChunkSize - 1) / kChunkSize;
+    for (int chunk = 0; chunk < chunks; chunk++) {
+      tensorListMeta.block_to_tensor[loc_block_info] = loc_tensor_info - 1;
+      tensorListMeta.block_to_chunk[loc_block_info] = chunk;
+      loc_block_info++;
+
+      const bool tensors_full =
+          (loc_tensor_info == depth_to_max_tensors[depth - 1] &&
+           chunk == chunks - 1);
+      const bool blocks_full =
+          (loc_block_info == depth_to_max_blocks[depth - 1]);
+      const bool last_chunk = (t == n_tensors - 1 && chunk == chunks - 1);
+      if (tensors_full || blocks_full || last_chunk) {
+        multi_tensor_apply_kernel<<<
+            loc_block_info,
+            kBlockSize,
+            0,
+            at::cuda::getCurrentCUDAStream()>>>(
+            tensorListMeta, callable, args...);
+        AT_CUDA_CHECK(cudaGetLastError());
+
+        loc_block_info = 0;
+        if (chunk == chunks - 1) {
+          loc_tensor_info = 0;
+        } else {
+          // The current tensor spills into the next launch; carry its entry
+          // over as slot 0.
+          tensorListMeta.sizes[0] = tensorListMeta.sizes[loc_tensor_info - 1];
+          for (int d = 0; d < depth; d++) {
+            tensorListMeta.addresses[d][0] =
+                tensorListMeta.addresses[d][loc_tensor_info - 1];
+          }
+          loc_tensor_info = 1;
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -506,6 +506,11 @@ Tensor host_softmax(const Tensor & input_, const int64_t dim_, const bool half_t
       inner_size *= input.size(i);
     // This kernel spawns a block per each element in the batch.
     // XXX: it assumes that inner_size == 1
+    // Rows short enough to be held in registers (dim_size <= 1024, e.g.
+    // attention scores over the sequence dimension) take the warp-persistent
+    // kernels from PersistentSoftmax.cuh, which keep the row resident across
+    // the max/sum/normalize phases instead of re-reading it per phase; the
+    // block-reduction kernel below handles longer rows.
     if (inner_size == 1) {
       const int ILP = 2;
       dim3 grid(outer_size);
@@ -76,6 +76,7 @@ std::tuple<at::Tensor,at::Tensor> cudnn_convolution_transpose_backward(
 
 #include <THC/THC.h>
 
+#include <ATen/cuda/CUDAContext.h>
 #include <ATen/cudnn/cudnn-wrapper.h>
 #include <ATen/cudnn/Descriptors.h>
 #include <ATen/cudnn/Types.h>
@@ -84,6 +85,9 @@ std::tuple<at::Tensor,at::Tensor> cudnn_convolution_transpose_backward(
 
 #include <ATen/TensorUtils.h>
 
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <functional>
 #include <iterator>
 #include <sstream>
@@ -272,14 +276,119 @@ struct ConvolutionArgs {
 //
 // ---------------------------------------------------------------------
 
+// Note [Persistent cudnn benchmark cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With torch.backends.cudnn.benchmark, every process pays an exhaustive
+// cudnnFind sweep for each new convolution configuration it sees.  When many
+// identical replicas start at once, that is minutes of duplicated GPU time at
+// every deploy.  Setting PYTORCH_CUDNN_BENCHMARK_CACHE_DIR to a writable
+// directory makes the caches below persistent: each cache loads a file from
+// that directory on first lookup and appends every newly selected algorithm,
+// so across runs only genuinely new shapes pay the search.
+//
+// Selected algorithms are only valid for the GPU model and cudnn version that
+// produced them, so both are baked into the file name and re-checked in the
+// file header; a stale or foreign file is simply ignored.  Records are
+// fixed-size (ConvolutionParams, perf result) pairs appended with stdio in
+// append mode, so concurrent replicas sharing a directory at worst duplicate
+// a record; a torn trailing record is dropped on load.  Like the in-memory
+// cache, the file is not keyed per-device: we assume benchmark-mode jobs run
+// on homogeneous GPUs.
+
+constexpr uint32_t kBenchmarkCacheMagic = 0x50544346; // "PTCF"
+
+const char* benchmark_cache_dir() {
+  static const char* dir = std::getenv("PYTORCH_CUDNN_BENCHMARK_CACHE_DIR");
+  return dir;
+}
+
+struct BenchmarkCacheHeader {
+  uint32_t magic;
+  uint32_t params_size;
+  uint32_t perf_size;
+  uint32_t cudnn_version;
+};
+
 // TODO: Use something less heavy duty than a big honking mutex
 template <typename T>
 struct BenchmarkCache {
   std::mutex mutex;
   std::unordered_map<ConvolutionParams, T, ParamsHash<ConvolutionParams>, ParamsEqual<ConvolutionParams>> map;
+  // Tag distinguishing the persistent files of the three caches.
+  const char* kind;
+  std::once_flag load_flag;
+
+  BenchmarkCache(const char* kind) : kind(kind) {}
+
+  std::string persistentCacheFile() const {
+    // The device name can contain spaces and slashes (e.g. "Tesla V100-SXM2-16GB"
+    // is fine, but "GeForce GTX 1080 Ti" is not a good file name as is).
+    std::string model = at::cuda::getCurrentDeviceProperties()->name;
+    for (auto& c : model) {
+      if (!std::isalnum(static_cast<unsigned char>(c))) {
+        c = '_';
+      }
+    }
+    std::ostringstream oss;
+    oss << benchmark_cache_dir() << "/cudnn_conv_" << kind << '_' << model
+        << "_v" << cudnnGetVersion() << ".bin";
+    return oss.str();
+  }
+
+  // Must be called with `mutex` held.
+  void loadPersistent() {
+    FILE* f = std::fopen(persistentCacheFile().c_str(), "rb");
+    if (f == nullptr) {
+      return;
+    }
+    BenchmarkCacheHeader header;
+    if (std::fread(&header, sizeof(header), 1, f) == 1 &&
+        header.magic == kBenchmarkCacheMagic &&
+        header.params_size == sizeof(ConvolutionParams) &&
+        header.perf_size == sizeof(T) &&
+        header.cudnn_version == cudnnGetVersion()) {
+      ConvolutionParams params;
+      T results;
+      while (std::fread(&params, sizeof(params), 1, f) == 1 &&
+             std::fread(&results, sizeof(results), 1, f) == 1) {
+        map.emplace(params, results);
+      }
+    }
+    std::fclose(f);
+  }
+
+  // Must be called with `mutex` held.
+  void appendPersistent(const ConvolutionParams& params, const T& results) {
+    auto file = persistentCacheFile();
+    // Write the header only when creating the file; "a" appends atomically
+    // enough for our fixed-size records (see the note above).
+    FILE* probe = std::fopen(file.c_str(), "rb");
+    const bool fresh = (probe == nullptr);
+    if (probe != nullptr) {
+      std::fclose(probe);
+    }
+    FILE* f = std::fopen(file.c_str(), "ab");
+    if (f == nullptr) {
+      return; // directory missing or not writable; stay in-memory only
+    }
+    if (fresh) {
+      BenchmarkCacheHeader header;
+      header.magic = kBenchmarkCacheMagic;
+      header.params_size = sizeof(ConvolutionParams);
+      header.perf_size = sizeof(T);
+      header.cudnn_version = cudnnGetVersion();
+      std::fwrite(&header, sizeof(header), 1, f);
+    }
+    std::fwrite(&params, sizeof(params), 1, f);
+    std::fwrite(&results, sizeof(results), 1, f);
+    std::fclose(f);
+  }
 
   bool find(const ConvolutionParams& params, T* results) {
     std::lock_guard<std::mutex> guard(mutex);
+    if (benchmark_cache_dir() != nullptr) {
+      std::call_once(load_flag, [&] { loadPersistent(); });
+    }
     auto it = map.find(params);
     if (it == map.end()) {
       return false;
@@ -290,13 +399,17 @@ struct BenchmarkCache {
 
   void insert(const ConvolutionParams& params, const T& results) {
     std::lock_guard<std::mutex> guard(mutex);
+    const bool is_new = (map.find(params) == map.end());
     map[params] = results;
+    if (is_new && benchmark_cache_dir() != nullptr) {
+      appendPersistent(params, results);
+    }
   }
 };
 
-BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
-BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
-BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
+BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos("fwd");
+BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos("bwd_data");
+BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos("bwd_filter");
 
 // TODO: Stop manually allocating CUDA memory; allocate an ATen byte
 // tensor instead.
@@ -0,0 +1,211 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Config.h>
+
+#if !AT_MKL_ENABLED()
+
+namespace at { namespace native {
+
+Tensor _sparse_csr_addmm_mkl(
+    const Tensor& self,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size,
+    const Tensor& dense,
+    Scalar beta,
+    Scalar alpha) {
+  AT_ERROR("_sparse_csr_addmm: ATen not compiled with MKL support");
+}
+
+}}
+
+#else // AT_MKL_ENABLED
+
+#include <ATen/Dispatch.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <mkl.h>
+#include <mkl_spblas.h>
+
+namespace at { namespace native {
+
+namespace {
+
+// MKL_INT is 32-bit unless MKL was built with the ILP64 interface, so the
+// int64 index tensors have to be converted (with a range check) before they
+// can be handed to the sparse BLAS.
+#ifdef MKL_ILP64
+constexpr ScalarType kMklIndexDtype = kLong;
+#else
+constexpr ScalarType kMklIndexDtype = kInt;
+#endif
+
+inline void mklCheck(sparse_status_t status, const char* name) {
+  TORCH_CHECK(
+      status == SPARSE_STATUS_SUCCESS,
+      name,
+      " failed with MKL sparse status ",
+      static_cast<int>(status));
+}
+
+inline sparse_status_t mkl_create_csr(
+    sparse_matrix_t* A,
+    MKL_INT rows,
+    MKL_INT cols,
+    MKL_INT* rows_start,
+    MKL_INT* rows_end,
+    MKL_INT* col_indx,
+    float* values) {
+  return mkl_sparse_s_create_csr(
+      A, SPARSE_INDEX_BASE_ZERO, rows, cols, rows_start, rows_end, col_indx,
+      values);
+}
+
+inline sparse_status_t mkl_create_csr(
+    sparse_matrix_t* A,
+    MKL_INT rows,
+    MKL_INT cols,
+    MKL_INT* rows_start,
+    MKL_INT* rows_end,
+    MKL_INT* col_indx,
+    double* values) {
+  return mkl_sparse_d_create_csr(
+      A, SPARSE_INDEX_BASE_ZERO, rows, cols, rows_start, rows_end, col_indx,
+      values);
+}
+
+inline sparse_status_t mkl_csr_mm(
+    float alpha,
+    const sparse_matrix_t A,
+    const matrix_descr descr,
+    const float* B,
+    MKL_INT columns,
+    MKL_INT ldb,
+    float beta,
+    float* C,
+    MKL_INT ldc) {
+  return mkl_sparse_s_mm(
+      SPARSE_OPERATION_NON_TRANSPOSE, alpha, A, descr,
+      SPARSE_LAYOUT_ROW_MAJOR, B, columns, ldb, beta, C, ldc);
+}
+
+inline sparse_status_t mkl_csr_mm(
+    double alpha,
+    const sparse_matrix_t A,
+    const matrix_descr descr,
+    const double* B,
+    MKL_INT columns,
+    MKL_INT ldb,
+    double beta,
+    double* C,
+    MKL_INT ldc) {
+  return mkl_sparse_d_mm(
+      SPARSE_OPERATION_NON_TRANSPOSE, alpha, A, descr,
+      SPARSE_LAYOUT_ROW_MAJOR, B, columns, ldb, beta, C, ldc);
+}
+
+} // namespace
+
+// result = beta * self + alpha * (sparse @ dense), where the sparse operand
+// is a CSR matrix of shape `size` given by its crow_indices/col_indices/
+// values components. The heavy lifting is done by mkl_sparse_?_mm, which
+// multiplies the sparse matrix against all columns of `dense` in one pass;
+// for the fixed-structure, highly sparse weight matrices this is intended
+// for, that beats the dense GEMM as well as the COO scatter loop in
+// SparseTensorMath.cpp.
+Tensor _sparse_csr_addmm_mkl(
+    const Tensor& self,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size,
+    const Tensor& dense,
+    Scalar beta,
+    Scalar alpha) {
+  TORCH_CHECK(size.size() == 2, "_sparse_csr_addmm: size must have 2 elements");
+  const int64_t m = size[0];
+  const int64_t k = size[1];
+  TORCH_CHECK(
+      dense.dim() == 2 && dense.size(0) == k,
+      "_sparse_csr_addmm: sparse matrix of size ",
+      m,
+      "x",
+      k,
+      " cannot be multiplied with dense matrix of size ",
+      dense.sizes());
+  const int64_t n = dense.size(1);
+  TORCH_CHECK(
+      values.dim() == 1 && col_indices.dim() == 1 &&
+          col_indices.numel() == values.numel(),
+      "_sparse_csr_addmm: col_indices and values must be 1-dimensional and "
+      "have the same number of elements");
+  TORCH_CHECK(
+      crow_indices.dim() == 1 && crow_indices.numel() == m + 1,
+      "_sparse_csr_addmm: crow_indices must have ",
+      m + 1,
+      " elements");
+  TORCH_CHECK(
+      values.scalar_type() == dense.scalar_type() &&
+          values.scalar_type() == self.scalar_type(),
+      "_sparse_csr_addmm: all operands must have the same dtype");
+#ifndef MKL_ILP64
+  TORCH_CHECK(
+      std::max({m, k, n, values.numel()}) <=
+          static_cast<int64_t>(std::numeric_limits<MKL_INT>::max()),
+      "_sparse_csr_addmm: operands are too large for the 32-bit MKL "
+      "interface");
+#endif
+
+  const Tensor crow = crow_indices.to(kMklIndexDtype).contiguous();
+  const Tensor col = col_indices.to(kMklIndexDtype).contiguous();
+  const Tensor values_contig = values.contiguous();
+  const Tensor dense_contig = dense.contiguous();
+
+  Tensor result = at::empty({m, n}, dense.options());
+  if (beta.to<double>() == 0.) {
+    result.zero_();
+  } else {
+    result.copy_(self.expand({m, n}));
+  }
+  if (values.numel() == 0) {
+    // MKL rejects null data pointers, and the product contributes nothing.
+    return result;
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(values.scalar_type(), "_sparse_csr_addmm", [&] {
+    MKL_INT* crow_data = static_cast<MKL_INT*>(crow.data_ptr());
+    sparse_matrix_t A = nullptr;
+    mklCheck(
+        mkl_create_csr(
+            &A,
+            static_cast<MKL_INT>(m),
+            static_cast<MKL_INT>(k),
+            crow_data,
+            crow_data + 1,
+            static_cast<MKL_INT*>(col.data_ptr()),
+            values_contig.data_ptr<scalar_t>()),
+        "mkl_sparse_create_csr");
+    matrix_descr descr;
+    descr.type = SPARSE_MATRIX_TYPE_GENERAL;
+    const sparse_status_t status = mkl_csr_mm(
+        alpha.to<scalar_t>(),
+        A,
+        descr,
+        dense_contig.data_ptr<scalar_t>(),
+        static_cast<MKL_INT>(n),
+        static_cast<MKL_INT>(n),
+        beta.to<scalar_t>(),
+        result.data_ptr<scalar_t>(),
+        static_cast<MKL_INT>(n));
+    mkl_sparse_destroy(A);
+    mklCheck(status, "mkl_sparse_mm");
+  });
+  return result;
+}
+
+}} // namespace at::native
+
+#endif // AT_MKL_ENABLED
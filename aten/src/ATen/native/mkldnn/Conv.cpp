@@ -107,7 +107,26 @@ at::Tensor mkldnn_convolution(
     IntArrayRef dilation,
     int64_t groups) {
   const ideep::tensor mkldnn_input = get_mkldnn_tensor(input);
-  const ideep::tensor mkldnn_weight = get_mkldnn_tensor(weight);
+  ideep::tensor mkldnn_weight;
+  if (weight.is_mkldnn()) {
+    mkldnn_weight = itensor_from_mkldnn(weight);
+  } else {
+    // Eager-mode models pass a dense (plain layout) weight on every call,
+    // and the implicit per-call reorder to the blocked layout eats most of
+    // the mkldnn gain for small batches. Reorder it through the prepack
+    // cache instead, the same layout mkldnn_reorder_conv2d_weight produces.
+    const auto w = itensor_view_from_dense(weight);
+    auto desc = ideep::convolution_forward::expected_weights_desc(
+        w.get_dims(),
+        w.get_data_type(),
+        {stride.begin(), stride.end()},
+        {padding.begin(), padding.end()},
+        {padding.begin(), padding.end()},
+        {dilation.begin(), dilation.end()},
+        groups,
+        ideep::algorithm::convolution_direct);
+    mkldnn_weight = itensor_prepacked_from_dense(weight, desc);
+  }
   c10::optional<ideep::tensor> mkldnn_bias{c10::nullopt};
   if (bias.defined()) {
     mkldnn_bias = get_mkldnn_tensor(bias);
@@ -14,6 +14,14 @@ Tensor mkldnn_linear(
   AT_ERROR("mkldnn_linear: ATen not compiled with MKLDNN support");
 }
 
+Tensor _mkldnn_linear_with_activation(
+    const Tensor& self,
+    const Tensor& weight,
+    const Tensor& bias,
+    std::string activation) {
+  AT_ERROR("_mkldnn_linear_with_activation: ATen not compiled with MKLDNN support");
+}
+
 } // namespace native
 } // namespace at
 
@@ -32,17 +40,33 @@ Tensor mkldnn_linear(
       "mkldnn_linear: input needs to has dim at least 2, input dim ", self.dim());
   TORCH_CHECK(self.is_mkldnn(),
       "mkldnn_linear: input needs to be mkldnn layout");
-  TORCH_CHECK(weight.is_mkldnn() && bias.is_mkldnn(),
-      "mkldnn_linear: weight and bias need to be mkldnn layout");
+  TORCH_CHECK(weight.is_mkldnn() || weight.dim() == 2,
+      "mkldnn_linear: weight needs to be mkldnn layout or a 2-d dense tensor");
 
   // reshape first if input dim is greater than 2 and the reshape will cost a memory copy.
   auto self_reshaped = self.dim() > 2 ? self.reshape({-1, self.size(self.dim() - 1)}) : self;
   const ideep::tensor x = itensor_from_mkldnn(self_reshaped);
-  const ideep::tensor w = itensor_from_mkldnn(weight);
+
+  ideep::tensor w;
+  if (weight.is_mkldnn()) {
+    w = itensor_from_mkldnn(weight);
+  } else {
+    // A dense weight is reordered to the blocked inner product layout once
+    // and cached, so eager-mode models do not pay for the reorder on every
+    // call (see itensor_prepacked_from_dense in MKLDNNCommon.cpp).
+    const auto w_view = itensor_view_from_dense(weight);
+    auto desc = ideep::inner_product_forward::expected_weights_desc(
+        w_view.get_dims(), w_view.get_data_type());
+    w = itensor_prepacked_from_dense(weight, desc);
+  }
 
   ideep::tensor y;
   if (bias.defined()) {
-    const ideep::tensor b = itensor_from_mkldnn(bias);
+    // A 1-d dense bias is already in plain layout; no reorder is needed.
+    auto bias_contig = bias.is_mkldnn() ? bias : bias.contiguous();
+    const ideep::tensor b = bias_contig.is_mkldnn()
+        ? itensor_from_mkldnn(bias_contig)
+        : itensor_view_from_dense(bias_contig);
     ideep::inner_product_forward::compute(x, w, b, y);
   } else {
     ideep::inner_product_forward::compute(x, w, y);
@@ -58,6 +82,25 @@ Tensor mkldnn_linear(
   return new_with_itensor_mkldnn(std::move(y), self.options());
 }
 
+Tensor _mkldnn_linear_with_activation(
+    const Tensor& self,
+    const Tensor& weight,
+    const Tensor& bias,
+    std::string activation) {
+  TORCH_CHECK(activation == "relu" || activation == "sigmoid",
+      "_mkldnn_linear_with_activation: unsupported activation for mkldnn "
+      "tensors: ", activation);
+  auto output = mkldnn_linear(self, weight, bias);
+  // The activation runs in place on the blocked inner product output, so the
+  // epilogue costs a single sweep over the output and no layout conversion.
+  ideep::tensor& y = itensor_from_mkldnn(output);
+  auto algo = activation == "relu" ? ideep::algorithm::eltwise_relu
+                                   : ideep::algorithm::eltwise_logistic;
+  ideep::eltwise_forward::compute(
+      y, y, algo, ideep::prop_kind::forward, /*alpha*/ 0.0);
+  return output;
+}
+
 } // namespace native
 } // namespace at
 
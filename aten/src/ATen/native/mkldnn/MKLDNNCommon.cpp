@@ -1,6 +1,10 @@
 #include <ATen/native/mkldnn/MKLDNNCommon.h>
 #include <ATen/OpaqueTensorImpl.h>
 #include <c10/core/Allocator.h>
+#include <c10/util/intrusive_ptr.h>
+
+#include <mutex>
+#include <unordered_map>
 
 #if AT_MKLDNN_ENABLED()
 
@@ -73,6 +77,73 @@ ideep::tensor itensor_view_from_dense(const Tensor& tensor) {
            ideep::tensor::data_type::f32},
           tensor.template data_ptr<float>()};
 }
+
+namespace {
+
+// A global cache of weights reordered into MKL-DNN's blocked layouts.
+// Entries are keyed on the weight's TensorImpl and hold a weak reference
+// plus the tensor's version at pack time, so a deallocated weight (whose
+// address may get reused by a new tensor) or an in-place update both
+// invalidate the entry instead of serving stale data.
+struct PrepackedWeightEntry {
+  c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl> weight_impl;
+  uint32_t weight_version;
+  ideep::tensor packed;
+};
+
+std::mutex prepacked_weight_cache_mutex;
+std::unordered_map<c10::TensorImpl*, PrepackedWeightEntry> prepacked_weight_cache;
+
+ideep::tensor pack_itensor_from_dense(
+    const Tensor& weight,
+    const ideep::tensor::desc& desc) {
+  ideep::tensor packed;
+  packed.init(desc);
+  packed.feed_from(itensor_view_from_dense(weight));
+  return packed;
+}
+
+} // namespace
+
+ideep::tensor itensor_prepacked_from_dense(
+    const Tensor& weight,
+    const ideep::tensor::desc& desc) {
+  if (!weight.is_contiguous()) {
+    // A fresh contiguous copy would be made per call anyway; caching keyed
+    // on its short-lived TensorImpl would only leak entries.
+    return pack_itensor_from_dense(weight.contiguous(), desc);
+  }
+
+  auto* impl = weight.unsafeGetTensorImpl();
+  const uint32_t version = impl->version_counter().current_version();
+  {
+    std::lock_guard<std::mutex> guard(prepacked_weight_cache_mutex);
+    auto it = prepacked_weight_cache.find(impl);
+    if (it != prepacked_weight_cache.end()) {
+      if (!it->second.weight_impl.expired() &&
+          it->second.weight_version == version &&
+          it->second.packed.get_desc() == desc) {
+        // ideep tensors share their underlying buffer when copied, so the
+        // returned handle stays valid even if the entry is evicted later.
+        return it->second.packed;
+      }
+      prepacked_weight_cache.erase(it);
+    }
+  }
+
+  ideep::tensor packed = pack_itensor_from_dense(weight, desc);
+  {
+    std::lock_guard<std::mutex> guard(prepacked_weight_cache_mutex);
+    prepacked_weight_cache.emplace(
+        impl,
+        PrepackedWeightEntry{
+            c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>(
+                weight.getIntrusivePtr()),
+            version,
+            packed});
+  }
+  return packed;
+}
 }}
 
 #endif // AT_MKLDNN_ENABLED()
@@ -17,6 +17,16 @@ ideep::tensor& itensor_from_mkldnn(const Tensor& mkldnn_tensor);
 // Construct an `ideep::tensor` "view" from dense tensor, note the
 // ideep::tensor will share the underlying buffer
 ideep::tensor itensor_view_from_dense(const Tensor& tensor);
+
+// Reorder a dense weight tensor into the (blocked) layout given by `desc`,
+// reusing a cached reorder when the same unmodified weight is seen again.
+// This gives eager-mode conv/linear the blocked-layout kernels without
+// paying for the reorder on every call; in-place updates to the weight
+// (e.g. optimizer steps) invalidate the cached copy via the tensor's
+// version counter.
+ideep::tensor itensor_prepacked_from_dense(
+    const Tensor& weight,
+    const ideep::tensor::desc& desc);
 }}
 
 #endif // AT_MKLDNN_ENABLED
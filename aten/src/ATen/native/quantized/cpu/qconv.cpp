@@ -9,6 +9,7 @@
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 
 namespace at {
@@ -643,6 +644,69 @@ class QConvInt8 final : public c10::OperatorKernel {
 #endif
 };
 
+/*
+ * Residual-add fusion for quantized conv.
+ *
+ * ResNet-style blocks end with out = relu(conv(x) + skip), and running the
+ * addition as a separate quantized::add_relu pass costs an extra output
+ * allocation plus a full read-modify-write of the activation tensor. The
+ * FBGEMM conv epilogue is fixed to ReQuantizeOutput (the depthwise and
+ * pointwise fast paths pull their requantization parameters out of it), so
+ * the skip connection cannot be folded into the GEMM epilogue itself.
+ * Instead we requantize the conv result directly to the final output
+ * parameters and accumulate the residual into it in place with the qadd
+ * kernels, which saves the extra pass without touching the engine backends.
+ */
+template <int kSpatialDim, bool kReluFused>
+class QConvAddInt8 final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor act,
+      Tensor accum,
+      Tensor packed_weight,
+      torch::List<int64_t> stride,
+      torch::List<int64_t> padding,
+      torch::List<int64_t> dilation,
+      int64_t groups,
+      double output_scale,
+      int64_t output_zero_point) {
+    Tensor output = QConvInt8<kSpatialDim, /*kReluFused=*/false>()(
+        act,
+        packed_weight,
+        stride,
+        padding,
+        dilation,
+        groups,
+        output_scale,
+        output_zero_point);
+    TORCH_CHECK(
+        accum.qscheme() == kPerTensorAffine,
+        "quantized::conv",
+        kSpatialDim,
+        "d_add: only per tensor quantization is supported for the "
+        "accumulator.");
+    TORCH_CHECK(
+        accum.sizes() == output.sizes(),
+        "quantized::conv",
+        kSpatialDim,
+        "d_add: accumulator must have the same shape as the conv output.");
+    TORCH_CHECK(
+        accum.scalar_type() == output.scalar_type(),
+        "quantized::conv",
+        kSpatialDim,
+        "d_add: accumulator must have the same data type as the conv "
+        "output.");
+    const Tensor accum_contig =
+        accum.contiguous(output.suggest_memory_format());
+    if (kReluFused) {
+      qadd_relu_stub(output.device().type(), output, output, accum_contig);
+    } else {
+      qadd_stub(output.device().type(), output, output, accum_contig);
+    }
+    return output;
+  }
+};
+
 static auto registry =
     c10::RegisterOperators()
         .op("quantized::conv2d",
@@ -662,6 +726,12 @@ static auto registry =
                 DispatchKey::QuantizedCPU))
         .op("quantized::conv3d_relu",
             c10::RegisterOperators::options().kernel<QConvInt8<3, true>>(
+                DispatchKey::QuantizedCPU))
+        .op("quantized::conv2d_add",
+            c10::RegisterOperators::options().kernel<QConvAddInt8<2, false>>(
+                DispatchKey::QuantizedCPU))
+        .op("quantized::conv2d_add_relu",
+            c10::RegisterOperators::options().kernel<QConvAddInt8<2, true>>(
                 DispatchKey::QuantizedCPU));
 
 } // namespace
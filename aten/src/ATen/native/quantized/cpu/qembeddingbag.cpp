@@ -0,0 +1,392 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/op_registration/op_registration.h>
+
+#include <caffe2/perfkernels/fused_8bit_rowwise_conversion.h>
+#include <caffe2/perfkernels/fused_8bit_rowwise_embedding_lookup_idx.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Quantizes a float embedding table to fused 8-bit rowwise format: each row
+// stores its values as uint8 followed by a float scale and a float bias
+// (8 extra bytes per row). Rows are quantized independently, so the format
+// tolerates the wildly different magnitudes typical of embedding tables.
+class QEmbeddingBagBytePrepack final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    TORCH_CHECK(
+        weight.scalar_type() == kFloat,
+        "quantized::embedding_bag_byte_prepack expects a float weight");
+    TORCH_CHECK(
+        weight.dim() == 2,
+        "quantized::embedding_bag_byte_prepack expects a 2d weight");
+    const auto weight_contig = weight.contiguous();
+    const int64_t num_rows = weight.size(0);
+    const int64_t num_cols = weight.size(1);
+    // 4-byte scale and 4-byte bias are appended to each quantized row.
+    Tensor packed = at::empty(
+        {num_rows, num_cols + 8}, weight.options().dtype(kByte));
+    caffe2::FloatToFused8BitRowwiseQuantized(
+        weight_contig.data_ptr<float>(),
+        num_rows,
+        num_cols,
+        packed.data_ptr<uint8_t>());
+    return packed;
+  }
+};
+
+class QEmbeddingBagByteUnpack final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor packed) {
+    TORCH_CHECK(
+        packed.scalar_type() == kByte,
+        "quantized::embedding_bag_byte_unpack expects a uint8 weight");
+    TORCH_CHECK(
+        packed.dim() == 2 && packed.size(1) > 8,
+        "quantized::embedding_bag_byte_unpack expects rows of quantized "
+        "values followed by an 8-byte scale and bias");
+    const auto packed_contig = packed.contiguous();
+    const int64_t num_rows = packed.size(0);
+    const int64_t num_cols = packed.size(1) - 8;
+    Tensor weight = at::empty(
+        {num_rows, num_cols}, packed.options().dtype(kFloat));
+    caffe2::Fused8BitRowwiseQuantizedToFloat(
+        packed_contig.data_ptr<uint8_t>(),
+        num_rows,
+        num_cols,
+        weight.data_ptr<float>());
+    return weight;
+  }
+};
+
+// Quantizes a float embedding table to fused 4-bit rowwise format: each row
+// stores two values per byte (low nibble first) followed by an fp16 scale
+// and an fp16 bias (4 extra bytes per row). There is no perfkernel for this
+// format, so the pack/unpack/lookup loops below are plain C++; they are
+// simple enough for the compiler to vectorize, and the 8x storage saving is
+// what matters for tables that do not fit in memory.
+class QEmbeddingBag4BitPrepack final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    TORCH_CHECK(
+        weight.scalar_type() == kFloat,
+        "quantized::embedding_bag_4bit_prepack expects a float weight");
+    TORCH_CHECK(
+        weight.dim() == 2 && weight.size(1) % 2 == 0,
+        "quantized::embedding_bag_4bit_prepack expects a 2d weight with an "
+        "even number of columns");
+    const auto weight_contig = weight.contiguous();
+    const int64_t num_rows = weight.size(0);
+    const int64_t num_cols = weight.size(1);
+    // Two quantized values per byte, plus a 2-byte fp16 scale and bias.
+    Tensor packed = at::empty(
+        {num_rows, num_cols / 2 + 4}, weight.options().dtype(kByte));
+    const auto* weight_data = weight_contig.data_ptr<float>();
+    auto* packed_data = packed.data_ptr<uint8_t>();
+
+    at::parallel_for(0, num_rows, 1, [&](int64_t start_row, int64_t end_row) {
+      for (int64_t row = start_row; row < end_row; row++) {
+        const float* src = weight_data + row * num_cols;
+        uint8_t* dst = packed_data + row * (num_cols / 2 + 4);
+        const float minimum = *std::min_element(src, src + num_cols);
+        const float maximum = *std::max_element(src, src + num_cols);
+        at::Half scale = (maximum - minimum) / 15.0f;
+        at::Half bias = minimum;
+        // Quantize with the fp16-rounded scale/bias the lookup will use.
+        const float scale_fp32 = std::max(static_cast<float>(scale), 1e-8f);
+        const float bias_fp32 = bias;
+        for (int64_t col = 0; col < num_cols; col += 2) {
+          const auto quantize = [&](float value) -> uint8_t {
+            const float transformed = (value - bias_fp32) / scale_fp32;
+            return static_cast<uint8_t>(
+                std::max(0.0f, std::min(std::nearbyint(transformed), 15.0f)));
+          };
+          dst[col / 2] = quantize(src[col]) | (quantize(src[col + 1]) << 4);
+        }
+        std::memcpy(dst + num_cols / 2, &scale, sizeof(at::Half));
+        std::memcpy(dst + num_cols / 2 + 2, &bias, sizeof(at::Half));
+      }
+    });
+    return packed;
+  }
+};
+
+class QEmbeddingBag4BitUnpack final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor packed) {
+    TORCH_CHECK(
+        packed.scalar_type() == kByte,
+        "quantized::embedding_bag_4bit_unpack expects a uint8 weight");
+    TORCH_CHECK(
+        packed.dim() == 2 && packed.size(1) > 4,
+        "quantized::embedding_bag_4bit_unpack expects rows of packed nibbles "
+        "followed by a 4-byte fp16 scale and bias");
+    const auto packed_contig = packed.contiguous();
+    const int64_t num_rows = packed.size(0);
+    const int64_t packed_cols = packed.size(1);
+    const int64_t num_cols = (packed_cols - 4) * 2;
+    Tensor weight = at::empty(
+        {num_rows, num_cols}, packed.options().dtype(kFloat));
+    const auto* packed_data = packed_contig.data_ptr<uint8_t>();
+    auto* weight_data = weight.data_ptr<float>();
+
+    for (int64_t row = 0; row < num_rows; row++) {
+      const uint8_t* src = packed_data + row * packed_cols;
+      float* dst = weight_data + row * num_cols;
+      at::Half scale, bias;
+      std::memcpy(&scale, src + num_cols / 2, sizeof(at::Half));
+      std::memcpy(&bias, src + num_cols / 2 + 2, sizeof(at::Half));
+      for (int64_t col = 0; col < num_cols; col += 2) {
+        const uint8_t byte = src[col / 2];
+        dst[col] = static_cast<float>(scale) * (byte & 0x0f) + bias;
+        dst[col + 1] = static_cast<float>(scale) * (byte >> 4) + bias;
+      }
+    }
+    return weight;
+  }
+};
+
+// Sum-mode embedding bag over a fused 8-bit rowwise quantized table. The
+// perfkernel dequantizes each row on the fly (scale * value + bias) and
+// accumulates in float with software prefetching of the upcoming rows, so
+// the table can stay in the 4x smaller packed format end to end.
+class QEmbeddingBagByteRowwiseOffsets final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      bool scale_grad_by_freq,
+      int64_t mode,
+      bool sparse,
+      c10::optional<Tensor> per_sample_weights,
+      bool include_last_offset) {
+    TORCH_CHECK(
+        weight.scalar_type() == kByte && weight.dim() == 2 &&
+            weight.size(1) > 8,
+        "quantized::embedding_bag_byte_rowwise_offsets expects a 2d uint8 "
+        "weight produced by quantized::embedding_bag_byte_prepack");
+    TORCH_CHECK(
+        indices.scalar_type() == kLong && offsets.scalar_type() == kLong,
+        "quantized::embedding_bag_byte_rowwise_offsets expects int64 indices "
+        "and offsets");
+    TORCH_CHECK(
+        mode == 0,
+        "quantized::embedding_bag_byte_rowwise_offsets only supports "
+        "mode='sum'");
+    TORCH_CHECK(
+        !scale_grad_by_freq && !sparse,
+        "quantized::embedding_bag_byte_rowwise_offsets is an inference-only "
+        "operator");
+    if (per_sample_weights.has_value()) {
+      TORCH_CHECK(
+          per_sample_weights->scalar_type() == kFloat &&
+              per_sample_weights->numel() == indices.numel(),
+          "per_sample_weights must be a float tensor with one entry per "
+          "index");
+    }
+
+    const auto weight_contig = weight.contiguous();
+    const auto indices_contig = indices.contiguous();
+    const auto offsets_contig = offsets.contiguous();
+
+    const int64_t block_size = weight.size(1) - 8;
+    int64_t output_size = offsets.numel() - 1;
+    const int64_t* offsets_data = offsets_contig.data_ptr<int64_t>();
+    std::vector<int64_t> offsets_include_last;
+
+    // Same convention as the float fast path in EmbeddingBag.cpp: the
+    // perfkernel wants offsets with one-past-the-end included.
+    if (!include_last_offset) {
+      output_size = offsets.numel();
+      offsets_include_last.resize(offsets.numel() + 1);
+      std::memcpy(
+          offsets_include_last.data(),
+          offsets_data,
+          sizeof(int64_t) * offsets.numel());
+      offsets_include_last[offsets.numel()] = indices.numel();
+      offsets_data = offsets_include_last.data();
+    }
+
+    Tensor output = at::empty(
+        {output_size, block_size}, weight.options().dtype(kFloat));
+    auto* output_data = output.data_ptr<float>();
+    const auto* weight_data = weight_contig.data_ptr<uint8_t>();
+    const auto* indices_data = indices_contig.data_ptr<int64_t>();
+    Tensor per_sample_weights_contig;
+    const float* per_sample_weights_data = nullptr;
+    if (per_sample_weights.has_value()) {
+      per_sample_weights_contig = per_sample_weights->contiguous();
+      per_sample_weights_data = per_sample_weights_contig.data_ptr<float>();
+    }
+
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          // The perfkernel bounds-checks the indices itself and throws on
+          // out-of-range rows.
+          caffe2::Fused8BitRowwiseEmbeddingLookupIdx(
+              /*block_size=*/block_size,
+              /*output_size=*/end_idx - start_idx,
+              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
+              /*data_size=*/weight.size(0),
+              /*input=*/weight_data,
+              /*indices=*/indices_data + offsets_data[start_idx],
+              /*offsets=*/offsets_data + start_idx,
+              /*weights=*/per_sample_weights_data
+                  ? per_sample_weights_data + offsets_data[start_idx]
+                  : nullptr,
+              /*normalize_by_lengths=*/false,
+              /*out=*/output_data + start_idx * block_size);
+        });
+    return output;
+  }
+};
+
+// Sum-mode embedding bag over a fused 4-bit rowwise quantized table.
+// Dequantization (scale * nibble + bias) is fused into the accumulation so
+// the table is only ever touched in its packed form.
+class QEmbeddingBag4BitRowwiseOffsets final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      bool scale_grad_by_freq,
+      int64_t mode,
+      bool sparse,
+      c10::optional<Tensor> per_sample_weights,
+      bool include_last_offset) {
+    TORCH_CHECK(
+        weight.scalar_type() == kByte && weight.dim() == 2 &&
+            weight.size(1) > 4,
+        "quantized::embedding_bag_4bit_rowwise_offsets expects a 2d uint8 "
+        "weight produced by quantized::embedding_bag_4bit_prepack");
+    TORCH_CHECK(
+        indices.scalar_type() == kLong && offsets.scalar_type() == kLong,
+        "quantized::embedding_bag_4bit_rowwise_offsets expects int64 indices "
+        "and offsets");
+    TORCH_CHECK(
+        mode == 0,
+        "quantized::embedding_bag_4bit_rowwise_offsets only supports "
+        "mode='sum'");
+    TORCH_CHECK(
+        !scale_grad_by_freq && !sparse,
+        "quantized::embedding_bag_4bit_rowwise_offsets is an inference-only "
+        "operator");
+    if (per_sample_weights.has_value()) {
+      TORCH_CHECK(
+          per_sample_weights->scalar_type() == kFloat &&
+              per_sample_weights->numel() == indices.numel(),
+          "per_sample_weights must be a float tensor with one entry per "
+          "index");
+    }
+
+    const auto weight_contig = weight.contiguous();
+    const auto indices_contig = indices.contiguous();
+    const auto offsets_contig = offsets.contiguous();
+
+    const int64_t packed_cols = weight.size(1);
+    const int64_t block_size = (packed_cols - 4) * 2;
+    const int64_t num_rows = weight.size(0);
+    int64_t output_size = offsets.numel() - 1;
+    const int64_t* offsets_data = offsets_contig.data_ptr<int64_t>();
+    std::vector<int64_t> offsets_include_last;
+
+    if (!include_last_offset) {
+      output_size = offsets.numel();
+      offsets_include_last.resize(offsets.numel() + 1);
+      std::memcpy(
+          offsets_include_last.data(),
+          offsets_data,
+          sizeof(int64_t) * offsets.numel());
+      offsets_include_last[offsets.numel()] = indices.numel();
+      offsets_data = offsets_include_last.data();
+    }
+
+    Tensor output = at::zeros(
+        {output_size, block_size}, weight.options().dtype(kFloat));
+    auto* output_data = output.data_ptr<float>();
+    const auto* weight_data = weight_contig.data_ptr<uint8_t>();
+    const auto* indices_data = indices_contig.data_ptr<int64_t>();
+    Tensor per_sample_weights_contig;
+    const float* per_sample_weights_data = nullptr;
+    if (per_sample_weights.has_value()) {
+      per_sample_weights_contig = per_sample_weights->contiguous();
+      per_sample_weights_data = per_sample_weights_contig.data_ptr<float>();
+    }
+
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          for (int64_t bag = start_idx; bag < end_idx; bag++) {
+            float* out_row = output_data + bag * block_size;
+            for (int64_t pos = offsets_data[bag]; pos < offsets_data[bag + 1];
+                 pos++) {
+              const int64_t row = indices_data[pos];
+              TORCH_CHECK(
+                  row >= 0 && row < num_rows,
+                  "quantized::embedding_bag_4bit_rowwise_offsets: index ",
+                  row,
+                  " is out of bounds for a table with ",
+                  num_rows,
+                  " rows");
+              const uint8_t* src = weight_data + row * packed_cols;
+              at::Half scale_fp16, bias_fp16;
+              std::memcpy(
+                  &scale_fp16, src + block_size / 2, sizeof(at::Half));
+              std::memcpy(
+                  &bias_fp16, src + block_size / 2 + 2, sizeof(at::Half));
+              float scale = scale_fp16;
+              float bias = bias_fp16;
+              if (per_sample_weights_data) {
+                scale *= per_sample_weights_data[pos];
+                bias *= per_sample_weights_data[pos];
+              }
+              for (int64_t col = 0; col < block_size; col += 2) {
+                const uint8_t byte = src[col / 2];
+                out_row[col] += scale * (byte & 0x0f) + bias;
+                out_row[col + 1] += scale * (byte >> 4) + bias;
+              }
+            }
+          }
+        });
+    return output;
+  }
+};
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("quantized::embedding_bag_byte_prepack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBagBytePrepack>(DispatchKey::CPU))
+        .op("quantized::embedding_bag_byte_unpack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBagByteUnpack>(DispatchKey::CPU))
+        .op("quantized::embedding_bag_byte_rowwise_offsets(Tensor weight, "
+            "Tensor indices, Tensor offsets, bool scale_grad_by_freq=False, "
+            "int mode=0, bool sparse=False, Tensor? per_sample_weights=None, "
+            "bool include_last_offset=False) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBagByteRowwiseOffsets>(DispatchKey::CPU))
+        .op("quantized::embedding_bag_4bit_prepack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitPrepack>(DispatchKey::CPU))
+        .op("quantized::embedding_bag_4bit_unpack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitUnpack>(DispatchKey::CPU))
+        .op("quantized::embedding_bag_4bit_rowwise_offsets(Tensor weight, "
+            "Tensor indices, Tensor offsets, bool scale_grad_by_freq=False, "
+            "int mode=0, bool sparse=False, Tensor? per_sample_weights=None, "
+            "bool include_last_offset=False) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitRowwiseOffsets>(DispatchKey::CPU));
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -0,0 +1,227 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/quantized/fake_quant_affine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Fused moving-average min/max observer + fake quantization.
+//
+// Quantization-aware training otherwise runs the observer as a chain of
+// Python-driven reductions and then a separate fake-quantize kernel, reading
+// every observed tensor several times. This op computes the min/max
+// statistics, folds them into the moving averages, derives the quantization
+// parameters and applies the (already vectorized) fake-quantize kernels in a
+// single C++ call; the tensor is read exactly twice (the statistics have to
+// be complete before quantization can start), with no trips back to Python
+// in between.
+namespace at {
+namespace native {
+
+namespace {
+
+// Matches MinMaxObserver.calculate_qparams for the affine scheme: the
+// quantized range always covers zero, the scale is floored at machine
+// epsilon so a constant tensor does not divide by zero, and the zero point
+// is clamped into [quant_min, quant_max].
+void calculate_affine_qparams(
+    float running_min,
+    float running_max,
+    int64_t quant_min,
+    int64_t quant_max,
+    float* scale,
+    int64_t* zero_point) {
+  const float min_val = std::min(running_min, 0.0f);
+  const float max_val = std::max(running_max, 0.0f);
+  float sc = (max_val - min_val) / static_cast<float>(quant_max - quant_min);
+  sc = std::max(sc, std::numeric_limits<float>::epsilon());
+  int64_t zp = quant_min - static_cast<int64_t>(std::nearbyint(min_val / sc));
+  zp = std::min(std::max(zp, quant_min), quant_max);
+  *scale = sc;
+  *zero_point = zp;
+}
+
+// Moving-average update shared by the per-tensor and per-channel paths. A
+// running range with min > max (the +inf/-inf a fresh observer buffer holds)
+// is treated as uninitialized and overwritten by the first observation.
+std::pair<float, float> update_running_range(
+    float running_min,
+    float running_max,
+    float observed_min,
+    float observed_max,
+    float averaging_const) {
+  if (running_min > running_max) {
+    return {observed_min, observed_max};
+  }
+  return {
+      running_min + averaging_const * (observed_min - running_min),
+      running_max + averaging_const * (observed_max - running_max)};
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor>
+fused_moving_avg_obs_fake_quant_cpu(
+    const Tensor& self,
+    const Tensor& running_min,
+    const Tensor& running_max,
+    double averaging_const,
+    int64_t quant_min,
+    int64_t quant_max,
+    int64_t ch_axis) {
+  TORCH_CHECK(self.scalar_type() == ScalarType::Float);
+  TORCH_CHECK(
+      running_min.scalar_type() == ScalarType::Float &&
+          running_max.scalar_type() == ScalarType::Float,
+      "`running_min` and `running_max` must be float tensors");
+  TORCH_CHECK(
+      running_min.sizes() == running_max.sizes(),
+      "`running_min` and `running_max` must have the same shape");
+  TORCH_CHECK(
+      quant_min <= quant_max,
+      "`quant_min` should be less than or \
+        equal to `quant_max`.");
+  TORCH_CHECK(self.numel() > 0, "expected a non-empty input tensor");
+
+  const auto X = self.contiguous();
+  const float* x_data = X.data_ptr<float>();
+  const float c = static_cast<float>(averaging_const);
+
+  if (ch_axis < 0) {
+    // Per-tensor: one fused min/max reduction over the whole tensor.
+    TORCH_CHECK(
+        running_min.numel() == 1,
+        "`running_min` must have a single element for per-tensor observation");
+    const int64_t numel = X.numel();
+    using MinMax = std::pair<float, float>;
+    const MinMax observed = at::parallel_reduce(
+        0,
+        numel,
+        at::internal::GRAIN_SIZE,
+        MinMax(
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity()),
+        [&](int64_t begin, int64_t end, MinMax acc) -> MinMax {
+          for (int64_t i = begin; i < end; i++) {
+            acc.first = std::min(acc.first, x_data[i]);
+            acc.second = std::max(acc.second, x_data[i]);
+          }
+          return acc;
+        },
+        [](MinMax a, MinMax b) -> MinMax {
+          return {std::min(a.first, b.first), std::max(a.second, b.second)};
+        });
+
+    const auto range = update_running_range(
+        running_min.item<float>(),
+        running_max.item<float>(),
+        observed.first,
+        observed.second,
+        c);
+
+    float scale;
+    int64_t zero_point;
+    calculate_affine_qparams(
+        range.first, range.second, quant_min, quant_max, &scale, &zero_point);
+
+    Tensor Y = at::empty_like(X, X.options(), MemoryFormat::Preserve);
+    fake_quant_tensor_stub(
+        kCPU, Y, X, scale, zero_point, quant_min, quant_max);
+
+    return std::make_tuple(
+        Y,
+        at::full({1}, range.first, self.options()),
+        at::full({1}, range.second, self.options()),
+        at::full({1}, scale, self.options()),
+        at::full({1}, zero_point, self.options().dtype(kLong)));
+  }
+
+  // Per-channel: statistics along ch_axis, one scale/zero_point per channel.
+  TORCH_CHECK(
+      ch_axis < self.dim(),
+      "`ch_axis` must be smaller than the number of input dimensions");
+  const int64_t channels = X.size(ch_axis);
+  TORCH_CHECK(
+      running_min.dim() == 1 && running_min.numel() == channels,
+      "`running_min` must be a 1-D tensor with one element per channel");
+
+  int64_t outer = 1;
+  for (int64_t d = 0; d < ch_axis; d++) {
+    outer *= X.size(d);
+  }
+  int64_t inner = 1;
+  for (int64_t d = ch_axis + 1; d < X.dim(); d++) {
+    inner *= X.size(d);
+  }
+
+  const auto running_min_contig = running_min.contiguous();
+  const auto running_max_contig = running_max.contiguous();
+  const float* running_min_data = running_min_contig.data_ptr<float>();
+  const float* running_max_data = running_max_contig.data_ptr<float>();
+
+  Tensor new_running_min = at::empty({channels}, self.options());
+  Tensor new_running_max = at::empty({channels}, self.options());
+  Tensor scale = at::empty({channels}, self.options());
+  Tensor zero_point = at::empty({channels}, self.options().dtype(kLong));
+  float* new_running_min_data = new_running_min.data_ptr<float>();
+  float* new_running_max_data = new_running_max.data_ptr<float>();
+  float* scale_data = scale.data_ptr<float>();
+  int64_t* zero_point_data = zero_point.data_ptr<int64_t>();
+
+  at::parallel_for(0, channels, 1, [&](int64_t start_ch, int64_t end_ch) {
+    for (int64_t ch = start_ch; ch < end_ch; ch++) {
+      float observed_min = std::numeric_limits<float>::infinity();
+      float observed_max = -std::numeric_limits<float>::infinity();
+      for (int64_t o = 0; o < outer; o++) {
+        const float* slice = x_data + (o * channels + ch) * inner;
+        for (int64_t i = 0; i < inner; i++) {
+          observed_min = std::min(observed_min, slice[i]);
+          observed_max = std::max(observed_max, slice[i]);
+        }
+      }
+      const auto range = update_running_range(
+          running_min_data[ch],
+          running_max_data[ch],
+          observed_min,
+          observed_max,
+          c);
+      new_running_min_data[ch] = range.first;
+      new_running_max_data[ch] = range.second;
+      calculate_affine_qparams(
+          range.first,
+          range.second,
+          quant_min,
+          quant_max,
+          &scale_data[ch],
+          &zero_point_data[ch]);
+    }
+  });
+
+  auto Y = at::empty_like(X, X.options(), MemoryFormat::Preserve);
+
+  std::vector<int64_t> expected_shape(X.dim(), 1);
+  expected_shape[ch_axis] = channels;
+
+  TensorIterator iter;
+  iter.dont_compute_common_dtype();
+  iter.add_output(Y);
+  iter.add_input(X);
+  iter.add_input(native::_unsafe_view(scale, expected_shape));
+  iter.add_input(native::_unsafe_view(zero_point, expected_shape));
+  iter.build();
+
+  fake_quant_per_channel_stub(iter.device_type(), iter, quant_min, quant_max);
+
+  return std::make_tuple(
+      Y, new_running_min, new_running_max, scale, zero_point);
+}
+
+} // namespace native
+} // namespace at
@@ -519,4 +519,44 @@ SparseTensor sparse_mask_cpu(const Tensor& t, const SparseTensor& mask) {
   return r;
 }
 
+// --------------------------------------------------------------------
+// CSR conversion
+// --------------------------------------------------------------------
+
+// Builds the compressed row pointer array of a CSR matrix from the row
+// indices of a coalesced COO matrix: result[r + 1] - result[r] is the number
+// of nonzeros in row r, so result[r] is where row r starts in the
+// col_indices/values arrays.
+Tensor _convert_indices_from_coo_to_csr_cpu(const Tensor& self, int64_t size) {
+  TORCH_CHECK(
+      self.dim() == 1,
+      "_convert_indices_from_coo_to_csr: expected a 1-dimensional tensor of row indices");
+  TORCH_CHECK(
+      self.scalar_type() == kLong,
+      "_convert_indices_from_coo_to_csr: expected int64 row indices, but got ",
+      self.scalar_type());
+  Tensor result = at::zeros({size + 1}, self.options());
+  if (self.numel() > 0) {
+    const Tensor input = self.contiguous();
+    const int64_t* indices = input.data_ptr<int64_t>();
+    int64_t* crow_indices = result.data_ptr<int64_t>();
+    const int64_t nnz = input.numel();
+    for (int64_t i = 0; i < nnz; i++) {
+      const int64_t row = indices[i];
+      TORCH_CHECK(
+          row >= 0 && row < size,
+          "_convert_indices_from_coo_to_csr: row index ",
+          row,
+          " is out of bounds for a matrix with ",
+          size,
+          " rows");
+      crow_indices[row + 1]++;
+    }
+    for (int64_t i = 0; i < size; i++) {
+      crow_indices[i + 1] += crow_indices[i];
+    }
+  }
+  return result;
+}
+
 }} // namespace at::native
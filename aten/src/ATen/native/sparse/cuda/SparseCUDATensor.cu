@@ -25,6 +25,19 @@ namespace at { namespace native {
 
 using namespace at::sparse;
 
+namespace {
+
+template <typename T>
+struct ModNOp {
+  ModNOp(T n) : n(n) {}
+  __host__ __device__ T operator()(const T& i) const {
+    return i % n;
+  }
+  T n;
+};
+
+} // namespace
+
 SparseTensor coalesce_sparse_cuda(const SparseTensor& self) {
   int64_t nnz = self._nnz();
   if (self.is_coalesced()) {
@@ -54,21 +67,22 @@ SparseTensor coalesce_sparse_cuda(const SparseTensor& self) {
   // here.
   LongTensor indices1D = flatten_indices(self._indices(), self.sizes(), true);
 
-  LongTensor origIndices = at::empty({nnz}, self._indices().options());
-  LongTensor uniqueOffsets = at::empty({nnz}, self._indices().options());
+  // origIndices and uniqueOffsets are both initialized to 0, 1, ..., nnz - 1;
+  // batch them into a single allocation and a single fill launch, since the
+  // small coalesces that sparse embedding gradients produce are launch-bound.
+  LongTensor indexBookkeeping = at::empty({2 * nnz}, self._indices().options());
+  LongTensor origIndices = indexBookkeeping.narrow(0, 0, nnz);
+  LongTensor uniqueOffsets = indexBookkeeping.narrow(0, nnz, nnz);
 
   typedef thrust::device_ptr<int64_t> thrust_ptr;
   thrust_ptr indicesIter(indices1D.data_ptr<int64_t>());
   thrust_ptr origIndicesIter(origIndices.data_ptr<int64_t>());
   thrust_ptr uniqueOffsetsIter(uniqueOffsets.data_ptr<int64_t>());
 
-
-  // Fill sortedOrigIndices with sequential indices
-  thrust::counting_iterator<int64_t> countIterI(0);
-  thrust::counting_iterator<int64_t> countIterO(0);
-
-  thrust::copy(policy, countIterI, countIterI + nnz, origIndicesIter);
-  thrust::copy(policy, countIterO, countIterO + nnz, uniqueOffsetsIter);
+  thrust::counting_iterator<int64_t> countIter(0);
+  thrust::transform(
+    policy, countIter, countIter + 2 * nnz,
+    thrust_ptr(indexBookkeeping.data_ptr<int64_t>()), ModNOp<int64_t>(nnz));
 
   thrust::sort_by_key(policy,
     indicesIter, indicesIter + nnz,
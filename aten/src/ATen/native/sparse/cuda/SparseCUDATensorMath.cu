@@ -10,6 +10,7 @@
 #include <ATen/cuda/detail/IndexUtils.cuh>
 #include <ATen/WrapDimUtilsMulti.h>
 #include <ATen/ExpandUtils.h>
+#include <c10/util/intrusive_ptr.h>
 
 #include <THC/THCTensorMathPointwise.cuh>
 #include <THC/THCThrustAllocator.cuh>
@@ -21,6 +22,8 @@
 #include <thrust/system/cuda/execution_policy.h>
 
 #include <bitset>
+#include <mutex>
+#include <unordered_map>
 
 #define I_INFO(tensor) cuda::detail::getTensorInfo<int64_t, uint64_t>(tensor)
 #define V_INFO(tensor) cuda::detail::getTensorInfo<scalar_t, uint64_t>(tensor)
@@ -43,6 +46,76 @@ namespace {
     sparse::cuda::Xcoo2csr(rowIndicesInt.data_ptr<int32_t>(), nnz, dim, csr.data_ptr<int32_t>());
     return csr;
   }
+
+  // Cache of COO -> CSR conversions, keyed on the TensorImpl of the coalesced
+  // indices tensor and validated with a weak reference plus the version
+  // counter (the same scheme the MKL-DNN weight prepacking cache uses). When
+  // the same sparse matrix is multiplied repeatedly -- a fixed adjacency
+  // matrix, or the embedding gradient an optimizer applies right after
+  // coalescing it -- the Xcoo2csr call and the int32 column index conversion
+  // only run the first time.
+  struct CsrCacheEntry {
+    c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>
+        indices_impl;
+    uint32_t indices_version;
+    int64_t dim;
+    IntTensor csr;
+    IntTensor colIndicesInt;
+  };
+
+  std::mutex csr_cache_mutex;
+  std::unordered_map<c10::TensorImpl*, CsrCacheEntry> csr_cache;
+
+  void _to_csr_int_cached(
+      const LongTensor& indices,
+      int64_t dim,
+      int64_t nnz,
+      IntTensor* csr,
+      IntTensor* colIndicesInt) {
+    c10::TensorImpl* impl = indices.unsafeGetTensorImpl();
+    const uint32_t version = impl->version_counter().current_version();
+    {
+      std::lock_guard<std::mutex> guard(csr_cache_mutex);
+      auto it = csr_cache.find(impl);
+      if (it != csr_cache.end()) {
+        const auto& entry = it->second;
+        if (!entry.indices_impl.expired() &&
+            entry.indices_version == version && entry.dim == dim) {
+          *csr = entry.csr;
+          *colIndicesInt = entry.colIndicesInt;
+          return;
+        }
+        // The impl was reallocated at the same address, mutated in place, or
+        // the sparse matrix was resized; drop the stale conversion.
+        csr_cache.erase(it);
+      }
+    }
+
+    *csr = _to_csr_int(indices.select(0, 0), dim, nnz);
+    LongTensor colIndices = indices.select(0, 1);
+    *colIndicesInt = at::empty({colIndices.size(0)}, indices.options().dtype(kInt));
+    colIndicesInt->copy_(colIndices);
+
+    std::lock_guard<std::mutex> guard(csr_cache_mutex);
+    // Dead entries pin their converted tensors (and thus device memory), so
+    // sweep them out whenever a new conversion is inserted.
+    for (auto it = csr_cache.begin(); it != csr_cache.end();) {
+      if (it->second.indices_impl.expired()) {
+        it = csr_cache.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    csr_cache.emplace(
+        impl,
+        CsrCacheEntry{
+            c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>(
+                indices.getIntrusivePtr()),
+            version,
+            dim,
+            *csr,
+            *colIndicesInt});
+  }
 }
 
 // NB: Deleted spaddcmul (aka addcmul_, but not actually wired up), spaddcdiv (not
@@ -84,11 +157,8 @@ Tensor& s_addmm_out_sparse_dense_cuda(Tensor& r_, const Tensor& t, const SparseT
   LongTensor indices = sparse._indices();
   Tensor values = sparse._values();
 
-  LongTensor rowIndices = indices.select(0, 0);
-  LongTensor colIndices = indices.select(0, 1);
-  IntTensor csr = _to_csr_int(rowIndices, m, nnz);
-  IntTensor colIndicesInt = at::empty({colIndices.size(0)}, indices.options().dtype(kInt));
-  colIndicesInt.copy_(colIndices);
+  IntTensor csr, colIndicesInt;
+  _to_csr_int_cached(indices, m, nnz, &csr, &colIndicesInt);
 
   // No half support, so we don't have to use CUDATypeConversion
   Tensor r__;
@@ -259,8 +259,10 @@ bool use_convolution2d(
     const IntArrayRef padding,
     const IntArrayRef stride,
     const IntArrayRef dilation,
-    const int64_t groups) {
-  return internal::convolution2d::available(
+    const int64_t groups,
+    const bool transposed) {
+  return !transposed &&
+         internal::convolution2d::available(
             weight,
             bias,
             padding,
@@ -47,8 +47,7 @@ Tensor convolution2d(
     const IntArrayRef,
     const IntArrayRef,
     const IntArrayRef,
-    const int64_t,
-    const bool) {
+    const int64_t) {
   TORCH_CHECK(false, internal::kError);
 }
 
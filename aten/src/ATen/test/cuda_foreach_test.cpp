@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+
+// The fused _foreach_* kernels pair elements of corresponding tensors by
+// flat offset, so the fast route must refuse lists whose paired tensors
+// have different layouts and fall back to the per-tensor slow path. A
+// channels-last tensor in one list against a contiguous one in the other
+// is the configuration Adam-style updates actually produce.
+TEST(ForeachTest, MixedMemoryFormatMatchesSlowPath) {
+  if (!at::cuda::is_available()) return;
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA);
+
+  std::vector<at::Tensor> params;
+  std::vector<at::Tensor> grads;
+  std::vector<at::Tensor> expected;
+  for (int i = 0; i < 3; i++) {
+    auto p = at::rand({2, 3, 4, 5}, options);
+    auto g = at::rand({2, 3, 4, 5}, options)
+                 .contiguous(at::MemoryFormat::ChannelsLast);
+    params.push_back(p);
+    grads.push_back(g);
+    // Reference result via a plain per-tensor op.
+    expected.push_back(p.add(g, 2.0));
+  }
+
+  at::_foreach_add_(params, grads, 2.0);
+  for (size_t i = 0; i < params.size(); i++) {
+    ASSERT_TRUE(params[i].allclose(expected[i]));
+  }
+}
+
+TEST(ForeachTest, MatchingLayoutsStillFused) {
+  if (!at::cuda::is_available()) return;
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA);
+
+  std::vector<at::Tensor> self;
+  std::vector<at::Tensor> tensor1;
+  std::vector<at::Tensor> tensor2;
+  std::vector<at::Tensor> expected;
+  for (int i = 0; i < 3; i++) {
+    auto s = at::rand({16, 16}, options);
+    auto t1 = at::rand({16, 16}, options);
+    auto t2 = at::rand({16, 16}, options);
+    self.push_back(s);
+    tensor1.push_back(t1);
+    tensor2.push_back(t2);
+    expected.push_back(s.addcmul(t1, t2, 0.5));
+  }
+
+  at::_foreach_addcmul_(self, tensor1, tensor2, 0.5);
+  for (size_t i = 0; i < self.size(); i++) {
+    ASSERT_TRUE(self[i].allclose(expected[i]));
+  }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <cmath>
+
+namespace {
+
+// Reference Adam update expressed with plain tensor ops, matching
+// fused_adam_kernel_slow_.
+void reference_adam_step(
+    std::vector<at::Tensor>& params,
+    const std::vector<at::Tensor>& grads,
+    std::vector<at::Tensor>& exp_avgs,
+    std::vector<at::Tensor>& exp_avg_sqs,
+    double lr,
+    double beta1,
+    double beta2,
+    double eps,
+    int64_t step) {
+  const double bias_correction1 = 1 - std::pow(beta1, step);
+  const double bias_correction2 = 1 - std::pow(beta2, step);
+  const double step_size = lr / bias_correction1;
+  for (size_t i = 0; i < params.size(); i++) {
+    exp_avgs[i].mul_(beta1).add_(grads[i], 1 - beta1);
+    exp_avg_sqs[i].mul_(beta2).addcmul_(grads[i], grads[i], 1 - beta2);
+    auto denom =
+        exp_avg_sqs[i].sqrt().div_(std::sqrt(bias_correction2)).add_(eps);
+    params[i].addcdiv_(exp_avgs[i], denom, -step_size);
+  }
+}
+
+} // namespace
+
+// The fused CPU optimizer steps index all buffers by one flat offset, so a
+// channels-last grad against contiguous param/exp_avg buffers must be routed
+// to the tensor-op fallback rather than updating the wrong elements.
+TEST(ForeachTest, FusedAdamMixedMemoryFormat) {
+  std::vector<at::Tensor> params;
+  std::vector<at::Tensor> grads;
+  std::vector<at::Tensor> exp_avgs;
+  std::vector<at::Tensor> exp_avg_sqs;
+  std::vector<at::Tensor> ref_params;
+  std::vector<at::Tensor> ref_exp_avgs;
+  std::vector<at::Tensor> ref_exp_avg_sqs;
+  for (int i = 0; i < 3; i++) {
+    auto p = at::rand({2, 3, 4, 5});
+    auto g = at::rand({2, 3, 4, 5}).contiguous(at::MemoryFormat::ChannelsLast);
+    auto m = at::rand({2, 3, 4, 5});
+    auto v = at::rand({2, 3, 4, 5}).abs();
+    params.push_back(p);
+    grads.push_back(g);
+    exp_avgs.push_back(m);
+    exp_avg_sqs.push_back(v);
+    ref_params.push_back(p.clone());
+    ref_exp_avgs.push_back(m.clone());
+    ref_exp_avg_sqs.push_back(v.clone());
+  }
+
+  const double lr = 1e-2, beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+  const int64_t step = 3;
+  at::_fused_adam_(
+      params, grads, exp_avgs, exp_avg_sqs,
+      lr, beta1, beta2, /*weight_decay=*/0.0, eps, step);
+  reference_adam_step(
+      ref_params, grads, ref_exp_avgs, ref_exp_avg_sqs,
+      lr, beta1, beta2, eps, step);
+
+  for (size_t i = 0; i < params.size(); i++) {
+    ASSERT_TRUE(params[i].allclose(ref_params[i]));
+    ASSERT_TRUE(exp_avgs[i].allclose(ref_exp_avgs[i]));
+    ASSERT_TRUE(exp_avg_sqs[i].allclose(ref_exp_avg_sqs[i]));
+  }
+}
+
+// Uniformly contiguous lists keep taking the fused raw-pointer path; its
+// result must agree with the tensor-op reference.
+TEST(ForeachTest, FusedAdamMatchesReference) {
+  std::vector<at::Tensor> params;
+  std::vector<at::Tensor> grads;
+  std::vector<at::Tensor> exp_avgs;
+  std::vector<at::Tensor> exp_avg_sqs;
+  std::vector<at::Tensor> ref_params;
+  std::vector<at::Tensor> ref_exp_avgs;
+  std::vector<at::Tensor> ref_exp_avg_sqs;
+  for (int i = 0; i < 3; i++) {
+    auto p = at::rand({16, 16});
+    auto g = at::rand({16, 16});
+    auto m = at::rand({16, 16});
+    auto v = at::rand({16, 16}).abs();
+    params.push_back(p);
+    grads.push_back(g);
+    exp_avgs.push_back(m);
+    exp_avg_sqs.push_back(v);
+    ref_params.push_back(p.clone());
+    ref_exp_avgs.push_back(m.clone());
+    ref_exp_avg_sqs.push_back(v.clone());
+  }
+
+  const double lr = 1e-2, beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+  const int64_t step = 1;
+  at::_fused_adam_(
+      params, grads, exp_avgs, exp_avg_sqs,
+      lr, beta1, beta2, /*weight_decay=*/0.0, eps, step);
+  reference_adam_step(
+      ref_params, grads, ref_exp_avgs, ref_exp_avg_sqs,
+      lr, beta1, beta2, eps, step);
+
+  for (size_t i = 0; i < params.size(); i++) {
+    ASSERT_TRUE(params[i].allclose(ref_params[i]));
+    ASSERT_TRUE(exp_avgs[i].allclose(ref_exp_avgs[i]));
+    ASSERT_TRUE(exp_avg_sqs[i].allclose(ref_exp_avg_sqs[i]));
+  }
+}
@@ -4,9 +4,11 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Parallel.h>
 
+#include <atomic>
 #include <iostream>
 #include <string.h>
 #include <sstream>
+#include <vector>
 
 using namespace at;
 
@@ -69,3 +71,41 @@ TEST(TestParallel, IntraOpLaunchFuture) {
 
   ASSERT_TRUE(v1 == 1 && v2 == 2);
 }
+
+TEST(TestParallel, LaunchFuture) {
+  std::atomic<int> v{0};
+
+  auto fut = at::launch_future([&v]() {
+    v += 1;
+  });
+  // continuations run inline once the future is ready
+  fut->addCallback([&v]() {
+    v += 10;
+  });
+  at::wait_for_future(fut);
+  ASSERT_EQ(v.load(), 11);
+
+  // waiting helps drain the pool, so nested fan-out waits cannot park
+  // every pool thread
+  std::atomic<int> done{0};
+  auto outer = at::launch_future([&done]() {
+    std::vector<std::shared_ptr<c10::ivalue::Future>> futs;
+    for (int i = 0; i < 16; i++) {
+      futs.push_back(at::launch_future([&done]() {
+        done += 1;
+      }));
+    }
+    for (auto& f : futs) {
+      at::wait_for_future(f);
+    }
+  });
+  at::wait_for_future(outer);
+  ASSERT_EQ(done.load(), 16);
+
+  // errors propagate through the future
+  auto err = at::launch_future([]() {
+    throw std::runtime_error("boom");
+  });
+  at::wait_for_future(err);
+  ASSERT_TRUE(err->hasError());
+}
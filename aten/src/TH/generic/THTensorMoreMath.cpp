@@ -362,6 +362,142 @@ static void THTensor_(quicksortdescend)(scalar_t *arr, int64_t *idx, int64_t ele
 #undef MAX_LEVELS
 #undef M_SMALL
 
+/* LSD radix sort fast path for primitive key types. Keys are mapped to an
+   order-preserving unsigned integer (sign-bit flip for signed integers,
+   the usual sign-magnitude transform for IEEE floats), sorted one byte at a
+   time together with the index payload, and mapped back. The histograms for
+   all digit positions are collected in a single parallel read; passes whose
+   digit is constant are skipped. Falls back to the comparator-based
+   quicksort for short or strided slices and when a float slice contains
+   NaN, so the comparator's NaN-last ordering is preserved. */
+#define TH_RADIX_SORT_MIN_SIZE 512
+
+#if defined(TH_REAL_IS_HALF) || defined(TH_REAL_IS_BOOL) || defined(TH_REAL_IS_BFLOAT16)
+
+static int THTensor_(tryRadixSort)(scalar_t *arr, int64_t arr_stride, int64_t *idx,
+                                   int64_t idx_stride, int64_t elements, int descending)
+{
+  /* comparator path handles these types */
+  (void)arr; (void)arr_stride; (void)idx; (void)idx_stride;
+  (void)elements; (void)descending;
+  return 0;
+}
+
+#else
+
+static inline uint64_t THTensor_(radixSortKey)(scalar_t v)
+{
+#if defined(TH_REAL_IS_FLOAT)
+  uint32_t b;
+  memcpy(&b, &v, sizeof(b));
+  return (b & 0x80000000u) ? (uint32_t)~b : (b | 0x80000000u);
+#elif defined(TH_REAL_IS_DOUBLE)
+  uint64_t b;
+  memcpy(&b, &v, sizeof(b));
+  return (b & 0x8000000000000000ull) ? ~b : (b | 0x8000000000000000ull);
+#elif defined(TH_REAL_IS_BYTE)
+  return (uint64_t)v;
+#else
+  /* signed integers: flip the sign bit, mask to the key width */
+  uint64_t mask = sizeof(scalar_t) == 8 ? ~0ull : ((1ull << (8 * sizeof(scalar_t))) - 1);
+  return ((uint64_t)v ^ (1ull << (8 * sizeof(scalar_t) - 1))) & mask;
+#endif
+}
+
+static inline scalar_t THTensor_(radixSortUnkey)(uint64_t k)
+{
+#if defined(TH_REAL_IS_FLOAT)
+  uint32_t b = (k & 0x80000000u) ? (uint32_t)(k & 0x7fffffffu) : (uint32_t)~k;
+  scalar_t v;
+  memcpy(&v, &b, sizeof(v));
+  return v;
+#elif defined(TH_REAL_IS_DOUBLE)
+  uint64_t b = (k & 0x8000000000000000ull) ? (k & 0x7fffffffffffffffull) : ~k;
+  scalar_t v;
+  memcpy(&v, &b, sizeof(v));
+  return v;
+#elif defined(TH_REAL_IS_BYTE)
+  return (scalar_t)k;
+#else
+  return (scalar_t)(k ^ (1ull << (8 * sizeof(scalar_t) - 1)));
+#endif
+}
+
+static int THTensor_(tryRadixSort)(scalar_t *arr, int64_t arr_stride, int64_t *idx,
+                                   int64_t idx_stride, int64_t elements, int descending)
+{
+  if (arr_stride != 1 || idx_stride != 1 || elements < TH_RADIX_SORT_MIN_SIZE) {
+    return 0;
+  }
+
+  const int passes = (int)sizeof(scalar_t);
+  std::vector<uint64_t> keys((size_t)elements), keys_tmp((size_t)elements);
+  std::vector<int64_t> pays((size_t)elements), pays_tmp((size_t)elements);
+  for (int64_t i = 0; i < elements; i++) {
+#if defined(TH_REAL_IS_FLOAT) || defined(TH_REAL_IS_DOUBLE)
+    if (std::isnan(arr[i])) {
+      return 0;
+    }
+#endif
+    keys[(size_t)i] = THTensor_(radixSortKey)(arr[i]);
+    pays[(size_t)i] = idx[i];
+  }
+
+  /* one parallel read collects the histograms for every digit position */
+  const int max_threads = at::get_num_threads();
+  std::vector<int64_t> hists((size_t)max_threads * passes * 256, 0);
+  at::parallel_for(0, elements, TH_OMP_OVERHEAD_THRESHOLD,
+      [&](int64_t begin, int64_t end) {
+    int64_t* hist = hists.data() + (size_t)at::get_thread_num() * passes * 256;
+    for (int64_t i = begin; i < end; i++) {
+      uint64_t k = keys[(size_t)i];
+      for (int p = 0; p < passes; p++) {
+        hist[p * 256 + ((k >> (8 * p)) & 0xff)]++;
+      }
+    }
+  });
+
+  uint64_t *src_k = keys.data(), *dst_k = keys_tmp.data();
+  int64_t *src_p = pays.data(), *dst_p = pays_tmp.data();
+  for (int p = 0; p < passes; p++) {
+    int64_t offset[256];
+    int64_t bucket = 0;
+    int constant_digit = 0;
+    for (int d = 0; d < 256; d++) {
+      int64_t count = 0;
+      for (int t = 0; t < max_threads; t++) {
+        count += hists[(size_t)t * passes * 256 + p * 256 + d];
+      }
+      if (count == elements) {
+        constant_digit = 1;
+      }
+      offset[d] = bucket;
+      bucket += count;
+    }
+    if (constant_digit) {
+      continue;
+    }
+    const int shift = 8 * p;
+    for (int64_t i = 0; i < elements; i++) {
+      int d = (src_k[(size_t)i] >> shift) & 0xff;
+      dst_k[offset[d]] = src_k[(size_t)i];
+      dst_p[offset[d]] = src_p[(size_t)i];
+      offset[d]++;
+    }
+    std::swap(src_k, dst_k);
+    std::swap(src_p, dst_p);
+  }
+
+  for (int64_t i = 0; i < elements; i++) {
+    int64_t j = descending ? elements - 1 - i : i;
+    arr[j] = THTensor_(radixSortUnkey)(src_k[(size_t)i]);
+    idx[j] = src_p[(size_t)i];
+  }
+  return 1;
+}
+
+#endif /* radix-sortable types */
+
 void THTensor_(sort)(THTensor *rt_, THLongTensor *ri_, THTensor *t, int dimension, int descendingOrder)
 {
   dimension = at::maybe_wrap_dim(dimension, t);
@@ -380,7 +516,8 @@ void THTensor_(sort)(THTensor *rt_, THLongTensor *ri_, THTensor *t, int dimensio
                          int64_t i;
                          for(i = 0; i < ri__size; i++)
                            ri__data[i*ri__stride] = i;
-                         THTensor_(quicksortdescend)(rt__data, ri__data, rt__size, rt__stride);)
+                         if (!THTensor_(tryRadixSort)(rt__data, rt__stride, ri__data, ri__stride, rt__size, 1))
+                           THTensor_(quicksortdescend)(rt__data, ri__data, rt__size, rt__stride);)
       }
   else
   {
@@ -388,7 +525,8 @@ void THTensor_(sort)(THTensor *rt_, THLongTensor *ri_, THTensor *t, int dimensio
                          int64_t i;
                          for(i = 0; i < ri__size; i++)
                            ri__data[i*ri__stride] = i;
-                         THTensor_(quicksortascend)(rt__data, ri__data, rt__size, rt__stride);)
+                         if (!THTensor_(tryRadixSort)(rt__data, rt__stride, ri__data, ri__stride, rt__size, 0))
+                           THTensor_(quicksortascend)(rt__data, ri__data, rt__size, rt__stride);)
       }
 }
 
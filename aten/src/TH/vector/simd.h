@@ -107,6 +107,8 @@ static inline uint32_t detectHostSIMDExtensions()
 {
   using at::native::CPUCapability;
   switch (at::native::get_cpu_capability()) {
+  // TH kernels have no AVX512 flavor; an AVX512 host still runs their AVX2 code
+  case CPUCapability::AVX512:
   case CPUCapability::AVX2:
     return SIMDExtension_AVX2 | SIMDExtension_AVX | SIMDExtension_SSE;
   case CPUCapability::AVX:
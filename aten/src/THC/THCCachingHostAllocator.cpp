@@ -4,17 +4,68 @@
 
 
 #include <cuda_runtime_api.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <stdint.h>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
 #include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+//
+// The allocator is split into a fixed set of arenas, each with its own lock,
+// block cache and event queue. A thread is assigned an arena round-robin on
+// first use and allocates from it from then on; frees and recordEvent calls
+// are routed back to the owning arena through a small pointer->arena map.
+// Dataloader pin threads thus stop contending on one global mutex: the only
+// shared state is that map, which is held just long enough for a lookup.
+//
+// Completed events used to be reaped only inside malloc, so a block whose
+// streams had long finished stayed unavailable until the next allocation.
+// A lazily started background thread now drains the per-arena event queues
+// whenever events are outstanding; malloc still reaps opportunistically, so
+// correctness never depends on the reaper making progress.
+//
+// When PYTORCH_PINNED_ALLOC_HUGE_PAGES is set (Linux only), allocations of
+// 2MB and up are backed by an anonymous mapping with MADV_HUGEPAGE and
+// pinned with cudaHostRegister instead of cudaHostAlloc, reducing TLB misses
+// on the host side of H2D staging copies.
+//
 
 namespace {
 
+constexpr size_t kNumArenas = 8;
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// number of unreaped events across all arenas, used to park the reaper
+// thread when there is nothing to do
+std::atomic<int64_t> outstanding_events{0};
+
+bool use_huge_pages()
+{
+#ifdef __linux__
+  static bool enabled = []() {
+    const char* val = getenv("PYTORCH_PINNED_ALLOC_HUGE_PAGES");
+    return val != nullptr && strcmp(val, "0") != 0;
+  }();
+  return enabled;
+#else
+  return false;
+#endif
+}
+
 struct BlockSize
 {
   size_t  size; // allocation size
@@ -27,10 +78,12 @@ struct Block : public BlockSize
 {
   bool  allocated;    // true if the block is currently allocated
   int   event_count;  // number of outstanding cuda events
+  bool  huge_pages;   // true if backed by a registered huge-page mapping
   std::unordered_set<at::cuda::CUDAStream> streams;
 
-  Block(size_t size, void* ptr, bool allocated) :
-      BlockSize(size, ptr), allocated(allocated), event_count(0), streams() {}
+  Block(size_t size, void* ptr, bool allocated, bool huge_pages=false) :
+      BlockSize(size, ptr), allocated(allocated), event_count(0),
+      huge_pages(huge_pages), streams() {}
 };
 
 static bool BlockComparator(const BlockSize& a, const BlockSize& b)
@@ -42,11 +95,11 @@ static bool BlockComparator(const BlockSize& a, const BlockSize& b)
   return (uintptr_t)a.ptr < (uintptr_t)b.ptr;
 }
 
-struct HostAllocator
+struct Arena
 {
   typedef bool (*Comparison)(const BlockSize&, const BlockSize&);
 
-  // lock around all operations
+  // lock around all operations on this arena
   std::mutex mutex;
 
   // blocks by pointer
@@ -58,7 +111,7 @@ struct HostAllocator
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, void*>> cuda_events;
 
-  HostAllocator() : available(BlockComparator) {}
+  Arena() : available(BlockComparator) {}
 
   cudaError_t malloc(void** ptr, size_t size)
   {
@@ -93,6 +146,33 @@ struct HostAllocator
       device_guard.reset_device(at::Device(at::DeviceType::CUDA, *primary_ctx_device_index));
     }
 
+#ifdef __linux__
+    if (use_huge_pages() && size >= kHugePageSize) {
+      size_t rounded = kHugePageSize * ((size + kHugePageSize - 1) / kHugePageSize);
+      void* mem = mmap(
+          nullptr,
+          rounded,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+      if (mem != MAP_FAILED) {
+        // Ask for transparent huge pages; registration pins whatever the
+        // kernel actually provides, so this failing is not fatal.
+        madvise(mem, rounded, MADV_HUGEPAGE);
+        err = cudaHostRegister(mem, rounded, cudaHostRegisterDefault);
+        if (err == cudaSuccess) {
+          *ptr = mem;
+          blocks.insert({mem, Block(rounded, mem, true, /*huge_pages=*/true)});
+          return cudaSuccess;
+        }
+        // fall back to cudaHostAlloc below
+        cudaGetLastError();
+        munmap(mem, rounded);
+      }
+    }
+#endif
+
     // note that cudaHostAlloc may not touch pointer if size is 0
     *ptr = 0;
 
@@ -110,16 +190,6 @@ struct HostAllocator
   {
     std::lock_guard<std::mutex> lock(mutex);
 
-    if (!ptr) {
-      return cudaSuccess;
-    }
-
-    // process outstanding cuda events which may have occurred
-    cudaError_t err = processEvents();
-    if (err != cudaSuccess) {
-      return err;
-    }
-
     auto it = blocks.find(ptr);
     THAssert(it != blocks.end());
 
@@ -131,7 +201,7 @@ struct HostAllocator
     block.allocated = false;
 
     // insert CUDA events for each stream on which this block was used. This
-    err = insertEvents(block);
+    cudaError_t err = insertEvents(block);
     if (err != cudaSuccess) {
       return err;
     }
@@ -143,21 +213,16 @@ struct HostAllocator
     return cudaSuccess;
   }
 
-  cudaError_t recordEvent(void* ptr, at::cuda::CUDAStream stream)
+  void addStream(void* ptr, at::cuda::CUDAStream stream)
   {
     std::lock_guard<std::mutex> lock(mutex);
 
     auto it = blocks.find(ptr);
-    if (it == blocks.end()) {
-      // ignore events for untracked pointers
-      return cudaSuccess;
-    }
+    THAssert(it != blocks.end());
 
     Block& block = it->second;
     THAssert(block.allocated);
-
     block.streams.insert(stream);
-    return cudaSuccess;
   }
 
   cudaError_t processEvents()
@@ -188,11 +253,24 @@ struct HostAllocator
         available.insert(block);
       }
       cuda_events.pop_front();
+      outstanding_events--;
     }
     return cudaSuccess;
   }
 
-  void emptyCache()
+  void reapEvents()
+  {
+    // Background variant of processEvents: errors cannot be surfaced to a
+    // caller here, so they are cleared and the queue is retried on the next
+    // pass (or by the next malloc on this arena).
+    std::lock_guard<std::mutex> lock(mutex);
+    if (processEvents() != cudaSuccess) {
+      cudaGetLastError();
+    }
+  }
+
+  // Frees all unallocated blocks, appending their pointers to `freed`.
+  void emptyCache(std::vector<void*>& freed)
   {
     std::lock_guard<std::mutex> lock(mutex);
 
@@ -204,6 +282,7 @@ struct HostAllocator
         THCudaCheckWarn(cudaEventDestroy(event));
         block.event_count--;
       }
+      outstanding_events--;
     }
 
     // all cuda_events have been processed
@@ -216,7 +295,15 @@ struct HostAllocator
     for (auto it = blocks.begin(); it != blocks.end();) {
       Block& block = it->second;
       if (!block.allocated) {
-        THCudaCheckWarn(cudaFreeHost(block.ptr));
+        if (block.huge_pages) {
+          THCudaCheckWarn(cudaHostUnregister(block.ptr));
+#ifdef __linux__
+          munmap(block.ptr, block.size);
+#endif
+        } else {
+          THCudaCheckWarn(cudaFreeHost(block.ptr));
+        }
+        freed.push_back(block.ptr);
         it = blocks.erase(it);
       } else {
         ++it;
@@ -246,6 +333,7 @@ struct HostAllocator
 
       block.event_count++;
       cuda_events.emplace_back(event, block.ptr);
+      outstanding_events++;
     }
 
     cudaSetDevice(prev_device);
@@ -253,6 +341,116 @@ struct HostAllocator
   }
 };
 
+struct HostAllocator
+{
+  Arena arenas[kNumArenas];
+
+  // owning arena by pointer, so frees and event recordings issued from any
+  // thread find their way back to the arena that allocated the block
+  std::mutex arena_map_mutex;
+  std::unordered_map<void*, Arena*> arena_of;
+
+  std::once_flag reaper_started;
+  std::mutex reaper_mutex;
+  std::condition_variable reaper_cv;
+
+  Arena& arenaForThisThread()
+  {
+    static std::atomic<size_t> next_arena{0};
+    thread_local size_t index = next_arena++ % kNumArenas;
+    return arenas[index];
+  }
+
+  Arena* arenaFor(void* ptr)
+  {
+    std::lock_guard<std::mutex> lock(arena_map_mutex);
+    auto it = arena_of.find(ptr);
+    return it == arena_of.end() ? nullptr : it->second;
+  }
+
+  cudaError_t malloc(void** ptr, size_t size)
+  {
+    Arena& arena = arenaForThisThread();
+    cudaError_t err = arena.malloc(ptr, size);
+    if (err == cudaSuccess) {
+      std::lock_guard<std::mutex> lock(arena_map_mutex);
+      arena_of[*ptr] = &arena;
+    }
+    return err;
+  }
+
+  cudaError_t free(void* ptr)
+  {
+    if (!ptr) {
+      return cudaSuccess;
+    }
+
+    Arena* arena = arenaFor(ptr);
+    THAssert(arena != nullptr);
+    cudaError_t err = arena->free(ptr);
+    if (err == cudaSuccess) {
+      // Freeing a multi-stream block queues events for the reaper. Taking
+      // (and immediately dropping) the reaper mutex before notifying makes
+      // sure a reaper that just found the queues empty cannot miss the
+      // notification.
+      startReaperOnce();
+      { std::lock_guard<std::mutex> lock(reaper_mutex); }
+      reaper_cv.notify_one();
+    }
+    return err;
+  }
+
+  cudaError_t recordEvent(void* ptr, at::cuda::CUDAStream stream)
+  {
+    Arena* arena = arenaFor(ptr);
+    if (arena == nullptr) {
+      // ignore events for untracked pointers
+      return cudaSuccess;
+    }
+    arena->addStream(ptr, stream);
+    return cudaSuccess;
+  }
+
+  void emptyCache()
+  {
+    std::vector<void*> freed;
+    for (auto& arena : arenas) {
+      arena.emptyCache(freed);
+    }
+    std::lock_guard<std::mutex> lock(arena_map_mutex);
+    for (void* ptr : freed) {
+      arena_of.erase(ptr);
+    }
+  }
+
+  void startReaperOnce()
+  {
+    std::call_once(reaper_started, [this] {
+      // The reaper is a daemon: it is never joined, as the process may exit
+      // with the thread parked and joining from a static destructor would
+      // deadlock. Blocks are still reclaimed without it via the
+      // opportunistic processEvents in malloc.
+      std::thread([this] { reaperLoop(); }).detach();
+    });
+  }
+
+  void reaperLoop()
+  {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(reaper_mutex);
+        reaper_cv.wait(lock, [] { return outstanding_events.load() > 0; });
+      }
+      while (outstanding_events.load() > 0) {
+        for (auto& arena : arenas) {
+          arena.reapEvents();
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+  }
+};
+
 }  // namespace
 
 static HostAllocator allocator;
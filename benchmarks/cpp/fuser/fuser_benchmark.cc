@@ -0,0 +1,223 @@
+// Regression harness for the JIT fusers, built on the cells from
+// benchmarks/fastrnns but driven entirely from C++: the cells are compiled
+// with torch::jit::compile and executed through GraphExecutor with the
+// profiling executor, so the numbers reflect the profiled-and-optimized
+// plan without the GIL or Python binding overhead in the loop.
+//
+// Every cell runs in two configurations, fused=1 (CPU fusion and the
+// tensorexpr fuser enabled) and fused=0 (both disabled), so a before/after
+// pair of runs gives per-cell fused vs unfused deltas. The number of fusion
+// groups in the executed plan is reported as a counter; a drop to zero means
+// the fuser stopped taking the subgraph, which is itself a regression even
+// if the timing noise hides it.
+//
+// See the README in this directory for producing and diffing baseline JSON.
+
+#include "benchmark/benchmark.h"
+
+#include <torch/csrc/jit/codegen/fuser/interface.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
+#include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/jit.h>
+#include <torch/torch.h>
+
+namespace {
+
+// fastrnns default problem size (miniBatch / inputSize / hiddenSize).
+constexpr int64_t kBatch = 64;
+constexpr int64_t kInputSize = 512;
+constexpr int64_t kHiddenSize = 512;
+
+// Mirrors benchmarks/fastrnns/cells.py:flat_lstm_cell.
+const char* kLSTMCellSource = R"JIT(
+def cell(input, hx, cx, w_ih, w_hh, b_ih, b_hh):
+    # type: (Tensor, Tensor, Tensor, Tensor, Tensor, Tensor, Tensor) -> Tuple[Tensor, Tensor]
+    gates = torch.mm(input, w_ih.t()) + torch.mm(hx, w_hh.t()) + b_ih + b_hh
+    ingate, forgetgate, cellgate, outgate = gates.chunk(4, 1)
+    ingate = torch.sigmoid(ingate)
+    forgetgate = torch.sigmoid(forgetgate)
+    cellgate = torch.tanh(cellgate)
+    outgate = torch.sigmoid(outgate)
+    cy = (forgetgate * cx) + (ingate * cellgate)
+    hy = outgate * torch.tanh(cy)
+    return hy, cy
+)JIT";
+
+// Mirrors benchmarks/fastrnns/cells.py:milstm_cell; the multiplicative
+// integration adds a longer pointwise chain between the matmuls.
+const char* kMILSTMCellSource = R"JIT(
+def cell(x, hx, cx, w_ih, w_hh, alpha, beta_i, beta_h, bias):
+    # type: (Tensor, Tensor, Tensor, Tensor, Tensor, Tensor, Tensor, Tensor, Tensor) -> Tuple[Tensor, Tensor]
+    Wx = x.mm(w_ih.t())
+    Uz = hx.mm(w_hh.t())
+    gates = alpha * Wx * Uz + beta_i * Wx + beta_h * Uz + bias
+    ingate, forgetgate, cellgate, outgate = gates.chunk(4, 1)
+    ingate = ingate.sigmoid()
+    forgetgate = forgetgate.sigmoid()
+    cellgate = cellgate.tanh()
+    outgate = outgate.sigmoid()
+    cy = (forgetgate * cx) + (ingate * cellgate)
+    hy = outgate * cy.tanh()
+    return hy, cy
+)JIT";
+
+// Transformer feed-forward block with an erf-based gelu spelled out as
+// pointwise ops, the shape the fuser sees after decomposition.
+const char* kTransformerFFNSource = R"JIT(
+def cell(x, w1, b1, w2, b2):
+    # type: (Tensor, Tensor, Tensor, Tensor, Tensor) -> Tensor
+    h = torch.addmm(b1, x, w1.t())
+    h = h * 0.5 * (1.0 + torch.erf(h * 0.70710678))
+    return torch.addmm(b2, h, w2.t())
+)JIT";
+
+// Forces the profiling executor so the steady-state plan is the profiled
+// and optimized one, and toggles CPU fusion plus the tensorexpr fuser for
+// the fused/unfused comparison. Restores the executor flags on destruction
+// so one grid point does not leak state into the next.
+struct FuserConfigGuard {
+  explicit FuserConfigGuard(bool fused)
+      : old_executor_(torch::jit::getExecutorMode().exchange(true)),
+        old_profiling_(torch::jit::getProfilingMode().exchange(true)),
+        old_cpu_fusion_(torch::jit::canFuseOnCPU()) {
+    torch::jit::overrideCanFuseOnCPU(fused);
+    torch::jit::setTensorExprFuserEnabled(fused);
+  }
+
+  ~FuserConfigGuard() {
+    torch::jit::getExecutorMode().store(old_executor_);
+    torch::jit::getProfilingMode().store(old_profiling_);
+    torch::jit::overrideCanFuseOnCPU(old_cpu_fusion_);
+    // The tensorexpr fuser has no getter; off is its default.
+    torch::jit::setTensorExprFuserEnabled(false);
+  }
+
+ private:
+  bool old_executor_;
+  bool old_profiling_;
+  bool old_cpu_fusion_;
+};
+
+// Counts fusion groups (legacy and tensorexpr) in the plan that the last
+// call actually executed. Recurses into nested blocks because the
+// profiling executor may leave groups behind bailout guards.
+int64_t countFusionGroups(torch::jit::Block* block) {
+  int64_t count = 0;
+  for (auto* node : block->nodes()) {
+    if (node->kind() == torch::jit::prim::FusionGroup ||
+        node->kind() ==
+            torch::jit::Symbol::fromQualString("tensorexpr::Group")) {
+      count++;
+    }
+    for (auto* subblock : node->blocks()) {
+      count += countFusionGroups(subblock);
+    }
+  }
+  return count;
+}
+
+int64_t countFusionGroups() {
+  auto graph = torch::jit::lastExecutedOptimizedGraph();
+  if (!graph) {
+    return 0;
+  }
+  return countFusionGroups(graph->block());
+}
+
+void runCell(
+    torch::jit::CompilationUnit& cu,
+    const std::vector<torch::jit::IValue>& inputs) {
+  auto stack = inputs;
+  cu.get_function("cell")(std::move(stack));
+}
+
+void benchmarkCell(
+    benchmark::State& state,
+    const char* source,
+    const std::vector<torch::jit::IValue>& inputs) {
+  const bool fused = state.range(0);
+  FuserConfigGuard guard(fused);
+  torch::NoGradGuard no_grad;
+
+  // Each configuration compiles from scratch so no specialized plan is
+  // shared between the fused and unfused runs.
+  auto cu = torch::jit::compile(source);
+
+  // Run past the profiling phase so the loop below measures the optimized
+  // plan, not instrumented profiling runs or compilation.
+  const size_t warmup = torch::jit::getNumProfiledRuns() + 2;
+  for (size_t i = 0; i < warmup; ++i) {
+    runCell(*cu, inputs);
+  }
+
+  for (auto _ : state) {
+    runCell(*cu, inputs);
+  }
+
+  state.counters["fusion_groups"] =
+      static_cast<double>(countFusionGroups());
+}
+
+std::vector<torch::jit::IValue> lstmInputs() {
+  return {
+      torch::randn({kBatch, kInputSize}),
+      torch::randn({kBatch, kHiddenSize}),
+      torch::randn({kBatch, kHiddenSize}),
+      torch::randn({4 * kHiddenSize, kInputSize}),
+      torch::randn({4 * kHiddenSize, kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+  };
+}
+
+std::vector<torch::jit::IValue> milstmInputs() {
+  return {
+      torch::randn({kBatch, kInputSize}),
+      torch::randn({kBatch, kHiddenSize}),
+      torch::randn({kBatch, kHiddenSize}),
+      torch::randn({4 * kHiddenSize, kInputSize}),
+      torch::randn({4 * kHiddenSize, kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+  };
+}
+
+std::vector<torch::jit::IValue> ffnInputs() {
+  return {
+      torch::randn({kBatch, kHiddenSize}),
+      torch::randn({4 * kHiddenSize, kHiddenSize}),
+      torch::randn({4 * kHiddenSize}),
+      torch::randn({kHiddenSize, 4 * kHiddenSize}),
+      torch::randn({kHiddenSize}),
+  };
+}
+
+void BM_LSTMCell(benchmark::State& state) {
+  benchmarkCell(state, kLSTMCellSource, lstmInputs());
+}
+
+void BM_MILSTMCell(benchmark::State& state) {
+  benchmarkCell(state, kMILSTMCellSource, milstmInputs());
+}
+
+void BM_TransformerFFN(benchmark::State& state) {
+  benchmarkCell(state, kTransformerFFNSource, ffnInputs());
+}
+
+void FusedArg(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"fused"});
+  b->Arg(0);
+  b->Arg(1);
+  b->UseRealTime();
+}
+
+BENCHMARK(BM_LSTMCell)->Apply(FusedArg);
+BENCHMARK(BM_MILSTMCell)->Apply(FusedArg);
+BENCHMARK(BM_TransformerFFN)->Apply(FusedArg);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+"""Diff two Google Benchmark JSON outputs and flag kernel regressions.
+
+Usage:
+    tensor_iterator_benchmark --benchmark_out=baseline.json \\
+        --benchmark_out_format=json
+    # ... rebuild with the change under test ...
+    tensor_iterator_benchmark --benchmark_out=candidate.json \\
+        --benchmark_out_format=json
+    python compare_with_baseline.py baseline.json candidate.json
+
+Exits non-zero if any benchmark slowed down by more than --threshold
+(default 10%), so this can gate CI jobs or release branches.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load_benchmarks(path):
+    with open(path) as f:
+        report = json.load(f)
+    times = {}
+    for bench in report["benchmarks"]:
+        # skip aggregate rows (mean/median/stddev) from --benchmark_repetitions
+        if bench.get("run_type", "iteration") != "iteration":
+            continue
+        times[bench["name"]] = float(bench["real_time"])
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="baseline benchmark JSON")
+    parser.add_argument("candidate", help="candidate benchmark JSON")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="relative slowdown treated as a regression (default: 0.10)",
+    )
+    args = parser.parse_args()
+
+    baseline = load_benchmarks(args.baseline)
+    candidate = load_benchmarks(args.candidate)
+
+    regressions = []
+    common = sorted(set(baseline) & set(candidate))
+    if not common:
+        print("no common benchmarks between the two reports", file=sys.stderr)
+        return 1
+
+    name_width = max(len(name) for name in common)
+    print("{:<{w}} {:>12} {:>12} {:>8}".format(
+        "benchmark", "baseline", "candidate", "delta", w=name_width))
+    for name in common:
+        base = baseline[name]
+        cand = candidate[name]
+        delta = (cand - base) / base
+        print("{:<{w}} {:>12.1f} {:>12.1f} {:>7.1%}".format(
+            name, base, cand, delta, w=name_width))
+        if delta > args.threshold:
+            regressions.append((name, delta))
+
+    for name in sorted(set(baseline) ^ set(candidate)):
+        which = "baseline" if name in baseline else "candidate"
+        print("only in {}: {}".format(which, name), file=sys.stderr)
+
+    if regressions:
+        print("\n{} regression(s) above {:.0%}:".format(
+            len(regressions), args.threshold), file=sys.stderr)
+        for name, delta in regressions:
+            print("  {} ({:+.1%})".format(name, delta), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
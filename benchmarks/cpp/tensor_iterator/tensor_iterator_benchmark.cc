@@ -0,0 +1,157 @@
+// Microbenchmarks for TensorIterator-based CPU kernels (the Loops.h/Reduce.h
+// kernels under aten/src/ATen/native/cpu), called through the ATen C++ API so
+// no Python binding overhead dilutes kernel-level regressions.
+//
+// Each benchmark runs over a grid of shape (L1/L2/RAM working sets), dtype
+// (float/double) and input contiguity (contiguous vs. every-other-column
+// slices). Outputs are preallocated so the steady-state loop measures the
+// kernel, not the allocator.
+//
+// See the README in this directory for producing and diffing baseline JSON.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+
+namespace {
+
+// Roughly L1-resident, L2-resident and memory-bound working sets.
+const std::vector<std::vector<int64_t>> kShapes = {
+    {64, 64},
+    {512, 512},
+    {4096, 4096},
+};
+
+const std::vector<at::ScalarType> kDtypes = {
+    at::kFloat,
+    at::kDouble,
+};
+
+at::Tensor make_arg(
+    const std::vector<int64_t>& shape,
+    at::ScalarType dtype,
+    bool contiguous) {
+  auto options = at::TensorOptions().dtype(dtype);
+  if (contiguous) {
+    return at::randn(shape, options);
+  }
+  // Same logical shape, but strided: allocate twice the row width and view
+  // every other column, which knocks the kernel off its vectorized fast path.
+  auto wide = shape;
+  wide.back() *= 2;
+  return at::randn(wide, options).slice(-1, 0, wide.back(), 2);
+}
+
+void GridArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"shape", "dtype", "contig"});
+  for (size_t shape = 0; shape < kShapes.size(); ++shape) {
+    for (size_t dtype = 0; dtype < kDtypes.size(); ++dtype) {
+      for (int64_t contig = 0; contig <= 1; ++contig) {
+        b->Args({static_cast<int64_t>(shape),
+                 static_cast<int64_t>(dtype),
+                 contig});
+      }
+    }
+  }
+}
+
+struct Grid {
+  explicit Grid(const benchmark::State& state)
+      : shape(kShapes[state.range(0)]),
+        dtype(kDtypes[state.range(1)]),
+        contiguous(state.range(2) != 0) {}
+
+  std::vector<int64_t> shape;
+  at::ScalarType dtype;
+  bool contiguous;
+};
+
+// Binary elementwise (Loops.h binary kernel).
+void BM_Add(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto b = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty(grid.shape, a.options());
+  while (state.KeepRunning()) {
+    at::add_out(out, a, b);
+  }
+  state.SetItemsProcessed(state.iterations() * out.numel());
+}
+BENCHMARK(BM_Add)->Apply(GridArgs);
+
+void BM_Mul(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto b = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty(grid.shape, a.options());
+  while (state.KeepRunning()) {
+    at::mul_out(out, a, b);
+  }
+  state.SetItemsProcessed(state.iterations() * out.numel());
+}
+BENCHMARK(BM_Mul)->Apply(GridArgs);
+
+// Unary elementwise (Loops.h unary kernel with a Vec256 body).
+void BM_Exp(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty(grid.shape, a.options());
+  while (state.KeepRunning()) {
+    at::exp_out(out, a);
+  }
+  state.SetItemsProcessed(state.iterations() * out.numel());
+}
+BENCHMARK(BM_Exp)->Apply(GridArgs);
+
+void BM_Sigmoid(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty(grid.shape, a.options());
+  while (state.KeepRunning()) {
+    at::sigmoid_out(out, a);
+  }
+  state.SetItemsProcessed(state.iterations() * out.numel());
+}
+BENCHMARK(BM_Sigmoid)->Apply(GridArgs);
+
+// Full reduction (Reduce.h).
+void BM_Sum(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty({}, a.options());
+  std::vector<int64_t> dims{0, 1};
+  while (state.KeepRunning()) {
+    at::sum_out(out, a, dims);
+  }
+  state.SetItemsProcessed(state.iterations() * a.numel());
+}
+BENCHMARK(BM_Sum)->Apply(GridArgs);
+
+// Row reduction (Reduce.h, non-trivial output stride pattern).
+void BM_SumDim(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty({grid.shape[0]}, a.options());
+  std::vector<int64_t> dims{1};
+  while (state.KeepRunning()) {
+    at::sum_out(out, a, dims);
+  }
+  state.SetItemsProcessed(state.iterations() * a.numel());
+}
+BENCHMARK(BM_SumDim)->Apply(GridArgs);
+
+// copy_stub; for contig == 0 this is a strided-to-contiguous gather.
+void BM_Copy(benchmark::State& state) {
+  Grid grid(state);
+  auto a = make_arg(grid.shape, grid.dtype, grid.contiguous);
+  auto out = at::empty(grid.shape, a.options());
+  while (state.KeepRunning()) {
+    out.copy_(a);
+  }
+  state.SetItemsProcessed(state.iterations() * out.numel());
+}
+BENCHMARK(BM_Copy)->Apply(GridArgs);
+
+} // namespace
+
+BENCHMARK_MAIN();
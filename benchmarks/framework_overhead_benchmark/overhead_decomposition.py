@@ -0,0 +1,158 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import time
+
+import torch
+
+from utils import secs_to_us
+
+""" Per-layer framework overhead budget for a single eager op.
+
+The other scripts in this directory time scenarios end to end; this one
+decomposes one torch.add call into the layers it passes through, by timing
+a ladder of call forms and subtracting:
+
+  full          torch.add on requires_grad inputs: Python binding, dispatcher,
+                VariableType + autograd node creation, TensorIterator setup,
+                output allocation, kernel.
+  no_grad       same call on plain inputs; full - no_grad = autograd layer.
+  out=          preallocated output; no_grad - out= = output allocation.
+  scripted      the same op in a scripted loop, so each call enters the
+                dispatcher from the interpreter instead of through the Python
+                binding; no_grad - scripted = Python binding layer (minus the
+                interpreter's own small per-op cost, which it underestimates).
+  kernel        the size-dependent part: out= time at this size minus out=
+                time at the smallest size. The remainder of the out= time is
+                the fixed dispatcher + TensorIterator-setup floor, reported
+                with the binding estimate subtracted.
+
+All numbers are per call in microseconds, reported across tensor sizes so
+a release-over-release diff answers "where did the extra microsecond go"
+per layer instead of per scenario.
+
+Example:
+python overhead_decomposition.py --num_iters 10000
+"""
+
+SHAPES = [
+    (1,),
+    (64, 64),
+    (512, 512),
+    (4096, 4096),
+]
+
+
+def time_per_call_us(fn, num_warmup_iters, num_iters):
+    for _ in range(num_warmup_iters):
+        fn()
+    start = time.time()
+    for _ in range(num_iters):
+        fn()
+    end = time.time()
+    return secs_to_us(end - start) / num_iters
+
+
+@torch.jit.script
+def _scripted_add_loop(x, y, n: int):
+    z = torch.add(x, y)
+    for _ in range(n):
+        z = torch.add(x, y)
+    return z
+
+
+def scripted_time_per_call_us(x, y, num_warmup_iters, num_iters):
+    # One interpreter entry per batch of calls; the Python binding is paid
+    # once for the loop instead of once per op.
+    _scripted_add_loop(x, y, num_warmup_iters)
+    start = time.time()
+    _scripted_add_loop(x, y, num_iters)
+    end = time.time()
+    return secs_to_us(end - start) / (num_iters + 1)
+
+
+def measure_shape(shape, num_warmup_iters, num_iters):
+    x = torch.randn(shape)
+    y = torch.randn(shape)
+    x_rg = torch.randn(shape, requires_grad=True)
+    out = torch.empty(shape)
+
+    t_full = time_per_call_us(lambda: torch.add(x_rg, y), num_warmup_iters, num_iters)
+    t_nograd = time_per_call_us(lambda: torch.add(x, y), num_warmup_iters, num_iters)
+    t_out = time_per_call_us(lambda: torch.add(x, y, out=out), num_warmup_iters, num_iters)
+    t_scripted = scripted_time_per_call_us(x, y, num_warmup_iters, num_iters)
+
+    return {
+        "full": t_full,
+        "no_grad": t_nograd,
+        "out": t_out,
+        "scripted": t_scripted,
+    }
+
+
+def decompose(raw, floor_out_time):
+    autograd = max(raw["full"] - raw["no_grad"], 0.0)
+    allocation = max(raw["no_grad"] - raw["out"], 0.0)
+    binding = max(raw["no_grad"] - raw["scripted"], 0.0)
+    kernel = max(raw["out"] - floor_out_time, 0.0)
+    # What is left of the out= call after removing the size-dependent kernel
+    # part and the binding estimate: dispatcher + TensorIterator setup (plus
+    # the one-element kernel, which is noise at this resolution).
+    dispatch_and_iter = max(raw["out"] - kernel - binding, 0.0)
+    return {
+        "full": raw["full"],
+        "python_binding": binding,
+        "autograd_node": autograd,
+        "dispatch+iter_setup": dispatch_and_iter,
+        "output_alloc": allocation,
+        "kernel_delta": kernel,
+    }
+
+
+LAYER_COLUMNS = [
+    "full",
+    "python_binding",
+    "autograd_node",
+    "dispatch+iter_setup",
+    "output_alloc",
+    "kernel_delta",
+]
+
+
+def print_table(results):
+    header = "{:<12}".format("shape") + "".join(
+        "{:>20}".format(col + " (us)") for col in LAYER_COLUMNS)
+    print("=" * len(header))
+    print(header)
+    print("-" * len(header))
+    for shape, layers in results:
+        row = "{:<12}".format("x".join(str(d) for d in shape)) + "".join(
+            "{:>20.3f}".format(layers[col]) for col in LAYER_COLUMNS)
+        print(row)
+    print("=" * len(header))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num_warmup_iters", type=int, default=1000)
+    parser.add_argument("--num_iters", type=int, default=10000)
+    args = parser.parse_args()
+
+    torch.set_num_threads(1)
+
+    raw_by_shape = [
+        (shape, measure_shape(shape, args.num_warmup_iters, args.num_iters))
+        for shape in SHAPES
+    ]
+    # The smallest shape's out= time is the fixed framework floor; larger
+    # shapes' excess over it is attributed to the kernel.
+    floor_out_time = raw_by_shape[0][1]["out"]
+
+    results = [
+        (shape, decompose(raw, floor_out_time)) for shape, raw in raw_by_shape
+    ]
+    print_table(results)
+
+
+if __name__ == "__main__":
+    main()
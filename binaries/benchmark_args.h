@@ -68,6 +68,13 @@ C10_DEFINE_string(
     "",
     "The folder that the output should be written to. This "
     "folder must already exist in the file system.");
+C10_DEFINE_bool(
+    report_hw_counters,
+    false,
+    "Whether to collect hardware performance counters (cycles, "
+    "instructions, LLC and dTLB misses) per main-run iteration via "
+    "perf_event and report derived metrics such as IPC. Linux only; "
+    "silently degrades when perf_event is unavailable.");
 C10_DEFINE_bool(
     run_individual,
     false,
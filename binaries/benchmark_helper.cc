@@ -24,6 +24,7 @@
 #endif
 
 #include <binaries/benchmark_helper.h>
+#include <binaries/perf_counters.h>
 #include "caffe2/core/blob_serialization.h"
 #ifdef __CUDA_ARCH__
 #include "caffe2/core/context_gpu.h"
@@ -246,6 +247,7 @@ void runNetwork(
     map<string, caffe2::TensorProtos>& tensor_protos_map,
     const bool wipe_cache,
     const bool run_individual,
+    const bool report_hw_counters,
     const bool run_on_gpu,
     const bool text_output,
     const int warmup,
@@ -258,6 +260,12 @@ void runNetwork(
     const std::string& output_folder) {
 
   LOG(INFO) << "Starting benchmark.";
+  // Opened before the warmup runs so that worker threads spawned during
+  // warmup inherit the counters.
+  std::unique_ptr<benchmark::PerfCounters> perf_counters;
+  if (report_hw_counters) {
+    perf_counters = std::make_unique<benchmark::PerfCounters>();
+  }
   caffe2::ObserverConfig::initSampleRate(1, 1, 1, run_individual, warmup);
   LOG(INFO) << "Running warmup runs.";
   for (int i = 0; i < warmup; ++i) {
@@ -284,7 +292,13 @@ void runNetwork(
     if (wipe_cache) {
       caffe2::wipe_cache();
     }
+    if (perf_counters) {
+      perf_counters->start();
+    }
     CAFFE_ENFORCE(net->Run(), "Main run ", i, " has failed.");
+    if (perf_counters) {
+      perf_counters->stop();
+    }
     // Write the output for the first num_blobs times
     writeOutput(
         workspace,
@@ -302,6 +316,9 @@ void runNetwork(
           std::chrono::seconds(sleep_between_iteration));
     }
   }
+  if (perf_counters) {
+    perf_counters->report(iter);
+  }
   if (run_individual) {
     LOG(INFO) << "operator runs.";
     if (sleep_between_net_and_operator > 0) {
@@ -424,6 +441,7 @@ int benchmark(
     const string& FLAGS_net,
     const string& FLAGS_output,
     const string& FLAGS_output_folder,
+    bool FLAGS_report_hw_counters,
     bool FLAGS_run_individual,
     int FLAGS_sleep_before_run,
     int FLAGS_sleep_between_iteration,
@@ -492,6 +510,7 @@ int benchmark(
       tensor_protos_map,
       FLAGS_wipe_cache,
       FLAGS_run_individual,
+      FLAGS_report_hw_counters,
       run_on_gpu,
       FLAGS_text_output,
       FLAGS_warmup,
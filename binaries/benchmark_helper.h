@@ -135,6 +135,7 @@ void runNetwork(
     map<string, caffe2::TensorProtos>& tensor_protos_map,
     const bool wipe_cache,
     const bool run_individual,
+    const bool report_hw_counters,
     const bool run_on_gpu,
     const bool text_output,
     const int warmup,
@@ -159,6 +160,7 @@ int benchmark(
     const string& FLAGS_net,
     const string& FLAGS_output,
     const string& FLAGS_output_folder,
+    bool FLAGS_report_hw_counters,
     bool FLAGS_run_individual,
     int FLAGS_sleep_before_run,
     int FLAGS_sleep_between_iteration,
@@ -22,6 +22,7 @@ int main(int argc, char** argv) {
       FLAGS_net,
       FLAGS_output,
       FLAGS_output_folder,
+      FLAGS_report_hw_counters,
       FLAGS_run_individual,
       FLAGS_sleep_before_run,
       FLAGS_sleep_between_iteration,
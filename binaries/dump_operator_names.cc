@@ -15,6 +15,7 @@
  */
 
 #include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/mobile/import.h>
 #include <torch/csrc/jit/mobile/module.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/runtime/instruction.h>
@@ -53,6 +54,13 @@ void dump_opnames(const Module& m, std::unordered_set<std::string>& opnames) {
 
 C10_DEFINE_string(model, "", "The given torch script model.");
 C10_DEFINE_string(output, "", "The output yaml file of operator list.");
+C10_DEFINE_bool(
+    bytecode,
+    false,
+    "Read the operator list from the model's mobile bytecode archive "
+    "instead of the TorchScript code. This is the list the shipped mobile "
+    "interpreter will execute and works even when this build does not "
+    "contain the listed kernels.");
 
 int main(int argc, char** argv) {
   c10::SetUsageMessage(
@@ -70,14 +78,21 @@ int main(int argc, char** argv) {
   CAFFE_ENFORCE_GE(FLAGS_model.size(), 0, "Model file must be specified.");
   CAFFE_ENFORCE_GE(FLAGS_output.size(), 0, "Output yaml file must be specified.");
 
-  auto m = torch::jit::load(FLAGS_model);
-  std::unordered_set<std::string> opnames;
-  torch::jit::dump_opnames(m, opnames);
   std::ofstream ofile(FLAGS_output);
   std::cout << "-- Final List --" << std::endl;
-  for (const auto& name : opnames) {
-    std::cout << name << std::endl;
-    ofile << "- " << name << std::endl;
+  if (FLAGS_bytecode) {
+    for (const auto& name : torch::jit::_export_operator_list(FLAGS_model)) {
+      std::cout << name << std::endl;
+      ofile << "- " << name << std::endl;
+    }
+  } else {
+    auto m = torch::jit::load(FLAGS_model);
+    std::unordered_set<std::string> opnames;
+    torch::jit::dump_opnames(m, opnames);
+    for (const auto& name : opnames) {
+      std::cout << name << std::endl;
+      ofile << "- " << name << std::endl;
+    }
   }
   ofile.close();
 }
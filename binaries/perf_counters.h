@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "caffe2/core/logging.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace benchmark {
+
+#if defined(__linux__)
+
+// Collects hardware event counts (cycles, instructions, LLC traffic, dTLB
+// misses) around a measured region via perf_event_open, so a cache- or
+// TLB-hostile regression shows up directly in the benchmark output instead
+// of requiring a separate run under perf.
+//
+// Counters are opened with inherit set, so pool threads spawned after
+// construction are included; construct the collector before the warmup runs.
+// Collection degrades to a no-op with a single warning when perf_event_open
+// is unavailable (e.g. kernel.perf_event_paranoid, seccomp in containers),
+// and events unsupported by the CPU are skipped individually.
+class PerfCounters {
+ public:
+  PerfCounters() {
+    addCounter("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    addCounter(
+        "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    addCounter(
+        "LLC_references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+    addCounter("LLC_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    addCounter(
+        "dTLB_load_misses",
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  }
+
+  ~PerfCounters() {
+    for (const auto& counter : counters_) {
+      close(counter.fd);
+    }
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool enabled() const {
+    return !counters_.empty();
+  }
+
+  void start() {
+    for (const auto& counter : counters_) {
+      ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    start_time_ = std::chrono::steady_clock::now();
+  }
+
+  void stop() {
+    elapsed_seconds_ += std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start_time_)
+                            .count();
+    for (auto& counter : counters_) {
+      ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+      // value, time_enabled, time_running; scale the count when the kernel
+      // had to multiplex this event onto the PMU.
+      uint64_t data[3] = {0, 0, 0};
+      if (read(counter.fd, data, sizeof(data)) ==
+          static_cast<ssize_t>(sizeof(data))) {
+        double scale = data[2] > 0
+            ? static_cast<double>(data[1]) / static_cast<double>(data[2])
+            : 1.0;
+        counter.total += static_cast<uint64_t>(data[0] * scale);
+      }
+    }
+  }
+
+  // Log per-iteration averages and derived metrics. DRAM traffic is
+  // estimated as one cache line per LLC miss; uncore bandwidth counters
+  // are not reachable through unprivileged per-thread perf events.
+  void report(int iterations) const {
+    if (!enabled() || iterations <= 0) {
+      return;
+    }
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_references = 0;
+    uint64_t llc_misses = 0;
+    LOG(INFO) << "Hardware counters, averaged over " << iterations
+              << " iterations:";
+    for (const auto& counter : counters_) {
+      LOG(INFO) << "  " << counter.name << ": " << counter.total / iterations;
+      if (counter.name == "cycles") {
+        cycles = counter.total;
+      } else if (counter.name == "instructions") {
+        instructions = counter.total;
+      } else if (counter.name == "LLC_references") {
+        llc_references = counter.total;
+      } else if (counter.name == "LLC_misses") {
+        llc_misses = counter.total;
+      }
+    }
+    if (cycles > 0) {
+      LOG(INFO) << "  IPC: "
+                << static_cast<double>(instructions) /
+              static_cast<double>(cycles);
+    }
+    if (llc_references > 0) {
+      LOG(INFO) << "  LLC_miss_rate: "
+                << 100.0 * static_cast<double>(llc_misses) /
+              static_cast<double>(llc_references)
+                << "%";
+    }
+    if (llc_misses > 0) {
+      const double bytes = static_cast<double>(llc_misses) * kCacheLineSize;
+      LOG(INFO) << "  estimated_dram_bytes: " << bytes / iterations;
+      if (elapsed_seconds_ > 0) {
+        LOG(INFO) << "  estimated_dram_bandwidth: " << bytes / elapsed_seconds_
+                  << " bytes/s";
+      }
+    }
+  }
+
+ private:
+  struct Counter {
+    std::string name;
+    int fd;
+    uint64_t total;
+  };
+
+  static constexpr double kCacheLineSize = 64.0;
+
+  void addCounter(const char* name, uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int fd = syscall(
+        __NR_perf_event_open,
+        &attr,
+        /* pid */ 0,
+        /* cpu */ -1,
+        /* group_fd */ -1,
+        /* flags */ 0);
+    if (fd < 0) {
+      if (!warned_) {
+        LOG(WARNING) << "perf_event_open failed for " << name << " ("
+                     << strerror(errno)
+                     << "); this counter will not be reported. You may need "
+                        "to lower /proc/sys/kernel/perf_event_paranoid.";
+        warned_ = true;
+      }
+      return;
+    }
+    counters_.push_back(Counter{name, fd, 0});
+  }
+
+  std::vector<Counter> counters_;
+  bool warned_ = false;
+  double elapsed_seconds_ = 0;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+#else // !__linux__
+
+// perf_event is Linux only; collection is a stub elsewhere.
+class PerfCounters {
+ public:
+  bool enabled() const {
+    return false;
+  }
+  void start() {}
+  void stop() {}
+  void report(int /* iterations */) const {}
+};
+
+#endif
+
+} // namespace benchmark
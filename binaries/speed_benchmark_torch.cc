@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ATen/ATen.h"
@@ -54,6 +58,19 @@ C10_DEFINE_bool(
 
 C10_DEFINE_int(pytext_len, 0, "Length of input sequence.");
 
+C10_DEFINE_int(
+    caller_threads,
+    1,
+    "Number of concurrent caller threads sharing the module. Each thread "
+    "runs its own warmup and iter loop; per-request latency percentiles "
+    "are reported across all threads.");
+C10_DEFINE_string(
+    caller_thread_sweep,
+    "",
+    "Comma separated list of caller thread counts to sweep, e.g. 1,2,4,8. "
+    "Overrides --caller_threads and prints one throughput/latency line "
+    "per count.");
+
 std::vector<std::string>
 split(char separator, const std::string& string, bool ignore_empty = true) {
   std::vector<std::string> pieces;
@@ -108,6 +125,84 @@ std::vector<c10::IValue> create_inputs() {
   return inputs;
 }
 
+float percentile(const std::vector<float>& sorted_values, double pct) {
+  if (sorted_values.empty()) {
+    return 0;
+  }
+  auto rank = static_cast<size_t>(
+      std::ceil(pct / 100.0 * static_cast<double>(sorted_values.size())));
+  rank = std::max<size_t>(rank, 1) - 1;
+  return sorted_values[std::min(rank, sorted_values.size() - 1)];
+}
+
+// Runs warmup + iter forward loops on caller_threads threads sharing the
+// module, and prints the aggregate throughput together with per-request
+// latency percentiles. Warmup runs on every thread and is discarded; the
+// timed sections are released together once all threads finish warming up,
+// so the numbers reflect steady-state concurrency.
+void run_concurrent_benchmark(
+    torch::jit::Module& module,
+    const std::vector<c10::IValue>& inputs,
+    int caller_threads) {
+  std::vector<std::vector<float>> latencies_us(caller_threads);
+  std::atomic<int> warmed_up{0};
+  std::atomic<bool> start{false};
+
+  std::vector<std::thread> callers;
+  for (int t = 0; t < caller_threads; ++t) {
+    callers.emplace_back([&, t]() {
+      // grad mode and the optimizer toggle are thread local, so the guards
+      // from main() do not carry over to caller threads
+      torch::autograd::AutoGradMode guard(false);
+      torch::jit::GraphOptimizerEnabledGuard no_optimizer_guard(false);
+      for (int i = 0; i < FLAGS_warmup; ++i) {
+        module.forward(inputs);
+      }
+      ++warmed_up;
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      auto& times = latencies_us[t];
+      times.reserve(FLAGS_iter);
+      for (int i = 0; i < FLAGS_iter; ++i) {
+        auto begin = high_resolution_clock::now();
+        module.forward(inputs);
+        auto end = high_resolution_clock::now();
+        times.push_back(duration_cast<microseconds>(end - begin).count());
+      }
+    });
+  }
+
+  while (warmed_up.load() < caller_threads) {
+    std::this_thread::yield();
+  }
+  caffe2::Timer timer;
+  start = true;
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  auto wall_millis = timer.MilliSeconds();
+
+  std::vector<float> all_times;
+  for (const auto& times : latencies_us) {
+    all_times.insert(all_times.end(), times.begin(), times.end());
+  }
+  std::sort(all_times.begin(), all_times.end());
+  double sum = 0;
+  for (auto time : all_times) {
+    sum += time;
+  }
+  auto total_iters = static_cast<double>(all_times.size());
+  std::cout << "Caller threads: " << caller_threads
+            << ". Iters per second: " << 1000.0 * total_iters / wall_millis
+            << ". Latency microseconds:"
+            << " avg " << (all_times.empty() ? 0 : sum / total_iters)
+            << ", p50 " << percentile(all_times, 50)
+            << ", p95 " << percentile(all_times, 95)
+            << ", p99 " << percentile(all_times, 99)
+            << "." << std::endl;
+}
+
 int main(int argc, char** argv) {
   c10::SetUsageMessage(
     "Run speed benchmark for pytorch model.\n"
@@ -135,12 +230,38 @@ int main(int argc, char** argv) {
   }
 
   std::cout << "Starting benchmark." << std::endl;
-  std::cout << "Running warmup runs." << std::endl;
   CAFFE_ENFORCE(
       FLAGS_warmup >= 0,
       "Number of warm up runs should be non negative, provided ",
       FLAGS_warmup,
       ".");
+  CAFFE_ENFORCE(
+      FLAGS_caller_threads >= 1,
+      "Number of caller threads should be positive, provided ",
+      FLAGS_caller_threads,
+      ".");
+
+  if (!FLAGS_caller_thread_sweep.empty() || FLAGS_caller_threads > 1) {
+    std::vector<int> thread_counts;
+    if (FLAGS_caller_thread_sweep.empty()) {
+      thread_counts.push_back(FLAGS_caller_threads);
+    } else {
+      for (const auto& count : split(',', FLAGS_caller_thread_sweep)) {
+        thread_counts.push_back(c10::stoi(count));
+        CAFFE_ENFORCE(
+            thread_counts.back() >= 1,
+            "Caller thread counts should be positive, provided ",
+            thread_counts.back(),
+            ".");
+      }
+    }
+    for (auto caller_threads : thread_counts) {
+      run_concurrent_benchmark(module, inputs, caller_threads);
+    }
+    return 0;
+  }
+
+  std::cout << "Running warmup runs." << std::endl;
   for (int i = 0; i < FLAGS_warmup; ++i) {
     module.forward(inputs);
   }
@@ -1,5 +1,7 @@
 #include <c10/core/Allocator.h>
 
+#include <atomic>
+
 namespace c10 {
 
 static void deleteInefficientStdFunctionContext(void* ptr) {
@@ -28,4 +30,28 @@ at::Allocator* GetAllocator(const at::DeviceType& t) {
   return alloc;
 }
 
+MemoryReportingInfoBase::~MemoryReportingInfoBase() = default;
+
+namespace {
+std::atomic<MemoryReportingInfoBase*> memory_reporting_info{nullptr};
+} // namespace
+
+void SetMemoryReportingInfo(MemoryReportingInfoBase* info) {
+  memory_reporting_info.store(info);
+}
+
+bool memoryProfilingEnabled() {
+  return memory_reporting_info.load() != nullptr;
+}
+
+void reportMemoryUsageToProfiler(
+    void* ptr,
+    int64_t alloc_size,
+    Device device) {
+  auto* info = memory_reporting_info.load();
+  if (info) {
+    info->reportMemoryUsage(ptr, alloc_size, device);
+  }
+}
+
 } // namespace c10
@@ -214,4 +214,27 @@ struct AllocatorRegisterer {
   static AllocatorRegisterer<t> g_allocator_d(f); \
   }
 
+// An interface for reporting allocator activity to a profiler. The autograd
+// profiler installs an implementation for the duration of a memory-profiling
+// session (see torch/csrc/autograd/profiler.cpp); allocators call
+// reportMemoryUsageToProfiler on every allocation and deallocation, which is
+// a no-op while nothing is installed.
+struct C10_API MemoryReportingInfoBase {
+  virtual ~MemoryReportingInfoBase();
+  // alloc_size is positive for allocations and negative for deallocations.
+  virtual void reportMemoryUsage(
+      void* ptr,
+      int64_t alloc_size,
+      Device device) = 0;
+};
+
+// The reporter is expected to outlive any reporting allocator call; install
+// nullptr to disable reporting again before destroying it.
+C10_API void SetMemoryReportingInfo(MemoryReportingInfoBase* info);
+C10_API bool memoryProfilingEnabled();
+C10_API void reportMemoryUsageToProfiler(
+    void* ptr,
+    int64_t alloc_size,
+    Device device);
+
 } // namespace c10
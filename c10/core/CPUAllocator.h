@@ -11,6 +11,7 @@
 C10_DECLARE_bool(caffe2_report_cpu_memory_usage);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_zero_fill);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_junk_fill);
+C10_DECLARE_bool(caffe2_cpu_allocator_use_huge_pages);
 
 namespace c10 {
 
@@ -30,6 +31,13 @@ C10_API void memset_junk(void* data, size_t num);
 C10_API void* alloc_cpu(size_t nbytes);
 C10_API void free_cpu(void* data);
 
+// Stats for FLAGS_caffe2_cpu_allocator_use_huge_pages: the number of
+// allocations that were 2MB-aligned and madvise(MADV_HUGEPAGE)'d, and the
+// total bytes they cover. Note these count what was requested from the
+// kernel; whether a region actually gets 2MB mappings is up to khugepaged.
+C10_API size_t cpu_huge_page_allocations();
+C10_API size_t cpu_huge_page_bytes();
+
 // Get the CPU Allocator.
 C10_API at::Allocator* GetCPUAllocator();
 // Sets the CPU allocator to the given allocator: the caller gives away the
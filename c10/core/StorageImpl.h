@@ -2,6 +2,7 @@
 
 #include <c10/core/Allocator.h>
 #include <c10/core/ScalarType.h>
+#include <c10/core/impl/ObjectPool.h>
 
 #include <c10/util/intrusive_ptr.h>
 
@@ -52,6 +53,16 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
   StorageImpl(const StorageImpl&) = delete;
   ~StorageImpl() = default;
 
+  // StorageImpl is created and destroyed alongside every temporary tensor;
+  // recycle it through the slab pool (the class is final, so every
+  // allocation has exactly this size). See Note [Metadata object slab pool]
+  static void* operator new(std::size_t nbytes) {
+    return c10::impl::ObjectPool<StorageImpl>::allocate(nbytes);
+  }
+  static void operator delete(void* ptr, std::size_t nbytes) {
+    c10::impl::ObjectPool<StorageImpl>::deallocate(ptr, nbytes);
+  }
+
   void reset() {
     data_ptr_.clear();
     numel_ = 0;
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+#include <c10/util/Exception.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace c10 {
+namespace impl {
+
+// Note [Metadata object slab pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Autograd and TensorIterator create and destroy TensorImpl/StorageImpl for
+// temporaries at rates where operator new/delete is a measurable cost. The
+// pool carves fixed-size blocks out of malloc'd slabs and recycles them
+// through a per-thread intrusive free list; blocks freed on a different
+// thread than they were allocated on simply land in the freeing thread's
+// list. A mutex-protected global free list backstops refills and collects
+// the cached blocks of exiting threads. Slabs are retained for the lifetime
+// of the process (the global pool is intentionally leaked so that objects
+// destroyed during static shutdown stay safe), so the footprint is bounded
+// by the peak number of live objects plus the per-thread caches.
+//
+// The pool is hooked up via class-scope operator new/delete, which is how it
+// ends up on the intrusive_ptr release path: the deleting destructor of the
+// pooled class routes through these operators with the dynamic type's size,
+// so subclasses with extra members transparently fall back to the global
+// heap.
+template <typename T>
+class ObjectPool final {
+ public:
+  static void* allocate(size_t nbytes) {
+    if (C10_UNLIKELY(nbytes != sizeof(T))) {
+      // a subclass with extra members; not pooled
+      return ::operator new(nbytes);
+    }
+    ThreadCache& tc = thread_cache();
+    if (C10_LIKELY(tc.head != nullptr)) {
+      FreeBlock* block = tc.head;
+      tc.head = block->next;
+      --tc.count;
+      return block;
+    }
+    return refill(tc);
+  }
+
+  static void deallocate(void* ptr, size_t nbytes) {
+    if (C10_UNLIKELY(nbytes != sizeof(T))) {
+      ::operator delete(ptr);
+      return;
+    }
+    ThreadCache& tc = thread_cache();
+    if (C10_UNLIKELY(tc.count >= kMaxThreadCacheBlocks)) {
+      flush_half(tc);
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = tc.head;
+    tc.head = block;
+    ++tc.count;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  static constexpr size_t kBlockSize = (sizeof(T) < sizeof(FreeBlock))
+      ? sizeof(FreeBlock)
+      : sizeof(T);
+  static constexpr size_t kBlocksPerSlab = 64;
+  static constexpr size_t kMaxThreadCacheBlocks = 256;
+
+  struct GlobalPool {
+    std::mutex mutex;
+    FreeBlock* free_list = nullptr;
+    std::vector<void*> slabs;
+  };
+
+  struct ThreadCache {
+    FreeBlock* head = nullptr;
+    size_t count = 0;
+
+    ~ThreadCache() {
+      // return everything to the (leaked) global pool
+      if (head == nullptr) {
+        return;
+      }
+      FreeBlock* tail = head;
+      while (tail->next != nullptr) {
+        tail = tail->next;
+      }
+      GlobalPool& gp = global();
+      std::lock_guard<std::mutex> guard(gp.mutex);
+      tail->next = gp.free_list;
+      gp.free_list = head;
+    }
+  };
+
+  static GlobalPool& global() {
+    static GlobalPool* pool = new GlobalPool();
+    return *pool;
+  }
+
+  static ThreadCache& thread_cache() {
+    static thread_local ThreadCache cache;
+    return cache;
+  }
+
+  C10_NOINLINE static void* refill(ThreadCache& tc) {
+    GlobalPool& gp = global();
+    {
+      std::lock_guard<std::mutex> guard(gp.mutex);
+      if (gp.free_list != nullptr) {
+        // grab a batch from the global list; hand out the first block and
+        // cache the rest
+        FreeBlock* block = gp.free_list;
+        FreeBlock* cursor = block->next;
+        size_t taken = 1;
+        while (cursor != nullptr && taken < kBlocksPerSlab / 2) {
+          FreeBlock* next = cursor->next;
+          cursor->next = tc.head;
+          tc.head = cursor;
+          ++tc.count;
+          cursor = next;
+          ++taken;
+        }
+        gp.free_list = cursor;
+        return block;
+      }
+    }
+    // carve a fresh slab; the first block is returned, the rest are cached
+    char* slab = static_cast<char*>(malloc(kBlockSize * kBlocksPerSlab));
+    TORCH_CHECK(slab, "ObjectPool: failed to allocate slab");
+    {
+      std::lock_guard<std::mutex> guard(gp.mutex);
+      gp.slabs.push_back(slab);
+    }
+    for (size_t i = 1; i < kBlocksPerSlab; ++i) {
+      FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * kBlockSize);
+      block->next = tc.head;
+      tc.head = block;
+      ++tc.count;
+    }
+    return slab;
+  }
+
+  C10_NOINLINE static void flush_half(ThreadCache& tc) {
+    FreeBlock* keep = tc.head;
+    for (size_t i = 1; i < kMaxThreadCacheBlocks / 2; ++i) {
+      keep = keep->next;
+    }
+    FreeBlock* spill = keep->next;
+    keep->next = nullptr;
+    tc.count = kMaxThreadCacheBlocks / 2;
+
+    FreeBlock* tail = spill;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+    GlobalPool& gp = global();
+    std::lock_guard<std::mutex> guard(gp.mutex);
+    tail->next = gp.free_list;
+    gp.free_list = spill;
+  }
+};
+
+} // namespace impl
+} // namespace c10
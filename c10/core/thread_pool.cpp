@@ -8,10 +8,15 @@ ThreadPool::ThreadPool(
       std::function<void()> init_thread)
     : threads_(pool_size < 0 ? defaultNumThreads() : pool_size),
       running_(true),
-      complete_(true),
-      available_(threads_.size()),
-      total_(threads_.size()),
+      queued_(0),
+      pending_(0),
+      available_(0),
+      submit_cursor_(0),
       numa_node_id_(numa_node_id) {
+  queues_.reserve(threads_.size());
+  for (std::size_t i = 0; i < threads_.size(); ++i) {
+    queues_.emplace_back(new WorkQueue());
+  }
   for (std::size_t i = 0; i < threads_.size(); ++i) {
     threads_[i] = std::thread([this, i, init_thread](){
       if (init_thread) {
@@ -43,7 +48,7 @@ size_t ThreadPool::size() const {
 }
 
 size_t ThreadPool::numAvailable() const {
-  return available_;
+  return available_.load();
 }
 
 bool ThreadPool::inThreadPool() const {
@@ -56,57 +61,145 @@ bool ThreadPool::inThreadPool() const {
 }
 
 void ThreadPool::run(const std::function<void()>& func) {
-  if (threads_.size() == 0) {
+  enqueue(task_element_t(func));
+}
+
+void ThreadPool::enqueue(task_element_t task) {
+  if (queues_.size() == 0) {
     throw std::runtime_error("No threads to run a task");
   }
-  std::unique_lock<std::mutex> lock(mutex_);
+  // Count the task before it becomes visible in a deque so that neither
+  // counter can be decremented below zero by a racing worker, and so that
+  // an idle worker re-checking its wake predicate is guaranteed to see the
+  // task (see the wake handshake below).
+  ++pending_;
+  ++queued_;
+
+  const std::size_t n = queues_.size();
+  const std::size_t start = submit_cursor_++ % n;
+  bool pushed = false;
+  // Rotate the home deque per submission and try-lock forward from it, so
+  // concurrent submitters normally land on different locks without blocking.
+  for (std::size_t attempt = 0; attempt < n && !pushed; ++attempt) {
+    WorkQueue& queue = *queues_[(start + attempt) % n];
+    std::unique_lock<std::mutex> qlock(queue.mutex, std::try_to_lock);
+    if (qlock.owns_lock()) {
+      queue.tasks.push_back(std::move(task));
+      pushed = true;
+    }
+  }
+  if (!pushed) {
+    // Every deque was contended; fall back to blocking on the home one.
+    WorkQueue& queue = *queues_[start];
+    std::lock_guard<std::mutex> qlock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
 
-  // Set task and signal condition variable so that a worker thread will
-  // wake up and use the task.
-  tasks_.push(task_element_t(func));
-  complete_ = false;
-  condition_.notify_one();
+  // Wake an idle worker if there is one.  If a worker is concurrently going
+  // to sleep it either shows up in available_ here, or it re-checks queued_
+  // under mutex_ after our increment above and stays awake.
+  if (available_.load() > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+  }
 }
 
-void ThreadPool::waitWorkComplete() {
-  std::unique_lock<std::mutex> lock(mutex_);
-  while (!complete_) {
-    completed_.wait(lock);
+c10::optional<ThreadPool::task_element_t> ThreadPool::pop_task(
+    std::size_t index) {
+  // Our own deque first, oldest task first.
+  {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> qlock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      c10::optional<task_element_t> task(queue.tasks.front());
+      queue.tasks.pop_front();
+      --queued_;
+      return task;
+    }
   }
+  // Steal from a sibling, newest task first to keep its older tasks in
+  // submission order for their owner.  try_lock only: if a deque is busy we
+  // move on rather than queue up on its lock; queued_ keeps us from going
+  // to sleep while work remains.
+  const std::size_t n = queues_.size();
+  for (std::size_t i = 1; i < n; ++i) {
+    WorkQueue& queue = *queues_[(index + i) % n];
+    std::unique_lock<std::mutex> qlock(queue.mutex, std::try_to_lock);
+    if (!qlock.owns_lock() || queue.tasks.empty()) {
+      continue;
+    }
+    c10::optional<task_element_t> task(queue.tasks.back());
+    queue.tasks.pop_back();
+    --queued_;
+    return task;
+  }
+  return c10::nullopt;
 }
 
-void ThreadPool::main_loop(std::size_t index) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  while (running_) {
-    // Wait on condition variable while the task is empty and
-    // the pool is still running.
-    while (tasks_.empty() && running_) {
-      condition_.wait(lock);
+bool ThreadPool::tryRunTask() {
+  if (queued_.load() == 0) {
+    return false;
+  }
+  // The caller has no home deque; scan from the submit cursor and take the
+  // oldest task of the first deque we can lock, like a worker would.
+  const std::size_t n = queues_.size();
+  c10::optional<task_element_t> task;
+  const std::size_t start = submit_cursor_.load() % n;
+  std::size_t drained = start;
+  for (std::size_t i = 0; i < n; ++i) {
+    WorkQueue& queue = *queues_[(start + i) % n];
+    std::unique_lock<std::mutex> qlock(queue.mutex, std::try_to_lock);
+    if (!qlock.owns_lock() || queue.tasks.empty()) {
+      continue;
     }
-    // If pool is no longer running, break out of loop.
-    if (!running_) {
-      break;
+    task.emplace(queue.tasks.front());
+    queue.tasks.pop_front();
+    --queued_;
+    drained = (start + i) % n;
+    break;
+  }
+  if (!task.has_value()) {
+    return false;
+  }
+
+  try {
+    if (task->run_with_id) {
+      // Pass a worker id even though we are not a worker; tasks only use it
+      // to index per-task state, and ours is the id of the deque we drained.
+      task->with_id(drained);
+    } else {
+      task->no_id();
     }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Exception in thread pool task: " << e.what();
+  } catch (...) {
+    LOG(ERROR) << "Exception in thread pool task: unknown";
+  }
 
-    // Copy task locally and remove from the queue.  This is
-    // done within its own scope so that the task object is
-    // destructed immediately after running the task.  This is
-    // useful in the event that the function contains
-    // shared_ptr arguments bound via bind.
-    {
-      auto tasks = tasks_.front();
-      tasks_.pop();
-      // Decrement count, indicating thread is no longer available.
-      --available_;
+  if (--pending_ == 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.notify_all();
+  }
+  return true;
+}
 
-      lock.unlock();
+void ThreadPool::waitWorkComplete() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  completed_.wait(lock, [this]() { return pending_.load() == 0; });
+}
 
-      // Run the task.
+void ThreadPool::main_loop(std::size_t index) {
+  while (running_) {
+    auto task = pop_task(index);
+    if (task.has_value()) {
+      // Run the task.  The local copy is destructed as the optional goes out
+      // of scope each iteration, which is useful in the event that the
+      // function contains shared_ptr arguments bound via bind.
       try {
-        if (tasks.run_with_id) {
-          tasks.with_id(index);
+        if (task->run_with_id) {
+          task->with_id(index);
         } else {
-          tasks.no_id();
+          task->no_id();
         }
       } catch (const std::exception& e) {
         LOG(ERROR) << "Exception in thread pool task: " << e.what();
@@ -114,22 +207,20 @@ void ThreadPool::main_loop(std::size_t index) {
         LOG(ERROR) << "Exception in thread pool task: unknown";
       }
 
-      // Update status of empty, maybe
-      // Need to recover the lock first
-      lock.lock();
-
-      // Increment count, indicating thread is available.
-      ++available_;
-      if (tasks_.empty() && available_ == total_) {
-        complete_ = true;
-        completed_.notify_one();
+      if (--pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.notify_all();
       }
-
-      // Deliberately hold the lock on the backedge, so this thread has an
-      // opportunity to acquire a new task before another thread acquires
-      // the lock.
+      continue;
     }
-  } // while running_
+
+    // Nothing to pop and nothing to steal; park until a submitter wakes us.
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++available_;
+    condition_.wait(
+        lock, [this]() { return queued_.load() > 0 || !running_; });
+    --available_;
+  }
 }
 
 C10_DEFINE_SHARED_REGISTRY(
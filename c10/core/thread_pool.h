@@ -1,15 +1,19 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <c10/util/Optional.h>
 #include <c10/util/intrusive_ptr.h>
 #include <c10/util/numa.h>
+#include <c10/util/thread_budget.h>
 #include <c10/util/thread_name.h>
 
 namespace c10 {
@@ -31,17 +35,35 @@ class C10_API TaskThreadPoolBase {
    */
   virtual bool inThreadPool() const = 0;
 
+  /**
+   * Run one pending task on the calling thread, if there is one.
+   * Returns false when no task was runnable. Lets a thread that is
+   * blocked on an external event (e.g. a future) help drain the pool
+   * instead of idling; pools without task visibility keep the default.
+   */
+  virtual bool tryRunTask() {
+    return false;
+  }
+
   virtual ~TaskThreadPoolBase() noexcept {}
 
   static size_t defaultNumThreads() {
-    auto num_threads = std::thread::hardware_concurrency();
-#if defined(_M_X64) || defined(__x86_64__)
-    num_threads /= 2;
-#endif
-    return num_threads;
+    // Consult the process-wide thread budget so that the pools sharing this
+    // default track physical cores (or an override) instead of each sizing
+    // itself from hardware_concurrency() independently.
+    return GetThreadBudget();
   }
 };
 
+// Note [Work-stealing thread pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Tasks are distributed round-robin over per-worker deques instead of a
+// single shared queue, so submitters and workers normally touch different
+// locks.  Submission try-locks deques starting from a rotating cursor and
+// only blocks if every deque is contended; a worker pops from the front of
+// its own deque and steals from the back of its siblings when it runs dry.
+// The pool-wide mutex is only taken to park/wake idle workers and to signal
+// completion, and its critical sections never touch a deque.
 class C10_API ThreadPool : public c10::TaskThreadPoolBase {
  protected:
   struct task_element_t {
@@ -55,15 +77,26 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
         : run_with_id(true), no_id(nullptr), with_id(f) {}
   };
 
-  std::queue<task_element_t> tasks_;
+  // One deque per worker; held by unique_ptr so each mutex lives in its own
+  // allocation and submitters hammering different deques don't false-share.
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<task_element_t> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
   std::vector<std::thread> threads_;
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable completed_;
   std::atomic_bool running_;
-  bool complete_;
-  std::size_t available_;
-  std::size_t total_;
+  // Tasks sitting in some deque; wake predicate for idle workers.
+  std::atomic<std::size_t> queued_;
+  // Tasks submitted but not yet finished (queued + in flight); completion
+  // predicate for waitWorkComplete().
+  std::atomic<std::size_t> pending_;
+  std::atomic<std::size_t> available_;
+  std::atomic<std::size_t> submit_cursor_;
   int numa_node_id_;
 
  public:
@@ -84,16 +117,12 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
 
   void run(const std::function<void()>& func) override;
 
+  bool tryRunTask() override;
+
   template <typename Task>
   void runTaskWithID(Task task) {
-    std::unique_lock<std::mutex> lock(mutex_);
-
-    // Set task and signal condition variable so that a worker thread will
-    // wake up and use the task.
-    tasks_.push(
+    enqueue(
         task_element_t(static_cast<std::function<void(std::size_t)>>(task)));
-    complete_ = false;
-    condition_.notify_one();
   }
 
   /// @brief Wait for queue to be empty
@@ -102,6 +131,12 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
  private:
   // @brief Entry point for pool threads.
   void main_loop(std::size_t index);
+
+  // @brief Push a task onto some worker's deque and wake an idle worker.
+  void enqueue(task_element_t task);
+
+  // @brief Pop from our own deque, stealing from a sibling if it is empty.
+  c10::optional<task_element_t> pop_task(std::size_t index);
 };
 
 class C10_API TaskThreadPool : public c10::ThreadPool {
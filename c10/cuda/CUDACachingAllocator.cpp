@@ -6,10 +6,24 @@
 #include <c10/util/UniqueVoidPtr.h>
 
 #include <cuda_runtime_api.h>
+
+#if !defined(__HIP_PLATFORM_HCC__) && !defined(_WIN32) && \
+    defined(CUDART_VERSION) && CUDART_VERSION >= 10020
+// Virtual memory management backed expandable segments,
+// see Note [Expandable segments].
+#define C10_CUDA_EXPANDABLE_SEGMENTS 1
+#include <cuda.h>
+#include <dlfcn.h>
+#include <cstdlib>
+#include <cstring>
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <deque>
 #include <iterator>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -63,6 +77,7 @@ constexpr size_t kSmallBuffer = 2097152;    // "small" allocations are packed in
 constexpr size_t kLargeBuffer = 20971520;   // "large" allocations may be packed in 20 MiB blocks
 constexpr size_t kMinLargeAlloc = 10485760; // allocations between 1 and 10 MiB may use kLargeBuffer
 constexpr size_t kRoundLarge = 2097152;     // round up large allocs to 2 MiB
+constexpr size_t kAllocFailureHistory = 128; // bound on recorded allocation failures
 
 typedef std::bitset<static_cast<size_t>(StatType::NUM_TYPES)> StatTypes;
 
@@ -101,6 +116,211 @@ struct Block;
 typedef bool (*Comparison)(const Block*, const Block*);
 typedef std::set<Block*, Comparison> BlockPool;
 
+#ifdef C10_CUDA_EXPANDABLE_SEGMENTS
+
+// Note [Expandable segments]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Long-running jobs can strand gigabytes of free memory in odd-sized blocks
+// split out of fixed cudaMalloc'd segments: a new large request then OOMs
+// even though enough bytes are technically free, because no single segment
+// has room. When PYTORCH_CUDA_ALLOC_EXPANDABLE_SEGMENTS is set, large
+// allocations are instead carved out of one growable segment per stream. A
+// big virtual address range is reserved up front (cuMemAddressReserve) and
+// physical pages are mapped into it incrementally (cuMemCreate + cuMemMap)
+// as the segment needs to grow. Every extension is contiguous with the
+// previous tail, so free memory in the segment always coalesces into a
+// single block instead of being stranded behind segment boundaries.
+//
+// The mode is opt-in because pointers in such segments cannot be shared
+// over CUDA IPC, and it requires driver support for virtual memory
+// management (CUDA 10.2+). The driver entry points are resolved lazily
+// from the already-loaded libcuda, avoiding a link-time dependency.
+
+struct DriverAPI {
+  CUresult (*memAddressReserve)(
+      CUdeviceptr*,
+      size_t,
+      size_t,
+      CUdeviceptr,
+      unsigned long long) = nullptr;
+  CUresult (*memAddressFree)(CUdeviceptr, size_t) = nullptr;
+  CUresult (*memCreate)(
+      CUmemGenericAllocationHandle*,
+      size_t,
+      const CUmemAllocationProp*,
+      unsigned long long) = nullptr;
+  CUresult (*memRelease)(CUmemGenericAllocationHandle) = nullptr;
+  CUresult (*memMap)(
+      CUdeviceptr,
+      size_t,
+      size_t,
+      CUmemGenericAllocationHandle,
+      unsigned long long) = nullptr;
+  CUresult (*memUnmap)(CUdeviceptr, size_t) = nullptr;
+  CUresult (*memSetAccess)(
+      CUdeviceptr,
+      size_t,
+      const CUmemAccessDesc*,
+      size_t) = nullptr;
+  CUresult (*memGetAllocationGranularity)(
+      size_t*,
+      const CUmemAllocationProp*,
+      CUmemAllocationGranularity_flags) = nullptr;
+  CUresult (*deviceGetAttribute)(int*, CUdevice_attribute, CUdevice) = nullptr;
+};
+
+// Returns the resolved driver entry points, or nullptr if they are
+// unavailable. The CUDA runtime has already loaded the driver into the
+// process, so resolution never loads a new library.
+DriverAPI* driver_api() {
+  static DriverAPI* api = []() -> DriverAPI* {
+    void* handle = dlopen("libcuda.so.1", RTLD_LAZY | RTLD_NOLOAD);
+    if (handle == nullptr) {
+      return nullptr;
+    }
+    static DriverAPI a;
+    bool ok = true;
+    auto resolve = [&](const char* name) -> void* {
+      void* fn = dlsym(handle, name);
+      ok = ok && fn != nullptr;
+      return fn;
+    };
+    a.memAddressReserve = (decltype(a.memAddressReserve))resolve("cuMemAddressReserve");
+    a.memAddressFree = (decltype(a.memAddressFree))resolve("cuMemAddressFree");
+    a.memCreate = (decltype(a.memCreate))resolve("cuMemCreate");
+    a.memRelease = (decltype(a.memRelease))resolve("cuMemRelease");
+    a.memMap = (decltype(a.memMap))resolve("cuMemMap");
+    a.memUnmap = (decltype(a.memUnmap))resolve("cuMemUnmap");
+    a.memSetAccess = (decltype(a.memSetAccess))resolve("cuMemSetAccess");
+    a.memGetAllocationGranularity =
+        (decltype(a.memGetAllocationGranularity))resolve("cuMemGetAllocationGranularity");
+    a.deviceGetAttribute = (decltype(a.deviceGetAttribute))resolve("cuDeviceGetAttribute");
+    return ok ? &a : nullptr;
+  }();
+  return api;
+}
+
+bool expandable_segments_enabled() {
+  static bool enabled = []() {
+    const char* val = getenv("PYTORCH_CUDA_ALLOC_EXPANDABLE_SEGMENTS");
+    return val != nullptr && strcmp(val, "0") != 0 && driver_api() != nullptr;
+  }();
+  return enabled;
+}
+
+// A reserved virtual address range that grows by mapping physical pages at
+// its tail; see Note [Expandable segments].
+struct ExpandableSegment {
+  int device = -1;
+  CUdeviceptr base = 0;
+  size_t max_size = 0; // size of the reserved virtual address range
+  size_t mapped_size = 0; // bytes currently backed by physical pages
+  size_t granularity = 0; // physical mapping granularity
+  std::vector<CUmemGenericAllocationHandle> handles;
+  Block* tail_block = nullptr; // last block in this segment's chain
+
+  // Reserves a virtual address range large enough for the whole device.
+  // Unmapped virtual addresses consume no memory.
+  bool reserve(int dev) {
+    device = dev;
+    CUmemAllocationProp prop = {};
+    prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+    prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    prop.location.id = device;
+    if (driver_api()->memGetAllocationGranularity(
+            &granularity, &prop, CU_MEM_ALLOC_GRANULARITY_MINIMUM) !=
+        CUDA_SUCCESS) {
+      return false;
+    }
+    size_t device_free = 0;
+    size_t device_total = 0;
+    C10_CUDA_CHECK(cudaMemGetInfo(&device_free, &device_total));
+    max_size = granularity * ((device_total + granularity - 1) / granularity);
+    return driver_api()->memAddressReserve(&base, max_size, 0, 0, 0) ==
+        CUDA_SUCCESS;
+  }
+
+  // Maps physical pages for `delta` more bytes (rounded up to the mapping
+  // granularity) at the tail. Returns the number of bytes mapped, or 0 on
+  // failure (e.g. the device is out of physical pages).
+  size_t expand(size_t delta) {
+    delta = granularity * ((delta + granularity - 1) / granularity);
+    if (delta == 0 || mapped_size + delta > max_size) {
+      return 0;
+    }
+    CUmemAllocationProp prop = {};
+    prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+    prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    prop.location.id = device;
+    CUmemAccessDesc access = {};
+    access.location = prop.location;
+    access.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+    size_t mapped = 0;
+    while (mapped < delta) {
+      CUmemGenericAllocationHandle handle;
+      if (driver_api()->memCreate(&handle, granularity, &prop, 0) !=
+          CUDA_SUCCESS) {
+        break;
+      }
+      CUdeviceptr at = base + mapped_size + mapped;
+      if (driver_api()->memMap(at, granularity, 0, handle, 0) !=
+              CUDA_SUCCESS ||
+          driver_api()->memSetAccess(at, granularity, &access, 1) !=
+              CUDA_SUCCESS) {
+        driver_api()->memRelease(handle);
+        break;
+      }
+      handles.push_back(handle);
+      mapped += granularity;
+    }
+    if (mapped < delta) {
+      // A partially grown mapping doesn't satisfy the request; roll it back
+      // so the caller can retry after returning cached blocks to the device.
+      while (mapped > 0) {
+        mapped -= granularity;
+        driver_api()->memUnmap(base + mapped_size + mapped, granularity);
+        driver_api()->memRelease(handles.back());
+        handles.pop_back();
+      }
+      return 0;
+    }
+    mapped_size += delta;
+    return delta;
+  }
+
+  // Unmaps all physical pages and frees the virtual address range.
+  void release() {
+    if (mapped_size > 0) {
+      driver_api()->memUnmap(base, mapped_size);
+      for (const auto handle : handles) {
+        driver_api()->memRelease(handle);
+      }
+      handles.clear();
+      mapped_size = 0;
+    }
+    if (base != 0) {
+      driver_api()->memAddressFree(base, max_size);
+      base = 0;
+    }
+  }
+
+  void* ptr() const {
+    return (void*)base; // NOLINT(performance-no-int-to-ptr)
+  }
+};
+
+#else
+
+constexpr bool expandable_segments_enabled() {
+  return false;
+}
+
+struct ExpandableSegment {
+  Block* tail_block = nullptr;
+};
+
+#endif // C10_CUDA_EXPANDABLE_SEGMENTS
+
 struct Block {
   int           device;      // gpu
   cudaStream_t  stream;      // allocation stream
@@ -112,15 +332,20 @@ struct Block {
   Block*        prev;        // prev block if split from a larger allocation
   Block*        next;        // next block if split from a larger allocation
   int           event_count; // number of outstanding CUDA events
+  ExpandableSegment* expandable_segment; // VA-backed segment owning this
+                                         // block, or null; see Note
+                                         // [Expandable segments]
 
   Block(int device, cudaStream_t stream, size_t size, BlockPool* pool, void* ptr) :
     device(device), stream(stream), stream_uses(), size(size), pool(pool),
-    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    expandable_segment(nullptr) { }
 
   // constructor for search key
   Block(int device, cudaStream_t stream, size_t size) :
     device(device), stream(stream), stream_uses(), size(size), pool(nullptr),
-    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    expandable_segment(nullptr) { }
 
   bool is_split() const {
     return (prev != nullptr) || (next != nullptr);
@@ -141,6 +366,30 @@ static bool BlockComparator(const Block* a, const Block* b)
   return (uintptr_t)a->ptr < (uintptr_t)b->ptr;
 }
 
+// Note [Graph-private memory pools]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Replaying a captured CUDA graph re-issues kernels against the raw device
+// pointers that were observed during capture, so every allocation made while
+// capturing must keep a stable address for as long as the graph is alive.
+// To guarantee this, allocations made between notifyCaptureBegin and
+// notifyCaptureEnd are served from a private pair of block pools tied to the
+// capture id. Blocks allocated from a private pool return to that pool when
+// freed and are never handed out to ordinary allocations, and the backing
+// segments are not released to the device (by emptyCache or an OOM-triggered
+// flush) until notifyCaptureDestroy drops the last reference to the pool.
+struct PrivatePool {
+  PrivatePool()
+      : large_blocks(BlockComparator), small_blocks(BlockComparator) {}
+
+  // Number of live graphs using this pool.
+  int use_count = 1;
+  // Number of unfreed cudaMallocs made for this pool. The pool object is
+  // kept alive until both counts reach zero.
+  int cudaMalloc_count = 0;
+  BlockPool large_blocks;
+  BlockPool small_blocks;
+};
+
 static std::string format_size(uint64_t size) {
   std::ostringstream os;
   os.precision(2);
@@ -187,6 +436,21 @@ class THCCachingAllocator {
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, Block*>> cuda_events;
 
+  // bounded history of failed cudaMallocs across all devices, oldest first
+  std::deque<AllocFailureInfo> alloc_failures;
+
+  // private pools for CUDA graphs, keyed by capture id;
+  // see Note [Graph-private memory pools]
+  std::unordered_map<CaptureId_t, std::unique_ptr<PrivatePool>> graph_pools;
+
+  // pool receiving allocations while a capture is underway, or null
+  PrivatePool* capture_pool = nullptr;
+
+  // growable VA-backed segments, one per (device, stream); nullptr caches
+  // a negative answer (device lacks VMM support or reservation failed).
+  // See Note [Expandable segments].
+  std::map<std::pair<int, cudaStream_t>, ExpandableSegment*> expandable_segments_;
+
  public:
 
   THCCachingAllocator() :
@@ -243,13 +507,37 @@ class THCCachingAllocator {
         block = find_free_block();
       }
     }
+    if (block == nullptr && expandable_segments_enabled() &&
+        size > kSmallSize && capture_pool == nullptr) {
+      // Grow a VA-backed segment instead of cudaMalloc'ing a new fixed one;
+      // see Note [Expandable segments]. Falls through to the regular path
+      // below if the device does not support virtual memory management.
+      ExpandableSegment* segment = get_expandable_segment(device, stream);
+      if (segment != nullptr) {
+        block = try_expandable_alloc(segment, device, stream, size, pool, stats, stat_types);
+        if (block == nullptr) {
+          stats.num_alloc_retries += 1;
+          record_alloc_failure(device, size, stream, /*oom=*/false);
+          // free_cached_blocks may release the segment itself if it was
+          // entirely free, so look it up again (recreating it if needed).
+          free_cached_blocks(device);
+          segment = get_expandable_segment(device, stream);
+          if (segment != nullptr) {
+            block = try_expandable_alloc(segment, device, stream, size, pool, stats, stat_types);
+          }
+        }
+      }
+    }
     if (block == nullptr) {
       void* ptr;
       size_t alloc_size = get_allocation_size(size);
-      cudaError_t err = cuda_malloc_with_retry(device, &ptr, alloc_size);
+      cudaError_t err = cuda_malloc_with_retry(device, &ptr, alloc_size, stream);
 
       if (err == cudaSuccess) {
         block = new Block(device, stream, alloc_size, &pool, ptr);
+        if (PrivatePool* private_pool = private_pool_of(&pool)) {
+          private_pool->cudaMalloc_count++;
+        }
         update_stat_array(stats.segment, 1, stat_types);
         update_stat_array(stats.reserved_bytes, alloc_size, stat_types);
       } else if (err == cudaErrorMemoryAllocation) {
@@ -260,6 +548,7 @@ class THCCachingAllocator {
         C10_CUDA_CHECK(cudaMemGetInfo(&device_free, &device_total));
 
         stats.num_ooms += 1;
+        record_alloc_failure(device, alloc_size, stream, /*oom=*/true);
 
         // "total capacity": total global memory on GPU
         // "already allocated": memory allocated by the program using the
@@ -300,6 +589,7 @@ class THCCachingAllocator {
       remaining = block;
 
       block = new Block(device, stream, size, &pool, block->ptr);
+      block->expandable_segment = remaining->expandable_segment;
       block->prev = remaining->prev;
       if (block->prev) {
         block->prev->next = block;
@@ -335,6 +625,11 @@ class THCCachingAllocator {
     update_stat_array(stats.allocated_bytes, block->size, stat_types);
     update_stat_array(stats.active, 1, stat_types);
     update_stat_array(stats.active_bytes, block->size, stat_types);
+
+    c10::reportMemoryUsageToProfiler(
+        block->ptr,
+        static_cast<int64_t>(block->size),
+        c10::Device(c10::DeviceType::CUDA, block->device));
   }
 
   void free(void* ptr)
@@ -360,6 +655,11 @@ class THCCachingAllocator {
     update_stat_array(stats.allocation, -1, {stat_types});
     update_stat_array(stats.allocated_bytes, -block->size, {stat_types});
 
+    c10::reportMemoryUsageToProfiler(
+        block->ptr,
+        -static_cast<int64_t>(block->size),
+        c10::Device(c10::DeviceType::CUDA, block->device));
+
     if (!block->stream_uses.empty()) {
       insert_events(block);
     } else {
@@ -422,6 +722,16 @@ class THCCachingAllocator {
     synchronize_and_free_events(nullopt);
     free_blocks(large_blocks, large_blocks.begin(), large_blocks.end());
     free_blocks(small_blocks, small_blocks.begin(), small_blocks.end());
+    // Private pools of live graphs must keep their addresses stable and are
+    // skipped; see Note [Graph-private memory pools].
+    for (auto& entry : graph_pools) {
+      if (entry.second->use_count == 0) {
+        auto& pool = *entry.second;
+        free_blocks(pool.large_blocks, pool.large_blocks.begin(), pool.large_blocks.end());
+        free_blocks(pool.small_blocks, pool.small_blocks.begin(), pool.small_blocks.end());
+      }
+    }
+    trim_graph_pools();
   }
 
   /** Retrieves info (total size + largest block) of the memory cache **/
@@ -489,7 +799,11 @@ class THCCachingAllocator {
       SegmentInfo& segment_info = result.back();
       segment_info.device = head_block->device;
       segment_info.address = reinterpret_cast<int64_t>(head_block->ptr);
-      segment_info.is_large = (head_block->pool == &large_blocks);
+      segment_info.stream = reinterpret_cast<int64_t>(head_block->stream);
+      const PrivatePool* private_pool = private_pool_of(head_block->pool);
+      segment_info.is_large = (head_block->pool == &large_blocks) ||
+          (private_pool != nullptr &&
+           head_block->pool == &private_pool->large_blocks);
 
       const Block* block = head_block;
       while (block != nullptr) {
@@ -522,6 +836,62 @@ class THCCachingAllocator {
     return result;
   }
 
+  /** Returns a copy of the bounded allocation failure history, oldest first. **/
+  std::vector<AllocFailureInfo> allocationFailureHistory() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return std::vector<AllocFailureInfo>(
+        alloc_failures.begin(), alloc_failures.end());
+  }
+
+  /** begins routing allocations to a private pool for a CUDA graph capture;
+   ** see Note [Graph-private memory pools] **/
+  void notifyCaptureBegin(CaptureId_t graph_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        capture_pool == nullptr,
+        "notifyCaptureBegin: a CUDA graph capture is already underway");
+    auto inserted = graph_pools.emplace(
+        graph_id, std::unique_ptr<PrivatePool>(new PrivatePool()));
+    TORCH_INTERNAL_ASSERT(
+        inserted.second, "notifyCaptureBegin: capture id already has a pool");
+    capture_pool = inserted.first->second.get();
+  }
+
+  /** stops routing allocations to the capture's private pool **/
+  void notifyCaptureEnd(CaptureId_t graph_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto it = graph_pools.find(graph_id);
+    TORCH_INTERNAL_ASSERT(
+        it != graph_pools.end() && capture_pool == it->second.get(),
+        "notifyCaptureEnd: no capture underway for this id");
+    capture_pool = nullptr;
+  }
+
+  /** drops a graph's reference on its private pool. Cached blocks are
+   ** returned to the device; the pool itself lingers until its last
+   ** outstanding allocation is freed. **/
+  void notifyCaptureDestroy(CaptureId_t graph_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto it = graph_pools.find(graph_id);
+    TORCH_INTERNAL_ASSERT(
+        it != graph_pools.end(), "notifyCaptureDestroy: unknown capture id");
+    PrivatePool* pool = it->second.get();
+    TORCH_INTERNAL_ASSERT(pool->use_count > 0);
+    pool->use_count--;
+    if (pool->use_count == 0) {
+      synchronize_and_free_events(nullopt);
+      free_blocks(
+          pool->large_blocks,
+          pool->large_blocks.begin(),
+          pool->large_blocks.end());
+      free_blocks(
+          pool->small_blocks,
+          pool->small_blocks.begin(),
+          pool->small_blocks.end());
+      trim_graph_pools();
+    }
+  }
+
  private:
 
   // All private methods do not acquire the allocator mutex.
@@ -538,6 +908,11 @@ class THCCachingAllocator {
     std::vector<const Block*> blocks;
     blocks.insert(blocks.end(), small_blocks.begin(), small_blocks.end());
     blocks.insert(blocks.end(), large_blocks.begin(), large_blocks.end());
+    for (const auto& entry : graph_pools) {
+      const auto& pool = *entry.second;
+      blocks.insert(blocks.end(), pool.small_blocks.begin(), pool.small_blocks.end());
+      blocks.insert(blocks.end(), pool.large_blocks.begin(), pool.large_blocks.end());
+    }
     for (const auto& item : allocated_blocks) {
       blocks.push_back(item.second);
     }
@@ -605,6 +980,10 @@ class THCCachingAllocator {
 
     const size_t subsumed_size = src->size;
     dst->size += subsumed_size;
+    if (src->expandable_segment != nullptr &&
+        src->expandable_segment->tail_block == src) {
+      src->expandable_segment->tail_block = dst;
+    }
     pool.erase(src);
     delete src;
 
@@ -612,6 +991,12 @@ class THCCachingAllocator {
   }
 
   BlockPool& get_pool(size_t size) {
+    if (capture_pool != nullptr) {
+      // allocations during a graph capture come from the capture's private
+      // pool; see Note [Graph-private memory pools]
+      return size <= kSmallSize ? capture_pool->small_blocks
+                                : capture_pool->large_blocks;
+    }
     if (size <= kSmallSize) {
       return small_blocks;
     } else {
@@ -619,14 +1004,41 @@ class THCCachingAllocator {
     }
   }
 
+  /** returns the private pool owning `pool`, or null for the global pools */
+  PrivatePool* private_pool_of(const BlockPool* pool) const {
+    for (const auto& entry : graph_pools) {
+      if (pool == &entry.second->large_blocks ||
+          pool == &entry.second->small_blocks) {
+        return entry.second.get();
+      }
+    }
+    return nullptr;
+  }
+
+  /** erases private pools whose graphs are gone and whose segments have all
+   ** been returned to the device **/
+  void trim_graph_pools() {
+    for (auto it = graph_pools.begin(); it != graph_pools.end();) {
+      if (it->second->use_count == 0 && it->second->cudaMalloc_count == 0) {
+        it = graph_pools.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
   StatType get_stat_type_for_pool(const BlockPool& pool) {
     if (&pool == &small_blocks) {
       return StatType::SMALL_POOL;
     } else if (&pool == &large_blocks) {
       return StatType::LARGE_POOL;
-    } else {
-      AT_ERROR("get_stat_type_for_pool: invalid pool");
     }
+    PrivatePool* private_pool = private_pool_of(&pool);
+    if (private_pool != nullptr) {
+      return &pool == &private_pool->small_blocks ? StatType::SMALL_POOL
+                                                  : StatType::LARGE_POOL;
+    }
+    AT_ERROR("get_stat_type_for_pool: invalid pool");
   }
 
   bool should_split(const Block* block, size_t size) {
@@ -635,9 +1047,14 @@ class THCCachingAllocator {
       return remaining >= kMinBlockSize;
     } else if (block->pool == &large_blocks) {
       return remaining > kSmallSize;
-    } else {
-      AT_ERROR("should_split: invalid pool");
     }
+    PrivatePool* private_pool = private_pool_of(block->pool);
+    if (private_pool != nullptr) {
+      return block->pool == &private_pool->small_blocks
+          ? remaining >= kMinBlockSize
+          : remaining > kSmallSize;
+    }
+    AT_ERROR("should_split: invalid pool");
   }
 
   size_t round_size(size_t size) {
@@ -658,16 +1075,23 @@ class THCCachingAllocator {
     }
   }
 
-  cudaError_t cuda_malloc_with_retry(int device, void** devPtr, size_t size)
+  cudaError_t cuda_malloc_with_retry(int device, void** devPtr, size_t size, cudaStream_t stream)
   {
     // Try cudaMalloc. If cudaMalloc fails, frees all non-split cached blocks
     // and retries.
     cudaError_t err = cudaMalloc(devPtr, size);
 
     if (err != cudaSuccess) {
+      cudaGetLastError();  // reset the last CUDA error
+      if (capture_pool != nullptr) {
+        // Freeing cached blocks calls cudaFree, which synchronizes the
+        // device and would invalidate the ongoing stream capture. Surface
+        // the failure instead of retrying.
+        return err;
+      }
       DeviceStats& stats = get_stats_for_device(device);
       stats.num_alloc_retries += 1;
-      cudaGetLastError();  // reset the last CUDA error
+      record_alloc_failure(device, size, stream, /*oom=*/false);
       free_cached_blocks(device);
       err = cudaMalloc(devPtr, size);
       if (err != cudaSuccess) {
@@ -678,6 +1102,28 @@ class THCCachingAllocator {
     return cudaSuccess;
   }
 
+  /** appends an entry to the bounded allocation failure history **/
+  void record_alloc_failure(int device, size_t size, cudaStream_t stream, bool oom)
+  {
+    size_t device_free = 0;
+    size_t device_total = 0;
+    if (cudaMemGetInfo(&device_free, &device_total) != cudaSuccess) {
+      cudaGetLastError();  // reset the last CUDA error
+    }
+
+    AllocFailureInfo info;
+    info.device = device;
+    info.size = size;
+    info.stream = reinterpret_cast<int64_t>(stream);
+    info.free_bytes = device_free;
+    info.oom = oom;
+
+    if (alloc_failures.size() >= kAllocFailureHistory) {
+      alloc_failures.pop_front();
+    }
+    alloc_failures.push_back(info);
+  }
+
   void free_cached_blocks(int device)
   {
     // First ensure that all blocks that can't currently be allocated due to
@@ -696,6 +1142,23 @@ class THCCachingAllocator {
         small_blocks,
         small_blocks.lower_bound(&lower_bound),
         small_blocks.lower_bound(&upper_bound));
+
+    // Private pools of live graphs must keep their addresses stable and are
+    // skipped; see Note [Graph-private memory pools].
+    for (auto& entry : graph_pools) {
+      if (entry.second->use_count == 0) {
+        auto& pool = *entry.second;
+        free_blocks(
+            pool.large_blocks,
+            pool.large_blocks.lower_bound(&lower_bound),
+            pool.large_blocks.lower_bound(&upper_bound));
+        free_blocks(
+            pool.small_blocks,
+            pool.small_blocks.lower_bound(&lower_bound),
+            pool.small_blocks.lower_bound(&upper_bound));
+      }
+    }
+    trim_graph_pools();
   }
 
   void free_blocks(BlockPool& blocks, BlockPool::iterator it, BlockPool::iterator end)
@@ -704,7 +1167,14 @@ class THCCachingAllocator {
     while (it != end) {
       Block* block = *it;
       if (!block->prev && !block->next) {
-        C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+        if (block->expandable_segment != nullptr) {
+          release_expandable_segment(block);
+        } else {
+          C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+          if (PrivatePool* private_pool = private_pool_of(block->pool)) {
+            private_pool->cudaMalloc_count--;
+          }
+        }
 
         DeviceStats& stats = get_stats_for_device(block->device);
         StatTypes stat_types;
@@ -723,6 +1193,119 @@ class THCCachingAllocator {
     }
   }
 
+#ifdef C10_CUDA_EXPANDABLE_SEGMENTS
+  /** returns the growable segment for (device, stream), creating it on first
+   ** use; returns null if the device lacks VMM support or the reservation
+   ** failed (the answer is cached). See Note [Expandable segments]. */
+  ExpandableSegment* get_expandable_segment(int device, cudaStream_t stream) {
+    auto key = std::make_pair(device, stream);
+    auto it = expandable_segments_.find(key);
+    if (it != expandable_segments_.end()) {
+      return it->second;
+    }
+    ExpandableSegment* segment = nullptr;
+    int supported = 0;
+    if (driver_api()->deviceGetAttribute(
+            &supported,
+            CU_DEVICE_ATTRIBUTE_VIRTUAL_ADDRESS_MANAGEMENT_SUPPORTED,
+            device) == CUDA_SUCCESS &&
+        supported) {
+      segment = new ExpandableSegment();
+      if (!segment->reserve(device)) {
+        delete segment;
+        segment = nullptr;
+      }
+    }
+    expandable_segments_[key] = segment;
+    return segment;
+  }
+
+  /** maps more physical pages into `segment` and returns a block covering
+   ** the new space, merged with a free tail block if there is one. Returns
+   ** null if the device is out of physical pages. */
+  Block* try_expandable_alloc(
+      ExpandableSegment* segment,
+      int device,
+      cudaStream_t stream,
+      size_t size,
+      BlockPool& pool,
+      DeviceStats& stats,
+      const StatTypes& stat_types) {
+    Block* tail = segment->tail_block;
+    if (tail != nullptr && !tail->allocated && tail->event_count == 0) {
+      // Grow the free tail block in place. find_free_block would have
+      // matched it if it were already big enough.
+      AT_ASSERT(tail->size < size);
+      size_t delta = segment->expand(size - tail->size);
+      if (delta == 0) {
+        return nullptr;
+      }
+      update_stat_array(stats.reserved_bytes, delta, stat_types);
+      pool.erase(tail);
+      if (tail->is_split()) {
+        // The inactive split block is growing by delta bytes; the caller's
+        // split/activation accounting below assumes block->size is current.
+        update_stat_array(stats.inactive_split_bytes, delta, stat_types);
+      }
+      tail->size += delta;
+      return tail;
+    }
+    // The tail is in use (or there is none yet): append a fresh block after
+    // it. The new space is contiguous with the tail, so the two coalesce
+    // once the tail is freed.
+    size_t delta = segment->expand(size);
+    if (delta == 0) {
+      return nullptr;
+    }
+    if (segment->mapped_size == delta) {
+      update_stat_array(stats.segment, 1, stat_types);
+    }
+    update_stat_array(stats.reserved_bytes, delta, stat_types);
+    Block* block = new Block(
+        device,
+        stream,
+        delta,
+        &pool,
+        static_cast<char*>(segment->ptr()) + segment->mapped_size - delta);
+    block->expandable_segment = segment;
+    block->prev = tail;
+    if (tail != nullptr) {
+      tail->next = block;
+    }
+    segment->tail_block = block;
+    return block;
+  }
+
+  /** releases a fully-merged, fully-free expandable segment back to the
+   ** driver. The caller (free_blocks) handles the shared stats/pool/delete
+   ** bookkeeping. */
+  void release_expandable_segment(Block* block) {
+    ExpandableSegment* segment = block->expandable_segment;
+    // An unsplit free block in a growable segment necessarily spans all of
+    // its mapped space.
+    TORCH_INTERNAL_ASSERT(segment->mapped_size == block->size);
+    TORCH_INTERNAL_ASSERT(segment->tail_block == block);
+    segment->release();
+    expandable_segments_.erase(std::make_pair(block->device, block->stream));
+    delete segment;
+  }
+#else
+  ExpandableSegment* get_expandable_segment(int, cudaStream_t) {
+    return nullptr;
+  }
+  Block* try_expandable_alloc(
+      ExpandableSegment*,
+      int,
+      cudaStream_t,
+      size_t,
+      BlockPool&,
+      DeviceStats&,
+      const StatTypes&) {
+    return nullptr;
+  }
+  void release_expandable_segment(Block*) {}
+#endif // C10_CUDA_EXPANDABLE_SEGMENTS
+
   void synchronize_and_free_events(optional<int> device) {
     // Synchronize on outstanding events and then free associated blocks.
     // Limited to blocks on the given device if specified.
@@ -846,56 +1429,174 @@ struct CudaCachingAllocator : public Allocator {
 
 CudaCachingAllocator device_allocator;
 
+static inline void assertValidDevice(int device) {
+  int device_num = device_count();
+  AT_ASSERTM(0 <= device && device < device_num, "Invalid device argument.");
+}
+
+// The default backend: forwards everything to the caching allocator above.
+struct NativeCachingBackend final : AllocatorBackend {
+  Allocator* getDeviceAllocator() override {
+    return &device_allocator;
+  }
+
+  void* raw_alloc(size_t nbytes) override {
+    if (nbytes == 0) {
+      return nullptr;
+    }
+    int device;
+    C10_CUDA_CHECK(cudaGetDevice(&device));
+    void* r = nullptr;
+    caching_allocator.malloc(&r, nbytes, cuda::getCurrentCUDAStream(device));
+    return r;
+  }
+
+  void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream) override {
+    if (nbytes == 0) {
+      return nullptr;
+    }
+    void* r = nullptr;
+    caching_allocator.malloc(&r, nbytes, stream);
+    return r;
+  }
+
+  void raw_delete(void* ptr) override {
+    caching_allocator.free(ptr);
+  }
+
+  void recordStream(const DataPtr& ptr, cuda::CUDAStream stream) override {
+    caching_allocator.recordStream(ptr, stream);
+  }
+
+  std::mutex* getFreeMutex() override {
+    return caching_allocator.getCudaFreeMutex();
+  }
+
+  void emptyCache() override {
+    caching_allocator.emptyCache();
+  }
+
+  void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock)
+      override {
+    caching_allocator.cacheInfo(dev_id, cachedAndFree, largestBlock);
+  }
+
+  void* getBaseAllocation(void* ptr, size_t* size) override {
+    return caching_allocator.getBaseAllocation(ptr, size);
+  }
+
+  DeviceStats getDeviceStats(int device) override {
+    assertValidDevice(device);
+    return caching_allocator.getStatsForDevice(device);
+  }
+
+  void resetAccumulatedStats(int device) override {
+    assertValidDevice(device);
+    caching_allocator.resetAccumulatedStats(device);
+  }
+
+  void resetPeakStats(int device) override {
+    assertValidDevice(device);
+    caching_allocator.resetPeakStats(device);
+  }
+
+  std::vector<SegmentInfo> snapshot() override {
+    return caching_allocator.snapshot();
+  }
+
+  std::vector<AllocFailureInfo> allocationFailureHistory() override {
+    return caching_allocator.allocationFailureHistory();
+  }
+
+  void notifyCaptureBegin(CaptureId_t graph_id) override {
+    caching_allocator.notifyCaptureBegin(graph_id);
+  }
+
+  void notifyCaptureEnd(CaptureId_t graph_id) override {
+    caching_allocator.notifyCaptureEnd(graph_id);
+  }
+
+  void notifyCaptureDestroy(CaptureId_t graph_id) override {
+    caching_allocator.notifyCaptureDestroy(graph_id);
+  }
+};
+
+NativeCachingBackend native_backend;
+
+std::atomic<AllocatorBackend*> active_backend{&native_backend};
+
+std::mutex* AllocatorBackend::getFreeMutex() {
+  static std::mutex free_mutex;
+  return &free_mutex;
+}
+
+AllocatorBackend* allocatorBackend() {
+  return active_backend.load(std::memory_order_acquire);
+}
+
+void setAllocatorBackend(AllocatorBackend* backend) {
+  TORCH_CHECK(backend != nullptr, "allocator backend must not be null");
+  active_backend.store(backend, std::memory_order_release);
+}
+
 Allocator* get(void)
 {
-  return &device_allocator;
+  return allocatorBackend()->getDeviceAllocator();
 }
 
 void emptyCache(void) {
-  caching_allocator.emptyCache();
+  allocatorBackend()->emptyCache();
 }
 
 void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock) {
-  caching_allocator.cacheInfo(dev_id, cachedAndFree, largestBlock);
+  allocatorBackend()->cacheInfo(dev_id, cachedAndFree, largestBlock);
 }
 
 void* getBaseAllocation(void *ptr, size_t *size)
 {
-  return caching_allocator.getBaseAllocation(ptr, size);
+  return allocatorBackend()->getBaseAllocation(ptr, size);
 }
 
 void recordStream(const DataPtr& ptr, cuda::CUDAStream stream)
 {
-  caching_allocator.recordStream(ptr, stream);
+  allocatorBackend()->recordStream(ptr, stream);
 }
 
 std::mutex* getFreeMutex()
 {
-  return caching_allocator.getCudaFreeMutex();
-}
-
-static inline void assertValidDevice(int device) {
-  int device_num = device_count();
-  AT_ASSERTM(0 <= device && device < device_num, "Invalid device argument.");
+  return allocatorBackend()->getFreeMutex();
 }
 
 DeviceStats getDeviceStats(int device) {
-  assertValidDevice(device);
-  return caching_allocator.getStatsForDevice(device);
+  return allocatorBackend()->getDeviceStats(device);
 }
 
 void resetAccumulatedStats(int device) {
-  assertValidDevice(device);
-  caching_allocator.resetAccumulatedStats(device);
+  allocatorBackend()->resetAccumulatedStats(device);
 }
 
 void resetPeakStats(int device) {
-  assertValidDevice(device);
-  caching_allocator.resetPeakStats(device);
+  allocatorBackend()->resetPeakStats(device);
 }
 
 std::vector<SegmentInfo> snapshot() {
-  return caching_allocator.snapshot();
+  return allocatorBackend()->snapshot();
+}
+
+std::vector<AllocFailureInfo> allocationFailureHistory() {
+  return allocatorBackend()->allocationFailureHistory();
+}
+
+void notifyCaptureBegin(CaptureId_t graph_id) {
+  allocatorBackend()->notifyCaptureBegin(graph_id);
+}
+
+void notifyCaptureEnd(CaptureId_t graph_id) {
+  allocatorBackend()->notifyCaptureEnd(graph_id);
+}
+
+void notifyCaptureDestroy(CaptureId_t graph_id) {
+  allocatorBackend()->notifyCaptureDestroy(graph_id);
 }
 
 //
@@ -917,15 +1618,53 @@ std::vector<SegmentInfo> snapshot() {
 namespace {
   std::mutex IpcMutex;
   std::unordered_map<std::string, std::weak_ptr<void>> ipcMemHandle_to_devptr;
+
+  // Reuse pool: strong references to the most recently used mappings, so a
+  // base allocation whose consumer-side storages all transiently die is not
+  // unmapped and re-opened when the sender shares the next tensor out of the
+  // same block. cudaIpcOpenMemHandle is expensive, and workloads that stream
+  // thousands of small tensors through a handful of sender allocations hit
+  // this constantly. Eviction only drops the pool's reference; the mapping
+  // closes once outstanding storages release theirs too.
+  constexpr size_t kIpcMappingPoolSize = 64;
+  std::list<std::pair<std::string, std::shared_ptr<void>>> ipcMappingPool;
+
+  // Moves (or inserts) the handle's entry to the back of the pool and
+  // evicts the least recently used entry beyond capacity. Caller must hold
+  // IpcMutex. The evicted reference is returned instead of dropped in place:
+  // releasing it can run the mapping's deleter, which takes IpcMutex, so the
+  // caller must let it go out of scope after unlocking.
+  std::shared_ptr<void> touchIpcMappingPool(
+      const std::string& handle, const std::shared_ptr<void>& devptr) {
+    for (auto it = ipcMappingPool.begin(); it != ipcMappingPool.end(); ++it) {
+      if (it->first == handle) {
+        ipcMappingPool.splice(ipcMappingPool.end(), ipcMappingPool, it);
+        return nullptr;
+      }
+    }
+    ipcMappingPool.emplace_back(handle, devptr);
+    if (ipcMappingPool.size() > kIpcMappingPoolSize) {
+      auto evicted = std::move(ipcMappingPool.front().second);
+      ipcMappingPool.pop_front();
+      return evicted;
+    }
+    return nullptr;
+  }
 }
 
 std::shared_ptr<void> getIpcDevPtr(std::string handle) {
+  // Declared before the lock so an evicted mapping is released after
+  // IpcMutex is dropped (its deleter re-takes the mutex).
+  std::shared_ptr<void> evicted;
   std::lock_guard<std::mutex> lock(IpcMutex);
 
   auto iter = ipcMemHandle_to_devptr.find(handle);
   if (iter != ipcMemHandle_to_devptr.end()) {
     auto devptr = iter->second.lock();
-    if (devptr) return devptr;
+    if (devptr) {
+      evicted = touchIpcMappingPool(handle, devptr);
+      return devptr;
+    }
   }
   // This ipcMemHandle hasn't been opened, or already expired, open it to
   // enable IPC access to that mem block.
@@ -948,32 +1687,21 @@ std::shared_ptr<void> getIpcDevPtr(std::string handle) {
   // But in the deleter for sp we erased the entry,
   // this should be safe to do now.
   ipcMemHandle_to_devptr.insert(iter, {handle, wp});
+  evicted = touchIpcMappingPool(handle, sp);
 
   return sp;
 }
 
 void* raw_alloc(size_t nbytes) {
-  if (nbytes == 0) {
-    return nullptr;
-  }
-  int device;
-  C10_CUDA_CHECK(cudaGetDevice(&device));
-  void* r = nullptr;
-  caching_allocator.malloc(&r, nbytes, cuda::getCurrentCUDAStream(device));
-  return r;
+  return allocatorBackend()->raw_alloc(nbytes);
 }
 
 void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream) {
-  if (nbytes == 0) {
-    return nullptr;
-  }
-  void* r = nullptr;
-  caching_allocator.malloc(&r, nbytes, stream);
-  return r;
+  return allocatorBackend()->raw_alloc_with_stream(nbytes, stream);
 }
 
 void raw_delete(void* ptr) {
-  caching_allocator.free(ptr);
+  allocatorBackend()->raw_delete(ptr);
 }
 
 } // namespace CUDACachingAllocator
@@ -98,6 +98,9 @@ struct BlockInfo {
 struct SegmentInfo {
   int64_t device = 0;
   int64_t address = 0;
+  // The stream the segment was allocated on; all blocks split out of a
+  // segment share it.
+  int64_t stream = 0;
   int64_t total_size = 0;
   int64_t allocated_size = 0;
   int64_t active_size = 0;
@@ -105,6 +108,94 @@ struct SegmentInfo {
   std::vector<BlockInfo> blocks;
 };
 
+// Record of a single failed cudaMalloc. The allocator keeps a bounded
+// history of these (oldest entries are dropped) so that OOMs and cache
+// flushes observed in production can be attributed to specific allocation
+// patterns after the fact, together with snapshot().
+struct AllocFailureInfo {
+  int64_t device = 0;
+  // Allocation size that failed and the stream that requested it.
+  int64_t size = 0;
+  int64_t stream = 0;
+  // Free device memory as reported by CUDA at the time of the failure.
+  int64_t free_bytes = 0;
+  // True if the failure persisted after flushing cached blocks, i.e. the
+  // allocation ultimately raised an out-of-memory error.
+  bool oom = false;
+};
+
+// Identifies the private memory pool backing one CUDA graph capture;
+// see Note [Graph-private memory pools] in CUDACachingAllocator.cpp.
+typedef unsigned long long CaptureId_t;
+
+// Interface implemented by a CUDA allocation backend. The caching allocator
+// in CUDACachingAllocator.cpp is the default; a different policy (e.g. a
+// slab allocator for graph-static inference workloads) can be installed
+// process-wide with setAllocatorBackend(). The free functions below forward
+// to the active backend, so the rest of the codebase is policy-agnostic.
+class C10_CUDA_API AllocatorBackend {
+ public:
+  virtual ~AllocatorBackend() {}
+
+  // The c10 Allocator handing out DataPtrs for tensor storage.
+  virtual Allocator* getDeviceAllocator() = 0;
+
+  virtual void* raw_alloc(size_t nbytes) = 0;
+  virtual void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream) = 0;
+  virtual void raw_delete(void* ptr) = 0;
+
+  // Marks the memory of `ptr' as used on `stream' so it is not handed out
+  // again (or returned to CUDA) before outstanding work on that stream
+  // finishes. Backends that hand each allocation straight to cudaMalloc and
+  // only free after synchronizing may leave this a no-op.
+  virtual void recordStream(const DataPtr& /* ptr */, CUDAStream /* stream */) {
+  }
+
+  // Mutex serializing allocations against cudaFree; NCCL takes it around
+  // grouped launches. The default is a plain process-wide mutex.
+  virtual std::mutex* getFreeMutex();
+
+  // Cache management and introspection. Optional: the defaults do nothing
+  // and report nothing, which is correct for backends that neither cache
+  // nor track.
+  virtual void emptyCache() {}
+  virtual void cacheInfo(
+      int /* dev_id */,
+      size_t* /* cachedAndFree */,
+      size_t* /* largestBlock */) {}
+  virtual void* getBaseAllocation(void* ptr, size_t* size) {
+    if (size) {
+      *size = 0;
+    }
+    return ptr;
+  }
+  virtual DeviceStats getDeviceStats(int /* device */) {
+    return DeviceStats();
+  }
+  virtual void resetAccumulatedStats(int /* device */) {}
+  virtual void resetPeakStats(int /* device */) {}
+  virtual std::vector<SegmentInfo> snapshot() {
+    return {};
+  }
+  virtual std::vector<AllocFailureInfo> allocationFailureHistory() {
+    return {};
+  }
+
+  // CUDA graph capture notifications; see notifyCaptureBegin below.
+  virtual void notifyCaptureBegin(CaptureId_t /* graph_id */) {}
+  virtual void notifyCaptureEnd(CaptureId_t /* graph_id */) {}
+  virtual void notifyCaptureDestroy(CaptureId_t /* graph_id */) {}
+};
+
+// Returns the active backend (the built-in caching allocator by default).
+C10_CUDA_API AllocatorBackend* allocatorBackend();
+
+// Installs `backend' as the process-wide allocation backend. Must be called
+// before any CUDA allocation is made: pointers are not migrated, so memory
+// obtained from one backend must never be freed through another. The caller
+// keeps ownership and must keep `backend' alive for the process lifetime.
+C10_CUDA_API void setAllocatorBackend(AllocatorBackend* backend);
+
 C10_CUDA_API void* raw_alloc(size_t nbytes);
 C10_CUDA_API void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream);
 C10_CUDA_API void raw_delete(void* ptr);
@@ -118,6 +209,14 @@ C10_CUDA_API DeviceStats getDeviceStats(int device);
 C10_CUDA_API void resetAccumulatedStats(int device);
 C10_CUDA_API void resetPeakStats(int device);
 C10_CUDA_API std::vector<SegmentInfo> snapshot();
+C10_CUDA_API std::vector<AllocFailureInfo> allocationFailureHistory();
+
+// Called by at::cuda::CUDAGraph around stream capture. Between begin and
+// end, all allocations are served from a private pool tied to `graph_id`,
+// whose addresses stay stable until notifyCaptureDestroy releases them.
+C10_CUDA_API void notifyCaptureBegin(CaptureId_t graph_id);
+C10_CUDA_API void notifyCaptureEnd(CaptureId_t graph_id);
+C10_CUDA_API void notifyCaptureDestroy(CaptureId_t graph_id);
 
 C10_CUDA_API std::mutex* getFreeMutex();
 
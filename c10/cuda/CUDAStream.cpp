@@ -321,6 +321,18 @@ cudaStream_t CUDAStream::stream() const {
   return ptr->stream;
 }
 
+bool CUDAStream::isCapturing() const {
+#if !defined(__HIP_PLATFORM_HCC__) && defined(CUDART_VERSION) && \
+    CUDART_VERSION >= 10000
+  DeviceGuard guard{stream_.device()};
+  cudaStreamCaptureStatus status;
+  C10_CUDA_CHECK(cudaStreamIsCapturing(stream(), &status));
+  return status != cudaStreamCaptureStatusNone;
+#else
+  return false;
+#endif
+}
+
 // Returns a stream from the requested pool
 // Note: when called the first time on a device, this will create the
 // stream pools for that device.
@@ -119,6 +119,13 @@ public:
     C10_CUDA_CHECK(cudaStreamSynchronize(stream()));
   }
 
+  /// Returns true if this stream is currently capturing work for a CUDA
+  /// graph (via cudaStreamBeginCapture). Always false on platforms without
+  /// stream capture support. Code that issues operations which are illegal
+  /// during capture (e.g. cudaFree, device synchronization) should check
+  /// this first.
+  bool isCapturing() const;
+
   int priority() const {
     #ifndef __HIP_PLATFORM_HCC__
       DeviceGuard guard{stream_.device()};
@@ -144,6 +144,16 @@ namespace at { namespace cuda { using namespace c10::hip; }}
 #define C10_UNLIKELY(expr)  (expr)
 #endif
 
+// C10_NOINLINE - Functions whose definition should never be inlined into
+// callers, e.g. cold slow paths kept out of a hot function's code size.
+#if defined(_MSC_VER)
+#define C10_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define C10_NOINLINE __attribute__((noinline))
+#else
+#define C10_NOINLINE
+#endif
+
 #include <sstream>
 #include <string>
 
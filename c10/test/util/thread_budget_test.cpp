@@ -0,0 +1,41 @@
+#include <c10/util/Exception.h>
+#include <c10/util/thread_budget.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(ThreadBudgetTest, OverrideAndRestore) {
+  const auto default_budget = c10::GetThreadBudget();
+  EXPECT_GE(default_budget, 1);
+
+  c10::SetThreadBudget(8);
+  EXPECT_EQ(c10::GetThreadBudget(), 8);
+
+  c10::SetThreadBudget(0);
+  EXPECT_EQ(c10::GetThreadBudget(), default_budget);
+}
+
+TEST(ThreadBudgetTest, Shares) {
+  c10::SetThreadBudget(8);
+
+  // unconfigured pools fall back to the caller-provided default share
+  EXPECT_EQ(c10::GetBudgetedNumThreads("test_pool", 1.0), 8);
+  EXPECT_EQ(c10::GetBudgetedNumThreads("test_pool", 0.5), 4);
+
+  c10::SetThreadBudgetShare("test_pool", 0.25);
+  EXPECT_EQ(c10::GetBudgetedNumThreads("test_pool", 1.0), 2);
+
+  // shares are clamped to at least one thread
+  c10::SetThreadBudgetShare("tiny_pool", 0.01);
+  EXPECT_EQ(c10::GetBudgetedNumThreads("tiny_pool", 1.0), 1);
+
+  EXPECT_THROW(
+      c10::SetThreadBudgetShare("test_pool", 0.0), c10::Error);
+  EXPECT_THROW(
+      c10::SetThreadBudgetShare("test_pool", 1.5), c10::Error);
+
+  c10::SetThreadBudget(0);
+}
+
+} // namespace
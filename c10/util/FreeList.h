@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace c10 {
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define C10_FREELIST_DISABLED
+#endif
+#elif defined(__SANITIZE_ADDRESS__)
+#define C10_FREELIST_DISABLED
+#endif
+
+/**
+ * A bounded per-thread free list of fixed-size heap blocks.
+ *
+ * Interpreted code creates and destroys small refcounted nodes (tuples,
+ * constant strings, lists) at instruction rate, and the malloc/free pair
+ * per node dominates the cost of constructing the value itself. FreeList<T>
+ * recycles the most recently freed block instead of returning it to the
+ * allocator, so a construct/destroy churn pattern runs entirely out of the
+ * (cache-hot) list. Intended to back class-specific operator new/delete of
+ * a final class T:
+ *
+ *   static void* operator new(std::size_t) {
+ *     return c10::FreeList<T>::get().allocate();
+ *   }
+ *   static void operator delete(void* ptr) {
+ *     c10::FreeList<T>::get().deallocate(ptr);
+ *   }
+ *
+ * T must be final (so every block has exactly sizeof(T) bytes) and at
+ * least pointer-sized (the next link is stored in the freed block). Blocks
+ * may be freed on a different thread than the one that allocated them;
+ * they simply migrate to the freeing thread's list. The list depth is
+ * bounded, so an idle thread retains at most kMaxDepth * sizeof(T) bytes,
+ * and everything is returned to the allocator when the thread exits.
+ *
+ * Under AddressSanitizer the list is disabled so that use-after-free on
+ * recycled nodes is still caught.
+ */
+template <typename T>
+class FreeList final {
+  static_assert(
+      sizeof(T) >= sizeof(void*),
+      "FreeList blocks store the next link in the freed block");
+
+ public:
+  static constexpr size_t kMaxDepth = 1024;
+
+  FreeList() = default;
+  FreeList(const FreeList&) = delete;
+  FreeList& operator=(const FreeList&) = delete;
+
+  ~FreeList() {
+    while (head_ != nullptr) {
+      void* next = *static_cast<void**>(head_);
+      ::operator delete(head_);
+      head_ = next;
+    }
+  }
+
+  void* allocate() {
+#ifndef C10_FREELIST_DISABLED
+    if (head_ != nullptr) {
+      void* block = head_;
+      head_ = *static_cast<void**>(block);
+      --depth_;
+      return block;
+    }
+#endif
+    return ::operator new(sizeof(T));
+  }
+
+  void deallocate(void* block) {
+#ifndef C10_FREELIST_DISABLED
+    if (depth_ < kMaxDepth) {
+      *static_cast<void**>(block) = head_;
+      head_ = block;
+      ++depth_;
+      return;
+    }
+#endif
+    ::operator delete(block);
+  }
+
+  static FreeList& get() {
+    static thread_local FreeList list;
+    return list;
+  }
+
+ private:
+  void* head_ = nullptr;
+  size_t depth_ = 0;
+};
+
+#undef C10_FREELIST_DISABLED
+
+} // namespace c10
@@ -0,0 +1,73 @@
+#include <c10/util/thread_budget.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace c10 {
+
+namespace {
+
+// 0 - use the default budget (number of physical cores)
+std::atomic<size_t> thread_budget{0};
+
+std::mutex& sharesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, double>& shares() {
+  static std::unordered_map<std::string, double> shares;
+  return shares;
+}
+
+size_t defaultThreadBudget() {
+  auto num_threads = std::thread::hardware_concurrency();
+#if defined(_M_X64) || defined(__x86_64__)
+  // hardware_concurrency() counts hyperthreads; budget physical cores
+  num_threads /= 2;
+#endif
+  return std::max<size_t>(num_threads, 1);
+}
+
+} // namespace
+
+size_t GetThreadBudget() {
+  size_t budget = thread_budget.load();
+  return budget > 0 ? budget : defaultThreadBudget();
+}
+
+void SetThreadBudget(size_t budget) {
+  thread_budget = budget;
+}
+
+void SetThreadBudgetShare(const std::string& pool_name, double share) {
+  TORCH_CHECK(
+      share > 0.0 && share <= 1.0,
+      "Thread budget share for pool ",
+      pool_name,
+      " must be in (0, 1], got ",
+      share);
+  std::lock_guard<std::mutex> lock(sharesMutex());
+  shares()[pool_name] = share;
+}
+
+size_t GetBudgetedNumThreads(
+    const std::string& pool_name,
+    double default_share) {
+  double share = default_share;
+  {
+    std::lock_guard<std::mutex> lock(sharesMutex());
+    auto it = shares().find(pool_name);
+    if (it != shares().end()) {
+      share = it->second;
+    }
+  }
+  return std::max<size_t>(
+      static_cast<size_t>(GetThreadBudget() * share), 1);
+}
+
+} // namespace c10
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstddef>
+#include <string>
+
+namespace c10 {
+
+/**
+ * Returns the process-wide thread budget: the total number of threads that
+ * thread pools in this process should size themselves against. Defaults to
+ * the number of physical cores.
+ */
+C10_API size_t GetThreadBudget();
+
+/**
+ * Overrides the process-wide thread budget; pass 0 to restore the default.
+ * Only affects pools created afterwards.
+ */
+C10_API void SetThreadBudget(size_t budget);
+
+/**
+ * Sets the share of the thread budget assigned to the pool registered under
+ * `pool_name` (e.g. "intraop", "interop"). `share` must be in (0, 1].
+ */
+C10_API void SetThreadBudgetShare(const std::string& pool_name, double share);
+
+/**
+ * Returns the number of threads the pool registered under `pool_name` should
+ * use by default: its configured share of the budget, or `default_share` if
+ * no share has been configured, clamped to at least one thread. Explicit
+ * sizing (e.g. set_num_threads) still takes precedence in the callers.
+ */
+C10_API size_t GetBudgetedNumThreads(
+    const std::string& pool_name,
+    double default_share);
+
+} // namespace c10
@@ -1,28 +1,82 @@
 #include "caffe2/serialize/file_adapter.h"
 #include <c10/util/Exception.h>
+#include <cerrno>
 #include "caffe2/core/common.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace caffe2 {
 namespace serialize {
 
 FileAdapter::FileAdapter(const std::string& file_name) {
+#ifndef _WIN32
+  fd_ = open(file_name.c_str(), O_RDONLY);
+  if (fd_ == -1) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  struct stat st;
+  if (fstat(fd_, &st) == -1) {
+    close(fd_);
+    fd_ = -1;
+    AT_ERROR("stat file failed, file path: ", file_name);
+  }
+  size_ = st.st_size;
+#else
   file_stream_.open(file_name, std::ifstream::in | std::ifstream::binary);
   if (!file_stream_) {
     AT_ERROR("open file failed, file path: ", file_name);
   }
   istream_adapter_ = std::make_unique<IStreamAdapter>(&file_stream_);
+#endif
 }
 
 size_t FileAdapter::size() const {
+#ifndef _WIN32
+  return size_;
+#else
   return istream_adapter_->size();
+#endif
 }
 
 size_t FileAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
     const {
+#ifndef _WIN32
+  size_t total = 0;
+  while (total < n) {
+    ssize_t ret = pread(
+        fd_, static_cast<char*>(buf) + total, n - total, pos + total);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AT_ERROR("file read failed ", what);
+    }
+    if (ret == 0) { // end of file
+      break;
+    }
+    total += ret;
+  }
+  return total;
+#else
   return istream_adapter_->read(pos, buf, n, what);
+#endif
 }
 
-FileAdapter::~FileAdapter() {}
+bool FileAdapter::supportsConcurrentReads() const {
+  return fd_ != -1;
+}
+
+FileAdapter::~FileAdapter() {
+#ifndef _WIN32
+  if (fd_ != -1) {
+    close(fd_);
+  }
+#endif
+}
 
 } // namespace serialize
 } // namespace caffe2
@@ -17,9 +17,15 @@ class CAFFE2_API FileAdapter final : public ReadAdapterInterface {
   size_t size() const override;
   size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const override;
+  bool supportsConcurrentReads() const override;
   ~FileAdapter();
 
  private:
+  // On POSIX the file is read with pread(2), which is positional and safe to
+  // call from multiple threads at once; file_stream_ is only used as a
+  // fallback where pread is unavailable.
+  int fd_ = -1;
+  uint64_t size_ = 0;
   std::ifstream file_stream_;
   std::unique_ptr<IStreamAdapter> istream_adapter_;
 };
@@ -1,9 +1,22 @@
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <cerrno>
+#include <functional>
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -50,10 +63,80 @@ size_t PyTorchStreamReader::read(uint64_t pos, char* buf, size_t n) {
   return in_->read(pos, buf, n, "reading file");
 }
 
+// A private (copy-on-write) mapping of the whole archive file. Mapped
+// records stay valid for as long as any of them holds a reference, even
+// after the reader itself is destroyed.
+struct MemoryMappedFile {
+#ifndef _WIN32
+  void* base = nullptr;
+  size_t size = 0;
+
+  static std::shared_ptr<MemoryMappedFile> tryMap(
+      const std::string& file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+      close(fd);
+      return nullptr;
+    }
+    // MAP_PRIVATE + PROT_WRITE gives copy-on-write pages, so callers that
+    // mutate a loaded storage behave exactly as with the malloc'd copy and
+    // never write back to the file. Clean pages are shared with the page
+    // cache (and thus across worker processes).
+    void* base = mmap(
+        nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+      return nullptr;
+    }
+    auto result = std::make_shared<MemoryMappedFile>();
+    result->base = base;
+    result->size = st.st_size;
+    return result;
+  }
+
+  MemoryMappedFile() = default;
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  ~MemoryMappedFile() {
+    if (base != nullptr) {
+      munmap(base, size);
+    }
+  }
+#endif
+};
+
+#ifndef _WIN32
+static void deleteMemoryMappedFileRef(void* ctx) {
+  delete static_cast<std::shared_ptr<MemoryMappedFile>*>(ctx);
+}
+
+static bool mmapEnabled() {
+  // Opt-out switch in case a deployment needs the old copying behavior
+  // (e.g. the archive file may be truncated while tensors are alive).
+  static const bool enabled = []() {
+    const char* flag = getenv("TORCH_SERIALIZATION_MMAP");
+    return flag == nullptr || strcmp(flag, "0") != 0;
+  }();
+  return enabled;
+}
+#endif
+
 PyTorchStreamReader::PyTorchStreamReader(const std::string& file_name)
     : ar_(std::make_unique<mz_zip_archive>()),
       in_(std::make_unique<FileAdapter>(file_name)) {
   init();
+#ifndef _WIN32
+  if (mmapEnabled()) {
+    // Failure to map (exotic filesystem, out of address space, ...) is not
+    // an error; getRecord just keeps copying through miniz.
+    mapped_file_ = MemoryMappedFile::tryMap(file_name);
+  }
+#endif
 }
 
 PyTorchStreamReader::PyTorchStreamReader(std::istream* in)
@@ -179,18 +262,65 @@ static size_t getPadding(
   return padding_size_plus_fbxx;
 }
 
+// Chunked-record framing (see writeChunkedRecord in inline_container.h): an
+// index record describing the split plus one compressed record per block.
+constexpr const char* kChunkedIndexSuffix = ".zindex";
+constexpr const char* kChunkedBlockInfix = ".zblock.";
+
+struct ChunkedRecordIndex {
+  uint64_t magic;
+  uint64_t uncompressed_size;
+  uint64_t block_size;
+  uint64_t num_blocks;
+};
+
+// Runs fn(block) for every block index, spread over up to
+// hardware_concurrency threads (the calling thread included). fn must
+// record its own failures; exceptions may not cross thread boundaries.
+static void forEachBlockInParallel(
+    size_t num_blocks,
+    const std::function<void(size_t)>& fn) {
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    size_t i;
+    while ((i = next++) < num_blocks) {
+      fn(i);
+    }
+  };
+  size_t num_threads = std::min(
+      num_blocks,
+      static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 bool PyTorchStreamReader::hasRecord(const std::string& name) {
+  std::lock_guard<std::mutex> guard(reader_lock_);
   std::string ss = archive_name_plus_slash_ + name;
   mz_zip_reader_locate_file(ar_.get(), ss.c_str(), nullptr, 0);
   bool result = ar_->m_last_error != MZ_ZIP_FILE_NOT_FOUND;
   if (!result) {
+    // a chunked record is present through its index record
     ar_->m_last_error = MZ_ZIP_NO_ERROR;
+    std::string index_ss = ss + kChunkedIndexSuffix;
+    mz_zip_reader_locate_file(ar_.get(), index_ss.c_str(), nullptr, 0);
+    result = ar_->m_last_error != MZ_ZIP_FILE_NOT_FOUND;
+    if (!result) {
+      ar_->m_last_error = MZ_ZIP_NO_ERROR;
+    }
   }
   valid("attempting to locate file ", name.c_str());
   return result;
 }
 
 std::vector<std::string> PyTorchStreamReader::getAllRecords() {
+  std::lock_guard<std::mutex> guard(reader_lock_);
   mz_uint num_files = mz_zip_reader_get_num_files(ar_.get());
   std::vector<std::string> out;
   char buf[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
@@ -212,11 +342,69 @@ size_t PyTorchStreamReader::getRecordID(const std::string& name) {
 }
 
 // return dataptr, size
+//
+// When the archive was opened by file name, is mmapped, and the record is
+// stored rather than deflated, the returned DataPtr points straight into
+// the mapped file pages: loading skips the copy entirely and multiple
+// processes reading the same model share page cache. The DataPtr's context
+// keeps the mapping alive, so records may outlive the reader.
 std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string& name) {
+  std::unique_lock<std::mutex> lock(reader_lock_);
+  {
+    // Records written by writeChunkedRecord exist only as an index plus
+    // block records; reassemble them transparently.
+    std::string ss = archive_name_plus_slash_ + name;
+    mz_zip_reader_locate_file(ar_.get(), ss.c_str(), nullptr, 0);
+    if (ar_->m_last_error == MZ_ZIP_FILE_NOT_FOUND) {
+      ar_->m_last_error = MZ_ZIP_NO_ERROR;
+      std::string index_ss = ss + kChunkedIndexSuffix;
+      mz_zip_reader_locate_file(ar_.get(), index_ss.c_str(), nullptr, 0);
+      if (ar_->m_last_error != MZ_ZIP_FILE_NOT_FOUND) {
+        valid("locating chunked record ", name.c_str());
+        lock.unlock();
+        return getChunkedRecord(name);
+      }
+      ar_->m_last_error = MZ_ZIP_NO_ERROR;
+      // fall through: getRecordID reports the record as missing
+    }
+  }
   size_t key = getRecordID(name);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
+#ifndef _WIN32
+  if (mapped_file_ != nullptr && stat.m_method == 0 /* stored */) {
+    size_t offset = dataOffsetFromLocalHeader(stat.m_local_header_ofs);
+    // PyTorchStreamWriter aligns record data to kFieldAlignment; archives
+    // from other zip tools may not, and consumers assume tensor data is
+    // suitably aligned, so fall back to copying for those.
+    if (offset % kFieldAlignment == 0 &&
+        offset + stat.m_uncomp_size <= mapped_file_->size) {
+      void* data = static_cast<uint8_t*>(mapped_file_->base) + offset;
+      at::DataPtr retval(
+          data,
+          new std::shared_ptr<MemoryMappedFile>(mapped_file_),
+          deleteMemoryMappedFileRef,
+          at::kCPU);
+      return std::make_tuple(std::move(retval), stat.m_uncomp_size);
+    }
+  }
+#endif
+  if (stat.m_method == 0 /* stored */ && in_->supportsConcurrentReads()) {
+    // For stored records the bytes on disk are the record; read them
+    // directly with the lock released so concurrent getRecord calls keep
+    // the disk queue full instead of serializing on the miniz state.
+    size_t offset = dataOffsetFromLocalHeader(stat.m_local_header_ofs);
+    size_t size = stat.m_uncomp_size;
+    lock.unlock();
+    void* ptr = malloc(size);
+    at::DataPtr retval(ptr, ptr, free, at::kCPU);
+    size_t read_bytes = in_->read(offset, ptr, size, "reading record");
+    if (read_bytes != size) {
+      CAFFE_THROW("record ", name, ": file is truncated");
+    }
+    return std::make_tuple(std::move(retval), size);
+  }
   void * ptr = malloc(stat.m_uncomp_size);
   mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
   valid("reading file ", name.c_str());
@@ -225,23 +413,77 @@ std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string
   return std::make_tuple(std::move(retval), stat.m_uncomp_size);
 }
 
+std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getChunkedRecord(
+    const std::string& name) {
+  at::DataPtr index_ptr;
+  size_t index_size;
+  std::tie(index_ptr, index_size) = getRecord(name + kChunkedIndexSuffix);
+  ChunkedRecordIndex index;
+  if (index_size != sizeof(index)) {
+    CAFFE_THROW("chunked record ", name, ": malformed index record");
+  }
+  memcpy(&index, index_ptr.get(), sizeof(index));
+  if (index.magic != kChunkedRecordMagic || index.block_size == 0 ||
+      index.num_blocks !=
+          (index.uncompressed_size + index.block_size - 1) / index.block_size) {
+    CAFFE_THROW("chunked record ", name, ": malformed index record");
+  }
+  void* dst = malloc(index.uncompressed_size);
+  at::DataPtr result(dst, dst, free, at::kCPU);
+  // Blocks are independent, so they are fetched (getRecord is thread-safe)
+  // and inflated in parallel, each into its slice of the output buffer.
+  std::atomic<bool> failed(false);
+  forEachBlockInParallel(index.num_blocks, [&](size_t k) {
+    try {
+      at::DataPtr block_ptr;
+      size_t block_size;
+      std::tie(block_ptr, block_size) =
+          getRecord(name + kChunkedBlockInfix + c10::to_string(k));
+      uint64_t offset = k * index.block_size;
+      mz_ulong dest_len = static_cast<mz_ulong>(
+          std::min(index.block_size, index.uncompressed_size - offset));
+      const mz_ulong expected_len = dest_len;
+      if (mz_uncompress(
+              static_cast<unsigned char*>(dst) + offset,
+              &dest_len,
+              static_cast<const unsigned char*>(block_ptr.get()),
+              block_size) != MZ_OK ||
+          dest_len != expected_len) {
+        failed = true;
+      }
+    } catch (...) {
+      failed = true;
+    }
+  });
+  if (failed) {
+    CAFFE_THROW("chunked record ", name, ": block decompression failed");
+  }
+  return std::make_tuple(std::move(result), index.uncompressed_size);
+}
+
 static int64_t read_le_16(uint8_t* buf) {
   return buf[0] + (buf[1] << 8);
 }
 
-size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
-  mz_zip_archive_file_stat stat;
-  mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
-  valid("retrieving file meta-data for ", name.c_str());
+size_t PyTorchStreamReader::dataOffsetFromLocalHeader(
+    uint64_t local_header_ofs) {
   uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
   in_->read(
-      stat.m_local_header_ofs,
+      local_header_ofs,
       local_header,
       MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
       "reading file header");
   size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
   size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
-  return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+  return local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+}
+
+size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
+  std::lock_guard<std::mutex> guard(reader_lock_);
+  mz_zip_archive_file_stat stat;
+  mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
+  valid("retrieving file meta-data for ", name.c_str());
+  return dataOffsetFromLocalHeader(stat.m_local_header_ofs);
 }
 
 
@@ -338,6 +580,49 @@ void PyTorchStreamWriter::writeRecord(
   valid("writing file ", name.c_str());
 }
 
+void PyTorchStreamWriter::writeChunkedRecord(
+    const std::string& name,
+    const void* data,
+    size_t size) {
+  const size_t num_blocks =
+      (size + kChunkedRecordBlockSize - 1) / kChunkedRecordBlockSize;
+  std::vector<std::vector<unsigned char>> blocks(num_blocks);
+  const auto* src = static_cast<const unsigned char*>(data);
+  std::atomic<bool> failed(false);
+  forEachBlockInParallel(num_blocks, [&](size_t k) {
+    size_t offset = k * kChunkedRecordBlockSize;
+    mz_ulong src_len = static_cast<mz_ulong>(
+        std::min(kChunkedRecordBlockSize, size - offset));
+    mz_ulong dest_len = mz_compressBound(src_len);
+    blocks[k].resize(dest_len);
+    if (mz_compress2(
+            blocks[k].data(),
+            &dest_len,
+            src + offset,
+            src_len,
+            MZ_DEFAULT_COMPRESSION) != MZ_OK) {
+      failed = true;
+      return;
+    }
+    blocks[k].resize(dest_len);
+  });
+  if (failed) {
+    CAFFE_THROW("chunked record ", name, ": block compression failed");
+  }
+  ChunkedRecordIndex index;
+  index.magic = kChunkedRecordMagic;
+  index.uncompressed_size = size;
+  index.block_size = kChunkedRecordBlockSize;
+  index.num_blocks = num_blocks;
+  writeRecord(name + kChunkedIndexSuffix, &index, sizeof(index));
+  for (size_t k = 0; k < num_blocks; ++k) {
+    writeRecord(
+        name + kChunkedBlockInfix + c10::to_string(k),
+        blocks[k].data(),
+        blocks[k].size());
+  }
+}
+
 void PyTorchStreamWriter::writeEndOfFile() {
   AT_ASSERT(!finalized_);
   finalized_ = true;
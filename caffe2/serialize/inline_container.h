@@ -5,6 +5,8 @@
 #include <cstring>
 #include <fstream>
 #include <istream>
+#include <memory>
+#include <mutex>
 #include <ostream>
 
 #include <c10/core/Allocator.h>
@@ -90,6 +92,10 @@ typedef struct mz_zip_archive mz_zip_archive;
 namespace caffe2 {
 namespace serialize {
 
+// A shared, reference-counted mmap of an archive file. See the note above
+// PyTorchStreamReader::getRecord in inline_container.cc.
+struct MemoryMappedFile;
+
 constexpr uint64_t kMinSupportedFileFormatVersion = 0x1L;
 constexpr uint64_t kMaxSupportedFileFormatVersion = 0x3L;
 
@@ -102,6 +108,12 @@ constexpr uint64_t kProducedFileFormatVersion = 0x3L;
 // Writer-specific constants
 constexpr uint64_t kFieldAlignment = 64;
 
+// Chunked-compression constants (see writeChunkedRecord). The block size is
+// the unit of parallel (de)compression; 1MiB keeps per-block overhead low
+// while still fanning a large storage out over every core.
+constexpr uint64_t kChunkedRecordMagic = 0x314b4e48435a5450UL; // "PTZCHNK1"
+constexpr size_t kChunkedRecordBlockSize = 1 << 20;
+
 class CAFFE2_API PyTorchStreamReader final {
  public:
   explicit PyTorchStreamReader(const std::string& file_name);
@@ -109,6 +121,9 @@ class CAFFE2_API PyTorchStreamReader final {
   explicit PyTorchStreamReader(std::unique_ptr<ReadAdapterInterface> in);
 
   // return dataptr, size
+  // Thread-safe: record lookups are serialized internally, and for stored
+  // records on a concurrent-read adapter the payload is read outside the
+  // lock, so several threads can pull records at full disk bandwidth.
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
   bool hasRecord(const std::string& name);
@@ -124,6 +139,8 @@ class CAFFE2_API PyTorchStreamReader final {
   size_t read(uint64_t pos, char* buf, size_t n);
   void valid(const char* what, const char* info = "");
   size_t getRecordID(const std::string& name);
+  size_t dataOffsetFromLocalHeader(uint64_t local_header_ofs);
+  std::tuple<at::DataPtr, size_t> getChunkedRecord(const std::string& name);
 
   friend size_t
   istream_read_func(void* pOpaque, uint64_t file_ofs, void* pBuf, size_t n);
@@ -132,6 +149,14 @@ class CAFFE2_API PyTorchStreamReader final {
   std::string archive_name_plus_slash_;
   std::unique_ptr<ReadAdapterInterface> in_;
   int64_t version_;
+  // Guards the miniz archive state and any adapter without concurrent-read
+  // support; see getRecord().
+  std::mutex reader_lock_;
+  // Set when the archive was opened by file name and could be mmapped;
+  // uncompressed records are then returned as pointers into the mapping
+  // instead of heap copies. Records share ownership of the mapping, so it
+  // can outlive the reader.
+  std::shared_ptr<MemoryMappedFile> mapped_file_;
 };
 
 class CAFFE2_API PyTorchStreamWriter final {
@@ -145,6 +170,13 @@ class CAFFE2_API PyTorchStreamWriter final {
       const void* data,
       size_t size,
       bool compress = false);
+  // Writes `name` split into kChunkedRecordBlockSize blocks that are
+  // deflate-compressed across all cores, as an index record
+  // "<name>.zindex" plus one "<name>.zblock.<k>" record per block.
+  // getRecord(name) reassembles such records transparently (decompressing
+  // blocks in parallel), but readers predating this format cannot, so this
+  // is strictly opt-in.
+  void writeChunkedRecord(const std::string& name, const void* data, size_t size);
   void writeEndOfFile();
 
   bool finalized() const {
@@ -16,6 +16,13 @@ class CAFFE2_API ReadAdapterInterface {
   virtual size_t size() const = 0;
   virtual size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const = 0;
+  // Whether read() may be called from several threads at once. Adapters with
+  // a shared cursor (e.g. an istream that must seek) keep the default;
+  // positional readers like the pread-based FileAdapter override this so
+  // PyTorchStreamReader can issue record reads concurrently.
+  virtual bool supportsConcurrentReads() const {
+    return false;
+  }
   virtual ~ReadAdapterInterface();
 };
 
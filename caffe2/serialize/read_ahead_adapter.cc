@@ -0,0 +1,143 @@
+#include "caffe2/serialize/read_ahead_adapter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <c10/util/Exception.h>
+
+namespace caffe2 {
+namespace serialize {
+
+ReadAheadAdapter::ReadAheadAdapter(
+    std::unique_ptr<ReadAdapterInterface> base,
+    size_t window_size)
+    : base_(std::move(base)), window_size_(window_size) {
+  TORCH_CHECK(base_ != nullptr, "ReadAheadAdapter requires a base adapter");
+  TORCH_CHECK(window_size_ > 0, "read-ahead window size must be non-zero");
+  prefetch_thread_ = std::thread([this] { prefetchLoop(); });
+}
+
+ReadAheadAdapter::~ReadAheadAdapter() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  prefetch_thread_.join();
+}
+
+size_t ReadAheadAdapter::size() const {
+  return base_->size();
+}
+
+bool ReadAheadAdapter::supportsConcurrentReads() const {
+  // read() below is safe to call concurrently regardless of the base
+  // adapter; base reads are serialized in readBase() if need be.
+  return true;
+}
+
+size_t ReadAheadAdapter::readBase(
+    uint64_t pos,
+    void* buf,
+    size_t n,
+    const char* what) const {
+  if (base_->supportsConcurrentReads()) {
+    return base_->read(pos, buf, n, what);
+  }
+  std::lock_guard<std::mutex> guard(base_mutex_);
+  return base_->read(pos, buf, n, what);
+}
+
+void ReadAheadAdapter::schedulePrefetch(uint64_t offset) const {
+  if (shutdown_ || offset >= base_->size()) {
+    return;
+  }
+  for (const auto& w : windows_) {
+    if (w.valid != 0 && w.offset <= offset && offset < w.offset + w.valid) {
+      return; // already buffered
+    }
+  }
+  if ((inflight_ && inflight_offset_ == offset) ||
+      (requested_ && requested_offset_ == offset)) {
+    return; // already underway
+  }
+  requested_ = true;
+  requested_offset_ = offset;
+  cv_.notify_all();
+}
+
+size_t ReadAheadAdapter::read(
+    uint64_t pos,
+    void* buf,
+    size_t n,
+    const char* what) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    for (const auto& w : windows_) {
+      if (w.offset <= pos && pos + n <= w.offset + w.valid) {
+        std::memcpy(buf, w.data.data() + (pos - w.offset), n);
+        // Stay ahead of the reader: have the window after this one buffered
+        // by the time it is requested. At end of file (a short window) there
+        // is nothing left to fetch.
+        if (w.valid == window_size_) {
+          schedulePrefetch(w.offset + w.valid);
+        }
+        return n;
+      }
+    }
+    if (inflight_ && inflight_offset_ <= pos &&
+        pos + n <= inflight_offset_ + window_size_) {
+      // The bytes are already on their way; wait instead of issuing a
+      // duplicate read.
+      cv_.wait(lock);
+      continue;
+    }
+    break;
+  }
+  // Miss: read synchronously and start buffering the bytes that follow.
+  schedulePrefetch(pos + n);
+  lock.unlock();
+  return readBase(pos, buf, n, what);
+}
+
+void ReadAheadAdapter::prefetchLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return requested_ || shutdown_; });
+    if (shutdown_) {
+      return;
+    }
+    const uint64_t offset = requested_offset_;
+    requested_ = false;
+    inflight_ = true;
+    inflight_offset_ = offset;
+    lock.unlock();
+
+    std::vector<char> data(window_size_);
+    size_t valid = 0;
+    const uint64_t end = base_->size();
+    if (offset < end) {
+      const size_t want =
+          static_cast<size_t>(std::min<uint64_t>(window_size_, end - offset));
+      try {
+        valid = readBase(offset, data.data(), want, "read-ahead");
+      } catch (...) {
+        // An empty window means readers fall back to synchronous reads,
+        // which will surface the error with the caller's context.
+        valid = 0;
+      }
+    }
+
+    lock.lock();
+    Window& w = windows_[next_victim_];
+    next_victim_ = 1 - next_victim_;
+    w.offset = offset;
+    w.valid = valid;
+    w.data = std::move(data);
+    inflight_ = false;
+    cv_.notify_all();
+  }
+}
+
+} // namespace serialize
+} // namespace caffe2
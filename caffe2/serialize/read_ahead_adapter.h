@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+constexpr size_t kReadAheadWindowSize = 1 << 20;
+
+// Wraps another read adapter with a background thread that prefetches the
+// window following each buffered read. Record payloads in a zip archive are
+// laid out (and requested) roughly in file order, so by the time the reader
+// asks for the next chunk its bytes are usually already buffered - hiding
+// per-read latency on slow media such as network-attached storage.
+//
+// The wrapper itself is safe to read from several threads; reads on a base
+// adapter with a shared cursor (e.g. IStreamAdapter) are serialized
+// internally.
+class CAFFE2_API ReadAheadAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(ReadAheadAdapter);
+  explicit ReadAheadAdapter(
+      std::unique_ptr<ReadAdapterInterface> base,
+      size_t window_size = kReadAheadWindowSize);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  bool supportsConcurrentReads() const override;
+  ~ReadAheadAdapter() override;
+
+ private:
+  struct Window {
+    uint64_t offset = 0;
+    size_t valid = 0; // number of buffered bytes, 0 if empty
+    std::vector<char> data;
+  };
+
+  void prefetchLoop();
+  // Must be called with mutex_ held.
+  void schedulePrefetch(uint64_t offset) const;
+  // Read from the base adapter, serializing if it has a shared cursor.
+  size_t readBase(uint64_t pos, void* buf, size_t n, const char* what) const;
+
+  std::unique_ptr<ReadAdapterInterface> base_;
+  size_t window_size_;
+
+  // read() is const in the interface, but the double buffer is mutable
+  // caching state.
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cv_;
+  mutable Window windows_[2];
+  mutable size_t next_victim_ = 0; // which window the next prefetch fills
+  mutable bool inflight_ = false;
+  mutable uint64_t inflight_offset_ = 0;
+  mutable bool requested_ = false;
+  mutable uint64_t requested_offset_ = 0;
+  bool shutdown_ = false;
+  mutable std::mutex base_mutex_;
+  std::thread prefetch_thread_;
+};
+
+} // namespace serialize
+} // namespace caffe2
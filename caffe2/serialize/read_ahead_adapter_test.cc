@@ -0,0 +1,50 @@
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "caffe2/serialize/istream_adapter.h"
+#include "caffe2/serialize/read_ahead_adapter.h"
+
+namespace caffe2 {
+namespace serialize {
+namespace {
+
+TEST(ReadAheadAdapter, MatchesBaseAdapter) {
+  std::string payload;
+  payload.reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    payload.push_back(static_cast<char>(i % 251));
+  }
+  std::istringstream iss(payload);
+
+  // A small window forces several prefetches over the payload.
+  ReadAheadAdapter adapter(
+      std::make_unique<IStreamAdapter>(&iss), /*window_size=*/128);
+  ASSERT_TRUE(adapter.supportsConcurrentReads());
+  ASSERT_EQ(adapter.size(), payload.size());
+
+  // Sequential reads, including ones that straddle window boundaries.
+  char buf[192];
+  for (uint64_t pos = 0; pos + sizeof(buf) <= payload.size(); pos += 100) {
+    ASSERT_EQ(adapter.read(pos, buf, sizeof(buf)), sizeof(buf));
+    ASSERT_EQ(std::memcmp(buf, payload.data() + pos, sizeof(buf)), 0);
+  }
+
+  // Backwards and repeated reads still return the right bytes.
+  ASSERT_EQ(adapter.read(5, buf, 64), 64);
+  ASSERT_EQ(std::memcmp(buf, payload.data() + 5, 64), 0);
+  ASSERT_EQ(adapter.read(5, buf, 64), 64);
+  ASSERT_EQ(std::memcmp(buf, payload.data() + 5, 64), 0);
+
+  // A read larger than the window falls through to the base adapter.
+  std::string big(payload.size(), '\0');
+  ASSERT_EQ(adapter.read(0, &big[0], big.size()), big.size());
+  ASSERT_EQ(big, payload);
+}
+
+} // namespace
+} // namespace serialize
+} // namespace caffe2
@@ -105,10 +105,31 @@ if(INTERN_BUILD_ATEN_OPS)
     if(MSVC)
       list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX2")
     else(MSVC)
-      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx2 -mfma ${CPU_NO_AVX256_SPLIT_FLAGS}")
+      # F16C ships on every AVX2-capable CPU and is needed for the
+      # vectorized Half path (vec256_half.h); MSVC enables it via /arch:AVX2.
+      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx2 -mfma -mf16c ${CPU_NO_AVX256_SPLIT_FLAGS}")
     endif(MSVC)
   endif(CXX_AVX2_FOUND)
 
+  if(CXX_AVX512_FOUND)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+
+    # GCC tunes for a 256-bit preferred vector width by default even with
+    # -mavx512f; ask for the full 512-bit width so the auto-vectorizer and
+    # the intrinsics headers use zmm registers in the AVX512 kernel flavor.
+    check_cxx_compiler_flag("-mprefer-vector-width=512" COMPILER_SUPPORTS_PREFER_VECTOR_WIDTH)
+    if(COMPILER_SUPPORTS_PREFER_VECTOR_WIDTH)
+      set(CPU_PREFER_VECTOR_WIDTH_FLAGS "-mprefer-vector-width=512")
+    endif(COMPILER_SUPPORTS_PREFER_VECTOR_WIDTH)
+
+    list(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    if(MSVC)
+      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX512")
+    else(MSVC)
+      list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512dq -mavx512vl -mavx512bw -mfma -mf16c ${CPU_PREFER_VECTOR_WIDTH_FLAGS}")
+    endif(MSVC)
+  endif(CXX_AVX512_FOUND)
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -979,6 +979,7 @@ endif(USE_LLVM)
 if(USE_CUDA)
   # public/*.cmake uses CAFFE2_USE_*
   set(CAFFE2_USE_CUDA ${USE_CUDA})
+  set(CAFFE2_USE_CUPTI ${USE_CUPTI})
   set(CAFFE2_USE_CUDNN ${USE_CUDNN})
   set(CAFFE2_USE_NVRTC ${USE_NVRTC})
   set(CAFFE2_USE_TENSORRT ${USE_TENSORRT})
@@ -999,6 +1000,11 @@ if(USE_CUDA)
     else()
       caffe2_update_option(USE_CUDNN OFF)
     endif()
+    if(CAFFE2_USE_CUPTI)
+      list(APPEND Caffe2_PUBLIC_CUDA_DEPENDENCY_LIBS caffe2::cupti)
+    else()
+      caffe2_update_option(USE_CUPTI OFF)
+    endif()
     if(CAFFE2_USE_TENSORRT)
       list(APPEND Caffe2_PUBLIC_CUDA_DEPENDENCY_LIBS caffe2::tensorrt)
     else()
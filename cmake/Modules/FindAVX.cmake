@@ -25,6 +25,23 @@ SET(AVX2_CODE "
   }
 ")
 
+SET(AVX512_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512 a = _mm512_set1_ps(0);
+    __m512i b = _mm512_set1_epi32(0);
+    // we rely on the F, DQ, BW and VL subsets in our AVX512 code
+    b = _mm512_abs_epi16(b);
+    __mmask16 m = _mm512_cmp_ps_mask(a, a, _CMP_EQ_OQ);
+    a = _mm512_mask_blend_ps(m, a, a);
+    __m256i c = _mm256_abs_epi64(_mm256_set1_epi64x(0));
+    (void)c;
+    return 0;
+  }
+")
+
 MACRO(CHECK_SSE lang type flags)
   SET(__FLAG_I 1)
   SET(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -56,6 +73,8 @@ ENDMACRO()
 
 CHECK_SSE(C "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(C "AVX512" " ;-mavx512f -mavx512dq -mavx512vl -mavx512bw -mfma;/arch:AVX512")
 
 CHECK_SSE(CXX "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(CXX "AVX512" " ;-mavx512f -mavx512dq -mavx512vl -mavx512bw -mfma;/arch:AVX512")
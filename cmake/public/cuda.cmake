@@ -305,6 +305,36 @@ set_property(
     TARGET caffe2::cublas PROPERTY INTERFACE_INCLUDE_DIRECTORIES
     ${CUDA_INCLUDE_DIRS})
 
+# cupti. Ships with the toolkit but lives under extras/CUPTI rather than
+# the regular library directory.
+if(CAFFE2_USE_CUPTI)
+  find_library(CUDA_CUPTI_LIB cupti
+    PATHS "${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI/lib64"
+          "${CUDA_TOOLKIT_ROOT_DIR}/lib64"
+    NO_DEFAULT_PATH)
+  find_path(CUDA_CUPTI_INCLUDE_DIR cupti.h
+    PATHS "${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI/include"
+          "${CUDA_INCLUDE_DIRS}"
+    NO_DEFAULT_PATH)
+  if(CUDA_CUPTI_LIB AND CUDA_CUPTI_INCLUDE_DIR)
+    add_library(caffe2::cupti UNKNOWN IMPORTED)
+    set_property(
+        TARGET caffe2::cupti PROPERTY IMPORTED_LOCATION
+        ${CUDA_CUPTI_LIB})
+    set_property(
+        TARGET caffe2::cupti PROPERTY INTERFACE_INCLUDE_DIRECTORIES
+        ${CUDA_CUPTI_INCLUDE_DIR})
+    set_property(
+        TARGET caffe2::cupti PROPERTY INTERFACE_COMPILE_DEFINITIONS
+        USE_CUPTI)
+  else()
+    message(WARNING
+        "Caffe2: Cannot find CUPTI in the CUDA toolkit at "
+        "${CUDA_TOOLKIT_ROOT_DIR}; turning USE_CUPTI off")
+    set(CAFFE2_USE_CUPTI OFF)
+  endif()
+endif()
+
 # nvrtc
 add_library(caffe2::nvrtc UNKNOWN IMPORTED)
 set_property(
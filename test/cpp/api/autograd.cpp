@@ -2,6 +2,8 @@
 
 #include <torch/torch.h>
 
+#include <torch/csrc/autograd/grad_buffer.h>
+
 #include <test/cpp/api/support.h>
 
 using namespace torch::autograd;
@@ -663,6 +665,56 @@ TEST(CustomAutogradTest, HookNone) {
   ASSERT_TRUE(was_called);
 }
 
+TEST(GradBufferTest, AccumulatesIntoFlatBuffer) {
+  Variable a = torch::randn({3, 4}, torch::requires_grad());
+  Variable b = torch::randn({5}, torch::requires_grad());
+  GradBuffer buf({a, b});
+
+  // Same device and dtype: one flat buffer covering both parameters.
+  ASSERT_EQ(buf.buffers().size(), 1);
+  ASSERT_EQ(buf.buffers()[0].numel(), a.numel() + b.numel());
+
+  (a.sum() + 2 * b.sum()).backward();
+  ASSERT_VARIABLE_EQ(a.grad(), torch::ones({3, 4}));
+  ASSERT_VARIABLE_EQ(b.grad(), 2 * torch::ones({5}));
+  // AccumulateGrad landed the gradients in place: the flat buffer holds
+  // them contiguously, in parameter order.
+  auto flat = buf.buffers()[0];
+  ASSERT_VARIABLE_EQ(flat.narrow(0, 0, a.numel()), torch::ones({12}));
+  ASSERT_VARIABLE_EQ(flat.narrow(0, a.numel(), b.numel()), 2 * torch::ones({5}));
+
+  // A second backward accumulates into the same views.
+  (a.sum() + 2 * b.sum()).backward();
+  ASSERT_VARIABLE_EQ(a.grad(), 2 * torch::ones({3, 4}));
+  ASSERT_VARIABLE_EQ(flat.narrow(0, a.numel(), b.numel()), 4 * torch::ones({5}));
+
+  // zero_() clears the buffer, and with it every gradient.
+  buf.zero_();
+  ASSERT_VARIABLE_EQ(a.grad(), torch::zeros({3, 4}));
+  ASSERT_VARIABLE_EQ(b.grad(), torch::zeros({5}));
+}
+
+TEST(GradBufferTest, GroupsByDtypeAndRestoresViews) {
+  Variable a = torch::randn({4}, torch::requires_grad());
+  Variable b = torch::randn(
+      {4}, torch::dtype(torch::kDouble).requires_grad(true));
+  GradBuffer buf({a, b});
+  ASSERT_EQ(buf.buffers().size(), 2);
+
+  // Simulate something replacing a .grad with an ordinary tensor (see the
+  // caveats in Note [Flat gradient buffers]).
+  a.grad() = torch::ones({4});
+  ASSERT_FALSE(a.grad().is_alias_of(buf.buffers()[0]));
+  buf.restore_views();
+  ASSERT_TRUE(a.grad().is_alias_of(buf.buffers()[0]));
+
+  (a.sum() + b.sum()).backward();
+  ASSERT_VARIABLE_EQ(a.grad(), torch::ones({4}));
+  ASSERT_VARIABLE_EQ(
+      b.grad(), torch::ones({4}, torch::dtype(torch::kDouble)));
+  ASSERT_VARIABLE_EQ(buf.buffers()[0], torch::ones({4}));
+}
+
 // TODO add these tests if needed
 // test_once_differentiable
 // test_sparse_backward
@@ -4,11 +4,14 @@
 
 #include <test/cpp/api/support.h>
 
+#include <torch/data/detail/shared_batch_ring.h>
+
 #include <c10/util/ArrayRef.h>
 #include <c10/util/tempfile.h>
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <future>
 #include <iostream>
 #include <iterator>
@@ -688,6 +691,111 @@ TEST(DataTest, QueueClearEmptiesTheQueue) {
   ASSERT_THROWS_WITH(queue.pop(1 * kMillisecond), "Timeout");
 }
 
+TEST(DataTest, SharedBatchRingRecyclesBuffersInPlace) {
+  torch::data::detail::SharedBatchRing ring(
+      {2, 3}, torch::kFloat32, /*capacity=*/2);
+  ASSERT_EQ(ring.capacity(), 2);
+
+  auto first = ring.acquire();
+  auto second = ring.acquire();
+  ASSERT_NE(first.data_ptr(), second.data_ptr());
+  first.fill_(1);
+  second.fill_(2);
+
+  // With all buffers in flight, acquisition blocks until one is released.
+  ASSERT_THROWS_WITH(ring.acquire(10 * kMillisecond), "Timeout");
+
+  ring.release(first);
+  auto recycled = ring.acquire();
+  // The recycled buffer reuses the released buffer's storage; no allocation
+  // or copy happened.
+  ASSERT_EQ(recycled.data_ptr(), first.data_ptr());
+  ASSERT_EQ(ring.slot(recycled), ring.slot(first));
+}
+
+TEST(DataTest, SharedBatchRingWorkerFillsConsumerReads) {
+  torch::data::detail::SharedBatchRing ring(
+      {4}, torch::kInt64, /*capacity=*/2);
+  torch::data::detail::Queue<size_t> filled;
+
+  std::thread worker([&] {
+    for (int64_t batch = 0; batch < 5; ++batch) {
+      auto buffer = ring.acquire();
+      buffer.fill_(batch);
+      filled.push(ring.slot(buffer));
+    }
+  });
+
+  for (int64_t batch = 0; batch < 5; ++batch) {
+    const auto& buffer = ring.buffer(filled.pop());
+    ASSERT_TRUE(buffer.equal(torch::full({4}, batch, torch::kInt64)));
+    ring.release(buffer);
+  }
+  worker.join();
+}
+
+TEST(DataTest, SharedBatchRingSharedMemoryIsVisibleAcrossMappings) {
+  const auto tempfile = c10::make_tempfile("shared-batch-ring-test");
+  torch::data::detail::SharedBatchRing producer(
+      {3}, torch::kFloat32, /*capacity=*/2, tempfile.name);
+  // A consumer constructed with the same prefix (as another process would be)
+  // maps the same files, so writes on one side are read on the other without
+  // any copy.
+  torch::data::detail::SharedBatchRing consumer(
+      {3}, torch::kFloat32, /*capacity=*/2, tempfile.name);
+
+  auto buffer = producer.acquire();
+  buffer.copy_(torch::tensor({1.0f, 2.0f, 3.0f}));
+  ASSERT_TRUE(consumer.buffer(producer.slot(buffer))
+                  .equal(torch::tensor({1.0f, 2.0f, 3.0f})));
+
+  for (size_t slot = 0; slot < producer.capacity(); ++slot) {
+    std::remove((tempfile.name + "." + std::to_string(slot)).c_str());
+  }
+}
+
+TEST(DataTest, DevicePrefetcherYieldsAllBatchesInOrder) {
+  datasets::TensorDataset dataset(torch::arange(10, torch::kFloat32));
+  auto loader =
+      torch::data::make_data_loader<torch::data::samplers::SequentialSampler>(
+          dataset, /*batch_size=*/2);
+  auto prefetcher = torch::data::make_device_prefetcher(
+      *loader, torch::kCPU, /*depth=*/3);
+
+  // Two epochs, to verify the prefetcher can be restarted.
+  for (int epoch = 0; epoch < 2; ++epoch) {
+    std::vector<float> seen;
+    for (auto& batch : prefetcher) {
+      ASSERT_EQ(batch.size(), 2);
+      for (auto& example : batch) {
+        seen.push_back(example.data.item<float>());
+      }
+    }
+    ASSERT_EQ(seen.size(), 10);
+    for (size_t i = 0; i < seen.size(); ++i) {
+      ASSERT_EQ(seen[i], static_cast<float>(i));
+    }
+  }
+}
+
+TEST(DataTest, DevicePrefetcherPassesThroughNonTensorBatches) {
+  DummyDataset dataset(6);
+  auto loader = torch::data::make_data_loader(dataset, /*batch_size=*/3);
+  auto prefetcher =
+      torch::data::make_device_prefetcher(*loader, torch::kCPU);
+
+  int sum = 0;
+  size_t batches = 0;
+  for (auto& batch : prefetcher) {
+    for (int value : batch) {
+      sum += value;
+    }
+    ++batches;
+  }
+  ASSERT_EQ(batches, 2);
+  ASSERT_EQ(sum, 1 + 2 + 3 + 4 + 5 + 6);
+}
+
 TEST(DataTest, DataShuttleCanPushAndPopJob) {
   torch::data::detail::DataShuttle<int, int> shuttle;
   shuttle.push_job(1);
@@ -2302,4 +2410,128 @@ TEST(DataLoaderTest, CustomPreprocessPolicy) {
       }
     }
   }
+}
+
+TEST(DataLoaderTest, ChunkDatasetStreamingShuffle) {
+  // With a non-zero shuffle_buffer_size, examples stream through a bounded
+  // reservoir instead of being shuffled per chunk. Every example must still
+  // be yielded exactly once per epoch.
+  const size_t prefetch_count = 2;
+  const size_t batch_size = 5;
+  const size_t shuffle_buffer_sizes[] = {1, 10, 64};
+
+  const size_t total_example_count = 35;
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  const int epoch_count = 2;
+
+  for (auto shuffle_buffer_size : shuffle_buffer_sizes) {
+    datasets::SharedBatchDataset<datasets::ChunkDataset<
+        DummyChunkDataReader,
+        samplers::SequentialSampler,
+        samplers::SequentialSampler>>
+        dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+            DummyChunkDataReader,
+            samplers::SequentialSampler,
+            samplers::SequentialSampler>>(
+            data_reader,
+            sampler,
+            sampler,
+            datasets::ChunkDatasetOptions(
+                prefetch_count,
+                batch_size,
+                /*cache_size=*/2048,
+                /*cross_chunk_shuffle_count=*/1,
+                shuffle_buffer_size));
+
+    auto data_loader = torch::data::make_data_loader(
+        dataset, DataLoaderOptions(batch_size).workers(0));
+
+    for (int epoch_index = 0; epoch_index < epoch_count; ++epoch_index) {
+      std::vector<int> result;
+      for (auto iterator = data_loader->begin(); iterator != data_loader->end();
+           ++iterator) {
+        auto& batch = *iterator;
+        std::copy(batch.begin(), batch.end(), std::back_inserter(result));
+      }
+
+      // All examples are yielded, each exactly once.
+      ASSERT_EQ(result.size(), total_example_count);
+      std::sort(result.begin(), result.end());
+      for (size_t i = 0; i < total_example_count; ++i) {
+        ASSERT_EQ(result[i], i);
+      }
+    }
+  }
+}
+
+TEST(DataLoaderTest, ChunkDatasetSharding) {
+  // shard_index needs to be within range.
+  ASSERT_THROWS_WITH(
+      datasets::ChunkDatasetOptions(
+          /*preloader_count=*/1,
+          /*batch_size=*/1,
+          /*cache_size=*/1,
+          /*cross_chunk_shuffle_count=*/1,
+          /*shuffle_buffer_size=*/0,
+          /*shard_count=*/2,
+          /*shard_index=*/2),
+      "Shard index needs to be less than the shard count.");
+
+  // Two shards over DummyChunkDataReader's three chunks: shard 0 reads chunks
+  // 0 and 2, shard 1 reads chunk 1. Together they cover every example exactly
+  // once.
+  const size_t prefetch_count = 1;
+  const size_t batch_size = 5;
+  const size_t shard_count = 2;
+
+  const size_t total_example_count = 35;
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  std::vector<int> result;
+  for (size_t shard_index = 0; shard_index < shard_count; ++shard_index) {
+    datasets::SharedBatchDataset<datasets::ChunkDataset<
+        DummyChunkDataReader,
+        samplers::SequentialSampler,
+        samplers::SequentialSampler>>
+        dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+            DummyChunkDataReader,
+            samplers::SequentialSampler,
+            samplers::SequentialSampler>>(
+            data_reader,
+            sampler,
+            sampler,
+            datasets::ChunkDatasetOptions(
+                prefetch_count,
+                batch_size,
+                /*cache_size=*/2048,
+                /*cross_chunk_shuffle_count=*/1,
+                /*shuffle_buffer_size=*/0,
+                shard_count,
+                shard_index));
+
+    auto data_loader = torch::data::make_data_loader(
+        dataset, DataLoaderOptions(batch_size).workers(0));
+
+    size_t shard_example_count = 0;
+    for (auto iterator = data_loader->begin(); iterator != data_loader->end();
+         ++iterator) {
+      auto& batch = *iterator;
+      shard_example_count += batch.size();
+      std::copy(batch.begin(), batch.end(), std::back_inserter(result));
+    }
+
+    // No shard reads the whole dataset.
+    ASSERT_LT(shard_example_count, total_example_count);
+  }
+
+  // The shards partition the dataset: together they cover every example
+  // exactly once.
+  ASSERT_EQ(result.size(), total_example_count);
+  std::sort(result.begin(), result.end());
+  for (size_t i = 0; i < total_example_count; ++i) {
+    ASSERT_EQ(result[i], i);
+  }
 }
\ No newline at end of file
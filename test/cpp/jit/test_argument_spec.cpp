@@ -94,6 +94,39 @@ void testCompleteArgumentSpec() {
   ASSERT_EQ(with_const.at(2).sizes().size(), 2);
 }
 
+// See Note [Shape-bucketed argument specs]
+void testShapeBucketedArgumentSpec() {
+  auto const CF = at::CPU(at::kFloat);
+
+  auto batch100 = createStack({var(CF, {100, 16}, false)});
+  auto batch128 = createStack({var(CF, {128, 16}, false)});
+  auto batch129 = createStack({var(CF, {129, 16}, false)});
+
+  // exact shapes: every batch size is its own spec
+  ASSERT_FALSE(
+      CompleteArgumentSpec(false, batch100) ==
+      CompleteArgumentSpec(false, batch128));
+
+  bool old_state = getArgumentSpecShapeBucketing().exchange(true);
+
+  // batch sizes within the same power-of-two bucket collapse to one spec...
+  CompleteArgumentSpec a(false, batch100);
+  CompleteArgumentSpec b(false, batch128);
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(a.hashCode(), b.hashCode());
+  ASSERT_TRUE(isEqual(a.at(0).sizes(), at::IntArrayRef({128, 16})));
+
+  // ...but crossing a bucket boundary still produces a new spec
+  CompleteArgumentSpec c(false, batch129);
+  ASSERT_FALSE(a == c);
+
+  // requires_grad still distinguishes specs within a bucket
+  auto batch100_grad = createStack({var(CF, {100, 16}, true)});
+  ASSERT_FALSE(CompleteArgumentSpec(true, batch100_grad) == a);
+
+  getArgumentSpecShapeBucketing() = old_state;
+}
+
 size_t hashCode(const TensorTypePtr& ptr) {
   return std::hash<TensorType>()(*ptr.get());
 }
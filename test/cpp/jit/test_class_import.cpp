@@ -6,6 +6,9 @@
 #include <torch/csrc/jit/serialization/import_source.h>
 #include <torch/torch.h>
 
+#include <atomic>
+#include <thread>
+
 namespace torch {
 namespace jit {
 
@@ -109,6 +112,59 @@ void testScriptObject() {
   ASSERT_TRUE(almostEqual(new_x, new_dx.toTensor()));
 }
 
+static const auto mutualSrcs = R"JIT(
+class Left:
+    def __init__(self, x):
+        self.x = x
+    def partner(self, other: __torch__.Right):
+        return other.y + self.x
+
+class Right:
+    def __init__(self, y):
+        self.y = y
+    def partner(self, other: __torch__.Left):
+        return other.x + self.y
+)JIT";
+
+// Imports of mutually-referencing classes running in many threads at once.
+// The waits-for graph used to detect compilation cycles is global, so a
+// stale edge left behind by one import must not make an unrelated import's
+// cycle probe throw a spurious RecursiveMethodCallError.
+void testClassImportConcurrent() {
+  constexpr int kThreads = 8;
+  constexpr int kIterations = 20;
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&failures]() {
+      for (int i = 0; i < kIterations; i++) {
+        try {
+          auto cu = std::make_shared<CompilationUnit>();
+          std::vector<at::Tensor> constantTable;
+          import_libs(
+              cu,
+              "__torch__.Left",
+              std::make_shared<Source>(mutualSrcs),
+              constantTable);
+          c10::QualifiedName base("__torch__");
+          auto left = cu->get_class(c10::QualifiedName(base, "Left"));
+          auto right = cu->get_class(c10::QualifiedName(base, "Right"));
+          if (!left || !left->getMethod("partner") || !right ||
+              !right->getMethod("partner")) {
+            failures++;
+          }
+        } catch (...) {
+          failures++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(failures, 0);
+}
+
 static const auto methodSrc = R"JIT(
 def __init__(self, x):
     return x
@@ -27,6 +27,7 @@
 #include "torch/csrc/jit/passes/guard_elimination.h"
 #include "torch/csrc/jit/passes/inline_autodiff_subgraphs.h"
 #include "torch/csrc/jit/passes/insert_guards.h"
+#include "torch/csrc/jit/jit_log.h"
 #include "torch/csrc/jit/passes/liveness.h"
 #include "torch/csrc/jit/passes/lower_grad_of.h"
 #include "torch/csrc/jit/passes/lower_tuples.h"
@@ -1043,6 +1044,19 @@ void testThreadLocalDebugInfo() {
   }
 }
 
+void testJitLogRing() {
+  bool old_enabled = jit_log_ring_enabled();
+  set_jit_log_ring_enabled(true);
+  GRAPH_UPDATE("ring buffer test event");
+  set_jit_log_ring_enabled(old_enabled);
+
+  auto dump = jit_log_ring_dump();
+  // The record carries the site's file/line and level; the message itself is
+  // not stored and is formatted lazily only by the textual backend.
+  ASSERT_TRUE(dump.find("test_misc") != std::string::npos);
+  ASSERT_TRUE(dump.find("UPDATE") != std::string::npos);
+}
+
 void testAutogradProfiler() {
   constexpr int batch_size = 4;
   constexpr int input_size = 256;
@@ -1,7 +1,11 @@
 #include <test/cpp/jit/test_base.h>
 #include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/api/inference_session.h>
 #include <torch/torch.h>
 
+#include <atomic>
+#include <thread>
+
 namespace torch {
 namespace jit {
 
@@ -62,6 +66,44 @@ void testModuleCloneInstance() {
   ASSERT_EQ(m3.attr(attr_name).toInt(), 3);
 }
 
+void testModuleInferenceSession() {
+  Module m("m");
+  m.register_parameter("weight", torch::ones({2, 2}), false);
+  m.define(R"(
+    def forward(self, x):
+      return x + self.weight
+  )");
+
+  auto session = InferenceSession::create(m);
+
+  // One context per thread over the shared frozen weights; every call must
+  // see the same folded weight values.
+  constexpr int kThreads = 4;
+  constexpr int kIterations = 16;
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&]() {
+      auto context = session.newContext();
+      for (int i = 0; i < kIterations; ++i) {
+        auto input = torch::randn({2, 2});
+        auto output = context.forward({input}).toTensor();
+        if (!output.equal(input + torch::ones({2, 2}))) {
+          ++mismatches;
+        }
+        // Contexts run with gradients disabled.
+        if (output.requires_grad()) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(mismatches.load(), 0);
+}
+
 void testModuleConstant() {
   auto cu = std::make_shared<CompilationUnit>();
   auto cls = ClassType::create("foo.bar", cu, true);
@@ -0,0 +1,45 @@
+#include <torch/jit.h>
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+#include <torch/csrc/jit/runtime/static_runtime.h>
+
+namespace torch {
+namespace jit {
+
+// See Note [Static runtime]
+void testStaticRuntime() {
+  auto graph = compile(R"JIT(
+    def fn(a, b):
+        c = a * b
+        d = c + b
+        return (d, [c], (a, 1.0))
+  )JIT")
+                   ->get_function("fn")
+                   .graph();
+
+  auto a = at::randn({2, 3});
+  auto b = at::randn({2, 3});
+  auto c = a * b;
+  auto d = c + b;
+
+  StaticRuntime runtime(graph);
+  // run twice to exercise workspace reuse across requests
+  for (int iter = 0; iter < 2; ++iter) {
+    auto outputs = runtime.run({a, b});
+    ASSERT_EQ(outputs.size(), 1);
+    auto result = outputs[0].toTuple()->elements();
+    ASSERT_EQ(result.size(), 3);
+    ASSERT_TRUE(exactlyEqual(result[0].toTensor(), d));
+    auto list = result[1].toTensorVector();
+    ASSERT_EQ(list.size(), 1);
+    ASSERT_TRUE(exactlyEqual(list[0], c));
+    auto tuple = result[2].toTuple()->elements();
+    ASSERT_EQ(tuple.size(), 2);
+    ASSERT_TRUE(exactlyEqual(tuple[0].toTensor(), a));
+    ASSERT_EQ(tuple[1].toDouble(), 1.0);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -52,18 +52,24 @@ namespace jit {
   _(PeepholeOptimize)                  \
   _(RecordFunction)                    \
   _(ThreadLocalDebugInfo)              \
+  _(JitLogRing)                        \
   _(SubgraphMatching)                  \
   _(SubgraphRewriter)                  \
   _(ModuleClone)                       \
   _(ModuleCloneInstance)               \
+  _(ModuleInferenceSession)            \
   _(ModuleConstant)                    \
   _(ModuleParameter)                   \
   _(ModuleDefine)                      \
   _(QualifiedName)                     \
   _(ClassImport)                       \
+  _(ClassImportConcurrent)             \
   _(ProfiledTensorTypeHashing)         \
+  _(ShapeBucketedArgumentSpec)         \
+  _(StaticRuntime)                     \
   _(ScriptObject)                      \
   _(SaveExtraFilesHook)                \
+  _(IncrementalCheckpoint)             \
   _(TypeTags)                          \
   _(DCE)                               \
   _(CustomFusionNestedBlocks)          \
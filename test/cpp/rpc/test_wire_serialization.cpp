@@ -37,6 +37,29 @@ TEST(WireSerialize, Base) {
   run("more", {torch::randn({5, 5}), torch::rand({10, 10})});
 }
 
+TEST(WireSerialize, InPlaceDeserialize) {
+  std::string payload = "hi";
+  std::vector<at::Tensor> tensors = {torch::randn({5, 5}), torch::rand({7, 3})};
+  auto ser = torch::distributed::rpc::wireSerialize(
+      std::vector<char>(payload.begin(), payload.end()), tensors);
+  // Stage the serialized bytes in an (aligned) buffer, as the receive path
+  // does, and deserialize in place.
+  auto buffer = torch::empty({(int64_t)ser.size()}, {torch::kChar});
+  memcpy(buffer.data_ptr(), ser.data(), ser.size());
+  auto deser = torch::distributed::rpc::wireDeserializeInPlace(buffer);
+  EXPECT_EQ(payload.size(), deser.first.size());
+  EXPECT_EQ(tensors.size(), deser.second.size());
+  const char* base = static_cast<const char*>(buffer.storage().data());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    EXPECT_TRUE(torch::equal(tensors[i], deser.second[i]));
+    // Tensor sections should alias the buffer, not be copies of it.
+    const char* data =
+        static_cast<const char*>(deser.second[i].storage().data());
+    EXPECT_GE(data, base);
+    EXPECT_LT(data, base + ser.size());
+  }
+}
+
 TEST(WireSerialize, RecopySparseTensors) {
   // Take a 1K row of a 1M tensors, and make sure we don't send across 1M rows.
   constexpr size_t k1K = 1024;
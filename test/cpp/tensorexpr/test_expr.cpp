@@ -3,6 +3,7 @@
 #include "test/cpp/tensorexpr/padded_buffer.h"
 #include "test/cpp/tensorexpr/test_utils.h"
 #include "torch/csrc/jit/tensorexpr/buffer.h"
+#include "torch/csrc/jit/tensorexpr/codegen_cache.h"
 #include "torch/csrc/jit/tensorexpr/eval.h"
 #include "torch/csrc/jit/tensorexpr/function.h"
 #include "torch/csrc/jit/tensorexpr/ir.h"
@@ -10,6 +11,8 @@
 #include "torch/csrc/jit/tensorexpr/loopnest.h"
 #include "torch/csrc/jit/tensorexpr/tensor.h"
 
+#include <c10/util/tempfile.h>
+
 #include <cmath>
 #include <sstream>
 #include <stdexcept>
@@ -489,5 +492,30 @@ void testStmtClone() {
   assertAllEqual(cloned_loop_results_after_mutation, 33);
 }
 
+void testExprPersistentCodegenCache() {
+  const std::string saved_dir = codegenCacheDir();
+  auto tmp = c10::make_tempfile("tensorexpr-cache-");
+  setCodegenCacheDir(tmp.name + "-dir");
+  ASSERT_TRUE(codegenCacheEnabled());
+
+  const std::string source = "__global__ void func(float* a) {}";
+  const std::string tag = "nvrtc_10.1_compute_70";
+  ASSERT_FALSE(codegenCacheLoad(source, tag));
+
+  codegenCacheStore(source, tag, "compiled bits");
+  auto hit = codegenCacheLoad(source, tag);
+  ASSERT_TRUE(bool(hit));
+  ASSERT_EQ(*hit, "compiled bits");
+
+  // Lookups verify the full key, not just its hash.
+  ASSERT_FALSE(codegenCacheLoad(source, "nvrtc_10.1_compute_75"));
+  ASSERT_FALSE(codegenCacheLoad(source + " ", tag));
+
+  setCodegenCacheDir("");
+  ASSERT_FALSE(codegenCacheEnabled());
+  ASSERT_FALSE(codegenCacheLoad(source, tag));
+  setCodegenCacheDir(saved_dir);
+}
+
 } // namespace jit
 } // namespace torch
@@ -31,6 +31,7 @@ namespace jit {
   _(ExprBinaryMath01)                     \
   _(ExprDynamicShapeAdd)                  \
   _(ExprBitwiseOps)                       \
+  _(ExprPersistentCodegenCache)           \
   _(IRPrinterBasicValueTest)              \
   _(IRPrinterBasicValueTest02)            \
   _(IRPrinterLetTest01)                   \
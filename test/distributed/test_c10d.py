@@ -793,6 +793,26 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
     def test_allreduce_basics_cuda(self):
         self._test_allreduce_basics(lambda t: t.clone().cuda())
 
+    def test_collective_metrics(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
+
+        tensor = torch.ones([16], dtype=torch.float32)
+        pg.allreduce(tensor).wait()
+        pg.broadcast([tensor]).wait()
+
+        metrics = pg._get_collective_metrics()
+        self.assertIn("allreduce", metrics)
+        self.assertIn("broadcast", metrics)
+        entry = metrics["allreduce"]
+        self.assertEqual(1, entry["count"])
+        self.assertEqual(tensor.numel() * tensor.element_size(), entry["total_bytes"])
+        self.assertGreaterEqual(entry["max_ms"], entry["min_ms"])
+        self.assertEqual(entry["count"], sum(entry["latency_histogram"]))
+
+        pg._reset_collective_metrics()
+        self.assertEqual({}, pg._get_collective_metrics())
+
     def _test_allreduce_stress(self, inputs):
         store = c10d.FileStore(self.file_name, self.world_size)
         pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts(threads=8))
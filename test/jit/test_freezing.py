@@ -5,6 +5,7 @@ from torch.testing._internal.jit_utils import JitTestCase
 from torch.testing import FileCheck
 
 import io
+import unittest
 
 if __name__ == '__main__':
     raise RuntimeError("This test file is not meant to be run directly, use:\n\n"
@@ -833,3 +834,38 @@ class TestFreezing(JitTestCase):
         out3 = smod(inp)
         self.assertNotEqual(out1, out2)
         self.assertEqual(out2, out3)
+
+    @unittest.skipIf(not torch.backends.mkldnn.is_available(), "MKL-DNN build is disabled")
+    def test_freeze_propagate_mkldnn_layout(self):
+        class Net(nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.conv1 = nn.Conv2d(3, 8, 3, padding=1)
+                self.conv2 = nn.Conv2d(3, 8, 3, padding=1)
+                self.pool = nn.MaxPool2d(2)
+
+            def forward(self, x):
+                y1 = torch.relu(self.conv1(x))
+                y2 = torch.relu(self.conv2(x))
+                y = torch.cat([y1, y2], dim=1)
+                y = self.pool(y)
+                return y + y
+
+        x = torch.randn(1, 3, 16, 16)
+        # Tracing records concrete shapes, which the pass needs to prove that
+        # elementwise ops do not broadcast.
+        m = torch.jit.trace(Net().eval(), x)
+        m.eval()
+        expected = m(x)
+        mf = torch._C._freeze_module(m._c)
+        graph = mf._get_method('forward').graph
+        torch._C._jit_pass_propagate_mkldnn_layout(graph)
+        # The whole conv/relu/cat/pool/add region runs in blocked layout:
+        # conversions appear only at the region boundaries.
+        FileCheck().check('aten::to_mkldnn') \
+                   .check('aten::conv2d') \
+                   .check('aten::max_pool2d') \
+                   .check('aten::add') \
+                   .check('aten::to_dense') \
+                   .run(graph)
+        self.assertEqual(mf.forward(x), expected)
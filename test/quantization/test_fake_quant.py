@@ -200,6 +200,57 @@ class TestFakeQuantizePerTensor(TestCase):
         self.assertNotEqual(fq_module.scale, scale)
         self.assertNotEqual(fq_module.zero_point, zero_point)
 
+    def test_fused_obs_fake_quant_per_tensor(self):
+        r"""Tests the fused moving-average observer + fake quantize op against
+        the composed reference (observer update, qparam computation, fake
+        quantize) over several observations.
+        """
+        torch.manual_seed(NP_RANDOM_SEED)
+        quant_min, quant_max = 0, 255
+        avg_const = 0.01
+        eps = np.finfo(np.float32).eps
+
+        running_min = torch.tensor([float('inf')])
+        running_max = torch.tensor([float('-inf')])
+        ref_min, ref_max = None, None
+        for i in range(3):
+            X = torch.randn(5, 7) * (i + 1)
+            X.requires_grad_()
+            Y, running_min, running_max, scale, zero_point = \
+                torch._fused_moving_avg_obs_fake_quant(
+                    X, running_min, running_max, avg_const,
+                    quant_min, quant_max)
+
+            x_min, x_max = X.min().item(), X.max().item()
+            if ref_min is None:
+                ref_min, ref_max = x_min, x_max
+            else:
+                ref_min += avg_const * (x_min - ref_min)
+                ref_max += avg_const * (x_max - ref_max)
+            self.assertEqual(running_min.item(), ref_min)
+            self.assertEqual(running_max.item(), ref_max)
+
+            ref_scale = max((max(ref_max, 0) - min(ref_min, 0)) /
+                            float(quant_max - quant_min), eps)
+            ref_zero_point = int(np.clip(
+                quant_min - round(min(ref_min, 0) / ref_scale),
+                quant_min, quant_max))
+            self.assertEqual(scale.item(), ref_scale)
+            self.assertEqual(zero_point.item(), ref_zero_point)
+
+            Y_ref = _fake_quantize_per_tensor_affine_reference(
+                X.detach(), ref_scale, ref_zero_point, quant_min, quant_max)
+            np.testing.assert_allclose(Y.detach(), Y_ref,
+                                       rtol=tolerance, atol=tolerance)
+
+            # The op must backpropagate like the plain fake quantize op.
+            dout = torch.rand(X.shape, dtype=torch.float)
+            dX_ref = _fake_quantize_per_tensor_affine_grad_reference(
+                dout, X.detach(), ref_scale, ref_zero_point,
+                quant_min, quant_max)
+            Y.backward(dout)
+            np.testing.assert_allclose(dX_ref, X.grad.detach(),
+                                       rtol=tolerance, atol=tolerance)
 
 
 class TestFakeQuantizePerChannel(TestCase):
@@ -310,5 +361,44 @@ class TestFakeQuantizePerChannel(TestCase):
         for key in state_dict:
             self.assertEqual(state_dict[key], loaded_dict[key])
 
+    def test_fused_obs_fake_quant_per_channel(self):
+        r"""Tests the fused observer + fake quantize op with per-channel
+        statistics against the composed reference.
+        """
+        torch.manual_seed(NP_RANDOM_SEED)
+        quant_min, quant_max = 0, 255
+        avg_const = 0.01
+        eps = np.finfo(np.float32).eps
+        axis = 1
+        channels = 4
+
+        X = torch.randn(3, channels, 5) * 3
+        running_min = torch.full((channels,), float('inf'))
+        running_max = torch.full((channels,), float('-inf'))
+        Y, running_min, running_max, scale, zero_point = \
+            torch._fused_moving_avg_obs_fake_quant(
+                X, running_min, running_max, avg_const,
+                quant_min, quant_max, axis)
+
+        # First observation initializes the running range directly.
+        ref_min = X.min(dim=2)[0].min(dim=0)[0]
+        ref_max = X.max(dim=2)[0].max(dim=0)[0]
+        self.assertEqual(running_min, ref_min)
+        self.assertEqual(running_max, ref_max)
+
+        ref_scale = torch.max(
+            (torch.clamp(ref_max, min=0) - torch.clamp(ref_min, max=0)) /
+            float(quant_max - quant_min),
+            torch.tensor(eps))
+        ref_zero_point = torch.clamp(
+            quant_min - torch.round(torch.clamp(ref_min, max=0) / ref_scale),
+            quant_min, quant_max).to(torch.int64)
+        self.assertEqual(scale, ref_scale)
+        self.assertEqual(zero_point, ref_zero_point)
+
+        Y_ref = _fake_quantize_per_channel_affine_reference(
+            X, ref_scale, ref_zero_point, axis, quant_min, quant_max)
+        np.testing.assert_allclose(Y, Y_ref, rtol=tolerance, atol=tolerance)
+
 if __name__ == '__main__':
     run_tests()
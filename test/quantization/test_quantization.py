@@ -33,7 +33,7 @@ from torch.testing._internal.common_quantization import QuantizationTestCase, \
     ModelWithFunctionals, \
     test_only_eval_fn, test_only_train_fn, \
     prepare_dynamic, convert_dynamic, SingleLayerLinearDynamicModel, \
-    TwoLayerLinearModel, NestedModel, ResNetBase, LSTMDynamicModel, \
+    TwoLayerLinearModel, NestedModel, ResNetBase, LSTMDynamicModel, GRUDynamicModel, \
     ModelWithNoQconfigPropagation, ModelForFusionWithBias
 
 from torch.testing._internal.common_quantization import AnnotatedTwoLayerLinearModel, AnnotatedNestedModel, \
@@ -778,6 +778,85 @@ class PostTrainingDynamicQuantTest(QuantizationTestCase):
 
             y, (h, c) = cell_dq(x, (h, c))
 
+    @given(qengine=st.sampled_from(("fbgemm",)))
+    def test_quantized_gru(self, qengine):
+        # TODO: qlinear_prepack_fp16 currently doesn't support QNNPACK
+        # re-add "qnnpack" to the engine set when this is supported
+
+        with override_quantized_engine(qengine):
+            model = GRUDynamicModel().eval()
+            ref = copy.deepcopy(model.gru)
+
+            model_int8 = quantize_dynamic(model=model, dtype=torch.qint8)
+            model_fp16 = quantize_dynamic(model=model, dtype=torch.float16)
+
+            # Smoke test extra reprs
+            self.assertTrue('DynamicQuantizedGRU' in str(model_int8))
+            self.assertTrue('DynamicQuantizedGRU' in str(model_fp16))
+            cell_int8 = model_int8.gru
+            cell_fp16 = model_fp16.gru
+
+            assert type(cell_int8) == torch.nn.quantized.dynamic.GRU, \
+                'torch.nn.GRU should be converted to torch.nn.quantized.dynamic.GRU after quantize_dynamic'
+            assert type(cell_fp16) == torch.nn.quantized.dynamic.GRU, \
+                'torch.nn.GRU should be converted to torch.nn.quantized.dynamic.GRU after quantize_dynamic'
+
+            niter = 10
+            x = torch.rand(niter, 3, 2)
+            hx = torch.rand(1, 3, 2)
+
+            ref_out, ref_hid = ref(x, hx)
+
+            # The elementwise tail runs in fp32, so only the dynamically
+            # quantized gate GEMMs introduce error relative to the fp32 cell.
+            output_int8, final_hidden_int8 = cell_int8(x, hx)
+            self.assertEqual(output_int8.shape, ref_out.shape)
+            self.assertEqual(final_hidden_int8.shape, ref_hid.shape)
+            torch.testing.assert_allclose(output_int8, ref_out, rtol=1e-1, atol=1e-2)
+            torch.testing.assert_allclose(final_hidden_int8, ref_hid, rtol=1e-1, atol=1e-2)
+
+            output_fp16, final_hidden_fp16 = cell_fp16(x, hx)
+            torch.testing.assert_allclose(output_fp16, ref_out, rtol=1e-1, atol=1e-2)
+            torch.testing.assert_allclose(final_hidden_fp16, ref_hid, rtol=1e-1, atol=1e-2)
+
+            class ScriptWrapper(torch.nn.Module):
+                def __init__(self, cell):
+                    super(ScriptWrapper, self).__init__()
+                    self.cell = cell
+
+                def forward(self, x, hx):
+                    # type: (torch.Tensor, torch.Tensor) -> Tuple[torch.Tensor, torch.Tensor]
+                    return self.cell(x, hx)
+
+            # TODO: TorchScript overloads don't work without this wrapper
+            cell_script = torch.jit.script(ScriptWrapper(cell_int8))
+            out_script, hid_script = cell_script(x, hx)
+            torch.testing.assert_allclose(out_script, output_int8)
+            torch.testing.assert_allclose(hid_script, final_hidden_int8)
+
+            # Test save/load
+            b = io.BytesIO()
+            torch.jit.save(cell_script, b)
+            b.seek(0)
+            loaded = torch.jit.load(b)
+            out_loaded, hid_loaded = loaded(x, hx)
+            torch.testing.assert_allclose(out_loaded, output_int8)
+            torch.testing.assert_allclose(hid_loaded, final_hidden_int8)
+
+            # Test default instantiation
+            cell_dq = torch.nn.quantized.dynamic.GRU(input_size=3,
+                                                     hidden_size=7,
+                                                     num_layers=2,
+                                                     bias=True,
+                                                     batch_first=False,
+                                                     dropout=0.0,
+                                                     bidirectional=False,
+                                                     dtype=torch.qint8)
+            y, h = cell_dq(torch.rand(128, 16, 3),
+                           torch.rand(2, 16, 7))
+            self.assertEqual(y.shape, torch.Size([128, 16, 7]))
+            self.assertEqual(h.shape, torch.Size([2, 16, 7]))
+
 
 @unittest.skipUnless('fbgemm' in torch.backends.quantized.supported_engines,
                      " Quantized operations require FBGEMM. FBGEMM is only optimized for CPUs"
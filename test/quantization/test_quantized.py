@@ -1433,6 +1433,75 @@ class TestQuantizedOps(TestCase):
         self.assertEqual(qX.equal(qX), equal_ref(qX, qX))
         self.assertEqual(qX.equal(qX2), equal_ref(qX, qX2))
 
+    """Tests the 8-bit rowwise quantized embedding bag operators."""
+    def test_embedding_bag_byte(self):
+        num_embeddings = 12
+        embedding_dim = 16
+        weight = torch.randn(num_embeddings, embedding_dim, dtype=torch.float)
+
+        packed = torch.ops.quantized.embedding_bag_byte_prepack(weight)
+        self.assertEqual(packed.shape,
+                         torch.Size([num_embeddings, embedding_dim + 8]))
+        self.assertEqual(packed.dtype, torch.uint8)
+
+        # Rowwise quantization to 8 bits cannot be off by more than one
+        # quantization step of the widest row.
+        unpacked = torch.ops.quantized.embedding_bag_byte_unpack(packed)
+        atol = (weight.max() - weight.min()).item() / 255
+        np.testing.assert_allclose(unpacked.numpy(), weight.numpy(),
+                                   rtol=0, atol=atol)
+
+        indices = torch.randint(0, num_embeddings, (10,), dtype=torch.long)
+        offsets = torch.tensor([0, 2, 2, 7], dtype=torch.long)
+        per_sample_weights = torch.randn(indices.numel(), dtype=torch.float)
+        for weights in [None, per_sample_weights]:
+            for include_last_offset in [False, True]:
+                result = torch.ops.quantized.embedding_bag_byte_rowwise_offsets(
+                    packed, indices, offsets, mode=0,
+                    per_sample_weights=weights,
+                    include_last_offset=include_last_offset)
+                # The lookup kernel dequantizes the rows on the fly, so it has
+                # to agree with a float embedding bag over the unpacked table.
+                reference = torch.nn.functional.embedding_bag(
+                    indices, unpacked, offsets, mode='sum',
+                    per_sample_weights=weights,
+                    include_last_offset=include_last_offset)
+                np.testing.assert_allclose(result.numpy(), reference.numpy(),
+                                           rtol=1e-5, atol=1e-5)
+
+    """Tests the 4-bit rowwise quantized embedding bag operators."""
+    def test_embedding_bag_4bit(self):
+        num_embeddings = 12
+        embedding_dim = 16
+        weight = torch.randn(num_embeddings, embedding_dim, dtype=torch.float)
+
+        packed = torch.ops.quantized.embedding_bag_4bit_prepack(weight)
+        self.assertEqual(packed.shape,
+                         torch.Size([num_embeddings, embedding_dim // 2 + 4]))
+        self.assertEqual(packed.dtype, torch.uint8)
+
+        # With 4 bits per value the quantization step of the widest row is
+        # (max - min) / 15; the fp16 scale and bias add a little more error.
+        unpacked = torch.ops.quantized.embedding_bag_4bit_unpack(packed)
+        atol = (weight.max() - weight.min()).item() / 15 * 1.01
+        np.testing.assert_allclose(unpacked.numpy(), weight.numpy(),
+                                   rtol=0, atol=atol)
+
+        indices = torch.randint(0, num_embeddings, (10,), dtype=torch.long)
+        offsets = torch.tensor([0, 2, 2, 7], dtype=torch.long)
+        per_sample_weights = torch.randn(indices.numel(), dtype=torch.float)
+        for weights in [None, per_sample_weights]:
+            for include_last_offset in [False, True]:
+                result = torch.ops.quantized.embedding_bag_4bit_rowwise_offsets(
+                    packed, indices, offsets, mode=0,
+                    per_sample_weights=weights,
+                    include_last_offset=include_last_offset)
+                reference = torch.nn.functional.embedding_bag(
+                    indices, unpacked, offsets, mode='sum',
+                    per_sample_weights=weights,
+                    include_last_offset=include_last_offset)
+                np.testing.assert_allclose(result.numpy(), reference.numpy(),
+                                           rtol=1e-5, atol=1e-5)
 
     @given(X=hu.tensor(shapes=hu.array_shapes(min_dims=4, max_dims=4,
                                               min_side=1, max_side=32),
@@ -2167,6 +2236,69 @@ class TestQuantizedConv(unittest.TestCase):
                 dilations, X_scale, X_zero_point, W_scale, W_zero_point,
                 Y_scale, Y_zero_point, use_bias, use_relu, use_channelwise)
 
+    """Tests the correctness of quantized convolution with a fused residual add."""
+    @given(use_relu=st.booleans(),
+           qengine=st.sampled_from(("qnnpack", "fbgemm")))
+    def test_qconv_add(self, use_relu, qengine):
+        if qengine not in torch.backends.quantized.supported_engines:
+            return
+        if qengine == 'qnnpack':
+            if IS_PPC or TEST_WITH_UBSAN or IS_MACOS:
+                return
+
+        with override_quantized_engine(qengine):
+            batch_size, in_channels, height, width = 2, 8, 10, 10
+            out_channels = 8
+            strides = (1, 1)
+            pads = (1, 1)
+            dilations = (1, 1)
+            groups = 1
+
+            X_scale, X_zero_point = 0.02, 2
+            W_scale, W_zero_point = 0.01, 0
+            accum_scale, accum_zero_point = 0.03, 1
+            Y_scale, Y_zero_point = 0.04, 3
+
+            X = torch.rand(batch_size, in_channels, height, width) * 4
+            W = torch.rand(out_channels, in_channels, 3, 3) * 2 - 1
+            b = torch.rand(out_channels)
+
+            X_q = torch.quantize_per_tensor(
+                X, scale=X_scale, zero_point=X_zero_point, dtype=torch.quint8)
+            W_q = torch.quantize_per_tensor(
+                W, scale=W_scale, zero_point=W_zero_point, dtype=torch.qint8)
+
+            W_prepack = torch.ops.quantized.conv2d_prepack(
+                W_q, b, strides, pads, dilations, groups)
+            Y_conv = torch.ops.quantized.conv2d(
+                X_q, W_prepack, strides, pads, dilations, groups,
+                Y_scale, Y_zero_point)
+
+            accum = torch.rand(Y_conv.shape) * 4
+            accum_q = torch.quantize_per_tensor(
+                accum, scale=accum_scale, zero_point=accum_zero_point,
+                dtype=torch.quint8)
+
+            if use_relu:
+                Y_ref = torch.ops.quantized.add_relu(
+                    Y_conv, accum_q, Y_scale, Y_zero_point)
+                Y_fused = torch.ops.quantized.conv2d_add_relu(
+                    X_q, accum_q, W_prepack, strides, pads, dilations,
+                    groups, Y_scale, Y_zero_point)
+            else:
+                Y_ref = torch.ops.quantized.add(
+                    Y_conv, accum_q, Y_scale, Y_zero_point)
+                Y_fused = torch.ops.quantized.conv2d_add(
+                    X_q, accum_q, W_prepack, strides, pads, dilations,
+                    groups, Y_scale, Y_zero_point)
+
+            # QNNPACK runs the standalone add through its own kernel, so
+            # allow the usual off-by-1 rounding difference there; the fused
+            # op and the reference share the conv implementation.
+            np.testing.assert_array_almost_equal(
+                Y_ref.int_repr().numpy(), Y_fused.int_repr().numpy(),
+                decimal=0)
+
     """Tests the correctness of the quantized::qconv_unpack op."""
     @given(
         inputs=hu.tensor_conv(
@@ -2748,6 +2748,23 @@ class TestAutograd(TestCase):
         self.assertTrue('cpu' in prof_str.lower())
         self.assertTrue('cuda' not in prof_str.lower())
 
+    def test_profiler_memory(self):
+        with profile(profile_memory=True) as prof:
+            x = torch.randn(128, 128)
+            x.mm(x)
+
+        # both tensors are still alive, so the net bytes attributed to the
+        # profiled scopes must cover at least their storages
+        total_cpu_bytes = sum(
+            evt.cpu_memory_usage for evt in prof.key_averages())
+        self.assertGreaterEqual(total_cpu_bytes, 2 * 128 * 128 * 4)
+        self.assertIn('CPU Mem', prof.table())
+
+        # without profile_memory the column should not appear
+        with profile() as prof:
+            x.mm(x)
+        self.assertNotIn('CPU Mem', prof.table())
+
     def test_profiler_aggregation_lstm(self):
         print("")
         rnn = torch.nn.LSTM(10, 20, 2)
@@ -100,6 +100,27 @@ class TestIndexing(TestCase):
         self.assertEqual(a[-2], 13)
         self.assertEqual(a[-1], 14)
 
+    def test_index_put_accumulate_duplicate_indices(self, device):
+        # Heavy duplication and a size big enough to take the parallel
+        # accumulation path on CPU; the result must match a bincount-style
+        # reference and stay deterministic across runs.
+        N = 100000
+        dt = torch.double
+        indices = torch.randint(0, 100, (N,), device=device)
+        values = torch.randn(N, dtype=dt, device=device)
+
+        a = torch.zeros(100, dtype=dt, device=device)
+        a.index_put_((indices,), values, accumulate=True)
+
+        ref = torch.zeros(100, dtype=dt, device=device)
+        for i in range(100):
+            ref[i] = values[indices == i].sum()
+        self.assertEqual(a, ref)
+
+        b = torch.zeros(100, dtype=dt, device=device)
+        b.index_put_((indices,), values, accumulate=True)
+        self.assertEqual(a, b, 0)
+
     def test_multiple_byte_mask(self, device):
         v = torch.randn(5, 7, 3, device=device)
         # note: these broadcast together and are transposed to the first dim
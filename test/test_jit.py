@@ -1112,6 +1112,49 @@ graph(%Ra, %Rb):
   return (%Ra)""", graph)
         FileCheck().run(input_str, graph)
 
+    def test_fuse_linear_activation(self):
+        activations = ['relu', 'gelu', 'sigmoid']
+        for activation in activations:
+            input_str = """
+graph(%input, %weight, %bias):
+    # CHECK-NOT: aten::linear
+    # CHECK-NOT: aten::{activation}
+    # CHECK: aten::_linear_with_activation
+    %linear_out = aten::linear(%input, %weight, %bias)
+    %res = aten::{activation}(%linear_out)
+    return (%res)""".format(activation=activation)
+            graph = parse_ir(input_str)
+            torch._C._jit_pass_fuse_linear_activation(graph)
+            FileCheck().run(input_str, graph)
+
+        # the linear output is used outside the activation, so the
+        # pattern must not be rewritten
+        input_str = """
+graph(%input, %weight, %bias):
+    # CHECK-NOT: aten::_linear_with_activation
+    # CHECK: aten::linear
+    %linear_out = aten::linear(%input, %weight, %bias)
+    # CHECK: aten::relu
+    %res = aten::relu(%linear_out)
+    %res2 = aten::add(%res, %linear_out, %bias)
+    return (%res2)"""
+        graph = parse_ir(input_str)
+        torch._C._jit_pass_fuse_linear_activation(graph)
+        FileCheck().run(input_str, graph)
+
+        # numerics: the fused op matches the unfused reference
+        for activation in activations:
+            def fn(x, w, b, activation=activation):
+                out = torch.nn.functional.linear(x, w, b)
+                return getattr(torch, activation)(out) if activation != 'gelu' \
+                    else torch.nn.functional.gelu(out)
+
+            x = torch.randn(4, 8)
+            w = torch.randn(6, 8)
+            b = torch.randn(6)
+            fused = torch._C._nn._linear_with_activation(x, w, b, activation)
+            self.assertEqual(fused, fn(x, w, b))
+
     @_tmp_donotuse_dont_inline_everything
     def test_pattern_based_module_rewrite(self):
         # Check match::module behavior
@@ -1773,6 +1816,33 @@ graph(%Ra, %Rb):
             self.assertIn('bernoulli_', profile(scripted_training, X))
             self.assertNotIn('bernoulli_', profile(scripted_eval, X))
 
+    def test_node_runtime_stats(self):
+        prev_exec = torch._C._jit_set_profiling_executor(True)
+        prev_mode = torch._C._jit_set_profiling_mode(True)
+        prev_stats = torch._C._jit_set_node_runtime_stats(True)
+        try:
+            @torch.jit.script
+            def fn(x, y):
+                return torch.mm(x, y) + y
+
+            x = torch.randn(8, 8)
+            y = torch.randn(8, 8)
+            for _ in range(3):
+                fn(x, y)
+
+            stats = fn.get_node_runtime_stats()
+            mm_entries = [s for node, s in stats if 'aten::mm' in node]
+            self.assertEqual(len(mm_entries), 1)
+            mm_stats = mm_entries[0]
+            self.assertGreaterEqual(mm_stats.count, 1)
+            self.assertGreater(mm_stats.last_ns, 0)
+            self.assertGreaterEqual(mm_stats.cumulative_ns, mm_stats.last_ns)
+            self.assertIn('[8, 8]', mm_stats.observed_shapes)
+        finally:
+            torch._C._jit_set_node_runtime_stats(prev_stats)
+            torch._C._jit_set_profiling_mode(prev_mode)
+            torch._C._jit_set_profiling_executor(prev_exec)
+
     @unittest.skipIf(not RUN_CUDA, "test_dropout_cuda require CUDA")
     @unittest.skipIf(GRAPH_EXECUTOR == ProfilingMode.LEGACY, "fixme")
     def test_dropout_cuda(self):
@@ -127,6 +127,50 @@ class TestMkldnn(TestCase):
                 self._test_serialization(mkldnn_conv2d, (x.to_mkldnn(),))
                 self._test_tracing(mkldnn_conv2d, (x.to_mkldnn(),))
 
+    def test_cat(self):
+        x = torch.randn(2, 3, 8, 8, dtype=torch.float32)
+        y = torch.randn(2, 5, 8, 8, dtype=torch.float32)
+        for dim in [1, -3]:
+            self.assertEqual(
+                torch.cat([x, y], dim=dim),
+                torch.cat([x.to_mkldnn(), y.to_mkldnn()], dim=dim).to_dense())
+        self.assertEqual(
+            torch.cat([x, x], dim=0),
+            torch.cat([x.to_mkldnn(), x.to_mkldnn()], dim=0).to_dense())
+        self.assertRaisesRegex(RuntimeError,
+                               "expected all inputs to be mkldnn tensors",
+                               lambda: torch.cat([x.to_mkldnn(), y], dim=1))
+
+    def test_conv2d_weight_prepack_cache(self):
+        x = torch.randn(2, 3, 16, 16, dtype=torch.float32)
+        conv2d = torch.nn.Conv2d(3, 8, 3).float()
+        y1 = conv2d(x)
+        # The second call reuses the cached blocked-layout weight.
+        self.assertEqual(conv2d(x), y1)
+        # An in-place weight update must invalidate the cached reorder; a
+        # fresh clone of the weight takes an uncached path, so it catches a
+        # stale cache entry.
+        with torch.no_grad():
+            conv2d.weight += 1
+        self.assertEqual(
+            conv2d(x),
+            torch.nn.functional.conv2d(
+                x, conv2d.weight.detach().clone(), conv2d.bias))
+
+    def test_linear_dense_weight(self):
+        x = torch.randn(3, 16, dtype=torch.float32)
+        for bias in [True, False]:
+            linear = torch.nn.Linear(16, 8, bias=bias).float()
+            # Dense weights are accepted directly and reordered through the
+            # prepack cache; the result has to match the converted module.
+            mkldnn_linear = mkldnn_utils.to_mkldnn(copy.deepcopy(linear))
+            y_dense_weight = torch._C._nn.mkldnn_linear(
+                x.to_mkldnn(), linear.weight,
+                linear.bias if bias else None).to_dense()
+            self.assertEqual(
+                mkldnn_linear(x.to_mkldnn()).to_dense(), y_dense_weight)
+            self.assertEqual(linear(x), y_dense_weight)
+
     def test_conv2d_legacy_jit_model(self):
         """
         MKLDNN integration used to serialize models with 5d weight for grouped
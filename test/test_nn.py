@@ -2905,6 +2905,30 @@ class TestNN(NNTestCase):
         self.assertTrue(a.ne(torch.arange(1, 7, dtype=a.dtype).view(2, 3)).all())
         self.assertTrue(a.norm(p=opts["norm_type"], dim=1).le(opts["max_norm"]).all())
 
+    def test_embedding_bag_rowwise_adagrad_update(self):
+        num_rows, dim = 10, 4
+        lr, eps = 0.1, 1e-8
+        weight = torch.randn(num_rows, dim)
+        state_sum = torch.rand(num_rows)
+        # Bags [0:2), [2:2), [2:5) and [5:7); row 7 repeats both within a bag
+        # and across bags, so the update has to see its own state changes.
+        indices = torch.tensor([0, 3, 7, 7, 1, 7, 4])
+        offset2bag = torch.tensor([0, 0, 2, 2, 2, 3, 3])
+        grad = torch.randn(4, dim)
+
+        ref_weight = weight.clone()
+        ref_state_sum = state_sum.clone()
+        for i in range(indices.numel()):
+            row, bag = indices[i].item(), offset2bag[i].item()
+            g = grad[bag]
+            ref_state_sum[row] += (g * g).mean()
+            ref_weight[row] -= lr * g / (ref_state_sum[row].sqrt() + eps)
+
+        torch._embedding_bag_rowwise_adagrad_update_(
+            weight, state_sum, grad, indices, offset2bag, lr, eps)
+        self.assertEqual(weight, ref_weight)
+        self.assertEqual(state_sum, ref_state_sum)
+
     def test_fractional_max_pool2d(self):
         x = torch.randn(1, 2, 7, 7, requires_grad=True)
         samples = x.new(1, 2, 2).uniform_()
@@ -3310,6 +3334,27 @@ class TestNN(NNTestCase):
                 output = module(input)
                 self.assertEqual(output.size(), (4,) + (2,) * (numel - 1) + (4,))
 
+    def test_pooling_nhwc_cpu(self):
+        for pool in [torch.nn.MaxPool2d((3, 3), stride=2, padding=1),
+                     torch.nn.AvgPool2d((3, 3), stride=2, padding=1)]:
+            input = torch.randint(1, 10, (4, 8, 8, 8), dtype=torch.float32)
+            input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+            grad = torch.randint(1, 10, (4, 8, 4, 4), dtype=torch.float32)
+            grad = grad.contiguous(memory_format=torch.channels_last)
+
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            ref_grad = grad.detach().clone().contiguous()
+
+            out = pool(input)
+            out.backward(grad)
+            ref_out = pool(ref_input)
+            ref_out.backward(ref_grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(input.grad, ref_input.grad)
+
     @unittest.skipIf(not TEST_CUDA, "CUDA unavailable")
     def test_adaptive_pooling_avg_nhwc(self):
         input = torch.randint(1, 10, (4, 8, 8, 8), dtype=torch.float32, device="cuda")
@@ -4428,6 +4473,60 @@ class TestNN(NNTestCase):
         with self.assertRaisesRegex(RuntimeError, 'empty tensor'):
             packed = rnn_utils.pack_padded_sequence(torch.randn(0, 0), [])
 
+    def test_pack_ragged_sequence(self):
+        # unsorted lengths are fine: the layout is batch-major
+        lengths = [4, 1, 3]
+        for batch_first in (True, False):
+            padded = torch.zeros(3, 5, 2)
+            for b, l in enumerate(lengths):
+                padded[b, :l] = torch.randn(l, 2)
+            src = (padded if batch_first else padded.transpose(0, 1)).detach().requires_grad_()
+
+            data, offsets = rnn_utils.pack_ragged_sequence(src, lengths, batch_first=batch_first)
+            self.assertEqual(offsets, torch.tensor([0, 4, 5, 8]))
+            expected = torch.cat([padded[b, :l] for b, l in enumerate(lengths)])
+            self.assertEqual(data, expected)
+
+            # round trip restores the padded batch and the lengths
+            unpacked, unpacked_len = rnn_utils.pad_ragged_sequence(
+                data, offsets, batch_first=batch_first)
+            self.assertEqual(unpacked, src)
+            self.assertEqual(unpacked_len, torch.tensor(lengths))
+
+            # token-wise compute on packed data matches the padded compute
+            linear = nn.Linear(2, 3)
+            out_packed = linear(data)
+            out_padded = linear(padded)
+            for b, l in enumerate(lengths):
+                self.assertEqual(out_packed[offsets[b]:offsets[b + 1]], out_padded[b, :l])
+
+            # gradient only flows into the real tokens
+            data.sum().backward()
+            grad = src.grad if batch_first else src.grad.transpose(0, 1)
+            for b, l in enumerate(lengths):
+                self.assertEqual(grad[b, :l], torch.ones(l, 2))
+                self.assertEqual(grad[b, l:].abs().sum(), 0)
+
+        # ragged softmax normalizes each sequence over its own length only
+        scores = torch.randn(8, requires_grad=True, dtype=torch.double)
+        offsets = torch.tensor([0, 4, 5, 8])
+        res = torch._ragged_softmax(scores, offsets)
+        ref = torch.cat([F.softmax(scores[s:e], dim=0)
+                         for s, e in zip(offsets[:-1], offsets[1:])])
+        self.assertEqual(res, ref)
+        self.assertEqual(res[4].item(), 1.)
+        gradcheck(lambda x: torch._ragged_softmax(x, offsets), (scores,))
+
+        # trailing dimensions are normalized independently
+        scores2d = torch.randn(8, 3)
+        res2d = torch._ragged_softmax(scores2d, offsets)
+        ref2d = torch.cat([F.softmax(scores2d[s:e], dim=0)
+                           for s, e in zip(offsets[:-1], offsets[1:])])
+        self.assertEqual(res2d, ref2d)
+
+        with self.assertRaisesRegex(RuntimeError, 'must equal the number of packed rows'):
+            torch._ragged_softmax(scores.detach(), torch.tensor([0, 4]))
+
     def test_LSTM_cell(self):
         # this is just a smoke test; these modules are implemented through
         # autograd so no Jacobian test is needed
@@ -4441,6 +4540,21 @@ class TestNN(NNTestCase):
 
             (hx + cx).sum().backward()
 
+    def test_LSTM_cell_fused_cpu(self):
+        # under no_grad the CPU cell takes a fused single-pass kernel; its
+        # output must match the composed autograd implementation.
+        for dtype in (torch.float, torch.double):
+            for hidden_size in (20, 31):  # vectorized width and tail
+                input = torch.randn(3, 10, dtype=dtype)
+                hx = torch.randn(3, hidden_size, dtype=dtype)
+                cx = torch.randn(3, hidden_size, dtype=dtype)
+                lstm = nn.LSTMCell(10, hidden_size).to(dtype)
+                hx_ref, cx_ref = lstm(input, (hx, cx))
+                with torch.no_grad():
+                    hx_fused, cx_fused = lstm(input, (hx, cx))
+                self.assertEqual(hx_ref, hx_fused)
+                self.assertEqual(cx_ref, cx_fused)
+
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
     def test_pack_sequence_batch_sizes_throw(self):
         with self.assertRaisesRegex(ValueError, r"batch_sizes should always be on CPU"):
@@ -7912,6 +8026,31 @@ class TestNN(NNTestCase):
         self.assertEqual(input.grad.dtype, dtype)
         self.assertEqual(input.grad, inputf.grad, prec=1e-1)
 
+    def test_cross_entropy_fused_matches_reference(self):
+        # 2D float/double CPU inputs take a fused kernel; it must agree with
+        # the explicit nll_loss(log_softmax(...)) composition.
+        for dtype in [torch.float, torch.double]:
+            for reduction in ['none', 'mean', 'sum']:
+                for weight in [None, torch.rand(10, dtype=dtype)]:
+                    input = torch.randn(15, 10, dtype=dtype, requires_grad=True)
+                    target = torch.empty(15, dtype=torch.long).random_(10)
+                    target[3] = -100  # exercise ignore_index
+
+                    fused = F.cross_entropy(input, target, weight, reduction=reduction)
+                    ref = F.nll_loss(F.log_softmax(input, 1), target, weight,
+                                     reduction=reduction)
+                    self.assertEqual(fused, ref)
+
+                    grad_output = torch.rand_like(fused)
+                    fused_grad, = torch.autograd.grad(fused, input, grad_output)
+                    ref_grad, = torch.autograd.grad(ref, input, grad_output)
+                    self.assertEqual(fused_grad, ref_grad)
+
+        input = torch.randn(6, 5, dtype=torch.double, requires_grad=True)
+        target = torch.empty(6, dtype=torch.long).random_(5)
+        target[1] = -100
+        gradgradcheck(lambda x: F.cross_entropy(x, target), [input])
+
     @unittest.skipIf(not torch.cuda.is_available(), "CUDA not available")
     def test_convert_sync_batchnorm(self):
         module = torch.nn.Sequential(
@@ -913,6 +913,25 @@ class TestSparse(TestCase):
         test_shape(10, 100, 0, 0)
         test_shape(10, 100, 0, 20)
 
+    def test_mm_repeated(self):
+        # Multiplying with the same coalesced sparse operand repeatedly must
+        # keep producing the right answer, including after its indices are
+        # modified in place (the CUDA backend caches the CSR conversion of
+        # the indices and invalidates it through the version counter).
+        i = self.index_tensor([[0, 1, 2], [1, 2, 3]])
+        v = self.value_tensor([1., 2., 3.])
+        x = self.sparse_tensor(i, v, torch.Size([5, 5])).coalesce()
+        y = torch.randn(5, 4, dtype=self.value_dtype, device=self.device)
+
+        expected = torch.mm(x.to_dense(), y)
+        for _ in range(2):
+            self.assertEqual(torch.mm(x, y), expected)
+
+        # Rows stay sorted, so the tensor remains validly coalesced.
+        x._indices()[1, 0] = 4
+        expected = torch.mm(x.to_dense(), y)
+        self.assertEqual(torch.mm(x, y), expected)
+
     @cpu_only
     def test_saddmm(self):
         def test_shape(di, dj, dk, nnz):
@@ -979,6 +998,39 @@ class TestSparse(TestCase):
         test_shape(7, 8, 9, 20, False)
         test_shape(7, 8, 9, 20, True)
 
+    @cpu_only
+    @unittest.skipIf(not torch.backends.mkl.is_available(), "Test requires MKL")
+    def test_sparse_csr_addmm(self):
+        def test_shape(m, k, n, nnz, beta, alpha):
+            S = self._gen_sparse(2, nnz, [m, k])[0].coalesce()
+            crow_indices = torch._convert_indices_from_coo_to_csr(
+                S.indices()[0], m)
+            col_indices = S.indices()[1]
+            values = S.values()
+            D1 = torch.randn(m, n, device=self.device)
+            D2 = torch.randn(k, n, device=self.device)
+
+            res = torch._sparse_csr_addmm(
+                D1, crow_indices, col_indices, values, [m, k], D2,
+                beta=beta, alpha=alpha)
+            expected = torch.addmm(D1, S.to_dense(), D2, beta=beta, alpha=alpha)
+            self.assertEqual(res, expected)
+
+        test_shape(7, 8, 9, 20, 1, 1)
+        test_shape(7, 8, 9, 20, 0.5, 2)
+        test_shape(7, 8, 9, 20, 0, 1)
+        test_shape(7, 8, 9, 0, 1, 1)
+
+    def test_convert_indices_from_coo_to_csr(self):
+        row_indices = torch.tensor([0, 0, 2, 2, 2, 4], dtype=torch.long)
+        crow_indices = torch._convert_indices_from_coo_to_csr(row_indices, 5)
+        self.assertEqual(
+            crow_indices, torch.tensor([0, 2, 2, 5, 5, 6], dtype=torch.long))
+        self.assertEqual(
+            torch._convert_indices_from_coo_to_csr(
+                torch.empty(0, dtype=torch.long), 3),
+            torch.zeros(4, dtype=torch.long))
+
     def test_dsmm(self):
         def test_shape(di, dj, dk, nnz):
             x = self._gen_sparse(2, nnz, [di, dj])[0]
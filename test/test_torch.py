@@ -4104,6 +4104,56 @@ tensor([[[1., 1., 1.,  ..., 1., 1., 1.],
             self.assertIs(pinned, pinned.pin_memory())
             self.assertEqual(pinned.data_ptr(), pinned.pin_memory().data_ptr())
 
+    @unittest.skipIf(PYTORCH_CUDA_MEMCHECK, "is_pinned uses failure to detect pointer property")
+    @unittest.skipIf(not torch.cuda.is_available(), 'no CUDA')
+    def test_pin_memory_batch(self):
+        # small tensors are copied into pinned allocations; tensors above the
+        # registration threshold may be pinned in place.
+        tensors = [torch.randn(3, 5), torch.randn(512, 1024), torch.randn(2)]
+        pinned = torch._pin_memory_batch(tensors)
+        self.assertEqual(len(pinned), len(tensors))
+        for original, result in zip(tensors, pinned):
+            self.assertTrue(result.is_pinned())
+            self.assertEqual(result, original)
+
+        # already pinned tensors are passed through without another copy.
+        repinned = torch._pin_memory_batch(pinned)
+        for result, again in zip(pinned, repinned):
+            self.assertEqual(result.data_ptr(), again.data_ptr())
+
+        self.assertRaises(
+            RuntimeError,
+            lambda: torch._pin_memory_batch([torch.randn(2).cuda()]))
+
+    @unittest.skipIf(PYTORCH_CUDA_MEMCHECK, "is_pinned uses failure to detect pointer property")
+    @unittest.skipIf(not torch.cuda.is_available(), 'no CUDA')
+    def test_pin_memory_inplace(self):
+        # In-place pinning registers the existing pages: no copy, same
+        # storage, and views become pinned too.
+        x = torch.randn(64, 64)
+        view = x[3]
+        ptr = x.data_ptr()
+        result = x._pin_memory_inplace_()
+        self.assertIs(result, x)
+        self.assertTrue(x.is_pinned())
+        self.assertTrue(view.is_pinned())
+        self.assertEqual(x.data_ptr(), ptr)
+
+        self.assertRaises(
+            RuntimeError,
+            lambda: torch.randn(2).cuda()._pin_memory_inplace_())
+
+    @unittest.skipIf(PYTORCH_CUDA_MEMCHECK, "is_pinned uses failure to detect pointer property")
+    @unittest.skipIf(not torch.cuda.is_available(), 'no CUDA')
+    def test_pin_memory_async(self):
+        from torch.utils.data._utils.pin_memory import pin_memory_async
+        tensors = [torch.randn(3, 5), torch.randn(16, 16)]
+        future = pin_memory_async(tensors)
+        pinned = future.result()
+        for original, result in zip(tensors, pinned):
+            self.assertTrue(result.is_pinned())
+            self.assertEqual(result, original)
+
     @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
     def test_numpy_unresizable(self):
         x = np.zeros((2, 2))
@@ -7103,6 +7153,22 @@ class TestTorchDeviceType(TestCase):
         for upper, batchsize in product([True, False], [(3,), (3, 4), (2, 3, 4)]):
             cholesky_test_helper(3, batchsize, upper)
 
+    @skipCUDAIfNoMagma
+    @skipCPUIfNoLapack
+    @dtypes(torch.double)
+    def test_cholesky_batched_many_batches(self, device, dtype):
+        from torch.testing._internal.common_utils import random_symmetric_pd_matrix
+
+        # many small matrices, enough to spread the batch over all threads
+        A = random_symmetric_pd_matrix(4, 256, dtype=dtype, device=device)
+        L = torch.cholesky(A)
+        self.assertEqual(A, torch.matmul(L, L.transpose(-2, -1)))
+
+        # a failure in the middle of the batch must still report its index
+        A[100] = torch.zeros(4, 4, dtype=dtype, device=device)
+        with self.assertRaisesRegex(RuntimeError, r'For batch 100'):
+            torch.cholesky(A)
+
     @skipCUDAIfNoMagma
     @skipCPUIfNoLapack
     @dtypes(torch.double)
@@ -8547,6 +8613,34 @@ class TestTorchDeviceType(TestCase):
                 raise unittest.SkipTest('Insufficient memory')
             raise
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_argminmax_vectorized(self, device, dtype):
+        # large contiguous slices take the vectorized selection path
+        x = torch.randn(100000, device=device, dtype=dtype)
+        self.assertEqual(x.argmax().item(), x.max(0)[1].item())
+        self.assertEqual(x.argmin().item(), x.min(0)[1].item())
+        self.assertEqual(x[x.argmax()], x.max())
+        self.assertEqual(x[x.argmin()], x.min())
+
+        # reduction over the inner dimension, one output per row
+        y = torch.randn(7, 1000, device=device, dtype=dtype)
+        for r in range(y.size(0)):
+            self.assertEqual(y.argmax(1)[r], y[r].argmax())
+            self.assertEqual(y.argmin(1)[r], y[r].argmin())
+
+        # strided slices fall back to the scalar reduce but must agree
+        z = y[:, ::3]
+        self.assertEqual(z.argmax(1), z.contiguous().argmax(1))
+        self.assertEqual(z.argmin(1), z.contiguous().argmin(1))
+
+        # NaN wins over every other value, wherever it is
+        for pos in (0, 3, 99998):
+            x2 = x.clone()
+            x2[pos] = float('nan')
+            self.assertEqual(x2.argmax().item(), pos)
+            self.assertEqual(x2.argmin().item(), pos)
+
     def test_remainder_overflow(self, device):
         # Check Integer Overflows
         x = torch.tensor(23500, dtype=torch.int64, device=device)
@@ -9788,6 +9882,18 @@ class TestTorchDeviceType(TestCase):
                             self.assertTrue(from_ <= double_t.min() <= (from_ + delta))
                             self.assertTrue((to_ - delta) <= double_t.max() < to_)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_uniform_contiguous_stream(self, device, dtype):
+        # the bulk fill used for contiguous tensors must draw the same
+        # sequence as the per-element path used for strided ones
+        torch.manual_seed(9)
+        contig = torch.empty(100, dtype=dtype, device=device).uniform_(-3, 7)
+        torch.manual_seed(9)
+        strided = torch.empty(200, dtype=dtype, device=device)[::2].uniform_(-3, 7)
+        self.assertEqual(contig, strided)
+        self.assertTrue((contig >= -3).all() and (contig < 7).all())
+
     @dtypes(torch.float, torch.double, torch.complex64, torch.complex128)
     def test_randn(self, device, dtype):
         for size in [0, SIZE]:
@@ -10339,6 +10445,26 @@ class TestTorchDeviceType(TestCase):
         # Check that output maintained correct shape
         self.assertEqual(raw_tensor.shape, raw_tensor.grad.shape)
 
+    @onlyCPU
+    def test_cumsum_cumprod_long_line(self, device):
+        # a single long scan line takes the blocked parallel path; it must
+        # agree with the per-chunk serial recurrence
+        n = 200000
+        x = torch.randint(-4, 5, (n,), device=device, dtype=torch.long)
+        c = x.cumsum(0)
+        self.assertEqual(c[0], x[0])
+        self.assertEqual(c[1:] - c[:-1], x[1:])
+
+        y = torch.rand(n, device=device) + 0.5
+        self.assertEqual(y.cumsum(0)[-1], y.sum(), 1e-2)
+        self.assertEqual(y.cumsum(0)[:100], y[:100].cumsum(0))
+
+        z = torch.ones(n, device=device)
+        z[12345] = 0.
+        zp = z.cumprod(0)
+        self.assertTrue((zp[:12345] == 1).all())
+        self.assertTrue((zp[12345:] == 0).all())
+
     def test_cumprod(self, device):
         x = torch.rand(100, 100, device=device)
         res1 = torch.cumprod(x, 1)
@@ -10626,6 +10752,33 @@ class TestTorchDeviceType(TestCase):
             expanded = torch.randn(1, 5, 1, 2, device=device).expand(3, 5, 7, 2)
             test_against_np(expanded)
 
+    @onlyCPU
+    def test_histc_accumulate(self, device):
+        # streaming chunks accumulated into one histogram must match a single
+        # histc over the concatenated data
+        chunks = [torch.randn(3000, device=device) for _ in range(4)]
+        hist = torch.zeros(20, device=device)
+        for chunk in chunks:
+            torch._histc_accumulate_(hist, chunk, -3, 3)
+        expected = torch.histc(torch.cat(chunks), bins=20, min=-3, max=3)
+        self.assertEqual(hist, expected)
+        # accumulating does not clear previous counts
+        before = hist.clone()
+        torch._histc_accumulate_(hist, chunks[0], -3, 3)
+        self.assertEqual(hist, before + torch.histc(chunks[0], bins=20, min=-3, max=3))
+        # the range is mandatory and must be finite and ordered
+        with self.assertRaisesRegex(RuntimeError, "max must be larger than min"):
+            torch._histc_accumulate_(hist, chunks[0], 3, 3)
+        with self.assertRaisesRegex(RuntimeError, "is not finite"):
+            torch._histc_accumulate_(hist, chunks[0], 0, float('inf'))
+
+        # large input exercises the per-thread histogram path
+        big = torch.randn(200000, device=device)
+        hist = torch.zeros(64, device=device)
+        torch._histc_accumulate_(hist, big, -4, 4)
+        self.assertEqual(hist, torch.histc(big, bins=64, min=-4, max=4))
+        self.assertEqual(hist.sum().item(), ((big >= -4) & (big <= 4)).sum().item())
+
     def test_bool_tensor_comparison_ops(self, device):
         a = torch.tensor([True, False, True, False, True, False], dtype=torch.bool, device=device)
         b = torch.tensor([True, False, True, True, True, True], dtype=torch.bool, device=device)
@@ -10688,6 +10841,20 @@ class TestTorchDeviceType(TestCase):
             x.resize_(shape)
             self.assertEqual(shape, x.shape)
 
+    @onlyCPU
+    def test_resize_amortized(self, device):
+        x = torch.tensor([], device=device)
+        for n in range(1, 100):
+            x._resize_amortized_((n, 4))
+            x[n - 1] = n
+        self.assertEqual(x.shape, (99, 4))
+        self.assertEqual(x[49], torch.full((4,), 50., device=device))
+        # the storage is over-allocated geometrically, distinct from the size
+        self.assertGreater(x.storage().size(), x.numel())
+        x._shrink_to_fit_()
+        self.assertEqual(x.storage().size(), x.numel())
+        self.assertEqual(x[49], torch.full((4,), 50., device=device))
+
     def test_resize_as_all_dtypes_and_devices(self, device):
         for dt in torch.testing.get_all_dtypes():
             x = torch.tensor([[1, 2], [3, 4], [5, 6]], dtype=dt, device=device)
@@ -11500,11 +11667,78 @@ class TestTorchDeviceType(TestCase):
                         for i in range(len(t)):
                             self.assertEqual(t[i].cpu().numpy(), np1[i])
 
+    def test_nonzero_large(self, device):
+        # Large enough to split across threads on CPU; the rows must still
+        # come out dense and in lexicographic order.
+        x = torch.zeros(1000, 200, device=device)
+        x[::3, ::7] = 1
+        idx = x.nonzero()
+        self.assertEqual(idx.size(0), (x != 0).sum().item())
+        recon = torch.zeros_like(x)
+        recon[idx[:, 0], idx[:, 1]] = 1
+        self.assertEqual(recon, x)
+        lin = idx[:, 0] * x.size(1) + idx[:, 1]
+        self.assertTrue((lin[1:] > lin[:-1]).all().item())
+
+        # masked_select over the same data takes the two-pass path as well
+        # and must preserve element order.
+        y = torch.arange(x.numel(), dtype=torch.float, device=device).reshape(x.shape)
+        sel = y.masked_select(x != 0)
+        self.assertEqual(sel, lin.to(torch.float))
+
     def test_nonzero_non_diff(self, device):
         x = torch.randn(10, requires_grad=True)
         nz = x.nonzero()
         self.assertFalse(nz.requires_grad)
 
+    @onlyCPU
+    def test_searchsorted(self, device):
+        # fixed sequences with ties and out-of-range values
+        boundaries = torch.tensor([1, 3, 5, 7, 9], device=device)
+        values = torch.tensor([[3, 6, 9], [0, 5, 10]], device=device)
+        self.assertEqual(torch.searchsorted(boundaries, values),
+                         torch.tensor([[1, 3, 4], [0, 2, 5]], device=device))
+        self.assertEqual(torch.searchsorted(boundaries, values, right=True),
+                         torch.tensor([[2, 3, 5], [0, 3, 5]], device=device))
+        self.assertEqual(torch.bucketize(values, boundaries),
+                         torch.searchsorted(boundaries, values))
+        self.assertEqual(torch.bucketize(values, boundaries, right=True),
+                         torch.searchsorted(boundaries, values, right=True))
+
+        # batched sorted sequence: each row of values searches its own row
+        sequence_2d = torch.tensor([[1, 3, 5, 7, 9], [2, 4, 6, 8, 10]], device=device)
+        self.assertEqual(torch.searchsorted(sequence_2d, values),
+                         torch.tensor([[1, 3, 4], [0, 2, 4]], device=device))
+
+        # scalar input and int32 output
+        self.assertEqual(torch.searchsorted(boundaries, 6).item(), 3)
+        self.assertEqual(torch.bucketize(6, boundaries).item(), 3)
+        out32 = torch.searchsorted(boundaries, values, out_int32=True)
+        self.assertEqual(out32.dtype, torch.int32)
+        self.assertEqual(out32.to(torch.int64), torch.searchsorted(boundaries, values))
+        out = torch.empty_like(values)
+        torch.searchsorted(boundaries, values, out=out)
+        self.assertEqual(out, torch.searchsorted(boundaries, values))
+
+        # large input exercises the parallel path; check against numpy
+        if TEST_NUMPY:
+            for dtype in (torch.float, torch.double, torch.long):
+                seq = torch.randn(500, device=device).mul(10).to(dtype).sort()[0]
+                vals = torch.randn(100000, device=device).mul(12).to(dtype)
+                for right in (False, True):
+                    ref = np.searchsorted(seq.numpy(), vals.numpy(),
+                                          side='right' if right else 'left')
+                    res = torch.searchsorted(seq, vals, right=right)
+                    self.assertEqual(res.numpy(), ref)
+
+        # shape / dtype checks
+        with self.assertRaisesRegex(RuntimeError, "same dtype"):
+            torch.searchsorted(boundaries.float(), values)
+        with self.assertRaisesRegex(RuntimeError, "boundaries tensor must be 1 dimension"):
+            torch.bucketize(values, sequence_2d)
+        with self.assertRaisesRegex(RuntimeError, "same leading dimensions"):
+            torch.searchsorted(sequence_2d, torch.zeros(3, 3, dtype=torch.long, device=device))
+
     def _brute_pdist(self, inp, p=2):
         """Computes the same as torch.pdist using primitives"""
         n = inp.shape[-2]
@@ -11539,7 +11773,7 @@ class TestTorchDeviceType(TestCase):
 
     @slowTest
     def test_pdist_norm_forward(self, device):
-        for shape in [(4, 5), (3, 2), (2, 1), (1500, 1)]:
+        for shape in [(4, 5), (3, 2), (2, 1), (300, 7), (1500, 1)]:
             for p in [0, 1, 2, 3, 1.5, 2.5, float('inf')]:
                 for trans in [False, True]:
                     for dtype in [torch.float32, torch.float64]:
@@ -12668,6 +12902,27 @@ class TestTorchDeviceType(TestCase):
         self.assertEqual(val, expect, allow_inf=True)
         self.assertEqual(idx, [5, 4, 3, 2])
 
+    @onlyCPU
+    def test_topk_large_slice(self, device):
+        # a single long slice takes the within-slice parallel selection path
+        t = torch.randn(200000, device=device)
+        for k in (1, 100, 5000):
+            for largest in (True, False):
+                val, idx = t.topk(k, largest=largest)
+                ref = t.sort(descending=largest)[0][:k]
+                self.assertEqual(val, ref)
+                self.assertEqual(t[idx], val)
+                # unsorted output must still select the same set of values
+                val_u, idx_u = t.topk(k, largest=largest, sorted=False)
+                self.assertEqual(val_u.sort(descending=largest)[0], ref)
+                self.assertEqual(t[idx_u], val_u)
+
+        # NaN is selected as the largest value in the chunked path too
+        t[123456] = float('nan')
+        val, idx = t.topk(10)
+        self.assertEqual(idx[0].item(), 123456)
+        self.assertTrue(torch.isnan(val[0]))
+
     def test_is_signed(self, device):
         self.assertEqual(torch.IntTensor(5).to(device).is_signed(), True)
         self.assertEqual(torch.ByteTensor(5).to(device).is_signed(), False)
@@ -13025,6 +13280,25 @@ class TestTorchDeviceType(TestCase):
                                     count += 1
                             self.assertEqual(j, count)
 
+    @onlyCPU
+    def test_unique_large(self, device):
+        # Large enough to take the parallel hash path on CPU; the unsorted
+        # variant must return values in first-occurrence order there.
+        x = torch.randint(0, 500, (100000,), dtype=torch.long, device=device)
+        uniq, inverse, counts = torch.unique(
+            x, sorted=True, return_inverse=True, return_counts=True)
+        self.assertEqual(uniq, x.unique(sorted=True))
+        self.assertTrue((uniq[1:] > uniq[:-1]).all().item())
+        self.assertEqual(uniq[inverse], x)
+        self.assertEqual(counts.sum().item(), x.numel())
+        self.assertEqual(counts, torch.bincount(x, minlength=500)[uniq])
+
+        uniq_u, inverse_u = torch.unique(x, sorted=False, return_inverse=True)
+        self.assertEqual(uniq_u[inverse_u], x)
+        seen = set()
+        first_occurrence = [v for v in x.tolist() if v not in seen and not seen.add(v)]
+        self.assertEqual(uniq_u.tolist(), first_occurrence)
+
     @dtypes(*set(torch.testing.get_all_dtypes()) - {torch.bfloat16})
     def test_unique_consecutive(self, device, dtype):
         if dtype is torch.half and self.device_type == 'cpu':
@@ -13412,6 +13686,30 @@ class TestTorchDeviceType(TestCase):
             self.assertEqual(prob_dist.dim(), 1, "wrong number of prob_dist dimensions")
             self.assertEqual(sample_indices.size(0), n_sample, "wrong number of samples")
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_multinomial_many_samples(self, device, dtype):
+        # enough draws with replacement to use the alias-table fast path
+        probs = torch.tensor([0.1, 0.0, 0.4, 0.2, 0.3], device=device, dtype=dtype)
+        n_sample = 100000
+        samples = torch.multinomial(probs, n_sample, True)
+        self.assertEqual(samples.size(0), n_sample)
+        self.assertTrue((samples >= 0).all() and (samples < 5).all())
+        self.assertFalse((samples == 1).any(), "sampled an index with zero probability")
+        freqs = torch.bincount(samples, minlength=5).to(dtype=dtype) / n_sample
+        self.assertEqual(freqs, probs, 0.02)
+
+        # unnormalized rows, batched
+        probs2 = torch.tensor([[1., 1., 2.], [0., 3., 1.]], device=device, dtype=dtype)
+        samples2 = torch.multinomial(probs2, n_sample, True)
+        freqs2 = torch.stack([torch.bincount(row, minlength=3) for row in samples2])
+        self.assertEqual(freqs2.to(dtype=dtype) / n_sample,
+                         probs2 / probs2.sum(-1, keepdim=True), 0.02)
+
+        # a deterministic distribution stays deterministic
+        point = torch.tensor([0., 1., 0.], device=device, dtype=dtype)
+        self.assertTrue((torch.multinomial(point, 1000, True) == 1).all())
+
     def test_var_unbiased(self, device):
         tensor = torch.randn(100, device=device)
         self.assertEqual(tensor.var(0), tensor.var(0, unbiased=True))
@@ -13513,6 +13811,11 @@ class TestTorchDeviceType(TestCase):
         l = torch.randn(5, 10, dtype=dtype, device=device)
         r = torch.randn(5, 20, dtype=dtype, device=device)
         w = torch.randn(30, 10, 20, dtype=dtype, device=device)
+        P = torch.randn(2, 3, dtype=dtype, device=device)
+        Q = torch.randn(3, 5, dtype=dtype, device=device)
+        R = torch.randn(5, 7, dtype=dtype, device=device)
+        S = torch.randn(7, 2, dtype=dtype, device=device)
+        T = torch.randn(3, 4, 5, 6, dtype=dtype, device=device)
         test_list = [
             # -- Vector
             ("i->", x),                 # sum
@@ -13547,6 +13850,13 @@ class TestTorchDeviceType(TestCase):
             # -- Other
             ("bn,anm,bm->ba", l, w, r),  # as torch.bilinear
             ("... ii->...i  ", I),       # batch diagonal with spaces
+            # -- Multi-operand (exercise the contraction-order planner)
+            ("ij,jk,kl->il", P, Q, R),            # matrix chain
+            ("ij,jk,kl,lm->im", P, Q, R, S),      # longer matrix chain
+            ("ea,fb,abcd,gc,hd->efgh",            # np.einsum optimize example
+             P, torch.randn(2, 4, dtype=dtype, device=device), T,
+             torch.randn(2, 5, dtype=dtype, device=device),
+             torch.randn(2, 6, dtype=dtype, device=device)),
         ]
         for test in test_list:
             actual = torch.einsum(test[0], test[1:])
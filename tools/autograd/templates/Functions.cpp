@@ -657,6 +657,41 @@ Tensor index_select_backward(Tensor grad, int64_t dim, Tensor indices, IntArrayR
 }
 
 Tensor slice_backward(Tensor grad, IntArrayRef input_sizes, int64_t dim, int64_t start, int64_t end, int64_t step) {
+  if (step == 1) {
+    // Unit-step slices (this is what narrow() lowers to) write every element
+    // of the result exactly once: zero only the complement of the slice
+    // instead of zero-filling the whole buffer and then overwriting the
+    // slice with grad, which writes the slice region twice and is pure
+    // memory traffic in slice-heavy backward passes.
+    const auto wrapped_dim = at::maybe_wrap_dim(dim, input_sizes.size());
+    auto grad_input = at::empty(input_sizes, grad.options());
+    if (grad_input.numel() == 0) {
+      return grad_input;
+    }
+    auto slice_view = grad_input.slice(wrapped_dim, start, end, step);
+    // Recover the normalized slice bounds from the view itself rather than
+    // re-deriving slice()'s clamping rules: grad_input is fresh with zero
+    // storage offset, so the view's offset is start * stride(dim).
+    const int64_t dim_size = grad_input.size(wrapped_dim);
+    const int64_t slice_start =
+        slice_view.storage_offset() / grad_input.stride(wrapped_dim);
+    const int64_t slice_len = slice_view.size(wrapped_dim);
+    if (slice_start > 0) {
+      grad_input.narrow(wrapped_dim, 0, slice_start).zero_();
+    }
+    if (slice_start + slice_len < dim_size) {
+      grad_input
+          .narrow(
+              wrapped_dim,
+              slice_start + slice_len,
+              dim_size - slice_start - slice_len)
+          .zero_();
+    }
+    if (slice_len > 0) {
+      slice_view.copy_(grad);
+    }
+    return grad_input;
+  }
   auto grad_input = at::zeros(input_sizes, grad.options());
   grad_input.slice(dim, start, end, step).copy_(grad);
   return grad_input;
@@ -806,22 +841,24 @@ Tensor split_with_sizes_backward(const std::vector<torch::autograd::Variable> &g
                                  IntArrayRef split_sizes, int64_t dim, IntArrayRef sizes, const at::TensorOptions &options) {
   dim = at::maybe_wrap_dim(dim, sizes.size());
 
-  // it's possible some of the grads are not defined (represents tensors of all 0s).
-  // Since at::cat can't handle those, let's define them
-  std::vector<Tensor> grads_all_defined(grads.size());
+  // Pack the chunk gradients straight into the full-size buffer instead of
+  // materializing zero tensors for missing chunks and routing everything
+  // through at::cat: each element is written exactly once, and an undefined
+  // chunk gradient (a tensor of all 0s) becomes a zero_ on its slice rather
+  // than a fresh allocation plus a copy.
+  auto grad_input = at::empty(sizes, options);
+  int64_t offset = 0;
   for (size_t j = 0; j < grads.size(); ++j) {
+    const auto length = split_sizes[j];
+    auto segment = grad_input.narrow(dim, offset, length);
     if (grads[j].defined()) {
-      grads_all_defined[j] = grads[j];
+      segment.copy_(grads[j]);
     } else {
-      auto length = split_sizes[j];
-      auto grad_size = sizes.vec();
-      grad_size[dim] = length;
-      grads_all_defined[j] = at::zeros(grad_size, options);
+      segment.zero_();
     }
+    offset += length;
   }
-
-  auto ret =  at::cat(grads_all_defined, dim);
-  return ret;
+  return grad_input;
 }
 
 Tensor split_backward(const std::vector<torch::autograd::Variable> &grads,
@@ -988,6 +1025,40 @@ Tensor binary_cross_entropy_double_backward_grad_output(const Tensor & grad, con
   return ggO;
 }
 
+Tensor cross_entropy_double_backward(const Tensor & grad, const Tensor & grad_output, const Tensor & self, const Tensor & target, const Tensor & weight, int64_t reduction, int64_t ignore_index) {
+  // _cross_entropy_loss_backward produces c * (softmax(self) - onehot(target))
+  // per row, where c collects grad_output, the class weight and the mean
+  // normalization. The onehot term is constant in self, so only the softmax
+  // Jacobian contributes.
+  auto p = self.softmax(-1);
+  auto valid = (target != ignore_index).to(self.scalar_type());
+  Tensor c;
+  if (weight.defined()) {
+    auto safe_target = target.masked_fill(target == ignore_index, 0);
+    c = weight.index_select(0, safe_target) * valid;
+  } else {
+    c = valid;
+  }
+  if (reduction == at::Reduction::Mean) {
+    c = c / c.sum();
+  }
+  c = c * grad_output;
+  return c.unsqueeze(-1) * p * (grad - (p * grad).sum(-1, true));
+}
+
+Tensor cross_entropy_double_backward_grad_output(const Tensor & grad, const Tensor & self, const Tensor & target, const Tensor & weight, int64_t reduction, int64_t ignore_index) {
+  // The backward output is linear in grad_output, so contract the incoming
+  // gradient with the response to a unit grad_output.
+  auto unit = reduction == at::Reduction::None
+      ? at::ones(target.sizes(), self.options())
+      : at::ones({}, self.options());
+  auto ggO = (at::_cross_entropy_loss_backward(unit, self, target, weight, reduction, ignore_index) * grad).sum(-1);
+  if (reduction != at::Reduction::None) {
+    ggO = ggO.sum();
+  }
+  return ggO;
+}
+
 Tensor l1_loss_double_backward_grad_output(const Tensor & grad, const Tensor & input, const Tensor & target, int64_t reduction) {
   auto output = l1_loss_backward(grad, input, target, at::Reduction::None);
   if (reduction == at::Reduction::Mean) {
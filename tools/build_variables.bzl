@@ -43,6 +43,7 @@ libtorch_sources = [
     "torch/csrc/autograd/functions/basic_ops.cpp",
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
+    "torch/csrc/autograd/grad_buffer.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
     "torch/csrc/autograd/profiler.cpp",
     "torch/csrc/autograd/record_function.cpp",
@@ -96,6 +97,7 @@ libtorch_sources = [
     "torch/csrc/jit/serialization/import_export_helpers.cpp",
     "torch/csrc/jit/runtime/instruction.cpp",
     "torch/csrc/jit/runtime/interpreter.cpp",
+    "torch/csrc/jit/runtime/static_runtime.cpp",
     "torch/csrc/jit/ir/ir.cpp",
     "torch/csrc/jit/ir/irparser.cpp",
     "torch/csrc/jit/jit_log.cpp",
@@ -142,6 +144,7 @@ libtorch_sources = [
     "torch/csrc/jit/passes/xnnpack_rewrite.cpp",
     "torch/csrc/jit/passes/fuse_linear.cpp",
     "torch/csrc/jit/passes/freeze_module.cpp",
+    "torch/csrc/jit/passes/mkldnn_layout_propagation.cpp",
     "torch/csrc/jit/passes/remove_expands.cpp",
     "torch/csrc/jit/passes/requires_grad_analysis.cpp",
     "torch/csrc/jit/passes/shape_analysis.cpp",
@@ -177,6 +180,7 @@ libtorch_sources = [
     "torch/csrc/jit/serialization/import_source.cpp",
     "torch/csrc/jit/testing/hooks_for_testing.cpp",
     "torch/csrc/jit/frontend/builtin_functions.cpp",
+    "torch/csrc/jit/api/inference_session.cpp",
     "torch/csrc/jit/api/module.cpp",
     "torch/csrc/jit/api/module_save.cpp",
     "torch/csrc/jit/api/object.cpp",
@@ -204,6 +208,7 @@ libtorch_sources = [
     "torch/csrc/utils/variadic.cpp",
     "torch/csrc/jit/tensorexpr/bounds_inference.cpp",
     "torch/csrc/jit/tensorexpr/codegen.cpp",
+    "torch/csrc/jit/tensorexpr/codegen_cache.cpp",
     "torch/csrc/jit/tensorexpr/eval.cpp",
     "torch/csrc/jit/tensorexpr/expr.cpp",
     "torch/csrc/jit/tensorexpr/function.cpp",
@@ -359,11 +359,8 @@ import torch.optim
 import torch.multiprocessing
 import torch.sparse
 import torch.utils.backcompat
-import torch.onnx
 import torch.jit
-import torch.hub
 import torch.random
-import torch.distributions
 import torch.testing
 import torch.backends.cuda
 import torch.backends.mkl
@@ -375,6 +372,35 @@ import torch.utils.data
 import torch.__config__
 import torch.__future__
 
+################################################################################
+# Lazily imported subpackages
+################################################################################
+
+# Rarely used subpackages that nothing above depends on are imported on
+# first attribute access (PEP 562) to keep cold `import torch` fast for
+# short-lived processes. The import system attaches the submodule to this
+# package, so __getattr__ only fires once per subpackage.
+_lazy_submodules = {
+    'distributions',
+    'hub',
+    'onnx',
+    'quasirandom',
+}
+
+if sys.version_info >= (3, 7):
+    def __getattr__(name):
+        if name in _lazy_submodules:
+            import importlib
+            return importlib.import_module('torch.' + name)
+        raise AttributeError(
+            "module '{}' has no attribute '{}'".format(__name__, name))
+else:
+    # Module-level __getattr__ needs Python 3.7; fall back to eager imports.
+    import torch.distributions
+    import torch.hub
+    import torch.onnx
+    import torch.quasirandom
+
 _C._init_names(list(torch._storage_classes))
 
 # attach docstrings to torch and tensor functions
@@ -391,9 +417,6 @@ def compiled_with_cxx11_abi():
 from torch._ops import ops
 from torch._classes import classes
 
-# Import the quasi random sampler
-import torch.quasirandom
-
 # If you are seeing this, it means that this call site was not checked if
 # the memory format could be preserved, and it was switched to old default
 # behaviour of contiguous
@@ -5184,6 +5184,97 @@ Example::
             [ 1,  2,  2,  0]])
 """.format(**common_args))
 
+add_docstr(torch.searchsorted,
+           r"""
+searchsorted(sorted_sequence, input, *, out_int32=False, right=False, out=None) -> Tensor
+
+Finds the indices from the *innermost* dimension of :attr:`sorted_sequence` such
+that, if the corresponding values in :attr:`input` were inserted before the
+indices, the order of the corresponding innermost dimension within
+:attr:`sorted_sequence` would be preserved. Returns a new tensor with the same
+size as :attr:`input`. If :attr:`right` is ``False`` (default), then the left
+boundary of :attr:`sorted_sequence` is closed.
+
+Args:
+    sorted_sequence (Tensor): N-D or 1-D tensor, containing monotonically
+        increasing sequence on the *innermost* dimension.
+    input (Tensor or Scalar): N-D tensor or a Scalar containing the search value(s).
+
+Keyword args:
+    out_int32 (bool, optional): indicate the output data type. torch.int32 if True,
+        torch.int64 otherwise. Default value is False, i.e. default output data type
+        is torch.int64.
+    right (bool, optional): if False, return the first suitable location that is
+        found. If True, return the last such index. If no suitable index found,
+        return 0 for non-numerical value (eg. nan, inf) or the size of *innermost*
+        dimension within :attr:`sorted_sequence` (one pass the last index of the
+        *innermost* dimension). In other words, if False, gets the lower bound index
+        for each value in :attr:`input` from the corresponding *innermost* dimension
+        of :attr:`sorted_sequence`. If True, gets the upper bound index instead.
+        Default value is False.
+    out (Tensor, optional): the output tensor, must be the same size as
+        :attr:`input` if provided.
+
+.. note:: If your use case is always 1-D sorted sequence, :func:`torch.bucketize` is
+          preferred, because it has fewer dimension checks resulting in slightly
+          better performance.
+
+Example::
+
+    >>> sorted_sequence = torch.tensor([[1, 3, 5, 7, 9], [2, 4, 6, 8, 10]])
+    >>> values = torch.tensor([[3, 6, 9], [3, 6, 9]])
+    >>> torch.searchsorted(sorted_sequence, values)
+    tensor([[1, 3, 4],
+            [1, 2, 4]])
+    >>> torch.searchsorted(sorted_sequence, values, right=True)
+    tensor([[2, 3, 5],
+            [1, 3, 4]])
+
+    >>> sorted_sequence_1d = torch.tensor([1, 3, 5, 7, 9])
+    >>> torch.searchsorted(sorted_sequence_1d, values)
+    tensor([[1, 3, 4],
+            [1, 3, 4]])
+""")
+
+add_docstr(torch.bucketize,
+           r"""
+bucketize(input, boundaries, *, out_int32=False, right=False, out=None) -> Tensor
+
+Returns the indices of the buckets to which each value in the :attr:`input` belongs,
+where the boundaries of the buckets are set by :attr:`boundaries`. Return a new tensor
+with the same size as :attr:`input`. If :attr:`right` is ``False`` (default), then the
+left boundary is closed.
+
+Args:
+    input (Tensor or Scalar): N-D tensor or a Scalar containing the search value(s).
+    boundaries (Tensor): 1-D tensor, must contain a monotonically increasing sequence.
+
+Keyword args:
+    out_int32 (bool, optional): indicate the output data type. torch.int32 if True,
+        torch.int64 otherwise. Default value is False, i.e. default output data type
+        is torch.int64.
+    right (bool, optional): if False, return the first suitable location that is
+        found. If True, return the last such index. If no suitable index found,
+        return 0 for non-numerical value (eg. nan, inf) or the size of
+        :attr:`boundaries` (one pass the last index). In other words, if False, gets
+        the lower bound index for each value in :attr:`input` from
+        :attr:`boundaries`. If True, gets the upper bound index instead. Default
+        value is False.
+    out (Tensor, optional): the output tensor, must be the same size as
+        :attr:`input` if provided.
+
+Example::
+
+    >>> boundaries = torch.tensor([1, 3, 5, 7, 9])
+    >>> v = torch.tensor([[3, 6, 9], [3, 6, 9]])
+    >>> torch.bucketize(v, boundaries)
+    tensor([[1, 3, 4],
+            [1, 3, 4]])
+    >>> torch.bucketize(v, boundaries, right=True)
+    tensor([[2, 3, 5],
+            [2, 3, 5]])
+""")
+
 add_docstr(torch.argsort,
            r"""
 argsort(input, dim=-1, descending=False) -> LongTensor
@@ -230,6 +230,13 @@ class profile(object):
             self cpu time might be artificially increased because of the shape
             collection.
 
+        profile_memory (bool, optional): Whether to report the amount of memory
+            allocated (or freed) by each operator. Allocator activity is
+            attributed to the innermost operator that was running when the
+            allocation happened; negative numbers mean an operator freed more
+            than it allocated (e.g. resize or the destruction of temporaries).
+            Default: ``False``
+
     .. warning:
         This context managers should not be called recursively, i.e. at most one
         instance should be enabled at any given time.
@@ -259,7 +266,8 @@ class profile(object):
         -----------------------------------  ---------------  ---------------  ---------------
 
     """
-    def __init__(self, enabled=True, use_cuda=False, record_shapes=False):
+    def __init__(self, enabled=True, use_cuda=False, record_shapes=False,
+                 profile_memory=False):
         self.enabled = enabled
         self.use_cuda = use_cuda
         self.function_events = None
@@ -267,6 +275,7 @@ class profile(object):
             return
         self.entered = False
         self.record_shapes = record_shapes
+        self.profile_memory = profile_memory
 
     def __enter__(self):
         if not self.enabled:
@@ -277,7 +286,12 @@ class profile(object):
         profiler_kind = torch.autograd.ProfilerState.CUDA if self.use_cuda \
             else torch.autograd.ProfilerState.CPU
         torch.autograd._enable_profiler(
-            torch.autograd.ProfilerConfig(profiler_kind, self.record_shapes))
+            torch.autograd.ProfilerConfig(
+                profiler_kind,
+                self.record_shapes,
+                1.0,  # sampling_prob
+                False,  # use_device_activities
+                self.profile_memory))
         return self
 
     def __exit__(self, exc_type, exc_val, exc_tb):
@@ -515,6 +529,21 @@ def format_time_share(time_us, total_time_us):
     return '{:.2f}%'.format(time_us * 100.0 / total_time_us)
 
 
+def format_memory(nbytes):
+    """Defines how to format memory in FunctionEvent; nbytes may be negative
+    for scopes that freed more than they allocated."""
+    KB = 1024
+    MB = 1024 * KB
+    GB = 1024 * MB
+    if abs(nbytes) >= GB:
+        return '{:.2f} Gb'.format(nbytes * 1.0 / GB)
+    elif abs(nbytes) >= MB:
+        return '{:.2f} Mb'.format(nbytes * 1.0 / MB)
+    elif abs(nbytes) >= KB:
+        return '{:.2f} Kb'.format(nbytes * 1.0 / KB)
+    return str(nbytes) + ' b'
+
+
 def attr_formatter(name):
     return property(lambda self: format_time(getattr(self, name)))
 
@@ -554,7 +583,8 @@ Kernel = namedtuple('Kernel', ['name', 'device', 'interval'])
 # TODO: record TID too
 class FunctionEvent(FormattedTimesMixin):
     """Profiling information about a single function."""
-    def __init__(self, id, name, thread, cpu_start, cpu_end, input_shapes=None):
+    def __init__(self, id, name, thread, cpu_start, cpu_end, input_shapes=None,
+                 cpu_memory_usage=0, cuda_memory_usage=0):
         self.id = id
         self.name = name
         self.cpu_interval = Interval(cpu_start, cpu_end)
@@ -563,6 +593,8 @@ class FunctionEvent(FormattedTimesMixin):
         self.count = 1
         self.cpu_children = []
         self.input_shapes = input_shapes
+        self.cpu_memory_usage = cpu_memory_usage
+        self.cuda_memory_usage = cuda_memory_usage
 
     def append_kernel(self, name, device, start, end):
         self.kernels.append(Kernel(name, device, Interval(start, end)))
@@ -619,6 +651,8 @@ class FunctionEventAvg(FormattedTimesMixin):
         self.cpu_time_total = 0
         self.cuda_time_total = 0
         self.self_cpu_time_total = 0
+        self.cpu_memory_usage = 0
+        self.cuda_memory_usage = 0
         self.input_shapes = None
 
     def add(self, other, group_by_input_shapes=False):
@@ -636,6 +670,8 @@ class FunctionEventAvg(FormattedTimesMixin):
         self.cpu_time_total += other.cpu_time_total
         self.cuda_time_total += other.cuda_time_total
         self.self_cpu_time_total += other.self_cpu_time_total
+        self.cpu_memory_usage += other.cpu_memory_usage
+        self.cuda_memory_usage += other.cuda_memory_usage
         self.count += other.count
         return self
 
@@ -694,9 +730,19 @@ def parse_cpu_trace(thread_records):
             cuda_records[record.device()] = record
     assert start_record is not None
 
+    # per-function-id [cpu_bytes, cuda_bytes] accumulated from memory_alloc
+    # records; attributed to the innermost range open when they were recorded
+    memory_usage = defaultdict(lambda: [0, 0])
+
     for record in itertools.chain(*thread_records):
         if record.kind() == 'mark':
             continue
+        elif record.kind() == 'memory_alloc':
+            if len(record_stack) > 0:
+                usage = memory_usage[record_stack[-1][0]]
+                usage[0] += record.cpu_memory_usage()
+                usage[1] += record.cuda_memory_usage()
+            continue
         elif record.kind() == 'push':
             record_stack.append((next_id, record))
             next_id += 1
@@ -708,7 +754,9 @@ def parse_cpu_trace(thread_records):
                 thread=start.thread_id(),
                 cpu_start=start_record.cpu_elapsed_us(start),
                 cpu_end=start_record.cpu_elapsed_us(record),
-                input_shapes=start.shapes())
+                input_shapes=start.shapes(),
+                cpu_memory_usage=memory_usage[function_id][0],
+                cuda_memory_usage=memory_usage[function_id][1])
             if start.has_cuda():
                 cuda_start = adjusted_time(start)
                 cuda_end = adjusted_time(record)
@@ -815,6 +863,9 @@ def build_table(events, sort_by=None, header=None, row_limit=100, use_cuda=True)
 
     has_input_shapes = any(
         [event.input_shapes is not None for event in events])
+    has_memory = any(
+        [event.cpu_memory_usage != 0 or event.cuda_memory_usage != 0
+         for event in events])
     name_column_width = max([len(evt.key) for evt in events]) + 4
     DEFAULT_COLUMN_WIDTH = 15
     SHAPES_COLUMN_WIDTH = 35
@@ -833,6 +884,10 @@ def build_table(events, sort_by=None, header=None, row_limit=100, use_cuda=True)
             'CUDA total',
             'CUDA time avg',
         ])
+    if has_memory:
+        headers.append('CPU Mem')
+        if use_cuda:
+            headers.append('CUDA Mem')
     headers.append(
         'Number of Calls'
     )
@@ -897,6 +952,10 @@ def build_table(events, sort_by=None, header=None, row_limit=100, use_cuda=True)
                 evt.cuda_time_total_str,
                 evt.cuda_time_str,  # Cuda time avg
             ])
+        if has_memory:
+            row_values.append(format_memory(evt.cpu_memory_usage))
+            if use_cuda:
+                row_values.append(format_memory(evt.cuda_memory_usage))
         row_values.append(
             evt.count,  # Number of calls
         )
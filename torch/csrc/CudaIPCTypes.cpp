@@ -90,13 +90,22 @@ void CudaIPCSentDataLimbo::add(std::unique_ptr<CudaIPCSentData> shared_block) {
   shared_blocks_.push_back(std::move(shared_block));
 }
 
+// Scanning the limbo takes its lock and walks every parked block, so doing
+// it on each deletion is quadratic when many small tensors are shared.
+// Collect in batches instead; the free-memory callback and allocator
+// pressure still trigger a full collect whenever memory is actually needed.
+constexpr uint64_t CUDA_IPC_COLLECT_LIMBO_EVERY_X_BLOCKS = 64;
+
 void CudaIPCSentDataDelete(void* ptr) {
   std::unique_ptr<CudaIPCSentData> sent_data(
       static_cast<CudaIPCSentData*>(ptr));
   if (sent_data->counter_value() > 0) {
     cuda_ipc_global_entities.CudaIPCSentDataLimbo_.add(std::move(sent_data));
   }
-  cuda_ipc_global_entities.CudaIPCSentDataLimbo_.collect();
+  if (cuda_ipc_global_entities.CudaIPCSentDataLimbo_.size() >=
+      CUDA_IPC_COLLECT_LIMBO_EVERY_X_BLOCKS) {
+    cuda_ipc_global_entities.CudaIPCSentDataLimbo_.collect();
+  }
 }
 
 void ReturnRefCounter(const std::string& handle, uint64_t offset /* unused */) {
@@ -4,7 +4,9 @@
 #include <torch/csrc/utils/memory.h>
 #include <torch/data/datasets/stateful.h>
 #include <torch/data/samplers.h>
+#include <algorithm>
 #include <queue>
+#include <random>
 #include <thread>
 
 #include <torch/serialize.h>
@@ -55,10 +57,17 @@ class BatchDataBuffer {
   BatchDataBuffer(
       size_t batch_size,
       ExampleSampler& example_sampler,
-      size_t queue_capacity)
+      size_t queue_capacity,
+      size_t shuffle_buffer_size = 0)
       : batch_size_(batch_size),
         example_sampler_(example_sampler),
-        queue_capacity_(queue_capacity) {}
+        queue_capacity_(queue_capacity),
+        shuffle_buffer_size_(shuffle_buffer_size),
+        shuffle_engine_(std::random_device()()) {
+    if (shuffle_buffer_size_ > 0) {
+      shuffle_buffer_.reserve(shuffle_buffer_size_);
+    }
+  }
 
   /// Return batch data from the queue. Called from the ChunkDataset main
   /// thread.
@@ -105,6 +114,28 @@ class BatchDataBuffer {
       return;
     }
 
+    if (shuffle_buffer_size_ > 0) {
+      // Streaming mode: instead of shuffling the whole chunk in memory through
+      // the example sampler, exchange each incoming example against a random
+      // slot of the bounded shuffle buffer and batch whatever falls out. The
+      // memory held per buffer is proportional to the shuffle buffer and the
+      // queue capacity, not to the chunk size.
+      UnwrappedBatchType emitted;
+      emitted.reserve(data.size());
+      for (auto& example : data) {
+        if (shuffle_buffer_.size() < shuffle_buffer_size_) {
+          shuffle_buffer_.emplace_back(std::move(example));
+          continue;
+        }
+        std::uniform_int_distribution<size_t> slot(0, shuffle_buffer_size_ - 1);
+        size_t index = slot(shuffle_engine_);
+        emitted.emplace_back(std::move(shuffle_buffer_[index]));
+        shuffle_buffer_[index] = std::move(example);
+      }
+      enqueue_in_order(std::move(emitted), lock);
+      return;
+    }
+
     auto data_size = data.size();
     auto remaining_size = data_size;
     example_sampler_.reset(data_size);
@@ -173,6 +204,25 @@ class BatchDataBuffer {
     cv_read_.notify_all();
   }
 
+  /// Drains examples still held in the shuffle buffer into the batch queue.
+  /// Called once from the last ChunkDataset worker thread when all chunks of
+  /// the epoch have been read, before the buffer is stopped. A no-op when
+  /// streaming shuffle is disabled.
+  void flush_shuffle_buffer() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (stop_ || shuffle_buffer_.empty()) {
+      return;
+    }
+    // The buffer holds a uniform sample of the epoch's tail, but the slots
+    // retain insertion bias; shuffle once more before draining so the last
+    // batches are as random as the rest.
+    std::shuffle(
+        shuffle_buffer_.begin(), shuffle_buffer_.end(), shuffle_engine_);
+    UnwrappedBatchType remaining;
+    remaining.swap(shuffle_buffer_);
+    enqueue_in_order(std::move(remaining), lock);
+  }
+
   void stop(){
     {
       // Hold the lock before changing stop_ to prevent a race condition which can
@@ -195,6 +245,45 @@ class BatchDataBuffer {
     // notify all readers too.
     cv_read_.notify_all();
   }
+  /// Appends already-shuffled examples to the batch queue in the order given,
+  /// topping up the last partial batch first. The caller must hold
+  /// `queue_mutex_` through `lock`; the lock is released before readers are
+  /// notified.
+  void enqueue_in_order(
+      UnwrappedBatchType data,
+      std::unique_lock<std::mutex>& lock) {
+    auto data_size = data.size();
+    if (data_size == 0) {
+      return;
+    }
+    size_t offset = 0;
+    if (!batch_queue_.empty()) {
+      auto& batch = batch_queue_.back();
+      size_t current_count = batch.batch_data.size();
+      if (current_count < batch_size_) {
+        auto example_count = std::min(data_size, batch_size_ - current_count);
+        for (size_t i = 0; i < example_count; ++i, ++offset) {
+          batch.batch_data.emplace_back(std::move(data[offset]));
+        }
+      }
+    }
+    while (offset < data_size) {
+      UnwrappedBatchType current_batch;
+
+      // Allocate the batch memory ahead of time.
+      current_batch.reserve(batch_size_);
+
+      auto example_count = std::min(data_size - offset, batch_size_);
+      for (size_t i = 0; i < example_count; ++i, ++offset) {
+        current_batch.emplace_back(std::move(data[offset]));
+      }
+      batch_queue_.emplace(std::move(current_batch));
+    }
+    total_example_count_in_queue_ += data_size;
+    lock.unlock();
+    cv_read_.notify_all();
+  }
+
   /// The batch size is needed to create batches from the chunk data. Similar to
   /// regular dataloader where the batches are created with prefetches,
   /// BatchDataBuffer perform the batch creation using the provided batch size.
@@ -233,6 +322,17 @@ class BatchDataBuffer {
   // configurable maximun number of elements the queue can hold at one time.
   size_t queue_capacity_;
 
+  // When greater than 0, examples stream through a bounded shuffle buffer of
+  // this many slots instead of being shuffled chunk-by-chunk through the
+  // example sampler.
+  size_t shuffle_buffer_size_;
+
+  // bounded reservoir holding examples not yet emitted in streaming mode.
+  UnwrappedBatchType shuffle_buffer_;
+
+  // random engine driving the shuffle buffer slot selection.
+  std::mt19937 shuffle_engine_;
+
   // When set to true, it wakes the writer threads from the wait and exit current
   // function call. This is needed when ChunkDataSet.Reset is called while the
   // previous epoch is not exhausted yet. When ChunkDataset is waiting its
@@ -250,11 +350,17 @@ struct ChunkDatasetOptions {
       size_t preloader_count,
       size_t batch_size,
       size_t cache_size = 2048,
-      size_t cross_chunk_shuffle_count = 1)
+      size_t cross_chunk_shuffle_count = 1,
+      size_t shuffle_buffer_size = 0,
+      size_t shard_count = 1,
+      size_t shard_index = 0)
       : preloader_count_(preloader_count),
         batch_size_(batch_size),
         cache_size_(cache_size),
-        cross_chunk_shuffle_count_(cross_chunk_shuffle_count) {
+        cross_chunk_shuffle_count_(cross_chunk_shuffle_count),
+        shuffle_buffer_size_(shuffle_buffer_size),
+        shard_count_(shard_count),
+        shard_index_(shard_index) {
     TORCH_CHECK(
         preloader_count_ > 0,
         "Preloader count is 0. At least one preloader needs to be specified.");
@@ -271,6 +377,12 @@ struct ChunkDatasetOptions {
     TORCH_CHECK(
         cross_chunk_shuffle_count_ > 0,
         "cross_chunk_shuffle_count needs to be greater than 0.");
+    TORCH_CHECK(
+        shard_count_ > 0,
+        "Shard count is 0. At least one shard needs to be specified.");
+    TORCH_CHECK(
+        shard_index_ < shard_count_,
+        "Shard index needs to be less than the shard count.");
   }
 
   /// The number of worker thread to preload chunk data.
@@ -292,6 +404,27 @@ struct ChunkDatasetOptions {
   // penalty when this value is greater than 1, as we need to do extra merge
   // between multiple chunks before performing example sampling.
   TORCH_ARG(size_t, cross_chunk_shuffle_count) = 1;
+
+  // The number of examples to hold in the streaming shuffle buffer. Default to
+  // 0 meaning streaming shuffle is disabled and the example sampler shuffles
+  // each loaded chunk in memory. When it is greater than 0, examples from all
+  // preloaded chunks stream through a bounded reservoir of this many slots and
+  // the example sampler is bypassed, so per-epoch memory is bounded by this
+  // value plus the cache size instead of the chunk size. Larger values give
+  // better shuffling at the cost of more memory; a few multiples of the batch
+  // size is usually sufficient.
+  TORCH_ARG(size_t, shuffle_buffer_size) = 0;
+
+  // The number of shards the chunks are partitioned into, typically the world
+  // size in distributed training. Default to 1 meaning no sharding. Chunk
+  // index `i` belongs to shard `i % shard_count`; every rank should construct
+  // the dataset with the same shard_count and its own shard_index so each
+  // chunk is read by exactly one rank.
+  TORCH_ARG(size_t, shard_count) = 1;
+
+  // The shard this dataset instance reads, typically the distributed rank.
+  // Needs to be less than shard_count.
+  TORCH_ARG(size_t, shard_index) = 0;
 };
 
 /// A stateful dataset that support hierarchical sampling and prefetching of
@@ -302,6 +435,13 @@ struct ChunkDatasetOptions {
 /// while the `ExampleSampler` determins the order of Examples that are returned
 /// in each `get_batch` call. The hierarchical sampling approach used here is
 /// inspired by this paper http://martin.zinkevich.org/publications/nips2010.pdf
+///
+/// When `ChunkDatasetOptions::shuffle_buffer_size` is set, examples are
+/// instead shuffled through a bounded reservoir while the chunks stream in,
+/// so memory usage is independent of the chunk size; see the option's
+/// documentation for details. `shard_count`/`shard_index` additionally
+/// restrict each dataset instance to its own share of the chunks for
+/// distributed training.
 template <
     typename ChunkReader,
     typename ChunkSampler = samplers::RandomSampler,
@@ -387,7 +527,8 @@ class ChunkDataset final
         detail::BatchDataBuffer<UnwrappedBatchType, ExampleSamplerType>>(
         options_.batch_size(),
         example_sampler_,
-        options_.cache_size());
+        options_.cache_size(),
+        options_.shuffle_buffer_size());
 
     // create new workers for this new epoch.
     quit_worker_ = false;
@@ -435,6 +576,23 @@ class ChunkDataset final
             break;
           }
         }
+        if (options_.shard_count() > 1) {
+          // Keep only the chunks assigned to this shard. All ranks walk the
+          // same chunk order, so each chunk is read by exactly one rank and
+          // no rank ever loads another rank's share of the data.
+          chunk_idx.erase(
+              std::remove_if(
+                  chunk_idx.begin(),
+                  chunk_idx.end(),
+                  [this](size_t index) {
+                    return index % options_.shard_count() !=
+                        options_.shard_index();
+                  }),
+              chunk_idx.end());
+          if (chunk_idx.empty()) {
+            continue;
+          }
+        }
         UnwrappedBatchType data = chunk_reader_.read_chunk(chunk_idx[0]);
         for (size_t i = 1; i < chunk_idx.size(); ++i) {
           auto chunk_data = chunk_reader_.read_chunk(chunk_idx[i]);
@@ -454,7 +612,9 @@ class ChunkDataset final
     AT_ASSERT(running_preloaders_.load() > 0);
     --running_preloaders_;
     if (running_preloaders_.load() == 0) {
-      // all preloaders are completed, so we can notify the batch_buffer.
+      // all preloaders are completed. Drain the streaming shuffle buffer, if
+      // any, and then notify the batch_buffer.
+      batch_buffer_->flush_shuffle_buffer();
       batch_buffer_->stop();
     }
   }
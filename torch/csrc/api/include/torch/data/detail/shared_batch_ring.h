@@ -0,0 +1,124 @@
+#pragma once
+
+#include <torch/data/detail/queue.h>
+#include <torch/types.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// A fixed-capacity ring of preallocated batch buffers.
+///
+/// Workers `acquire()` a free buffer, fill it in place and hand the tensor to
+/// the consumer, which `release()`s it back into the ring once the batch has
+/// been consumed. Every buffer is allocated once up front and then recycled,
+/// so steady-state operation performs no allocations and no copies; `acquire`
+/// blocks when all buffers are in flight, which also bounds the memory the
+/// pipeline can hold at any time.
+///
+/// When constructed with a `shm_prefix`, the buffers are backed by shared
+/// file mappings (one file per slot, created through `at::from_file`). A
+/// cooperating process can map the same files -- `buffer(slot)` on a ring
+/// constructed with the same arguments returns a view of identical memory --
+/// so only the slot index needs to cross the process boundary and consumers
+/// read the batch zero-copy. Without a prefix the buffers are ordinary heap
+/// tensors, which still gives allocation-free recycling between worker and
+/// consumer threads of one process.
+class SharedBatchRing {
+ public:
+  SharedBatchRing(
+      std::vector<int64_t> sizes,
+      TensorOptions options,
+      size_t capacity,
+      std::string shm_prefix = std::string())
+      : sizes_(std::move(sizes)) {
+    TORCH_CHECK(
+        capacity > 0, "SharedBatchRing requires a capacity of at least one");
+    buffers_.reserve(capacity);
+    for (size_t slot = 0; slot < capacity; ++slot) {
+      Tensor buffer;
+      if (shm_prefix.empty()) {
+        buffer = torch::empty(sizes_, options);
+      } else {
+        int64_t numel = 1;
+        for (const auto size : sizes_) {
+          numel *= size;
+        }
+        buffer = at::from_file(
+                     shm_prefix + "." + std::to_string(slot),
+                     /*shared=*/true,
+                     numel,
+                     options)
+                     .view(sizes_);
+      }
+      slot_of_buffer_.emplace(buffer.data_ptr(), slot);
+      buffers_.push_back(std::move(buffer));
+      free_slots_.push(slot);
+    }
+  }
+
+  /// Returns a free buffer to fill in place, blocking until one is available.
+  /// An optional `timeout` limits the time spent waiting; an exception is
+  /// raised if it expires.
+  Tensor acquire(optional<std::chrono::milliseconds> timeout = nullopt) {
+    return buffers_[free_slots_.pop(timeout)];
+  }
+
+  /// Hands a buffer previously obtained from `acquire()` back to the ring,
+  /// making its slot available to workers again. The caller must be done
+  /// reading the buffer: workers may start overwriting it immediately.
+  void release(const Tensor& buffer) {
+    free_slots_.push(slot(buffer));
+  }
+
+  /// Returns the slot index backing `buffer`; this is what a multiprocess
+  /// transport would send over the wire instead of the tensor itself.
+  size_t slot(const Tensor& buffer) const {
+    auto it = slot_of_buffer_.find(buffer.data_ptr());
+    TORCH_CHECK(
+        it != slot_of_buffer_.end(),
+        "The given tensor was not acquired from this SharedBatchRing");
+    return it->second;
+  }
+
+  /// Returns the buffer stored in the given slot.
+  const Tensor& buffer(size_t slot) const {
+    TORCH_CHECK(
+        slot < buffers_.size(),
+        "Slot index ",
+        slot,
+        " is out of range for a SharedBatchRing of capacity ",
+        buffers_.size());
+    return buffers_[slot];
+  }
+
+  /// The number of buffers in the ring.
+  size_t capacity() const noexcept {
+    return buffers_.size();
+  }
+
+  /// The shape of every buffer in the ring.
+  const std::vector<int64_t>& sizes() const noexcept {
+    return sizes_;
+  }
+
+ private:
+  std::vector<int64_t> sizes_;
+  std::vector<Tensor> buffers_;
+  std::unordered_map<void*, size_t> slot_of_buffer_;
+  Queue<size_t> free_slots_;
+};
+
+} // namespace detail
+} // namespace data
+} // namespace torch
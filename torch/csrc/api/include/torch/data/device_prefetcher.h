@@ -0,0 +1,180 @@
+#pragma once
+
+#include <torch/data/example.h>
+#include <torch/data/iterator.h>
+#include <torch/types.h>
+
+#include <torch/csrc/utils/memory.h>
+
+#include <c10/core/Event.h>
+#include <c10/core/Stream.h>
+#include <c10/core/StreamGuard.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+
+/// A pipeline stage that moves batches to a device ahead of consumption.
+///
+/// `DevicePrefetcher` wraps a `DataLoader` and yields device-resident batches:
+/// while batch `N` is being consumed (e.g. trained on), batches up to `N + k`
+/// (`k` being the `depth`) have already been pinned and their host-to-device
+/// copies issued, the standard double-buffering that is otherwise hand-rolled
+/// around every training loop. Tensors are pinned through `pin_memory()` --
+/// and therefore the caching host allocator -- before the copy, so the
+/// transfer is truly asynchronous.
+///
+/// When a dedicated `copy_stream` is supplied (e.g. from
+/// `at::cuda::getStreamFromPool()`), copies are issued on that stream so they
+/// overlap with compute on the consumer's stream; an event recorded after
+/// each copy is blocked on by the consumer's current stream when the batch is
+/// handed out, so no explicit synchronization is needed on the caller's side.
+/// Without a dedicated stream, copies are still issued ahead of time on the
+/// current stream.
+///
+/// Batches are moved with the `transfer` overloads below, which cover
+/// tensors, `Example`s and vectors thereof; any other payload is passed
+/// through unchanged.
+template <typename DataLoader>
+class DevicePrefetcher {
+ public:
+  using BatchType = typename DataLoader::BatchType;
+
+  DevicePrefetcher(
+      DataLoader& loader,
+      Device device,
+      size_t depth = 2,
+      optional<c10::Stream> copy_stream = nullopt)
+      : loader_(loader),
+        device_(device),
+        depth_(depth),
+        copy_stream_(std::move(copy_stream)) {
+    TORCH_CHECK(
+        depth_ > 0, "DevicePrefetcher requires a prefetch depth of at least one");
+    if (copy_stream_) {
+      TORCH_CHECK(
+          copy_stream_->device() == device_,
+          "The copy stream must live on the prefetch target device");
+    }
+  }
+
+  /// Returns an iterator over device-resident batches. Resets the underlying
+  /// `DataLoader`, so the same restrictions apply as for its `begin()`.
+  Iterator<BatchType> begin() {
+    source_ = loader_.begin();
+    source_end_ = loader_.end();
+    in_flight_.clear();
+    return Iterator<BatchType>(torch::make_unique<detail::ValidIterator<BatchType>>(
+        [this] { return this->next(); }));
+  }
+
+  /// Returns a sentinel iterator that compares equal to an iterator returned
+  /// by `begin()` once the underlying `DataLoader` is exhausted.
+  Iterator<BatchType> end() {
+    return Iterator<BatchType>(
+        torch::make_unique<detail::SentinelIterator<BatchType>>());
+  }
+
+ private:
+  struct InFlight {
+    BatchType batch;
+    optional<c10::Event> event;
+  };
+
+  /// Tops up the pipeline to `depth_` in-flight batches and then hands out
+  /// the oldest one, or an empty optional once the source is exhausted.
+  optional<BatchType> next() {
+    while (in_flight_.size() < depth_ && *source_ != *source_end_) {
+      enqueue(std::move(**source_));
+      ++*source_;
+    }
+    if (in_flight_.empty()) {
+      return nullopt;
+    }
+    InFlight head = std::move(in_flight_.front());
+    in_flight_.pop_front();
+    if (head.event) {
+      // Make the consumer's current stream wait for the copy; this is a
+      // device-side wait and does not block the host.
+      c10::impl::VirtualGuardImpl impl(device_.type());
+      head.event->block(impl.getStream(device_));
+    }
+    return optional<BatchType>(std::move(head.batch));
+  }
+
+  /// Issues the host-to-device copies for one batch.
+  void enqueue(BatchType batch) {
+    if (copy_stream_) {
+      c10::StreamGuard guard(*copy_stream_);
+      BatchType device_batch = transfer(std::move(batch));
+      c10::Event event(device_.type());
+      event.record(*copy_stream_);
+      in_flight_.push_back(InFlight{std::move(device_batch), std::move(event)});
+    } else {
+      in_flight_.push_back(InFlight{transfer(std::move(batch)), nullopt});
+    }
+  }
+
+  Tensor transfer(Tensor tensor) {
+    if (device_.is_cuda() && tensor.device().is_cpu() && !tensor.is_pinned()) {
+      tensor = tensor.pin_memory();
+    }
+    return tensor.to(device_, /*non_blocking=*/true);
+  }
+
+  template <typename Data, typename Target>
+  Example<Data, Target> transfer(Example<Data, Target> example) {
+    return {transfer(std::move(example.data)),
+            transfer(std::move(example.target))};
+  }
+
+  template <typename Data>
+  Example<Data, example::NoTarget> transfer(
+      Example<Data, example::NoTarget> example) {
+    return Example<Data, example::NoTarget>(transfer(std::move(example.data)));
+  }
+
+  template <typename T>
+  std::vector<T> transfer(std::vector<T> batch) {
+    for (auto& example : batch) {
+      example = transfer(std::move(example));
+    }
+    return batch;
+  }
+
+  /// Non-tensor payloads are handed through unchanged.
+  template <typename T>
+  T transfer(T value) {
+    return value;
+  }
+
+  DataLoader& loader_;
+  const Device device_;
+  const size_t depth_;
+  optional<c10::Stream> copy_stream_;
+  optional<Iterator<BatchType>> source_;
+  optional<Iterator<BatchType>> source_end_;
+  std::deque<InFlight> in_flight_;
+};
+
+/// Convenience function to create a `DevicePrefetcher` with template argument
+/// deduction, mirroring `make_data_loader`.
+template <typename DataLoader>
+DevicePrefetcher<DataLoader> make_device_prefetcher(
+    DataLoader& loader,
+    Device device,
+    size_t depth = 2,
+    optional<c10::Stream> copy_stream = nullopt) {
+  return DevicePrefetcher<DataLoader>(
+      loader, device, depth, std::move(copy_stream));
+}
+
+} // namespace data
+} // namespace torch
@@ -770,18 +770,31 @@ inline Tensor cross_entropy(
     int64_t ignore_index,
     CrossEntropyFuncOptions::reduction_t reduction) {
   NLLLossFuncOptions::reduction_t reduction_;
+  int64_t reduction_enum;
   if (c10::get_if<enumtype::kNone>(&reduction)) {
     reduction_ = torch::kNone;
+    reduction_enum = at::Reduction::None;
   } else if (c10::get_if<enumtype::kMean>(&reduction)) {
     reduction_ = torch::kMean;
+    reduction_enum = at::Reduction::Mean;
   } else if (c10::get_if<enumtype::kSum>(&reduction)) {
     reduction_ = torch::kSum;
+    reduction_enum = at::Reduction::Sum;
   } else {
     TORCH_INTERNAL_ASSERT(
       false,
       enumtype::get_enum_name(reduction),
       " is not valid");
   }
+  if (input.dim() == 2 && target.dim() == 1 &&
+      input.device().type() == torch::kCPU &&
+      (input.dtype() == torch::kFloat32 || input.dtype() == torch::kFloat64) &&
+      (!weight.defined() || weight.dtype() == input.dtype())) {
+    // Fused kernel: computes the log_softmax normalizer and gathers the
+    // target logit in a single pass, without materializing log_softmax.
+    return torch::_cross_entropy_loss(
+        input, target, weight, reduction_enum, ignore_index);
+  }
   return torch::nn::functional::detail::nll_loss(
     torch::nn::functional::detail::log_softmax(input, 1, c10::nullopt),
     target,
@@ -30,6 +30,28 @@ inline double clip_grad_norm_(
         total_norm = param_max;
       }
     }
+  } else if (norm_type == 2.0 && !params_with_grad.empty()) {
+    // The common L2 case goes through the fused op: one traversal for the
+    // global norm and one conditional in-place scale, instead of 2N
+    // dispatches. It requires a uniform dtype and device across the list.
+    std::vector<Tensor> grads;
+    grads.reserve(params_with_grad.size());
+    bool fused = true;
+    for (const auto& param : params_with_grad) {
+      auto grad = param.grad().data();
+      fused = fused &&
+          grad.dtype() == params_with_grad[0].grad().dtype() &&
+          grad.device() == params_with_grad[0].grad().device();
+      grads.push_back(std::move(grad));
+    }
+    if (fused) {
+      return torch::_clip_grad_norm(grads, max_norm).item().toDouble();
+    }
+    for (const auto& param : params_with_grad) {
+      auto param_norm = param.grad().data().norm(norm_type);
+      total_norm += std::pow(param_norm.item().toDouble(), norm_type);
+    }
+    total_norm = std::pow(total_norm, 1.0 / norm_type);
   } else {
     for (const auto& param : params_with_grad) {
       auto param_norm = param.grad().data().norm(norm_type);
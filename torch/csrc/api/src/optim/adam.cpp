@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <functional>
+#include <map>
 
 namespace torch {
 namespace optim {
@@ -69,6 +70,20 @@ Tensor Adam::step(LossClosure closure)  {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<AdamOptions&>(group.options());
+    auto beta1 = std::get<0>(options.betas());
+    auto beta2 = std::get<1>(options.betas());
+
+    // All hyperparameters are uniform within a group, so the only per-parameter
+    // inputs to the update are the dtype and the step count (which feeds the
+    // bias corrections). Bucketing by both lets each bucket be updated with a
+    // handful of fused _foreach_* calls instead of several kernel launches per
+    // parameter.
+    struct Bucket {
+      std::vector<Tensor> params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs;
+    };
+    std::map<std::pair<at::ScalarType, int64_t>, Bucket> buckets;
+
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -76,7 +91,6 @@ Tensor Adam::step(LossClosure closure)  {
       auto grad = p.grad();
       TORCH_CHECK(!grad.is_sparse(), "Adam does not support sparse gradients"/*, please consider SparseAdam instead*/);
       auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
-      auto& options = static_cast<AdamOptions&>(group.options());
 
       // State initialization
       if(param_state == state_.end()) {
@@ -94,37 +108,70 @@ Tensor Adam::step(LossClosure closure)  {
       }
 
       auto& state = static_cast<AdamParamState&>(*state_[c10::guts::to_string(p.unsafeGetTensorImpl())]);
-      auto& exp_avg = state.exp_avg();
-      auto& exp_avg_sq = state.exp_avg_sq();
-      auto& max_exp_avg_sq = state.max_exp_avg_sq();
-
       state.step(state.step()+1);
-      auto beta1 = std::get<0>(options.betas());
-      auto beta2 = std::get<1>(options.betas());
 
-      auto bias_correction1 = 1 - std::pow(beta1, state.step());
-      auto bias_correction2 = 1 - std::pow(beta2, state.step());
+      auto& bucket = buckets[{p.scalar_type(), state.step()}];
+      bucket.params.push_back(p);
+      bucket.grads.push_back(grad);
+      bucket.exp_avgs.push_back(state.exp_avg());
+      bucket.exp_avg_sqs.push_back(state.exp_avg_sq());
+      if(options.amsgrad()) {
+        bucket.max_exp_avg_sqs.push_back(state.max_exp_avg_sq());
+      }
+    }
+
+    for (auto& item : buckets) {
+      auto step = item.first.second;
+      auto& bucket = item.second;
+
+      if (!options.amsgrad()) {
+        // Single-kernel update: one read-modify-write traversal over param,
+        // exp_avg and exp_avg_sq together; weight decay and the bias
+        // corrections are folded into the op.
+        at::_fused_adam_(
+            bucket.params,
+            bucket.grads,
+            bucket.exp_avgs,
+            bucket.exp_avg_sqs,
+            options.lr(),
+            beta1,
+            beta2,
+            options.weight_decay(),
+            options.eps(),
+            step);
+        continue;
+      }
 
+      auto bias_correction1 = 1 - std::pow(beta1, step);
+      auto bias_correction2 = 1 - std::pow(beta2, step);
+
+      auto grads = bucket.grads;
       if(options.weight_decay() != 0) {
-        grad = grad.add(p, options.weight_decay());
+        grads = at::_foreach_add(grads, bucket.params, options.weight_decay());
       }
 
       // Decay the first and second moment running average coefficient
-      exp_avg.mul_(beta1).add_(grad, 1 - beta1);
-      exp_avg_sq.mul_(beta2).addcmul_(grad, grad, 1 - beta2);
+      at::_foreach_mul_(bucket.exp_avgs, beta1);
+      at::_foreach_add_(bucket.exp_avgs, grads, 1 - beta1);
+      at::_foreach_mul_(bucket.exp_avg_sqs, beta2);
+      at::_foreach_addcmul_(bucket.exp_avg_sqs, grads, grads, 1 - beta2);
 
-      Tensor denom;
+      std::vector<Tensor> denom;
       if(options.amsgrad()) {
         // Maintains the maximum of all 2nd moment running avg. till now
-        torch::max_out(max_exp_avg_sq, exp_avg_sq, max_exp_avg_sq);
+        for (size_t i = 0; i < bucket.params.size(); i++) {
+          torch::max_out(bucket.max_exp_avg_sqs[i], bucket.exp_avg_sqs[i], bucket.max_exp_avg_sqs[i]);
+        }
         // Use the max. for normalizing running avg. of gradient
-        denom = (max_exp_avg_sq.sqrt() / sqrt(bias_correction2)).add_(options.eps());
+        denom = at::_foreach_sqrt(bucket.max_exp_avg_sqs);
       } else {
-        denom = (exp_avg_sq.sqrt() / sqrt(bias_correction2)).add_(options.eps());
+        denom = at::_foreach_sqrt(bucket.exp_avg_sqs);
       }
+      at::_foreach_div_(denom, sqrt(bias_correction2));
+      at::_foreach_add_(denom, options.eps());
 
       auto step_size = options.lr() / bias_correction1;
-      p.addcdiv_(exp_avg, denom, -step_size);
+      at::_foreach_addcdiv_(bucket.params, bucket.exp_avgs, denom, -step_size);
     }
   }
   return loss;
@@ -7,6 +7,7 @@
 #include <ATen/ATen.h>
 
 #include <functional>
+#include <map>
 
 namespace torch {
 namespace optim {
@@ -71,6 +72,17 @@ Tensor RMSprop::step(LossClosure closure)  {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<RMSpropOptions&>(group.options());
+
+    // The plain configuration (no momentum, not centered) is updated with a
+    // single fused kernel per dtype bucket; the momentum and centered
+    // variants keep the per-tensor path below.
+    const bool use_fused = options.momentum() <= 0 && !options.centered();
+    struct Bucket {
+      std::vector<Tensor> params, grads, square_avgs;
+    };
+    std::map<at::ScalarType, Bucket> buckets;
+
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -78,7 +90,6 @@ Tensor RMSprop::step(LossClosure closure)  {
       auto grad = p.grad();
       TORCH_CHECK(!grad.is_sparse(), "RMSprop does not support sparse gradients");
       auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
-      auto& options = static_cast<RMSpropOptions&>(group.options());
 
       // State initialization
       if (param_state == state_.end()) {
@@ -100,6 +111,15 @@ Tensor RMSprop::step(LossClosure closure)  {
 
       state.step(state.step() + 1);
 
+      if (use_fused) {
+        // Weight decay is folded into the fused op; push the raw gradient.
+        auto& bucket = buckets[p.scalar_type()];
+        bucket.params.push_back(p);
+        bucket.grads.push_back(grad);
+        bucket.square_avgs.push_back(square_avg);
+        continue;
+      }
+
       if (options.weight_decay() != 0) {
         grad = grad.add(p, options.weight_decay());
       }
@@ -125,6 +145,18 @@ Tensor RMSprop::step(LossClosure closure)  {
         p.addcdiv_(grad, avg, -options.lr());
       }
     }
+
+    for (auto& item : buckets) {
+      auto& bucket = item.second;
+      at::_fused_rmsprop_(
+          bucket.params,
+          bucket.grads,
+          bucket.square_avgs,
+          options.lr(),
+          options.alpha(),
+          options.eps(),
+          options.weight_decay());
+    }
   }
   return loss;
 }
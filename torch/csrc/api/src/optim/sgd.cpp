@@ -10,6 +10,7 @@
 #include <ATen/ATen.h>
 
 #include <functional>
+#include <map>
 
 namespace torch {
 namespace optim {
@@ -66,33 +67,71 @@ Tensor SGD::step(LossClosure closure)  {
     auto dampening = options.dampening();
     auto nesterov = options.nesterov();
 
+    // Bucket parameters by dtype and update each bucket with fused
+    // _foreach_* calls (see Adam::step). A parameter taking its first
+    // momentum step keeps the per-tensor path below so buffer
+    // initialization stays as before; it joins a bucket from the next
+    // step on.
+    struct Bucket {
+      std::vector<Tensor> params, grads, bufs;
+    };
+    std::map<at::ScalarType, Bucket> buckets;
+
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
       }
       auto d_p = p.grad().data();
-      if (weight_decay != 0) {
-        d_p = d_p.add(p.data(), weight_decay);
-      }
       if (momentum != 0) {
-        Tensor buf;
         auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
         if(param_state == state_.end()) {
-          buf = torch::clone(d_p).detach();
+          if (weight_decay != 0) {
+            d_p = d_p.add(p.data(), weight_decay);
+          }
+          auto buf = torch::clone(d_p).detach();
           auto state = std::make_unique<SGDParamState>();
           state->momentum_buffer(buf);
           state_[c10::guts::to_string(p.unsafeGetTensorImpl())] = std::move(state);
-        } else {
-          buf = static_cast<SGDParamState&>(*param_state->second).momentum_buffer();
-          buf.mul_(momentum).add_(d_p, 1 - dampening);
-        }
-        if (nesterov) {
-          d_p = d_p.add(buf, momentum);
-        } else {
-          d_p = buf;
+          if (nesterov) {
+            d_p = d_p.add(buf, momentum);
+          } else {
+            d_p = buf;
+          }
+          p.data().add_(d_p, -1 * options.lr());
+          continue;
         }
+        auto& bucket = buckets[p.scalar_type()];
+        bucket.params.push_back(p.data());
+        bucket.grads.push_back(d_p);
+        bucket.bufs.push_back(static_cast<SGDParamState&>(*param_state->second).momentum_buffer());
+      } else {
+        auto& bucket = buckets[p.scalar_type()];
+        bucket.params.push_back(p.data());
+        bucket.grads.push_back(d_p);
+      }
+    }
+
+    for (auto& item : buckets) {
+      auto& bucket = item.second;
+      if (momentum != 0) {
+        // Single-kernel update: buffer and parameter are read, updated and
+        // written back in one traversal; weight decay is folded in.
+        at::_fused_sgd_(
+            bucket.params,
+            bucket.grads,
+            bucket.bufs,
+            options.lr(),
+            momentum,
+            dampening,
+            weight_decay,
+            nesterov);
+        continue;
+      }
+      auto grads = bucket.grads;
+      if (weight_decay != 0) {
+        grads = at::_foreach_add(grads, bucket.params, weight_decay);
       }
-      p.data().add_(d_p, -1 * options.lr());
+      at::_foreach_add_(bucket.params, grads, -1 * options.lr());
     }
   }
   return loss;
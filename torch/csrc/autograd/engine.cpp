@@ -17,9 +17,12 @@
 #include <c10/util/Optional.h>
 #include <c10/core/StreamGuard.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -27,6 +30,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <unordered_set>
 #include <typeinfo>
 #include <sstream>
@@ -200,13 +204,61 @@ size_t ReadyQueue::size() const {
   return heap_.size();
 }
 
-auto ReadyQueue::pop() -> NodeTask {
-  // Lock mutex for accesses to heap_
-  std::unique_lock<std::mutex> lock(mutex_);
-  not_empty_.wait(lock, [this]{ return !heap_.empty(); });
+void ReadyQueue::set_steal_targets(
+    std::vector<std::shared_ptr<ReadyQueue>> steal_targets) {
+  steal_targets_ = std::move(steal_targets);
+}
+
+c10::optional<NodeTask> ReadyQueue::try_steal() {
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || heap_.empty()) {
+    return c10::nullopt;
+  }
+  // Shutdown tasks and the empty wake-up tasks sort to the top of the heap
+  // and are addressed to this queue's owner; stealing one would leave the
+  // owner sleeping forever. Only real function tasks may leave the queue.
+  if (heap_.top().isShutdownTask_ || !heap_.top().fn_) {
+    return c10::nullopt;
+  }
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   auto task = std::move(const_cast<NodeTask&>(heap_.top())); heap_.pop();
-  return task;
+  return c10::optional<NodeTask>(std::move(task));
+}
+
+auto ReadyQueue::pop() -> NodeTask {
+  // Consumers without steal targets block on their own queue as before.
+  // Consumers with steal targets (the CPU helper threads, see
+  // Note [CPU helper threads]) sweep their siblings' queues whenever their
+  // own runs dry, and otherwise sleep with a backoff so a task stuck in a
+  // backed-up sibling queue still gets picked up promptly mid-backward
+  // without busy-spinning when the engine is idle.
+  static thread_local std::chrono::milliseconds steal_backoff(1);
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (steal_targets_.empty()) {
+        not_empty_.wait(lock, [this]{ return !heap_.empty(); });
+      }
+      if (!heap_.empty()) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto task = std::move(const_cast<NodeTask&>(heap_.top())); heap_.pop();
+        steal_backoff = std::chrono::milliseconds(1);
+        return task;
+      }
+    }
+    for (auto& steal_target : steal_targets_) {
+      auto task = steal_target->try_steal();
+      if (task) {
+        steal_backoff = std::chrono::milliseconds(1);
+        return std::move(*task);
+      }
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait_for(lock, steal_backoff, [this]{ return !heap_.empty(); });
+    }
+    steal_backoff = std::min(steal_backoff * 2, std::chrono::milliseconds(64));
+  }
 }
 
 bool ReadyQueue::empty() const {
@@ -225,10 +277,16 @@ Engine::~Engine() {
   for (auto& queue: device_ready_queues_) {
     noBackward =  noBackward && queue->empty();
   }
+  for (auto& queue: cpu_helper_queues_) {
+    noBackward =  noBackward && queue->empty();
+  }
   if (noBackward) {
     for (auto& queue : device_ready_queues_) {
      queue->pushShutdownTask();
     }
+    for (auto& queue : cpu_helper_queues_) {
+     queue->pushShutdownTask();
+    }
     // Do not wait for termination of global threads on Windows
     // Because CRT terminates DLL threads before calling
     // global object destructors
@@ -257,7 +315,7 @@ void Engine::set_device(int device) {
   //
   // Don't use DeviceGuard here because its destructor may be called before the
   // device is reset. This is fine because the device is thread local.
-  if (device != CPU_DEVICE) {
+  if (device != CPU_DEVICE && device != CPU_HELPER_DEVICE) {
     for (size_t i = 0; i < static_cast<size_t>(c10::DeviceType::COMPILE_TIME_MAX_DEVICE_TYPES); i++) {
       auto* impl = c10::impl::device_guard_impl_registry[i].load();
       if (impl && device < impl->deviceCount()) {
@@ -571,6 +629,10 @@ static variable_list call_function(
   bool prev_checkpoint_valid_state = checkpoint_valid;
   checkpoint_valid =
       graph_task->can_checkpoint() && prev_checkpoint_valid_state;
+  // Start bringing back the saved tensors that backward will need next, so
+  // the copies overlap with this node's execution and are ordered ahead of
+  // the nodes that consume them. See Note [Saved tensor host offload].
+  SavedTensorOffload::prefetch_ahead();
   auto& fn = *func;
   auto inputs =
       call_pre_hooks(fn, InputBuffer::variables(std::move(inputBuffer)));
@@ -678,83 +740,187 @@ void Engine::evaluate_function(
     }
   }
 
-  // Lock mutex for the accesses to GraphTask dependencies_, not_ready_ and cpu_ready_queue_ below
-  std::lock_guard<std::mutex> lock(graph_task->mutex_);
-  for (int i = 0; i < num_outputs; ++i) {
-    auto& output = outputs[i];
-    const auto& next = fn.next_edge(i);
+  // See Note [Multi-producer input buffers] in engine.h. For a consumer with
+  // several outstanding producers, the accumulation into its parked buffer is
+  // deferred until after GraphTask::mutex_ is released and runs under the
+  // buffer's own lock. Crucially, the dependency decrement is also deferred
+  // until after the accumulation has landed: a producer only becomes
+  // observable as "done" once its gradient is in the buffer, so whichever
+  // producer takes the count to zero knows every other accumulation has
+  // completed and the buffer is safe to dispatch.
+  struct DeferredAccumulation {
+    GraphTask::NotReadyEntry* entry;
+    std::shared_ptr<Node> function;
+    uint32_t input_nr;
+    Variable output;
+    c10::optional<c10::Stream> opt_next_stream;
+  };
+  std::vector<DeferredAccumulation> deferred;
+
+  {
+    // Lock mutex for the accesses to GraphTask dependencies_, not_ready_ and cpu_ready_queue_ below
+    std::lock_guard<std::mutex> lock(graph_task->mutex_);
+    for (int i = 0; i < num_outputs; ++i) {
+      auto& output = outputs[i];
+      const auto& next = fn.next_edge(i);
 
-    if (!next.is_valid()) continue;
+      if (!next.is_valid()) continue;
 
-    // Check if the next function is ready to be computed
-    bool is_ready = false;
-    auto& dependencies = graph_task->dependencies_;
-    auto it = dependencies.find(next.function.get());
-
-    if (it == dependencies.end()) {
-      auto name = next.function->name();
-      throw std::runtime_error(std::string("dependency not found for ") + name);
-    } else if (--it->second == 0) {
-      dependencies.erase(it);
-      is_ready = true;
-    }
+      auto& dependencies = graph_task->dependencies_;
+      auto it = dependencies.find(next.function.get());
 
-    auto& not_ready = graph_task->not_ready_;
-    auto not_ready_it = not_ready.find(next.function.get());
-    if (not_ready_it == not_ready.end()) {
-      // Skip functions that aren't supposed to be executed
-      if (!exec_info_.empty()) {
-        auto it = exec_info_.find(next.function.get());
-        if (it == exec_info_.end() || !it->second.should_execute()) {
+      if (it == dependencies.end()) {
+        auto name = next.function->name();
+        throw std::runtime_error(std::string("dependency not found for ") + name);
+      }
+
+      auto& not_ready = graph_task->not_ready_;
+      auto not_ready_it = not_ready.find(next.function.get());
+      if (not_ready_it == not_ready.end()) {
+        // Skip functions that aren't supposed to be executed
+        if (!exec_info_.empty()) {
+          auto exec_it = exec_info_.find(next.function.get());
+          if (exec_it == exec_info_.end() || !exec_it->second.should_execute()) {
+            if (--it->second == 0) {
+              dependencies.erase(it);
+            }
+            continue;
+          }
+        }
+        if (it->second == 1) {
+          // Sole outstanding producer: nothing can race us on this buffer,
+          // so accumulate and dispatch right here (the first add into an
+          // empty buffer is just a move).
+          dependencies.erase(it);
+          InputBuffer input_buffer(next.function->num_inputs());
+          const auto opt_next_stream = next.function->stream(c10::DeviceType::CUDA);
+          input_buffer.add(next.input_nr,
+                           std::move(output),
+                           opt_parent_stream,
+                           opt_next_stream);
+          auto queue = ready_queue(graph_task, input_buffer.device());
+          queue->push(
+              NodeTask(graph_task, next.function, std::move(input_buffer)));
           continue;
         }
+        // More producers are outstanding; park a shared buffer for them.
+        not_ready_it = not_ready.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(next.function.get()),
+            std::forward_as_tuple(next.function->num_inputs())).first;
       }
-      // No buffers have been allocated for the function
-      InputBuffer input_buffer(next.function->num_inputs());
-
-      // Accumulates into buffer
-      const auto opt_next_stream = next.function->stream(c10::DeviceType::CUDA);
-      input_buffer.add(next.input_nr,
-                       std::move(output),
-                       opt_parent_stream,
-                       opt_next_stream);
-
-      if (is_ready) {
-        auto queue = ready_queue(graph_task, input_buffer.device());
-        queue->push(
-            NodeTask(graph_task, next.function, std::move(input_buffer)));
-      } else {
-        not_ready.emplace(next.function.get(), std::move(input_buffer));
-      }
-    } else {
-      // The function already has a buffer
-      auto &input_buffer = not_ready_it->second;
-
-      // Accumulates into buffer
-      const auto opt_next_stream = next.function->stream(c10::DeviceType::CUDA);
-      input_buffer.add(next.input_nr,
-                       std::move(output),
-                       opt_parent_stream,
-                       opt_next_stream);
-      if (is_ready) {
-        auto queue = ready_queue(graph_task, input_buffer.device());
-        queue->push(
-            NodeTask(graph_task, next.function, std::move(input_buffer)));
-        not_ready.erase(not_ready_it);
-      }
+      deferred.push_back({&not_ready_it->second,
+                          next.function,
+                          next.input_nr,
+                          std::move(output),
+                          next.function->stream(c10::DeviceType::CUDA)});
     }
   }
+
+  if (deferred.empty()) {
+    return;
+  }
+
+  // Accumulate into the shared buffers without holding the GraphTask mutex.
+  // The entries are stable: only the producer that later takes a consumer's
+  // dependency count to zero erases its entry, and that cannot happen before
+  // we publish our own decrements below.
+  for (auto& item : deferred) {
+    std::lock_guard<std::mutex> lock(item.entry->mutex);
+    item.entry->buffer.add(item.input_nr,
+                           std::move(item.output),
+                           opt_parent_stream,
+                           item.opt_next_stream);
+  }
+
+  // Publish the decrements and dispatch whatever became ready.
+  std::lock_guard<std::mutex> lock(graph_task->mutex_);
+  for (auto& item : deferred) {
+    auto& dependencies = graph_task->dependencies_;
+    auto it = dependencies.find(item.function.get());
+    TORCH_INTERNAL_ASSERT(it != dependencies.end());
+    if (--it->second != 0) {
+      continue;
+    }
+    dependencies.erase(it);
+    auto& not_ready = graph_task->not_ready_;
+    auto not_ready_it = not_ready.find(item.function.get());
+    TORCH_INTERNAL_ASSERT(not_ready_it != not_ready.end());
+    auto input_buffer = std::move(not_ready_it->second.buffer);
+    not_ready.erase(not_ready_it);
+    auto queue = ready_queue(graph_task, input_buffer.device());
+    queue->push(
+        NodeTask(graph_task, item.function, std::move(input_buffer)));
+  }
 }
 
+// Note [Backward plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// compute_dependencies re-traverses the whole graph on every backward() and
+// pays one hash-map operation per edge, a measurable fixed cost for
+// small-model high-step-rate jobs. Reusing the counts across iterations is
+// only sound when we can prove we are looking at the same graph: a typical
+// training step rebuilds all Nodes, so counts keyed by Node* from the last
+// iteration would be dangling (and, with the Node recycle pool, could even
+// alias fresh nodes at the same addresses). The one case where reuse is
+// provably valid is backwarding the *same retained graph* again: we remember
+// the root nodes as weak_ptrs, and if they all lock to the same pointers the
+// whole reachable graph is still alive (roots hold shared_ptr chains to the
+// interior) and structurally unchanged, so the cached dependency map applies
+// verbatim. For rebuilt graphs we still reuse the plan's shape: the node
+// count from last iteration pre-sizes the traversal containers so the maps
+// never rehash mid-walk. The cache is thread-local, like the sequence_nr
+// counter, so concurrent backwards on different threads don't interfere.
+namespace {
+
+struct BackwardPlanCache {
+  // Roots of the last backward, for pointer-identity validation.
+  std::vector<std::weak_ptr<Node>> roots;
+  // Dependency counts of the last keep_graph backward over those roots.
+  std::unordered_map<Node*, int> dependencies;
+  // Number of nodes in the last backward over any graph; a sizing hint only.
+  size_t node_count = 0;
+};
+
+thread_local BackwardPlanCache backward_plan_cache;
+
+bool plan_cache_matches(
+    const BackwardPlanCache& cache,
+    const edge_list& root_edges) {
+  if (cache.roots.empty() || cache.roots.size() != root_edges.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < root_edges.size(); ++i) {
+    const auto cached_root = cache.roots[i].lock();
+    if (!cached_root || cached_root != root_edges[i].function) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 /* Computes the number of dependencies for each function which requires grad */
 auto Engine::compute_dependencies(Node* root, GraphTask& task) -> void {
+  auto& dependencies = task.dependencies_;
+  auto& cache = backward_plan_cache;
+
+  // See Note [Backward plan cache]: the same retained graph backwarded
+  // again gets last iteration's counts without re-traversing.
+  if (plan_cache_matches(cache, root->next_edges())) {
+    dependencies = cache.dependencies;
+    return;
+  }
+
   // Just to make sure that they will never be added to the queue again
   std::unordered_set<Node*> seen;
   std::vector<Node*> queue { root };
+  seen.reserve(cache.node_count + 1);
+  dependencies.reserve(cache.node_count);
 
   // Queue contains all nodes that will start propagating gradients.
   // We no longer have to expand functions that don't require grad.
-  auto& dependencies = task.dependencies_;
   while (!queue.empty()) {
     auto fn = queue.back(); queue.pop_back();
     for (const auto& edge : fn->next_edges()) {
@@ -765,6 +931,20 @@ auto Engine::compute_dependencies(Node* root, GraphTask& task) -> void {
       }
     }
   }
+
+  cache.node_count = dependencies.size();
+  cache.roots.clear();
+  if (task.keep_graph_) {
+    // Only a retained graph can come back with identical nodes, so only
+    // then is the O(nodes) snapshot worth taking.
+    cache.roots.reserve(root->next_edges().size());
+    for (const auto& edge : root->next_edges()) {
+      cache.roots.push_back(edge.function);
+    }
+    cache.dependencies = dependencies;
+  } else {
+    cache.dependencies.clear();
+  }
 }
 
 auto Engine::execute(const edge_list& roots,
@@ -1042,14 +1222,28 @@ size_t Engine::ready_queue_size(const std::shared_ptr<GraphTask>& graph_task, at
     // out of bound error.
     return 0;
   }
+  if (device.type() == at::kCPU) {
+    // Don't go through ready_queue(): a size query should not advance the
+    // round-robin cursor used for distributing CPU tasks.
+    TORCH_INTERNAL_ASSERT(graph_task);
+    return graph_task->cpu_ready_queue_->size();
+  }
   return ready_queue(graph_task, device)->size();
 }
 
 // CPU ready queue is per GraphTask, but CUDA device ready queues are shared across all graph tasks
 auto Engine::ready_queue(const std::shared_ptr<GraphTask>& graph_task, at::Device device) -> std::shared_ptr<ReadyQueue>{
   if (device.type() == at::kCPU) {
-    // return the cpu ready queue memorized in GraphTask
     TORCH_INTERNAL_ASSERT(graph_task);
+    // Spread CPU ready work round-robin over the owner's queue and the
+    // helper queues, if any. See Note [CPU helper threads]
+    if (!cpu_helper_queues_.empty()) {
+      const size_t idx = next_cpu_task_queue_++ % (cpu_helper_queues_.size() + 1);
+      if (idx > 0) {
+        return cpu_helper_queues_[idx - 1];
+      }
+    }
+    // return the cpu ready queue memorized in GraphTask
     return graph_task->cpu_ready_queue_;
   } else {
     // See Note [Allocating GPUs to autograd threads]
@@ -1058,8 +1252,10 @@ auto Engine::ready_queue(const std::shared_ptr<GraphTask>& graph_task, at::Devic
 }
 
 auto Engine::ready_queue_by_index(const std::shared_ptr<GraphTask>& graph_task, int device_index) -> std::shared_ptr<ReadyQueue> {
-  if (device_index == CPU_DEVICE) {
-    // return the cpu ready queue memorized in GraphTask
+  if (device_index == CPU_DEVICE || device_index == CPU_HELPER_DEVICE) {
+    // Return the cpu ready queue memorized in GraphTask. For a graph task
+    // owned by a CPU helper thread (reentrant backward on a helper), this is
+    // that helper's own queue, so wake-up tasks reach the right place.
     TORCH_INTERNAL_ASSERT(graph_task);
     return graph_task->cpu_ready_queue_;
   } else {
@@ -1070,7 +1266,61 @@ auto Engine::ready_queue_by_index(const std::shared_ptr<GraphTask>& graph_task,
   }
 }
 
+// Note [CPU helper threads]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// CPU ready work of a graph task is normally drained by the single thread
+// that called backward(), so wide models whose backward graphs fan out into
+// thousands of small CPU Nodes top out at one core (plus device threads).
+// When a pool size is configured -- via Engine::set_cpu_worker_count or the
+// TORCH_AUTOGRAD_CPU_WORKERS environment variable -- the engine additionally
+// starts that many CPU helper threads, each with its own ReadyQueue; CPU-ready tasks are
+// spread round-robin over the owner's queue and the helper queues, and a
+// helper that runs dry steals real function tasks from its siblings'
+// queues. Helpers run under worker_device == CPU_HELPER_DEVICE so they
+// behave like device threads (they never break out of thread_main on graph
+// completion and wake the owner through its cpu_ready_queue_).
+//
+// This is opt-in because it changes the order in which gradients are
+// accumulated into InputBuffers (floating point nondeterminism) and because
+// it runs Nodes of one backward pass concurrently, which custom autograd
+// Functions are not required to support. GraphTask state mutated during
+// evaluation (not_ready_, dependencies_, captured_vars_) is already guarded
+// by GraphTask::mutex_, which is what makes concurrent evaluate_function
+// calls safe for built-in ops.
+static int num_cpu_helper_threads() {
+  const char* val = std::getenv("TORCH_AUTOGRAD_CPU_WORKERS");
+  if (val == nullptr) {
+    return 0;
+  }
+  int nthreads = std::atoi(val);
+  if (nthreads <= 0) {
+    return 0;
+  }
+  return std::min(nthreads, (int)std::thread::hardware_concurrency());
+}
+
+void Engine::set_cpu_worker_count(int count) {
+  TORCH_CHECK(
+      count >= -1,
+      "cpu_worker_count must be >= 0, or -1 to fall back to "
+      "TORCH_AUTOGRAD_CPU_WORKERS");
+  TORCH_CHECK(
+      !worker_threads_started_.load(),
+      "cannot change the number of autograd CPU workers after the first "
+      "backward pass has started the worker threads");
+  cpu_worker_count_override_.store(count);
+}
+
+int Engine::cpu_worker_count() const {
+  const int count = cpu_worker_count_override_.load();
+  if (count >= 0) {
+    return std::min(count, (int)std::thread::hardware_concurrency());
+  }
+  return num_cpu_helper_threads();
+}
+
 auto Engine::start_device_threads() -> void {
+  worker_threads_started_.store(true);
   // See Note [Allocating GPUs to autograd threads]
   c10::DeviceIndex num_devices = 0;
   for (const auto& impl_atomic : c10::impl::device_guard_impl_registry) {
@@ -1089,11 +1339,33 @@ auto Engine::start_device_threads() -> void {
 
   thread_pool_shared_ = std::make_shared<ThreadPoolShared>();
 
-  non_reentrant_device_thread_count_.store(num_devices);
+  // See Note [CPU helper threads]
+  const int num_cpu_helpers = cpu_worker_count();
+  cpu_helper_queues_ = std::vector<std::shared_ptr<ReadyQueue>>(num_cpu_helpers);
+  for (auto& queue : cpu_helper_queues_) {
+    queue.reset(new ReadyQueue());
+  }
+  for (int i = 0; i < num_cpu_helpers; ++i) {
+    // every helper may steal from every other helper
+    std::vector<std::shared_ptr<ReadyQueue>> steal_targets;
+    for (int j = 0; j < num_cpu_helpers; ++j) {
+      if (j != i) {
+        steal_targets.push_back(cpu_helper_queues_[j]);
+      }
+    }
+    cpu_helper_queues_[i]->set_steal_targets(std::move(steal_targets));
+  }
+
+  non_reentrant_device_thread_count_.store(num_devices + num_cpu_helpers);
   for (int i = 0; i < num_devices; ++i) {
     std::thread t(&Engine::thread_init, this, i, device_ready_queues_[i]);
     t.detach();
   }
+  for (int i = 0; i < num_cpu_helpers; ++i) {
+    std::thread t(
+        &Engine::thread_init, this, CPU_HELPER_DEVICE, cpu_helper_queues_[i]);
+    t.detach();
+  }
 }
 
 void Engine::add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task) {
@@ -11,6 +11,8 @@
 #include <torch/csrc/autograd/input_buffer.h>
 #include <torch/csrc/utils/future.h>
 
+#include <c10/util/Optional.h>
+
 #include <deque>
 #include <exception>
 #include <functional>
@@ -36,6 +38,9 @@ void validate_outputs(
 
 static constexpr int NO_DEVICE = -2;
 static constexpr int CPU_DEVICE = -1;
+// Worker device of the CPU helper threads, which assist with CPU ready work
+// but never own a backward call. See Note [CPU helper threads].
+static constexpr int CPU_HELPER_DEVICE = -3;
 
 // GraphTask holds metadata needed for a single execution of backward()
 struct GraphTask {
@@ -51,7 +56,20 @@ struct GraphTask {
   // To protect reads/writes to not_ready_, dependencies_, captured_vars_,
   // has_error_, future_result_, cpu_ready_queue_, and leaf_streams.
   std::mutex mutex_;
-  std::unordered_map<Node*, InputBuffer> not_ready_;
+  // Note [Multi-producer input buffers]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // A buffer parked in not_ready_ can receive gradients from several producer
+  // nodes running on different threads, and accumulating into it can launch a
+  // real kernel. Each entry therefore carries its own mutex so that the
+  // accumulations run outside GraphTask::mutex_ (which is only held for the
+  // bookkeeping around them). See the deferred accumulation logic in
+  // Engine::evaluate_function for the ordering that makes this safe.
+  struct NotReadyEntry {
+    explicit NotReadyEntry(size_t num_inputs) : buffer(num_inputs) {}
+    InputBuffer buffer;
+    std::mutex mutex;
+  };
+  std::unordered_map<Node*, NotReadyEntry> not_ready_;
   std::unordered_map<Node*, int> dependencies_;
 
   struct ExecInfo {
@@ -200,6 +218,12 @@ struct ReadyQueue {
 
   std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
 
+  // Queues this queue's consumer may steal from when it runs dry.
+  // Written once before the consuming threads start (see
+  // Engine::start_device_threads), safe to read without synchronization
+  // afterwards. See Note [CPU helper threads].
+  std::vector<std::shared_ptr<ReadyQueue>> steal_targets_;
+
  public:
   // incrementOutstandingTasks indicates whether or not we should increment
   // 'outstanding_tasks_' for the associated GraphTask. This should mostly
@@ -210,6 +234,13 @@ struct ReadyQueue {
   NodeTask pop();
   bool empty() const;
   size_t size() const;
+
+  // Must be called before any thread starts consuming from this queue.
+  void set_steal_targets(std::vector<std::shared_ptr<ReadyQueue>> steal_targets);
+  // Pops the top task if it is stealable (a real function task; shutdown and
+  // wake-up placeholder tasks are addressed to this queue's owner and must
+  // stay). Returns nullopt instead of blocking when the queue is contended.
+  c10::optional<NodeTask> try_steal();
 };
 
 // A single instance of this struct should be created through the whole process lifetime.
@@ -272,6 +303,14 @@ struct TORCH_API Engine {
 
   bool is_checkpoint_valid();
 
+  // Configures how many CPU helper threads execute ready CPU Nodes
+  // concurrently during backward; see Note [CPU helper threads] in
+  // engine.cpp. Must be called before the worker threads are started
+  // (i.e. before the first backward); -1 clears an earlier override and
+  // falls back to the TORCH_AUTOGRAD_CPU_WORKERS environment variable.
+  void set_cpu_worker_count(int count);
+  int cpu_worker_count() const;
+
   size_t ready_queue_size(const std::shared_ptr<GraphTask>& graph_task, at::Device device);
 
   // Should be called after fork to notify that worker threads are gone
@@ -317,6 +356,20 @@ struct TORCH_API Engine {
   // Safe to read device_ready_queues_ without synchronization after intialization
   std::vector<std::shared_ptr<ReadyQueue>> device_ready_queues_;
 
+  // Per-worker queues of the CPU helper threads; same lifetime and
+  // synchronization story as device_ready_queues_.
+  // See Note [CPU helper threads]
+  std::vector<std::shared_ptr<ReadyQueue>> cpu_helper_queues_;
+  // Round-robin cursor for spreading CPU ready work over the owner's queue
+  // and the helper queues.
+  std::atomic<size_t> next_cpu_task_queue_{0};
+  // Programmatic override for the CPU helper pool size; -1 means "use the
+  // TORCH_AUTOGRAD_CPU_WORKERS environment variable".
+  std::atomic<int> cpu_worker_count_override_{-1};
+  // Set once start_device_threads has run; after that the pool size is
+  // frozen and set_cpu_worker_count refuses changes.
+  std::atomic<bool> worker_threads_started_{false};
+
   std::vector<std::function<void()>> final_callbacks_;
   // To protect reads and writes to final_callbacks_
   std::mutex post_callbacks_lock_;
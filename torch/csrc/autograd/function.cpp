@@ -19,6 +19,82 @@ namespace torch { namespace autograd {
 /// numbers.
 thread_local uint64_t Function_next_sequence_nr_ = 0;
 
+namespace {
+
+// See Note [Autograd node recycle pool] in function.h. Freed Node blocks are
+// binned by size class (64-byte granularity) into a per-thread freelist and
+// handed back out to subsequent allocations of the same class. Sizes above
+// the cap are rare (a handful of generated nodes with many saved variables)
+// and go straight to the global heap.
+constexpr size_t kNodePoolGranularity = 64;
+constexpr size_t kNodePoolMaxBytes = 1024;
+constexpr size_t kNodePoolNumClasses = kNodePoolMaxBytes / kNodePoolGranularity;
+// Per size class, cap the number of cached blocks so a burst of graph
+// construction doesn't pin memory forever.
+constexpr size_t kNodePoolMaxCached = 256;
+
+struct NodePoolBlock {
+  NodePoolBlock* next;
+};
+
+struct NodePool {
+  NodePoolBlock* freelists[kNodePoolNumClasses] = {};
+  size_t cached[kNodePoolNumClasses] = {};
+
+  ~NodePool() {
+    for (auto& head : freelists) {
+      while (head != nullptr) {
+        NodePoolBlock* block = head;
+        head = block->next;
+        ::operator delete(block);
+      }
+    }
+  }
+};
+
+thread_local NodePool node_pool;
+
+inline size_t node_pool_size_class(size_t size) {
+  return (size - 1) / kNodePoolGranularity;
+}
+
+} // namespace
+
+void* Node::operator new(std::size_t size) {
+  if (size == 0 || size > kNodePoolMaxBytes) {
+    return ::operator new(size);
+  }
+  const size_t cls = node_pool_size_class(size);
+  NodePoolBlock* block = node_pool.freelists[cls];
+  if (block != nullptr) {
+    node_pool.freelists[cls] = block->next;
+    --node_pool.cached[cls];
+    return block;
+  }
+  // Round up to the class boundary so a recycled block can serve any
+  // allocation that maps to the same class.
+  return ::operator new((cls + 1) * kNodePoolGranularity);
+}
+
+void Node::operator delete(void* ptr, std::size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (size == 0 || size > kNodePoolMaxBytes) {
+    ::operator delete(ptr);
+    return;
+  }
+  const size_t cls = node_pool_size_class(size);
+  if (node_pool.cached[cls] >= kNodePoolMaxCached) {
+    ::operator delete(ptr);
+    return;
+  }
+  auto* block = static_cast<NodePoolBlock*>(ptr);
+  block->next = node_pool.freelists[cls];
+  node_pool.freelists[cls] = block;
+  ++node_pool.cached[cls];
+}
+
 uint64_t Node::peek_at_next_sequence_nr() {
   return Function_next_sequence_nr_;
 }
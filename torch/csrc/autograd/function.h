@@ -109,6 +109,26 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   Node& operator=(Node&& other) = delete;
   virtual ~Node() = default;
 
+  // Note [Autograd node recycle pool]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Every differentiable op in a training step heap-allocates a grad_fn, and
+  // the whole graph is freed again after backward(); on small-batch workloads
+  // this malloc/free churn is a measurable slice of the step time. The obvious
+  // fix -- a per-iteration bump arena released en masse after backward() -- is
+  // not sound here: Nodes are owned by shared_ptr from the autograd_meta of
+  // the tensors they produced, so a grad_fn outlives backward() whenever its
+  // output tensor is still alive (or retain_graph is used). Instead we
+  // intercept allocation at class scope and recycle freed Node memory through
+  // a per-thread, size-classed freelist. The sized operator delete receives
+  // the dynamic type's size (it is invoked from the deleting destructor), so
+  // every Node subclass routes through the pool with its true size without
+  // any per-subclass opt-in. Unusually large nodes fall back to the global
+  // heap. Blocks freed on a thread other than the allocating one simply land
+  // in the freeing thread's cache -- in steady state the backward thread both
+  // frees and (for reentrant graphs) allocates, so caches stay balanced.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
@@ -22,6 +22,33 @@ struct TORCH_API AccumulateGrad : public Node {
     return new_grad;
   }
 
+  // Note [Lazy sparse gradient accumulation]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Accumulates two sparse gradients by concatenating their index/value runs
+  // instead of merge-adding them. The result is uncoalesced -- duplicate
+  // indices sum implicitly -- which is the same tensor mathematically and is
+  // handled by every sparse consumer, so the expensive per-accumulation
+  // merge/sort is deferred until someone actually needs a coalesced view
+  // (typically once, in the sparse optimizer update). Embedding-heavy models
+  // accumulate many sparse gradients per step, and those repeated merge
+  // passes dominate their backward. Falls back to a real add once the
+  // concatenated runs would store more elements than the dense tensor, so
+  // memory stays bounded if gradients are accumulated across many steps
+  // without being cleared.
+  static at::Tensor accumulate_sparse_uncoalesced(
+      const at::Tensor& a,
+      const at::Tensor& b) {
+    if (a.sparse_dim() != b.sparse_dim() ||
+        a.scalar_type() != b.scalar_type() ||
+        a._nnz() + b._nnz() > a.numel()) {
+      return a + b;
+    }
+    auto indices = at::cat({a._indices(), b._indices()}, 1);
+    auto values = at::cat({a._values(), b._values()}, 0);
+    return at::_sparse_coo_tensor_unsafe(
+        indices, values, a.sizes(), a.options());
+  }
+
   // Given a variable with its current grad as variable_grad, accumulates
   // new_grad into variable_grad if in place accumulation is possible.
   // Otherwise, uses 'update_grad' to update the grad for the variable.
@@ -97,15 +124,20 @@ struct TORCH_API AccumulateGrad : public Node {
         // TensorImpl type of a tensor requires changing the tensor itself, and
         // thus in this case we have to change the grad tensor.
         update_grad(new_grad + variable_grad);
+      } else if (variable_grad.is_sparse() && new_grad.is_sparse()) {
+        // See Note [Lazy sparse gradient accumulation]: keep the grad as
+        // concatenated uncoalesced runs rather than merge-adding on every
+        // accumulation.
+        update_grad(
+            accumulate_sparse_uncoalesced(variable_grad, new_grad));
       } else {
-        // In this case we can avoid changing the grad tensor. There are three
+        // In this case we can avoid changing the grad tensor. There are two
         // scenarios when we'll hit this case:
         //
-        // 1. `variable_grad` is sparse, and `new_grad` is sparse.
-        // 2. `variable_grad` is dense, and `new_grad` is sparse.
-        // 3. `variable_grad` is dense, and `new_grad` is dense.
+        // 1. `variable_grad` is dense, and `new_grad` is sparse.
+        // 2. `variable_grad` is dense, and `new_grad` is dense.
         //
-        // In all of these three cases, `variable_grad += new_grad` is a
+        // In both of these cases, `variable_grad += new_grad` is a
         // valid operation which adds `new_grad` to `variable_grad` in
         // place. `variable_grad` is thus still referring to the same tensor
         // after the operation.
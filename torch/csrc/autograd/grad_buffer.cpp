@@ -0,0 +1,86 @@
+#include <torch/csrc/autograd/grad_buffer.h>
+
+#include <torch/csrc/autograd/grad_mode.h>
+
+#include <c10/util/Exception.h>
+
+#include <utility>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+GradBuffer::GradBuffer(std::vector<Variable> parameters)
+    : parameters_(std::move(parameters)) {
+  views_.resize(parameters_.size());
+
+  // Group parameters by (device, dtype), in order of first appearance. The
+  // number of groups is tiny (one per device/dtype combination in the
+  // model), so a linear scan beats any map.
+  struct Group {
+    at::Device device;
+    at::ScalarType dtype;
+    std::vector<size_t> indices;
+    int64_t numel = 0;
+  };
+  std::vector<Group> groups;
+  for (size_t i = 0; i < parameters_.size(); ++i) {
+    const auto& param = parameters_[i];
+    TORCH_CHECK(param.defined(), "GradBuffer: undefined parameter at index ", i);
+    TORCH_CHECK(
+        !param.is_sparse(),
+        "GradBuffer: sparse parameters are not supported (index ", i, ")");
+    Group* group = nullptr;
+    for (auto& candidate : groups) {
+      if (candidate.device == param.device() &&
+          candidate.dtype == param.scalar_type()) {
+        group = &candidate;
+        break;
+      }
+    }
+    if (group == nullptr) {
+      groups.push_back({param.device(), param.scalar_type(), {}, 0});
+      group = &groups.back();
+    }
+    group->indices.push_back(i);
+    group->numel += param.numel();
+  }
+
+  // Allocate the flat buffers and carve each parameter's gradient view out
+  // of its group's buffer, reducer-style (narrow + view).
+  AutoGradMode grad_mode(false);
+  buffers_.reserve(groups.size());
+  for (const auto& group : groups) {
+    auto options = parameters_[group.indices.front()].options();
+    auto buffer = at::zeros({group.numel}, options);
+    int64_t offset = 0;
+    for (const auto i : group.indices) {
+      const auto& param = parameters_[i];
+      const auto length = param.numel();
+      views_[i] =
+          buffer.narrow(0, offset, length).view(param.sizes());
+      offset += length;
+    }
+    buffers_.push_back(std::move(buffer));
+  }
+
+  restore_views();
+}
+
+void GradBuffer::zero_() {
+  AutoGradMode grad_mode(false);
+  for (auto& buffer : buffers_) {
+    buffer.zero_();
+  }
+}
+
+void GradBuffer::restore_views() {
+  AutoGradMode grad_mode(false);
+  for (size_t i = 0; i < parameters_.size(); ++i) {
+    auto& grad = parameters_[i].grad();
+    if (!grad.defined() || !grad.is_alias_of(views_[i])) {
+      grad = views_[i];
+    }
+  }
+}
+
+}} // namespace torch::autograd
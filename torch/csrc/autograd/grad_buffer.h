@@ -0,0 +1,63 @@
+#pragma once
+
+#include <torch/csrc/autograd/variable.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <vector>
+
+namespace torch { namespace autograd {
+
+// Note [Flat gradient buffers]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Models with thousands of small parameters pay per-tensor overhead twice in
+// every step: once in AccumulateGrad (one tiny kernel per parameter) and once
+// in the optimizer. This is the single-process analogue of the bucketing the
+// c10d Reducer does for allreduce (see initialize_buckets in
+// torch/csrc/distributed/c10d/reducer.cpp): we preallocate one flat
+// contiguous buffer per (device, dtype) group of parameters and point each
+// parameter's .grad at a view into it. AccumulateGrad then lands every
+// gradient in place through its existing `variable_grad += new_grad` path, so
+// after backward the flat buffers hold all gradients contiguously and the
+// optimizer (or a fused kernel) can do a few large vector operations instead
+// of thousands of tiny ones.
+//
+// Caveats, shared with the Reducer's gradient views:
+//  - This is a first-order training optimization. Running backward with grad
+//    mode enabled (double backward), or a gradient path that has to change
+//    the grad tensor's type (a sparse gradient arriving before any dense
+//    one), replaces the view with an ordinary tensor for that parameter;
+//    restore_views() re-establishes the invariant (discarding whatever the
+//    detached grad held).
+//  - Code that calls .grad.detach_() (old-style zero_grad) is incompatible
+//    with views; use zero_() here instead, which is also one kernel per
+//    buffer rather than one per parameter.
+struct TORCH_API GradBuffer {
+  // Allocates one flat zero-filled buffer per (device, dtype) group over
+  // `parameters` (grouped in the given order) and points each parameter's
+  // .grad at a view into its buffer.
+  explicit GradBuffer(std::vector<Variable> parameters);
+
+  // The flat buffers, one per (device, dtype) group, in order of first
+  // appearance of the group in `parameters`.
+  const std::vector<at::Tensor>& buffers() const {
+    return buffers_;
+  }
+
+  // Zeroes all gradients, one kernel per flat buffer.
+  void zero_();
+
+  // Points each parameter's .grad back at its view into the flat buffer.
+  // Only needed if something replaced a .grad since construction (see the
+  // caveats in Note [Flat gradient buffers]); contents of the replaced grad
+  // are not carried over.
+  void restore_views();
+
+ private:
+  std::vector<Variable> parameters_;
+  // Parallel to parameters_: the view into the flat buffer that serves as
+  // the parameter's .grad.
+  std::vector<at::Tensor> views_;
+  std::vector<at::Tensor> buffers_;
+};
+
+}} // namespace torch::autograd
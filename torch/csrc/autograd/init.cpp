@@ -4,6 +4,7 @@
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <ATen/autocast_mode.h>
+#include <torch/csrc/autograd/engine.h>
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/python_function.h>
 #include <torch/csrc/autograd/function.h>
@@ -34,10 +35,14 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .value("Disabled", ProfilerState::Disabled)
       .value("CPU", ProfilerState::CPU)
       .value("CUDA", ProfilerState::CUDA)
-      .value("NVTX", ProfilerState::NVTX);
+      .value("NVTX", ProfilerState::NVTX)
+      .value("Sampled", ProfilerState::Sampled);
 
   py::class_<ProfilerConfig>(m, "ProfilerConfig")
-      .def(py::init<ProfilerState, bool>());
+      .def(py::init<ProfilerState, bool>())
+      .def(py::init<ProfilerState, bool, double>())
+      .def(py::init<ProfilerState, bool, double, bool>())
+      .def(py::init<ProfilerState, bool, double, bool, bool>());
 
   py::class_<Event>(m, "ProfilerEvent")
       .def("kind", &Event::kind)
@@ -47,13 +52,35 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .def("cpu_elapsed_us", &Event::cpu_elapsed_us)
       .def("cuda_elapsed_us", &Event::cuda_elapsed_us)
       .def("has_cuda", &Event::has_cuda)
+      .def("correlation_id", &Event::correlation_id)
+      .def("cpu_memory_usage", &Event::cpu_memory_usage)
+      .def("cuda_memory_usage", &Event::cuda_memory_usage)
       .def("shapes", &Event::shapes);
 
+  py::class_<DeviceActivity>(m, "_DeviceActivity")
+      .def_readonly("name", &DeviceActivity::name)
+      .def_readonly("correlation_id", &DeviceActivity::correlation_id)
+      .def_readonly("start_ns", &DeviceActivity::start_ns)
+      .def_readonly("end_ns", &DeviceActivity::end_ns)
+      .def_readonly("device", &DeviceActivity::device)
+      .def_readonly("stream", &DeviceActivity::stream);
+
   m.def("_enable_profiler", enableProfiler);
   m.def("_disable_profiler", disableProfiler);
   m.def("_profiler_enabled", profilerEnabled);
+  m.def(
+      "_device_activity_tracing_available", deviceActivityTracingAvailable);
+  m.def("_take_device_activities", takeDeviceActivities);
   m.def("_run_before_callbacks", _runBeforeCallbacks);
 
+  // See Note [CPU helper threads] in torch/csrc/autograd/engine.cpp.
+  m.def("_set_backward_cpu_worker_count", [](int count) {
+    torch::autograd::Engine::get_default_engine().set_cpu_worker_count(count);
+  });
+  m.def("_backward_cpu_worker_count", []() {
+    return torch::autograd::Engine::get_default_engine().cpu_worker_count();
+  });
+
   py::class_<RecordFunction, std::shared_ptr<RecordFunction>>(m, "_RecordFunction")
     .def(py::init<>());
 
@@ -1,5 +1,7 @@
 #include <torch/csrc/autograd/input_buffer.h>
 
+#include <torch/csrc/autograd/functions/accumulate_grad.h>
+
 #include <c10/core/DeviceGuard.h>
 #include <c10/core/StreamGuard.h>
 #include <c10/core/Event.h>
@@ -11,6 +13,18 @@
 
 namespace torch { namespace autograd {
 
+  // A dense gradient can be accumulated into in place iff nobody else can
+  // observe the mutation: we hold the only reference to the tensor and its
+  // storage, and the tensor covers its storage densely (so add_ touches
+  // every element exactly once).
+  static bool can_accumulate_inplace(const Variable& v) {
+    return !v.is_sparse() &&
+        v.is_non_overlapping_and_dense() &&
+        v.use_count() == 1 &&
+        v.has_storage() &&
+        v.storage().use_count() == 1;
+  }
+
   static void accumulate(std::vector<Variable>& buffer,
                          const size_t pos,
                          Variable&& var) {
@@ -19,18 +33,32 @@ namespace torch { namespace autograd {
     // ATen doesn't route sparse additions correctly...
     // do dense + sparse in-place if possible
     if (old_var.is_sparse()) {
+      if (var.is_sparse()) {
+        // See Note [Lazy sparse gradient accumulation] in accumulate_grad.h:
+        // concatenate the runs and leave coalescing to the consumer instead
+        // of merge-adding on every fan-in edge.
+        buffer[pos] =
+            AccumulateGrad::accumulate_sparse_uncoalesced(old_var, var);
       //storage use_count is a big hammer, but for anything lighter there's an adversarial example with unexpected inplace modification
-      if (!var.is_sparse() && var.is_contiguous() && var.storage().use_count() == 1) {
+      } else if (var.is_contiguous() && var.storage().use_count() == 1) {
           buffer[pos] = var.add_(old_var);
       } else {
           buffer[pos] = var + old_var;
       }
-    } else {
-      if (var.is_sparse() && !old_var.is_sparse() && old_var.is_contiguous() && old_var.storage().use_count() == 1) {
+    } else if (var.is_sparse()) {
+      if (old_var.is_contiguous() && old_var.storage().use_count() == 1) {
           buffer[pos] = old_var.add_(var);
       } else {
           buffer[pos] = old_var + var;
       }
+    } else if (can_accumulate_inplace(old_var)) {
+      // Dense + dense: accumulate into the first-arriving buffer instead of
+      // materializing a fresh tensor per fan-in edge.
+      buffer[pos] = old_var.add_(var);
+    } else if (can_accumulate_inplace(var)) {
+      buffer[pos] = var.add_(old_var);
+    } else {
+      buffer[pos] = old_var + var;
     }
   }
 
@@ -1,6 +1,9 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/jit/frontend/code_template.h>
 
+#include <c10/core/Allocator.h>
+
+#include <atomic>
 #include <fstream>
 #include <list>
 #include <mutex>
@@ -19,6 +22,26 @@ constexpr CUDAStubs* default_stubs_addr = &default_stubs;
 static CUDAStubs* cuda_stubs = default_stubs_addr;
 
 ProfilerState state = ProfilerState::Disabled;
+
+// Note [CUPTI activity tracing]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The classic CUDA profiling mode brackets every op with a pair of
+// cudaEvents and synchronizes to read them, which perturbs the very thing
+// being measured. With ProfilerConfig::use_device_activities, the CUPTI
+// backend in profiler_cuda.cpp instead subscribes to the driver's activity
+// records (kernels, memcpys, memsets), which are buffered on-device and
+// delivered asynchronously. To attribute device activities back to op
+// scopes, pushRange pushes an external correlation id (from a global
+// counter) which CUPTI attaches to every kernel launched inside the scope;
+// the same id is stored on the PushRange Event, so consumers can join the
+// two timelines after the fact. One caveat: when a RecordFunction ends on a
+// different thread than it started on, the original thread's correlation
+// stack cannot be popped from here; device work launched on that thread
+// before its next scope may be attributed to the stale scope.
+bool device_activities_active = false;
+std::atomic<uint64_t> next_correlation_id{1};
+std::vector<DeviceActivity> collected_device_activities;
+
 // Protects access all_event_lists_map.
 std::mutex all_event_lists_map_mutex;
 std::unordered_map<uint16_t, std::shared_ptr<RangeEventList>>
@@ -34,10 +57,41 @@ void registerCUDAMethods(CUDAStubs* stubs) {
 
 ProfilerConfig::~ProfilerConfig() = default;
 
+namespace {
+// Per-thread ring size for ProfilerState::Sampled; at ~100 bytes per Event
+// this bounds an always-on profiled thread to a few MB.
+constexpr size_t kSampledRingCapacity = 32 * 1024;
+
+// Installed into c10 for the duration of a profile(profile_memory=True)
+// session; every allocator alloc/free lands as a MemoryAlloc event on the
+// calling thread's event list, and is attributed to the innermost enclosing
+// op scope when the trace is parsed (see torch/autograd/profiler.py).
+struct MemoryReportingInfo : public c10::MemoryReportingInfoBase {
+  void reportMemoryUsage(void* /* ptr */, int64_t alloc_size, c10::Device device)
+      override {
+    if (state == ProfilerState::Disabled || state == ProfilerState::NVTX) {
+      return;
+    }
+    getEventList()
+        .record(
+            EventKind::MemoryAlloc,
+            StringView("[memory]"),
+            thread_id,
+            /* record_cuda */ false)
+        .updateMemoryStats(alloc_size, device);
+  }
+};
+
+MemoryReportingInfo memory_reporting_info;
+} // namespace
+
 RangeEventList& getEventList() {
   if (!event_list) {
     std::lock_guard<std::mutex> guard(all_event_lists_map_mutex);
-    event_list = std::make_shared<RangeEventList>();
+    // The list's shape (unbounded blocks vs. fixed ring) is decided by the
+    // mode under which the thread records its first event.
+    event_list = std::make_shared<RangeEventList>(
+        state == ProfilerState::Sampled ? kSampledRingCapacity : 0);
     thread_id = RecordFunction::currentThreadId();
     all_event_lists_map.emplace(thread_id, event_list);
   }
@@ -100,12 +154,20 @@ void pushRange(
       cuda_stubs->nvtxRangePushA(name.str());
     }
   } else {
+    uint64_t correlation_id = 0;
+    if (device_activities_active) {
+      correlation_id = next_correlation_id++;
+      cuda_stubs->pushCorrelationId(correlation_id);
+    }
     getEventList().record(
         EventKind::PushRange,
         name,
         thread_id,
-        state == ProfilerState::CUDA,
-        std::move(shapes));
+        // Per-op cudaEvents are the observer effect the activity backend
+        // exists to avoid; skip them when it is on.
+        state == ProfilerState::CUDA && !device_activities_active,
+        std::move(shapes),
+        correlation_id);
   }
 }
 
@@ -116,17 +178,23 @@ void popRange() {
   if (state == ProfilerState::NVTX) {
     cuda_stubs->nvtxRangePop();
   } else {
+    if (device_activities_active) {
+      cuda_stubs->popCorrelationId();
+    }
     getEventList().record(
         EventKind::PopRange,
         StringView(""),
         thread_id,
-        state == ProfilerState::CUDA);
+        state == ProfilerState::CUDA && !device_activities_active);
   }
 }
 
 void enableProfiler(ProfilerConfig config) {
   ProfilerState new_state = config.state;
   AT_ASSERT(new_state != ProfilerState::Disabled);
+  TORCH_CHECK(
+      config.sampling_prob > 0 && config.sampling_prob <= 1.0,
+      "Profiler sampling probability should be in (0, 1]");
   if (new_state == ProfilerState::NVTX && !cuda_stubs->enabled())
     throw std::runtime_error("Can't use NVTX profiler - PyTorch was compiled without CUDA");
   if (state != ProfilerState::Disabled && new_state != state) {
@@ -177,21 +245,38 @@ void enableProfiler(ProfilerConfig config) {
                 fn.getStartCallbacksThreadId());
 
             auto& eventList = eventListIter->second;
-            eventList->record(
+            // Use the foreign-writer entry point: the owning thread may be
+            // recording concurrently. See Note [Lock-free event recording].
+            eventList->record_foreign(
                       EventKind::PopRange,
                       StringView(""),
                       fn.getStartCallbacksThreadId(),
-                      state == ProfilerState::CUDA);
+                      state == ProfilerState::CUDA &&
+                          !device_activities_active);
           }
         } else {
           popRange();
         }
       },
       /* needs_inputs */ config.report_input_shapes,
-      /* sampling_prob */ 1.0,
+      /* sampling_prob */ config.sampling_prob,
       /* scopes */ {RecordScope::FUNCTION, RecordScope::USER_SCOPE});
   state = new_state;
 
+  if (config.profile_memory && state != ProfilerState::NVTX) {
+    c10::SetMemoryReportingInfo(&memory_reporting_info);
+  }
+
+  if (state == ProfilerState::CUDA && config.use_device_activities) {
+    TORCH_CHECK(
+        cuda_stubs->activityTracingAvailable(),
+        "use_device_activities requires a build with USE_CUPTI");
+    cuda_stubs->enableActivityTracing();
+    device_activities_active = true;
+    mark("__start_profile", false);
+    return;
+  }
+
   if(state == ProfilerState::CUDA) {
     // event recording appears to have some startup overhead, so we need to
     // to generate some dummy events first before recording synchronization events
@@ -221,6 +306,14 @@ thread_event_lists disableProfiler() {
 
   popCallback();
   state = ProfilerState::Disabled;
+  c10::SetMemoryReportingInfo(nullptr);
+
+  if (device_activities_active) {
+    // Flushes outstanding CUPTI buffers; activities are kept until the next
+    // takeDeviceActivities() call.
+    collected_device_activities = cuda_stubs->disableActivityTracing();
+    device_activities_active = false;
+  }
 
   if (old_state == ProfilerState::NVTX) {
     return thread_event_lists();
@@ -243,6 +336,14 @@ thread_event_lists disableProfiler() {
   }
 }
 
+bool deviceActivityTracingAvailable() {
+  return cuda_stubs->activityTracingAvailable();
+}
+
+std::vector<DeviceActivity> takeDeviceActivities() {
+  return std::move(collected_device_activities);
+}
+
 void Event::record(bool record_cuda) {
   if (record_cuda) {
     cuda_stubs->record(&device_, &event, &cpu_ns_);
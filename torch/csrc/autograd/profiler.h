@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <memory>
@@ -25,6 +26,20 @@ struct Node;
 
 namespace profiler {
 
+// A device-side activity (kernel, memcpy, memset) collected asynchronously
+// by the CUPTI backend (see profiler_cuda.cpp). Timestamps are in ns on the
+// CPU clock used by getTime(). correlation_id matches the id recorded on the
+// PushRange Event of the op scope the activity was launched from (see
+// Note [CUPTI activity tracing]).
+struct TORCH_API DeviceActivity {
+  std::string name;
+  uint64_t correlation_id = 0;
+  int64_t start_ns = 0;
+  int64_t end_ns = 0;
+  int device = -1;
+  int64_t stream = -1;
+};
+
 struct TORCH_API CUDAStubs {
   virtual void record(int* device, CUDAEventStub* event, int64_t* cpu_ns) {
     fail();
@@ -33,6 +48,24 @@ struct TORCH_API CUDAStubs {
     fail();
     return 0.f;
   }
+  // Asynchronous activity tracing (CUPTI). Available only when PyTorch is
+  // built with USE_CUPTI; see Note [CUPTI activity tracing].
+  virtual bool activityTracingAvailable() {
+    return false;
+  }
+  virtual void enableActivityTracing() {
+    fail();
+  }
+  virtual std::vector<DeviceActivity> disableActivityTracing() {
+    fail();
+    return {};
+  }
+  virtual void pushCorrelationId(uint64_t id) {
+    fail();
+  }
+  virtual void popCorrelationId() {
+    fail();
+  }
   virtual void nvtxMarkA(const char* name) {
     fail();
   }
@@ -102,20 +135,44 @@ enum class TORCH_API ProfilerState {
     CPU, // CPU-only profiling
     CUDA, // CPU + CUDA events
     NVTX,  // only emit NVTX markers
+    Sampled, // CPU-only, sampled, into bounded per-thread rings; cheap
+             // enough to leave enabled in long-running services
 };
 
 struct TORCH_API ProfilerConfig {
-  ProfilerConfig(ProfilerState state, bool report_input_shapes)
-      : state(state), report_input_shapes(report_input_shapes) {}
+  ProfilerConfig(
+      ProfilerState state,
+      bool report_input_shapes,
+      double sampling_prob = 1.0,
+      bool use_device_activities = false,
+      bool profile_memory = false)
+      : state(state),
+        report_input_shapes(report_input_shapes),
+        sampling_prob(sampling_prob),
+        use_device_activities(use_device_activities),
+        profile_memory(profile_memory) {}
   ~ProfilerConfig();
   ProfilerState state;
   bool report_input_shapes;
+  // Probability that any given RecordFunction is profiled (see the
+  // sampling support in record_function.h, which keeps start/end callbacks
+  // paired). Mostly useful with ProfilerState::Sampled.
+  double sampling_prob;
+  // With ProfilerState::CUDA, collect kernel/memcpy timelines asynchronously
+  // through CUPTI instead of bracketing every op with cudaEvents; see
+  // Note [CUPTI activity tracing]. Requires a build with USE_CUPTI.
+  bool use_device_activities;
+  // Record allocator activity (see c10::MemoryReportingInfoBase) as
+  // MemoryAlloc events, so every profiled op scope can report the bytes it
+  // allocated and freed.
+  bool profile_memory;
 };
 
 enum class TORCH_API EventKind : uint16_t {
   Mark,
   PushRange,
-  PopRange
+  PopRange,
+  MemoryAlloc,
 };
 #ifndef _MSC_VER
 #  pragma GCC diagnostic pop
@@ -127,11 +184,13 @@ struct TORCH_API Event final {
       StringView name,
       uint16_t thread_id,
       bool record_cuda,
-      std::vector<std::vector<int64_t>>&& shapes = {})
+      std::vector<std::vector<int64_t>>&& shapes = {},
+      uint64_t correlation_id = 0)
       : name_(std::move(name)),
         kind_(kind),
         thread_id_(thread_id),
-        shapes_(shapes) {
+        shapes_(shapes),
+        correlation_id_(correlation_id) {
     record(record_cuda);
   }
 
@@ -141,6 +200,7 @@ struct TORCH_API Event final {
       case EventKind::Mark: return "mark";
       case EventKind::PushRange: return "push";
       case EventKind::PopRange: return "pop";
+      case EventKind::MemoryAlloc: return "memory_alloc";
     }
     throw std::runtime_error("unknown EventKind");
   }
@@ -156,6 +216,11 @@ struct TORCH_API Event final {
   double cpu_elapsed_us(const Event & e) {
     return (e.cpu_ns_ - cpu_ns_)/(1000.0);
   }
+  // Absolute CPU timestamp in ns; used to interleave events merged from
+  // different writers (see RangeEventList::consolidate).
+  int64_t cpu_ns() const {
+    return cpu_ns_;
+  }
   double cuda_elapsed_us(const Event & e);
   bool has_cuda() const {
     return event != nullptr;
@@ -163,6 +228,26 @@ struct TORCH_API Event final {
   int device() const {
     return device_;
   }
+  // Non-zero only for PushRange events recorded while CUPTI activity tracing
+  // is on; matches DeviceActivity::correlation_id.
+  uint64_t correlation_id() const {
+    return correlation_id_;
+  }
+  // Attribute an allocator report to this event (MemoryAlloc kind);
+  // alloc_size is positive for allocations and negative for frees.
+  void updateMemoryStats(int64_t alloc_size, c10::Device device) {
+    if (device.is_cuda() || device.type() == c10::DeviceType::HIP) {
+      cuda_memory_usage_ = alloc_size;
+    } else {
+      cpu_memory_usage_ = alloc_size;
+    }
+  }
+  int64_t cpu_memory_usage() const {
+    return cpu_memory_usage_;
+  }
+  int64_t cuda_memory_usage() const {
+    return cuda_memory_usage_;
+  }
 private:
   // signed to allow for negative intervals, initialized for safety.
   int64_t cpu_ns_ = 0;
@@ -170,16 +255,39 @@ private:
   EventKind kind_;
   uint16_t thread_id_;
   std::vector<std::vector<int64_t>> shapes_;
+  uint64_t correlation_id_ = 0;
   int device_ = -1;
+  int64_t cpu_memory_usage_ = 0;
+  int64_t cuda_memory_usage_ = 0;
   struct CUevent_st* event = nullptr;
 };
 
 // a linked-list of fixed sized vectors, to avoid
 // a std::vector resize from taking a large amount of time inside
 // a profiling  event
+//
+// Note [Lock-free event recording]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Each RangeEventList is owned by exactly one thread (see getEventList), and
+// the owner records without taking any lock: even an uncontended mutex
+// acquire/release pair is measurable at per-op granularity and distorts
+// multi-threaded inference timings. The one cross-thread write -- a
+// RecordFunction that ends on a different thread than it started on -- goes
+// through record_foreign(), which appends to a small side list under the
+// mutex, so it never races the owner. consolidate() merges the two by
+// timestamp; like changing profiler modes, it must only run when no events
+// are being recorded (see the NOTE above enableProfiler).
 struct RangeEventList {
-  // This mutex is used to serialize access when different threads are writing
-  // to the same instance of RangeEventList.
+  RangeEventList() = default;
+  // A non-zero ring capacity turns the list into a fixed-size ring that
+  // overwrites its oldest events instead of growing; used by
+  // ProfilerState::Sampled so profiling can stay enabled indefinitely with
+  // bounded memory.
+  explicit RangeEventList(size_t ring_capacity)
+      : ring_capacity_(ring_capacity) {}
+
+  // Serializes record_foreign() against consolidate(). Owner-thread
+  // record() never takes it.
   std::mutex mutex_;
   constexpr static size_t MB = 1024 * 1024;
   constexpr static size_t event_block_size = 16 * MB;
@@ -189,34 +297,79 @@ struct RangeEventList {
                 "num_block_elements is calculated incorrectly");
   using block_type = std::vector<Event>;
 
+  // Must only be called from the owning thread. Returns the recorded event
+  // so callers can attach data that is not part of the Event constructor
+  // (e.g. updateMemoryStats); the reference is only valid until the next
+  // record() call.
   template<typename... Args>
-  void record(Args&&... args) {
-    std::lock_guard<std::mutex> guard(mutex_);
+  Event& record(Args&&... args) {
+    if (ring_capacity_ > 0) {
+      const size_t slot = ring_next_;
+      if (ring_.size() < ring_capacity_) {
+        if (ring_.capacity() == 0) {
+          ring_.reserve(ring_capacity_);
+        }
+        ring_.emplace_back(std::forward<Args>(args)...);
+      } else {
+        ring_[slot] = Event(std::forward<Args>(args)...);
+      }
+      ring_next_ = (ring_next_ + 1) % ring_capacity_;
+      return ring_[slot];
+    }
     if (blocks.empty() || blocks.front().size() == num_block_elements) {
       allocBlock();
     }
     blocks.front().emplace_back(std::forward<Args>(args)...);
+    return blocks.front().back();
+  }
+
+  // Safe to call from any thread.
+  template<typename... Args>
+  void record_foreign(Args&&... args) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    foreign_events_.emplace_back(std::forward<Args>(args)...);
   }
 
   std::vector<Event> consolidate() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    std::forward_list<block_type> localBlocks;
-    localBlocks.swap(blocks);
-    lock.unlock();
     std::vector<Event> result;
-
-    for (auto & block : localBlocks) {
-      result.insert(result.begin(),
-                    std::make_move_iterator(block.begin()),
-                    std::make_move_iterator(block.end()));
+    if (ring_capacity_ > 0) {
+      // Unroll the ring into chronological order.
+      result.reserve(ring_.size());
+      const size_t start = ring_.size() < ring_capacity_ ? 0 : ring_next_;
+      for (size_t i = 0; i < ring_.size(); ++i) {
+        result.push_back(std::move(ring_[(start + i) % ring_.size()]));
+      }
+      ring_.clear();
+      ring_next_ = 0;
+    } else {
+      std::forward_list<block_type> localBlocks;
+      localBlocks.swap(blocks);
+      for (auto & block : localBlocks) {
+        result.insert(result.begin(),
+                      std::make_move_iterator(block.begin()),
+                      std::make_move_iterator(block.end()));
+      }
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!foreign_events_.empty()) {
+      result.insert(result.end(),
+                    std::make_move_iterator(foreign_events_.begin()),
+                    std::make_move_iterator(foreign_events_.end()));
+      foreign_events_.clear();
+      // Restore chronological order so push/pop pairing by position still
+      // works downstream.
+      std::stable_sort(result.begin(), result.end(),
+                       [](const Event& a, const Event& b) {
+                         return a.cpu_ns() < b.cpu_ns();
+                       });
     }
     return result;
   }
 
   std::forward_list<block_type> blocks;
   private:
-     // allocBlock() assumes that mutex_ is held when called, in order to prevent
-    // multiple threads' block writes stomping over each other.
+    // allocBlock() is only called by the owning thread, see
+    // Note [Lock-free event recording].
     void allocBlock() {
       blocks.emplace_front();
       auto & new_block = blocks.front();
@@ -228,6 +381,11 @@ struct RangeEventList {
         (*ptr);
       }
     }
+
+    std::vector<Event> ring_;
+    size_t ring_capacity_ = 0;
+    size_t ring_next_ = 0;
+    std::vector<Event> foreign_events_;
 };
 
 TORCH_API RangeEventList& getEventList();
@@ -240,6 +398,13 @@ TORCH_API void enableProfiler(ProfilerConfig);
 TORCH_API thread_event_lists disableProfiler();
 TORCH_API bool profilerEnabled();
 
+// Whether this build can collect device activities asynchronously (i.e. was
+// built with USE_CUPTI). See Note [CUPTI activity tracing].
+TORCH_API bool deviceActivityTracingAvailable();
+// Returns (and clears) the activities collected during the last CUDA
+// profiling session run with use_device_activities.
+TORCH_API std::vector<DeviceActivity> takeDeviceActivities();
+
 
 // Usage:
 //   {
@@ -2,7 +2,14 @@
 #include <c10/cuda/CUDAGuard.h>
 #include <nvToolsExt.h>
 
+#ifdef USE_CUPTI
+#include <cupti.h>
+#endif
+
+#include <cstdlib>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace torch { namespace autograd { namespace profiler {
 
@@ -31,6 +38,122 @@ static inline void cudaCheck(cudaError_t result, const char * file, int line) {
 }
 #define TORCH_CUDA_CHECK(result) cudaCheck(result,__FILE__,__LINE__);
 
+#ifdef USE_CUPTI
+
+// CUPTI backend for Note [CUPTI activity tracing] (see profiler.cpp).
+// Activity records are buffered by the driver and delivered to
+// bufferCompleted on a CUPTI-owned thread; we stash raw records and resolve
+// them into DeviceActivity (including the external correlation ids pushed
+// around op scopes and the CUPTI->CPU clock offset) when tracing stops.
+
+static void cuptiCheck(CUptiResult result, const char* file, int line) {
+  if (result != CUPTI_SUCCESS) {
+    const char* str = nullptr;
+    cuptiGetResultString(result, &str);
+    std::stringstream ss;
+    ss << file << ":" << line << ": CUPTI error: "
+       << (str != nullptr ? str : "unknown");
+    throw std::runtime_error(ss.str());
+  }
+}
+#define TORCH_CUPTI_CHECK(result) cuptiCheck(result, __FILE__, __LINE__);
+
+constexpr size_t kCuptiBufferSize = 4 * 1024 * 1024;
+
+struct CuptiActivityState {
+  std::mutex mutex;
+  std::vector<DeviceActivity> activities;
+  // CUPTI correlation id -> external (op scope) correlation id.
+  std::unordered_map<uint32_t, uint64_t> external_ids;
+  // Offset turning CUPTI timestamps into getTime() CPU timestamps,
+  // calibrated when tracing is enabled.
+  int64_t clock_offset_ns = 0;
+};
+
+CuptiActivityState& cuptiState() {
+  static CuptiActivityState state;
+  return state;
+}
+
+void CUPTIAPI bufferRequested(
+    uint8_t** buffer,
+    size_t* size,
+    size_t* maxNumRecords) {
+  // malloc guarantees the 8-byte alignment CUPTI asks for.
+  *buffer = static_cast<uint8_t*>(std::malloc(kCuptiBufferSize));
+  *size = kCuptiBufferSize;
+  *maxNumRecords = 0;
+}
+
+void CUPTIAPI bufferCompleted(
+    CUcontext /* unused */,
+    uint32_t /* unused */,
+    uint8_t* buffer,
+    size_t /* unused */,
+    size_t validSize) {
+  auto& state = cuptiState();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  CUpti_Activity* record = nullptr;
+  while (validSize > 0 &&
+         cuptiActivityGetNextRecord(buffer, validSize, &record) ==
+             CUPTI_SUCCESS) {
+    switch (record->kind) {
+      case CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL: {
+        const auto* kernel =
+            reinterpret_cast<const CUpti_ActivityKernel4*>(record);
+        DeviceActivity activity;
+        activity.name = kernel->name;
+        // Resolved to the external id in disableActivityTracing.
+        activity.correlation_id = kernel->correlationId;
+        activity.start_ns = static_cast<int64_t>(kernel->start);
+        activity.end_ns = static_cast<int64_t>(kernel->end);
+        activity.device = static_cast<int>(kernel->deviceId);
+        activity.stream = static_cast<int64_t>(kernel->streamId);
+        state.activities.push_back(std::move(activity));
+        break;
+      }
+      case CUPTI_ACTIVITY_KIND_MEMCPY: {
+        const auto* memcpy_record =
+            reinterpret_cast<const CUpti_ActivityMemcpy*>(record);
+        DeviceActivity activity;
+        activity.name = "Memcpy";
+        activity.correlation_id = memcpy_record->correlationId;
+        activity.start_ns = static_cast<int64_t>(memcpy_record->start);
+        activity.end_ns = static_cast<int64_t>(memcpy_record->end);
+        activity.device = static_cast<int>(memcpy_record->deviceId);
+        activity.stream = static_cast<int64_t>(memcpy_record->streamId);
+        state.activities.push_back(std::move(activity));
+        break;
+      }
+      case CUPTI_ACTIVITY_KIND_MEMSET: {
+        const auto* memset_record =
+            reinterpret_cast<const CUpti_ActivityMemset*>(record);
+        DeviceActivity activity;
+        activity.name = "Memset";
+        activity.correlation_id = memset_record->correlationId;
+        activity.start_ns = static_cast<int64_t>(memset_record->start);
+        activity.end_ns = static_cast<int64_t>(memset_record->end);
+        activity.device = static_cast<int>(memset_record->deviceId);
+        activity.stream = static_cast<int64_t>(memset_record->streamId);
+        state.activities.push_back(std::move(activity));
+        break;
+      }
+      case CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION: {
+        const auto* correlation =
+            reinterpret_cast<const CUpti_ActivityExternalCorrelation*>(record);
+        state.external_ids[correlation->correlationId] =
+            correlation->externalId;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  std::free(buffer);
+}
+
+#endif // USE_CUPTI
+
 struct CUDAMethods : public CUDAStubs {
   void record(int* device, CUDAEventStub* event, int64_t* cpu_ns) override {
     TORCH_CUDA_CHECK(cudaGetDevice(device));
@@ -70,6 +193,72 @@ struct CUDAMethods : public CUDAStubs {
     return true;
   }
 
+#ifdef USE_CUPTI
+  bool activityTracingAvailable() override {
+    return true;
+  }
+
+  void enableActivityTracing() override {
+    auto& state = cuptiState();
+    {
+      std::lock_guard<std::mutex> guard(state.mutex);
+      state.activities.clear();
+      state.external_ids.clear();
+      // Calibrate the CUPTI clock against the CPU clock used for Events so
+      // both timelines can be interleaved.
+      uint64_t cupti_now = 0;
+      TORCH_CUPTI_CHECK(cuptiGetTimestamp(&cupti_now));
+      state.clock_offset_ns = getTime() - static_cast<int64_t>(cupti_now);
+    }
+    TORCH_CUPTI_CHECK(
+        cuptiActivityRegisterCallbacks(bufferRequested, bufferCompleted));
+    TORCH_CUPTI_CHECK(
+        cuptiActivityEnable(CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION));
+    TORCH_CUPTI_CHECK(
+        cuptiActivityEnable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL));
+    TORCH_CUPTI_CHECK(cuptiActivityEnable(CUPTI_ACTIVITY_KIND_MEMCPY));
+    TORCH_CUPTI_CHECK(cuptiActivityEnable(CUPTI_ACTIVITY_KIND_MEMSET));
+  }
+
+  std::vector<DeviceActivity> disableActivityTracing() override {
+    TORCH_CUPTI_CHECK(cuptiActivityDisable(CUPTI_ACTIVITY_KIND_MEMSET));
+    TORCH_CUPTI_CHECK(cuptiActivityDisable(CUPTI_ACTIVITY_KIND_MEMCPY));
+    TORCH_CUPTI_CHECK(
+        cuptiActivityDisable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL));
+    TORCH_CUPTI_CHECK(
+        cuptiActivityDisable(CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION));
+    // Deliver any buffers still held by the driver.
+    TORCH_CUPTI_CHECK(cuptiActivityFlushAll(0));
+
+    auto& state = cuptiState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    std::vector<DeviceActivity> result;
+    result.reserve(state.activities.size());
+    for (auto& activity : state.activities) {
+      // Rewrite the CUPTI correlation id with the op scope id pushed in
+      // pushRange; activities launched outside any profiled scope keep 0.
+      const auto it =
+          state.external_ids.find(static_cast<uint32_t>(activity.correlation_id));
+      activity.correlation_id = it != state.external_ids.end() ? it->second : 0;
+      activity.start_ns += state.clock_offset_ns;
+      activity.end_ns += state.clock_offset_ns;
+      result.push_back(std::move(activity));
+    }
+    state.activities.clear();
+    state.external_ids.clear();
+    return result;
+  }
+
+  void pushCorrelationId(uint64_t id) override {
+    TORCH_CUPTI_CHECK(cuptiActivityPushExternalCorrelationId(
+        CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, id));
+  }
+
+  void popCorrelationId() override {
+    TORCH_CUPTI_CHECK(cuptiActivityPopExternalCorrelationId(
+        CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, nullptr));
+  }
+#endif // USE_CUPTI
 };
 
 struct RegisterCUDAMethods {
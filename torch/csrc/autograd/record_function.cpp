@@ -11,13 +11,33 @@ namespace profiler {
 
 namespace {
 
-float sample_zero_one() {
+// Note [Cheap sampled callbacks]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Sampled callbacks exist so that a low-frequency observer (e.g. a
+// 1-in-10000 op-latency sampler) can stay registered fleet-wide; that only
+// works if the skip path costs next to nothing. Instead of drawing a
+// uniform random number on every op, each thread keeps a per-callback
+// counter of how many invocations to skip before the callback fires again.
+// The counter is drawn from a geometric distribution with the callback's
+// sampling probability, which makes each invocation an exact Bernoulli
+// trial while touching the RNG only once per ~1/prob ops; the skip path is
+// a single decrement. Counters are lazily (re)initialized whenever the
+// thread first observes a new callbacks_version_.
+int64_t sample_geometric(double prob) {
   static thread_local auto gen =
       torch::make_unique<std::mt19937>(std::random_device()());
-  std::uniform_real_distribution<float> dist(0.0, 1.0);
+  std::geometric_distribution<int64_t> dist(prob);
   return dist(*gen);
 }
 
+struct ThreadLocalSamplingState {
+  bool initialized = false;
+  uint64_t callbacks_version = 0;
+  // number of sampled-callback invocations left to skip, per callback index
+  c10::SmallVector<int64_t, kSoftLimitCallbacks> tries_left;
+};
+thread_local ThreadLocalSamplingState sampling_state_;
+
 class CallbackManager {
  public:
   void pushCallback(
@@ -103,11 +123,15 @@ class CallbackManager {
   inline void TEST_setGlobalSamplingProbability(double sampling_prob) {
     global_prob_ = sampling_prob;
     use_global_prob_ = true;
+    // invalidate the per-thread skip counters drawn with the old
+    // probabilities; see Note [Cheap sampled callbacks]
+    ++callbacks_version_;
   }
 
   inline void TEST_unsetGlobalSamplingProbability() {
     global_prob_ = 0.0;
     use_global_prob_ = false;
+    ++callbacks_version_;
   }
 
  private:
@@ -129,9 +153,37 @@ class CallbackManager {
 
   inline bool shouldRunCallback(size_t cb_idx, RecordScope scope) const {
     TORCH_INTERNAL_ASSERT(cb_idx < callbacks_.size());
-    return callbacks_[cb_idx].scopes_[static_cast<size_t>(scope)] &&
-           (!callbacks_[cb_idx].is_sampled_ ||
-            (sample_zero_one() < samplingProbability(cb_idx)));
+    if (!callbacks_[cb_idx].scopes_[static_cast<size_t>(scope)]) {
+      return false;
+    }
+    if (!callbacks_[cb_idx].is_sampled_ && !use_global_prob_) {
+      return true;
+    }
+    const double prob = samplingProbability(cb_idx);
+    if (prob >= 1.0) {
+      return true;
+    }
+    if (prob <= 0.0) {
+      return false;
+    }
+    // see Note [Cheap sampled callbacks]
+    auto& state = sampling_state_;
+    if (!state.initialized || state.callbacks_version != callbacks_version_) {
+      state.initialized = true;
+      state.callbacks_version = callbacks_version_;
+      state.tries_left.clear();
+      for (size_t i = 0; i < callbacks_.size(); ++i) {
+        const double p = samplingProbability(i);
+        state.tries_left.push_back(
+            (p > 0.0 && p < 1.0) ? sample_geometric(p) : 0);
+      }
+    }
+    if (state.tries_left[cb_idx] > 0) {
+      --state.tries_left[cb_idx];
+      return false;
+    }
+    state.tries_left[cb_idx] = sample_geometric(prob);
+    return true;
   }
 
   struct Callback;
@@ -268,7 +268,9 @@ TORCH_API void TEST_unsetGlobalSamplingProbability();
  *  needs_inputs - whether the callbacks need the inputs passed from the observed
  *    function/range; NOTE: passing the inputs incurs an additional overhead;
  *  sampling_prob - whether the callbacks are sampled and the sampling
- *    probability;
+ *    probability; the skip path is a thread-local counter decrement (no RNG
+ *    call), cheap enough for always-on, low-probability observers
+ *    (see Note [Cheap sampled callbacks] in record_function.cpp);
  *  scopes - types of scopes to execute the callbacks on (see RecordScope);
  *    passing empty set means the callbacks will be executed for all possible
  *    scope types
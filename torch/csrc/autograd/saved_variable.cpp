@@ -7,13 +7,160 @@
 
 #include <ATen/Tensor.h>
 
+#include <c10/core/DeviceGuard.h>
+#include <c10/core/Event.h>
+#include <c10/core/StreamGuard.h>
+#include <c10/util/Optional.h>
+
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 namespace torch { namespace autograd {
 
+// See Note [Saved tensor host offload] in saved_variable.h.
+struct SavedTensorOffloadState {
+  std::mutex mutex;
+  // Pinned copy; written by the offload D2H copy, guarded by offload_event.
+  at::Tensor host;
+  // Device copy; valid once prefetch_started, guarded by prefetch_event.
+  at::Tensor prefetched;
+  at::TensorOptions device_options;
+  c10::Device device{c10::DeviceType::CPU};
+  c10::optional<c10::Event> offload_event;
+  c10::optional<c10::Event> prefetch_event;
+  bool prefetch_started = false;
+
+  // Starts the H2D copy back to the home device. Must hold mutex.
+  void start_prefetch_locked() {
+    if (prefetch_started) {
+      return;
+    }
+    prefetch_started = true;
+    c10::DeviceGuard device_guard(device);
+    const c10::impl::VirtualGuardImpl impl(device.type());
+    const auto stream = impl.getStream(device);
+    // Don't read the pinned buffer before the offload copy has written it.
+    offload_event->block(stream);
+    prefetched = at::empty(host.sizes(), device_options);
+    prefetched.copy_(host, /*non_blocking=*/true);
+    prefetch_event = c10::Event(device.type());
+    prefetch_event->record(stream);
+  }
+
+  // Returns the device copy, ordering the consuming (current) stream after
+  // the H2D copy. Issues the copy on the spot if prefetch never ran.
+  at::Tensor fetch() {
+    std::lock_guard<std::mutex> lock(mutex);
+    start_prefetch_locked();
+    const c10::impl::VirtualGuardImpl impl(device.type());
+    prefetch_event->block(impl.getStream(device));
+    return prefetched;
+  }
+};
+
+namespace {
+
+thread_local bool offload_enabled = false;
+std::atomic<size_t> offload_min_bytes{1024 * 1024};
+
+// How many not-yet-prefetched spilled tensors a single prefetch_ahead() call
+// kicks off. Enough to stay ahead of one node's compute without flooding the
+// copy path.
+constexpr size_t kOffloadPrefetchWindow = 2;
+
+// Offloaded tensors in save order. Backward consumes saved tensors in
+// roughly reverse save order, so prefetching walks from the back.
+struct OffloadQueue {
+  std::mutex mutex;
+  std::deque<std::weak_ptr<SavedTensorOffloadState>> pending;
+};
+
+OffloadQueue& offload_queue() {
+  static OffloadQueue queue;
+  return queue;
+}
+
+} // namespace
+
+bool SavedTensorOffload::enabled() {
+  return offload_enabled;
+}
+
+void SavedTensorOffload::set_enabled(bool enabled) {
+  offload_enabled = enabled;
+}
+
+size_t SavedTensorOffload::min_bytes() {
+  return offload_min_bytes.load();
+}
+
+void SavedTensorOffload::set_min_bytes(size_t min_bytes) {
+  offload_min_bytes.store(min_bytes);
+}
+
+void SavedTensorOffload::prefetch_ahead() {
+  std::vector<std::shared_ptr<SavedTensorOffloadState>> to_start;
+  {
+    std::lock_guard<std::mutex> lock(offload_queue().mutex);
+    auto& pending = offload_queue().pending;
+    while (!pending.empty() && to_start.size() < kOffloadPrefetchWindow) {
+      auto state = pending.back().lock();
+      pending.pop_back();
+      if (state == nullptr) {
+        // The SavedVariable is gone (backward already consumed and released
+        // it, or the graph was dropped); nothing to bring back.
+        continue;
+      }
+      to_start.push_back(std::move(state));
+    }
+  }
+  // Issue the copies outside the queue lock; start_prefetch_locked is
+  // idempotent, so racing with an unpack() of the same tensor is fine.
+  for (auto& state : to_start) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->start_prefetch_locked();
+  }
+}
+
+void SavedVariable::maybe_offload_to_host() {
+  if (!data_.defined() || !data_.device().is_cuda() || data_.is_sparse() ||
+      !data_.is_contiguous()) {
+    return;
+  }
+  const size_t nbytes = data_.numel() * data_.element_size();
+  if (nbytes < SavedTensorOffload::min_bytes()) {
+    return;
+  }
+  auto state = std::make_shared<SavedTensorOffloadState>();
+  state->device = data_.device();
+  state->device_options = data_.options();
+  c10::DeviceGuard device_guard(state->device);
+  const c10::impl::VirtualGuardImpl impl(state->device.type());
+  auto host = at::empty(
+      data_.sizes(), data_.options().device(at::kCPU).pinned_memory(true));
+  host.copy_(data_, /*non_blocking=*/true);
+  state->offload_event = c10::Event(state->device.type());
+  state->offload_event->record(impl.getStream(state->device));
+  state->host = host;
+  // From here on the graph holds only the pinned copy; the device tensor's
+  // lifetime is back in the hands of the forward pass. The copy was enqueued
+  // on the producing stream, so the caching allocator can reuse the device
+  // memory without further synchronization.
+  data_ = std::move(host);
+  {
+    std::lock_guard<std::mutex> lock(offload_queue().mutex);
+    offload_queue().pending.push_back(state);
+  }
+  offload_state_ = std::move(state);
+}
+
 SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_inplace_view) {
   if (variable.defined()) {
     was_default_constructed_ = false;
@@ -33,6 +180,9 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_i
     }
     version_counter_ = impl::version_counter(variable);
     saved_version_ = version_counter_.current_version();
+    if (SavedTensorOffload::enabled()) {
+      maybe_offload_to_host();
+    }
   }
 }
 
@@ -78,14 +228,18 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
     throw std::runtime_error(message.str());
   }
 
+  // See Note [Saved tensor host offload]: if the data was spilled to host,
+  // hand out the (prefetched) device copy instead of the pinned buffer.
+  auto data = offload_state_ ? offload_state_->fetch() : data_;
+
   // NB: saved views are unpacked as normal Variables (not views) even though
   // they still share the same storage. This works only because we never call
   // in-place functions on unpacked variables.
   Variable var;
   if (grad_fn) {
-    var = make_variable(data_, Edge(std::move(grad_fn), output_nr_));
+    var = make_variable(data, Edge(std::move(grad_fn), output_nr_));
   } else {
-    var = make_variable(data_, requires_grad_);
+    var = make_variable(data, requires_grad_);
   }
   impl::set_version_counter(var, saved_version_);
 
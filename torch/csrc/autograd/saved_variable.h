@@ -14,6 +14,41 @@ struct Node;
 
 TORCH_API extern const char* ERR_BACKWARD_TWICE;
 
+struct SavedTensorOffloadState;
+
+// Note [Saved tensor host offload]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Large-model training is frequently bound by device memory held in saved
+// activations, not by compute. When offload is enabled (thread-local, so it
+// can be scoped around the memory-hungry part of forward), every
+// SavedVariable built around a dense, contiguous CUDA tensor of at least
+// min_bytes() asynchronously copies it into a pinned host buffer and drops
+// its reference to the device tensor, so the activation's device memory is
+// freed as soon as the forward pass lets go of it. During backward the engine
+// calls prefetch_ahead() before running each node (see call_function in
+// engine.cpp), which starts copying the most recently saved still-resident
+// tensors back to their device -- backward consumes saved tensors in roughly
+// reverse save order, so these are the ones needed next. unpack() hands out
+// the prefetched device copy after making the consuming stream wait on the
+// copy; if the prefetch hadn't started yet it is issued on the spot. The
+// generic c10 device interface has no stream pool, so the copies are enqueued
+// on the device's current stream, ordered ahead of the consuming node's
+// kernels; they still overlap with host-side work and with compute on other
+// streams.
+struct TORCH_API SavedTensorOffload {
+  // Thread-local. Enable around the forward region whose activations should
+  // be spilled to host memory.
+  static bool enabled();
+  static void set_enabled(bool enabled);
+  // Tensors smaller than this are never offloaded (default 1 MB); the PCIe
+  // round trip isn't worth it for small tensors.
+  static size_t min_bytes();
+  static void set_min_bytes(size_t min_bytes);
+  // Engine hook: starts copying the next few offloaded tensors back to their
+  // device. Safe to call from any thread; cheap when nothing is offloaded.
+  static void prefetch_ahead();
+};
+
 /// A snapshot of a variable at a certain version. A `SavedVariable` stores
 /// enough information to reconstruct a variable from a certain point in time.
 class TORCH_API SavedVariable {
@@ -29,6 +64,7 @@ class TORCH_API SavedVariable {
   Variable unpack(std::shared_ptr<Node> saved_for = nullptr) const;
 
   void reset_data() {
+    offload_state_.reset();
     return data_.reset();
   }
 
@@ -39,6 +75,14 @@ class TORCH_API SavedVariable {
  private:
   at::Tensor data_;
 
+  // See Note [Saved tensor host offload]. Non-null iff data_ holds the
+  // pinned host copy of an offloaded device tensor.
+  std::shared_ptr<SavedTensorOffloadState> offload_state_;
+
+  // Spills data_ to a pinned host buffer if offload is enabled and the
+  // tensor is eligible. Called from the constructor.
+  void maybe_offload_to_host();
+
   // The gradient function associated with this node. If has_grad_fn
   // is false, then this is a leaf node. Note that the grad_fn is not saved if
   // it would create a circular reference. In that case, the grad_fn must be
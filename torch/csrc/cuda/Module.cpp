@@ -364,6 +364,7 @@ PyObject * THCPModule_memorySnapshot(PyObject *_unused, PyObject *noargs)
     py::dict segmentDict;
     segmentDict["device"] = segmentInfo.device;
     segmentDict["address"] = segmentInfo.address;
+    segmentDict["stream"] = segmentInfo.stream;
     segmentDict["total_size"] = segmentInfo.total_size;
     segmentDict["allocated_size"] = segmentInfo.allocated_size;
     segmentDict["active_size"] = segmentInfo.active_size;
@@ -392,6 +393,27 @@ PyObject * THCPModule_memorySnapshot(PyObject *_unused, PyObject *noargs)
   END_HANDLE_TH_ERRORS
 }
 
+PyObject * THCPModule_allocationFailureHistory(PyObject *_unused, PyObject *noargs)
+{
+  HANDLE_TH_ERRORS
+
+  using c10::cuda::CUDACachingAllocator::AllocFailureInfo;
+
+  py::list result;
+  for (const AllocFailureInfo& info : c10::cuda::CUDACachingAllocator::allocationFailureHistory()) {
+    py::dict failureDict;
+    failureDict["device"] = info.device;
+    failureDict["size"] = info.size;
+    failureDict["stream"] = info.stream;
+    failureDict["free_bytes"] = info.free_bytes;
+    failureDict["oom"] = info.oom;
+    result.append(failureDict);
+  }
+
+  return result.release().ptr();
+  END_HANDLE_TH_ERRORS
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Cuda module initialization
 ////////////////////////////////////////////////////////////////////////////////
@@ -503,6 +525,7 @@ static struct PyMethodDef _THCPModule_methods[] = {
   {"_cuda_resetAccumulatedMemoryStats", (PyCFunction) THCPModule_resetAccumulatedMemoryStats, METH_O, nullptr},
   {"_cuda_resetPeakMemoryStats", (PyCFunction) THCPModule_resetPeakMemoryStats, METH_O,  nullptr},
   {"_cuda_memorySnapshot", (PyCFunction) THCPModule_memorySnapshot, METH_NOARGS, nullptr},
+  {"_cuda_allocationFailureHistory", (PyCFunction) THCPModule_allocationFailureHistory, METH_NOARGS, nullptr},
   {"_cuda_cudaHostAllocator", (PyCFunction)THCPModule_cudaHostAllocator, METH_NOARGS, nullptr},
   {"_cuda_cudaCachingAllocator_raw_alloc", (PyCFunction)THCPModule_cudaCachingAllocator_raw_alloc, METH_VARARGS, nullptr},
   {"_cuda_cudaCachingAllocator_raw_delete", (PyCFunction)THCPModule_cudaCachingAllocator_raw_delete, METH_O, nullptr},
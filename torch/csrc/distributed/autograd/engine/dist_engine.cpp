@@ -182,6 +182,11 @@ void DistEngine::computeDependencies(
     graphTask->init_to_execute(dummyRoot, outputEdges);
 
     // Mark all 'RecvRPCBackward' as needing execution.
+    //
+    // NB: these functions carry the maximum sequence number (see
+    // RecvRpcBackward), so once their gradients are ready the engine pops
+    // them ahead of other ready local work and the cross-worker sends
+    // overlap with the rest of the backward pass.
     for (const auto& recvBackwardEdge : recvBackwardEdges) {
       graphTask->exec_info_[recvBackwardEdge.function.get()].needed_ = true;
     }
@@ -1,3 +1,5 @@
+#include <limits>
+
 #include <torch/csrc/distributed/autograd/functions/recvrpc_backward.h>
 #include <ATen/core/functional.h>
 #include <torch/csrc/distributed/autograd/rpc_messages/propagate_gradients_req.h>
@@ -14,7 +16,11 @@ RecvRpcBackward::RecvRpcBackward(
     const AutogradMetadata& autogradMetadata,
     ContextPtr autogradContext,
     rpc::worker_id_t fromWorkerId)
-    : autogradMetadata_(autogradMetadata),
+    // The maximum sequence number makes the ready queue run this node ahead
+    // of any local compute that is ready at the same time, so the gradient
+    // send overlaps with the rest of the backward pass (see the class doc).
+    : torch::autograd::Node(std::numeric_limits<uint64_t>::max()),
+      autogradMetadata_(autogradMetadata),
       autogradContext_(std::move(autogradContext)),
       fromWorkerId_(fromWorkerId) {}
 
@@ -17,6 +17,12 @@ class DistAutogradContext;
 // autograd graph. This is more or less a placeholder function that is used to
 // pass gradients to the remote host during the backward pass. The inputs to the
 // RPC function are the inputs to this autograd function.
+//
+// Running this function puts gradients on the wire, so it is constructed with
+// the maximum sequence number: the engine's ready queue pops higher sequence
+// numbers first, which starts the (asynchronous) network transfer as soon as
+// the gradients are ready and overlaps it with the remaining local backward
+// pass, instead of letting cross-worker traffic bunch up at the end.
 class TORCH_API RecvRpcBackward : public torch::autograd::Node {
  public:
   explicit RecvRpcBackward(
@@ -6,6 +6,12 @@
 #include <torch/csrc/distributed/c10d/reducer.h>
 #include <torch/csrc/utils/tensor_flatten.h>
 
+#ifdef USE_CUDA
+#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAGuard.h>
+#endif
+
 namespace c10d {
 namespace {
 
@@ -14,11 +20,58 @@ class BroadcastWork {
   BroadcastWork(
       const std::shared_ptr<c10d::ProcessGroup>& process_group,
       std::vector<at::Tensor> bucket_tensors)
-      : bucket_tensors_(std::move(bucket_tensors)),
-        flat_tensor_({torch::utils::flatten_dense_tensors(bucket_tensors_)}),
-        work_(process_group->broadcast(flat_tensor_)) {}
+      : bucket_tensors_(std::move(bucket_tensors)) {
+#ifdef USE_CUDA
+    if (bucket_tensors_.front().is_cuda()) {
+      // Flatten on a side stream so that the gather copies for this bucket
+      // overlap with the in-flight broadcast of the previous bucket. With a
+      // single stream, every flatten/unflatten pass would serialize against
+      // the network, adding a full extra pass over the model bytes.
+      const auto device = bucket_tensors_.front().device();
+      at::cuda::CUDAEvent event;
+      event.record(at::cuda::getCurrentCUDAStream(device.index()));
+      copyStream_ = at::cuda::getStreamFromPool(false, device.index());
+      // The copy stream must not touch the bucket tensors until all pending
+      // ops that produced them on the current stream have finished.
+      event.block(*copyStream_);
+      // The bucket tensors were allocated on the current stream and are used
+      // on the copy stream. Record the copy stream to prevent them from being
+      // freed before their copy stream ops finish.
+      for (auto& tensor : bucket_tensors_) {
+        c10::cuda::CUDACachingAllocator::recordStream(
+            tensor.storage().data_ptr(), *copyStream_);
+      }
+      at::cuda::CUDAStreamGuard guard(*copyStream_);
+      flat_tensor_ = {torch::utils::flatten_dense_tensors(bucket_tensors_)};
+      work_ = process_group->broadcast(flat_tensor_);
+      return;
+    }
+#endif
+    flat_tensor_ = {torch::utils::flatten_dense_tensors(bucket_tensors_)};
+    work_ = process_group->broadcast(flat_tensor_);
+  }
 
   void finish() {
+#ifdef USE_CUDA
+    if (copyStream_) {
+      // Scatter back on the same side stream, so that the copies for this
+      // bucket run concurrently with the broadcast of the next one.
+      at::cuda::CUDAStreamGuard guard(*copyStream_);
+      work_->wait();
+      auto output_tensors = torch::utils::unflatten_dense_tensors(
+          flat_tensor_.front(), bucket_tensors_);
+      TORCH_INTERNAL_ASSERT(output_tensors.size() == bucket_tensors_.size());
+      for (size_t i = 0; i < output_tensors.size(); i++) {
+        bucket_tensors_[i].copy_(output_tensors[i], /*non_blocking=*/true);
+      }
+      // Let the caller's stream wait for the copies, so that subsequent work
+      // on the bucket tensors is ordered after the scatter.
+      at::cuda::CUDAEvent event;
+      event.record(*copyStream_);
+      event.block(guard.original_stream());
+      return;
+    }
+#endif
     work_->wait();
 
     // Copy the output of the broadcast operation back.
@@ -42,6 +95,12 @@ class BroadcastWork {
 
   // The broadcast work that is kicked off upon construction.
   std::shared_ptr<c10d::ProcessGroup::Work> work_;
+
+#ifdef USE_CUDA
+  // Side stream used to flatten and scatter CUDA buckets, so the copies for
+  // one bucket overlap with the broadcast of another. Unset for CPU buckets.
+  c10::optional<at::cuda::CUDAStream> copyStream_;
+#endif
 };
 
 } // namespace
@@ -3,6 +3,7 @@
 #include <c10d/FileStore.hpp>
 #include <c10d/HashStore.hpp>
 #include <c10d/ProcessGroup.hpp>
+#include <c10d/ShmStore.hpp>
 
 #ifdef USE_C10D_GLOO
 #include <c10d/ProcessGroupGloo.hpp>
@@ -122,11 +123,13 @@ PyObject* c10d_init(PyObject* _unused) {
               std::vector<std::vector<torch::autograd::Variable>>,
               std::vector<std::vector<size_t>>,
               std::shared_ptr<::c10d::ProcessGroup>,
-              std::vector<std::vector<bool>>>(),
+              std::vector<std::vector<bool>>,
+              bool>(),
           py::arg("replicas"),
           py::arg("bucket_indices"),
           py::arg("process_group"),
-          py::arg("expect_sparse_gradients") = std::vector<std::vector<bool>>())
+          py::arg("expect_sparse_gradients") = std::vector<std::vector<bool>>(),
+          py::arg("gradient_as_bucket_view") = false)
       .def(
           "initialize_buckets",
           &::c10d::Reducer::initialize_buckets,
@@ -140,7 +143,11 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
-      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
+      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats)
+      .def(
+          "register_builtin_comm_hook",
+          &::c10d::Reducer::register_builtin_comm_hook,
+          py::call_guard<py::gil_scoped_release>());
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
 An enum-like class for available reduction operations: ``SUM``, ``PRODUCT``,
@@ -262,6 +269,13 @@ They are used in specifying strategies for reduction collectives, e.g.,
   shared_ptr_class_<::c10d::HashStore>(module, "HashStore", store)
       .def(py::init<>());
 
+  shared_ptr_class_<::c10d::ShmStore>(module, "ShmStore", store)
+      .def(
+          py::init<const std::string&, int, size_t>(),
+          py::arg("name"),
+          py::arg("world_size"),
+          py::arg("size") = ::c10d::ShmStore::kDefaultSize);
+
   shared_ptr_class_<::c10d::TCPStore>(module, "TCPStore", store)
       .def(
           py::init<
@@ -541,7 +555,29 @@ They are used in specifying strategies for reduction collectives, e.g.,
               "barrier",
               &::c10d::ProcessGroup::barrier,
               py::arg("opts") = ::c10d::BarrierOptions(),
-              py::call_guard<py::gil_scoped_release>());
+              py::call_guard<py::gil_scoped_release>())
+
+          .def(
+              "_get_collective_metrics",
+              [](::c10d::ProcessGroup& pg) {
+                py::dict result;
+                for (const auto& kv : pg.getCollectiveMetrics()) {
+                  const auto& e = kv.second;
+                  py::dict entry;
+                  entry["count"] = e.count;
+                  entry["total_bytes"] = e.total_bytes;
+                  entry["total_ms"] = e.total_ms;
+                  entry["min_ms"] = e.min_ms;
+                  entry["max_ms"] = e.max_ms;
+                  entry["latency_histogram"] = e.latency_histogram;
+                  result[py::str(kv.first)] = entry;
+                }
+                return result;
+              })
+
+          .def(
+              "_reset_collective_metrics",
+              &::c10d::ProcessGroup::resetCollectiveMetrics);
 
   module.def(
       "_round_robin_process_groups",
@@ -633,12 +669,14 @@ They are used in specifying strategies for reduction collectives, e.g.,
               const std::shared_ptr<::c10d::Store>&,
               int,
               int,
-              const std::chrono::milliseconds&>(),
+              const std::chrono::milliseconds&,
+              bool>(),
           py::arg("store"),
           py::arg("rank"),
           py::arg("size"),
           py::arg("timeout") = std::chrono::milliseconds(
-              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis));
+              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis),
+          py::arg("is_high_priority_stream") = false);
 #endif
 
 #ifdef USE_C10D_MPI
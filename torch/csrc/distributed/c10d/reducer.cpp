@@ -1,6 +1,9 @@
 #include <torch/csrc/distributed/c10d/reducer.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <numeric>
 
 #include <c10/core/DeviceGuard.h>
 #include <c10/util/Exception.h>
@@ -37,22 +40,74 @@ inline int64_t current_time_in_nanos() {
   return torch::autograd::profiler::getTime();
 }
 
+// Number of iterations over which gradient-ready times are measured before
+// buckets are rebuilt, see Note [Adaptive gradient buckets].
+constexpr size_t kBucketRebuildIterations = 3;
+
+bool adaptive_buckets_enabled() {
+  const char* enabled = std::getenv("TORCH_DDP_REBUILD_BUCKETS");
+  return enabled == nullptr || std::string(enabled) != "0";
+}
+
 } // namespace
 
+at::Tensor Fp16CompressHook::compress(
+    size_t bucket_index,
+    size_t replica_index,
+    const at::Tensor& contents) {
+  // Only fp32 buckets are compressed; everything else passes through.
+  if (contents.scalar_type() != at::kFloat) {
+    return contents;
+  }
+  const uint64_t key =
+      (static_cast<uint64_t>(bucket_index) << 32) | replica_index;
+  auto& residual = residuals_[key];
+  if (!residual.defined()) {
+    residual = at::zeros_like(contents);
+  }
+  // Error feedback: add back what the previous iteration's quantization
+  // dropped, and remember what this iteration's quantization drops.
+  auto corrected = contents.add(residual);
+  auto compressed = corrected.to(at::kHalf);
+  residual.copy_(corrected).sub_(compressed.to(at::kFloat));
+  return compressed;
+}
+
+void Fp16CompressHook::decompress(
+    size_t /* bucket_index */,
+    size_t /* replica_index */,
+    const at::Tensor& reduced,
+    at::Tensor& contents) {
+  if (reduced.is_same(contents)) {
+    // The bucket was passed through uncompressed and reduced in place.
+    return;
+  }
+  contents.copy_(reduced);
+}
+
+void Fp16CompressHook::reset() {
+  residuals_.clear();
+}
+
 Reducer::Reducer(
     std::vector<std::vector<torch::autograd::Variable>> replicas,
     std::vector<std::vector<size_t>> bucket_indices,
     std::shared_ptr<c10d::ProcessGroup> process_group,
-    std::vector<std::vector<bool>> expect_sparse_gradients)
+    std::vector<std::vector<bool>> expect_sparse_gradients,
+    bool gradient_as_bucket_view)
     : replicas_(std::move(replicas)),
       process_group_(std::move(process_group)),
       expect_sparse_gradients_(std::move(expect_sparse_gradients)),
+      gradient_as_bucket_view_(gradient_as_bucket_view),
       expect_autograd_hooks_(false),
       require_finalize_(false),
       next_bucket_(0),
       has_marked_unused_parameters_(false),
       local_used_maps_reduced_(false),
-      backward_stats_base_(0) {
+      backward_stats_base_(0),
+      rebuild_buckets_enabled_(adaptive_buckets_enabled()),
+      buckets_rebuilt_(false),
+      observed_iterations_(0) {
   C10_LOG_API_USAGE_ONCE("torch.distributed.ddp.reducer");
 
   TORCH_CHECK(replicas_.size() >= 1, "Expected at least one model replica.");
@@ -162,6 +217,8 @@ Reducer::Reducer(
         backward_stats_.begin(),
         backward_stats_.end(),
         [=](std::vector<int64_t>& v) { v.resize(variable_count); });
+    // Summed ready times over the first iterations, used to rebuild buckets.
+    accumulated_ready_times_.resize(variable_count);
   }
 
   // Initialize locally used parameter maps
@@ -232,14 +289,26 @@ void Reducer::mark_variable_ready_dense(VariableIndex index) {
         bucket_view.toString(),
         ", got ",
         grad.toString());
-    // Assert that the grad tensor and the bucket don't share storage.
-    // If they did, we could avoid the copy altogether.
-    // The reason for not doing this is that existing code calls
-    // `detach_` from `zero_grad`, which is incompatible with views.
-    TORCH_INTERNAL_ASSERT(!grad.is_alias_of(bucket_view));
     TORCH_INTERNAL_ASSERT(grad.device() == bucket_view.device());
     TORCH_INTERNAL_ASSERT(grad.numel() == bucket_view.numel());
-    bucket_view.copy_(grad.view({-1}), /* non_blocking */ true);
+    if (gradient_as_bucket_view_ && grad.is_alias_of(bucket_view)) {
+      // The backward pass wrote into the bucket directly through the
+      // gradient view; there is nothing to copy.
+    } else {
+      // Assert that the grad tensor and the bucket don't share storage.
+      // If they did, we could avoid the copy altogether.
+      // The reason for not doing this by default is that existing code
+      // calls `detach_` from `zero_grad`, which is incompatible with
+      // views; opt in with gradient-as-bucket-view.
+      TORCH_INTERNAL_ASSERT(!grad.is_alias_of(bucket_view));
+      bucket_view.copy_(grad.view({-1}), /* non_blocking */ true);
+      if (gradient_as_bucket_view_) {
+        // The gradient was detached from the bucket (e.g. the application
+        // assigned a fresh tensor to `.grad`). Point it back at the bucket
+        // so the next backward pass writes in place again.
+        grad = bucket_view.view(variable.sizes());
+      }
+    }
   } else {
     bucket_view.zero_();
   }
@@ -408,9 +477,13 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
   for (; next_bucket_ < buckets_.size() && buckets_[next_bucket_].pending == 0;
        next_bucket_++) {
     auto& bucket = buckets_[next_bucket_];
+    const bool use_comm_hook =
+        comm_hook_ != nullptr && !bucket.expect_sparse_gradient;
     std::vector<at::Tensor> tensors;
     tensors.reserve(bucket.replicas.size());
-    for (const auto& replica : bucket.replicas) {
+    for (size_t replica_index = 0; replica_index < bucket.replicas.size();
+         replica_index++) {
+      const auto& replica = bucket.replicas[replica_index];
       // TODO(@pietern): Ensure proper synchronization with the CUDA events
       // that recorded copies into this contents tensor. If these copies are
       // executed on non-default streams, the current stream for the device
@@ -420,7 +493,17 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
       // these operations are implicitly sequenced, and we don't need to
       // do any extra synchronization here.
       //
-      tensors.push_back(replica.contents);
+      if (use_comm_hook) {
+        tensors.push_back(comm_hook_->compress(
+            next_bucket_, replica_index, replica.contents));
+      } else {
+        tensors.push_back(replica.contents);
+      }
+    }
+    if (use_comm_hook) {
+      // Hold on to the compressed tensors; the reduced values are copied
+      // back into the bucket contents in `finalize_backward`.
+      bucket.hook_tensors = tensors;
     }
     bucket.work = process_group_->allreduce(tensors);
   }
@@ -429,7 +512,10 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
 void Reducer::initialize_buckets(
     std::vector<std::vector<size_t>> bucket_indices) {
   std::lock_guard<std::mutex> lock(mutex_);
+  assign_buckets(std::move(bucket_indices));
+}
 
+void Reducer::assign_buckets(std::vector<std::vector<size_t>> bucket_indices) {
   // This shouldn't be called if we're expecting autograd hooks to fire.
   TORCH_CHECK(
       !expect_autograd_hooks_,
@@ -439,6 +525,12 @@ void Reducer::initialize_buckets(
   buckets_.clear();
   variable_locators_.clear();
 
+  // Per-bucket comm hook state (e.g. error-feedback residuals) no longer
+  // lines up with the new assignment.
+  if (comm_hook_ != nullptr) {
+    comm_hook_->reset();
+  }
+
   // Ensure we have a bucket index for every variable.
   variable_locators_.resize(replicas_[0].size());
 
@@ -512,6 +604,24 @@ void Reducer::initialize_buckets(
 
         // Allocate bucket contents tensor.
         replica.contents = at::empty({static_cast<long>(offset)}, options);
+
+        // With gradient-as-bucket-view, gradients are views into the flat
+        // bucket from the start, so backward writes land directly in the
+        // communication buffer. Any existing gradient (e.g. when buckets
+        // are rebuilt between iterations) is carried over into its view.
+        if (gradient_as_bucket_view_) {
+          for (size_t i = 0; i < replica.variables.size(); i++) {
+            auto& variable = replica.variables[i];
+            auto bucket_view =
+                replica.contents.narrow(0, replica.offsets[i], replica.lengths[i])
+                    .view(variable.sizes());
+            auto& grad = variable.grad();
+            if (grad.defined()) {
+              bucket_view.copy_(grad);
+            }
+            grad = bucket_view;
+          }
+        }
       }
 
       // Add bucket replica to enclosing bucket.
@@ -536,6 +646,25 @@ void Reducer::initialize_buckets(
   }
 }
 
+void Reducer::register_comm_hook(std::unique_ptr<BucketCommHook> hook) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_CHECK(
+      !expect_autograd_hooks_,
+      "A communication hook must be registered before a backward pass.");
+  TORCH_CHECK(
+      comm_hook_ == nullptr,
+      "A communication hook has already been registered.");
+  comm_hook_ = std::move(hook);
+}
+
+void Reducer::register_builtin_comm_hook(const std::string& name) {
+  if (name == "fp16_compress") {
+    register_comm_hook(torch::make_unique<Fp16CompressHook>());
+  } else {
+    TORCH_CHECK(false, "Unknown builtin communication hook: ", name);
+  }
+}
+
 // Traverse the autograd graph starting at the specified output.
 // All parameters for which we have a pointer to their gradient accumulation
 // functions, but don't show up in the autograd graph will be marked ready for
@@ -682,9 +811,20 @@ void Reducer::finalize_bucket_dense(Bucket& bucket) {
       // If a parameter is globally unused, we keep its grad untouched.
       if (!global_unused) {
         if (!grad.defined()) {
-          grad = at::empty(bucket_view.sizes(), bucket_view.options());
+          if (gradient_as_bucket_view_) {
+            // The reduced results already live in the bucket; hand the
+            // variable a view so the next backward accumulates in place.
+            grad = bucket_view;
+          } else {
+            grad = at::empty(bucket_view.sizes(), bucket_view.options());
+            grad.copy_(bucket_view);
+          }
+        } else if (gradient_as_bucket_view_ && grad.is_alias_of(bucket_view)) {
+          // The gradient is a view into the bucket, so the reduced results
+          // are already in place and the copy-out disappears.
+        } else {
+          grad.copy_(bucket_view);
         }
-        grad.copy_(bucket_view);
       }
     }
   }
@@ -716,12 +856,26 @@ void Reducer::finalize_backward() {
   TORCH_INTERNAL_ASSERT(next_bucket_ == buckets_.size());
 
   // Wait for asynchronous reduction to complete and unflatten contents.
-  for (auto& bucket : buckets_) {
+  for (size_t bucket_index = 0; bucket_index < buckets_.size();
+       bucket_index++) {
+    auto& bucket = buckets_[bucket_index];
     TORCH_INTERNAL_ASSERT(bucket.work);
     bucket.work->wait();
     if (bucket.expect_sparse_gradient) {
       finalize_bucket_sparse(bucket);
     } else {
+      if (comm_hook_ != nullptr && !bucket.hook_tensors.empty()) {
+        for (size_t replica_index = 0;
+             replica_index < bucket.replicas.size();
+             replica_index++) {
+          comm_hook_->decompress(
+              bucket_index,
+              replica_index,
+              bucket.hook_tensors[replica_index],
+              bucket.replicas[replica_index].contents);
+        }
+        bucket.hook_tensors.clear();
+      }
       finalize_bucket_dense(bucket);
     }
   }
@@ -740,6 +894,17 @@ void Reducer::finalize_backward() {
     local_used_work_->wait();
   }
   local_used_maps_reduced_ = false;
+
+  // See Note [Adaptive gradient buckets].
+  if (rebuild_buckets_enabled_ && !buckets_rebuilt_) {
+    for (size_t i = 0; i < backward_stats_[0].size(); i++) {
+      accumulated_ready_times_[i] += backward_stats_[0][i];
+    }
+    if (++observed_iterations_ >= kBucketRebuildIterations) {
+      buckets_rebuilt_ = true;
+      rebuild_buckets();
+    }
+  }
 }
 
 namespace {
@@ -766,6 +931,122 @@ inline bool operator==(const BucketKey& lhs, const BucketKey& rhs) {
 
 } // namespace
 
+// Note [Adaptive gradient buckets]
+// The initial bucket assignment is computed from parameter sizes alone (see
+// compute_bucket_assignment_by_size), under the assumption that gradients
+// become ready in reverse parameter order. How well allreduce overlaps with
+// backward actually depends on per-layer backward timing, which varies by
+// model and hardware. The per-variable ready timestamps recorded in
+// `backward_stats_` over the first iterations give us the real order, so
+// after `kBucketRebuildIterations` we regroup variables by their summed
+// ready times, capped at the byte size of the largest initial bucket (which
+// preserves the construction-time bucket_cap_mb intent). Every process must
+// reduce identical buckets, and measured timings differ per process, so the
+// rebuilt assignment is broadcast from rank 0.
+void Reducer::rebuild_buckets() {
+  const auto variable_count = replicas_[0].size();
+
+  // Cap rebuilt buckets at the byte size of the largest current dense
+  // bucket. If there is none (all sparse), there is nothing to regroup.
+  size_t size_limit = 0;
+  for (const auto& bucket : buckets_) {
+    if (bucket.expect_sparse_gradient) {
+      continue;
+    }
+    const auto& contents = bucket.replicas[0].contents;
+    size_limit = std::max(
+        size_limit,
+        static_cast<size_t>(contents.numel() * contents.element_size()));
+  }
+  if (size_limit == 0) {
+    return;
+  }
+
+  // Order variables by the time their gradient became ready, summed over
+  // the observed iterations. Break ties by index to keep the sort
+  // deterministic.
+  std::vector<size_t> order(variable_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return std::tie(accumulated_ready_times_[a], a) <
+        std::tie(accumulated_ready_times_[b], b);
+  });
+
+  // Pack variables into buckets in ready order, subject to the same
+  // type/device constraints as compute_bucket_assignment_by_size. Variables
+  // with sparse gradients keep a bucket of their own. Bucket order now
+  // follows gradient production order, so reductions can be kicked off as
+  // early as possible.
+  struct BucketAccumulator {
+    std::vector<size_t> indices;
+    size_t size = 0;
+  };
+  std::unordered_map<BucketKey, BucketAccumulator, torch::hash<BucketKey>>
+      open_buckets;
+  std::vector<std::vector<size_t>> assignment;
+  for (const auto variable_index : order) {
+    const auto& tensor = replicas_[0][variable_index];
+    if (expect_sparse_gradients_[0][variable_index]) {
+      assignment.push_back({variable_index});
+      continue;
+    }
+    auto key = BucketKey(tensor.scalar_type(), tensor.device());
+    auto& bucket = open_buckets[key];
+    bucket.indices.push_back(variable_index);
+    bucket.size += tensor.numel() * tensor.element_size();
+    if (bucket.size >= size_limit) {
+      assignment.emplace_back(std::move(bucket.indices));
+      bucket = BucketAccumulator();
+    }
+  }
+  for (auto& it : open_buckets) {
+    if (!it.second.indices.empty()) {
+      assignment.emplace_back(std::move(it.second.indices));
+    }
+  }
+
+  // Broadcast rank 0's assignment so every process reduces identical
+  // buckets. Layout: [num_buckets, bucket sizes..., flattened indices...],
+  // at a fixed length so all ranks can post the broadcast without first
+  // exchanging sizes. The tensor lives on the replica device because some
+  // backends (e.g. NCCL) do not support CPU tensors.
+  const auto tensor_length = static_cast<long>(1 + 2 * variable_count);
+  auto indices_cpu =
+      at::zeros({tensor_length}, at::TensorOptions().dtype(at::kLong));
+  int64_t* data = indices_cpu.data_ptr<int64_t>();
+  data[0] = assignment.size();
+  size_t pos = 1;
+  for (const auto& bucket_indices : assignment) {
+    data[pos++] = bucket_indices.size();
+  }
+  for (const auto& bucket_indices : assignment) {
+    for (const auto variable_index : bucket_indices) {
+      data[pos++] = variable_index;
+    }
+  }
+  auto indices_comm = indices_cpu.to(replicas_[0][0].device());
+  std::vector<at::Tensor> broadcast_list = {indices_comm};
+  process_group_->broadcast(broadcast_list)->wait();
+  if (!indices_comm.is_same(indices_cpu)) {
+    indices_cpu.copy_(indices_comm);
+  }
+
+  const auto num_buckets = static_cast<size_t>(data[0]);
+  TORCH_INTERNAL_ASSERT(num_buckets <= variable_count);
+  std::vector<std::vector<size_t>> synced_assignment;
+  synced_assignment.reserve(num_buckets);
+  pos = 1 + num_buckets;
+  for (size_t i = 0; i < num_buckets; i++) {
+    std::vector<size_t> bucket_indices(static_cast<size_t>(data[1 + i]));
+    for (auto& variable_index : bucket_indices) {
+      variable_index = static_cast<size_t>(data[pos++]);
+    }
+    synced_assignment.emplace_back(std::move(bucket_indices));
+  }
+
+  assign_buckets(std::move(synced_assignment));
+}
+
 // This is equivalent to take_tensors but returns indices into the
 // tensor list argument for bucket assignment. Also, it is aware
 // of device placement and will not allow buckets to span devices.
@@ -13,17 +13,70 @@
 
 namespace c10d {
 
+// Transforms flattened dense bucket contents before they are handed to the
+// allreduce, and restores them once the reduction completes. Used for
+// gradient compression on bandwidth-bound links; see Fp16CompressHook.
+// Hooks run on the autograd thread, under the Reducer lock.
+struct BucketCommHook {
+  virtual ~BucketCommHook() = default;
+
+  // Returns the tensor to allreduce in place of `contents`. May return
+  // `contents` itself to pass a bucket through uncompressed.
+  virtual at::Tensor compress(
+      size_t bucket_index,
+      size_t replica_index,
+      const at::Tensor& contents) = 0;
+
+  // Writes the reduced tensor returned by `compress` back into `contents`.
+  virtual void decompress(
+      size_t bucket_index,
+      size_t replica_index,
+      const at::Tensor& reduced,
+      at::Tensor& contents) = 0;
+
+  // Called when the bucket assignment changes and per-bucket state
+  // (e.g. residuals) no longer lines up with bucket indices.
+  virtual void reset() {}
+};
+
+// Compresses fp32 buckets to fp16 on the wire, keeping an fp32
+// error-feedback residual per bucket so the quantization error is carried
+// into the next iteration instead of being dropped.
+class Fp16CompressHook : public BucketCommHook {
+ public:
+  at::Tensor compress(
+      size_t bucket_index,
+      size_t replica_index,
+      const at::Tensor& contents) override;
+  void decompress(
+      size_t bucket_index,
+      size_t replica_index,
+      const at::Tensor& reduced,
+      at::Tensor& contents) override;
+  void reset() override;
+
+ private:
+  // fp32 residuals keyed by (bucket index, replica index).
+  std::unordered_map<uint64_t, at::Tensor> residuals_;
+};
+
 class Reducer {
  public:
   // The constructor takes a list of variables for every model replica.
   // The bucket assignment for this reducer is specified as a list of
   // buckets, each of which is specified as a list of indices into the
   // variables list for **a single replica** (i.e. `variables[0]`).
+  // If `gradient_as_bucket_view` is true, parameter gradients are made views
+  // into the flat bucket buffers, so backward writes land directly in the
+  // communication buffers and the copy-out after reduction disappears.
+  // Callers must not `detach_` such gradients (e.g. via legacy zero_grad
+  // code), as that is incompatible with views.
   explicit Reducer(
       std::vector<std::vector<torch::autograd::Variable>> replicas,
       std::vector<std::vector<size_t>> bucket_indices,
       std::shared_ptr<c10d::ProcessGroup> process_group,
-      std::vector<std::vector<bool>> expect_sparse_gradients);
+      std::vector<std::vector<bool>> expect_sparse_gradients,
+      bool gradient_as_bucket_view = false);
 
   ~Reducer() noexcept(false);
 
@@ -47,6 +100,14 @@ class Reducer {
     return backward_stats_;
   }
 
+  // Installs a hook that transforms bucket contents before the allreduce.
+  // Must be called before any backward pass, and at most once.
+  void register_comm_hook(std::unique_ptr<BucketCommHook> hook);
+
+  // Installs one of the hooks defined in this file by name.
+  // Currently supported: "fp16_compress".
+  void register_builtin_comm_hook(const std::string& name);
+
  protected:
   // Forward declaration.
   struct Bucket;
@@ -61,6 +122,9 @@ class Reducer {
   std::vector<std::vector<torch::autograd::Variable>> replicas_;
   std::shared_ptr<c10d::ProcessGroup> process_group_;
   std::vector<std::vector<bool>> expect_sparse_gradients_;
+  // Whether dense gradients are kept as views into the bucket contents;
+  // see the constructor comment.
+  const bool gradient_as_bucket_view_;
 
   std::vector<std::vector<std::shared_ptr<torch::autograd::Node>>>
       grad_accumulators_;
@@ -108,6 +172,14 @@ class Reducer {
 
   void finalize_backward();
 
+  // Implementation of bucket (re)assignment. Callers must hold `mutex_`.
+  void assign_buckets(std::vector<std::vector<size_t>> bucket_indices);
+
+  // Regroups variables by measured gradient-ready order, see
+  // Note [Adaptive gradient buckets] in reducer.cpp. Called with `mutex_`
+  // held, from `finalize_backward`.
+  void rebuild_buckets();
+
   // A bucket replica represents [1..N] gradients to be reduced,
   // with the same dtype, on the same device.
   //
@@ -160,6 +232,10 @@ class Reducer {
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
 
+    // Tensors handed to the allreduce in place of the replica contents
+    // when a comm hook is installed. Cleared after decompression.
+    std::vector<at::Tensor> hook_tensors;
+
     // If this bucket should expect a single sparse gradient.
     // Implies: replicas[i].variables.size() == 1.
     bool expect_sparse_gradient = false;
@@ -186,6 +262,19 @@ class Reducer {
   // the point in time buckets were ready, or ideal bucket assignment/ordering.
   int64_t backward_stats_base_;
   std::vector<std::vector<int64_t>> backward_stats_;
+
+  // Adaptive bucket rebuilding: gradient-ready times are accumulated over
+  // the first iterations, after which variables are regrouped in the order
+  // their gradients actually become ready (see Note [Adaptive gradient
+  // buckets] in reducer.cpp). Disabled with TORCH_DDP_REBUILD_BUCKETS=0,
+  // which must be set consistently across all processes.
+  bool rebuild_buckets_enabled_;
+  bool buckets_rebuilt_;
+  size_t observed_iterations_;
+  std::vector<int64_t> accumulated_ready_times_;
+
+  // Optional transformation of bucket contents around the allreduce.
+  std::unique_ptr<BucketCommHook> comm_hook_;
 };
 
 std::vector<std::vector<size_t>> compute_bucket_assignment_by_size(
@@ -411,37 +411,82 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
 }
 
 void ProcessGroupAgent::handleSend(const SendWork& work) {
-  auto serializedPayload = std::make_unique<std::string>(std::move(
-      wireSerialize(work.message_.payload(), work.message_.tensors())));
+  // Serialize with the tensor storages left in place: every tensor data
+  // section is sent as its own chunk, directly from the tensor's DataPtr,
+  // instead of first being copied into one flat buffer.
+  auto wire = std::make_shared<WireChunkedData>(wireSerializeChunked(
+      work.message_.payload(), work.message_.tensors()));
+
+  int64_t totalSize = wire->header.size();
+  std::vector<int64_t> chunkSizes = {(int64_t)wire->header.size()};
+  for (size_t i = 0; i < wire->tensorData.size(); i++) {
+    totalSize += wire->tensorData[i].sizeInBytes() + wire->padding[i].size();
+    chunkSizes.push_back((int64_t)wire->tensorData[i].sizeInBytes());
+    chunkSizes.push_back((int64_t)wire->padding[i].size());
+  }
+  const int64_t numChunks = chunkSizes.size();
 
   std::vector<torch::Tensor> preamble = {torch::tensor(
       {(int64_t)pg_->getRank(),
-       (int64_t)serializedPayload->length(),
+       totalSize,
        (int64_t)work.message_.type(),
-       (int64_t)work.message_.id()},
+       (int64_t)work.message_.id(),
+       numChunks},
       {torch::kInt64})};
 
+  // The chunk tensors reference memory owned by `wire`; the deleter keeps
+  // it alive until the last chunk tensor (which the pending send work holds
+  // on to) is released.
+  auto keepWireAlive = [wire](void*) {};
+  std::vector<std::vector<torch::Tensor>> chunks;
+  chunks.reserve(numChunks);
+  chunks.push_back({torch::from_blob(
+      const_cast<char*>(wire->header.data()),
+      wire->header.size(),
+      keepWireAlive,
+      {torch::kChar})});
+  for (size_t i = 0; i < wire->tensorData.size(); i++) {
+    const auto& td = wire->tensorData[i];
+    // Zero-length sections carry no bytes; the receiver skips them too.
+    if (td.sizeInBytes() != 0) {
+      chunks.push_back({torch::from_blob(
+          const_cast<char*>(td.data()),
+          td.sizeInBytes(),
+          keepWireAlive,
+          {torch::kChar})});
+    }
+    // Alignment padding keeps the next section on a boundary the receiver
+    // can reference in place; see wireDeserializeInPlace().
+    const auto& pad = wire->padding[i];
+    if (!pad.empty()) {
+      chunks.push_back({torch::from_blob(
+          const_cast<char*>(pad.data()),
+          pad.size(),
+          keepWireAlive,
+          {torch::kChar})});
+    }
+  }
+
   // ProcessGroup is not thread-safe when sending with the same tag,
   // hence the lock
   std::vector<std::shared_ptr<c10d::ProcessGroup::Work>> pendingSends;
   const auto dst = work.to_.id_;
-
-  auto serializedPayloadData = const_cast<char*>(serializedPayload->data());
-  auto serializedPayloadSize = serializedPayload->size();
-  std::string* deleteWhenDone = serializedPayload.release();
-  std::vector<torch::Tensor> payload = {torch::from_blob(
-      reinterpret_cast<void*>(serializedPayloadData),
-      serializedPayloadSize,
-      [deleteWhenDone](void*) { delete deleteWhenDone; },
-      {torch::kChar})};
-  pendingSends.reserve(2);
+  pendingSends.reserve(2 + chunks.size());
 
   sendCounts_.increment(dst);
 
   {
     std::lock_guard<std::mutex> guard(sendMutexes_[dst]);
     pendingSends.emplace_back(pg_->send(preamble, dst, dst /* channelTag */));
-    pendingSends.emplace_back(pg_->send(payload, dst, dst /* channelTag */));
+    if (numChunks > 1) {
+      std::vector<torch::Tensor> sizesTensor = {
+          torch::tensor(chunkSizes, {torch::kInt64})};
+      pendingSends.emplace_back(
+          pg_->send(sizesTensor, dst, dst /* channelTag */));
+    }
+    for (auto& chunk : chunks) {
+      pendingSends.emplace_back(pg_->send(chunk, dst, dst /* channelTag */));
+    }
   }
   // Write pendingSends to a global map so that they can be interrupted by
   // ::shutdown().
@@ -499,7 +544,9 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
 
 bool ProcessGroupAgent::handleRecv(RecvWork& work) {
   torch::Tensor& payload = work.payload_;
-  auto data = wireDeserialize(payload.storage().data(), payload.numel());
+  // Tensors are created directly over the receive buffer when their sections
+  // are aligned, instead of being copied out of it.
+  auto data = wireDeserializeInPlace(payload);
   Message message(
       std::move(data.first), std::move(data.second), work.type_, work.id_);
   if (message.isRequest()) {
@@ -695,8 +742,8 @@ void ProcessGroupAgent::listenLoop() {
 
 void ProcessGroupAgent::listenLoopInternal() {
   while (rpcAgentRunning_.load()) {
-    // rank, tensor size, message type
-    std::vector<torch::Tensor> preamble = {torch::empty({4}, {torch::kInt64})};
+    // rank, total size, message type, id, number of chunks
+    std::vector<torch::Tensor> preamble = {torch::empty({5}, {torch::kInt64})};
     auto work = pg_->recvAnysource(preamble, pg_->getRank());
     {
       // Write class variable so it can be aborted by shutdown()
@@ -714,21 +761,53 @@ void ProcessGroupAgent::listenLoopInternal() {
     auto size = preamble_items[1];
     MessageType type = MessageType(preamble_items[2]);
     int64_t id = preamble_items[3];
+    auto numChunks = preamble_items[4];
+
+    // The sender transmits the serialized message as a list of chunks so
+    // that tensor data goes out straight from its storages; receive the
+    // chunks back-to-back into one flat buffer.
+    torch::Tensor buffer = torch::empty({size}, {torch::kChar});
+
+    std::vector<int64_t> chunkSizes = {size};
+    if (numChunks > 1) {
+      std::vector<torch::Tensor> sizesTensor = {
+          torch::empty({numChunks}, {torch::kInt64})};
+      work = pg_->recv(sizesTensor, srcRank, pg_->getRank());
+      {
+        // Write class variable so it can be aborted by shutdown()
+        std::lock_guard<std::mutex> guard(recvWorkMutex_);
+        recvWork_ = work;
+      }
 
-    std::vector<torch::Tensor> tensors = {torch::empty({size}, {torch::kChar})};
-    work = pg_->recv(tensors, srcRank, pg_->getRank());
-    {
-      // Write class variable so it can be aborted by shutdown()
-      std::lock_guard<std::mutex> guard(recvWorkMutex_);
-      recvWork_ = work;
+      if (!rpcAgentRunning_.load() || !work->wait() /* aborted */) {
+        return;
+      }
+
+      int64_t* sizesData = sizesTensor.front().storage().data<int64_t>();
+      chunkSizes.assign(sizesData, sizesData + numChunks);
     }
 
-    if (!rpcAgentRunning_.load() || !work->wait() /* aborted */) {
-      return;
+    int64_t offset = 0;
+    for (const auto chunkSize : chunkSizes) {
+      // Zero-length sections carry no bytes on the wire.
+      if (chunkSize == 0) {
+        continue;
+      }
+      std::vector<torch::Tensor> chunk = {buffer.narrow(0, offset, chunkSize)};
+      work = pg_->recv(chunk, srcRank, pg_->getRank());
+      {
+        // Write class variable so it can be aborted by shutdown()
+        std::lock_guard<std::mutex> guard(recvWorkMutex_);
+        recvWork_ = work;
+      }
+
+      if (!rpcAgentRunning_.load() || !work->wait() /* aborted */) {
+        return;
+      }
+      offset += chunkSize;
     }
 
-    enqueueRecv(
-        RecvWork(allWorkerInfo_[srcRank], type, id, std::move(tensors[0])));
+    enqueueRecv(RecvWork(allWorkerInfo_[srcRank], type, id, std::move(buffer)));
   }
 }
 
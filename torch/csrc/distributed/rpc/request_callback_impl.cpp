@@ -11,6 +11,7 @@
 #include <torch/csrc/distributed/autograd/rpc_messages/rpc_with_autograd.h>
 #include <torch/csrc/distributed/autograd/utils.h>
 #include <torch/csrc/distributed/rpc/python_call.h>
+#include <torch/csrc/distributed/rpc/python_functions.h>
 #include <torch/csrc/distributed/rpc/python_remote_call.h>
 #include <torch/csrc/distributed/rpc/python_resp.h>
 #include <torch/csrc/distributed/rpc/python_rpc_handler.h>
@@ -167,11 +168,72 @@ void RequestCallbackImpl::processRpc(
       auto& upc = static_cast<UnpickledPythonCall&>(rpc);
       auto& pythonRpcHandler = PythonRpcHandler::getInstance();
       std::shared_ptr<SerializedPyObj> serializedPyObj = nullptr;
+      c10::intrusive_ptr<c10::ivalue::Future> chainedJitFuture = nullptr;
+      std::shared_ptr<FutureMessage> chainedRpcFuture = nullptr;
       {
         pybind11::gil_scoped_acquire ag;
-        serializedPyObj =
-            std::make_shared<SerializedPyObj>(pythonRpcHandler.serialize(
-                pythonRpcHandler.runPythonUdf(std::move(upc).movePythonUdf())));
+        py::object result =
+            pythonRpcHandler.runPythonUdf(std::move(upc).movePythonUdf());
+        // A UDF may return a future instead of a value - the future of a
+        // nested TorchScript rpc_async or of a nested Python-UDF rpc_async.
+        // In that case, chain the response on the future below instead of
+        // serializing here, so this server thread is released while the
+        // nested work is pending; concurrency is then bounded by pending
+        // futures rather than by server threads.
+        if (py::isinstance<torch::jit::PythonFutureWrapper>(result)) {
+          chainedJitFuture = result.cast<torch::jit::PythonFutureWrapper&>().fut;
+        } else if (py::isinstance<FutureMessage>(result)) {
+          chainedRpcFuture = result.cast<std::shared_ptr<FutureMessage>>();
+        } else {
+          serializedPyObj = std::make_shared<SerializedPyObj>(
+              pythonRpcHandler.serialize(result));
+        }
+      }
+      if (chainedJitFuture) {
+        chainedJitFuture->addCallback(
+            [responseFuture, messageId, chainedJitFuture]() {
+              try {
+                py::object pyValue;
+                {
+                  pybind11::gil_scoped_acquire ag;
+                  pyValue = torch::jit::toPyObject(chainedJitFuture->value());
+                }
+                SerializedPyObj result =
+                    PythonRpcHandler::getInstance().serialize(pyValue);
+                Message m =
+                    std::move(PythonResp(std::move(result))).toMessage();
+                m.setId(messageId);
+                responseFuture->markCompleted(std::move(m));
+              } catch (const std::exception& e) {
+                responseFuture->setError(e.what());
+              }
+            });
+        return;
+      }
+      if (chainedRpcFuture) {
+        chainedRpcFuture->addCallback(
+            [responseFuture, messageId, chainedRpcFuture]() {
+              if (chainedRpcFuture->hasError()) {
+                responseFuture->setError(chainedRpcFuture->error()->what());
+                return;
+              }
+              try {
+                py::object pyValue;
+                {
+                  pybind11::gil_scoped_acquire ag;
+                  pyValue = toPyObj(chainedRpcFuture->constValue());
+                }
+                SerializedPyObj result =
+                    PythonRpcHandler::getInstance().serialize(pyValue);
+                Message m =
+                    std::move(PythonResp(std::move(result))).toMessage();
+                m.setId(messageId);
+                responseFuture->markCompleted(std::move(m));
+              } catch (const std::exception& e) {
+                responseFuture->setError(e.what());
+              }
+            });
+        return;
       }
       markComplete(
           std::move(PythonResp(std::move(*serializedPyObj))).toMessage());
@@ -275,14 +337,87 @@ void RequestCallbackImpl::processRpc(
 
       auto ownerRRef = ctx.getOrCreateOwnerRRef(rrefId, PyObjectType::get());
 
+      auto postProcessing = [rrefId, forkId, messageId, responseFuture]() {
+        if (rrefId != forkId) {
+          // Caller is a user and callee is the owner, add fork
+          //
+          // NB: rrefId == forkId is true if and only if calling remote to
+          // self. In that case both the caller and the callee will access
+          // the OwnerRRef. Hence, on the callee side (here), it should not
+          // call addForkOfOwner as it is not a fork. To allow callee to
+          // distinguish when this request is sent to self, the caller will
+          // set forkId using rrefId (OwnerRRef does not have a forkId
+          // anyway).
+          RRefContext::getInstance().addForkOfOwner(rrefId, forkId);
+        }
+        Message m = RemoteRet(rrefId, forkId).toMessage();
+        m.setId(messageId);
+        responseFuture->markCompleted(std::move(m));
+      };
+
       auto& pythonRpcHandler = PythonRpcHandler::getInstance();
       IValue py_ivalue;
+      c10::intrusive_ptr<c10::ivalue::Future> chainedJitFuture = nullptr;
+      std::shared_ptr<FutureMessage> chainedRpcFuture = nullptr;
       try {
         {
           pybind11::gil_scoped_acquire ag;
-          py_ivalue = jit::toIValue(
-              pythonRpcHandler.runPythonUdf(std::move(uprc).movePythonUdf()),
-              PyObjectType::get());
+          py::object result =
+              pythonRpcHandler.runPythonUdf(std::move(uprc).movePythonUdf());
+          // As in the PYTHON_CALL case above, a UDF returning a future frees
+          // this thread; the rref is fulfilled and RemoteRet sent from the
+          // future's continuation instead.
+          if (py::isinstance<torch::jit::PythonFutureWrapper>(result)) {
+            chainedJitFuture =
+                result.cast<torch::jit::PythonFutureWrapper&>().fut;
+          } else if (py::isinstance<FutureMessage>(result)) {
+            chainedRpcFuture = result.cast<std::shared_ptr<FutureMessage>>();
+          } else {
+            py_ivalue = jit::toIValue(result, PyObjectType::get());
+          }
+        }
+        if (chainedJitFuture) {
+          chainedJitFuture->addCallback(
+              [ownerRRef, postProcessing, chainedJitFuture]() {
+                try {
+                  IValue value;
+                  {
+                    pybind11::gil_scoped_acquire ag;
+                    value = jit::toIValue(
+                        torch::jit::toPyObject(chainedJitFuture->value()),
+                        PyObjectType::get());
+                  }
+                  ownerRRef->setValue(std::move(value));
+                } catch (const std::exception& e) {
+                  ownerRRef->setError(e.what());
+                }
+                postProcessing();
+              });
+          return;
+        }
+        if (chainedRpcFuture) {
+          chainedRpcFuture->addCallback(
+              [ownerRRef, postProcessing, chainedRpcFuture]() {
+                if (chainedRpcFuture->hasError()) {
+                  ownerRRef->setError(chainedRpcFuture->error()->what());
+                  postProcessing();
+                  return;
+                }
+                try {
+                  IValue value;
+                  {
+                    pybind11::gil_scoped_acquire ag;
+                    value = jit::toIValue(
+                        toPyObj(chainedRpcFuture->constValue()),
+                        PyObjectType::get());
+                  }
+                  ownerRRef->setValue(std::move(value));
+                } catch (const std::exception& e) {
+                  ownerRRef->setError(e.what());
+                }
+                postProcessing();
+              });
+          return;
         }
         ownerRRef->setValue(std::move(py_ivalue));
       } catch (py::error_already_set& e) {
@@ -295,18 +430,7 @@ void RequestCallbackImpl::processRpc(
         ownerRRef->setError(e.what());
       }
 
-      if (rrefId != forkId) {
-        // Caller is a user and callee is the owner, add fork
-        //
-        // NB: rrefId == forkId is true if and only if calling remote to self.
-        // In that case both the caller and the callee will access the
-        // OwnerRRef. Hence, on the callee side (here), it should not call
-        // addForkOfOwner as it is not a fork. To allow callee to distinguish
-        // when this request is sent to self, the caller will set forkId using
-        // rrefId (OwnerRRef does not have a forkId anyway).
-        ctx.addForkOfOwner(rrefId, forkId);
-      }
-      markComplete(RemoteRet(rrefId, forkId).toMessage());
+      postProcessing();
       return;
     }
     case MessageType::SCRIPT_RREF_FETCH_CALL: {
@@ -58,13 +58,15 @@ std::vector<c10::intrusive_ptr<RRef>> RRefContext::destroyInstance(
   }
   ctx.checkRRefLeaks(ignoreRRefLeak);
   std::vector<c10::intrusive_ptr<RRef>> deletedRRefs;
-  for (auto& entry : ctx.owners_) {
-    auto rref = entry.second;
-    if (rref->isPyObj()) {
-      deletedRRefs.emplace_back(std::move(rref));
+  for (auto& shard : ctx.shards_) {
+    for (auto& entry : shard.owners) {
+      auto rref = entry.second;
+      if (rref->isPyObj()) {
+        deletedRRefs.emplace_back(std::move(rref));
+      }
     }
+    shard.owners.clear();
   }
-  ctx.owners_.clear();
   return deletedRRefs;
 }
 
@@ -80,7 +82,11 @@ RRefContext::RRefContext(std::shared_ptr<RpcAgent> agent)
     : agent_(std::move(agent)), destroyed_(false) {}
 
 RRefContext::~RRefContext() {
-  if (!owners_.empty()) {
+  bool hasOwners = false;
+  for (auto& shard : shards_) {
+    hasOwners = hasOwners || !shard.owners.empty();
+  }
+  if (hasOwners) {
     VLOG(1) << "Destructing RRefContext with non-empty OwnerRRef set. "
             << "This would likely cause Python deref error. "
             << "Make sure destroyInstance() is invoked before destruction.";
@@ -90,13 +96,17 @@ RRefContext::~RRefContext() {
 std::unordered_map<std::string, std::string> RRefContext::getDebugInfo() {
   std::unordered_map<std::string, std::string> info;
   std::unique_lock<std::mutex> lock(mutex_);
-  auto ownerSize = owners_.size();
   auto numPendingUsers = pendingUsers_.size();
+  lock.unlock();
+  size_t ownerSize = 0;
   int numForks = 0;
-  for (const auto& owner : forks_) {
-    numForks += owner.second.size();
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
+    ownerSize += shard.owners.size();
+    for (const auto& owner : shard.forks) {
+      numForks += owner.second.size();
+    }
   }
-  lock.unlock();
   info[kNumOwnerRRefs] = c10::to_string(ownerSize);
   info[kNumPendingUsers] = c10::to_string(numPendingUsers);
   info[kNumForks] = c10::to_string(numForks);
@@ -104,16 +114,19 @@ std::unordered_map<std::string, std::string> RRefContext::getDebugInfo() {
 }
 
 void RRefContext::checkRRefLeaks(bool ignoreRRefLeak) {
-  if (!forks_.empty()) {
-    std::stringstream ss;
-    for (auto& entry : forks_) {
+  bool leaked = false;
+  std::stringstream ss;
+  for (auto& shard : shards_) {
+    for (auto& entry : shard.forks) {
       const RRefId& rrefId = entry.first;
       for (const auto& forkId : entry.second) {
+        leaked = true;
         ss << "Leaking RRef " << rrefId << " with fork Id " << forkId
            << std::endl;
       }
     }
-
+  }
+  if (leaked) {
     LOG(WARNING)
         << "Detected RRef Leaks during shutdown. This usually "
         << "occurs when the application code still holds references to RRef "
@@ -186,6 +199,15 @@ void RRefContext::delUser(
   confirmedUsers_.erase(forkId);
 }
 
+size_t RRefContext::numOwners() const {
+  size_t numOwners = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    numOwners += shard.owners.size();
+  }
+  return numOwners;
+}
+
 void RRefContext::delAllUsers(std::chrono::milliseconds timeoutMillis) {
   // First, wait for all pending UserRRefs to be confirmed,
   // one kind is pendingUsers_, which are shared from Owner,
@@ -221,7 +243,7 @@ void RRefContext::delAllUsers(std::chrono::milliseconds timeoutMillis) {
   {
     std::unique_lock<std::mutex> lock(mutex_);
     bool noOwner = deleteAllUsersCV_.wait_for(
-        lock, timeoutMillis, [this]() { return owners_.size() == 0; });
+        lock, timeoutMillis, [this]() { return numOwners() == 0; });
     if (!noOwner) {
       LOG(ERROR) << "Timed out waiting for pending OwnerRRefs to be deleted.";
     }
@@ -266,16 +288,17 @@ c10::intrusive_ptr<RRef> RRefContext::getOrCreateRRef(
 c10::intrusive_ptr<OwnerRRef> RRefContext::getOrCreateOwnerRRef(
     const RRefId& rrefId,
     const TypePtr& type) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  const auto iter = owners_.find(rrefId);
-  if (iter == owners_.end()) {
+  auto& shard = shardFor(rrefId);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  const auto iter = shard.owners.find(rrefId);
+  if (iter == shard.owners.end()) {
     // Scenario (1) the first time this owner knows about this RRef
     //
     // NB: cannot use make_shared here as the constructor of OwnerRRef is
     // private.
     auto rref = c10::make_intrusive<OwnerRRef>(getWorkerId(), rrefId, type);
-    owners_[rref->rrefId()] = rref;
-    ownerCV_.notify_all();
+    shard.owners[rref->rrefId()] = rref;
+    shard.ownerCV.notify_all();
     return rref;
   } else {
     // Scenario (2) retrieving an existing RRef
@@ -288,7 +311,7 @@ c10::intrusive_ptr<OwnerRRef> RRefContext::getOrCreateOwnerRRef(
 
 c10::intrusive_ptr<OwnerRRef> RRefContext::createOwnerRRef(
     const TypePtr& type) {
-  // Don't add this OnwerRRef to the owners_ map yet, otherwise
+  // Don't add this OnwerRRef to the owners map yet, otherwise
   // it will never be removed from there. Instead, only add it to the
   // map in prepareChildFork, in case this local RRef is being passed
   // to another worker.
@@ -297,12 +320,14 @@ c10::intrusive_ptr<OwnerRRef> RRefContext::createOwnerRRef(
 }
 
 c10::intrusive_ptr<OwnerRRef> RRefContext::getOwnerRRef(const RRefId& rrefId) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  const auto iter = owners_.find(rrefId);
-  if (iter == owners_.end()) {
+  auto& shard = shardFor(rrefId);
+  std::unique_lock<std::mutex> lock(shard.mutex);
+  const auto iter = shard.owners.find(rrefId);
+  if (iter == shard.owners.end()) {
     // Scenario (1) RRef is used before it is created
-    ownerCV_.wait(lock, [&] { return owners_.find(rrefId) != owners_.end(); });
-    return c10::static_intrusive_pointer_cast<OwnerRRef>(owners_[rrefId]);
+    shard.ownerCV.wait(
+        lock, [&] { return shard.owners.find(rrefId) != shard.owners.end(); });
+    return c10::static_intrusive_pointer_cast<OwnerRRef>(shard.owners[rrefId]);
   } else {
     // Scenario (2) retrieving an existing RRef
     return c10::static_intrusive_pointer_cast<OwnerRRef>(iter->second);
@@ -324,11 +349,12 @@ RRefForkData RRefContext::prepareChildFork(
     // TODO: When adding failure retries and timeout, this fork needs to be
     // deleted if the owner does not receive the ACK within the timeout.
     addForkOfOwner(rrefForkData.rrefId_, rrefForkData.forkId_);
-    // ensure that this RRef is in the owners_ list to keep it alive.
+    // ensure that this RRef is in the owners map to keep it alive.
     // this is needed for OwnerRRefs that were created locally.
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      owners_[rref->rrefId()] = rref;
+      auto& shard = shardFor(rref->rrefId());
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.owners[rref->rrefId()] = rref;
     }
   } else {
     // Note [Useful Phantom Fork ID for User to Owner Call]
@@ -369,7 +395,7 @@ void RRefContext::notifyOwnerAndParentOfFork(
       }
     } else {
       // If the parent is the owner, this fork has already been added into the
-      // forks_ map when the owner sends the message to the callee user.
+      // forks map when the owner sends the message to the callee user.
       // Hence, it is not necessary to send another RREF_CHILD_ACCEPT or
       // RREF_FORK_REQUEST back to the owner. See Note [Early Fork
       // Registration].
@@ -383,7 +409,7 @@ void RRefContext::notifyOwnerAndParentOfFork(
   if (rref->isOwner()) {
     // See Note [Useful Phantom Fork ID for User to Owner Call]
     // In this case, the owner is the caller, and it does not add the fork id
-    // into forks_. Because, there will be no real `UserRRef` associated
+    // into the forks map. Because, there will be no real `UserRRef` associated
     // with this fork ID.
     auto fm = agent_->sendWithRetries(
         agent_->getWorkerInfo(parent), RRefChildAccept(forkId).toMessage());
@@ -568,10 +594,11 @@ void RRefContext::finishForkRequest(const ForkId& forkId, worker_id_t parent) {
 }
 
 void RRefContext::addSelfAsFork(c10::intrusive_ptr<OwnerRRef>& rref) {
-  std::lock_guard<std::mutex> lock(mutex_);
   const auto& rrefId = rref->rrefId();
-  owners_[rrefId] = rref;
-  auto& rrefForks = forks_[rrefId];
+  auto& shard = shardFor(rrefId);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.owners[rrefId] = rref;
+  auto& rrefForks = shard.forks[rrefId];
   TORCH_INTERNAL_ASSERT(
       rrefForks.find(rrefId) == rrefForks.end(),
       "Attempt to add self as fork twice ",
@@ -580,8 +607,9 @@ void RRefContext::addSelfAsFork(c10::intrusive_ptr<OwnerRRef>& rref) {
 }
 
 void RRefContext::addForkOfOwner(const RRefId& rrefId, const ForkId& forkId) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto& rrefForks = forks_[rrefId];
+  auto& shard = shardFor(rrefId);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& rrefForks = shard.forks[rrefId];
   TORCH_INTERNAL_ASSERT(
       rrefForks.find(forkId) == rrefForks.end(),
       "Got fork notification twice on the same RRef ",
@@ -592,8 +620,9 @@ void RRefContext::addForkOfOwner(const RRefId& rrefId, const ForkId& forkId) {
 void RRefContext::addForkOfOwnerIfNotPresent(
     const RRefId& rrefId,
     const ForkId& forkId) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto& rrefForks = forks_[rrefId];
+  auto& shard = shardFor(rrefId);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& rrefForks = shard.forks[rrefId];
   // We first check whether the child exists in rrefForks. It's possible
   // the child may have been added by a previous send attempt, and this check
   // (as opposed to an assertion here) ensures that messages that trigger this
@@ -617,9 +646,10 @@ c10::intrusive_ptr<RRef> RRefContext::delForkOfOwner(
   // statements to ensure this function is idempotent. This makes it safe to
   // retry RRefUserDelete messages.
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto rrefIter = forks_.find(rrefId);
-    if (rrefIter != forks_.end()) {
+    auto& shard = shardFor(rrefId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto rrefIter = shard.forks.find(rrefId);
+    if (rrefIter != shard.forks.end()) {
       auto& rrefForks = rrefIter->second;
       auto forkIter = rrefForks.find(forkId);
       if (forkIter != rrefForks.end()) {
@@ -631,13 +661,13 @@ c10::intrusive_ptr<RRef> RRefContext::delForkOfOwner(
             << ", likely because it was deleted by a previously retried message";
       }
       if (rrefForks.empty()) {
-        auto ownerIter = owners_.find(rrefId);
-        if (ownerIter != owners_.end()) {
+        auto ownerIter = shard.owners.find(rrefId);
+        if (ownerIter != shard.owners.end()) {
           deletedRRef = ownerIter->second;
-          owners_.erase(ownerIter);
+          shard.owners.erase(ownerIter);
           ownerReduced = true;
         }
-        forks_.erase(rrefIter);
+        shard.forks.erase(rrefIter);
       }
     } else {
       LOG(INFO)
@@ -646,6 +676,11 @@ c10::intrusive_ptr<RRef> RRefContext::delForkOfOwner(
     }
   }
   if (ownerReduced) {
+    // delAllUsers() checks the owner count in its wait predicate while holding
+    // mutex_. Briefly acquiring mutex_ here ensures the waiter either observes
+    // the deletion above or is already blocked on the condition variable, so
+    // the notification below cannot be missed.
+    { std::lock_guard<std::mutex> lock(mutex_); }
     deleteAllUsersCV_.notify_all();
   }
   return deletedRRef;
@@ -7,6 +7,7 @@
 #include <torch/csrc/distributed/rpc/types.h>
 #include <torch/csrc/utils/future.h>
 
+#include <array>
 #include <atomic>
 
 namespace torch {
@@ -89,13 +90,13 @@ class TORCH_API RRefContext {
 
   c10::intrusive_ptr<OwnerRRef> getOwnerRRef(const RRefId& rrefId);
 
-  // Adding the RRefId of an OwnerRRef into the forks_ map. This is useful when
+  // Adding the RRefId of an OwnerRRef into the forks map. This is useful when
   // making a remote call to self, which as for now, still goes through serde
   // and invokes request callback. In this case, the OwnerRRef has already been
   // created on the send side, and we need to pass it to the receive side,
   // instead of creating a new OwnerRRef. This is done by adding the OwnerRRef
-  // into owners_. However, that alone is not enough, as it could be deleted
-  // when all UserRRef die, which would then remove the OwnerRRef from owners_
+  // into the owners map. However, that alone is not enough, as it could be
+  // deleted when all UserRRef die, which would then remove the OwnerRRef
   // and this could happen before the self remote call finishes. To prevent
   // that, this API adds the RRefId as a ForkId, which will then delete the
   // ForkId when the self remote is done.
@@ -214,29 +215,61 @@ class TORCH_API RRefContext {
   static std::atomic<local_id_t> nextLocalId_;
 
   const std::shared_ptr<RpcAgent> agent_;
+  // Guards the pending/confirmed user maps below. The owner-side state is
+  // sharded by RRefId with per-shard locks instead, see
+  // Note [RRef shard domains].
   mutable std::mutex mutex_;
-  // Keep OwnerRRefs alive until there is no living UserRRefs.
-  std::unordered_map<RRefId, c10::intrusive_ptr<RRef>, RRefId::Hash> owners_;
-  // A conditional variable to block getOwnerRRef() calls until the
-  // corresponding OwnerRRef has been created and inserted into the owners_ map.
-  // The method getOwnerRRef() is triggered by rref.to_here() messages. The
-  // reason for having this CV is because rref.to_here() message and rpc.remote
-  // message may arrive in any order, and to_here() can only be served when the
-  // RRef value is ready. In the previous version, we used to block the
-  // to_here() call by waiting on the CV member variable in OwnerRRef. However,
-  // that means the to_here() call has to first create the OwnerRRef, which
-  // would require knowing the IValue type when if we want to make RRef an
-  // IValue. Instead of sending serialized TypePtr in every to_here() message,
-  // we decided to only create OwnerRRef when processing remote calls.
-  // TODO: As OwnerRRef::getValue() is always called after
-  // OwnerRRef::setValue(), we should be able to remove the CV from OwnerRRef.
-  std::condition_variable ownerCV_;
-  // Tracks known living UserRRefs of an OwnerRRef
-  std::unordered_map<
-      RRefId,
-      std::unordered_set<ForkId, ForkId::Hash>,
-      RRefId::Hash>
-      forks_;
+
+  // Note [RRef shard domains]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Owner-side state is touched on every RRef create, fork, and delete,
+  // and parameter-server style workloads drive millions of such calls
+  // through this context concurrently. A single lock around the owners
+  // and forks maps becomes the top contention point on the server, so the
+  // two maps are sharded by RRefId hash with one lock (and one owner CV)
+  // per shard. All state for a given RRefId lives in exactly one shard,
+  // so per-RRef operations take a single shard lock and the fork/delete
+  // protocol semantics are unchanged; only whole-context operations
+  // (debug info, leak checks, shutdown) visit every shard.
+  struct RRefShard {
+    mutable std::mutex mutex;
+    // Keep OwnerRRefs alive until there is no living UserRRefs.
+    std::unordered_map<RRefId, c10::intrusive_ptr<RRef>, RRefId::Hash> owners;
+    // A conditional variable to block getOwnerRRef() calls until the
+    // corresponding OwnerRRef has been created and inserted into the owners
+    // map. The method getOwnerRRef() is triggered by rref.to_here()
+    // messages. The reason for having this CV is because rref.to_here()
+    // message and rpc.remote message may arrive in any order, and to_here()
+    // can only be served when the RRef value is ready. In the previous
+    // version, we used to block the to_here() call by waiting on the CV
+    // member variable in OwnerRRef. However, that means the to_here() call
+    // has to first create the OwnerRRef, which would require knowing the
+    // IValue type when if we want to make RRef an IValue. Instead of
+    // sending serialized TypePtr in every to_here() message, we decided to
+    // only create OwnerRRef when processing remote calls.
+    // TODO: As OwnerRRef::getValue() is always called after
+    // OwnerRRef::setValue(), we should be able to remove the CV from
+    // OwnerRRef.
+    std::condition_variable ownerCV;
+    // Tracks known living UserRRefs of an OwnerRRef
+    std::unordered_map<
+        RRefId,
+        std::unordered_set<ForkId, ForkId::Hash>,
+        RRefId::Hash>
+        forks;
+  };
+
+  static constexpr size_t kNumRRefShards = 16;
+
+  inline RRefShard& shardFor(const RRefId& rrefId) {
+    return shards_[RRefId::Hash()(rrefId) % kNumRRefShards];
+  }
+
+  // Sums the number of OwnerRRefs across all shards; takes every shard
+  // lock.
+  size_t numOwners() const;
+
+  std::array<RRefShard, kNumRRefShards> shards_;
 
   // This cond var is used by deleteAllUsers(), a event notificaton is sent if
   // number of pending UserRRef or UserRRef children is reduced, or
@@ -212,6 +212,16 @@ parseWireSections(const void* data, size_t data_size) {
 
 static const char* kMeta = "meta";
 static const char* kPayload = "payload";
+
+// Alignment of tensor data sections within the serialized stream. Receive
+// buffers come from the CPU allocator, which aligns at least this much, so
+// sections that start on a multiple of this offset can be handed to the
+// unpickler in place, without being copied out of the receive buffer.
+constexpr size_t kTensorDataAlign = 64;
+
+size_t alignWireSize(size_t size) {
+  return (size + kTensorDataAlign - 1) / kTensorDataAlign * kTensorDataAlign;
+}
 }; // namespace
 
 c10::List<at::Tensor> cloneSparseTensors(
@@ -238,7 +248,7 @@ c10::List<at::Tensor> cloneSparseTensors(
   return pTensors;
 }
 
-std::string wireSerialize(
+WireChunkedData wireSerializeChunked(
     const std::vector<char>& payload,
     const std::vector<at::Tensor>& tensors) {
   for (const auto& tensor : tensors) {
@@ -252,15 +262,14 @@ std::string wireSerialize(
 
   struct Ent {
     std::string name;
-    const char* data;
     size_t size;
   };
   std::vector<Ent> entries;
   std::string metaEntry;
-  std::vector<jit::WriteableTensorData> tensorData;
+  WireChunkedData out;
 
   if (!payload.empty()) {
-    entries.push_back({kPayload, payload.data(), payload.size()});
+    entries.push_back({kPayload, payload.size()});
   }
 
   if (!tensors.empty()) {
@@ -271,39 +280,93 @@ std::string wireSerialize(
     pickler.protocol();
     pickler.pushIValue(cloneSparseTensors(tensors));
     pickler.stop();
-    // tensorData is in function scope so that the data() pointers stay valid.
-    tensorData = pickler.tensorData();
-    entries.push_back({kMeta, metaEntry.data(), metaEntry.size()});
-    for (size_t i = 0; i < tensorData.size(); i++) {
-      entries.push_back({c10::to_string(i),
-                         tensorData[i].data(),
-                         tensorData[i].sizeInBytes()});
+    // out.tensorData owns the pickled tensors, keeping the chunk data()
+    // pointers valid for as long as the caller holds the result.
+    out.tensorData = pickler.tensorData();
+    entries.push_back({kMeta, metaEntry.size()});
+    // Zero-fill every tensor data section up to a kTensorDataAlign multiple,
+    // so that sections after the first stay aligned. The unpickler never
+    // reads the trailing pad bytes; they only shift section offsets.
+    out.padding.resize(out.tensorData.size());
+    for (size_t i = 0; i < out.tensorData.size(); i++) {
+      const auto size = out.tensorData[i].sizeInBytes();
+      out.padding[i].assign(alignWireSize(size) - size, '\0');
+      entries.push_back({c10::to_string(i), alignWireSize(size)});
+    }
+  }
+
+  auto buildHeader = [&entries]() {
+    std::string header;
+    for (const auto& e : entries) {
+      header.append(e.name)
+          .append(" ")
+          .append(c10::to_string(e.size))
+          .append("\n");
+    }
+    header.push_back('\n');
+    return header;
+  };
+
+  if (!tensors.empty()) {
+    // Pad the meta section so that the first tensor data section starts on a
+    // kTensorDataAlign boundary. Growing the meta section can change the
+    // digit count of its table entry, hence the loop; it converges within a
+    // couple of rounds. The unpickler stops at the pickle STOP opcode and
+    // never reads the pad bytes.
+    auto& metaSize = entries[payload.empty() ? 0 : 1].size;
+    for (;;) {
+      const size_t headerLen =
+          buildHeader().size() + payload.size() + metaSize;
+      if (headerLen % kTensorDataAlign == 0) {
+        break;
+      }
+      metaSize += kTensorDataAlign - headerLen % kTensorDataAlign;
     }
+    metaEntry.append(metaSize - metaEntry.size(), '\0');
   }
 
-  std::string header;
-  size_t tot = 0;
-  for (const auto& e : entries) {
-    tot += e.size;
-    header.append(e.name)
-        .append(" ")
-        .append(c10::to_string(e.size))
-        .append("\n");
+  std::string header = buildHeader();
+
+  // The payload and pickle metadata are small control sections; fold them
+  // into the header chunk so the tensor storages are the only sections
+  // referenced in place rather than copied.
+  out.header = std::move(header);
+  if (!payload.empty()) {
+    out.header.append(payload.data(), payload.size());
+  }
+  if (!tensors.empty()) {
+    out.header.append(metaEntry);
+  }
+  return out;
+}
+
+std::string wireSerialize(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors) {
+  auto chunked = wireSerializeChunked(payload, tensors);
+  size_t tot = chunked.header.size();
+  for (size_t i = 0; i < chunked.tensorData.size(); i++) {
+    tot += chunked.tensorData[i].sizeInBytes() + chunked.padding[i].size();
   }
-  header.push_back('\n');
 
   std::string out;
-  out.reserve(header.size() + tot);
-  out.append(header);
-  for (const auto& e : entries) {
-    out.append(e.data, e.size);
+  out.reserve(tot);
+  out.append(chunked.header);
+  for (size_t i = 0; i < chunked.tensorData.size(); i++) {
+    out.append(chunked.tensorData[i].data(), chunked.tensorData[i].sizeInBytes());
+    out.append(chunked.padding[i]);
   }
   return out;
 }
 
-std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+namespace {
+
+// Shared implementation of wireDeserialize() and wireDeserializeInPlace();
+// `sectionAlloc` produces the DataPtr backing each tensor data section.
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserializeImpl(
     const void* data,
-    size_t data_size) {
+    size_t data_size,
+    const std::function<at::DataPtr(const char*, size_t)>& sectionAlloc) {
   auto sections = parseWireSections(data, data_size);
 
   std::vector<char> payload;
@@ -333,12 +396,7 @@ std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
       if (it == sections.end()) {
         throw std::runtime_error("Couldn't find entity " + ename);
       }
-      const auto& idat = it->second;
-      auto dptr = at::getCPUAllocator()->allocate(idat.second);
-      if (idat.second != 0) {
-        memcpy(dptr.get(), idat.first, idat.second);
-      }
-      return dptr;
+      return sectionAlloc(it->second.first, it->second.second);
     };
 
     // No need to pass typeResolver here, as it always processes string and
@@ -353,6 +411,41 @@ std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
   return {std::move(payload), std::move(tensors)};
 }
 
+at::DataPtr copySectionAlloc(const char* ptr, size_t size) {
+  auto dptr = at::getCPUAllocator()->allocate(size);
+  if (size != 0) {
+    memcpy(dptr.get(), ptr, size);
+  }
+  return dptr;
+}
+
+} // namespace
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
+    const void* data,
+    size_t data_size) {
+  return wireDeserializeImpl(data, data_size, copySectionAlloc);
+}
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserializeInPlace(
+    const at::Tensor& buffer) {
+  auto storage = buffer.storage();
+  auto sectionAlloc = [&storage](const char* ptr, size_t size) -> at::DataPtr {
+    // Aligned sections (the serializer pads them, see wireSerializeChunked())
+    // are referenced in place; the deleter holds on to the buffer's storage
+    // so the section outlives the buffer. Sections that are not aligned
+    // (e.g. when the buffer itself came from an unaligned blob) are copied
+    // out instead, since tensor kernels may assume aligned storage.
+    if (reinterpret_cast<uintptr_t>(ptr) % kTensorDataAlign == 0) {
+      return c10::InefficientStdFunctionContext::makeDataPtr(
+          const_cast<char*>(ptr), [storage](void*) {}, at::kCPU);
+    }
+    return copySectionAlloc(ptr, size);
+  };
+  return wireDeserializeImpl(
+      buffer.storage().data(), buffer.numel(), sectionAlloc);
+}
+
 } // namespace rpc
 } // namespace distributed
 } // namespace torch
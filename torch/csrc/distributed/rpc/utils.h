@@ -1,6 +1,7 @@
 #pragma once
 
 #include <torch/csrc/distributed/rpc/rpc_command_base.h>
+#include <torch/csrc/jit/serialization/pickler.h>
 
 namespace torch {
 namespace distributed {
@@ -39,6 +40,34 @@ TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
     const void* data,
     size_t data_size);
 
+// Serialized form of a message in which the tensor data sections reference
+// their source storages instead of being copied into one flat buffer.
+// `header` holds the section table together with the payload and pickle
+// metadata sections; `tensorData` owns the (possibly cloned) tensors and
+// points at their storages; `padding[i]` is the zero-fill that follows
+// `tensorData[i]` so that every tensor data section starts on an aligned
+// boundary (see wireDeserializeInPlace()). Concatenating `header` with the
+// tensor data chunks, each followed by its padding, yields exactly the
+// wireSerialize() format.
+struct TORCH_API WireChunkedData {
+  std::string header;
+  std::vector<torch::jit::WriteableTensorData> tensorData;
+  std::vector<std::string> padding;
+};
+
+// Like wireSerialize(), but leaves the tensor data in place so that callers
+// can send it scatter-gather style, directly from the tensor storages.
+TORCH_API WireChunkedData wireSerializeChunked(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors);
+
+// Like wireDeserialize(), but for serialized bytes that live in a tensor
+// (e.g. a flat receive buffer). Tensor data sections alias the buffer
+// instead of being copied out of it; the returned tensors hold a reference
+// to the buffer's storage, so the buffer may be released by the caller.
+TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>>
+wireDeserializeInPlace(const at::Tensor& buffer);
+
 // Some Tensors are effectively views of larger Tensors, where only a small
 // subset of the Storage data is referenced. This normally is good and avoids
 // copies when kept locally, but if we naively push the whole Storage over the
@@ -56,6 +56,7 @@ struct TORCH_API CompilationUnit {
   CompilationUnit(const CompilationUnit&) = delete;
 
   Function* find_function(const c10::QualifiedName& name) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto it = dict_.find(name);
     if (it == dict_.end()) {
       return nullptr;
@@ -115,6 +116,7 @@ struct TORCH_API CompilationUnit {
       c10::QualifiedName name,
       std::shared_ptr<Graph> graph,
       bool shouldMangle = false) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (shouldMangle) {
       name = mangle(name);
     }
@@ -126,6 +128,7 @@ struct TORCH_API CompilationUnit {
   }
 
   std::vector<Function*> get_functions() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     return fmap(functions_, [](const std::unique_ptr<Function>& fn) {
       return fn.get();
     });
@@ -150,6 +153,7 @@ struct TORCH_API CompilationUnit {
   }
 
   void drop_all_functions() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     dict_.clear();
     functions_.clear();
   }
@@ -158,6 +162,7 @@ struct TORCH_API CompilationUnit {
    * Register a class as being owned by this compilation unit.
    */
   void register_type(c10::NamedTypePtr namedType) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     // TODO: class types cannot be redefined because we have no way right now
     // of invalidating their methods. NamedTuples are fine though, since they
     // don't have methods.
@@ -187,6 +192,7 @@ struct TORCH_API CompilationUnit {
   }
 
   c10::TupleTypePtr get_named_tuple(const c10::QualifiedName& name) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     for (const auto& cls : classes_) {
       if (cls->name()->qualifiedName() == name.qualifiedName()) {
         return cls->expect<TupleType>();
@@ -196,6 +202,7 @@ struct TORCH_API CompilationUnit {
   }
 
   c10::NamedTypePtr get_type(const c10::QualifiedName& name) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto it = classDict_.find(name);
     if (it == classDict_.end()) {
       return nullptr;
@@ -206,6 +213,7 @@ struct TORCH_API CompilationUnit {
   // For testing: clear all Python-defined classes to ensure that unit tests
   // have isolation.
   void _clear_python_cu() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     // Delete all the associated class methods
     for (auto type : classes_) {
       if (auto cls = type->cast<ClassType>()) {
@@ -227,6 +235,7 @@ struct TORCH_API CompilationUnit {
   // [Internal Only] Remove method.
   // Note Used for freezing.
   void unsafeRemoveMethod(const c10::QualifiedName& method_name) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto it = dict_.find(method_name);
     TORCH_CHECK(
         it != dict_.end(),
@@ -246,6 +255,7 @@ struct TORCH_API CompilationUnit {
   // Module is a singleton class instance, different instances of the same
   // Python Module will have different types but the same qualified name.
   c10::QualifiedName mangle(const c10::QualifiedName& name) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto mangled = name;
     while (get_type(mangled) || find_function(mangled)) {
       mangled = mangler_.mangle(mangled);
@@ -263,6 +273,7 @@ struct TORCH_API CompilationUnit {
       bool shouldMangle = false) const;
 
   Function& register_function(std::unique_ptr<Function> fn) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     TORCH_CHECK(
         0 == dict_.count(fn->qualname().qualifiedName()),
         "method '",
@@ -285,6 +296,12 @@ struct TORCH_API CompilationUnit {
   std::vector<c10::NamedTypePtr> classes_;
 
   mutable NameMangler mangler_;
+
+  // Guards functions_, dict_, classes_ and classDict_: definitions may be
+  // registered and looked up from several threads at once while a module's
+  // methods are compiled in parallel. Reentrant because e.g. create_function
+  // mangles, which in turn looks up existing definitions.
+  mutable std::recursive_mutex mutex_;
 };
 
 // An owning pointer to a Function. Just a pair of a raw Function ptr and it's
@@ -6,9 +6,20 @@
 #include <torch/csrc/jit/passes/constant_propagation.h>
 #include <torch/csrc/jit/passes/peephole.h>
 
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 namespace {
+// State of the waits-for graph maintained by CompilationWaitGraph. A blocked
+// thread has at most one outgoing edge, present only while it is blocked,
+// pointing at the hold token it waits on; active_holds maps each live token
+// back to the thread that holds it.
+std::mutex wait_graph_mutex;
+std::unordered_map<std::thread::id, uint64_t> wait_graph;
+std::unordered_map<uint64_t, std::thread::id> active_holds;
+uint64_t next_hold_token = 1;
+
 c10::FunctionSchema defaultSchemaFor(const Function& function) {
   std::vector<c10::Argument> args;
   std::vector<c10::Argument> returns;
@@ -27,6 +38,51 @@ c10::FunctionSchema defaultSchemaFor(const Function& function) {
 }
 } // namespace
 
+uint64_t CompilationWaitGraph::beginHold() {
+  std::lock_guard<std::mutex> guard(wait_graph_mutex);
+  const auto token = next_hold_token++;
+  active_holds.emplace(token, std::this_thread::get_id());
+  return token;
+}
+
+void CompilationWaitGraph::endHold(uint64_t token) {
+  std::lock_guard<std::mutex> guard(wait_graph_mutex);
+  active_holds.erase(token);
+}
+
+void CompilationWaitGraph::beginWait(uint64_t token) {
+  std::lock_guard<std::mutex> guard(wait_graph_mutex);
+  const auto self = std::this_thread::get_id();
+  // Every blocked thread registered its edge before blocking, so walking the
+  // chain from `token` only visits blocked threads; if it reaches this
+  // thread, the new edge would complete a cycle in which no participant can
+  // make progress. A hop whose hold has been released is a stale edge left
+  // by a thread that finished waiting but has not reacquired its mutex yet;
+  // that thread is about to make progress, so the walk stops rather than
+  // reporting a phantom cycle.
+  auto cur = token;
+  while (true) {
+    auto hold = active_holds.find(cur);
+    if (hold == active_holds.end()) {
+      break;
+    }
+    if (hold->second == self) {
+      throw RecursiveMethodCallError();
+    }
+    auto it = wait_graph.find(hold->second);
+    if (it == wait_graph.end()) {
+      break;
+    }
+    cur = it->second;
+  }
+  wait_graph[self] = token;
+}
+
+void CompilationWaitGraph::endWait() {
+  std::lock_guard<std::mutex> guard(wait_graph_mutex);
+  wait_graph.erase(std::this_thread::get_id());
+}
+
 void placeholderCreator(GraphFunction&) {
   throw RecursiveMethodCallError();
 }
@@ -52,12 +108,46 @@ IValue GraphFunction::operator()(
 }
 
 void GraphFunction::ensure_defined() {
+  // Several threads may race here when a module's methods are compiled in
+  // parallel (see CompilationUnit::define). Exactly one thread runs the
+  // creator; the others block until the graph is ready. A thread that
+  // re-enters while it is itself running the creator is emitting a recursive
+  // call, which is reported the same way as in serial compilation.
+  std::unique_lock<std::mutex> lock(creation_mutex_);
+  while (creating_) {
+    if (creation_thread_ == std::this_thread::get_id()) {
+      throw RecursiveMethodCallError();
+    }
+    CompilationWaitGraph::beginWait(creation_token_);
+    creation_cv_.wait(lock);
+    CompilationWaitGraph::endWait();
+  }
   if (function_creator_) {
-    auto creator = function_creator_;
-    function_creator_ = placeholderCreator;
-    creator(*this);
+    auto creator = std::move(function_creator_);
     function_creator_ = nullptr;
+    creating_ = true;
+    creation_thread_ = std::this_thread::get_id();
+    creation_token_ = CompilationWaitGraph::beginHold();
+    lock.unlock();
+    try {
+      creator(*this);
+    } catch (...) {
+      lock.lock();
+      // Later callers see the same error a recursive call would have
+      // produced, matching what the serial implementation left behind when a
+      // creator threw.
+      function_creator_ = placeholderCreator;
+      creating_ = false;
+      CompilationWaitGraph::endHold(creation_token_);
+      creation_cv_.notify_all();
+      throw;
+    }
+    lock.lock();
+    creating_ = false;
+    CompilationWaitGraph::endHold(creation_token_);
+    creation_cv_.notify_all();
   }
+  lock.unlock();
   check_single_output();
 }
 
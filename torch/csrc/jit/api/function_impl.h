@@ -5,9 +5,41 @@
 #include <torch/csrc/jit/runtime/graph_executor.h>
 #include <torch/csrc/utils/memory.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace torch {
 namespace jit {
 
+// Tracks what each blocked compilation thread is waiting on, across all
+// functions and importers. When methods are compiled in parallel a cycle of
+// such waits would deadlock, so a thread registers the edge before it blocks
+// and the thread that would close a cycle throws RecursiveMethodCallError
+// instead - the same error single-threaded compilation produces for
+// recursive calls.
+//
+// Waits are recorded against a hold token rather than a bare thread id: a
+// waiter only erases its edge after it wakes and reacquires its mutex, so a
+// finished wait can briefly leave a stale edge behind. Because the holder
+// releases the token (under the graph lock) before notifying, the cycle walk
+// can tell such edges apart from live ones and never reports a phantom
+// cycle.
+struct TORCH_API CompilationWaitGraph {
+  // Register a hold for the current thread (a creator running, an import in
+  // flight). Returns the token waiters should pass to beginWait.
+  static uint64_t beginHold();
+  // Release a hold. Must be called before the waiters are notified, while
+  // still holding the mutex that guards the hold's state.
+  static void endHold(uint64_t token);
+  // Record that the current thread is about to block on the hold identified
+  // by `token`. Throws RecursiveMethodCallError if the edge would close a
+  // cycle of waiting threads.
+  static void beginWait(uint64_t token);
+  // Remove the edge recorded by beginWait once the wait returns.
+  static void endWait();
+};
+
 struct TORCH_API GraphFunction : public Function {
   GraphFunction(
       c10::QualifiedName name,
@@ -135,6 +167,15 @@ struct TORCH_API GraphFunction : public Function {
   // that it can construct methods out of order
   std::function<void(GraphFunction&)> function_creator_;
 
+  // Hands off graph creation between threads when several methods are
+  // compiled concurrently: the first thread through ensure_defined() runs
+  // function_creator_ and the others wait on creation_cv_ until it is done.
+  std::mutex creation_mutex_;
+  std::condition_variable creation_cv_;
+  std::thread::id creation_thread_;
+  uint64_t creation_token_ = 0;
+  bool creating_ = false;
+
   // if absent, then we generate a default schema based on the graph
   // mutable because getSchema caches the default schema if one is requested
   // before a call to setSchema
@@ -0,0 +1,34 @@
+#include <torch/csrc/jit/api/inference_session.h>
+
+#include <ATen/core/grad_mode.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+
+namespace torch {
+namespace jit {
+
+InferenceSession InferenceSession::create(const Module& module) {
+  // freeze_module requires eval mode; flip it on an instance clone so the
+  // caller's module keeps its training flag.
+  Module prepared = module.clone_instance();
+  if (prepared.hasattr("training")) {
+    prepared.eval();
+  }
+  return InferenceSession(freeze_module(prepared));
+}
+
+InferenceContext InferenceSession::newContext() const {
+  return InferenceContext(frozen_.clone_instance());
+}
+
+IValue InferenceContext::run_method(
+    const std::string& name,
+    std::vector<IValue> inputs) {
+  // Inference never needs the autograd graph. Disabling grad mode both
+  // skips autograd bookkeeping and keeps every context on the same
+  // (grad-disabled) ArgumentSpec, so all threads share one cached plan.
+  at::AutoGradMode guard(false);
+  return module_.get_method(name)(std::move(inputs));
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,79 @@
+/** \brief This file defines the concurrent inference API for TorchScript
+ * modules.
+ *
+ * A torch::jit::Module is not a thread-safe object: attribute reads and
+ * writes on the instance are unsynchronized, so sharing one instance across
+ * serving threads is only safe as long as no method mutates module state.
+ * The usual workaround -- a deep module replica per thread -- multiplies the
+ * weight memory by the thread count.
+ *
+ * InferenceSession provides the middle ground. It freezes the module once
+ * (see freeze_module.h), so the weights are internalized into the graph as
+ * immutable constants, and then hands out lightweight per-thread
+ * InferenceContexts. A context is an instance clone of the frozen module:
+ * it shares the ClassType, the methods, their GraphExecutors (and therefore
+ * the optimized-plan cache) and all tensor storage with every other context,
+ * while any residual mutable attribute slots are private to the context.
+ *
+ * Thread-safety guarantees:
+ *  - InferenceSession is immutable after creation; create(), newContext()
+ *    and frozen_module() may be called concurrently from any thread.
+ *  - An InferenceContext must be used by one thread at a time. Contexts are
+ *    cheap (shallow slot copies); create one per serving thread instead of
+ *    sharing one.
+ *  - Calls on distinct contexts never block each other: plan-cache hits in
+ *    the shared GraphExecutor are lock-free, and contexts run with gradients
+ *    disabled so every thread hits the same cached plan.
+ */
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+
+namespace torch {
+namespace jit {
+
+struct InferenceSession;
+
+/** \brief A single-threaded execution handle over shared frozen weights. */
+struct TORCH_API InferenceContext {
+  IValue forward(std::vector<IValue> inputs) {
+    return run_method("forward", std::move(inputs));
+  }
+
+  /// Runs an arbitrary method of the frozen module. Gradients are disabled
+  /// for the duration of the call.
+  IValue run_method(const std::string& name, std::vector<IValue> inputs);
+
+  /// The context's private instance clone of the frozen module.
+  Module& module() {
+    return module_;
+  }
+
+ private:
+  friend struct InferenceSession;
+  explicit InferenceContext(Module module) : module_(std::move(module)) {}
+
+  Module module_;
+};
+
+/** \brief Shared, immutable inference state for one loaded model. */
+struct TORCH_API InferenceSession {
+  /// Builds a session from a module. The module is left untouched: freezing
+  /// operates on an instance clone that is put in eval mode first.
+  static InferenceSession create(const Module& module);
+
+  /// Returns a fresh execution context for use by a single thread.
+  InferenceContext newContext() const;
+
+  const Module& frozen_module() const {
+    return frozen_;
+  }
+
+ private:
+  explicit InferenceSession(Module frozen) : frozen_(std::move(frozen)) {}
+
+  Module frozen_;
+};
+
+} // namespace jit
+} // namespace torch
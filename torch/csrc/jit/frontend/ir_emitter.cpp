@@ -1,4 +1,5 @@
 #include <torch/csrc/jit/frontend/ir_emitter.h>
+#include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
 #include <c10/util/StringUtil.h>
 #include <torch/csrc/jit/api/function_impl.h>
@@ -24,8 +25,11 @@
 
 #include <c10/util/Optional.h>
 
+#include <algorithm>
 #include <atomic>
 #include <climits>
+#include <condition_variable>
+#include <mutex>
 #include <set>
 
 namespace torch {
@@ -3470,6 +3474,10 @@ struct FunctionResolver : public Resolver {
     return otherResolver_->resolveType(name, loc);
   }
 
+  bool supportsParallelCompilation() const override {
+    return otherResolver_->supportsParallelCompilation();
+  }
+
  private:
   Resolver* otherResolver_;
   const std::unordered_map<std::string, Function*>& functionTable_;
@@ -3528,6 +3536,17 @@ std::unique_ptr<Function> CompilationUnit::define(
   return fn;
 }
 
+// Parallel compilation trades the deterministic ordering of compile errors
+// for import latency; keep an escape hatch while it soaks.
+static bool parallelCompilationEnabled() {
+  static const char* enable_c_str =
+      std::getenv("PYTORCH_JIT_PARALLEL_COMPILATION");
+  if (!enable_c_str) {
+    return true;
+  }
+  return std::string(enable_c_str) != "0";
+}
+
 std::vector<Function*> CompilationUnit::define(
     const c10::optional<QualifiedName>& prefix,
     const std::vector<Def>& definitions,
@@ -3561,8 +3580,69 @@ std::vector<Function*> CompilationUnit::define(
     }
   }
 
+  bool parallel = definitions.size() > 1 && parallelCompilationEnabled() &&
+      std::all_of(resolvers.begin(), resolvers.end(), [](const ResolverPtr& r) {
+                    return r->supportsParallelCompilation();
+                  });
+  if (!parallel) {
+    for (Function* function : functions) {
+      function->ensure_defined();
+    }
+    return functions;
+  }
+
+  // Compile the methods across the inter-op thread pool. Methods compile
+  // lazily through GraphFunction::ensure_defined, which also orders
+  // inter-method dependencies: the first thread to reach a method builds its
+  // graph and any other thread that needs it blocks until it is ready, so no
+  // explicit scheduling is required here. The loop below is where this thread
+  // does its share of the work and is also what guarantees every method ends
+  // up defined; the launched tasks merely race it.
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  std::exception_ptr first_error;
+
+  auto record_error = [&]() {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (!first_error) {
+      first_error = std::current_exception();
+    }
+  };
+
+  size_t num_tasks = std::min(
+      functions.size(), static_cast<size_t>(at::get_num_interop_threads()));
+  size_t inflight = num_tasks;
+  for (size_t t = 0; t < num_tasks; t++) {
+    at::launch([&, t]() {
+      for (size_t i = t; i < functions.size(); i += num_tasks) {
+        try {
+          functions[i]->ensure_defined();
+        } catch (...) {
+          record_error();
+          break;
+        }
+      }
+      std::lock_guard<std::mutex> guard(mutex);
+      if (--inflight == 0) {
+        done_cv.notify_all();
+      }
+    });
+  }
+
   for (Function* function : functions) {
-    function->ensure_defined();
+    try {
+      function->ensure_defined();
+    } catch (...) {
+      record_error();
+      break;
+    }
+  }
+
+  // The tasks reference this frame, so wait them out even on error.
+  std::unique_lock<std::mutex> lock(mutex);
+  done_cv.wait(lock, [&] { return inflight == 0; });
+  if (first_error) {
+    std::rethrow_exception(first_error);
   }
   return functions;
 }
@@ -41,6 +41,15 @@ struct Resolver {
   virtual TypePtr resolveType(const std::string& name, const SourceRange& loc) {
     return nullptr;
   }
+
+  // Whether this resolver may be invoked from several threads at once.
+  // CompilationUnit::define only compiles a batch of definitions in parallel
+  // when every resolver involved returns true here. The default is
+  // conservative: resolvers that depend on the Python interpreter or carry
+  // unguarded mutable state must stay serial.
+  virtual bool supportsParallelCompilation() const {
+    return false;
+  }
 };
 
 // A resolver that only understands "torch.foo()" lookups.
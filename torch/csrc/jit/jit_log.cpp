@@ -1,7 +1,13 @@
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include <ATen/core/function.h>
@@ -111,6 +117,124 @@ std::string jit_log_prefix(
   return jit_log_prefix(prefix_ss.str(), in_str);
 }
 
+// See Note [JIT log ring buffer] in jit_log.h.
+namespace {
+
+struct JitLogRecord {
+  int64_t timestamp_ns;
+  const char* file; // string literal (__FILE__), never freed
+  uint32_t line;
+  JitLoggingLevels level;
+  uint64_t tid;
+};
+
+constexpr size_t kRingCapacity = 8192;
+
+struct JitLogRing;
+
+// Dump needs to see every thread's buffer, so rings register themselves
+// here on first use and move their live records into `retired` when their
+// thread exits.
+struct RingRegistry {
+  std::mutex mutex;
+  std::vector<JitLogRing*> rings;
+  std::vector<JitLogRecord> retired;
+};
+
+RingRegistry& ringRegistry() {
+  static RingRegistry registry;
+  return registry;
+}
+
+struct JitLogRing {
+  std::array<JitLogRecord, kRingCapacity> records;
+  // Total records ever written; records[count % kRingCapacity] is the next
+  // slot and min(count, kRingCapacity) slots are live.
+  uint64_t count = 0;
+  uint64_t tid;
+
+  JitLogRing() {
+    tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+    auto& registry = ringRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.rings.push_back(this);
+  }
+
+  ~JitLogRing() {
+    auto& registry = ringRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.rings.erase(
+        std::remove(registry.rings.begin(), registry.rings.end(), this),
+        registry.rings.end());
+    appendLiveRecords(registry.retired);
+  }
+
+  void appendLiveRecords(std::vector<JitLogRecord>& out) const {
+    const uint64_t live = std::min<uint64_t>(count, kRingCapacity);
+    for (uint64_t i = count - live; i < count; ++i) {
+      out.push_back(records[i % kRingCapacity]);
+    }
+  }
+};
+
+JitLogRing& localRing() {
+  static thread_local JitLogRing ring;
+  return ring;
+}
+
+std::atomic<bool> ring_enabled{std::getenv("PYTORCH_JIT_LOG_RING") != nullptr};
+
+} // namespace
+
+bool jit_log_ring_enabled() {
+  return ring_enabled.load(std::memory_order_relaxed);
+}
+
+void set_jit_log_ring_enabled(bool enabled) {
+  ring_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void jit_log_ring_record(JitLoggingLevels level, const char* fn, int l) {
+  auto& ring = localRing();
+  JitLogRecord& record = ring.records[ring.count % kRingCapacity];
+  record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+  record.file = fn;
+  record.line = static_cast<uint32_t>(l);
+  record.level = level;
+  record.tid = ring.tid;
+  ring.count++;
+}
+
+std::string jit_log_ring_dump() {
+  // Collecting from live rings while their threads keep writing is
+  // best-effort: records are fixed-size, so a torn read garbles at most the
+  // lines it touches, which is acceptable for a diagnostic dump.
+  std::vector<JitLogRecord> all;
+  {
+    auto& registry = ringRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    all = registry.retired;
+    for (const JitLogRing* ring : registry.rings) {
+      ring->appendLiveRecords(all);
+    }
+  }
+  std::stable_sort(
+      all.begin(), all.end(), [](const JitLogRecord& a, const JitLogRecord& b) {
+        return a.timestamp_ns < b.timestamp_ns;
+      });
+
+  std::stringstream ss;
+  for (const JitLogRecord& record : all) {
+    ss << record.timestamp_ns << " [" << record.level << " "
+       << c10::detail::StripBasename(std::string(record.file)) << ":"
+       << std::setfill('0') << std::setw(3) << record.line << "] tid "
+       << record.tid << "\n";
+  }
+  return ss.str();
+}
+
 std::ostream& operator<<(std::ostream& out, JitLoggingLevels level) {
   switch (level) {
     case JitLoggingLevels::GRAPH_DUMP:
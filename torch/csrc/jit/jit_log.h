@@ -68,11 +68,34 @@ TORCH_API bool is_enabled(const char* cfname, JitLoggingLevels level);
 
 TORCH_API std::ostream& operator<<(std::ostream& out, JitLoggingLevels level);
 
-#define JIT_LOG(level, ...)                                  \
-  if (is_enabled(__FILE__, level)) {                         \
-    std::cerr << jit_log_prefix(                             \
-        level, __FILE__, __LINE__, ::c10::str(__VA_ARGS__)); \
-  }
+// Note [JIT log ring buffer]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The textual backend above formats eagerly and writes to stderr, which is
+// expensive enough to perturb the behavior it is meant to observe (e.g.
+// recompilation storms in a loaded server). As an alternative, the ring
+// buffer backend records every JIT_LOG site hit as a small binary record
+// (timestamp, level, file, line, thread) in a per-thread ring buffer; the
+// write path touches only thread-local memory, so it is cheap enough to
+// leave enabled in production. Formatting happens lazily, on demand, when
+// jit_log_ring_dump() merges the per-thread buffers into a time-sorted
+// text log. Enable with PYTORCH_JIT_LOG_RING=1 or
+// set_jit_log_ring_enabled(); the per-file PYTORCH_JIT_LOG_LEVEL filter
+// does not apply, all sites are recorded.
+TORCH_API bool jit_log_ring_enabled();
+TORCH_API void set_jit_log_ring_enabled(bool enabled);
+TORCH_API void jit_log_ring_record(JitLoggingLevels level, const char* fn, int l);
+TORCH_API std::string jit_log_ring_dump();
+
+#define JIT_LOG(level, ...)                                    \
+  do {                                                         \
+    if (::torch::jit::jit_log_ring_enabled()) {                \
+      ::torch::jit::jit_log_ring_record(level, __FILE__, __LINE__); \
+    }                                                          \
+    if (is_enabled(__FILE__, level)) {                         \
+      std::cerr << jit_log_prefix(                             \
+          level, __FILE__, __LINE__, ::c10::str(__VA_ARGS__)); \
+    }                                                          \
+  } while (0)
 
 // tries to reconstruct original python source
 #define SOURCE_DUMP(MSG, G) \
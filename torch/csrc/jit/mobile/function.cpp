@@ -6,11 +6,33 @@
 #include <torch/custom_class_detail.h>
 #include "interpreter.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 
 char const* toString(OpCode op);
 namespace mobile {
+namespace {
+// Operator resolution is string-keyed (JIT registry lookup or dispatcher
+// findSchema) and models repeat the same handful of ops across methods, so
+// resolved functions are interned process-wide and later loads reuse them.
+// Failed lookups are not cached, so operators registered after a load
+// (e.g. custom ops) are still found by subsequent loads.
+std::mutex& resolvedOperatorsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<c10::OperatorName, std::function<void(Stack&)>>&
+resolvedOperators() {
+  static std::unordered_map<c10::OperatorName, std::function<void(Stack&)>>
+      operators;
+  return operators;
+}
+} // namespace
+
 Function::Function(c10::QualifiedName name)
     : name_(name), code_(std::make_shared<Code>()) {}
 
@@ -29,12 +51,24 @@ bool Function::append_operator(
   code_->op_names_.emplace_back(name, overload_name);
   auto opname = code_->op_names_.back();
 
+  {
+    std::lock_guard<std::mutex> lock(resolvedOperatorsMutex());
+    auto it = resolvedOperators().find(opname);
+    if (it != resolvedOperators().end()) {
+      code_->operators_.emplace_back(it->second);
+      return true;
+    }
+  }
+
   auto opname_c10 = opname;
   std::function<void(Stack&)> fn;
 
   auto jit_op = findOperatorFor(opname);
   if (jit_op) {
-    fn = [jit_op](Stack& stack) { jit_op->getOperation()(stack); };
+    // Resolve the operation once here; getOperation() copies the underlying
+    // std::function, which is too expensive to do per executed instruction.
+    auto op_fn = jit_op->getOperation();
+    fn = [op_fn](Stack& stack) { op_fn(stack); };
   } else {
     auto op = c10::Dispatcher::singleton().findSchema(opname_c10);
     if (op.has_value()) {
@@ -46,7 +80,11 @@ bool Function::append_operator(
     }
   }
 
-  code_->operators_.emplace_back(fn);
+  {
+    std::lock_guard<std::mutex> lock(resolvedOperatorsMutex());
+    resolvedOperators().emplace(opname, fn);
+  }
+  code_->operators_.emplace_back(std::move(fn));
   return true;
 }
 
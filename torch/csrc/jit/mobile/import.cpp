@@ -82,73 +82,85 @@ void print_unsupported_ops_and_throw(
   TORCH_CHECK(false, "Following ops cannot be found:", error_message);
 }
 
-void parseMethods(
-    const std::vector<IValue>& vals,
-    mobile::CompilationUnit& mcu) {
-  for (const auto& element : vals) {
-    const auto& m_tuple = element.toTuple()->elements();
-    const std::string& function_name = m_tuple[0].toStringRef();
-    IValue table = m_tuple[1];
-
-    auto function = std::unique_ptr<mobile::Function>(
-        new mobile::Function(c10::QualifiedName(function_name)));
-
-    const auto& ins_list =
-        expect_field(table, "instructions", BYTECODE_INDEX_INSTRUCTION)
-            .toTuple()
-            ->elements();
-    const auto& ops_list =
-        expect_field(table, "operators", BYTECODE_INDEX_OPERATOR)
-            .toTuple()
-            ->elements();
-    const auto& consts_list =
-        expect_field(table, "constants", BYTECODE_INDEX_CONSTANT)
-            .toTuple()
-            ->elements();
-    const auto& types_list =
-        expect_field(table, "types", BYTECODE_INDEX_TYPE).toTuple()->elements();
-    const auto& register_size = expect_field(table, "register_size", 4).toInt();
+std::unique_ptr<mobile::Function> parseMethod(const IValue& element) {
+  const auto& m_tuple = element.toTuple()->elements();
+  const std::string& function_name = m_tuple[0].toStringRef();
+  IValue table = m_tuple[1];
+
+  auto function = std::unique_ptr<mobile::Function>(
+      new mobile::Function(c10::QualifiedName(function_name)));
+
+  const auto& ins_list =
+      expect_field(table, "instructions", BYTECODE_INDEX_INSTRUCTION)
+          .toTuple()
+          ->elements();
+  const auto& ops_list =
+      expect_field(table, "operators", BYTECODE_INDEX_OPERATOR)
+          .toTuple()
+          ->elements();
+  const auto& consts_list =
+      expect_field(table, "constants", BYTECODE_INDEX_CONSTANT)
+          .toTuple()
+          ->elements();
+  const auto& types_list =
+      expect_field(table, "types", BYTECODE_INDEX_TYPE).toTuple()->elements();
+  const auto& register_size = expect_field(table, "register_size", 4).toInt();
+
+  for (const auto& ins : ins_list) {
+    auto ins_item = ins.toTuple()->elements();
+    TORCH_CHECK(
+        ins_item.size() == 3,
+        "There should be three parts in an instruction.");
+    OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
+    int X = ins_item[1].toInt();
+    int N = ins_item[2].toInt();
+    function->append_instruction(op_code, X, N);
+  }
 
-    for (const auto& ins : ins_list) {
-      auto ins_item = ins.toTuple()->elements();
-      TORCH_CHECK(
-          ins_item.size() == 3,
-          "There should be three parts in an instruction.");
-      OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
-      int X = ins_item[1].toInt();
-      int N = ins_item[2].toInt();
-      function->append_instruction(op_code, X, N);
+  std::unordered_set<std::string> unsupported_op_names;
+  for (const auto& op : ops_list) {
+    auto op_item = op.toTuple()->elements();
+    TORCH_CHECK(
+        op_item.size() == 2,
+        "There should be two parts in an operator name.");
+    auto op_found = function->append_operator(
+        op_item[0].toString()->string(), op_item[1].toString()->string());
+    if (!op_found) {
+      unsupported_op_names.emplace(operator_str(
+          op_item[0].toString()->string(), op_item[1].toString()->string()));
     }
+  }
 
-    std::unordered_set<std::string> unsupported_op_names;
-    for (const auto& op : ops_list) {
-      auto op_item = op.toTuple()->elements();
-      TORCH_CHECK(
-          op_item.size() == 2,
-          "There should be two parts in an operator name.");
-      auto op_found = function->append_operator(
-          op_item[0].toString()->string(), op_item[1].toString()->string());
-      if (!op_found) {
-        unsupported_op_names.emplace(operator_str(
-            op_item[0].toString()->string(), op_item[1].toString()->string()));
-      }
-    }
+  if (!unsupported_op_names.empty()) {
+    print_unsupported_ops_and_throw(unsupported_op_names);
+  };
 
-    if (!unsupported_op_names.empty()) {
-      print_unsupported_ops_and_throw(unsupported_op_names);
-    };
+  for (const auto& constant : consts_list) {
+    function->append_constant(constant);
+  }
 
-    for (const auto& constant : consts_list) {
-      function->append_constant(constant);
-    }
+  for (const auto& t : types_list) {
+    function->append_type(c10::parseType(t.toStringRef()));
+  }
 
-    for (const auto& t : types_list) {
-      function->append_type(c10::parseType(t.toStringRef()));
-    }
+  function->set_register_size(register_size);
 
-    function->set_register_size(register_size);
+  return function;
+}
 
-    mcu.register_function(std::move(function));
+void parseMethods(
+    const std::vector<IValue>& vals,
+    mobile::CompilationUnit& mcu) {
+  for (const auto& element : vals) {
+    const std::string& function_name =
+        element.toTuple()->elements()[0].toStringRef();
+    // Parsing a method (operator resolution, type parsing) dominates load
+    // time, so defer it until the method is first looked up; app startup
+    // then only pays for the methods it actually calls. The element tuple
+    // is refcounted, so holding it in the parser closure is cheap.
+    mcu.register_lazy_function(
+        c10::QualifiedName(function_name),
+        [element]() { return parseMethod(element); });
   }
 }
 
@@ -157,6 +169,7 @@ class BytecodeDeserializer final {
  public:
   explicit BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader> reader);
   mobile::Module deserialize(c10::optional<at::Device> device);
+  std::vector<std::string> deserialize_operator_list();
 
  private:
   c10::IValue readArchive(
@@ -183,6 +196,35 @@ mobile::Module BytecodeDeserializer::deserialize(
   return mobile::Module(readArchive("data", mcu).toObject(), mcu);
 }
 
+std::vector<std::string> BytecodeDeserializer::deserialize_operator_list() {
+  // Only the bytecode archive is read; the operators are collected from the
+  // method tables without being resolved, so missing kernels do not throw.
+  auto mcu = std::make_shared<mobile::CompilationUnit>();
+  auto bvals = readArchive("bytecode", mcu).toTuple()->elements();
+
+  std::vector<std::string> op_names;
+  std::unordered_set<std::string> seen;
+  for (const auto& element : bvals) {
+    IValue table = element.toTuple()->elements()[1];
+    const auto& ops_list =
+        expect_field(table, "operators", BYTECODE_INDEX_OPERATOR)
+            .toTuple()
+            ->elements();
+    for (const auto& op : ops_list) {
+      auto op_item = op.toTuple()->elements();
+      TORCH_CHECK(
+          op_item.size() == 2,
+          "There should be two parts in an operator name.");
+      auto op_name = operator_str(
+          op_item[0].toString()->string(), op_item[1].toString()->string());
+      if (seen.insert(op_name).second) {
+        op_names.push_back(std::move(op_name));
+      }
+    }
+  }
+  return op_names;
+}
+
 c10::IValue BytecodeDeserializer::readArchive(
     const std::string& archive_name,
     std::shared_ptr<mobile::CompilationUnit> mcu) {
@@ -279,9 +321,12 @@ mobile::Module _load_for_mobile(
 mobile::Module _load_for_mobile(
     const std::string& filename,
     c10::optional<at::Device> device) {
-  std::unique_ptr<FileAdapter> rai = std::make_unique<FileAdapter>(filename);
-  auto module = _load_for_mobile(std::move(rai), device);
-  return module;
+  // Opening the archive by file name lets the stream reader mmap it, so
+  // tensor records come back as pointers into the mapping and their pages
+  // are only faulted in when a method actually touches them.
+  auto reader = torch::make_unique<PyTorchStreamReader>(filename);
+  BytecodeDeserializer deserializer(std::move(reader));
+  return deserializer.deserialize(device);
 }
 
 mobile::Module _load_for_mobile(
@@ -292,5 +337,11 @@ mobile::Module _load_for_mobile(
   return deserializer.deserialize(device);
 }
 
+std::vector<std::string> _export_operator_list(const std::string& filename) {
+  auto reader = torch::make_unique<PyTorchStreamReader>(filename);
+  BytecodeDeserializer deserializer(std::move(reader));
+  return deserializer.deserialize_operator_list();
+}
+
 } // namespace jit
 } // namespace torch
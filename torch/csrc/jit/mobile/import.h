@@ -23,5 +23,13 @@ TORCH_API mobile::Module _load_for_mobile(
 TORCH_API mobile::Module _load_for_mobile(
     std::unique_ptr<ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt);
+
+// Returns the root operator names ("name.overload_name") referenced by the
+// bytecode of the mobile model in `filename`, in first-use order. The
+// operators are not resolved or run, so the extracting build does not need
+// the listed kernels to be present; the list is the expected input for
+// selective builds (SELECTED_OP_LIST).
+TORCH_API std::vector<std::string> _export_operator_list(
+    const std::string& filename);
 } // namespace jit
 } // namespace torch
@@ -22,12 +22,52 @@ void CompilationUnit::register_function(std::unique_ptr<Function> fn) {
   methods_.emplace_back(std::move(fn));
 }
 
+void CompilationUnit::register_lazy_function(
+    c10::QualifiedName qn,
+    std::function<std::unique_ptr<Function>()> parser) {
+  pending_methods_.emplace_back(std::move(qn), std::move(parser));
+}
+
+Function* CompilationUnit::materialize(size_t idx) {
+  auto parser = std::move(pending_methods_[idx].second);
+  pending_methods_.erase(pending_methods_.begin() + idx);
+  methods_.emplace_back(parser());
+  return methods_.back().get();
+}
+
+std::vector<std::unique_ptr<Function>>& CompilationUnit::methods() {
+  while (!pending_methods_.empty()) {
+    materialize(pending_methods_.size() - 1);
+  }
+  return methods_;
+}
+
 Function* CompilationUnit::find_function(const c10::QualifiedName& qn) {
   for (auto& fn : methods_) {
     if (fn->qualname() == qn) {
       return fn.get();
     }
   }
+  for (size_t i = 0; i < pending_methods_.size(); ++i) {
+    if (pending_methods_[i].first == qn) {
+      return materialize(i);
+    }
+  }
+  return nullptr;
+}
+
+Function* CompilationUnit::find_function_by_basename(
+    const std::string& basename) {
+  for (auto& fn : methods_) {
+    if (fn->name() == basename) {
+      return fn.get();
+    }
+  }
+  for (size_t i = 0; i < pending_methods_.size(); ++i) {
+    if (pending_methods_[i].first.name() == basename) {
+      return materialize(i);
+    }
+  }
   return nullptr;
 }
 
@@ -60,12 +100,11 @@ c10::IValue Module::run_method(const std::string& method_name, Stack stack) {
 }
 
 Function* Module::find_method(const std::string& basename) const {
-  for (auto& fn : cu_->methods()) {
-    if (fn->name() == basename) {
-      return fn.get();
-    }
+  auto fn = cu_->find_function_by_basename(basename);
+  if (fn == nullptr) {
+    AT_ERROR("Method '", basename, "' is not defined.");
   }
-  AT_ERROR("Method '", basename, "' is not defined.");
+  return fn;
 }
 
 namespace {
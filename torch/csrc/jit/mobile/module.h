@@ -2,6 +2,8 @@
 //#include <ATen/core/function_schema.h>
 #include <torch/csrc/jit/mobile/function.h>
 
+#include <functional>
+
 namespace torch {
 namespace jit {
 namespace mobile {
@@ -10,13 +12,23 @@ using Stack = std::vector<c10::IValue>;
 class CompilationUnit {
  public:
   void register_function(std::unique_ptr<Function> fn);
-  std::vector<std::unique_ptr<Function>>& methods() {
-    return methods_;
-  }
+  // Registers a method without parsing its bytecode. `parser` builds the
+  // function and is invoked the first time the method is looked up, so
+  // loading a model only pays for the methods it actually runs.
+  void register_lazy_function(
+      c10::QualifiedName qn,
+      std::function<std::unique_ptr<Function>()> parser);
+  // Parses any still-pending methods, then returns the full list.
+  std::vector<std::unique_ptr<Function>>& methods();
   Function* find_function(const c10::QualifiedName& qn);
+  Function* find_function_by_basename(const std::string& basename);
 
  private:
+  Function* materialize(size_t idx);
   std::vector<std::unique_ptr<Function>> methods_;
+  std::vector<
+      std::pair<c10::QualifiedName, std::function<std::unique_ptr<Function>()>>>
+      pending_methods_;
 };
 
 class TORCH_API Module {
@@ -11,6 +11,7 @@
 
 #include <ATen/ATen.h>
 #include <algorithm>
+#include <map>
 #include <unordered_map>
 
 namespace torch {
@@ -315,13 +316,81 @@ bool shape_is_fast_for_side(const at::Tensor& other_side_input) {
   return other_side_input.numel() <= 1024 * 2048;
 }
 
+// Note [Side batching beyond plain mm]
+// Side batching also understands the add+mm and batched GEMM families, so
+// per-head addmm/baddbmm chains that share one operand (the classic
+// multi-head attention projection pattern) collapse into a single wide
+// GEMM. We only take addmm/baddbmm with beta == alpha == 1 (the form the
+// frontend emits for linear layers); the bias is applied per chunk after
+// the fused multiply, which is exactly what addmm would have computed.
+// The shared operand can be on either side; for the batched family the
+// concat/chunk dimension simply shifts by one to skip the batch dim.
+enum class GemmKind { MM, AddMM, BMM, BAddBMM };
+
+bool gemm_has_bias(GemmKind kind) {
+  return kind == GemmKind::AddMM || kind == GemmKind::BAddBMM;
+}
+
+bool gemm_is_batched(GemmKind kind) {
+  return kind == GemmKind::BMM || kind == GemmKind::BAddBMM;
+}
+
+// index of the lhs matrix operand; bias-bearing variants put the bias first
+size_t gemm_lhs_offset(GemmKind kind) {
+  return gemm_has_bias(kind) ? 1 : 0;
+}
+
+c10::optional<GemmKind> gemm_kind(Node* node) {
+  if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    return GemmKind::MM;
+  }
+  if (node->matches("aten::bmm(Tensor self, Tensor mat2) -> Tensor")) {
+    return GemmKind::BMM;
+  }
+  if (node->matches(
+          "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta, Scalar alpha) -> Tensor",
+          /*const_inputs=*/{attr::beta, attr::alpha})) {
+    if (node->get<at::Scalar>(attr::beta)->toDouble() == 1.0 &&
+        node->get<at::Scalar>(attr::alpha)->toDouble() == 1.0) {
+      return GemmKind::AddMM;
+    }
+    return c10::nullopt;
+  }
+  if (node->matches(
+          "aten::baddbmm(Tensor self, Tensor batch1, Tensor batch2, *, Scalar beta, Scalar alpha) -> Tensor",
+          /*const_inputs=*/{attr::beta, attr::alpha})) {
+    if (node->get<at::Scalar>(attr::beta)->toDouble() == 1.0 &&
+        node->get<at::Scalar>(attr::alpha)->toDouble() == 1.0) {
+      return GemmKind::BAddBMM;
+    }
+    return c10::nullopt;
+  }
+  return c10::nullopt;
+}
+
 RegisterOperators mm_batch_side_reg({Operator(
     prim::MMBatchSide,
     [](const Node* node) -> Operation {
-      size_t num_other_side_inputs = node->inputs().size() - 1;
       Side single_side = static_cast<Side>(node->i(Symbol::attr("side")));
-      return [num_other_side_inputs, single_side](Stack& stack) {
+      bool has_bias = node->i(Symbol::attr("has_bias"));
+      bool is_batched = node->i(Symbol::attr("is_batched"));
+      size_t num_other_side_inputs = node->inputs().size() - 1;
+      if (has_bias) {
+        num_other_side_inputs /= 2;
+      }
+      return [num_other_side_inputs, single_side, has_bias, is_batched](
+                 Stack& stack) {
         at::Tensor side_input;
+        std::vector<at::Tensor> biases;
+        if (has_bias) {
+          biases.reserve(num_other_side_inputs);
+          for (auto it = stack.end() - num_other_side_inputs;
+               it != stack.end();
+               ++it) {
+            biases.push_back(std::move(*it).toTensor());
+          }
+          drop(stack, num_other_side_inputs);
+        }
         std::vector<at::Tensor> other_side_inputs;
         other_side_inputs.reserve(num_other_side_inputs);
         for (auto it = stack.end() - num_other_side_inputs; it != stack.end();
@@ -331,31 +400,43 @@ RegisterOperators mm_batch_side_reg({Operator(
         drop(stack, num_other_side_inputs);
         pop(stack, side_input);
 
-        auto any_other_input = other_side_inputs[0];
+        // for the batched family the concat dim shifts past the batch dim
+        int64_t cat_dim =
+            (single_side == Side::LHS ? 1 : 0) + (is_batched ? 1 : 0);
         if (have_same_shape(other_side_inputs) &&
             shape_is_fast_for_side(other_side_inputs[0])) {
-          auto other_side_input =
-              at::cat(other_side_inputs, single_side == Side::LHS ? 1 : 0);
-          auto mm_out = single_side == Side::LHS
-              ? side_input.mm(other_side_input)
-              : other_side_input.mm(side_input);
-          auto outputs = at::chunk(
-              mm_out,
-              num_other_side_inputs,
-              /*dim=*/single_side == Side::LHS ? 1 : 0);
-          stack.insert(
-              stack.end(),
-              std::make_move_iterator(outputs.begin()),
-              std::make_move_iterator(outputs.end()));
-        } else {
-          if (single_side == Side::LHS) {
-            for (at::Tensor& other : other_side_inputs) {
-              stack.emplace_back(side_input.mm(other));
-            }
+          auto other_side_input = at::cat(other_side_inputs, cat_dim);
+          at::Tensor mm_out;
+          if (is_batched) {
+            mm_out = single_side == Side::LHS
+                ? side_input.bmm(other_side_input)
+                : other_side_input.bmm(side_input);
           } else {
-            for (at::Tensor& other : other_side_inputs) {
-              stack.emplace_back(other.mm(side_input));
+            mm_out = single_side == Side::LHS
+                ? side_input.mm(other_side_input)
+                : other_side_input.mm(side_input);
+          }
+          auto outputs = at::chunk(mm_out, num_other_side_inputs, cat_dim);
+          for (size_t i = 0; i < outputs.size(); ++i) {
+            if (has_bias) {
+              // chunks are disjoint views, so the adds don't interfere
+              outputs[i].add_(biases[i]);
+            }
+            stack.emplace_back(std::move(outputs[i]));
+          }
+        } else {
+          for (size_t i = 0; i < other_side_inputs.size(); ++i) {
+            const at::Tensor& lhs = single_side == Side::LHS
+                ? side_input
+                : other_side_inputs[i];
+            const at::Tensor& rhs = single_side == Side::LHS
+                ? other_side_inputs[i]
+                : side_input;
+            auto out = is_batched ? lhs.bmm(rhs) : lhs.mm(rhs);
+            if (has_bias) {
+              out.add_(biases[i]);
             }
+            stack.emplace_back(std::move(out));
           }
         }
 
@@ -364,9 +445,12 @@ RegisterOperators mm_batch_side_reg({Operator(
     },
     aliasAnalysisIsSpecialCase())});
 
-std::pair<std::vector<Node*>, std::vector<Node*>> gatherIndependentMMUses(
-    Value* value,
-    AliasDb& alias_db) {
+// Independent same-family uses of `value` as the shared lhs or rhs operand.
+// Grouped by (kind, side) because a fused node can only execute one GEMM
+// family. See Note [Side batching beyond plain mm].
+using GemmUseGroups = std::map<std::pair<GemmKind, Side>, std::vector<Node*>>;
+
+GemmUseGroups gatherIndependentGemmUses(Value* value, AliasDb& alias_db) {
   const auto postprocess = [&](std::vector<Node*> mms) {
     if (mms.size() == 0) {
       return mms;
@@ -392,25 +476,33 @@ std::pair<std::vector<Node*>, std::vector<Node*>> gatherIndependentMMUses(
   };
 
   Block* block = value->node()->owningBlock();
-  std::vector<Node*> lhses; // Will contain nodes where value is used as an lhs
-  std::vector<Node*> rhses; // Like above, but rhs
+  GemmUseGroups groups;
   for (Use u : value->uses()) {
-    if (u.user->owningBlock() == block &&
-        u.user->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
-      if (u.offset == 0 && u.user->inputs()[1] != value) {
-        lhses.push_back(u.user);
-      } else if (u.offset == 1 && u.user->inputs()[0] != value) {
-        rhses.push_back(u.user);
-      }
+    if (u.user->owningBlock() != block) {
+      continue;
+    }
+    auto kind = gemm_kind(u.user);
+    if (!kind) {
+      continue;
+    }
+    size_t lhs_offset = gemm_lhs_offset(*kind);
+    if (u.offset == lhs_offset && u.user->inputs()[lhs_offset + 1] != value) {
+      groups[{*kind, Side::LHS}].push_back(u.user);
+    } else if (
+        u.offset == lhs_offset + 1 && u.user->inputs()[lhs_offset] != value) {
+      groups[{*kind, Side::RHS}].push_back(u.user);
     }
   }
-  return std::make_pair(postprocess(lhses), postprocess(rhses));
+  for (auto& group : groups) {
+    group.second = postprocess(std::move(group.second));
+  }
+  return groups;
 }
 
 void BatchMMSide(Block* block, AliasDb& alias_db) {
   // NB: 8 is the current loop unrolling factor
   static constexpr size_t how_many_is_many = 8;
-  const auto batch_side = [&](std::vector<Node*>& mms, Side side) {
+  const auto batch_side = [&](std::vector<Node*>& mms, GemmKind kind, Side side) {
     AT_ASSERT(!mms.empty());
     for (int64_t i = static_cast<int64_t>(mms.size()) - 2; i >= 0; --i) {
       bool move_ok = alias_db.moveBeforeTopologicallyValid(mms[i], mms[i + 1]);
@@ -424,27 +516,36 @@ void BatchMMSide(Block* block, AliasDb& alias_db) {
         /*num_outputs=*/mms.size());
     graph->insertNode(batch_mm);
     batch_mm->i_(Symbol::attr("side"), static_cast<int>(side));
-    Value* const_side = mms[0]->inputs().at(side == Side::LHS ? 0 : 1);
+    batch_mm->i_(Symbol::attr("has_bias"), gemm_has_bias(kind));
+    batch_mm->i_(Symbol::attr("is_batched"), gemm_is_batched(kind));
+    size_t lhs_offset = gemm_lhs_offset(kind);
+    Value* const_side =
+        mms[0]->inputs().at(side == Side::LHS ? lhs_offset : lhs_offset + 1);
     batch_mm->addInput(const_side);
     for (size_t i = 0; i < mms.size(); ++i) {
-      batch_mm->addInput(mms[i]->inputs().at(side == Side::LHS ? 1 : 0));
+      batch_mm->addInput(
+          mms[i]->inputs().at(side == Side::LHS ? lhs_offset + 1 : lhs_offset));
       mms[i]->output()->replaceAllUsesWith(batch_mm->outputs().at(i));
     }
+    if (gemm_has_bias(kind)) {
+      for (Node* mm : mms) {
+        batch_mm->addInput(mm->inputs().at(0));
+      }
+    }
   };
 
   std::unordered_set<Value*> considered_values;
   for (Node* node : block->nodes()) {
-    if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    if (gemm_kind(node)) {
       for (Value* input : node->inputs()) {
         if (/*bool not_inserted = */ !considered_values.emplace(input).second) {
           continue;
         }
-        auto uses_with_many = gatherIndependentMMUses(input, alias_db);
-        if (uses_with_many.first.size() >= how_many_is_many) {
-          batch_side(uses_with_many.first, Side::LHS);
-        }
-        if (uses_with_many.second.size() >= how_many_is_many) {
-          batch_side(uses_with_many.second, Side::RHS);
+        auto groups = gatherIndependentGemmUses(input, alias_db);
+        for (auto& group : groups) {
+          if (group.second.size() >= how_many_is_many) {
+            batch_side(group.second, group.first.first, group.first.second);
+          }
         }
       }
     } else {
@@ -48,5 +48,46 @@ void FuseLinear(std::shared_ptr<Graph>& graph) {
       matmul_pattern, fused_linear_bias_none);
   matmul_to_linear.runOnGraph(graph);
 }
+
+void FuseLinearActivation(std::shared_ptr<Graph>& graph) {
+  // Both the functional and the in-place flavor of each activation are
+  // matched; the fused op always writes the activation in place on the
+  // linear output, so the rewrite is valid for either.
+  for (const std::string activation : {"relu", "gelu", "sigmoid"}) {
+    std::string linear_activation_pattern = R"IR(
+      graph(%input, %weight, %bias):
+          %linear_out = aten::linear(%input, %weight, %bias)
+          %res = aten::)IR" + activation + R"IR((%linear_out)
+          return (%res))IR";
+    std::string linear_activation_inplace_pattern = R"IR(
+      graph(%input, %weight, %bias):
+          %linear_out = aten::linear(%input, %weight, %bias)
+          %res = aten::)IR" + activation + R"IR(_(%linear_out)
+          return (%res))IR";
+    std::string fused_linear_activation = R"IR(
+      graph(%input, %weight, %bias):
+          %activation : str = prim::Constant[value=")IR" + activation + R"IR("]()
+          %res = aten::_linear_with_activation(%input, %weight, %bias, %activation)
+          return (%res))IR";
+
+    // Only fuse when the activation is the sole consumer of the linear
+    // output; otherwise the intermediate result is still observable.
+    auto single_use_filter =
+        [](const Match& match,
+           const std::unordered_map<std::string, Value*>& vmap) {
+          return match.values_map.at(vmap.at("linear_out"))->uses().size() == 1;
+        };
+
+    SubgraphRewriter rewriter;
+    rewriter.RegisterRewritePattern(
+        linear_activation_pattern, fused_linear_activation);
+    if (activation != "gelu") {
+      // gelu has no in-place variant
+      rewriter.RegisterRewritePattern(
+          linear_activation_inplace_pattern, fused_linear_activation);
+    }
+    rewriter.runOnGraph(graph, single_use_filter);
+  }
+}
 } // namespace jit
 } // namespace torch
@@ -13,5 +13,13 @@ namespace jit {
  * This pass can be deleted once the JIT can emit the aten::linear in the future
  */
 TORCH_API void FuseLinear(std::shared_ptr<Graph>& graph);
+
+/** \brief Fuse aten::linear followed by relu/gelu/sigmoid into
+ * aten::_linear_with_activation, which applies the activation as an epilogue
+ * of the linear instead of a separate pass over the output.
+ * Only valid for inference graphs (the fused op has no derivative), so it is
+ * meant to run on frozen modules after FuseLinear.
+ */
+TORCH_API void FuseLinearActivation(std::shared_ptr<Graph>& graph);
 } // namespace jit
 } // namespace torch
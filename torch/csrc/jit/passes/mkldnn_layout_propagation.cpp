@@ -0,0 +1,187 @@
+#include <torch/csrc/jit/passes/mkldnn_layout_propagation.h>
+
+#include <ATen/ATen.h>
+#include <torch/csrc/jit/ir/constants.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool isConstantFloatCpuTensor(Value* v, int64_t dim) {
+  auto ival = toIValue(v);
+  if (!ival || !ival->isTensor()) {
+    return false;
+  }
+  const auto& t = ival->toTensor();
+  return t.defined() && t.device().type() == c10::DeviceType::CPU &&
+      t.scalar_type() == at::kFloat && t.dim() == dim && !t.requires_grad();
+}
+
+// mkldnn add/mul do not broadcast, so elementwise ops are only converted
+// when both operands are statically known to have the same sizes.
+bool haveSameConcreteSizes(Value* a, Value* b) {
+  auto type_a = a->type()->cast<TensorType>();
+  auto type_b = b->type()->cast<TensorType>();
+  if (!type_a || !type_b) {
+    return false;
+  }
+  auto sizes_a = type_a->sizes().concrete_sizes();
+  auto sizes_b = type_b->sizes().concrete_sizes();
+  return sizes_a && sizes_b && *sizes_a == *sizes_b;
+}
+
+class MkldnnLayoutPropagation {
+ public:
+  explicit MkldnnLayoutPropagation(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  void run() {
+    collectConvertibleNodes();
+    if (converted_nodes_.empty()) {
+      return;
+    }
+    insertInputConversions();
+    insertOutputConversions();
+  }
+
+ private:
+  bool isMkldnn(Value* v) const {
+    return mkldnn_values_.count(v) != 0;
+  }
+
+  // Whether this node can run on mkldnn tensors given which values are
+  // already in blocked layout. conv2d and linear seed regions: converting
+  // their activation is worth it even when it is dense, and their constant
+  // weights can stay dense since the kernels reorder them through the
+  // prepack cache. All other ops only extend an existing region.
+  bool isConvertible(Node* node) {
+    switch (node->kind()) {
+      case aten::conv2d:
+        return isConstantFloatCpuTensor(node->input(1), /*dim=*/4);
+      case aten::linear:
+        return isConstantFloatCpuTensor(node->input(1), /*dim=*/2);
+      case aten::relu:
+      case aten::sigmoid:
+      case aten::max_pool2d:
+      case aten::adaptive_avg_pool2d:
+        return isMkldnn(node->input(0));
+      case aten::avg_pool2d:
+        // mkldnn_avg_pool2d rejects divisor_override
+        return isMkldnn(node->input(0)) && node->input(6)->mustBeNone();
+      case aten::add:
+      case aten::mul: {
+        if (node->inputs().size() < 2 ||
+            !node->input(1)->type()->isSubtypeOf(TensorType::get())) {
+          return false; // Scalar variant
+        }
+        return isMkldnn(node->input(0)) && isMkldnn(node->input(1)) &&
+            haveSameConcreteSizes(node->input(0), node->input(1));
+      }
+      case aten::cat: {
+        Node* list = node->input(0)->node();
+        if (list->kind() != prim::ListConstruct || list->inputs().empty() ||
+            list->output()->uses().size() != 1) {
+          return false;
+        }
+        for (Value* v : list->inputs()) {
+          if (!isMkldnn(v)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  void collectConvertibleNodes() {
+    // Only the top-level block is considered; control flow is rare in
+    // frozen CNN inference graphs and stays in dense layout.
+    for (Node* node : graph_->block()->nodes()) {
+      if (!isConvertible(node)) {
+        continue;
+      }
+      converted_nodes_.push_back(node);
+      converted_set_.insert(node);
+      if (node->kind() == aten::cat) {
+        // The list construct feeding a converted cat consumes mkldnn
+        // values directly; mark it so no to_dense is inserted for them.
+        converted_set_.insert(node->input(0)->node());
+      }
+      mkldnn_values_.insert(node->output(0));
+    }
+  }
+
+  // Convert the dense activations flowing into region seeds. The
+  // conversion is memoized per value and inserted before its first
+  // converted user, which dominates all later ones.
+  void insertInputConversions() {
+    for (Node* node : converted_nodes_) {
+      if (node->kind() != aten::conv2d && node->kind() != aten::linear) {
+        continue;
+      }
+      Value* activation = node->input(0);
+      if (isMkldnn(activation)) {
+        continue;
+      }
+      auto it = to_mkldnn_memo_.find(activation);
+      if (it == to_mkldnn_memo_.end()) {
+        WithInsertPoint guard(node);
+        Value* converted =
+            graph_->insert(Symbol::aten("to_mkldnn"), {activation});
+        it = to_mkldnn_memo_.emplace(activation, converted).first;
+      }
+      node->replaceInput(0, it->second);
+    }
+  }
+
+  // Convert region outputs back to dense layout, but only for the uses
+  // that actually leave the region (including graph outputs).
+  void insertOutputConversions() {
+    for (Node* node : converted_nodes_) {
+      for (Value* output : node->outputs()) {
+        if (!isMkldnn(output)) {
+          continue;
+        }
+        std::vector<Use> dense_uses;
+        for (const Use& use : output->uses()) {
+          if (converted_set_.count(use.user) == 0) {
+            dense_uses.push_back(use);
+          }
+        }
+        if (dense_uses.empty()) {
+          continue;
+        }
+        WithInsertPoint guard(node->next());
+        Value* dense = graph_->insert(Symbol::aten("to_dense"), {output});
+        for (const Use& use : dense_uses) {
+          use.user->replaceInput(use.offset, dense);
+        }
+      }
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  std::vector<Node*> converted_nodes_;
+  std::unordered_set<Node*> converted_set_;
+  std::unordered_set<Value*> mkldnn_values_;
+  std::unordered_map<Value*, Value*> to_mkldnn_memo_;
+};
+
+} // namespace
+
+void PropagateMkldnnLayout(std::shared_ptr<Graph>& graph) {
+  if (!at::hasMKLDNN()) {
+    return;
+  }
+  MkldnnLayoutPropagation(graph).run();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,26 @@
+/** \brief Keep frozen fp32 CPU inference graphs in MKL-DNN blocked layout.
+ *
+ * Mixed graphs bounce between dense and mkldnn layouts because every op
+ * without an MkldnnCPU kernel forces a to_dense conversion. This pass finds
+ * regions of mkldnn-supported ops seeded by convolutions (and linears) with
+ * constant float weights, keeps the activations in blocked layout inside
+ * each region, and inserts to_mkldnn/to_dense conversions only at the
+ * region boundaries.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Propagate MKL-DNN layout through supported regions of the graph.
+ *
+ * Intended to run on a frozen, inference-only graph (see freeze_module);
+ * it assumes weights are constants and does not touch control flow blocks.
+ * No-op when ATen is built without MKL-DNN support.
+ */
+TORCH_API void PropagateMkldnnLayout(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
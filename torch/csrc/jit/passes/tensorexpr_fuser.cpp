@@ -54,6 +54,16 @@ value_list sortReverseTopological(
 }
 
 bool isSupported(Node* node) {
+  // Reductions are only lowered when their dims are compile-time constants;
+  // see TensorExprKernel::computeSum and computeSoftmax.
+  if (node->kind() == aten::sum || node->kind() == aten::softmax) {
+    for (size_t i = 1; i < node->inputs().size(); i++) {
+      if (node->inputs()[i]->node()->kind() != prim::Constant) {
+        return false;
+      }
+    }
+    return true;
+  }
   // TODO:
   switch (node->kind()) {
     case aten::add:
@@ -6,6 +6,7 @@
 #include <torch/csrc/jit/frontend/ir_emitter.h>
 #include <torch/csrc/jit/frontend/tracer.h>
 #include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/canonicalize.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
@@ -25,6 +26,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/mkldnn_layout_propagation.h>
 #include <torch/csrc/jit/passes/onnx.h>
 #include <torch/csrc/jit/passes/onnx/cast_all_constant_to_floating.h>
 #include <torch/csrc/jit/passes/onnx/constant_fold.h>
@@ -55,6 +57,7 @@
 #include <torch/csrc/jit/runtime/argument_spec.h>
 #include <torch/csrc/jit/runtime/autodiff.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/csrc/jit/runtime/profiling_record.h>
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/csrc/jit/runtime/print_handler.h>
@@ -214,6 +217,8 @@ void initJITBindings(PyObject* module) {
           [](Module& module) { return freeze_module(module); },
           py::arg("module"))
       .def("_jit_pass_fuse_linear", &FuseLinear)
+      .def("_jit_pass_fuse_linear_activation", &FuseLinearActivation)
+      .def("_jit_pass_propagate_mkldnn_layout", &PropagateMkldnnLayout)
       .def(
           "_jit_pass_fold_quantize",
           [](Module& module, const std::string& method_name) {
@@ -426,6 +431,28 @@ void initJITBindings(PyObject* module) {
             getBailoutDepth() = depth;
             return old_depth;
           })
+      .def(
+          "_jit_set_node_runtime_stats",
+          [](bool enabled) {
+            bool old_state = getProfilingNodeRuntimeStats();
+            getProfilingNodeRuntimeStats() = enabled;
+            return old_state;
+          })
+      .def(
+          "_jit_set_shape_bucketing",
+          [](bool enabled) {
+            bool old_state = getArgumentSpecShapeBucketing();
+            getArgumentSpecShapeBucketing() = enabled;
+            return old_state;
+          })
+      .def(
+          "_jit_set_log_ring_enabled",
+          [](bool enabled) {
+            bool old_state = jit_log_ring_enabled();
+            set_jit_log_ring_enabled(enabled);
+            return old_state;
+          })
+      .def("_jit_log_ring_dump", []() { return jit_log_ring_dump(); })
       .def(
           "_jit_set_inline_everything_mode",
           [](bool enabled) { getInlineEverythingMode() = enabled; })
@@ -571,6 +598,12 @@ void initJITBindings(PyObject* module) {
       .def_property_readonly(
           "df_output_vjps", [](Gradient& m) { return m.df_output_vjps; });
 
+  py::class_<NodeRuntimeStats>(m, "NodeRuntimeStats")
+      .def_readonly("count", &NodeRuntimeStats::count)
+      .def_readonly("cumulative_ns", &NodeRuntimeStats::cumulative_ns)
+      .def_readonly("last_ns", &NodeRuntimeStats::last_ns)
+      .def_readonly("observed_shapes", &NodeRuntimeStats::observed_shapes);
+
   py::class_<GraphExecutorState>(m, "GraphExecutorState")
       .def_property_readonly(
           "graph", [](GraphExecutorState& s) { return s.graph; })
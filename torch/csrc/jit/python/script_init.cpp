@@ -19,6 +19,7 @@
 #include <torch/csrc/jit/python/python_tracer.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
 #include <torch/csrc/jit/runtime/logging.h>
+#include <torch/csrc/jit/runtime/profiling_record.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import_source.h>
 #include <torch/csrc/jit/serialization/python_print.h>
@@ -34,6 +35,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <memory>
@@ -214,6 +216,28 @@ FunctionDefaults calcOverloadedFunctionDefaults(
   return updated_defaults;
 }
 
+// Renders the executor's per-node runtime statistics as (node IR line,
+// stats) pairs; node pointers themselves are not stable enough to expose
+// to Python.
+std::vector<std::pair<std::string, NodeRuntimeStats>> nodeRuntimeStatsList(
+    GraphExecutor& executor) {
+  std::vector<std::pair<std::string, NodeRuntimeStats>> result;
+  for (const auto& entry : executor.getNodeRuntimeStats()) {
+    std::ostringstream node_str;
+    node_str << *entry.first;
+    auto str = node_str.str();
+    while (!str.empty() && str.back() == '\n') {
+      str.pop_back();
+    }
+    result.emplace_back(std::move(str), entry.second);
+  }
+  // hottest first
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.second.cumulative_ns > b.second.cumulative_ns;
+  });
+  return result;
+}
+
 } // namespace
 
 bool checkMutableFunctionDefault(const py::object& def_arg) {
@@ -846,6 +870,15 @@ void initJitScriptBindings(PyObject* module) {
             throw std::runtime_error(
                 "Attempted to call get_debug_state on a Module without a compiled forward()");
           })
+      .def(
+          "get_node_runtime_stats",
+          [](Module& self) {
+            if (auto m = self.find_method("forward")) {
+              return nodeRuntimeStatsList(m->get_executor());
+            }
+            throw std::runtime_error(
+                "Attempted to call get_node_runtime_stats on a Module without a compiled forward()");
+          })
       .def(
           "_define",
           [](Module& m,
@@ -1010,6 +1043,11 @@ void initJitScriptBindings(PyObject* module) {
           [](const StrongFunctionPtr& self) {
             return self.function_->get_executor().getDebugState();
           })
+      .def(
+          "get_node_runtime_stats",
+          [](const StrongFunctionPtr& self) {
+            return nodeRuntimeStatsList(self.function_->get_executor());
+          })
       .def_property_readonly(
           "name",
           [](const StrongFunctionPtr& self) { return self.function_->name(); })
@@ -4,6 +4,12 @@
 namespace torch {
 namespace jit {
 
+// See Note [Shape-bucketed argument specs] in argument_spec.h
+std::atomic<bool>& getArgumentSpecShapeBucketing() {
+  static std::atomic<bool> shape_bucketing{false};
+  return shape_bucketing;
+}
+
 void ArgumentSpecCreator::scan(
     const TypePtr& typ,
     size_t depth,
@@ -6,6 +6,7 @@
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/jit/ir/ir.h>
 #include <torch/csrc/utils/hash.h>
+#include <atomic>
 #include <iostream>
 #include <vector>
 
@@ -201,6 +202,33 @@ struct TORCH_API ArgumentSpecCreator {
   std::vector<Inst> instructions_;
 };
 
+// Note [Shape-bucketed argument specs]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// CompleteArgumentSpec keys compiled code on exact sizes and strides, so a
+// serving workload whose batch dimension wanders over 1..256 produces a new
+// spec (and potentially a fresh specialization) for nearly every distinct
+// batch size. When shape bucketing is enabled, sizes and strides are rounded
+// up to the next power of two before they enter the spec, so each dimension
+// contributes at most log2(max_size) distinct buckets and a bounded set of
+// specializations covers all production batch sizes. A bucketed spec is a
+// cache key only: consumers must treat its recorded sizes as upper bounds
+// for the bucket, not as exact shapes. ArgumentSpec is unaffected since it
+// records dimensionality rather than sizes.
+TORCH_API std::atomic<bool>& getArgumentSpecShapeBucketing();
+
+// Rounds a dimension up to the next power of two. 0 and 1 are preserved so
+// broadcast strides and singleton dims keep their identity.
+inline int64_t bucketShapeDim(int64_t dim) {
+  if (dim <= 1) {
+    return dim;
+  }
+  int64_t bucket = 1;
+  while (bucket < dim) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
 // CompleteArgumentSpec represents one particular specialization.
 // It is designed so that it can be created, hashed, and compared quickly
 // since it is used along the hot-path of the JIT to check if the code
@@ -248,6 +276,18 @@ struct CompleteArgumentSpec {
     auto* pods = reinterpret_cast<CompleteArgumentInfoPOD*>(data.data());
     int64_t* next_dim = sizes_strides();
     int32_t total_dims = 0;
+    // See Note [Shape-bucketed argument specs]
+    const bool bucket_shapes = getArgumentSpecShapeBucketing().load();
+    auto append_dims = [&](at::IntArrayRef src) {
+      if (bucket_shapes) {
+        for (auto d : src) {
+          *next_dim++ = bucketShapeDim(d);
+        }
+      } else {
+        std::copy(src.begin(), src.end(), next_dim);
+        next_dim += src.size();
+      }
+    };
     for (int32_t i = 0; i < num_inputs; i++) {
       auto& pod = pods[i];
       pod.is_tensor = static_cast<uint32_t>(inputs[i].isTensor());
@@ -259,12 +299,8 @@ struct CompleteArgumentSpec {
           pod.device = (!t.is_cuda()) ? -1 : t.get_device();
           pod.requires_grad = with_grad && t.requires_grad();
           total_dims += t.ndimension();
-          auto sizes = t.sizes();
-          std::copy(sizes.begin(), sizes.end(), next_dim);
-          next_dim += sizes.size();
-          auto strides = t.strides();
-          std::copy(strides.begin(), strides.end(), next_dim);
-          next_dim += strides.size();
+          append_dims(t.sizes());
+          append_dims(t.strides());
         }
       }
       // each POD has a running tally of all dimensions including its own
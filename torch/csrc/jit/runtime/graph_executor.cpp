@@ -538,7 +538,8 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     if (fallback) {
       state.fallback = fallback;
     }
-    for (auto& entry : plan_cache) {
+    auto cache = std::atomic_load(&plan_cache);
+    for (auto& entry : *cache) {
       state.execution_plans.emplace(entry.first, entry.second);
     }
     return state;
@@ -557,24 +558,48 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     return fallback;
   }
 
-  const ExecutionPlan& getOrCompile(const Stack& stack) {
+  // Note [Lock-free plan cache lookup]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // The plan cache is read on every invocation but written only when a new
+  // spec shows up, so with many serving threads hammering the same `forward`
+  // a mutex-protected table turns steady-state cache hits into a point of
+  // contention. Instead the cache is an immutable map published through an
+  // atomically-loaded shared_ptr: readers grab the current snapshot without
+  // taking a lock, and compilation (still serialized by compile_mutex)
+  // copies the map, inserts the new plan, and publishes the new snapshot.
+  // Plans are returned by value; they are two shared_ptr-sized handles, and
+  // this keeps a plan alive even if its snapshot is replaced mid-run.
+  ExecutionPlan getOrCompile(const Stack& stack) {
     // outside lock guard, to minimize the time holding the lock on the fast
     // path ArgumentSpec even computes its hashCode here.
     ArgumentSpec spec =
         arg_spec_creator_.create(autograd::GradMode::is_enabled(), stack);
+    auto cache = std::atomic_load(&plan_cache);
+    auto it = cache->find(spec);
+    if (it != cache->end()) {
+      logging::getLogger()->addStatValue(
+          logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
+      return it->second;
+    }
     {
       std::lock_guard<std::mutex> lock(compile_mutex);
-      auto it = plan_cache.find(spec);
-      if (it != plan_cache.end()) {
+      // a concurrent compilation may have published this spec while we
+      // were waiting for the lock
+      cache = std::atomic_load(&plan_cache);
+      it = cache->find(spec);
+      if (it != cache->end()) {
         logging::getLogger()->addStatValue(
             logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
         return it->second;
       }
       auto plan = compileSpec(spec);
-      auto r = plan_cache.emplace(std::move(spec), std::move(plan));
+      auto updated = std::make_shared<PlanMap>(*cache);
+      updated->emplace(std::move(spec), plan);
+      std::atomic_store(
+          &plan_cache, std::shared_ptr<const PlanMap>(std::move(updated)));
       logging::getLogger()->addStatValue(
           logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
-      return r.first->second;
+      return plan;
     }
   }
 
@@ -650,8 +675,10 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
   ExecutionPlan fallback;
 
   // Mapping from argument configurations to optimized versions of the graph
-  // that are specialized to the spec.
-  std::unordered_map<ArgumentSpec, ExecutionPlan> plan_cache;
+  // that are specialized to the spec. The map itself is immutable; updates
+  // publish a new snapshot. See Note [Lock-free plan cache lookup].
+  using PlanMap = std::unordered_map<ArgumentSpec, ExecutionPlan>;
+  std::shared_ptr<const PlanMap> plan_cache = std::make_shared<PlanMap>();
 };
 
 GraphExecutor::GraphExecutor(
@@ -692,6 +719,11 @@ GraphExecutorState GraphExecutor::getDebugState() {
   return pImpl->getDebugState();
 }
 
+std::unordered_map<const Node*, NodeRuntimeStats> GraphExecutor::
+    getNodeRuntimeStats() {
+  return pImpl->getNodeRuntimeStats();
+}
+
 TORCH_API bool IsNewExecutorEnabled() {
   static const auto disable_new_executor =
       std::getenv("TORCH_JIT_DISABLE_NEW_EXECUTOR");
@@ -15,6 +15,7 @@ namespace torch {
 namespace jit {
 struct GraphExecutorState;
 struct Code;
+struct NodeRuntimeStats;
 
 struct ExecutionPlan {
   ExecutionPlan() = default;
@@ -70,6 +71,12 @@ struct TORCH_API GraphExecutor {
   std::shared_ptr<Graph> graph() const;
   GraphExecutorState getDebugState();
 
+  // Per-node runtime statistics (execution count, wall times, observed
+  // shapes) collected by the profiling executor during instrumented runs;
+  // only populated when getProfilingNodeRuntimeStats() is set, empty for
+  // the legacy executor. Keys are nodes of the instrumented graph.
+  std::unordered_map<const Node*, NodeRuntimeStats> getNodeRuntimeStats();
+
   static size_t getDefaultNumBailOuts();
 
  private:
@@ -87,6 +94,9 @@ TORCH_API std::atomic<bool>& getProfilingMode();
 TORCH_API std::atomic<bool>& getExecutorMode();
 TORCH_API std::atomic<size_t>& getNumProfiledRuns();
 TORCH_API std::atomic<size_t>& getBailoutDepth();
+// When set, graphs instrumented by the profiling executor additionally
+// collect per-node runtime statistics; see GraphExecutor::getNodeRuntimeStats.
+TORCH_API std::atomic<bool>& getProfilingNodeRuntimeStats();
 TORCH_API bool IsNewExecutorEnabled();
 
 struct TORCH_API GraphOptimizerEnabledGuard {
@@ -72,6 +72,14 @@ struct GraphExecutorImplBase {
       Stack& stack,
       size_t remaining_bailout_depth) = 0;
   virtual GraphExecutorState getDebugState() = 0;
+
+  // Overridden by the profiling executor; the legacy executor collects no
+  // per-node runtime statistics.
+  virtual std::unordered_map<const Node*, NodeRuntimeStats>
+  getNodeRuntimeStats() {
+    return {};
+  }
+
   virtual ~GraphExecutorImplBase() = default;
 
  protected:
@@ -88,8 +96,10 @@ struct GraphExecutorImplBase {
   const size_t num_inputs;
   const size_t num_outputs;
 
-  // GraphExecutors can be accessed from multiple threads, so this thread needs
-  // to be held every time we access the fallback or plan_cache.
+  // GraphExecutors can be accessed from multiple threads, so this mutex
+  // needs to be held every time we access the fallback or compile a new
+  // plan. Plan cache *lookups* are lock-free; see
+  // Note [Lock-free plan cache lookup] in graph_executor.cpp.
   std::mutex compile_mutex;
 };
 
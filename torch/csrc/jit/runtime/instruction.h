@@ -51,7 +51,8 @@ namespace jit {
   _(ISINSTANCE, "TI") /* check object is one of  types[X:X+N]  */           \
   _(TUPLE_SLICE, "II") /* slice tup[X:(X+N)] */                             \
   _(FORK, "CN") /* launch a thread to run code entry x with N inputs  */    \
-  _(WARN, "") /* emit a warning with line information */
+  _(WARN, "") /* emit a warning with line information */                    \
+  _(PRIM_OP, "O") /* invoke direct prim op stub X, see Note [Prim op stubs] */
 
 enum OpCode : uint8_t {
 #define DEFINE_OP(op, _) op,
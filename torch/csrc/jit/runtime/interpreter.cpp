@@ -359,6 +359,127 @@ struct BailoutBlock {
   std::vector<Instruction> instructions; // ends in a TAIL_CALL
 };
 
+// Note: [Prim op stubs]
+// Trivially cheap primitives (int arithmetic, comparisons, tuple indexing,
+// ...) spend a meaningful part of their runtime going through the boxed
+// Operation std::function in operator_table_. For the hottest of them,
+// emitOperator emits a PRIM_OP instruction instead, which calls through a
+// plain function pointer into the stubs below. Every stub must match the
+// semantics of the registered operator with the same name exactly; the keys
+// include the overload name so that only the intended overload is
+// intercepted. Mobile bytecode export lowers PRIM_OP back to OP (see
+// getFunctionTuple in serialization/export_module.cpp).
+using PrimOpStub = void (*)(Stack&);
+
+static const std::unordered_map<std::string, PrimOpStub>& primOpStubs() {
+  static const std::unordered_map<std::string, PrimOpStub> stubs = {
+      {"prim::TupleUnpack",
+       [](Stack& stack) { tupleUnpack(stack); }},
+      {"prim::TupleIndex",
+       [](Stack& stack) {
+         int64_t index = pop(stack).toInt();
+         auto tuple = pop(stack).toTuple();
+         auto norm_index = index;
+         if (norm_index < 0) {
+           norm_index += tuple->elements().size();
+         }
+         if (norm_index < 0 ||
+             norm_index >= static_cast<int64_t>(tuple->elements().size())) {
+           throw std::out_of_range("Tuple list index out of range");
+         }
+         stack.emplace_back(tuple->elements()[norm_index]);
+       }},
+      {"prim::unchecked_cast", [](Stack& /* stack */) {}},
+      {"aten::__not__",
+       [](Stack& stack) { push(stack, !pop(stack).toBool()); }},
+      {"aten::__is__",
+       [](Stack& stack) {
+         IValue self, obj;
+         pop(stack, self, obj);
+         push(stack, self.is(obj));
+       }},
+      {"aten::__isnot__",
+       [](Stack& stack) {
+         IValue self, obj;
+         pop(stack, self, obj);
+         push(stack, !self.is(obj));
+       }},
+      {"aten::Bool.int",
+       [](Stack& stack) {
+         int64_t i;
+         pop(stack, i);
+         push(stack, (bool)i);
+       }},
+      {"aten::Bool.float",
+       [](Stack& stack) {
+         double d;
+         pop(stack, d);
+         push(stack, (bool)d);
+       }},
+      {"aten::Float.int",
+       [](Stack& stack) {
+         int64_t i;
+         pop(stack, i);
+         push(stack, (float)i);
+       }},
+      {"aten::len.t",
+       [](Stack& stack) {
+         c10::List<IValue> a = pop(stack).to<c10::List<IValue>>();
+         const int64_t size = a.size();
+         push(stack, size);
+       }},
+      {"aten::size",
+       [](Stack& stack) {
+         auto t = std::move(pop(stack)).toTensor();
+         push(stack, t.sizes().vec());
+       }},
+      {"aten::dim",
+       [](Stack& stack) {
+         at::Tensor arg = pop(stack).toTensor();
+         push(stack, arg.dim());
+       }},
+      {"aten::numel",
+       [](Stack& stack) {
+         at::Tensor arg = pop(stack).toTensor();
+         push(stack, arg.numel());
+       }},
+#define DEFINE_INT_STUB(key, expr)  \
+  {key, [](Stack& stack) {          \
+     int64_t a, b;                  \
+     pop(stack, a, b);              \
+     push(stack, expr);             \
+   }}
+#define DEFINE_FLOAT_STUB(key, expr) \
+  {key, [](Stack& stack) {           \
+     double a, b;                    \
+     pop(stack, a, b);               \
+     push(stack, expr);              \
+   }}
+      DEFINE_INT_STUB("aten::add.int", a + b),
+      DEFINE_INT_STUB("aten::sub.int", a - b),
+      DEFINE_INT_STUB("aten::mul.int", a * b),
+      DEFINE_INT_STUB("aten::__round_to_zero_floordiv", a / b),
+      DEFINE_INT_STUB("aten::eq.int", a == b),
+      DEFINE_INT_STUB("aten::ne.int", a != b),
+      DEFINE_INT_STUB("aten::lt.int", a < b),
+      DEFINE_INT_STUB("aten::gt.int", a > b),
+      DEFINE_INT_STUB("aten::le.int", a <= b),
+      DEFINE_INT_STUB("aten::ge.int", a >= b),
+      DEFINE_FLOAT_STUB("aten::add.float", a + b),
+      DEFINE_FLOAT_STUB("aten::sub.float", a - b),
+      DEFINE_FLOAT_STUB("aten::mul.float", a * b),
+      DEFINE_FLOAT_STUB("aten::eq.float", a == b),
+      DEFINE_FLOAT_STUB("aten::ne.float", a != b),
+      DEFINE_FLOAT_STUB("aten::lt.float", a < b),
+      DEFINE_FLOAT_STUB("aten::gt.float", a > b),
+      DEFINE_FLOAT_STUB("aten::le.float", a <= b),
+      DEFINE_FLOAT_STUB("aten::ge.float", a >= b),
+#undef DEFINE_INT_STUB
+#undef DEFINE_FLOAT_STUB
+  };
+  return stubs;
+}
+
 struct CodeImpl {
   friend struct InterpreterState;
   std::vector<Instruction> instructions_;
@@ -370,6 +491,8 @@ struct CodeImpl {
 
   std::vector<IValue> constant_table_;
   std::vector<Operation> operator_table_;
+  // direct stubs dispatched by PRIM_OP, see Note: [Prim op stubs]
+  std::vector<PrimOpStub> prim_op_table_;
   std::vector<Function*> function_table_;
   std::vector<std::unique_ptr<GraphFunction>> forked_functions_;
   std::vector<TypePtr> type_table_;
@@ -470,7 +593,7 @@ struct CodeImpl {
     instructions_source_.emplace_back(current_node_);
 
     // check that we didn't accidentally emit nodes out of topological order
-    if (op == OP) {
+    if (op == OP || op == PRIM_OP) {
       if (last_inserted_op_ != nullptr && current_node_ != last_inserted_op_ &&
           current_node_->owningBlock() == last_inserted_op_->owningBlock()) {
         TORCH_INTERNAL_ASSERT(
@@ -553,9 +676,18 @@ struct CodeImpl {
     const Operator& op = node->getOperator();
     if (op.hasOperation() && op.schema().is_vararg()) {
       insertInstruction(OPN, operator_table_.size(), node->inputs().size());
-    } else {
-      insertInstruction(OP, operator_table_.size());
+      operator_table_.emplace_back(op.getOperation(node));
+      return;
     }
+    // see Note: [Prim op stubs]
+    const auto& stubs = primOpStubs();
+    auto it = stubs.find(c10::toString(op.schema().operator_name()));
+    if (it != stubs.end()) {
+      insertInstruction(PRIM_OP, prim_op_table_.size());
+      prim_op_table_.emplace_back(it->second);
+      return;
+    }
+    insertInstruction(OP, operator_table_.size());
     operator_table_.emplace_back(op.getOperation(node));
   }
 
@@ -884,7 +1016,7 @@ struct CodeImpl {
   void dump(std::ostream& out, size_t i) const {
     out << i << " " << instructions_[i];
     if (instructions_[i].op == OP || instructions_[i].op == CALL ||
-        instructions_[i].op == OPN) {
+        instructions_[i].op == OPN || instructions_[i].op == PRIM_OP) {
       out << " # " << *instructions_source_[i];
     } else {
       out << "\n";
@@ -899,12 +1031,108 @@ struct CodeImpl {
   }
 };
 
+// Note [Interpreter frame arenas]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Every interpreter invocation needs a register file and a frame stack.
+// The register count of the entry frame is known statically from the code
+// object (CodeImpl::register_size_), but these vectors used to be allocated
+// fresh for every InterpreterState, so high-QPS scripted models paid a
+// couple of heap allocations (plus growth reallocations for nested calls)
+// per inference. Instead we keep a small thread-local pool of retired
+// backing vectors and hand their warmed-up capacity to the next
+// invocation, so entering the interpreter on a hot thread does no heap
+// allocation. The pool only caches capacity: vectors are cleared before
+// they are recycled, so no IValues (and thus no tensors) outlive the run
+// that produced them. Note that a state may be destroyed on a different
+// thread than the one that created it (e.g. for async runs); each thread
+// simply recycles into its own pool, which is still correct, just less
+// effective for that run.
+
+// A Frame captures function's state
+// (e.g. `pc` and `base_pointer`)
+// Each Frame corresponds to a call to a `Frame::function`
+// which has not yet returned
+// The arguments for `Frame::function`
+// are located at [base_pointer + arg_number]
+struct Frame {
+  std::shared_ptr<CodeImpl> function;
+  // program counter corresponds to the index
+  // of the currently executed instruction
+  size_t pc;
+  // marks the start index of the frame
+  // base_pointer is used by TAIL_CALL
+  // to replace the current frame
+  // with a frame of a bailout graph
+  size_t base_pointer;
+
+  // unique to every frame with prim::profile across all threads
+  c10::optional<size_t> id;
+  static std::atomic<size_t> num_frames;
+};
+
+std::atomic<size_t> Frame::num_frames;
+
+struct InterpreterFrameArena {
+  static constexpr size_t kMaxPooled = 8;
+  static constexpr size_t kInitialFrameDepth = 16;
+
+  std::vector<IValue> acquireRegisters(size_t register_size) {
+    auto result = acquire(register_pool_);
+    result.reserve(register_size);
+    return result;
+  }
+
+  std::vector<Frame> acquireFrames() {
+    auto result = acquire(frame_pool_);
+    if (result.capacity() == 0) {
+      result.reserve(kInitialFrameDepth);
+    }
+    return result;
+  }
+
+  void release(std::vector<IValue>&& registers, std::vector<Frame>&& frames) {
+    recycle(register_pool_, std::move(registers));
+    recycle(frame_pool_, std::move(frames));
+  }
+
+ private:
+  template <typename T>
+  static std::vector<T> acquire(std::vector<std::vector<T>>& pool) {
+    if (pool.empty()) {
+      return std::vector<T>();
+    }
+    auto result = std::move(pool.back());
+    pool.pop_back();
+    return result;
+  }
+
+  template <typename T>
+  static void recycle(std::vector<std::vector<T>>& pool, std::vector<T>&& v) {
+    if (pool.size() < kMaxPooled) {
+      v.clear();
+      pool.emplace_back(std::move(v));
+    }
+  }
+
+  std::vector<std::vector<IValue>> register_pool_;
+  std::vector<std::vector<Frame>> frame_pool_;
+};
+
+static thread_local InterpreterFrameArena frame_arena;
+
 // InterpreterState state that and used to compute a Code
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
-  InterpreterStateImpl(const Code& code) {
+  InterpreterStateImpl(const Code& code)
+      : registers(frame_arena.acquireRegisters(code.pImpl->register_size_)),
+        frames(frame_arena.acquireFrames()) {
     enterFrame(code, 0);
   }
 
+  ~InterpreterStateImpl() override {
+    // See Note [Interpreter frame arenas]
+    frame_arena.release(std::move(registers), std::move(frames));
+  }
+
  private:
   // if we need to suspend, where do we reset the stack?
   // answer: to where it was when we were called, not
@@ -923,34 +1151,13 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
   // minimizing the total number or register
   std::vector<IValue> registers;
 
-  // A Frame captures function's state
-  // (e.g. `pc` and `base_pointer`)
-  // Each Frame corresponds to a call to a `Frame::function`
-  // which has not yet returned
-  // The arguments for `Frame::function`
-  // are located at [base_pointer + arg_number]
-  struct Frame {
-    std::shared_ptr<CodeImpl> function;
-    // program counter corresponds to the index
-    // of the currently executed instruction
-    size_t pc;
-    // marks the start index of the frame
-    // base_pointer is used by TAIL_CALL
-    // to replace the current frame
-    // with a frame of a bailout graph
-    size_t base_pointer;
-
-    // unique to every frame with prim::profile across all threads
-    c10::optional<size_t> id;
-    static std::atomic<size_t> num_frames;
-  };
-
   // saved-by-value stuff that can exist on the stack inside runInterpreter
   struct ActiveFrame {
     size_t pc;
     Instruction* instructions;
     IValue* constants;
     Operation* operators;
+    PrimOpStub* prim_ops;
     Function** functions;
     std::function<void(std::vector<IValue>&)>* profile_functions;
     TypePtr* types;
@@ -960,6 +1167,7 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
           instructions(frame.function->instructions_.data()),
           constants(frame.function->constant_table_.data()),
           operators(frame.function->operator_table_.data()),
+          prim_ops(frame.function->prim_op_table_.data()),
           functions(frame.function->function_table_.data()),
           profile_functions(frame.function->profile_function_table_.data()),
           types(frame.function->type_table_.data()) {}
@@ -1054,6 +1262,10 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             af.operators[inst.X](stack);
             ++af.pc;
             break;
+          case PRIM_OP:
+            af.prim_ops[inst.X](stack);
+            ++af.pc;
+            break;
           case LOAD:
             stack.emplace_back(reg(inst.X));
             ++af.pc;
@@ -1425,8 +1637,6 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
   }
 };
 
-std::atomic<size_t> InterpreterStateImpl::Frame::num_frames;
-
 std::ostream& operator<<(std::ostream& out, const Code& code) {
   out << *code.pImpl->graph_ << "\n";
   code.pImpl->dump(out);
@@ -1,4 +1,5 @@
 #include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
+#include <ATen/Parallel.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/bailout_graph.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
@@ -29,6 +30,13 @@ C10_DEFINE_bool(
     true,
     "If this flag is set to false TorchScript will be using the legacy/original executor");
 
+C10_DEFINE_bool(
+    torch_jit_background_optimization,
+    false,
+    "Build the optimized plan on a background thread once profiling is done, "
+    "serving the profiled plan in the meantime, instead of stalling the first "
+    "caller that finds profiling complete");
+
 namespace torch {
 namespace jit {
 
@@ -42,6 +50,7 @@ static std::atomic<bool> profiling_mode{true};
 
 static std::atomic<size_t> num_profiled_runs{1};
 static std::atomic<size_t> bailout_depth{1};
+static std::atomic<bool> node_runtime_stats{false};
 
 std::atomic<bool>& getProfilingMode() {
   return profiling_mode;
@@ -58,6 +67,10 @@ std::atomic<size_t>& getBailoutDepth() {
   return bailout_depth;
 }
 
+std::atomic<bool>& getProfilingNodeRuntimeStats() {
+  return node_runtime_stats;
+}
+
 static bool needsGradientInProfilingMode(Block* b) {
   for (auto n : b->nodes()) {
     if (n->kind() == prim::BailOut) {
@@ -184,12 +197,53 @@ ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(
     return *profiling_plan_;
   }
 
-  auto copy = pr_->graph()->copy();
-  runProfilingOptimizations(copy);
-  // cache
-  optimized_plan_ =
-      ExecutionPlan(copy, function_name_, remaining_bailout_depth);
-  return *optimized_plan_;
+  if (!FLAGS_torch_jit_background_optimization) {
+    auto copy = pr_->graph()->copy();
+    runProfilingOptimizations(copy);
+    // cache
+    optimized_plan_ =
+        ExecutionPlan(copy, function_name_, remaining_bailout_depth);
+    return *optimized_plan_;
+  }
+
+  // Tiered execution: keep serving the profiled plan while a background task
+  // produces the optimized plan, which the early-out above picks up once the
+  // task publishes it under compile_mutex.
+  if (background_error_) {
+    auto error = background_error_;
+    background_error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+  if (!optimization_in_flight_) {
+    optimization_in_flight_ = true;
+    auto copy = pr_->graph()->copy();
+    at::launch([this, copy, remaining_bailout_depth]() mutable {
+      c10::optional<ExecutionPlan> plan;
+      std::exception_ptr error;
+      try {
+        // Operates only on the private copy, so it is safe off the lock.
+        runProfilingOptimizations(copy);
+        plan = ExecutionPlan(copy, function_name_, remaining_bailout_depth);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(compile_mutex);
+      if (plan) {
+        optimized_plan_ = std::move(plan);
+      } else {
+        background_error_ = error;
+      }
+      optimization_in_flight_ = false;
+      background_done_cv_.notify_all();
+    });
+  }
+  return *profiling_plan_;
+}
+
+ProfilingGraphExecutorImpl::~ProfilingGraphExecutorImpl() {
+  // The background optimization task references this executor; wait it out.
+  std::unique_lock<std::mutex> lock(compile_mutex);
+  background_done_cv_.wait(lock, [this] { return !optimization_in_flight_; });
 }
 
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
@@ -200,5 +254,14 @@ GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
   return state;
 }
 
+std::unordered_map<const Node*, NodeRuntimeStats> ProfilingGraphExecutorImpl::
+    getNodeRuntimeStats() {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  if (!pr_) {
+    return {};
+  }
+  return pr_->runtimeStats();
+}
+
 } // namespace jit
 } // namespace torch
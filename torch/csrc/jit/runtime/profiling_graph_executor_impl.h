@@ -1,6 +1,8 @@
 #pragma once
 #include <torch/csrc/jit/runtime/graph_executor_impl.h>
 
+#include <condition_variable>
+
 namespace torch {
 namespace jit {
 
@@ -12,7 +14,9 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   ExecutionPlan getPlanFor(Stack& stack, size_t remaining_bailout_depth)
       override;
   GraphExecutorState getDebugState() override;
-  ~ProfilingGraphExecutorImpl() override = default;
+  std::unordered_map<const Node*, NodeRuntimeStats> getNodeRuntimeStats()
+      override;
+  ~ProfilingGraphExecutorImpl() override;
 
  private:
   void runProfilingInsensitiveOptimizations(std::shared_ptr<Graph>& graph);
@@ -21,6 +25,14 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   c10::optional<ExecutionPlan>
       profiling_plan_; // plan to run in order to profiling the code
   c10::optional<ExecutionPlan> optimized_plan_;
+  // Set while a background task is building optimized_plan_ (see getPlanFor);
+  // guarded by compile_mutex.
+  bool optimization_in_flight_ = false;
+  // Signaled when the background task finishes. The destructor waits on it so
+  // the task never outlives the executor.
+  std::condition_variable background_done_cv_;
+  // An error raised by the background task, rethrown to the next caller.
+  std::exception_ptr background_error_;
 };
 
 } // namespace jit
@@ -4,9 +4,30 @@
 #include <torch/csrc/jit/runtime/graph_executor.h>
 #include <torch/csrc/jit/runtime/interpreter.h>
 
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
 namespace torch {
 namespace jit {
 
+namespace {
+
+// bound on the distinct shapes remembered per node in NodeRuntimeStats
+constexpr size_t kMaxObservedShapes = 64;
+
+// start timestamps of in-flight runtime-profiled nodes; node execution is
+// properly nested, so starts and ends pair up like a stack
+thread_local std::vector<int64_t> runtime_start_times_;
+
+int64_t runtimeNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
 ProfilingRecord::ProfilingRecord(std::shared_ptr<Graph> g)
     : profiled_graph_(std::move(g)), profiling_count_(getNumProfiledRuns()) {}
 
@@ -27,7 +48,7 @@ void ProfilingRecord::insertShapeProfile(Node* n, Value* i) {
   bool first = true;
   pno->setType(TensorType::get());
   std::function<void(Stack&)> shape_profiler =
-      [this, pno, first](Stack& stack) mutable {
+      [this, pno, n, first](Stack& stack) mutable {
         int64_t frame_id;
         pop(stack, frame_id);
         IValue t;
@@ -43,6 +64,20 @@ void ProfilingRecord::insertShapeProfile(Node* n, Value* i) {
               pno->setType(pttp);
               first = false;
             }
+            if (getProfilingNodeRuntimeStats()) {
+              auto& stats = this->runtime_stats_[n];
+              if (stats.observed_shapes.size() < kMaxObservedShapes) {
+                std::ostringstream os;
+                os << t.toTensor().sizes();
+                auto shape = os.str();
+                if (std::find(
+                        stats.observed_shapes.begin(),
+                        stats.observed_shapes.end(),
+                        shape) == stats.observed_shapes.end()) {
+                  stats.observed_shapes.push_back(std::move(shape));
+                }
+              }
+            }
           } else {
             pno->setType(TensorType::get()->withUndefined());
           }
@@ -57,7 +92,39 @@ void ProfilingRecord::insertShapeProfile(Node* n, Value* i) {
   n->replaceInputWith(i, pn->output());
 }
 
+// Brackets n with a pair of profile nodes that attribute the wall time in
+// between to n's NodeRuntimeStats.
+void ProfilingRecord::insertRuntimeProfile(Node* n) {
+  auto start_pn = createProfileNode(
+      [](Stack& stack) {
+        int64_t frame_id;
+        pop(stack, frame_id);
+        runtime_start_times_.push_back(runtimeNowNs());
+      },
+      {});
+  auto end_pn = createProfileNode(
+      [this, n](Stack& stack) {
+        int64_t frame_id;
+        pop(stack, frame_id);
+        if (runtime_start_times_.empty()) {
+          // execution unwound past the start profile; drop the measurement
+          return;
+        }
+        auto elapsed = runtimeNowNs() - runtime_start_times_.back();
+        runtime_start_times_.pop_back();
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        auto& stats = this->runtime_stats_[n];
+        ++stats.count;
+        stats.cumulative_ns += elapsed;
+        stats.last_ns = elapsed;
+      },
+      {});
+  start_pn->insertBefore(n);
+  end_pn->insertAfter(n);
+}
+
 void ProfilingRecord::instrumentBlock(Block* block) {
+  const bool runtime_stats = getProfilingNodeRuntimeStats();
   for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
     auto n = *it;
     for (auto i : n->inputs()) {
@@ -72,6 +139,11 @@ void ProfilingRecord::instrumentBlock(Block* block) {
     for (auto b : n->blocks()) {
       instrumentBlock(b);
     }
+
+    // n's own instrumentation must not be instrumented in turn
+    if (runtime_stats && n->kind() != prim::profile) {
+      insertRuntimeProfile(n);
+    }
   }
 
   // inserting profile nodes on block outputs
@@ -108,5 +180,11 @@ std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
   return pr;
 }
 
+std::unordered_map<const Node*, NodeRuntimeStats> ProfilingRecord::
+    runtimeStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return runtime_stats_;
+}
+
 } // namespace jit
 } // namespace torch
@@ -15,6 +15,19 @@ namespace jit {
 
 using ::c10::TensorTypePtr;
 
+// Aggregated runtime statistics for one node of the profiled graph,
+// collected while instrumented (profiling) runs execute and
+// getProfilingNodeRuntimeStats() is set. Wall times are nanoseconds.
+struct TORCH_API NodeRuntimeStats {
+  int64_t count = 0; // number of times the node executed
+  int64_t cumulative_ns = 0; // total wall time spent in the node
+  int64_t last_ns = 0; // wall time of the most recent execution
+  // distinct tensor input shapes the shape profiler has seen flow into the
+  // node, rendered as e.g. "[128, 20]"; capped so fully dynamic models
+  // cannot grow the stats without bound
+  std::vector<std::string> observed_shapes;
+};
+
 struct ProfilingRecord {
   // N.B. ProfilingRecord's copy and move c-tor are disabled, so we won't
   // end up accidentally copying or moving ProfilingRecords whose addresses
@@ -34,13 +47,21 @@ struct ProfilingRecord {
     return profiled_graph_;
   }
 
+  // Snapshot of the per-node runtime statistics, keyed by nodes of graph().
+  // Only populated when getProfilingNodeRuntimeStats() was set at the time
+  // the graph was instrumented.
+  TORCH_API std::unordered_map<const Node*, NodeRuntimeStats> runtimeStats();
+
  private:
   ProfileOp* createProfileNode(
       const std::function<void(Stack&)>& fp,
       at::ArrayRef<Value*> inputs);
   void instrumentBlock(Block* block);
   void insertShapeProfile(Node* n, Value* i);
+  void insertRuntimeProfile(Node* n);
   ProfilingRecord(std::shared_ptr<Graph> g);
+
+  std::unordered_map<const Node*, NodeRuntimeStats> runtime_stats_;
 };
 
 } // namespace jit
@@ -0,0 +1,274 @@
+#include <torch/csrc/jit/runtime/static_runtime.h>
+
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/passes/inliner.h>
+#include <torch/csrc/jit/runtime/vararg_functions.h>
+
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// The interpreter implements container prims as dedicated instructions, so
+// they have no registered Operation. Synthesize equivalent operations here
+// from the vararg helpers the mobile interpreter uses.
+Operation getStaticOperation(Node* node) {
+  if (const Operator* op = node->maybeOperator()) {
+    return op->getOperation(node);
+  }
+  size_t num_inputs = node->inputs().size();
+  switch (node->kind()) {
+    case prim::TupleConstruct: {
+      auto type = node->output()->type()->expect<TupleType>();
+      if (type->name()) {
+        return [type, num_inputs](Stack& stack) {
+          namedTupleConstruct(stack, type, num_inputs);
+          return 0;
+        };
+      }
+      return [num_inputs](Stack& stack) {
+        tupleConstruct(stack, num_inputs);
+        return 0;
+      };
+    }
+    case prim::ListConstruct: {
+      auto type = node->output()->type()->expect<ListType>();
+      return [type, num_inputs](Stack& stack) {
+        listConstruct(stack, type, num_inputs);
+        return 0;
+      };
+    }
+    case prim::DictConstruct: {
+      auto type = node->output()->type()->expect<DictType>();
+      return [type, num_inputs](Stack& stack) {
+        dictConstruct(stack, type, num_inputs);
+        return 0;
+      };
+    }
+    case prim::TupleUnpack: {
+      return [](Stack& stack) {
+        tupleUnpack(stack);
+        return 0;
+      };
+    }
+    case prim::ListUnpack: {
+      size_t num_outputs = node->outputs().size();
+      return [num_outputs](Stack& stack) {
+        listUnpack(stack, num_outputs);
+        return 0;
+      };
+    }
+    case prim::TupleSlice: {
+      size_t begin = node->i(attr::beg);
+      size_t end = node->i(attr::end);
+      return [begin, end](Stack& stack) {
+        tupleSlice(stack, begin, end);
+        return 0;
+      };
+    }
+    default:
+      TORCH_CHECK(
+          false, "StaticRuntime does not support node: ", *node);
+  }
+}
+
+} // namespace
+
+StaticRuntime::StaticRuntime(std::shared_ptr<Graph> graph)
+    : graph_(std::move(graph)) {
+  init(c10::nullopt);
+}
+
+StaticRuntime::StaticRuntime(const Module& module) {
+  graph_ = module.get_method("forward").graph()->copy();
+  Inline(*graph_);
+  init(module._ivalue());
+}
+
+void StaticRuntime::init(c10::optional<IValue> self) {
+  // Values whose IValue is fully known at construction time: constants,
+  // the bound module object, and attribute reads chained off it.
+  std::unordered_map<const Value*, IValue> preloaded;
+
+  if (self) {
+    TORCH_CHECK(
+        !graph_->inputs().empty() &&
+            graph_->inputs()[0]->type()->cast<ClassType>(),
+        "expected a module graph whose first input is the module object");
+    preloaded.emplace(graph_->inputs()[0], std::move(*self));
+  }
+
+  // Phase 1: resolve construction-time values and collect runtime steps.
+  std::vector<Node*> nodes;
+  for (Node* node : graph_->nodes()) {
+    if (node->kind() == prim::Constant) {
+      auto value = toIValue(node->output());
+      TORCH_INTERNAL_ASSERT(value, "unrepresentable constant: ", *node);
+      preloaded.emplace(node->output(), std::move(*value));
+      continue;
+    }
+    if (node->kind() == prim::GetAttr) {
+      // frozen modules only read attributes off the (constant) module
+      // object, so the whole chain folds away at construction
+      auto it = preloaded.find(node->input());
+      TORCH_CHECK(
+          it != preloaded.end(),
+          "StaticRuntime requires attribute reads to resolve to the frozen module: ",
+          *node);
+      preloaded.emplace(
+          node->output(), it->second.toObject()->getAttr(node->s(attr::name)));
+      continue;
+    }
+    TORCH_CHECK(
+        node->blocks().empty(),
+        "StaticRuntime does not support control flow: ",
+        *node);
+    nodes.push_back(node);
+  }
+
+  // Phase 2: lifetimes. The step index of the last use of each runtime
+  // value; graph outputs stay alive past all steps.
+  const size_t kAliveForOutput = nodes.size();
+  std::unordered_map<const Value*, size_t> last_use;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (Value* input : nodes[i]->inputs()) {
+      if (!preloaded.count(input)) {
+        last_use[input] = i;
+      }
+    }
+  }
+  for (Value* output : graph_->outputs()) {
+    if (!preloaded.count(output)) {
+      last_use[output] = kAliveForOutput;
+    }
+  }
+
+  // Phase 3: linear-scan register allocation. Construction-time values get
+  // dedicated registers that are never recycled; runtime values release
+  // their register at last use, making it available to later steps.
+  std::unordered_map<const Value*, uint32_t> value_to_reg;
+  std::vector<uint32_t> free_regs;
+  uint32_t num_regs = 0;
+  for (auto& entry : preloaded) {
+    value_to_reg[entry.first] = num_regs++;
+  }
+  auto allocate = [&](const Value* v) {
+    uint32_t reg;
+    if (!free_regs.empty()) {
+      reg = free_regs.back();
+      free_regs.pop_back();
+    } else {
+      reg = num_regs++;
+    }
+    value_to_reg[v] = reg;
+    return reg;
+  };
+
+  for (Value* input : graph_->inputs()) {
+    if (!preloaded.count(input)) {
+      input_regs_.push_back(allocate(input));
+    }
+  }
+
+  size_t max_step_width = 0;
+  steps_.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    Node* node = nodes[i];
+    OpStep step;
+    step.node = node;
+    step.op = getStaticOperation(node);
+    auto inputs = node->inputs();
+    step.input_regs.reserve(inputs.size());
+    step.move_input.reserve(inputs.size());
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      Value* v = inputs[j];
+      // move a dying operand onto the stack, but only at its final
+      // occurrence if this node consumes it more than once
+      bool is_final_occurrence = true;
+      for (size_t k = j + 1; k < inputs.size() && is_final_occurrence; ++k) {
+        is_final_occurrence = inputs[k] != v;
+      }
+      bool dies_here = !preloaded.count(v) && last_use.at(v) == i;
+      step.input_regs.push_back(value_to_reg.at(v));
+      step.move_input.push_back(dies_here && is_final_occurrence);
+      if (dies_here && is_final_occurrence) {
+        // the register is dead before the op runs, so this node's outputs
+        // may reuse it
+        free_regs.push_back(value_to_reg.at(v));
+      }
+    }
+    for (Value* output : node->outputs()) {
+      step.output_regs.push_back(allocate(output));
+    }
+    max_step_width = std::max(
+        max_step_width, std::max(inputs.size(), node->outputs().size()));
+    steps_.push_back(std::move(step));
+  }
+
+  auto outputs = graph_->outputs();
+  for (size_t j = 0; j < outputs.size(); ++j) {
+    const Value* v = outputs[j];
+    bool is_final_occurrence = true;
+    for (size_t k = j + 1; k < outputs.size() && is_final_occurrence; ++k) {
+      is_final_occurrence = outputs[k] != v;
+    }
+    output_regs_.push_back(value_to_reg.at(v));
+    move_output_.push_back(!preloaded.count(v) && is_final_occurrence);
+  }
+
+  // Phase 4: materialize the workspace and preload constants.
+  registers_.resize(num_regs);
+  for (auto& entry : preloaded) {
+    registers_[value_to_reg.at(entry.first)] = std::move(entry.second);
+  }
+  stack_.reserve(max_step_width);
+}
+
+std::vector<IValue> StaticRuntime::run(std::vector<IValue> inputs) {
+  TORCH_CHECK(
+      inputs.size() == input_regs_.size(),
+      "StaticRuntime expected ",
+      input_regs_.size(),
+      " inputs, but got ",
+      inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    registers_[input_regs_[i]] = std::move(inputs[i]);
+  }
+  for (OpStep& step : steps_) {
+    stack_.clear();
+    for (size_t j = 0; j < step.input_regs.size(); ++j) {
+      IValue& r = registers_[step.input_regs[j]];
+      if (step.move_input[j]) {
+        stack_.emplace_back(std::move(r));
+      } else {
+        stack_.emplace_back(r);
+      }
+    }
+    auto offset = step.op(stack_);
+    TORCH_INTERNAL_ASSERT(
+        offset == 0, "op tried to jump: ", *step.node);
+    TORCH_INTERNAL_ASSERT(
+        stack_.size() == step.output_regs.size(),
+        "op left an unexpected number of outputs: ",
+        *step.node);
+    for (size_t j = 0; j < step.output_regs.size(); ++j) {
+      registers_[step.output_regs[j]] = std::move(stack_[j]);
+    }
+  }
+  std::vector<IValue> outputs;
+  outputs.reserve(output_regs_.size());
+  for (size_t j = 0; j < output_regs_.size(); ++j) {
+    IValue& r = registers_[output_regs_[j]];
+    if (move_output_[j]) {
+      outputs.emplace_back(std::move(r));
+    } else {
+      outputs.emplace_back(r);
+    }
+  }
+  return outputs;
+}
+
+} // namespace jit
+} // namespace torch
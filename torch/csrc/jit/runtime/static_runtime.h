@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ATen/core/stack.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+#include <memory>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// Note [Static runtime]
+// ~~~~~~~~~~~~~~~~~~~~~
+// After freeze_module, an inference graph is pure, shape-stable dataflow:
+// no control flow, no module mutation, and the same operator sequence on
+// every request. The interpreter still pays for generality on that
+// workload -- instruction dispatch, frame bookkeeping, and fresh
+// IValue/refcount traffic for every intermediate. StaticRuntime compiles
+// such a graph once into a flat list of (Operation, register index) steps
+// over a single preallocated register workspace:
+//  * prim::Constant values and attribute reads off the frozen module are
+//    resolved at construction time and preloaded into the workspace,
+//  * every intermediate is assigned a workspace register by a linear scan
+//    over value lifetimes, so registers whose value has died are reused by
+//    later steps instead of growing the workspace,
+//  * an input that reaches its last use is moved (not copied) onto the
+//    operator stack, so dead tensors are released at the earliest possible
+//    point and their storage can be recycled by the caching allocator.
+// A StaticRuntime keeps its workspace across calls, so an instance must
+// only be used by one thread at a time; create one per serving thread.
+struct TORCH_API StaticRuntime {
+  // `graph` must be inlined, frozen dataflow: no control flow, no
+  // mutation of objects. The graph is shared, not copied; do not mutate
+  // it after construction.
+  explicit StaticRuntime(std::shared_ptr<Graph> graph);
+
+  // Convenience constructor for a frozen module (see freeze_module):
+  // compiles the module's "forward" method, binding the module object at
+  // construction so run() takes only the data inputs.
+  explicit StaticRuntime(const Module& module);
+
+  std::vector<IValue> run(std::vector<IValue> inputs);
+
+ private:
+  struct OpStep {
+    Operation op;
+    Node* node; // for error reporting only
+    std::vector<uint32_t> input_regs;
+    // true if this operand reaches its last use here and is moved onto
+    // the operator stack instead of copied
+    std::vector<bool> move_input;
+    std::vector<uint32_t> output_regs;
+  };
+
+  void init(c10::optional<IValue> self);
+
+  std::shared_ptr<Graph> graph_;
+  std::vector<OpStep> steps_;
+  std::vector<uint32_t> input_regs_;
+  std::vector<uint32_t> output_regs_;
+  std::vector<bool> move_output_;
+  // the preallocated workspace; registers holding construction-time
+  // constants are never overwritten
+  std::vector<IValue> registers_;
+  // scratch operator stack, reused across steps and calls
+  std::vector<IValue> stack_;
+};
+
+} // namespace jit
+} // namespace torch
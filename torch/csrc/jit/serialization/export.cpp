@@ -18,6 +18,7 @@
 #include <ATen/ATen.h>
 #include <c10/util/Optional.h>
 
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <regex>
@@ -44,6 +45,75 @@ void writeArchiveAndTensors(
   out.writeRecord(fname, data, size);
 }
 
+namespace {
+
+// 64-bit FNV-1a; cheap enough to run over every storage at snapshot time
+// and collision-safe enough to treat "hash equal" as "content equal".
+uint64_t contentHash(const char* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// The content hash of record `fname` in `base`: from its "<fname>.hash"
+// record when `base` was itself written incrementally, otherwise by hashing
+// the record bytes (so the first delta against a full checkpoint works too).
+c10::optional<uint64_t> baseRecordHash(
+    caffe2::serialize::PyTorchStreamReader& base,
+    const std::string& fname) {
+  std::string hash_name = fname + kTensorRecordHashSuffix;
+  if (base.hasRecord(hash_name)) {
+    at::DataPtr hash_ptr;
+    size_t hash_size;
+    std::tie(hash_ptr, hash_size) = base.getRecord(hash_name);
+    if (hash_size == sizeof(uint64_t)) {
+      uint64_t hash;
+      std::memcpy(&hash, hash_ptr.get(), sizeof(hash));
+      return hash;
+    }
+    return c10::nullopt;
+  }
+  if (base.hasRecord(fname)) {
+    at::DataPtr data_ptr;
+    size_t data_size;
+    std::tie(data_ptr, data_size) = base.getRecord(fname);
+    return contentHash(static_cast<const char*>(data_ptr.get()), data_size);
+  }
+  return c10::nullopt;
+}
+
+} // namespace
+
+void writeArchiveAndTensorsIncremental(
+    const std::string& archive_name,
+    const char* data,
+    size_t size,
+    const std::vector<WriteableTensorData>& tensors,
+    caffe2::serialize::PyTorchStreamReader& base,
+    caffe2::serialize::PyTorchStreamWriter& out) {
+  std::string prefix = archive_name + "/";
+  size_t i = 0;
+  for (const auto& td : tensors) {
+    std::string fname = prefix + std::to_string(i++);
+    uint64_t hash = contentHash(td.data(), td.sizeInBytes());
+    auto base_hash = baseRecordHash(base, fname);
+    if (base_hash && *base_hash == hash) {
+      // Unchanged: the bytes live in the base chain under the same name.
+      // The marker's payload is just the hash, for debugging; the loader
+      // only keys off the record's existence.
+      out.writeRecord(fname + kTensorRecordRefSuffix, &hash, sizeof(hash));
+    } else {
+      out.writeRecord(fname, td.data(), td.sizeInBytes());
+    }
+    out.writeRecord(fname + kTensorRecordHashSuffix, &hash, sizeof(hash));
+  }
+  std::string fname = archive_name + ".pkl";
+  out.writeRecord(fname, data, size);
+}
+
 namespace {
 namespace onnx_torch = ::torch::onnx;
 namespace onnx = ::ONNX_NAMESPACE;
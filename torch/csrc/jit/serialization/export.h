@@ -80,6 +80,20 @@ TORCH_API void writeArchiveAndTensors(
     const std::vector<WriteableTensorData>& tensors,
     caffe2::serialize::PyTorchStreamWriter& out);
 
+// Incremental (delta) variant of writeArchiveAndTensors: tensor records
+// whose content hash matches the record of the same name in `base` are
+// written as a small "<name>.ref" marker instead of their bytes, and every
+// tensor slot gets a "<name>.hash" record so the next delta can diff
+// against this archive cheaply. Load the result with readArchiveAndTensors,
+// passing the chain of base archives (newest first).
+TORCH_API void writeArchiveAndTensorsIncremental(
+    const std::string& archive_name,
+    const char* pickle_bytes,
+    size_t size,
+    const std::vector<WriteableTensorData>& tensors,
+    caffe2::serialize::PyTorchStreamReader& base,
+    caffe2::serialize::PyTorchStreamWriter& out);
+
 // Surrounding system can install an additional hook to produce extra files
 // with metadata based on environment every time a module is serialized.
 using ExportModuleExtraFilesHook = std::function<ExtraFilesMap(const Module&)>;
@@ -14,6 +14,8 @@
 
 #include <ATen/ATen.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "ATen/core/jit_type.h"
@@ -55,8 +57,14 @@ c10::IValue getFunctionTuple(const Function& func) {
   std::vector<std::string> method_names;
   for (size_t i = 0; i < instructions_copy.size(); ++i) {
     Instruction ins = instructions_copy[i];
-    if (ins.op == OP || ins.op == OPN) {
+    if (ins.op == OP || ins.op == OPN || ins.op == PRIM_OP) {
       auto node = code.instructions_source()[i];
+      // The mobile interpreter dispatches every operator through the
+      // registry, so lower PRIM_OP (see Note: [Prim op stubs]) back to OP
+      // and renumber X against the operator list serialized here.
+      OpCode op = ins.op == PRIM_OP ? OP : ins.op;
+      instructions_copy[i] =
+          Instruction(op, static_cast<int32_t>(opnames.size()), ins.N);
       opnames.emplace_back(node->schema().operator_name());
     }
     // CALL nodes at this point represent built-in (i.e. non-Graph)
@@ -160,6 +168,17 @@ void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook) {
   GetExtraFilesHook() = hook;
 }
 
+// Opt-in: compress large tensor records in parallel blocks (see
+// PyTorchStreamWriter::writeChunkedRecord). Off by default because older
+// readers cannot open archives written this way.
+bool chunkedCompressionEnabled() {
+  static const bool enabled = []() {
+    const char* flag = getenv("TORCH_SERIALIZATION_CHUNKED_COMPRESSION");
+    return flag != nullptr && strcmp(flag, "0") != 0;
+  }();
+  return enabled;
+}
+
 class ScriptModuleSerializer {
  public:
   explicit ScriptModuleSerializer(const std::string& filename)
@@ -210,7 +229,12 @@ class ScriptModuleSerializer {
     std::string prefix = archive_name + "/";
     for (const auto& td : data_pickle.tensorData()) {
       std::string fname = prefix + c10::to_string(i++);
-      writer_.writeRecord(fname, td.data(), td.sizeInBytes());
+      if (chunkedCompressionEnabled() &&
+          td.sizeInBytes() >= caffe2::serialize::kChunkedRecordBlockSize) {
+        writer_.writeChunkedRecord(fname, td.data(), td.sizeInBytes());
+      } else {
+        writer_.writeRecord(fname, td.data(), td.sizeInBytes());
+      }
     }
     std::string fname = archive_name + ".pkl";
     writer_.writeRecord(fname, data.data(), data.size());
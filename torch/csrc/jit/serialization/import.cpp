@@ -17,8 +17,12 @@
 #include "caffe2/serialize/istream_adapter.h"
 
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -59,7 +63,8 @@ IValue readArchiveAndTensors(
     c10::optional<TypeResolver> type_resolver,
     c10::optional<ObjLoader> obj_loader,
     c10::optional<at::Device> device,
-    PyTorchStreamReader& stream_reader) {
+    PyTorchStreamReader& stream_reader,
+    const std::vector<PyTorchStreamReader*>& base_readers) {
   std::string picklename = archive_name + ".pkl";
   at::DataPtr pickle_ptr;
   size_t pickle_size;
@@ -80,9 +85,129 @@ IValue readArchiveAndTensors(
   };
 
   std::string archive_name_plus_slash = archive_name + "/";
+
+  // Prefetch this archive's tensor records on the inter-op pool while the
+  // main thread unpickles. getRecord is thread-safe and the pread-based
+  // FileAdapter reads concurrently, so on fast storage the load tracks raw
+  // disk bandwidth instead of issuing one read at a time.
+  struct PrefetchedRecord {
+    // IN_PROGRESS entries are always owned by a prefetch task and become
+    // READY; CONSUMED is terminal (data handed out, or the consumer decided
+    // to read the record itself).
+    enum State { NOT_STARTED, IN_PROGRESS, READY, CONSUMED };
+    State state = NOT_STARTED;
+    at::DataPtr data;
+  };
+  std::mutex prefetch_mutex;
+  std::condition_variable prefetch_cv;
+  std::unordered_map<std::string, PrefetchedRecord> prefetched;
+  std::vector<std::string> prefetch_names;
+  for (const auto& record : stream_reader.getAllRecords()) {
+    // getAllRecords returns names with the top-level archive folder
+    // attached, while getRecord takes them without it.
+    auto pos = record.find('/');
+    if (pos == std::string::npos) {
+      continue;
+    }
+    std::string suffix = record.substr(pos + 1);
+    if (suffix.size() > archive_name_plus_slash.size() &&
+        suffix.compare(
+            0, archive_name_plus_slash.size(), archive_name_plus_slash) == 0) {
+      // Chunked-compression sub-records (see writeChunkedRecord) are never
+      // requested by name; getRecord on the base name reads them itself, in
+      // parallel, so prefetching them here would only read them twice.
+      if (suffix.find(".zindex") != std::string::npos ||
+          suffix.find(".zblock.") != std::string::npos) {
+        continue;
+      }
+      // Likewise for incremental-checkpoint bookkeeping records.
+      if (suffix.find(kTensorRecordRefSuffix) != std::string::npos ||
+          suffix.find(kTensorRecordHashSuffix) != std::string::npos) {
+        continue;
+      }
+      prefetched.emplace(suffix, PrefetchedRecord());
+      prefetch_names.push_back(std::move(suffix));
+    }
+  }
+  std::atomic<size_t> next_record{0};
+  size_t num_tasks = std::min(
+      prefetch_names.size(), static_cast<size_t>(at::get_num_interop_threads()));
+  size_t inflight = num_tasks;
+  for (size_t t = 0; t < num_tasks; ++t) {
+    at::launch([&]() {
+      size_t i;
+      while ((i = next_record++) < prefetch_names.size()) {
+        const std::string& name = prefetch_names[i];
+        {
+          std::lock_guard<std::mutex> guard(prefetch_mutex);
+          auto& entry = prefetched[name];
+          if (entry.state != PrefetchedRecord::NOT_STARTED) {
+            continue; // the consumer claimed it already
+          }
+          entry.state = PrefetchedRecord::IN_PROGRESS;
+        }
+        at::DataPtr data;
+        try {
+          data = std::get<0>(stream_reader.getRecord(name));
+        } catch (...) {
+          // Leave the entry empty; the consumer re-reads it synchronously
+          // and reports the error on the main thread.
+        }
+        std::lock_guard<std::mutex> guard(prefetch_mutex);
+        auto& entry = prefetched[name];
+        entry.data = std::move(data);
+        entry.state = PrefetchedRecord::READY;
+        prefetch_cv.notify_all();
+      }
+      std::lock_guard<std::mutex> guard(prefetch_mutex);
+      --inflight;
+      prefetch_cv.notify_all();
+    });
+  }
+
   auto read_record = [&](const std::string& name) {
     std::string ss = archive_name_plus_slash + name;
-    return std::get<0>(stream_reader.getRecord(ss));
+    std::unique_lock<std::mutex> lock(prefetch_mutex);
+    auto it = prefetched.find(ss);
+    if (it != prefetched.end()) {
+      if (it->second.state == PrefetchedRecord::NOT_STARTED) {
+        // Claim it ourselves rather than waiting: the pool may be busy (or
+        // this load may itself be running on the last pool thread), and a
+        // read the consumer performs is just as good as a prefetched one.
+        it->second.state = PrefetchedRecord::CONSUMED;
+      } else if (it->second.state != PrefetchedRecord::CONSUMED) {
+        prefetch_cv.wait(
+            lock, [&] { return it->second.state == PrefetchedRecord::READY; });
+        it->second.state = PrefetchedRecord::CONSUMED;
+        if (it->second.data) {
+          return std::move(it->second.data);
+        }
+        // the prefetch failed; re-read synchronously to surface the error
+      }
+      // CONSUMED: shared storages may be requested more than once; each
+      // request past the first reads its own copy, as before.
+    }
+    lock.unlock();
+    // Incremental checkpoints store unchanged records as "<name>.ref"
+    // markers; walk the base chain (newest first) to the archive that holds
+    // the bytes.
+    PyTorchStreamReader* r = &stream_reader;
+    size_t next_base = 0;
+    while (!r->hasRecord(ss)) {
+      TORCH_CHECK(
+          r->hasRecord(ss + kTensorRecordRefSuffix),
+          "record '",
+          ss,
+          "' not found in archive");
+      TORCH_CHECK(
+          next_base < base_readers.size(),
+          "record '",
+          ss,
+          "' is a reference into a base checkpoint, but no (further) base "
+          "archive was provided");
+      r = base_readers[next_base++];
+    }
+    return std::get<0>(r->getRecord(ss));
   };
 
   Unpickler unpickler(
@@ -92,7 +217,23 @@ IValue readArchiveAndTensors(
       std::move(read_record),
       device);
   unpickler.set_version(stream_reader.version());
-  return unpickler.parse_ivalue();
+
+  // The prefetch tasks reference this frame; wait them out even when
+  // unpickling throws.
+  auto join_prefetch = [&]() {
+    next_record = prefetch_names.size(); // stop issuing new reads
+    std::unique_lock<std::mutex> lock(prefetch_mutex);
+    prefetch_cv.wait(lock, [&] { return inflight == 0; });
+  };
+  IValue result;
+  try {
+    result = unpickler.parse_ivalue();
+  } catch (...) {
+    join_prefetch();
+    throw;
+  }
+  join_prefetch();
+  return result;
 }
 
 namespace {
@@ -114,7 +255,7 @@ class ScriptModuleDeserializer final {
             &constants_table_,
             [this](const std::string& qualifier) {
               return findSourceInArchiveFromQualifier(
-                  *reader_, export_prefix_, qualifier);
+                  reader_, export_prefix_, qualifier);
             },
             reader_->version()) {}
 
@@ -126,7 +267,9 @@ class ScriptModuleDeserializer final {
   IValue readArchive(const std::string& archive_name);
 
   std::shared_ptr<CompilationUnit> compilation_unit_;
-  std::unique_ptr<PyTorchStreamReader> reader_;
+  // Shared with the deserialized sources' (deferred) debug-info unpicklers,
+  // which may read records after deserialization has finished.
+  std::shared_ptr<PyTorchStreamReader> reader_;
   c10::optional<at::Device> device_;
   std::vector<at::Tensor> constants_table_;
   SourceImporter source_importer_;
@@ -65,12 +65,17 @@ TORCH_API Module load(
     c10::optional<c10::Device> device = c10::nullopt,
     ExtraFilesMap& extra_files = default_extra_files);
 
+// `base_readers` is only needed for archives written by
+// writeArchiveAndTensorsIncremental: tensor records marked as unchanged are
+// resolved from the chain of base archives, ordered newest first.
 TORCH_API IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
     c10::optional<ObjLoader> obj_loader,
     c10::optional<at::Device> device,
-    caffe2::serialize::PyTorchStreamReader& stream_reader);
+    caffe2::serialize::PyTorchStreamReader& stream_reader,
+    const std::vector<caffe2::serialize::PyTorchStreamReader*>& base_readers =
+        {});
 
 } // namespace jit
 } // namespace torch
@@ -22,26 +22,25 @@ std::string qualifierToArchivePath(
 }
 
 std::shared_ptr<Source> findSourceInArchiveFromQualifier(
-    caffe2::serialize::PyTorchStreamReader& reader,
+    std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader,
     const std::string& export_prefix,
     const std::string& qualifier) {
   const std::string path = qualifierToArchivePath(qualifier, export_prefix);
-  if (!reader.hasRecord(path)) {
+  if (!reader->hasRecord(path)) {
     return nullptr;
   }
   at::DataPtr data;
   size_t size;
-  std::tie(data, size) = reader.getRecord(path);
+  std::tie(data, size) = reader->getRecord(path);
 
   std::shared_ptr<ConcreteSourceRangeUnpickler> gen_ranges = nullptr;
 
   std::string debug_file = path + ".debug_pkl";
-  if (reader.hasRecord(debug_file)) {
-    at::DataPtr debug_data;
-    size_t debug_size;
-    std::tie(debug_data, debug_size) = reader.getRecord(debug_file);
+  if (reader->hasRecord(debug_file)) {
+    // Defer reading the debug record until a source range is actually
+    // queried (i.e. an error is raised); see ConcreteSourceRangeUnpickler.
     gen_ranges = std::make_shared<ConcreteSourceRangeUnpickler>(
-        std::move(debug_data), debug_size);
+        reader, std::move(debug_file));
   }
   return std::make_shared<Source>(
       std::string(static_cast<const char*>(data.get()), size),
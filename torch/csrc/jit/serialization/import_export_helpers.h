@@ -14,6 +14,13 @@ namespace jit {
 
 struct Source;
 
+// Suffixes used by incremental (delta) checkpoints, see
+// writeArchiveAndTensorsIncremental in export.cpp. "<name>.hash" holds the
+// 64-bit content hash of tensor record "<name>"; "<name>.ref" marks a
+// record whose bytes live unchanged in a base archive.
+constexpr const char* kTensorRecordHashSuffix = ".hash";
+constexpr const char* kTensorRecordRefSuffix = ".ref";
+
 // Convert a class type's qualifier name to the corresponding path the source
 // file it should be written to.
 //
@@ -24,7 +31,7 @@ std::string qualifierToArchivePath(
     const std::string& export_prefix);
 
 std::shared_ptr<Source> findSourceInArchiveFromQualifier(
-    caffe2::serialize::PyTorchStreamReader& reader,
+    std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader,
     const std::string& export_prefix,
     const std::string& qualifier);
 
@@ -40,7 +40,7 @@ class ScriptModuleDeserializer final {
  public:
   ScriptModuleDeserializer(
       std::shared_ptr<CompilationUnit> cu,
-      std::unique_ptr<PyTorchStreamReader> reader,
+      std::shared_ptr<PyTorchStreamReader> reader,
       const c10::optional<at::Device>& device)
       : compilation_unit_(cu),
         reader_(std::move(reader)),
@@ -50,7 +50,7 @@ class ScriptModuleDeserializer final {
             &constants_table_,
             [this](const std::string& qualifier) {
               return findSourceInArchiveFromQualifier(
-                  *reader_, export_prefix_, qualifier);
+                  reader_, export_prefix_, qualifier);
             },
             reader_->version()) {}
 
@@ -71,7 +71,9 @@ class ScriptModuleDeserializer final {
   std::shared_ptr<Source> sourceLoader(const std::string& qualifier);
 
   std::shared_ptr<CompilationUnit> compilation_unit_;
-  std::unique_ptr<PyTorchStreamReader> reader_;
+  // Shared with the deserialized sources' (deferred) debug-info unpicklers,
+  // which may read records after deserialization has finished.
+  std::shared_ptr<PyTorchStreamReader> reader_;
   c10::optional<at::Device> device_;
   std::vector<at::Tensor> constants_table_;
   SourceImporter source_importer_;
@@ -314,13 +316,10 @@ Module ScriptModuleDeserializer::LEGACY_convertModule(
   // generating code.
   std::shared_ptr<SourceRangeUnpickler> gen_ranges = nullptr;
   if (module_def.has_torchscript_debug_arena()) {
-    at::DataPtr data;
-    size_t size;
-    std::tie(data, size) =
-        reader_->getRecord(module_def.torchscript_debug_arena().key());
-
-    gen_ranges =
-        std::make_shared<ConcreteSourceRangeUnpickler>(std::move(data), size);
+    // Defer reading the debug record until a source range is actually
+    // queried; see ConcreteSourceRangeUnpickler.
+    gen_ranges = std::make_shared<ConcreteSourceRangeUnpickler>(
+        reader_, module_def.torchscript_debug_arena().key());
   }
 
   if (module_def.has_torchscript_arena()) {
@@ -371,7 +370,7 @@ Module ScriptModuleDeserializer::LEGACY_convertModule(
 
 Module LEGACY_deserialize(
     std::shared_ptr<CompilationUnit> cu,
-    std::unique_ptr<caffe2::serialize::PyTorchStreamReader> reader,
+    std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader,
     const c10::optional<c10::Device>& device) {
   ScriptModuleDeserializer deserializer(cu, std::move(reader), device);
   return deserializer.LEGACY_deserialize();
@@ -1,15 +1,65 @@
 #include "import_source.h"
 
 #include <ATen/core/qualified_name.h>
+#include <torch/csrc/jit/api/function_impl.h>
 #include <torch/csrc/jit/frontend/parser.h>
 #include <torch/csrc/jit/frontend/resolver.h>
 #include <torch/csrc/jit/frontend/script_type_parser.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/custom_class.h>
 
+#include <cstdlib>
+
 namespace torch {
 namespace jit {
 
+namespace {
+
+// Note [Source parse cache]
+// Re-loading a model re-lexes and re-parses the same source text on every
+// load. When TORCH_JIT_SOURCE_PARSE_CACHE is set, parsed trees are shared
+// process-wide, keyed by a hash of the source text, so repeated loads of
+// identical sources (same model re-loaded, or models sharing library code)
+// skip the parser. Trees are immutable once built, so sharing them across
+// compilation units is safe. This is opt-in because cached trees keep their
+// originating Source (and through it the archive's debug-info reader) alive
+// for the life of the process.
+//
+// The parsed trees cannot be persisted across processes: the AST and IR
+// have no serialized form in this codebase - the serialized source text is
+// itself the canonical on-disk artifact.
+bool parseCacheEnabled() {
+  const char* enabled = std::getenv("TORCH_JIT_SOURCE_PARSE_CACHE");
+  return enabled != nullptr && std::string(enabled) != "0";
+}
+
+uint64_t parsedSourceHash(const std::string& qualifier, const std::string& text) {
+  // FNV-1a, 64 bit
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix = [&hash](const std::string& s) {
+    for (char c : s) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+    }
+  };
+  mix(qualifier);
+  hash = (hash ^ text.size()) * 0x100000001b3ULL;
+  mix(text);
+  return hash;
+}
+
+struct ParsedSourceCache {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, std::vector<std::pair<QualifiedName, TreeRef>>>
+      entries;
+};
+
+ParsedSourceCache& parsedSourceCache() {
+  static ParsedSourceCache cache;
+  return cache;
+}
+
+} // namespace
+
 struct OpsValue : public SugaredValue {
   OpsValue(size_t version) : version_(version) {}
   std::string kind() const override {
@@ -112,23 +162,65 @@ struct SourceImporterImpl : public Resolver,
     if (auto custom_class = getCustomClass(name.qualifiedName())) {
       return custom_class;
     }
+    std::unique_lock<std::mutex> lock(mutex_);
     parseSourceIfNeeded(name.prefix());
-    auto it = to_be_defined_.find(name);
-    if (it != to_be_defined_.end() && it->second->kind() == TK_CLASS_DEF) {
-      ClassDef cd(it->second);
-      to_be_defined_.erase(it);
-      importNamedType(name.prefix(), cd);
+    while (true) {
+      // Types are registered before their methods are compiled, so once the
+      // lookup succeeds there is no need to wait for an in-flight import.
+      if (auto type = cu_->get_type(name)) {
+        return type;
+      }
+      auto pending = being_imported_.find(name);
+      if (pending != being_imported_.end()) {
+        if (pending->second.thread == std::this_thread::get_id()) {
+          // A self-reference from within the import itself; fall through to
+          // the lookup below, which reflects what has been registered so far.
+          break;
+        }
+        CompilationWaitGraph::beginWait(pending->second.token);
+        cv_.wait(lock);
+        CompilationWaitGraph::endWait();
+        continue;
+      }
+      auto it = to_be_defined_.find(name);
+      if (it != to_be_defined_.end() && it->second->kind() == TK_CLASS_DEF) {
+        ClassDef cd(it->second);
+        to_be_defined_.erase(it);
+        importWithLockReleased(
+            lock, name, [&] { importNamedType(name.prefix(), cd); });
+      }
+      break;
     }
     return cu_->get_type(name);
   }
 
   Function* findFunction(const QualifiedName& name) {
+    std::unique_lock<std::mutex> lock(mutex_);
     parseSourceIfNeeded(name.prefix());
-    auto it = to_be_defined_.find(name);
-    if (it != to_be_defined_.end() && it->second->kind() == TK_DEF) {
-      Def d(it->second);
-      to_be_defined_.erase(it);
-      importFunction(name.prefix(), d);
+    while (true) {
+      // Functions are registered before they are compiled;
+      // GraphFunction::ensure_defined synchronizes use of the graph itself.
+      if (auto fn = cu_->find_function(name)) {
+        return fn;
+      }
+      auto pending = being_imported_.find(name);
+      if (pending != being_imported_.end()) {
+        if (pending->second.thread == std::this_thread::get_id()) {
+          break;
+        }
+        CompilationWaitGraph::beginWait(pending->second.token);
+        cv_.wait(lock);
+        CompilationWaitGraph::endWait();
+        continue;
+      }
+      auto it = to_be_defined_.find(name);
+      if (it != to_be_defined_.end() && it->second->kind() == TK_DEF) {
+        Def d(it->second);
+        to_be_defined_.erase(it);
+        importWithLockReleased(
+            lock, name, [&] { importFunction(name.prefix(), d); });
+      }
+      break;
     }
     return cu_->find_function(name);
   }
@@ -148,11 +240,29 @@ struct SourceImporterImpl : public Resolver,
     if (!src) {
       return;
     }
+
+    // See Note [Source parse cache]
+    const bool use_cache = parseCacheEnabled();
+    uint64_t hash = 0;
+    if (use_cache) {
+      hash = parsedSourceHash(qualifier, src->text());
+      auto& cache = parsedSourceCache();
+      std::lock_guard<std::mutex> guard(cache.mutex);
+      auto cached = cache.entries.find(hash);
+      if (cached != cache.entries.end()) {
+        for (const auto& entry : cached->second) {
+          to_be_defined_[entry.first] = entry.second;
+        }
+        return;
+      }
+    }
+
     Parser p(src);
     parsePossibleVersionNumber(p.lexer());
 
     auto& L = p.lexer();
 
+    std::vector<std::pair<QualifiedName, TreeRef>> parsed;
     while (L.cur().kind != TK_EOF) {
       parseImports(L);
       auto tk = L.cur();
@@ -160,19 +270,30 @@ struct SourceImporterImpl : public Resolver,
       switch (kind) {
         case TK_CLASS_DEF: {
           auto parsed_treeref = ClassDef(p.parseClass());
-          to_be_defined_[QualifiedName(
-              qualifier, parsed_treeref.name().name())] = parsed_treeref;
+          parsed.emplace_back(
+              QualifiedName(qualifier, parsed_treeref.name().name()),
+              parsed_treeref);
         } break;
         case TK_DEF: {
           auto parsed_treeref = Def(p.parseFunction(/*is_method=*/false));
-          to_be_defined_[QualifiedName(
-              qualifier, parsed_treeref.name().name())] = parsed_treeref;
+          parsed.emplace_back(
+              QualifiedName(qualifier, parsed_treeref.name().name()),
+              parsed_treeref);
         } break;
         default:
           throw ErrorReport(L.cur().range)
               << "Unexpected token in code import: " << kindToString(kind);
       }
     }
+
+    for (const auto& entry : parsed) {
+      to_be_defined_[entry.first] = entry.second;
+    }
+    if (use_cache) {
+      auto& cache = parsedSourceCache();
+      std::lock_guard<std::mutex> guard(cache.mutex);
+      cache.entries.emplace(hash, std::move(parsed));
+    }
   }
 
   void LEGACY_import_methods(
@@ -225,7 +346,41 @@ struct SourceImporterImpl : public Resolver,
     return findNamedType(QualifiedName(name));
   }
 
+  bool supportsParallelCompilation() const override {
+    // All shared state is guarded by mutex_ (or by the CompilationUnit's own
+    // lock), so method graphs can be built concurrently.
+    return true;
+  }
+
  private:
+  // Runs `import_fn` for `name` with mutex_ released: compiling the imported
+  // definition re-enters the resolver, possibly from other threads. Threads
+  // that ask for `name` in the meantime wait on cv_ until the import
+  // finishes.
+  template <typename Fn>
+  void importWithLockReleased(
+      std::unique_lock<std::mutex>& lock,
+      const QualifiedName& name,
+      const Fn& import_fn) {
+    const auto token = CompilationWaitGraph::beginHold();
+    being_imported_.emplace(
+        name, PendingImport{std::this_thread::get_id(), token});
+    lock.unlock();
+    try {
+      import_fn();
+    } catch (...) {
+      lock.lock();
+      being_imported_.erase(name);
+      CompilationWaitGraph::endHold(token);
+      cv_.notify_all();
+      throw;
+    }
+    lock.lock();
+    being_imported_.erase(name);
+    CompilationWaitGraph::endHold(token);
+    cv_.notify_all();
+  }
+
   void importFunction(const std::string& qualifier, const Def& def) {
     std::vector<Def> definitions{def};
     std::vector<ResolverPtr> resolvers{shared_from_this()};
@@ -457,6 +612,18 @@ struct SourceImporterImpl : public Resolver,
   // named types and functions loaded from a file but not yet defined because
   // their type has not been requested yet.
   std::unordered_map<QualifiedName, TreeRef> to_be_defined_;
+  // Guards loaded_sources_, to_be_defined_ and being_imported_. The lock is
+  // released while an import compiles (see importWithLockReleased), so that
+  // several importer-driven compilations can proceed concurrently.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Imports currently in flight, mapped to the thread performing them and
+  // the wait-graph hold token registered for the import.
+  struct PendingImport {
+    std::thread::id thread;
+    uint64_t token;
+  };
+  std::unordered_map<QualifiedName, PendingImport> being_imported_;
 };
 
 std::shared_ptr<SugaredValue> ClassNamespaceValue::attr(
@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/serialization/pickle.h>
 #include <ATen/core/ivalue.h>
+#include <c10/util/string_utils.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/jit/serialization/export.h>
@@ -72,6 +73,57 @@ std::vector<char> pickle_save(const at::IValue& ivalue) {
 #endif
 }
 
+PickledSpans pickle_save_spans(const IValue& ivalue) {
+  PickledSpans result;
+  Pickler pickler([&](const char* buf, size_t size) {
+    result.data.insert(result.data.end(), buf, buf + size);
+  });
+  pickler.protocol();
+  pickler.pushIValue(ivalue);
+  pickler.stop();
+  result.tensor_data = pickler.tensorData();
+  return result;
+}
+
+IValue unpickle_spans(
+    const char* data,
+    size_t size,
+    const std::vector<std::pair<const char*, size_t>>& tensor_spans,
+    c10::optional<at::Device> device) {
+  size_t bytes_read = 0;
+  auto reader = [&](char* buffer, size_t len) -> size_t {
+    if (bytes_read >= size) {
+      return 0;
+    }
+    len = std::min(size - bytes_read, len);
+    std::memcpy(buffer, data + bytes_read, len);
+    bytes_read += len;
+    return len;
+  };
+  // Storage root keys are the span indices, in order of first reference.
+  auto read_record = [&](const std::string& name) -> at::DataPtr {
+    size_t idx = c10::stoull(name);
+    TORCH_CHECK(
+        idx < tensor_spans.size(),
+        "pickle data references tensor storage ",
+        name,
+        ", but only ",
+        tensor_spans.size(),
+        " spans were provided");
+    const auto& span = tensor_spans[idx];
+    void* ptr = malloc(span.second);
+    std::memcpy(ptr, span.first, span.second);
+    return at::DataPtr(ptr, ptr, free, at::kCPU);
+  };
+  Unpickler unpickler(
+      std::move(reader),
+      /*type_resolver=*/nullptr,
+      /*obj_loader=*/nullptr,
+      std::move(read_record),
+      std::move(device));
+  return unpickler.parse_ivalue();
+}
+
 #ifndef C10_MOBILE
 class VectorReader : public caffe2::serialize::ReadAdapterInterface {
  public:
@@ -114,6 +166,76 @@ IValue pickle_load(const std::vector<char>& data) {
 #endif
 };
 
+std::vector<char> pickle_save_incremental(
+    const IValue& ivalue,
+    const std::vector<char>& base) {
+#ifndef C10_MOBILE
+  std::vector<char> pickle_data;
+  Pickler pickler([&](const char* buf, size_t size) {
+    pickle_data.insert(pickle_data.end(), buf, buf + size);
+  });
+  pickler.protocol();
+  pickler.pushIValue(ivalue);
+  pickler.stop();
+
+  caffe2::serialize::PyTorchStreamReader base_reader(
+      std::make_unique<VectorReader>(base));
+
+  std::vector<char> container_data;
+  caffe2::serialize::PyTorchStreamWriter writer(
+      [&](const void* void_bytes, size_t len) {
+        const char* bytes = reinterpret_cast<const char*>(void_bytes);
+        container_data.insert(container_data.end(), bytes, bytes + len);
+        return len;
+      });
+  writeArchiveAndTensorsIncremental(
+      "data",
+      pickle_data.data(),
+      pickle_data.size(),
+      pickler.tensorData(),
+      base_reader,
+      writer);
+  return container_data;
+#else
+  AT_ERROR(
+      "pickle_save_incremental not supported on mobile "
+      "(see https://github.com/pytorch/pytorch/pull/30108)");
+#endif
+}
+
+IValue pickle_load_incremental(
+    const std::vector<char>& data,
+    const std::vector<std::vector<char>>& bases) {
+#ifndef C10_MOBILE
+  caffe2::serialize::PyTorchStreamReader reader(
+      std::make_unique<VectorReader>(data));
+
+  std::vector<std::unique_ptr<caffe2::serialize::PyTorchStreamReader>>
+      base_readers;
+  std::vector<caffe2::serialize::PyTorchStreamReader*> base_ptrs;
+  base_readers.reserve(bases.size());
+  base_ptrs.reserve(bases.size());
+  for (const auto& base : bases) {
+    base_readers.push_back(
+        std::make_unique<caffe2::serialize::PyTorchStreamReader>(
+            std::make_unique<VectorReader>(base)));
+    base_ptrs.push_back(base_readers.back().get());
+  }
+
+  return readArchiveAndTensors(
+      "data",
+      /*class_resolver=*/c10::nullopt,
+      /*obj_loader=*/c10::nullopt,
+      /*device=*/c10::nullopt,
+      reader,
+      base_ptrs);
+#else
+  AT_ERROR(
+      "pickle_load_incremental not supported on mobile "
+      "(see https://github.com/pytorch/pytorch/pull/30108)");
+#endif
+}
+
 IValue unpickle(
     std::function<size_t(char*, size_t)> reader,
     TypeResolver type_resolver,
@@ -56,10 +56,57 @@ TORCH_API std::vector<char> pickle(
 /// `torch::pickle_load` in C++ and `torch.load` in Python.
 TORCH_API std::vector<char> pickle_save(const IValue& ivalue);
 
+/// The result of `pickle_save_spans`: `data` holds the pickle program
+/// (metadata only) and `tensor_data` holds one contiguous (pointer, size)
+/// span per tensor storage, in the order the program references them (root
+/// keys "0", "1", ...). Each span keeps its CPU tensor alive, so a caller
+/// can writev(2) or send the spans directly, without funnelling
+/// multi-gigabyte payloads through an intermediate buffer the way
+/// `pickle_save` does.
+struct PickledSpans {
+  std::vector<char> data;
+  std::vector<WriteableTensorData> tensor_data;
+};
+
+/// Like `pickle_save`, but leaves tensor storages in place and returns them
+/// as separate spans for scatter-gather style writes; see `PickledSpans`.
+/// Use `unpickle_spans` to reconstruct the IValue.
+TORCH_API PickledSpans pickle_save_spans(const IValue& ivalue);
+
+/// Counterpart to `pickle_save_spans`: reconstructs an IValue from the
+/// pickle program in [`data`, `data` + `size`) and the tensor storage spans
+/// in root-key order (e.g. gathered back out of an RPC message). The span
+/// contents are copied into freshly allocated storages, so the inputs only
+/// need to stay alive for the duration of the call.
+TORCH_API IValue unpickle_spans(
+    const char* data,
+    size_t size,
+    const std::vector<std::pair<const char*, size_t>>& tensor_spans,
+    c10::optional<at::Device> device = c10::nullopt);
+
 /// Deserialize a `torch::IValue` from bytes produced by either
 /// `torch::pickle_save` in C++ or `torch.save` in Python
 TORCH_API IValue pickle_load(const std::vector<char>& data);
 
+/// Like `pickle_save`, but writes an incremental (delta) archive against
+/// `base`, which must be the bytes of an earlier `pickle_save` or
+/// `pickle_save_incremental` result: tensor records whose content is
+/// unchanged are stored as small references into the base instead of their
+/// bytes. Intended for frequent checkpoints where most storages (typically
+/// optimizer state) do not change between snapshots. Load the result with
+/// `pickle_load_incremental`.
+TORCH_API std::vector<char> pickle_save_incremental(
+    const IValue& ivalue,
+    const std::vector<char>& base);
+
+/// Counterpart to `pickle_save_incremental`: deserializes `data`, resolving
+/// records it references out of `bases`, the chain of earlier checkpoint
+/// bytes ordered newest first. A plain `pickle_save` archive loads with an
+/// empty chain.
+TORCH_API IValue pickle_load_incremental(
+    const std::vector<char>& data,
+    const std::vector<std::vector<char>>& bases);
+
 /// `reader` is a function that takes in a size to read from some pickled
 /// binary. `reader` should remember where it last read, and return
 /// the number of bytes read.
@@ -2,6 +2,7 @@
 #include <torch/csrc/jit/serialization/source_range_serialization_impl.h>
 
 #include <ATen/core/ivalue.h>
+#include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/serialization/pickle.h>
 
 namespace torch {
@@ -106,11 +107,26 @@ ConcreteSourceRangeUnpickler::ConcreteSourceRangeUnpickler(
       deserializer(new SourceRangeDeserializer()),
       unpickled_records(nullptr) {}
 
+ConcreteSourceRangeUnpickler::ConcreteSourceRangeUnpickler(
+    std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader,
+    std::string record_name)
+    : size(0),
+      reader(std::move(reader)),
+      record_name(std::move(record_name)),
+      deserializer(new SourceRangeDeserializer()),
+      unpickled_records(nullptr) {}
+
 void ConcreteSourceRangeUnpickler::unpickle() {
   if (unpickled_records) {
     return;
   }
 
+  if (reader) {
+    // The record read was deferred at import time; do it now.
+    std::tie(data, size) = reader->getRecord(record_name);
+    reader = nullptr;
+  }
+
   auto ivalues = jit::unpickle(reinterpret_cast<const char*>(data.get()), size)
                      .toTuple()
                      ->elements();
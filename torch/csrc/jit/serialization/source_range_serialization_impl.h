@@ -2,6 +2,12 @@
 
 #include <torch/csrc/jit/serialization/source_range_serialization.h>
 
+namespace caffe2 {
+namespace serialize {
+class PyTorchStreamReader;
+} // namespace serialize
+} // namespace caffe2
+
 namespace torch {
 namespace jit {
 
@@ -12,6 +18,13 @@ class ConcreteSourceRangeUnpickler : public SourceRangeUnpickler {
  public:
   ConcreteSourceRangeUnpickler(at::DataPtr&& data, size_t size);
 
+  // Defers reading `record_name` from `reader` until the first lookup.
+  // Debug info is only consulted when an error is raised, so imports that
+  // never throw skip the record read (and decompression) entirely.
+  ConcreteSourceRangeUnpickler(
+      std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader,
+      std::string record_name);
+
   c10::optional<SourceRange> findSourceRangeThatGenerated(
       const SourceRange& range) override;
 
@@ -19,6 +32,9 @@ class ConcreteSourceRangeUnpickler : public SourceRangeUnpickler {
   at::DataPtr data;
   size_t size;
 
+  std::shared_ptr<caffe2::serialize::PyTorchStreamReader> reader;
+  std::string record_name;
+
   void unpickle();
 
   std::shared_ptr<SourceRangeDeserializer> deserializer;
@@ -213,6 +213,11 @@ void Unpickler::run() {
 void Unpickler::setInput(size_t memo_id) {
   AT_ASSERT(!stack_.empty());
   if (memo_id >= memo_table_.size()) {
+    if (memo_id >= memo_table_.capacity()) {
+      // Memo ids are assigned mostly sequentially, so grow geometrically
+      // up front instead of reallocating the table entry by entry.
+      memo_table_.reserve(std::max(memo_id + 1, 2 * memo_table_.capacity()));
+    }
     memo_table_.insert(
         memo_table_.end(), memo_id - memo_table_.size(), IValue());
     memo_table_.push_back(stack_.back());
@@ -304,7 +309,7 @@ PickleOpCode Unpickler::readInstruction() {
     } break;
     case PickleOpCode::BINUNICODE: {
       uint32_t length = read<uint32_t>();
-      stack_.emplace_back(readBytes(length));
+      stack_.emplace_back(internString(readBytes(length)));
     } break;
     case PickleOpCode::BINFLOAT:
       stack_.emplace_back(readFloat());
@@ -745,6 +750,21 @@ std::string Unpickler::readBytes(size_t length) {
   return data;
 }
 
+// The pickler memoizes strings by object identity, not by content, so the
+// same text can occur many times in one archive (attribute keys and type
+// names recur on every entry of a large state dict). Share a single
+// ConstantString per distinct text instead of allocating one per occurrence.
+IValue Unpickler::internString(std::string&& ss) {
+  auto it = interned_strings_.find(ss);
+  if (it == interned_strings_.end()) {
+    // NB: construct the IValue from a copy first; the emplace below moves
+    // `ss` into the key, and argument evaluation order is unspecified.
+    IValue value(static_cast<const std::string&>(ss));
+    it = interned_strings_.emplace(std::move(ss), std::move(value)).first;
+  }
+  return it->second;
+}
+
 // Pop all the list items off of the stack and append them to the list at
 // the corresponding MARK
 void Unpickler::readList(IValue list_ivalue) {
@@ -90,6 +90,7 @@ class Unpickler {
   }
   void readSlowWithBuffer(char* dest, size_t sz);
   std::string readBytes(size_t num_bytes);
+  IValue internString(std::string&& ss);
 
   double readFloat();
   void readGlobal(
@@ -131,6 +132,11 @@ class Unpickler {
   // pickler, so we can just use the actual data pointer of each string.
   std::unordered_map<std::string, c10::TypePtr> type_cache_;
 
+  // The pickler only memoizes strings by object identity, so the same text
+  // (attribute keys, type names, ...) can appear many times in one archive.
+  // Intern them so each distinct string is heap-allocated once per unpickle.
+  std::unordered_map<std::string, IValue> interned_strings_;
+
   // optionally nullptr, needs to be present for creating classes
   TypeResolver type_resolver_;
   ObjLoader obj_loader_;
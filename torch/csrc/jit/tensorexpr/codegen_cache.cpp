@@ -0,0 +1,162 @@
+#include <torch/csrc/jit/tensorexpr/codegen_cache.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+namespace {
+
+std::mutex& cacheDirMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::string& cacheDirStorage() {
+  static std::string dir = []() {
+    const char* env = std::getenv("PYTORCH_TENSOREXPR_CACHE_DIR");
+    return std::string(env ? env : "");
+  }();
+  return dir;
+}
+
+void makeCacheDir(const std::string& dir) {
+  // Only the leaf directory is created; a missing parent simply leaves the
+  // cache cold, which store() tolerates.
+#ifdef _WIN32
+  _mkdir(dir.c_str());
+#else
+  mkdir(dir.c_str(), 0777);
+#endif
+}
+
+// FNV-1a, used only to name the cache file; lookups verify the stored
+// source and tag, so a collision is just a miss.
+uint64_t hashKey(const std::string& source, const std::string& tag) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto mix = [&h](const std::string& s) {
+    for (char c : s) {
+      h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+    }
+    h = (h ^ 0xff) * 0x100000001b3ULL;
+  };
+  mix(tag);
+  mix(source);
+  return h;
+}
+
+std::string entryPath(const std::string& source, const std::string& tag) {
+  std::ostringstream oss;
+  oss << codegenCacheDir() << "/" << std::hex << hashKey(source, tag)
+      << ".kernel";
+  return oss.str();
+}
+
+bool readField(std::istream& in, std::string& field) {
+  uint64_t size = 0;
+  if (!in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    return false;
+  }
+  field.resize(size);
+  return size == 0 || bool(in.read(&field[0], size));
+}
+
+void writeField(std::ostream& out, const std::string& field) {
+  uint64_t size = field.size();
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out.write(field.data(), size);
+}
+
+} // namespace
+
+const std::string& codegenCacheDir() {
+  std::lock_guard<std::mutex> lock(cacheDirMutex());
+  return cacheDirStorage();
+}
+
+void setCodegenCacheDir(const std::string& dir) {
+  std::lock_guard<std::mutex> lock(cacheDirMutex());
+  cacheDirStorage() = dir;
+}
+
+bool codegenCacheEnabled() {
+  return !codegenCacheDir().empty();
+}
+
+c10::optional<std::string> codegenCacheLoad(
+    const std::string& source,
+    const std::string& tag) {
+  if (!codegenCacheEnabled()) {
+    return c10::nullopt;
+  }
+  std::ifstream in(entryPath(source, tag), std::ios::binary);
+  if (!in) {
+    return c10::nullopt;
+  }
+  std::string stored_tag;
+  std::string stored_source;
+  std::string artifact;
+  if (!readField(in, stored_tag) || !readField(in, stored_source) ||
+      !readField(in, artifact)) {
+    return c10::nullopt;
+  }
+  if (stored_tag != tag || stored_source != source) {
+    return c10::nullopt;
+  }
+  return artifact;
+}
+
+void codegenCacheStore(
+    const std::string& source,
+    const std::string& tag,
+    const std::string& artifact) {
+  if (!codegenCacheEnabled()) {
+    return;
+  }
+  const std::string path = entryPath(source, tag);
+  makeCacheDir(codegenCacheDir());
+  // Write to a process-private temp file and rename it into place, so a
+  // concurrent reader never observes a partially written entry.
+#ifdef _WIN32
+  const auto pid = _getpid();
+#else
+  const auto pid = getpid();
+#endif
+  const std::string tmp_path = path + ".tmp." + std::to_string(pid);
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    writeField(out, tag);
+    writeField(out, source);
+    writeField(out, artifact);
+    if (!out) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    // Another process may have published the same entry first.
+    std::remove(tmp_path.c_str());
+  }
+}
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <string>
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+// Persistent, cross-process cache for compiled fusion kernels.
+//
+// Identical fusion groups are recompiled from scratch by every process at
+// warmup. When a cache directory is configured, the codegen backends store
+// their compiled artifacts (PTX for the NVRTC backend, native object files
+// for the LLVM backend) in that directory, keyed by the canonicalized kernel
+// source and a backend-specific target tag, so warm starts skip compilation
+// entirely. The directory may be shared by any number of concurrent
+// processes: entries are written atomically via rename, and a lookup
+// verifies the stored source and tag so hash collisions degrade to misses.
+//
+// The cache is disabled unless the PYTORCH_TENSOREXPR_CACHE_DIR environment
+// variable points at a (creatable) directory, or a directory is set
+// explicitly with setCodegenCacheDir. Entries are never invalidated
+// automatically; the tag must encode everything the artifact depends on
+// (compiler version, target architecture, etc.).
+
+// Returns the configured cache directory, or an empty string when caching
+// is disabled.
+TORCH_API const std::string& codegenCacheDir();
+
+// Overrides the cache directory. An empty string disables caching.
+TORCH_API void setCodegenCacheDir(const std::string& dir);
+
+TORCH_API bool codegenCacheEnabled();
+
+// Returns the artifact previously stored for (source, tag), or nullopt.
+TORCH_API c10::optional<std::string> codegenCacheLoad(
+    const std::string& source,
+    const std::string& tag);
+
+// Stores an artifact for (source, tag). Best effort: I/O failures are
+// ignored, the caller has a freshly compiled kernel either way.
+TORCH_API void codegenCacheStore(
+    const std::string& source,
+    const std::string& tag,
+    const std::string& artifact);
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
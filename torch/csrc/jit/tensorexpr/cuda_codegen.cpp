@@ -4,6 +4,7 @@
 #include <ATen/CUDAGeneratorImpl.h>
 #include <c10/cuda/CUDAFunctions.h>
 #include <torch/csrc/jit/tensorexpr/analysis.h>
+#include <torch/csrc/jit/tensorexpr/codegen_cache.h>
 #include <torch/csrc/jit/tensorexpr/cuda_random.h>
 #include <torch/csrc/jit/tensorexpr/eval.h>
 #include <torch/csrc/jit/tensorexpr/exceptions.h>
@@ -640,6 +641,37 @@ void CudaCodeGen::CompileToNVRTC(
             << "minor: " << minor << std::endl;
 #endif
 
+  // The function name embeds a process-local counter, so strip it from the
+  // cache key; the cached artifact remembers the name it was compiled under
+  // on its first line, followed by the PTX image.
+  std::string cache_tag;
+  std::string canonical_code;
+  if (codegenCacheEnabled()) {
+    canonical_code = code;
+    for (size_t pos = canonical_code.find(func_name); pos != std::string::npos;
+         pos = canonical_code.find(func_name, pos)) {
+      canonical_code.replace(pos, func_name.size(), "func");
+    }
+    int nvrtc_major, nvrtc_minor;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+    cache_tag = "nvrtc_" + std::to_string(nvrtc_major) + "." +
+        std::to_string(nvrtc_minor) + "_compute_" + std::to_string(major) +
+        std::to_string(minor);
+    if (auto cached = codegenCacheLoad(canonical_code, cache_tag)) {
+      const size_t split = cached->find('\n');
+      if (split != std::string::npos) {
+        const std::string cached_name = cached->substr(0, split);
+        CUmodule module;
+        AT_CUDA_DRIVER_CHECK(
+            nvrtc().cuModuleLoadData(&module, cached->c_str() + split + 1));
+        AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleGetFunction(
+            &function_, module, cached_name.c_str()));
+        at::cuda::set_device(prior_device);
+        return;
+      }
+    }
+  }
+
   // Creates the NVRTC program
   nvrtcProgram program;
   AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
@@ -676,6 +708,13 @@ void CudaCodeGen::CompileToNVRTC(
   ptx.resize(ptx_size);
   AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx.data()));
 
+  if (codegenCacheEnabled()) {
+    codegenCacheStore(
+        canonical_code,
+        cache_tag,
+        func_name + "\n" + std::string(ptx.data(), ptx.size()));
+  }
+
   CUmodule module;
   AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleLoadData(&module, ptx.data()));
   AT_CUDA_DRIVER_CHECK(
@@ -392,6 +392,164 @@ Tensor* TensorExprKernel::computeFourOperand(
       });
 }
 
+Tensor* TensorExprKernel::computeSum(const torch::jit::Value* v) {
+  auto const& n = v->node();
+  auto const& inputShape = valueShape(n->inputs()[0]);
+  size_t rank = inputShape.size();
+  hasReduction_ = true;
+
+  // Only the dim-list overload is lowered:
+  //   aten::sum.dim_IntList(Tensor self, int[1] dim, bool keepdim=False, *,
+  //                         ScalarType? dtype=None)
+  // Full reductions produce a zero-dim tensor and would put a reduction axis
+  // in the outer-most loop, which the schedule parallelizes; we don't lower
+  // them and let the kernel fall back instead.
+  if (n->inputs().size() != 4) {
+    throw malformed_input("unsupported sum overload");
+  }
+  auto dimsValue = toIValue(n->inputs()[1]);
+  auto keepdimValue = toIValue(n->inputs()[2]);
+  if (!dimsValue || !dimsValue->isIntList() || !keepdimValue ||
+      !keepdimValue->isBool()) {
+    throw malformed_input("non-constant dims or keepdim in sum");
+  }
+  bool keepdim = keepdimValue->toBool();
+  std::vector<bool> isReduced(rank, false);
+  for (int64_t dim : dimsValue->toIntVector()) {
+    if (dim < 0) {
+      dim += rank;
+    }
+    if (dim < 0 || static_cast<size_t>(dim) >= rank) {
+      throw malformed_input("invalid reduction dim in sum");
+    }
+    isReduced[dim] = true;
+  }
+
+  auto outputDims = texprDims(v);
+  if (outputDims.empty()) {
+    throw malformed_input("full reductions are not supported");
+  }
+
+  std::vector<DimArg> reduceDims;
+  for (size_t i = 0; i < rank; i++) {
+    if (isReduced[i]) {
+      reduceDims.emplace_back(inputShape[i], "r" + c10::to_string(i));
+    }
+  }
+
+  size_t numOutputDims = outputDims.size();
+  return Reduce(
+      "aten_sum",
+      outputDims,
+      Sum(),
+      [this, v, rank, isReduced, keepdim, numOutputDims](
+          ParameterList& allVars) {
+        // allVars holds the output axes followed by the reduction axes.
+        auto const& n = v->node();
+        std::vector<ExprHandle> axes;
+        size_t outIdx = 0;
+        size_t reduceIdx = numOutputDims;
+        for (size_t i = 0; i < rank; i++) {
+          if (isReduced[i]) {
+            axes.push_back(allVars[reduceIdx++]);
+            if (keepdim) {
+              // Skip over the size-one output axis.
+              outIdx++;
+            }
+          } else {
+            axes.push_back(allVars[outIdx++]);
+          }
+        }
+        return demoteOutput(
+            tensorOrConstant(n->inputs()[0], axes), n->output());
+      },
+      reduceDims);
+}
+
+Tensor* TensorExprKernel::computeSoftmax(const torch::jit::Value* v) {
+  // aten::softmax(Tensor self, int dim, ScalarType? dtype=None)
+  //
+  // Lowered as the usual numerically stable decomposition: a max reduction
+  // over the softmax dim, a pointwise exp of the shifted input, a sum
+  // reduction and a pointwise division. All four stay in one kernel, so the
+  // intermediates are never materialized to full output tensors outside it.
+  auto const& n = v->node();
+  auto const& shape = valueShape(n->inputs()[0]);
+  size_t rank = shape.size();
+  hasReduction_ = true;
+
+  int64_t dim = constant(n->inputs()[1]).AsNode<IntImm>()->value();
+  if (dim < 0) {
+    dim += rank;
+  }
+  // Softmax over the only dim of a 1-D input would be a full reduction; see
+  // the note in computeSum.
+  if (rank < 2 || dim < 0 || static_cast<size_t>(dim) >= rank) {
+    throw malformed_input("unsupported softmax dim");
+  }
+
+  std::vector<DimArg> nonReducedDims;
+  for (size_t i = 0; i < rank; i++) {
+    if (i != static_cast<size_t>(dim)) {
+      nonReducedDims.emplace_back(shape[i], "i" + c10::to_string(i));
+    }
+  }
+  std::vector<DimArg> reducedDims = {DimArg(shape[dim], "r")};
+
+  // Reconstruct the input axes from the non-reduced axes followed by the
+  // reduction axis.
+  auto toInputAxes = [dim](ParameterList& vars) {
+    std::vector<ExprHandle> axes(vars.begin(), vars.end() - 1);
+    axes.insert(axes.begin() + dim, vars.back());
+    return axes;
+  };
+  // Drop the softmax dim from the output axes to index the reductions.
+  auto toNonReducedAxes = [dim](ParameterList& axes) {
+    std::vector<ExprHandle> nonReduced;
+    for (size_t i = 0; i < axes.size(); i++) {
+      if (i != static_cast<size_t>(dim)) {
+        nonReduced.push_back(axes[i]);
+      }
+    }
+    return nonReduced;
+  };
+
+  Dtype inputDtype = tensors_.at(n->inputs()[0]->unique())->body()->dtype();
+  Tensor* max = Reduce(
+      "aten_softmax_max",
+      nonReducedDims,
+      Maximum(inputDtype),
+      [this, n, &toInputAxes](ParameterList& vars) {
+        return tensorOrConstant(n->inputs()[0], toInputAxes(vars));
+      },
+      reducedDims);
+  Tensor* e = Compute(
+      "aten_softmax_exp",
+      texprDims(v),
+      [this, n, max, &toNonReducedAxes](ParameterList& axes) {
+        auto inp = tensorOrConstant(
+            n->inputs()[0], std::vector<ExprHandle>(axes.begin(), axes.end()));
+        return exp(inp - max->call(toNonReducedAxes(axes)));
+      });
+  Tensor* sum = Reduce(
+      "aten_softmax_sum",
+      nonReducedDims,
+      Sum(),
+      [e, &toInputAxes](ParameterList& vars) {
+        return e->call(toInputAxes(vars));
+      },
+      reducedDims);
+  return Compute(
+      "aten_softmax",
+      texprDims(v),
+      [this, n, e, sum, &toNonReducedAxes](ParameterList& axes) {
+        ExprHandle compute =
+            e->call(std::vector<ExprHandle>(axes.begin(), axes.end())) /
+            sum->call(toNonReducedAxes(axes));
+        return demoteOutput(compute, n->output());
+      });
+}
+
 Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
   switch (v->node()->kind()) {
     case aten::add: {
@@ -943,6 +1101,14 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
           });
     }
 
+    case aten::sum: {
+      return computeSum(v);
+    }
+
+    case aten::softmax: {
+      return computeSoftmax(v);
+    }
+
     default: {
       throw std::runtime_error("Unhandled node kind");
     }
@@ -950,6 +1116,10 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
 }
 
 void TensorExprKernel::lowerToBackend(BackendType backendType) {
+  if (backendType == kCudaCodeGen && hasReduction_) {
+    throw std::runtime_error("Reductions are not yet supported in cuda codegen");
+  }
+
   std::vector<Tensor*> tensorOutputs(tensorOutputs_);
 
   if (backendType == BackendType::kCudaCodeGen) {
@@ -998,6 +1168,11 @@ void TensorExprKernel::lowerToBackend(BackendType backendType) {
     if (!l.hasLoopBodyFor(p.second)) {
       continue;
     }
+    // Reductions are computed into intermediate buffers rather than being
+    // inlined into their consumers.
+    if (dynamic_cast<const ReduceOp*>(p.second->body())) {
+      continue;
+    }
     Stmt* loop = l.getLoopBodyFor(p.second);
     if (torch::jit::tensorexpr::HasRand(loop).has_rand()) {
       l.computeInlineWithRandom(loop);
@@ -1050,27 +1225,31 @@ void TensorExprKernel::lowerToBackend(BackendType backendType) {
   } else if (backendType == kLLVMCodeGen) {
     l.prepareForCodegen();
 
-    std::vector<For*> innerLoops;
-    std::vector<For*> worklist;
-
     // Find outer-most For loops
-    if (For* rootF = dynamic_cast<For*>(l.root_stmt())) {
-      worklist.push_back(rootF);
-    } else if (Block* body = dynamic_cast<Block*>(l.root_stmt())) {
-      std::vector<Block*> blocks = {body};
-      while (blocks.size()) {
-        Block* b = blocks.back();
-        blocks.pop_back();
-
-        for (Stmt* s : b->stmts()) {
-          if (For* f = dynamic_cast<For*>(s)) {
-            worklist.push_back(f);
-          } else if (Block* b2 = dynamic_cast<Block*>(s)) {
-            blocks.push_back(b2);
+    auto findOuterLoops = [&l]() {
+      std::vector<For*> outerLoops;
+      if (For* rootF = dynamic_cast<For*>(l.root_stmt())) {
+        outerLoops.push_back(rootF);
+      } else if (Block* body = dynamic_cast<Block*>(l.root_stmt())) {
+        std::vector<Block*> blocks = {body};
+        while (blocks.size()) {
+          Block* b = blocks.back();
+          blocks.pop_back();
+
+          for (Stmt* s : b->stmts()) {
+            if (For* f = dynamic_cast<For*>(s)) {
+              outerLoops.push_back(f);
+            } else if (Block* b2 = dynamic_cast<Block*>(s)) {
+              blocks.push_back(b2);
+            }
           }
         }
       }
-    }
+      return outerLoops;
+    };
+
+    std::vector<For*> innerLoops;
+    std::vector<For*> worklist = findOuterLoops();
 
     // Traverse the For loop nest find inner-most loops, which are
     // vectorization candidates.
@@ -1110,9 +1289,21 @@ void TensorExprKernel::lowerToBackend(BackendType backendType) {
         l.vectorize(split2);
       }
     }
+
+    // Parallelize the outer-most loops over the intra-op thread pool.
+    // Re-discover them, since splitWithTail replaced the loops collected
+    // above when an outer-most loop was also inner-most.
+    for (For* loop : findOuterLoops()) {
+      l.setParallel(loop);
+    }
   }
 
-  l.prepareForCodegen();
+  if (backendType != kLLVMCodeGen) {
+    // The LLVM backend already prepared for codegen before scheduling;
+    // preparing twice would insert duplicate allocations for intermediate
+    // reduction buffers.
+    l.prepareForCodegen();
+  }
   Stmt* stmt = l.root_stmt();
   // Arithmetic Simplification.
   stmt = IRSimplifier::simplify(stmt);
@@ -151,6 +151,10 @@ class TensorExprKernel {
           const ExprHandle&,
           const ExprHandle&)>& innerExpr);
 
+  Tensor* computeSum(const torch::jit::Value* v);
+
+  Tensor* computeSoftmax(const torch::jit::Value* v);
+
   Tensor* computeValue(const torch::jit::Value* v);
 
   void lowerToBackend(BackendType backendType);
@@ -219,6 +223,7 @@ class TensorExprKernel {
   bool fallback_{false};
   bool hasRandom_{false};
   bool hasBroadcast_{false};
+  bool hasReduction_{false};
 };
 
 TORCH_API int& getTECudaPointwiseLoopLevels();
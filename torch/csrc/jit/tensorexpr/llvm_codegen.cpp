@@ -4,18 +4,24 @@
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
 #include <memory>
+#include <unordered_set>
 
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 
+#include <ATen/Parallel.h>
 #include <torch/csrc/jit/tensorexpr/buffer.h>
+#include <torch/csrc/jit/tensorexpr/codegen_cache.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
 #include <torch/csrc/jit/tensorexpr/ir.h>
 #include <torch/csrc/jit/tensorexpr/ir_printer.h>
@@ -28,6 +34,30 @@ using namespace torch::jit::tensorexpr;
 DEFINE_TRIGGER(llvm_codegen_created);
 DEFINE_TRIGGER(llvm_codegen_executed);
 
+extern "C" {
+
+typedef void (*ParallelCallee)(int32_t index, int8_t* packed_data);
+
+// Run a compiled loop body over [start, stop) on the intra-op thread pool.
+// Parallel For loops are lowered to a call to this function; the loop body
+// is outlined into a separate function and its captured variables are
+// packed into packed_data. See LLVMCodeGenImpl::processParallelFor.
+void DispatchParallel(
+    int8_t* func,
+    int32_t start,
+    int32_t stop,
+    int8_t* packed_data) noexcept {
+  // TODO: preserve the func type.
+  at::parallel_for(start, stop, 1, [&](int64_t f_begin, int64_t f_end) {
+    ParallelCallee callee = reinterpret_cast<ParallelCallee>(func);
+    for (int32_t index = f_begin; index < f_end; index++) {
+      callee(index, packed_data);
+    }
+  });
+}
+
+} // extern "C"
+
 namespace torch {
 namespace jit {
 namespace tensorexpr {
@@ -56,6 +86,7 @@ class LLVMCodeGenImpl : public IRVisitor {
   llvm::Type* dtypeToLLVMPtr(Dtype dtype);
   void emitWrapper(const std::vector<llvm::Type*>& params);
   void emitKernel(Stmt* stmt, const std::vector<llvm::Type*>& params);
+  void processParallelFor(const For* v);
 
  public:
   LLVMCodeGenImpl(
@@ -257,8 +288,30 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   emitWrapper(params);
   emitKernel(stmt, params);
 
-  cantFail(jit_->addModule(
-      llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  if (codegenCacheEnabled()) {
+    // The emitted IR is deterministic for identical fusion groups (all
+    // symbol and block names are fixed), so the printed module doubles as
+    // the persistent cache key. A hit loads the cached native object
+    // directly; a miss compiles the module to an object here so the exact
+    // artifact that runs is what gets published.
+    std::string ir;
+    llvm::raw_string_ostream ir_stream(ir);
+    ir_stream << *module_;
+    ir_stream.flush();
+    const std::string cache_tag = "llvm_" + module_->getTargetTriple() + "_" +
+        llvm::sys::getHostCPUName().str();
+    std::unique_ptr<llvm::MemoryBuffer> obj;
+    if (auto cached = codegenCacheLoad(ir, cache_tag)) {
+      obj = llvm::MemoryBuffer::getMemBufferCopy(*cached);
+    } else {
+      obj = llvm::orc::SimpleCompiler(*TM_)(*module_);
+      codegenCacheStore(ir, cache_tag, obj->getBuffer().str());
+    }
+    cantFail(jit_->addObject(std::move(obj)));
+  } else {
+    cantFail(jit_->addModule(
+        llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  }
   auto sym = jit_->findSymbol("wrapper");
   kernelAddress_ = cantFail(sym.getAddress());
 
@@ -897,7 +950,130 @@ void LLVMCodeGenImpl::visit(const Load* v) {
   value_ = load;
 }
 
+namespace {
+
+// Collects the distinct Vars referenced by a parallel loop body, in a
+// deterministic order, so they can be packed into the closure passed to the
+// outlined loop function.
+class ClosureVarFinder : public IRVisitor {
+ public:
+  void visit(const Var* v) override {
+    if (seen_.insert(v).second) {
+      vars_.push_back(v);
+    }
+  }
+
+  const std::vector<const Var*>& vars() const {
+    return vars_;
+  }
+
+ private:
+  std::unordered_set<const Var*> seen_;
+  std::vector<const Var*> vars_;
+};
+
+} // namespace
+
+void LLVMCodeGenImpl::processParallelFor(const For* v) {
+  // Create "start" and "stop" values.
+  v->start()->accept(this);
+  auto start = this->value_;
+  v->stop()->accept(this);
+  auto stop = this->value_;
+
+  // The loop body is outlined into a separate function, so gather the
+  // variables it captures from the surrounding scope. Variables bound
+  // within the body itself are in neither map and are skipped.
+  ClosureVarFinder finder;
+  v->body()->accept(&finder);
+  std::vector<const Var*> closure_vars;
+  std::vector<llvm::Value*> closure_vals;
+  for (const Var* var : finder.vars()) {
+    if (var == v->var()) {
+      continue;
+    }
+    if (varToArg_.count(var)) {
+      closure_vars.push_back(var);
+      closure_vals.push_back(fn_->arg_begin() + varToArg_.at(var));
+    } else if (varToVal_.count(var)) {
+      closure_vars.push_back(var);
+      closure_vals.push_back(varToVal_.at(var));
+    }
+  }
+
+  // Pack the captured values into a struct in the caller's frame.
+  auto bytePtrTy = llvm::Type::getInt8PtrTy(getContext());
+  std::vector<llvm::Type*> closure_types;
+  for (auto val : closure_vals) {
+    closure_types.push_back(val->getType());
+  }
+  auto closure_ty = llvm::StructType::get(getContext(), closure_types);
+  auto closure = irb_.CreateAlloca(closure_ty);
+  for (size_t i = 0; i < closure_vals.size(); i++) {
+    irb_.CreateStore(
+        closure_vals[i], irb_.CreateStructGEP(closure_ty, closure, i));
+  }
+  auto packed_data = irb_.CreatePointerCast(closure, bytePtrTy);
+
+  // Create the outlined loop body function: void(int32_t index, int8_t*).
+  auto callee_ty = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(getContext()), {IntTy_, bytePtrTy}, false);
+  auto callee = llvm::Function::Create(
+      callee_ty, llvm::Function::PrivateLinkage, "parallel_body", module_.get());
+
+  // Codegen the body into the callee, rebinding the captured variables to
+  // the values unpacked from the closure.
+  auto caller_insert_block = irb_.GetInsertBlock();
+  auto old_fn = fn_;
+  auto old_varToArg = std::move(varToArg_);
+  varToArg_.clear();
+  auto old_varToVal = std::move(varToVal_);
+  varToVal_.clear();
+
+  fn_ = callee;
+  auto entry = llvm::BasicBlock::Create(getContext(), "entry", fn_);
+  irb_.SetInsertPoint(entry);
+  auto unpacked =
+      irb_.CreatePointerCast(callee->arg_begin() + 1, closure_ty->getPointerTo());
+  for (size_t i = 0; i < closure_vars.size(); i++) {
+    varToVal_.emplace(
+        closure_vars[i],
+        irb_.CreateLoad(irb_.CreateStructGEP(closure_ty, unpacked, i)));
+  }
+  varToVal_.emplace(v->var(), callee->arg_begin());
+  if (v->body()) {
+    v->body()->accept(this);
+  }
+  irb_.CreateRetVoid();
+
+  fn_ = old_fn;
+  varToArg_ = std::move(old_varToArg);
+  varToVal_ = std::move(old_varToVal);
+  irb_.SetInsertPoint(caller_insert_block);
+
+  // Dispatch the outlined body over the intra-op thread pool.
+  llvm::FunctionCallee dispatcher = module_->getOrInsertFunction(
+      "DispatchParallel",
+      llvm::FunctionType::get(
+          llvm::Type::getVoidTy(getContext()),
+          {bytePtrTy, IntTy_, IntTy_, bytePtrTy},
+          false));
+  llvm::cast<llvm::Function>(dispatcher.getCallee())
+      ->addFnAttr(llvm::Attribute::NoUnwind);
+  auto func_value = irb_.CreatePointerCast(callee, bytePtrTy);
+  irb_.CreateCall(
+      dispatcher.getFunctionType(),
+      dispatcher.getCallee(),
+      {func_value, start, stop, packed_data});
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
+}
+
 void LLVMCodeGenImpl::visit(const For* v) {
+  if (v->loop_options().is_parallel()) {
+    processParallelFor(v);
+    return;
+  }
+
   // Create "start" and "stop" values.
   v->start()->accept(this);
   auto start = this->value_;
@@ -1448,11 +1624,40 @@ void LLVMCodeGenImpl::visit(const FunctionCall* v) {
 }
 
 void LLVMCodeGenImpl::visit(const Allocate* v) {
-  throw unimplemented_lowering(v);
+  llvm::Value* size =
+      llvm::ConstantInt::getSigned(LongTy_, v->dtype().byte_size());
+  for (const Expr* dim : v->dims()) {
+    dim->accept(this);
+    size = irb_.CreateMul(size, irb_.CreateSExt(value_, LongTy_));
+  }
+
+  auto bytePtrTy = llvm::Type::getInt8PtrTy(getContext());
+  llvm::FunctionCallee malloc_fn = module_->getOrInsertFunction(
+      "malloc", llvm::FunctionType::get(bytePtrTy, {LongTy_}, false));
+  auto buffer = irb_.CreateCall(
+      malloc_fn.getFunctionType(), malloc_fn.getCallee(), {size});
+  varToVal_.emplace(
+      v->buffer_var(), irb_.CreatePointerCast(buffer, dtypeToLLVMPtr(v->dtype())));
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
 }
 
 void LLVMCodeGenImpl::visit(const Free* v) {
-  throw unimplemented_lowering(v);
+  auto it = varToVal_.find(v->buffer_var());
+  if (it == varToVal_.end()) {
+    throw malformed_input("freeing an unallocated buffer in LLVM codegen");
+  }
+
+  auto bytePtrTy = llvm::Type::getInt8PtrTy(getContext());
+  llvm::FunctionCallee free_fn = module_->getOrInsertFunction(
+      "free",
+      llvm::FunctionType::get(
+          llvm::Type::getVoidTy(getContext()), {bytePtrTy}, false));
+  irb_.CreateCall(
+      free_fn.getFunctionType(),
+      free_fn.getCallee(),
+      {irb_.CreatePointerCast(it->second, bytePtrTy)});
+  varToVal_.erase(it);
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
 }
 
 void LLVMCodeGenImpl::visit(const Cond* v) {
@@ -425,6 +425,13 @@ class TORCH_API PytorchLLVMJITImpl {
     return Error::success();
   }
 
+  Error addObject(std::unique_ptr<MemoryBuffer> O) {
+    if (auto Err = LLJ->addObjectFile(std::move(O))) {
+      return Err;
+    }
+    return Error::success();
+  }
+
   JITSymbol findSymbol(const std::string Name) {
     return cantFail(LLJ->lookup(Name));
   }
@@ -443,6 +450,10 @@ Error PytorchLLVMJIT::addModule(ThreadSafeModule M) {
   return impl_->addModule(std::move(M));
 }
 
+Error PytorchLLVMJIT::addObject(std::unique_ptr<MemoryBuffer> O) {
+  return impl_->addObject(std::move(O));
+}
+
 JITSymbol PytorchLLVMJIT::findSymbol(const std::string Name) {
   return impl_->findSymbol(std::move(Name));
 }
@@ -362,6 +362,9 @@ class LoopOptions {
     if (is_gpu_thread_index()) {
       throw std::runtime_error("Cannot set both gpu block and thread index");
     }
+    if (is_parallel()) {
+      throw std::runtime_error("Cannot set both gpu block index and parallel");
+    }
     if (is_gpu_block_index() && gpu_block_index() != index) {
       throw std::runtime_error("Cannot set a previously set block index");
     }
@@ -396,18 +399,35 @@ class LoopOptions {
     if (is_gpu_block_index()) {
       throw std::runtime_error("Cannot set both gpu thread and block index");
     }
+    if (is_parallel()) {
+      throw std::runtime_error("Cannot set both gpu thread index and parallel");
+    }
     if (is_gpu_thread_index() && gpu_thread_index() != index) {
       throw std::runtime_error("Cannot set a previously set thread index");
     }
     gpu_thread_index_ = index;
   }
 
+  // Parallel execution over the CPU intra-op thread pool
+  bool is_parallel() const {
+    return is_parallel_;
+  }
+
+  void set_parallel() {
+    if (is_gpu_block_index() || is_gpu_thread_index()) {
+      throw std::runtime_error("Cannot set both gpu index and parallel");
+    }
+    is_parallel_ = true;
+  }
+
   std::string ToString() const {
     std::ostringstream oss;
     if (is_gpu_block_index()) {
       oss << gpu_block_index_str();
     } else if (is_gpu_thread_index()) {
       oss << gpu_thread_index_str();
+    } else if (is_parallel()) {
+      oss << "parallel";
     }
     return oss.str();
   }
@@ -415,6 +435,7 @@ class LoopOptions {
  private:
   int gpu_block_index_ = -1;
   int gpu_thread_index_ = -1;
+  bool is_parallel_ = false;
 };
 
 class For : public StmtNode<For> {
@@ -508,6 +529,10 @@ class For : public StmtNode<For> {
     loop_options_.set_gpu_thread_index(thread_index);
   }
 
+  void set_parallel() {
+    loop_options_.set_parallel();
+  }
+
  private:
   const Var* var_;
   const Expr* start_;
@@ -367,6 +367,27 @@ def memory_snapshot():
     return torch._C._cuda_memorySnapshot()
 
 
+def allocation_failure_history():
+    r"""Returns a bounded history of CUDA memory allocation failures across
+    all devices, oldest first.
+
+    Each entry is a dictionary describing one failed ``cudaMalloc``: the
+    ``"device"`` and ``"stream"`` the allocation was requested on, the
+    ``"size"`` in bytes that failed, the ``"free_bytes"`` reported by CUDA at
+    the time, and ``"oom"``, which is ``True`` if the failure persisted after
+    the allocator flushed its cache (i.e. the allocation raised an
+    out-of-memory error rather than merely triggering a retry).
+
+    Together with :func:`~torch.cuda.memory_snapshot` this can be used to
+    attribute fragmentation-induced failures to specific allocation patterns.
+
+    .. note::
+        See :ref:`cuda-memory-management` for more details about GPU memory
+        management.
+    """
+    return torch._C._cuda_allocationFailureHistory()
+
+
 def memory_summary(device=None, abbreviated=False):
     r"""Returns a human-readable printout of the current memory allocator
     statistics for a given device.
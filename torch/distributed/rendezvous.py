@@ -6,7 +6,7 @@ except ImportError:
 import torch._six as six
 import numbers
 import os
-from . import FileStore, TCPStore
+from . import FileStore, ShmStore, TCPStore
 from .constants import default_pg_timeout
 
 
@@ -107,6 +107,29 @@ def _file_rendezvous_handler(url, **kwargs):
     raise RuntimeError("Unable to perform rerendezvous using file:// method")
 
 
+def _shm_rendezvous_handler(url, **kwargs):
+    def _error(msg):
+        return _rendezvous_error("shm:// rendezvous: " + msg)
+
+    result = urlparse(url)
+    name = result.netloc or result.path.lstrip("/")
+    if not name:
+        raise _error("segment name missing")
+    query = dict(pair.split("=") for pair in filter(None, result.query.split("&")))
+    if "rank" not in query:
+        raise _error("rank parameter missing")
+    if "world_size" not in query:
+        raise _error("world size parameter missing")
+
+    rank = int(query["rank"])
+    world_size = int(query["world_size"])
+    store = ShmStore(name, world_size)
+    yield (store, rank, world_size)
+
+    # If this configuration is invalidated, there is nothing we can do about it
+    raise RuntimeError("Unable to perform rerendezvous using shm:// method")
+
+
 def _tcp_rendezvous_handler(url, timeout=default_pg_timeout, **kwargs):
     def _error(msg):
         return _rendezvous_error("tcp:// rendezvous: " + msg)
@@ -177,5 +200,6 @@ def _env_rendezvous_handler(url, timeout=default_pg_timeout, **kwargs):
 
 
 register_rendezvous_handler("file", _file_rendezvous_handler)
+register_rendezvous_handler("shm", _shm_rendezvous_handler)
 register_rendezvous_handler("tcp", _tcp_rendezvous_handler)
 register_rendezvous_handler("env", _env_rendezvous_handler)
@@ -4,6 +4,39 @@
 
 namespace c10d {
 
+void CollectiveMetrics::record(const char* opName, int64_t bytes, double ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = entries_[opName];
+  if (entry.count == 0 || ms < entry.min_ms) {
+    entry.min_ms = ms;
+  }
+  if (ms > entry.max_ms) {
+    entry.max_ms = ms;
+  }
+  entry.count++;
+  entry.total_bytes += bytes;
+  entry.total_ms += ms;
+  size_t bucket = 0;
+  double upper_ms = 1.0;
+  while (ms >= upper_ms &&
+         bucket + 1 < CollectiveMetricsEntry::kNumLatencyBuckets) {
+    upper_ms *= 2.0;
+    bucket++;
+  }
+  entry.latency_histogram[bucket]++;
+}
+
+std::unordered_map<std::string, CollectiveMetricsEntry> CollectiveMetrics::
+    snapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_;
+}
+
+void CollectiveMetrics::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
 ProcessGroup::Work::~Work() {}
 
 bool ProcessGroup::Work::isCompleted() {
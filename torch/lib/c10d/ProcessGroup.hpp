@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +15,38 @@
 
 namespace c10d {
 
+// Aggregated timing and bandwidth statistics for one collective type
+// ("allreduce", "broadcast", ...) on one ProcessGroup; see
+// ProcessGroup::getCollectiveMetrics(). All times are wall-clock
+// milliseconds as observed on this rank, so comparing the same collective
+// across ranks exposes the straggler.
+struct CollectiveMetricsEntry {
+  // Histogram of per-op latencies in power-of-two millisecond buckets:
+  // bucket 0 counts ops under 1ms, bucket i ops in [2^(i-1), 2^i) ms and
+  // the last bucket everything slower.
+  static constexpr size_t kNumLatencyBuckets = 16;
+
+  int64_t count = 0;
+  int64_t total_bytes = 0; // input bytes moved, summed over ops
+  double total_ms = 0.0;
+  double min_ms = 0.0;
+  double max_ms = 0.0;
+  std::array<int64_t, kNumLatencyBuckets> latency_histogram{};
+};
+
+// Thread-safe per-collective-type aggregation; implementations record one
+// sample per completed Work object.
+class CollectiveMetrics {
+ public:
+  void record(const char* opName, int64_t bytes, double ms);
+  std::unordered_map<std::string, CollectiveMetricsEntry> snapshot();
+  void reset();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, CollectiveMetricsEntry> entries_;
+};
+
 // ProcessGroup is a base class that captures collective and point to
 // point communication in a fixed set of processes.
 //
@@ -195,9 +229,22 @@ class ProcessGroup {
   virtual std::shared_ptr<ProcessGroup::Work> barrier(
       const BarrierOptions& opts = BarrierOptions()) = 0;
 
+  // Per-collective-type timing and bandwidth statistics recorded by
+  // implementations that instrument their Work objects (gloo, nccl);
+  // empty for backends that do not.
+  std::unordered_map<std::string, CollectiveMetricsEntry>
+  getCollectiveMetrics() {
+    return metrics_.snapshot();
+  }
+
+  void resetCollectiveMetrics() {
+    metrics_.reset();
+  }
+
  protected:
   const int rank_;
   const int size_;
+  CollectiveMetrics metrics_;
 };
 
 } // namespace c10d
@@ -7,6 +7,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstdlib>
 #include <type_traits>
 
 #include <gloo/allgather.h>
@@ -93,6 +94,15 @@ class GlooStore : public ::gloo::rendezvous::Store {
   std::shared_ptr<::c10d::Store> store_;
 };
 
+// Sums tensor sizes for the bytes-moved column of the collective metrics.
+int64_t nbytesSum(const std::vector<at::Tensor>& tensors) {
+  int64_t sum = 0;
+  for (const auto& tensor : tensors) {
+    sum += static_cast<int64_t>(tensor.nbytes());
+  }
+  return sum;
+}
+
 typedef void (*ReduceFunc)(void*, const void*, const void*, size_t);
 
 template <
@@ -424,6 +434,13 @@ bool doesHostnameResolveToUsableAddress(const std::string& hostname) {
   return rp != nullptr;
 }
 
+bool hierarchicalAllreduceEnabled() {
+  // Opt-in, and must be set consistently across all processes in the
+  // group. See Note [Hierarchical allreduce].
+  const auto* flag = std::getenv("TORCH_GLOO_HIERARCHICAL_ALLREDUCE");
+  return flag != nullptr && std::string(flag) != "0";
+}
+
 } // namespace
 
 #if defined(__linux__) || defined(__APPLE__)
@@ -506,7 +523,8 @@ ProcessGroupGloo::ProcessGroupGloo(
     : ProcessGroup(rank, size),
       store_(new GlooStore(store)),
       stop_(false),
-      collectiveCounter_(0) {
+      collectiveCounter_(0),
+      hierarchical_(false) {
   auto& devices = options.devices;
   if (devices.empty()) {
     throw std::runtime_error("No device(s) specified");
@@ -533,6 +551,10 @@ ProcessGroupGloo::ProcessGroupGloo(
     contexts_.push_back(std::move(context));
   }
 
+  // Optionally set up intra-host and inter-host sub-groups for two-level
+  // allreduce, see Note [Hierarchical allreduce].
+  initHierarchy(options.devices[0], options.timeout);
+
   // Every worker thread stores the AsyncWork object it's currently
   // working on in the workInProgress_ vector. It must have size equal
   // to the number of workers such that they can simply index into it
@@ -545,6 +567,80 @@ ProcessGroupGloo::ProcessGroupGloo(
   }
 }
 
+void ProcessGroupGloo::initHierarchy(
+    const std::shared_ptr<::gloo::transport::Device>& device,
+    std::chrono::milliseconds timeout) {
+  if (!hierarchicalAllreduceEnabled()) {
+    return;
+  }
+
+  // Tell everybody which host this rank lives on. This runs in the
+  // constructor, which is collective, so every rank participates.
+  std::array<char, 256> hostname{};
+  auto rv = gethostname(hostname.data(), hostname.size() - 1);
+  if (rv != 0) {
+    throw std::system_error(errno, std::system_category());
+  }
+  const std::string keyPrefix("hierarchical/host/");
+  const std::string selfHost(hostname.data());
+  store_->set(
+      keyPrefix + std::to_string(rank_),
+      std::vector<char>(selfHost.begin(), selfHost.end()));
+
+  // Group ranks by host, in order of first appearance by rank. Every
+  // rank computes the same grouping from the same keys.
+  std::unordered_map<std::string, size_t> hostIndices;
+  std::vector<std::vector<int>> hostRanks;
+  size_t hostIndex = 0;
+  int localRank = -1;
+  for (int r = 0; r < size_; r++) {
+    auto value = store_->get(keyPrefix + std::to_string(r));
+    std::string host(value.begin(), value.end());
+    auto it = hostIndices.find(host);
+    if (it == hostIndices.end()) {
+      it = hostIndices.emplace(host, hostRanks.size()).first;
+      hostRanks.emplace_back();
+    }
+    if (r == rank_) {
+      hostIndex = it->second;
+      localRank = hostRanks[it->second].size();
+    }
+    hostRanks[it->second].push_back(r);
+  }
+
+  // A single host, or a single rank per host, degenerates to the flat
+  // algorithm; don't bother setting up sub-contexts.
+  const auto numHosts = hostRanks.size();
+  if (numHosts < 2 || numHosts == static_cast<size_t>(size_)) {
+    return;
+  }
+
+  // Connect the ranks that share this host.
+  const auto localSize = hostRanks[hostIndex].size();
+  if (localSize > 1) {
+    auto context =
+        std::make_shared<::gloo::rendezvous::Context>(localRank, localSize);
+    auto store = ::gloo::rendezvous::PrefixStore(
+        "hierarchical/intra/" + std::to_string(hostIndex), *store_);
+    context->setTimeout(timeout);
+    context->connectFullMesh(store, device);
+    intraContext_ = std::move(context);
+  }
+
+  // The first rank on every host joins the inter-host context.
+  if (localRank == 0) {
+    auto context =
+        std::make_shared<::gloo::rendezvous::Context>(hostIndex, numHosts);
+    auto store =
+        ::gloo::rendezvous::PrefixStore("hierarchical/inter", *store_);
+    context->setTimeout(timeout);
+    context->connectFullMesh(store, device);
+    interContext_ = std::move(context);
+  }
+
+  hierarchical_ = true;
+}
+
 ProcessGroupGloo::~ProcessGroupGloo() {
   std::unique_lock<std::mutex> lock(workMutex_);
   workConsumeCV_.wait(lock, [&] { return workQueue_.empty(); });
@@ -595,7 +691,11 @@ void ProcessGroupGloo::runLoop(int workerIndex) {
   }
 }
 
-void ProcessGroupGloo::enqueue(std::shared_ptr<AsyncWork> work) {
+void ProcessGroupGloo::enqueue(
+    std::shared_ptr<AsyncWork> work,
+    const char* opName,
+    int64_t bytes) {
+  work->initMetrics(&metrics_, opName, bytes);
   std::unique_lock<std::mutex> lock(workMutex_);
   workQueue_.push_back(std::move(work));
   lock.unlock();
@@ -748,7 +848,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::broadcast(
     throw std::runtime_error("Invalid backend");
   }
 
-  enqueue(work);
+  enqueue(work, "broadcast", nbytesSum(inputs));
   return work;
 }
 
@@ -835,6 +935,82 @@ class AsyncAllreduceCoalescedWork : public AsyncAllreduceWork {
   }
 };
 
+// Note [Hierarchical allreduce]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// On multi-host jobs with several ranks per host, the flat allreduce
+// sends every rank's data across the host boundary. With
+// TORCH_GLOO_HIERARCHICAL_ALLREDUCE set, dense CPU allreduces instead run
+// in three steps: reduce to the first rank on each host, allreduce across
+// hosts between those local roots only, and broadcast the result back to
+// the other local ranks. The intra-host steps stay on the host's own
+// network path, so the cross-host fabric carries only one rank's worth of
+// traffic per host.
+//
+// The sub-contexts for the intra-host and inter-host groups are created
+// at construction time, keyed by hostname (see initHierarchy). Groups
+// that span a single host, or that place a single rank on every host,
+// keep the flat algorithm since the hierarchy would be a no-op. All
+// supported reduce ops are associative, so applying them in two levels
+// yields the same result as the flat reduction (up to floating point
+// reordering, which the flat algorithm does not guarantee either).
+class AsyncHierarchicalAllreduceWork : public AsyncAllreduceWork {
+ public:
+  AsyncHierarchicalAllreduceWork(
+      std::shared_ptr<gloo::Context> intraContext,
+      std::shared_ptr<gloo::Context> interContext,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp reduceOp,
+      uint32_t tag)
+      : AsyncAllreduceWork(std::move(interContext), inputs, reduceOp, tag),
+        intraContext(std::move(intraContext)) {}
+
+  // The inter-host context doubles as the base class context and is
+  // null on ranks that are not their host's local root.
+  std::shared_ptr<gloo::Context> intraContext;
+
+  void run() override {
+    const auto& scalarType = inputs[0].scalar_type();
+
+    // Step 1: reduce to the local root (the first rank on this host).
+    if (intraContext) {
+      gloo::ReduceOptions opts(intraContext);
+      opts.setRoot(0);
+      opts.setTag(tag);
+      opts.setReduceFunction(getReduceFunction(scalarType, reduceOp));
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, inputs[0]);
+      gloo::reduce(opts);
+    }
+
+    // Step 2: allreduce across hosts between the local roots.
+    if (context) {
+      allreduce(inputs);
+    }
+
+    // Step 3: broadcast the result from the local root.
+    if (intraContext) {
+      gloo::BroadcastOptions opts(intraContext);
+      opts.setRoot(0);
+      opts.setTag(tag);
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, inputs[0]);
+      gloo::broadcast(opts);
+    }
+  }
+
+ protected:
+  template <typename T>
+  void getReduceFunction(gloo::ReduceOptions::Func& fn, const ReduceOp op) {
+    fn = toFunction<T>(op);
+  }
+
+  gloo::ReduceOptions::Func getReduceFunction(
+      const at::ScalarType& dtype,
+      const ReduceOp op) {
+    gloo::ReduceOptions::Func fn;
+    GENERATE_ALL_TYPES(dtype, getReduceFunction, fn, op);
+    return fn;
+  }
+};
+
 class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
  public:
   AsyncSparseAllreduceWork(
@@ -1268,8 +1444,16 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   auto context = getContext(tag);
   if (device.type() == at::kCPU) {
     if (layout == c10::kStrided) {
-      work = std::make_shared<AsyncAllreduceWork>(
-          std::move(context), inputs, opts.reduceOp, tag);
+      // The hierarchical variant handles a single input tensor per rank;
+      // multi-input calls contribute every local tensor to the reduction
+      // and keep the flat algorithm. See Note [Hierarchical allreduce].
+      if (hierarchical_ && inputs.size() == 1) {
+        work = std::make_shared<AsyncHierarchicalAllreduceWork>(
+            intraContext_, interContext_, inputs, opts.reduceOp, tag);
+      } else {
+        work = std::make_shared<AsyncAllreduceWork>(
+            std::move(context), inputs, opts.reduceOp, tag);
+      }
     } else if (layout == c10::kSparse) {
       work = std::make_shared<AsyncSparseAllreduceWork>(
           std::move(context), inputs, tag);
@@ -1292,7 +1476,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
     throw std::runtime_error("Invalid backend");
   }
 
-  enqueue(work);
+  enqueue(work, "allreduce", nbytesSum(inputs));
   return work;
 }
 
@@ -1352,7 +1536,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce_coalesced(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "allreduce_coalesced", nbytesSum(tensors));
   return work;
 }
 
@@ -1518,7 +1702,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::reduce(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "reduce", nbytesSum(inputs));
   return work;
 }
 
@@ -1715,7 +1899,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allgather(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "allgather", nbytesSum(inputs));
   return work;
 }
 
@@ -1835,7 +2019,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allgather_coalesced(
   auto context = getContext(tag);
   auto work = std::make_shared<AsyncAllgatherCoalescedWork>(
       std::move(context), output_lists, input_list, tag);
-  enqueue(work);
+  enqueue(work, "allgather_coalesced", nbytesSum(input_list));
   return work;
 }
 
@@ -2047,7 +2231,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::gather(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gather", nbytesSum(inputs));
   return work;
 }
 
@@ -2233,7 +2417,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::scatter(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "scatter", nbytesSum(outputs));
   return work;
 }
 
@@ -2380,7 +2564,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::barrier(
   auto context = getContext(tag);
   auto work = std::make_shared<AsyncBarrierWork>(
       std::move(context), std::move(priorWork), tag);
-  enqueue(work);
+  enqueue(work, "barrier", 0);
   return work;
 }
 
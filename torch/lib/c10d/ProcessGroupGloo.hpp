@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -69,19 +70,38 @@ class ProcessGroupGloo : public ProcessGroup {
   class AsyncWork : public ProcessGroup::Work {
    public:
     static void execute(std::shared_ptr<AsyncWork> work) {
+      const auto start = std::chrono::steady_clock::now();
       std::exception_ptr eptr;
       try {
         work->run();
       } catch (...) {
         eptr = std::current_exception();
       }
+      if (!eptr && work->metrics_ != nullptr) {
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        work->metrics_->record(work->opName_, work->bytes_, elapsed.count());
+      }
       work->finish(eptr);
     }
 
     virtual void run() = 0;
 
+    // Set when the work is enqueued, so execute() can attribute its wall
+    // time and bytes moved to the collective type.
+    void initMetrics(CollectiveMetrics* metrics, const char* opName, int64_t bytes) {
+      metrics_ = metrics;
+      opName_ = opName;
+      bytes_ = bytes;
+    }
+
    protected:
     friend class ProcessGroupGloo;
+
+   private:
+    CollectiveMetrics* metrics_ = nullptr;
+    const char* opName_ = "";
+    int64_t bytes_ = 0;
   };
 
   // For send and recv operations there is no need to pass them to the
@@ -245,11 +265,27 @@ class ProcessGroupGloo : public ProcessGroup {
   // to contexts being used in a round-robin fashion.
   std::shared_ptr<::gloo::Context> getContext(uint32_t tag);
 
+  // Sets up the intra-host and inter-host sub-contexts for two-level
+  // dense allreduce, if enabled and the group spans multiple hosts.
+  // See Note [Hierarchical allreduce] in ProcessGroupGloo.cpp.
+  void initHierarchy(
+      const std::shared_ptr<::gloo::transport::Device>& device,
+      std::chrono::milliseconds timeout);
+
+  // Hierarchical allreduce state. `intraContext_` connects the ranks
+  // sharing this rank's host and `interContext_` connects the first rank
+  // on every host (it is null on the other ranks).
+  bool hierarchical_;
+  std::shared_ptr<::gloo::Context> intraContext_;
+  std::shared_ptr<::gloo::Context> interContext_;
+
   // Entrypoint for worker threads.
   void runLoop(int workerIndex);
 
   // Queue work to run on worker thread.
-  void enqueue(std::shared_ptr<AsyncWork> work);
+  // Tags the work with the metrics aggregator before queueing it for the
+  // worker threads; opName/bytes feed getCollectiveMetrics().
+  void enqueue(std::shared_ptr<AsyncWork> work, const char* opName, int64_t bytes);
 
   // Keep both a queue of pending work, and a vector with in progress work.
   // Both of these can only be mutated when holding the queue lock.
@@ -1,5 +1,7 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <tuple>
 #include <unordered_set>
@@ -11,6 +13,13 @@
 
 #include <c10d/Utils.hpp>
 
+// Point-to-point send/recv, which backs alltoall/gather/scatter below, was
+// added in NCCL 2.7.
+#if defined(NCCL_MAJOR) && \
+    ((NCCL_MAJOR > 2) || (NCCL_MAJOR == 2 && NCCL_MINOR >= 7))
+#define ENABLE_NCCL_P2P_SUPPORT
+#endif
+
 namespace c10d {
 
 constexpr const char* const kNCCLAbortedCommStoreKey = "NCCLABORTEDCOMM";
@@ -142,11 +151,24 @@ ProcessGroupNCCL::WorkNCCL::WorkNCCL(const std::vector<at::Device>& devices)
   ncclComms_.resize(devices.size());
 }
 
-ProcessGroupNCCL::WorkNCCL::~WorkNCCL() {}
+ProcessGroupNCCL::WorkNCCL::~WorkNCCL() {
+  // Last chance to attribute this work's wall time if the caller never
+  // polled for completion. Swallow CUDA errors; this is a destructor.
+  try {
+    if (finishedGPUExecutionInternal()) {
+      maybeRecordMetrics();
+    }
+  } catch (...) {
+  }
+}
 
 bool ProcessGroupNCCL::WorkNCCL::isCompleted() {
   checkAndSetException();
-  return exception() || finishedGPUExecutionInternal();
+  const bool finished = finishedGPUExecutionInternal();
+  if (finished && !exception()) {
+    maybeRecordMetrics();
+  }
+  return exception() || finished;
 }
 
 bool ProcessGroupNCCL::WorkNCCL::isSuccess() const {
@@ -172,7 +194,24 @@ void ProcessGroupNCCL::WorkNCCL::checkAndSetException() {
 // Helper that checks if the NCCL kernels are completed on the GPUs
 bool ProcessGroupNCCL::WorkNCCL::finishedGPUExecution() {
   checkAndSetException();
-  return finishedGPUExecutionInternal();
+  const bool finished = finishedGPUExecutionInternal();
+  if (finished && !exception()) {
+    maybeRecordMetrics();
+  }
+  return finished;
+}
+
+void ProcessGroupNCCL::WorkNCCL::maybeRecordMetrics() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (metrics_ == nullptr || metricsRecorded_) {
+      return;
+    }
+    metricsRecorded_ = true;
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - workStartTime_;
+  metrics_->record(opName_, bytes_, elapsed.count());
 }
 
 bool ProcessGroupNCCL::WorkNCCL::finishedGPUExecutionInternal() const {
@@ -261,12 +300,19 @@ ProcessGroupNCCL::ProcessGroupNCCL(
     const std::shared_ptr<Store>& store,
     int rank,
     int size,
-    const std::chrono::milliseconds& opTimeout)
+    const std::chrono::milliseconds& opTimeout,
+    bool isHighPriorityStream)
     : ProcessGroup(rank, size),
       store_(store),
       ncclCommCounter_(0),
       terminateWatchdog_(false),
-      opTimeout_(opTimeout) {
+      opTimeout_(opTimeout),
+      isHighPriorityStream_(isHighPriorityStream) {
+  char* highPriorityStreams = getenv(NCCL_HIGH_PRIORITY_STREAMS);
+  if (highPriorityStreams != nullptr &&
+      strcmp(highPriorityStreams, "0") != 0) {
+    isHighPriorityStream_ = true;
+  }
   char* blockingWait = getenv(NCCL_BLOCKING_WAIT);
   try {
     if (blockingWait != nullptr) {
@@ -285,6 +331,16 @@ ProcessGroupNCCL::ProcessGroupNCCL(
         "Invalid value for environment variable: " +
         std::string(NCCL_BLOCKING_WAIT));
   }
+  char* pipelineThreshold = getenv(NCCL_PIPELINE_THRESHOLD);
+  if (pipelineThreshold != nullptr) {
+    try {
+      pipelineThresholdBytes_ = std::stoull(pipelineThreshold);
+    } catch (std::exception& e) {
+      throw std::runtime_error(
+          "Invalid value for environment variable: " +
+          std::string(NCCL_PIPELINE_THRESHOLD));
+    }
+  }
 
 #ifdef ENABLE_NCCL_ERROR_CHECKING
   ncclCommWatchdogThread_ =
@@ -507,8 +563,10 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     gpuGuard.set_index(devices[i].index());
     ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
 
-    // Creates the NCCL streams
-    streamVal.push_back(at::cuda::getStreamFromPool());
+    // Creates the NCCL streams. When requested, the streams come from the
+    // high priority pool so communication overlaps compute instead of
+    // queueing behind it.
+    streamVal.push_back(at::cuda::getStreamFromPool(isHighPriorityStream_));
   }
 
   C10D_NCCL_CHECK(ncclGroupEnd());
@@ -574,6 +632,73 @@ void check_gpu_tensors(const std::vector<at::Tensor>& tensors) {
   }
 }
 
+// Check that all `tensors' are dense CUDA tensors sharing a single GPU, as
+// required for a coalesced (grouped) collective.
+void check_gpu_tensors_same_device(const std::vector<at::Tensor>& tensors) {
+  if (tensors.size() == 0) {
+    throw std::runtime_error("Tensor list must be nonempty");
+  }
+
+  const auto& first = tensors.front();
+  for (const auto& t : tensors) {
+    if (!t.is_cuda() || t.is_sparse()) {
+      throw std::runtime_error("Tensors must be CUDA and dense");
+    }
+    if (!t.is_contiguous()) {
+      throw std::runtime_error("Tensors must be contiguous");
+    }
+    if (t.get_device() != first.get_device()) {
+      throw std::runtime_error("Tensors must be on the same GPU device");
+    }
+  }
+}
+
+// Check that `split_sizes' is a valid dim-0 split of `tensor' across
+// `group_size' ranks. An empty list means the first dimension must divide
+// evenly.
+void checkSplitSizes(
+    const std::vector<int64_t>& split_sizes,
+    const at::Tensor& tensor,
+    int group_size) {
+  if (split_sizes.size() == 0) {
+    TORCH_CHECK(
+        tensor.size(0) % group_size == 0,
+        "Tensor's dim 0 does not divide equally across group size");
+  } else {
+    TORCH_CHECK(
+        split_sizes.size() == static_cast<size_t>(group_size),
+        "Number of tensor splits not equal to group size");
+    int64_t sum = 0;
+    for (const auto split_size : split_sizes) {
+      sum += split_size;
+    }
+    TORCH_CHECK(
+        sum == tensor.size(0), "Split sizes doesn't match total dim 0 size");
+  }
+}
+
+// Compute per-rank element counts and offsets into `tensor' for an alltoall
+// with the given dim-0 split sizes (empty means equal splits).
+void computeLengthsAndOffsets(
+    const std::vector<int64_t>& split_sizes,
+    const at::Tensor& tensor,
+    int group_size,
+    std::vector<size_t>* lengths,
+    std::vector<size_t>* offsets) {
+  const int64_t dim0_size = tensor.size(0);
+  const int64_t row_size = (dim0_size ? tensor.numel() / dim0_size : 1);
+  const bool equal_splits = split_sizes.size() == 0;
+  const int64_t split_size = equal_splits ? dim0_size / group_size : 0;
+  size_t offset = 0;
+  for (int i = 0; i < group_size; i++) {
+    const size_t length =
+        row_size * (equal_splits ? split_size : split_sizes[i]);
+    (*lengths)[i] = length;
+    (*offsets)[i] = offset;
+    offset += length;
+  }
+}
+
 // Flatten each list in `tensor_lists' for a gather or scatter operation, and
 // ensure compatibility with the corresponding tensor in `other'.
 std::vector<at::Tensor> flatten_for_scatter_gather(
@@ -616,6 +741,21 @@ std::vector<at::Tensor> flatten_for_scatter_gather(
   return flattened;
 }
 
+// Chunk size used by the pipelined allreduce path. Chunks alternate between
+// two communicator/stream pairs, so with 32MB chunks a chunk's ring reduction
+// overlaps the launch and protocol phases of its successor while staying
+// large enough to saturate the link.
+constexpr size_t kPipelineChunkBytes = 32 * 1024 * 1024;
+
+// Sums tensor sizes for the bytes-moved column of the collective metrics.
+int64_t nbytesSum(const std::vector<at::Tensor>& tensors) {
+  int64_t sum = 0;
+  for (const auto& tensor : tensors) {
+    sum += static_cast<int64_t>(tensor.nbytes());
+  }
+  return sum;
+}
+
 } // namespace
 
 std::shared_ptr<ProcessGroupNCCL::WorkNCCL> ProcessGroupNCCL::initWork(
@@ -629,7 +769,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& outputs,
     Fn fn,
     PreProcess pre,
-    PostProcess post) {
+    PostProcess post,
+    const char* opName) {
   const auto devices = getDeviceList(inputs);
   const auto key = getKeyFromDevices(devices);
   auto& ncclComms = getNCCLComm(key, devices);
@@ -682,6 +823,10 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     work->store_ = store_;
   }
 
+  work->metrics_ = &metrics_;
+  work->opName_ = opName;
+  work->bytes_ = nbytesSum(inputs);
+
   return work;
 }
 
@@ -689,13 +834,15 @@ template <typename Fn>
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& inputs,
     std::vector<at::Tensor>& outputs,
-    Fn fn) {
+    Fn fn,
+    const char* opName) {
   return collective(
       inputs,
       outputs,
       fn,
       [](std::vector<at::cuda::CUDAStream>&) {},
-      [](std::vector<at::cuda::CUDAStream>&) {});
+      [](std::vector<at::cuda::CUDAStream>&) {},
+      opName);
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
@@ -703,6 +850,14 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
     const AllreduceOptions& opts) {
   check_gpu_tensors(tensors);
 
+  // A single monolithic NCCL call cannot overlap its own reduction phases;
+  // large buckets go down the chunked path, which pipelines fixed-size
+  // chunks across two internal communicator/stream pairs.
+  if (pipelineThresholdBytes_ > 0 &&
+      static_cast<size_t>(tensors[0].nbytes()) >= pipelineThresholdBytes_) {
+    return allreduceChunked(tensors, opts);
+  }
+
   return collective(
       tensors,
       tensors,
@@ -718,14 +873,162 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
             ncclOp[opts.reduceOp],
             comm,
             stream.stream());
-      });
+      },
+      "allreduce");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceChunked(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  const auto devices = getDeviceList(tensors);
+  const auto key = getKeyFromDevices(devices);
+
+  // NCCL serializes all calls issued on one communicator, so pipelining
+  // needs a second communicator per device, not just a second stream. The
+  // second set is cached under a reserved key; device keys are plain digit
+  // lists, so the prefix cannot collide. Every rank takes this path for the
+  // same tensors and creates the communicators in the same order.
+  const auto pipelineKey = "pipeline:" + key;
+  auto& ncclComms = getNCCLComm(key, devices);
+  auto& pipelineComms = getNCCLComm(pipelineKey, devices);
+
+  // Both stream sets must wait for pending work on the input tensors'
+  // allocation streams before any chunk is issued. See [Sync Streams].
+  syncStreams(devices, ncclEvents_[key], ncclStreams_[key]);
+  syncStreams(devices, ncclEvents_[pipelineKey], ncclStreams_[pipelineKey]);
+
+  // Work itself will create the CUDA events on all GPUs of tensors
+  auto work = initWork(devices);
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    gpuGuard.set_index(devices[i].index());
+    // The tensors are used on both internal streams; record both so the
+    // caching allocator does not reuse the memory before the last chunk
+    // finishes. See [Sync Streams].
+    c10::cuda::CUDACachingAllocator::recordStream(
+        tensors[i].storage().data_ptr(), ncclStreams_[key][i]);
+    c10::cuda::CUDACachingAllocator::recordStream(
+        tensors[i].storage().data_ptr(), ncclStreams_[pipelineKey][i]);
+  }
+
+  // check_gpu_tensors() guarantees the tensors are contiguous and have
+  // identical type and shape across devices, so chunk geometry is computed
+  // once. The chunk walk order and the chunk -> communicator mapping are
+  // deterministic, keeping the per-communicator issue order identical on
+  // every rank as NCCL requires.
+  const size_t elementSize = tensors[0].element_size();
+  const size_t numel = tensors[0].numel();
+  const size_t chunkNumel = std::max(kPipelineChunkBytes / elementSize, size_t(1));
+  const size_t numChunks = (numel + chunkNumel - 1) / chunkNumel;
+
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    const size_t offset = chunk * chunkNumel;
+    const size_t count = std::min(chunkNumel, numel - offset);
+    auto& comms = (chunk % 2 == 0) ? ncclComms : pipelineComms;
+    auto& streams =
+        (chunk % 2 == 0) ? ncclStreams_[key] : ncclStreams_[pipelineKey];
+
+    AutoNcclGroup nccl_group_guard;
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      gpuGuard.set_index(devices[i].index());
+      char* data =
+          static_cast<char*>(tensors[i].data_ptr()) + offset * elementSize;
+      C10D_NCCL_CHECK(ncclAllReduce(
+          data,
+          data,
+          count,
+          getNcclDataType(tensors[i].scalar_type()),
+          ncclOp[opts.reduceOp],
+          comms[i]->getNcclComm(),
+          streams[i].stream()));
+    }
+  }
+
+  // Join the secondary stream back into the primary one, so the completion
+  // events below (and the [Sync Streams] events that the next collective on
+  // this key records) cover the chunks issued on both streams.
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    at::cuda::CUDAEvent pipelineDone;
+    pipelineDone.record(ncclStreams_[pipelineKey][i]);
+    pipelineDone.block(ncclStreams_[key][i]);
+  }
+
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    at::cuda::CUDAStream& ncclStream = ncclStreams_[key][i];
+    work->cudaEvents_[i].record(ncclStream);
+    work->ncclComms_[i] = ncclComms[i];
+    work->blockingWait_ = blockingWait_;
+    work->opTimeout_ = opTimeout_;
+    work->store_ = store_;
+  }
+
+  work->metrics_ = &metrics_;
+  work->opName_ = "allreduce";
+  work->bytes_ = nbytesSum(tensors);
+
+  return work;
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
     std::vector<at::Tensor>& tensors,
     const AllreduceCoalescedOptions& opts) {
-  throw std::runtime_error(
-      "allreduce_coalesced is currently not supported with NCCL");
+  check_gpu_tensors_same_device(tensors);
+
+  // All tensors share a single device, so a single communicator and NCCL
+  // stream is used, unlike `collective' which maps one tensor to each
+  // device. Every per-tensor allreduce is issued inside one NCCL group,
+  // which batches them into a single grouped launch instead of paying
+  // launch and synchronization overhead per tensor.
+  const std::vector<at::Device> devices = {tensors[0].device()};
+  const auto key = getKeyFromDevices(devices);
+  auto& ncclComms = getNCCLComm(key, devices);
+
+  // First let NCCL streams wait for input tensors allocation streams
+  syncStreams(devices, ncclEvents_[key], ncclStreams_[key]);
+
+  // Work itself will create the CUDA events on all GPUs of tensors
+  auto work = initWork(devices);
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+  gpuGuard.set_index(devices[0].index());
+  at::cuda::CUDAStream& ncclStream = ncclStreams_[key][0];
+
+  // The tensors are created on a worker stream and used on the NCCL
+  // stream. They must record the NCCL stream to prevent being freed
+  // before the collective finishes. See [Sync Streams].
+  for (auto& tensor : tensors) {
+    c10::cuda::CUDACachingAllocator::recordStream(
+        tensor.storage().data_ptr(), ncclStream);
+  }
+
+  {
+    AutoNcclGroup nccl_group_guard;
+    for (auto& tensor : tensors) {
+      C10D_NCCL_CHECK(ncclAllReduce(
+          tensor.data_ptr(),
+          tensor.data_ptr(),
+          tensor.numel(),
+          getNcclDataType(tensor.scalar_type()),
+          ncclOp[opts.reduceOp],
+          ncclComms[0]->getNcclComm(),
+          ncclStream.stream()));
+    }
+  }
+
+  // Event should only be recorded after the ncclGroupEnd()
+  work->cudaEvents_[0].record(ncclStream);
+  work->ncclComms_[0] = ncclComms[0];
+  work->blockingWait_ = blockingWait_;
+  work->opTimeout_ = opTimeout_;
+  work->store_ = store_;
+
+  work->metrics_ = &metrics_;
+  work->opName_ = "allreduce_coalesced";
+  work->bytes_ = nbytesSum(tensors);
+
+  return work;
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
@@ -748,7 +1051,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
             root,
             comm,
             stream.stream());
-      });
+      },
+      "broadcast");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce(
@@ -773,7 +1077,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce(
             root,
             comm,
             stream.stream());
-      });
+      },
+      "reduce");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
@@ -816,7 +1121,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
             outputTensors[i][j].copy_(outputFlattened[i][j], true);
           }
         }
-      });
+      },
+      "allgather");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather_coalesced(
@@ -868,7 +1174,155 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce_scatter(
           }
         }
       },
-      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {});
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      "reduce_scatter");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::alltoall_base(
+    at::Tensor& outputTensor,
+    at::Tensor& inputTensor,
+    std::vector<int64_t>& outputSplitSizes,
+    std::vector<int64_t>& inputSplitSizes,
+    const AllToAllOptions& /* unused */) {
+#ifdef ENABLE_NCCL_P2P_SUPPORT
+  std::vector<at::Tensor> inputTensors = {inputTensor};
+  std::vector<at::Tensor> outputTensors = {outputTensor};
+  check_gpu_tensors(inputTensors);
+  check_gpu_tensors(outputTensors);
+  TORCH_CHECK(
+      outputTensor.get_device() == inputTensor.get_device() &&
+          outputTensor.scalar_type() == inputTensor.scalar_type(),
+      "Input and output tensors must have the same type and reside on the "
+      "same GPU device");
+
+  if (outputSplitSizes.size() == 0 && inputSplitSizes.size() == 0) {
+    TORCH_CHECK(
+        outputTensor.numel() == inputTensor.numel(),
+        "Tensors are not equal in size");
+    TORCH_CHECK(
+        outputTensor.size(0) % size_ == 0,
+        "Tensor's dim 0 does not divide equally across group size");
+  } else {
+    checkSplitSizes(inputSplitSizes, inputTensor, size_);
+    checkSplitSizes(outputSplitSizes, outputTensor, size_);
+  }
+
+  return collective(
+      inputTensors,
+      outputTensors,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        // See [Sync Streams].
+        c10::cuda::CUDACachingAllocator::recordStream(
+            output.storage().data_ptr(), stream);
+
+        std::vector<size_t> sendLengths(size_);
+        std::vector<size_t> sendOffsets(size_);
+        std::vector<size_t> recvLengths(size_);
+        std::vector<size_t> recvOffsets(size_);
+        computeLengthsAndOffsets(
+            inputSplitSizes, input, size_, &sendLengths, &sendOffsets);
+        computeLengthsAndOffsets(
+            outputSplitSizes, output, size_, &recvLengths, &recvOffsets);
+
+        const auto type = getNcclDataType(input.scalar_type());
+        const size_t elementSize = input.element_size();
+        char* sendBuff = static_cast<char*>(input.data_ptr());
+        char* recvBuff = static_cast<char*>(output.data_ptr());
+
+        // All sends and recvs are issued inside the surrounding NCCL group,
+        // so they fuse into a single grouped launch.
+        for (int r = 0; r < size_; r++) {
+          if (sendLengths[r] != 0) {
+            C10D_NCCL_CHECK(ncclSend(
+                sendBuff + sendOffsets[r] * elementSize,
+                sendLengths[r],
+                type,
+                r,
+                comm,
+                stream.stream()));
+          }
+          if (recvLengths[r] != 0) {
+            C10D_NCCL_CHECK(ncclRecv(
+                recvBuff + recvOffsets[r] * elementSize,
+                recvLengths[r],
+                type,
+                r,
+                comm,
+                stream.stream()));
+          }
+        }
+        return ncclSuccess;
+      },
+      "alltoall_base");
+#else
+  throw std::runtime_error(
+      "ProcessGroupNCCL alltoall_base requires NCCL 2.7 or later");
+#endif
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::alltoall(
+    std::vector<at::Tensor>& outputTensors,
+    std::vector<at::Tensor>& inputTensors,
+    const AllToAllOptions& /* unused */) {
+#ifdef ENABLE_NCCL_P2P_SUPPORT
+  TORCH_CHECK(
+      inputTensors.size() == static_cast<size_t>(size_),
+      "Number of input tensors is not equal to group size");
+  TORCH_CHECK(
+      outputTensors.size() == static_cast<size_t>(size_),
+      "Number of output tensors is not equal to group size");
+  check_gpu_tensors_same_device(inputTensors);
+  check_gpu_tensors_same_device(outputTensors);
+  TORCH_CHECK(
+      inputTensors[0].get_device() == outputTensors[0].get_device(),
+      "Input and output tensors must reside on the same GPU device");
+
+  // All per-rank tensors live on a single device, so one communicator and
+  // NCCL stream is used; the single-element vectors only carry the device
+  // mapping into `collective'.
+  std::vector<at::Tensor> inputTensor0 = {inputTensors[0]};
+  std::vector<at::Tensor> outputTensor0 = {outputTensors[0]};
+
+  return collective(
+      inputTensor0,
+      outputTensor0,
+      [&](at::Tensor& /* unused */,
+          at::Tensor& /* unused */,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        for (int r = 0; r < size_; r++) {
+          at::Tensor& input = inputTensors[r];
+          at::Tensor& output = outputTensors[r];
+          // See [Sync Streams].
+          c10::cuda::CUDACachingAllocator::recordStream(
+              input.storage().data_ptr(), stream);
+          c10::cuda::CUDACachingAllocator::recordStream(
+              output.storage().data_ptr(), stream);
+          C10D_NCCL_CHECK(ncclSend(
+              input.data_ptr(),
+              input.numel(),
+              getNcclDataType(input.scalar_type()),
+              r,
+              comm,
+              stream.stream()));
+          C10D_NCCL_CHECK(ncclRecv(
+              output.data_ptr(),
+              output.numel(),
+              getNcclDataType(output.scalar_type()),
+              r,
+              comm,
+              stream.stream()));
+        }
+        return ncclSuccess;
+      },
+      "alltoall");
+#else
+  throw std::runtime_error(
+      "ProcessGroupNCCL alltoall requires NCCL 2.7 or later");
+#endif
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::barrier(
@@ -907,22 +1361,156 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::barrier(
   auto ncclWork = dynamic_cast<ProcessGroupNCCL::WorkNCCL*>(work.get());
   TORCH_CHECK(ncclWork);
   ncclWork->barrierTensors_ = std::move(barrierTensors);
+  // Attribute the dummy allreduce to the barrier in the metrics.
+  ncclWork->opName_ = "barrier";
+  ncclWork->bytes_ = 0;
 
   return work;
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::gather(
-    std::vector<std::vector<at::Tensor>>& /* unused */,
-    std::vector<at::Tensor>& /* unused */,
-    const GatherOptions& /* unused */) {
-  throw std::runtime_error("ProcessGroupNCCL does not support gather");
+    std::vector<std::vector<at::Tensor>>& outputTensors,
+    std::vector<at::Tensor>& inputTensors,
+    const GatherOptions& opts) {
+#ifdef ENABLE_NCCL_P2P_SUPPORT
+  check_gpu_tensors(inputTensors);
+  TORCH_CHECK(
+      inputTensors.size() == 1,
+      "ProcessGroupNCCL::gather supports a single tensor per rank");
+
+  const auto root = opts.rootRank;
+  if (rank_ == root) {
+    TORCH_CHECK(
+        outputTensors.size() == 1 &&
+            outputTensors[0].size() == static_cast<size_t>(size_),
+        "The root rank must provide one output tensor per rank");
+    for (const auto& output : outputTensors[0]) {
+      TORCH_CHECK(
+          output.is_cuda() && !output.is_sparse() && output.is_contiguous() &&
+              output.get_device() == inputTensors[0].get_device() &&
+              output.scalar_type() == inputTensors[0].scalar_type() &&
+              output.sizes() == inputTensors[0].sizes(),
+          "Output tensors must match the input tensor in type and size and "
+          "reside on the same GPU device");
+    }
+  } else {
+    TORCH_CHECK(
+        outputTensors.size() == 0,
+        "Non-root ranks must not provide output tensors");
+  }
+
+  return collective(
+      inputTensors,
+      inputTensors,
+      [&](at::Tensor& input,
+          at::Tensor& /* unused */,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        const auto type = getNcclDataType(input.scalar_type());
+        // Every rank (including the root) sends its input; the root posts a
+        // matching receive per rank. All calls land in the surrounding NCCL
+        // group and fuse into a single launch.
+        C10D_NCCL_CHECK(ncclSend(
+            input.data_ptr(),
+            input.numel(),
+            type,
+            root,
+            comm,
+            stream.stream()));
+        if (rank_ == root) {
+          for (int r = 0; r < size_; r++) {
+            at::Tensor& output = outputTensors[0][r];
+            // See [Sync Streams].
+            c10::cuda::CUDACachingAllocator::recordStream(
+                output.storage().data_ptr(), stream);
+            C10D_NCCL_CHECK(ncclRecv(
+                output.data_ptr(),
+                output.numel(),
+                type,
+                r,
+                comm,
+                stream.stream()));
+          }
+        }
+        return ncclSuccess;
+      },
+      "gather");
+#else
+  throw std::runtime_error(
+      "ProcessGroupNCCL gather requires NCCL 2.7 or later");
+#endif
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::scatter(
-    std::vector<at::Tensor>& /* unused */,
-    std::vector<std::vector<at::Tensor>>& /* unused */,
-    const ScatterOptions& /* unused */) {
-  throw std::runtime_error("ProcessGroupNCCL does not support scatter");
+    std::vector<at::Tensor>& outputTensors,
+    std::vector<std::vector<at::Tensor>>& inputTensors,
+    const ScatterOptions& opts) {
+#ifdef ENABLE_NCCL_P2P_SUPPORT
+  check_gpu_tensors(outputTensors);
+  TORCH_CHECK(
+      outputTensors.size() == 1,
+      "ProcessGroupNCCL::scatter supports a single tensor per rank");
+
+  const auto root = opts.rootRank;
+  if (rank_ == root) {
+    TORCH_CHECK(
+        inputTensors.size() == 1 &&
+            inputTensors[0].size() == static_cast<size_t>(size_),
+        "The root rank must provide one input tensor per rank");
+    for (const auto& input : inputTensors[0]) {
+      TORCH_CHECK(
+          input.is_cuda() && !input.is_sparse() && input.is_contiguous() &&
+              input.get_device() == outputTensors[0].get_device() &&
+              input.scalar_type() == outputTensors[0].scalar_type() &&
+              input.sizes() == outputTensors[0].sizes(),
+          "Input tensors must match the output tensor in type and size and "
+          "reside on the same GPU device");
+    }
+  } else {
+    TORCH_CHECK(
+        inputTensors.size() == 0,
+        "Non-root ranks must not provide input tensors");
+  }
+
+  return collective(
+      outputTensors,
+      outputTensors,
+      [&](at::Tensor& output,
+          at::Tensor& /* unused */,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        const auto type = getNcclDataType(output.scalar_type());
+        // The root sends one tensor per rank; every rank (including the
+        // root) posts the matching receive. See gather above.
+        if (rank_ == root) {
+          for (int r = 0; r < size_; r++) {
+            at::Tensor& input = inputTensors[0][r];
+            // See [Sync Streams].
+            c10::cuda::CUDACachingAllocator::recordStream(
+                input.storage().data_ptr(), stream);
+            C10D_NCCL_CHECK(ncclSend(
+                input.data_ptr(),
+                input.numel(),
+                type,
+                r,
+                comm,
+                stream.stream()));
+          }
+        }
+        C10D_NCCL_CHECK(ncclRecv(
+            output.data_ptr(),
+            output.numel(),
+            type,
+            root,
+            comm,
+            stream.stream()));
+        return ncclSuccess;
+      },
+      "scatter");
+#else
+  throw std::runtime_error(
+      "ProcessGroupNCCL scatter requires NCCL 2.7 or later");
+#endif
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::send(
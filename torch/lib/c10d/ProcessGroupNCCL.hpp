@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -17,6 +18,18 @@ namespace c10d {
 // non-blocking.
 constexpr const char* NCCL_BLOCKING_WAIT = "NCCL_BLOCKING_WAIT";
 
+// Environment variable which, when set to 1, makes the process group pick its
+// NCCL streams from the high priority stream pool regardless of the
+// constructor argument. See the isHighPriorityStream constructor argument.
+constexpr const char* NCCL_HIGH_PRIORITY_STREAMS = "NCCL_HIGH_PRIORITY_STREAMS";
+
+// Environment variable which overrides the minimum tensor size, in bytes,
+// above which allreduce splits the tensor into chunks pipelined across two
+// internal communicator/stream pairs. Set to 0 to disable the chunked path.
+// Like all collective configuration, the value must be identical on every
+// rank of the process group.
+constexpr const char* NCCL_PIPELINE_THRESHOLD = "NCCL_PIPELINE_THRESHOLD";
+
 // ProcessGroupNCCL implements NCCL bindings for c10d.
 //
 // All functions of the class are expected to be called in the same order
@@ -103,6 +116,19 @@ class ProcessGroupNCCL : public ProcessGroup {
     // Time point representing when the work started.
     std::chrono::time_point<std::chrono::steady_clock> workStartTime_;
 
+    // Records the elapsed time since workStartTime_ and the bytes moved
+    // into the owning process group's metrics, the first time completion
+    // is observed. Timings are host-side observations from enqueue to
+    // observed completion, not GPU kernel durations, so they include any
+    // delay between the kernels finishing and the caller polling.
+    void maybeRecordMetrics();
+
+    // Aggregator owned by the ProcessGroupNCCL that created this work.
+    CollectiveMetrics* metrics_ = nullptr;
+    const char* opName_ = "";
+    int64_t bytes_ = 0;
+    bool metricsRecorded_ = false;
+
     // Wrapper method for the static checkForNCCLErrors which can be overridden
     // for tests.
     virtual std::exception_ptr checkForNCCLErrors(
@@ -140,12 +166,17 @@ class ProcessGroupNCCL : public ProcessGroup {
   // against a different set of devices, the process group creates another NCCL
   // communicator. These NCCL communicators are cached and reused if possible.
   //
+  // If `isHighPriorityStream` is true, the NCCL streams for this process
+  // group are taken from the high priority CUDA stream pool (see
+  // c10::cuda::getStreamFromPool), so communication kernels can preempt
+  // compute kernels and overlap with them instead of queueing behind them.
   ProcessGroupNCCL(
       const std::shared_ptr<Store>& store,
       int rank,
       int size,
       const std::chrono::milliseconds& opTimeout =
-          std::chrono::milliseconds(kProcessGroupNCCLOpTimeoutMillis));
+          std::chrono::milliseconds(kProcessGroupNCCLOpTimeoutMillis),
+      bool isHighPriorityStream = false);
 
   // This constructor includes the deprecated `groupName` argument.
   // If you have existing code that uses the `groupName`, you can replace
@@ -198,10 +229,21 @@ class ProcessGroupNCCL : public ProcessGroup {
       std::vector<std::vector<at::Tensor>>& inputTensors,
       const ReduceScatterOptions& opts = ReduceScatterOptions()) override;
 
+  std::shared_ptr<ProcessGroup::Work> alltoall_base(
+      at::Tensor& outputTensor,
+      at::Tensor& inputTensor,
+      std::vector<int64_t>& outputSplitSizes,
+      std::vector<int64_t>& inputSplitSizes,
+      const AllToAllOptions& opts = AllToAllOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> alltoall(
+      std::vector<at::Tensor>& outputTensors,
+      std::vector<at::Tensor>& inputTensors,
+      const AllToAllOptions& opts = AllToAllOptions()) override;
+
   std::shared_ptr<ProcessGroup::Work> barrier(
       const BarrierOptions& opts = BarrierOptions()) override;
 
-  // Unsupported Ops
   std::shared_ptr<ProcessGroup::Work> gather(
       std::vector<std::vector<at::Tensor>>& outputTensors,
       std::vector<at::Tensor>& inputTensors,
@@ -212,6 +254,7 @@ class ProcessGroupNCCL : public ProcessGroup {
       std::vector<std::vector<at::Tensor>>& inputTensors,
       const ScatterOptions& opts = ScatterOptions()) override;
 
+  // Unsupported Ops
   std::shared_ptr<ProcessGroup::Work> send(
       std::vector<at::Tensor>& tensors,
       int dstRank,
@@ -252,18 +295,31 @@ class ProcessGroupNCCL : public ProcessGroup {
   //    ncclResult_t fn(at::Tensor& input, at::Tensor& output,
   //                    ncclComm_t, at::cuda::CUDAStream&);
   //    void {pre,post}(std::vector<at::cuda::CUDAStream&>);
+  // `opName' keys the entry in getCollectiveMetrics() that the returned
+  // work item reports into on completion.
   template <typename Fn>
   std::shared_ptr<ProcessGroup::Work> collective(
       std::vector<at::Tensor>& input,
       std::vector<at::Tensor>& output,
-      Fn fn);
+      Fn fn,
+      const char* opName);
   template <typename Fn, typename PreProcess, typename PostProcess>
   std::shared_ptr<ProcessGroup::Work> collective(
       std::vector<at::Tensor>& input,
       std::vector<at::Tensor>& output,
       Fn fn,
       PreProcess pre,
-      PostProcess post);
+      PostProcess post,
+      const char* opName);
+
+  // Chunked variant of allreduce used for tensors of at least
+  // pipelineThresholdBytes_. The tensor is split into fixed-size chunks
+  // which alternate between two communicator/stream pairs, so a GB-scale
+  // bucket overlaps its own reduction phases instead of running as one
+  // monolithic, serialized NCCL call.
+  std::shared_ptr<ProcessGroup::Work> allreduceChunked(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts);
 
   // Checks for NCCL errors on each of the communicators and returns an
   // appropriate exception_ptr (nullptr if no errors).
@@ -372,6 +428,13 @@ class ProcessGroupNCCL : public ProcessGroup {
   // Timeout for operations. This is only used when blockingWait_ is enabled.
   std::chrono::milliseconds opTimeout_;
 
+  // Whether the NCCL streams are taken from the high priority pool.
+  bool isHighPriorityStream_ = false;
+
+  // Minimum tensor size, in bytes, for allreduce to take the chunked,
+  // dual-stream path; 0 disables it. See NCCL_PIPELINE_THRESHOLD.
+  size_t pipelineThresholdBytes_ = 128 * 1024 * 1024;
+
   // Set of communicators that this process group has aborted and their
   // ncclUniqueId has been written to the store. We don't need a lock
   // for this map since only the watchdog thread accesses this set. The
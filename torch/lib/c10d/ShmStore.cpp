@@ -0,0 +1,398 @@
+#include <c10d/ShmStore.hpp>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <system_error>
+#include <thread>
+
+#define SYSASSERT(rv, ...)                                                 \
+  if ((rv) < 0) {                                                          \
+    throw std::system_error(errno, std::system_category(), ##__VA_ARGS__); \
+  }
+
+namespace c10d {
+
+namespace detail {
+
+// Header of the shared memory segment, followed by the record log. Records
+// are appended under the writer lock; readers only load `writeOffset' with
+// acquire semantics and replay the log, so get()/check() never block a
+// writer. `generation' is bumped on every append and doubles as the futex
+// word that wait() blocks on.
+struct ShmStoreSegment {
+  std::atomic<uint32_t> initialized;
+  std::atomic<uint32_t> writerLock;
+  std::atomic<uint32_t> generation;
+  std::atomic<uint32_t> finished;
+  std::atomic<uint64_t> writeOffset;
+  uint64_t dataSize;
+};
+
+static_assert(
+    sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+        sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+    "ShmStore requires lock-free std::atomic over shared memory");
+
+} // namespace detail
+
+namespace {
+
+using detail::ShmStoreSegment;
+
+// Each log record is two length words followed by the key and value bytes.
+constexpr size_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+
+uint8_t* segmentData(ShmStoreSegment* segment) {
+  return reinterpret_cast<uint8_t*>(segment) + sizeof(ShmStoreSegment);
+}
+
+#ifdef __linux__
+
+int futex(
+    std::atomic<uint32_t>* uaddr,
+    int op,
+    uint32_t val,
+    const struct timespec* timeout) {
+  // Not FUTEX_PRIVATE: the word is shared between processes.
+  return syscall(
+      SYS_futex,
+      reinterpret_cast<uint32_t*>(uaddr),
+      op,
+      val,
+      timeout,
+      nullptr,
+      0);
+}
+
+// Blocks until `word' no longer holds `val', a wake arrives, or `timeout'
+// expires; kNoTimeout blocks indefinitely. Spurious returns are fine, all
+// callers re-check their condition in a loop.
+void futexWait(
+    std::atomic<uint32_t>* word,
+    uint32_t val,
+    std::chrono::milliseconds timeout) {
+  struct timespec ts;
+  struct timespec* tsp = nullptr;
+  if (timeout != c10d::Store::kNoTimeout) {
+    ts.tv_sec = timeout.count() / 1000;
+    ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+    tsp = &ts;
+  }
+  futex(word, FUTEX_WAIT, val, tsp);
+}
+
+void futexWakeAll(std::atomic<uint32_t>* word) {
+  futex(word, FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr);
+}
+
+#else
+
+// Portable fallback: poll instead of sleeping on a futex. The segment and
+// its atomics work the same way, only blocking degrades to a FileStore
+// style sleep loop.
+void futexWait(
+    std::atomic<uint32_t>* word,
+    uint32_t val,
+    std::chrono::milliseconds timeout) {
+  if (word->load(std::memory_order_acquire) != val) {
+    return;
+  }
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+void futexWakeAll(std::atomic<uint32_t>* word) {}
+
+#endif
+
+// Simple cross-process futex lock serializing writers. The store is not a
+// data-plane object, so an uncontended syscall-free fast path plus a wake
+// per unlock is plenty.
+void lockSegment(ShmStoreSegment* segment) {
+  uint32_t expected = 0;
+  while (!segment->writerLock.compare_exchange_weak(
+      expected, 1, std::memory_order_acquire)) {
+    futexWait(&segment->writerLock, 1, c10d::Store::kNoTimeout);
+    expected = 0;
+  }
+}
+
+void unlockSegment(ShmStoreSegment* segment) {
+  segment->writerLock.store(0, std::memory_order_release);
+  futexWakeAll(&segment->writerLock);
+}
+
+// RAII wrapper so appends unlock on exceptions (e.g. a full segment).
+struct SegmentLockGuard {
+  explicit SegmentLockGuard(ShmStoreSegment* segment) : segment_(segment) {
+    lockSegment(segment_);
+  }
+  ~SegmentLockGuard() {
+    unlockSegment(segment_);
+  }
+  ShmStoreSegment* segment_;
+};
+
+// Appends a record and publishes it via `writeOffset', waking all waiters
+// through the generation counter. The caller must hold the writer lock.
+void appendLocked(
+    ShmStoreSegment* segment,
+    const std::string& key,
+    const void* value,
+    size_t valueSize) {
+  const size_t offset = segment->writeOffset.load(std::memory_order_acquire);
+  const size_t recordSize = kRecordHeaderSize + key.size() + valueSize;
+  if (offset + recordSize > segment->dataSize) {
+    throw std::runtime_error(
+        "ShmStore: shared memory segment is full; construct the store "
+        "with a larger size");
+  }
+  uint8_t* record = segmentData(segment) + offset;
+  const uint32_t keyLen = key.size();
+  const uint32_t valueLen = valueSize;
+  memcpy(record, &keyLen, sizeof(keyLen));
+  memcpy(record + sizeof(keyLen), &valueLen, sizeof(valueLen));
+  memcpy(record + kRecordHeaderSize, key.data(), key.size());
+  memcpy(record + kRecordHeaderSize + key.size(), value, valueSize);
+  segment->writeOffset.store(offset + recordSize, std::memory_order_release);
+  segment->generation.fetch_add(1, std::memory_order_release);
+  futexWakeAll(&segment->generation);
+}
+
+void append(
+    ShmStoreSegment* segment,
+    const std::string& key,
+    const void* value,
+    size_t valueSize) {
+  SegmentLockGuard lock(segment);
+  appendLocked(segment, key, value, valueSize);
+}
+
+} // namespace
+
+constexpr size_t ShmStore::kDefaultSize;
+
+ShmStore::ShmStore(const std::string& name, int numWorkers, size_t size)
+    : Store(),
+      name_(name.empty() || name[0] != '/' ? "/" + name : name),
+      numWorkers_(numWorkers),
+      segment_(nullptr),
+      segmentSize_(sizeof(ShmStoreSegment) + size),
+      pos_(0) {
+  if (numWorkers_ < 1) {
+    throw std::runtime_error(
+        "Number of workers for ShmStore should be greater than zero");
+  }
+
+  // The first worker to create the segment sizes and initializes it; the
+  // others map it and wait for the `initialized' flag. O_EXCL makes the
+  // creator unambiguous.
+  int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  const bool creator = fd >= 0;
+  if (!creator) {
+    if (errno != EEXIST) {
+      SYSASSERT(fd, "shm_open(" + name_ + ")");
+    }
+    fd = shm_open(name_.c_str(), O_RDWR, 0600);
+    SYSASSERT(fd, "shm_open(" + name_ + ")");
+  } else {
+    auto rv = ftruncate(fd, segmentSize_);
+    SYSASSERT(rv, "ftruncate(" + name_ + ")");
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  if (!creator) {
+    // Wait until the creator's ftruncate took effect before mapping.
+    while (true) {
+      struct stat st;
+      auto rv = fstat(fd, &st);
+      SYSASSERT(rv, "fstat(" + name_ + ")");
+      if (static_cast<size_t>(st.st_size) >= segmentSize_) {
+        break;
+      }
+      const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::steady_clock::now() - start);
+      if (timeout_ != kNoTimeout && elapsed > timeout_) {
+        ::close(fd);
+        throw std::runtime_error(
+            "Timeout waiting for ShmStore segment: " + name_);
+      }
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  void* base =
+      mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    throw std::system_error(
+        errno, std::system_category(), "mmap(" + name_ + ")");
+  }
+  segment_ = static_cast<ShmStoreSegment*>(base);
+
+  if (creator) {
+    // The mapping starts zero-filled, so only the capacity needs to be
+    // written before publishing the segment.
+    segment_->dataSize = segmentSize_ - sizeof(ShmStoreSegment);
+    segment_->initialized.store(1, std::memory_order_release);
+    futexWakeAll(&segment_->initialized);
+  } else {
+    while (segment_->initialized.load(std::memory_order_acquire) == 0) {
+      const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::steady_clock::now() - start);
+      if (timeout_ != kNoTimeout && elapsed > timeout_) {
+        munmap(segment_, segmentSize_);
+        throw std::runtime_error(
+            "Timeout waiting for ShmStore segment: " + name_);
+      }
+      futexWait(&segment_->initialized, 0, std::chrono::milliseconds(10));
+    }
+    if (segment_->dataSize != segmentSize_ - sizeof(ShmStoreSegment)) {
+      munmap(segment_, segmentSize_);
+      throw std::runtime_error(
+          "ShmStore: all workers must pass the same size for " + name_);
+    }
+  }
+}
+
+ShmStore::~ShmStore() {
+  // The last worker unlinks the segment; the name can then be reused.
+  const auto finished =
+      segment_->finished.fetch_add(1, std::memory_order_acq_rel) + 1;
+  if (finished == static_cast<uint32_t>(numWorkers_)) {
+    shm_unlink(name_.c_str());
+  }
+  munmap(segment_, segmentSize_);
+}
+
+void ShmStore::set(const std::string& key, const std::vector<uint8_t>& value) {
+  std::unique_lock<std::mutex> l(activeShmOpLock_);
+  append(segment_, key, value.data(), value.size());
+}
+
+std::vector<uint8_t> ShmStore::get(const std::string& key) {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> l(activeShmOpLock_);
+  while (true) {
+    // The generation is sampled before replaying the log; an append racing
+    // with the replay changes it, so the wait below returns immediately
+    // instead of missing the update.
+    const auto gen = segment_->generation.load(std::memory_order_acquire);
+    refresh();
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      return it->second;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - start);
+    if (timeout_ != kNoTimeout && elapsed > timeout_) {
+      throw std::runtime_error("Timeout waiting for key: " + key);
+    }
+    // Release the process-local lock while blocked so another thread of
+    // this process can publish the key.
+    l.unlock();
+    futexWait(&segment_->generation, gen, timeout_);
+    l.lock();
+  }
+}
+
+int64_t ShmStore::addHelper(const std::string& key, int64_t i) {
+  // The writer lock spans the read-modify-write, so concurrent adds from
+  // other processes serialize on the segment, like FileStore's exclusive
+  // file lock.
+  SegmentLockGuard lock(segment_);
+  refresh();
+  int64_t ti = i;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    auto buf = reinterpret_cast<const char*>(it->second.data());
+    ti += std::stoll(std::string(buf, it->second.size()));
+  }
+  const auto str = std::to_string(ti);
+  appendLocked(segment_, key, str.data(), str.size());
+  return ti;
+}
+
+int64_t ShmStore::add(const std::string& key, int64_t i) {
+  std::unique_lock<std::mutex> l(activeShmOpLock_);
+  return addHelper(key, i);
+}
+
+bool ShmStore::check(const std::vector<std::string>& keys) {
+  std::unique_lock<std::mutex> l(activeShmOpLock_);
+  refresh();
+  for (const auto& key : keys) {
+    if (cache_.count(key) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShmStore::wait(const std::vector<std::string>& keys) {
+  wait(keys, timeout_);
+}
+
+void ShmStore::wait(
+    const std::vector<std::string>& keys,
+    const std::chrono::milliseconds& timeout) {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> l(activeShmOpLock_);
+  while (true) {
+    const auto gen = segment_->generation.load(std::memory_order_acquire);
+    refresh();
+    bool allPresent = true;
+    for (const auto& key : keys) {
+      if (cache_.count(key) == 0) {
+        allPresent = false;
+        break;
+      }
+    }
+    if (allPresent) {
+      return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - start);
+    if (timeout != kNoTimeout && elapsed > timeout) {
+      throw std::runtime_error("Wait timeout");
+    }
+    l.unlock();
+    futexWait(&segment_->generation, gen, timeout);
+    l.lock();
+  }
+}
+
+bool ShmStore::refresh() {
+  const size_t offset = segment_->writeOffset.load(std::memory_order_acquire);
+  if (offset == pos_) {
+    return false;
+  }
+  const uint8_t* data = segmentData(segment_);
+  while (pos_ < offset) {
+    uint32_t keyLen;
+    uint32_t valueLen;
+    memcpy(&keyLen, data + pos_, sizeof(keyLen));
+    memcpy(&valueLen, data + pos_ + sizeof(keyLen), sizeof(valueLen));
+    pos_ += kRecordHeaderSize;
+    std::string key(reinterpret_cast<const char*>(data + pos_), keyLen);
+    pos_ += keyLen;
+    cache_[key] = std::vector<uint8_t>(data + pos_, data + pos_ + valueLen);
+    pos_ += valueLen;
+  }
+  return true;
+}
+
+} // namespace c10d
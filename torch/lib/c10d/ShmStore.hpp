@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include <c10d/Store.hpp>
+
+namespace c10d {
+
+namespace detail {
+struct ShmStoreSegment;
+} // namespace detail
+
+// Store backed by a POSIX shared memory segment, for the common case where
+// all workers run on a single host. Keys and values are appended to a log in
+// the segment; readers replay the log into a process-local cache without
+// taking any lock, and wait() blocks on a generation counter (a futex on
+// Linux) instead of polling the filesystem like FileStore or round-tripping
+// through loopback like TCPStore.
+//
+// Like FileStore, the store is append-only: set() on an existing key appends
+// a new record which shadows the old one. All workers must pass the same
+// `name' and `numWorkers'; the last worker to be destructed unlinks the
+// segment.
+class ShmStore : public Store {
+ public:
+  // Default capacity of the value log. Rendezvous traffic is a handful of
+  // small records per rank, so this leaves ample headroom.
+  static constexpr size_t kDefaultSize = 4 * 1024 * 1024;
+
+  explicit ShmStore(
+      const std::string& name,
+      int numWorkers,
+      size_t size = kDefaultSize);
+
+  virtual ~ShmStore();
+
+  void set(const std::string& key, const std::vector<uint8_t>& value) override;
+
+  std::vector<uint8_t> get(const std::string& key) override;
+
+  int64_t add(const std::string& key, int64_t value) override;
+
+  bool check(const std::vector<std::string>& keys) override;
+
+  void wait(const std::vector<std::string>& keys) override;
+
+  void wait(
+      const std::vector<std::string>& keys,
+      const std::chrono::milliseconds& timeout) override;
+
+ protected:
+  int64_t addHelper(const std::string& key, int64_t i);
+
+  // Replays new log records into cache_ and returns true if any were found.
+  bool refresh();
+
+  std::string name_;
+  int numWorkers_;
+
+  detail::ShmStoreSegment* segment_;
+  size_t segmentSize_;
+
+  // Log offset up to which cache_ is current.
+  size_t pos_;
+  std::unordered_map<std::string, std::vector<uint8_t>> cache_;
+
+  // Serializes segment access between threads of this process; cross-process
+  // writers are serialized by the lock word in the segment itself.
+  std::mutex activeShmOpLock_;
+};
+
+} // namespace c10d
@@ -2,8 +2,13 @@
 
 #include <poll.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include <unistd.h>
 #include <algorithm>
+#include <array>
 #include <system_error>
 
 namespace c10d {
@@ -54,6 +59,100 @@ void TCPStoreDaemon::join() {
   daemonThread_.join();
 }
 
+#ifdef __linux__
+
+// On Linux the daemon multiplexes its connections with epoll(7). With
+// poll(2), every wakeup rescans the entire descriptor set, so servicing
+// a rendezvous with thousands of workers costs O(connections) for every
+// single query; epoll wakeups only visit the connections that are
+// actually ready.
+void TCPStoreDaemon::run() {
+  int epollFd;
+  SYSCHECK_ERR_RETURN_NEG1(epollFd = ::epoll_create1(0));
+
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.fd = storeListenSocket_;
+  SYSCHECK_ERR_RETURN_NEG1(
+      ::epoll_ctl(epollFd, EPOLL_CTL_ADD, storeListenSocket_, &ev));
+
+  // Register the read end of the pipe that signals the stopping of the
+  // daemon run; it reports EPOLLHUP (always reported, no need to ask for
+  // it) when the write end is closed.
+  ev.events = 0;
+  ev.data.fd = controlPipeFd_[0];
+  SYSCHECK_ERR_RETURN_NEG1(
+      ::epoll_ctl(epollFd, EPOLL_CTL_ADD, controlPipeFd_[0], &ev));
+
+  // receive the queries
+  std::array<struct epoll_event, 64> events;
+  bool finished = false;
+  while (!finished) {
+    int nfds;
+    SYSCHECK_ERR_RETURN_NEG1(
+        nfds = ::epoll_wait(epollFd, events.data(), events.size(), -1));
+
+    for (int i = 0; i < nfds; i++) {
+      const int fd = events[i].data.fd;
+
+      // TCPStore's listening socket has an event and it should now be
+      // able to accept new connections.
+      if (fd == storeListenSocket_) {
+        if (events[i].events ^ EPOLLIN) {
+          throw std::system_error(
+              ECONNABORTED,
+              std::system_category(),
+              "Unexpected epoll event on the master's listening socket: " +
+                  std::to_string(events[i].events));
+        }
+        int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
+        sockets_.push_back(sockFd);
+        struct epoll_event workerEv = {};
+        workerEv.events = EPOLLIN;
+        workerEv.data.fd = sockFd;
+        SYSCHECK_ERR_RETURN_NEG1(
+            ::epoll_ctl(epollFd, EPOLL_CTL_ADD, sockFd, &workerEv));
+
+        // The pipe receives an event which tells us to shutdown the daemon
+      } else if (fd == controlPipeFd_[0]) {
+        // Will be EPOLLHUP when the pipe is closed
+        if (events[i].events ^ EPOLLHUP) {
+          throw std::system_error(
+              ECONNABORTED,
+              std::system_category(),
+              "Unexpected epoll event on the control pipe's reading fd: " +
+                  std::to_string(events[i].events));
+        }
+        finished = true;
+        break;
+
+        // Otherwise one of the worker connections has a query for us
+      } else {
+        try {
+          query(fd);
+        } catch (...) {
+          // There was an error when processing query. Probably an exception
+          // occurred in recv/send what would indicate that socket on the
+          // other side has been closed. If the closing was due to normal
+          // exit, then the store should continue executing. Otherwise, if
+          // it was different exception, other connections will get an
+          // exception once they try to use the store. We will go ahead and
+          // close this connection whenever we hit an exception here.
+          //
+          // Closing the descriptor also removes it from the epoll set.
+          ::close(fd);
+          clearSocketWaitState(fd);
+          sockets_.erase(std::find(sockets_.begin(), sockets_.end(), fd));
+        }
+      }
+    }
+  }
+
+  ::close(epollFd);
+}
+
+#else
+
 void TCPStoreDaemon::run() {
   std::vector<struct pollfd> fds;
   fds.push_back({.fd = storeListenSocket_, .events = POLLIN});
@@ -116,29 +215,8 @@ void TCPStoreDaemon::run() {
         // use the store. We will go ahead and close this connection whenever
         // we hit an exception here.
         ::close(fds[fdIdx].fd);
+        clearSocketWaitState(fds[fdIdx].fd);
 
-        // Remove all the tracking state of the close FD
-        for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-          for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-            if (*vecIt == fds[fdIdx].fd) {
-              vecIt = it->second.erase(vecIt);
-            } else {
-              ++vecIt;
-            }
-          }
-          if (it->second.size() == 0) {
-            it = waitingSockets_.erase(it);
-          } else {
-            ++it;
-          }
-        }
-        for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-          if (it->first == fds[fdIdx].fd) {
-            it = keysAwaited_.erase(it);
-          } else {
-            ++it;
-          }
-        }
         fds.erase(fds.begin() + fdIdx);
         sockets_.erase(sockets_.begin() + fdIdx - 2);
         --fdIdx;
@@ -148,6 +226,33 @@ void TCPStoreDaemon::run() {
   }
 }
 
+#endif
+
+void TCPStoreDaemon::clearSocketWaitState(int socket) {
+  // Remove all the tracking state of the closed socket
+  for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
+    for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+      if (*vecIt == socket) {
+        vecIt = it->second.erase(vecIt);
+      } else {
+        ++vecIt;
+      }
+    }
+    if (it->second.size() == 0) {
+      it = waitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
+    if (it->first == socket) {
+      it = keysAwaited_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void TCPStoreDaemon::stop() {
   if (controlPipeFd_[1] != -1) {
     // close the write end of the pipe
@@ -30,6 +30,8 @@ class TCPStoreDaemon {
 
   bool checkKeys(const std::vector<std::string>& keys) const;
   void wakeupWaitingClients(const std::string& key);
+  // Drops the wait-tracking state of a closed connection.
+  void clearSocketWaitState(int socket);
 
   std::thread daemonThread_;
   std::unordered_map<std::string, std::vector<uint8_t>> tcpStore_;
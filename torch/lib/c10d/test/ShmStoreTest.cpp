@@ -0,0 +1,88 @@
+#include <c10d/test/StoreTestCommon.hpp>
+
+#include <unistd.h>
+
+#include <iostream>
+#include <thread>
+
+#include <c10d/PrefixStore.hpp>
+#include <c10d/ShmStore.hpp>
+
+std::string tmpname() {
+  // Unique per process so concurrent test runs don't collide.
+  return "c10d-test-" + std::to_string(getpid());
+}
+
+void testHelper(const std::string prefix = "") {
+  const auto name = tmpname();
+  std::cout << "Using shared memory segment: " << name << std::endl;
+
+  const auto numThreads = 4;
+
+  // All instances below share one segment; the segment is unlinked when the
+  // last of them is destructed.
+  const auto numWorkers = numThreads + 2;
+
+  // Basic set/get
+  {
+    auto shmStore = std::make_shared<c10d::ShmStore>(name, numWorkers);
+    c10d::PrefixStore store(prefix, shmStore);
+    c10d::test::set(store, "key0", "value0");
+    c10d::test::set(store, "key1", "value1");
+    c10d::test::set(store, "key2", "value2");
+    c10d::test::check(store, "key0", "value0");
+    c10d::test::check(store, "key1", "value1");
+    c10d::test::check(store, "key2", "value2");
+
+    // Get on a new instance replays the log written by the first one
+    {
+      auto shmStore2 = std::make_shared<c10d::ShmStore>(name, numWorkers);
+      c10d::PrefixStore store2(prefix, shmStore2);
+      c10d::test::check(store2, "key0", "value0");
+    }
+
+    // Hammer on ShmStore#add
+    std::vector<std::thread> threads;
+    const auto numIterations = 100;
+    c10d::test::Semaphore sem1, sem2;
+    for (auto i = 0; i < numThreads; i++) {
+      threads.push_back(std::thread([&] {
+        auto threadStore = std::make_shared<c10d::ShmStore>(name, numWorkers);
+        c10d::PrefixStore store(prefix, threadStore);
+        sem1.post();
+        sem2.wait();
+        for (auto j = 0; j < numIterations; j++) {
+          store.add("counter", 1);
+        }
+      }));
+    }
+    sem1.wait(numThreads);
+    sem2.post(numThreads);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Check that the counter has the expected value
+    {
+      std::string expected = std::to_string(numThreads * numIterations);
+      c10d::test::check(store, "counter", expected);
+    }
+
+    // wait() blocks until another instance publishes the key
+    {
+      std::thread waiter([&] {
+        store.wait({"published"});
+        c10d::test::check(store, "published", "yes");
+      });
+      c10d::test::set(store, "published", "yes");
+      waiter.join();
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  testHelper();
+  testHelper("testPrefix");
+  std::cout << "Test succeeded" << std::endl;
+  return 0;
+}
@@ -2352,6 +2352,13 @@ def cross_entropy(input, target, weight=None, size_average=None, ignore_index=-1
                 reduction=reduction)
     if size_average is not None or reduce is not None:
         reduction = _Reduction.legacy_get_string(size_average, reduce)
+    if input.dim() == 2 and target.dim() == 1 and input.device.type == 'cpu' and \
+            (input.dtype == torch.float32 or input.dtype == torch.float64) and \
+            (weight is None or weight.dtype == input.dtype):
+        # Fused kernel: computes the log_softmax normalizer and gathers the
+        # target logit in a single pass, without materializing log_softmax.
+        return torch._cross_entropy_loss(input, target, weight,
+                                         _Reduction.get_enum(reduction), ignore_index)
     return nll_loss(log_softmax(input, 1), target, weight, None, ignore_index, None, reduction)
 
 
@@ -443,7 +443,36 @@ class Module(object):
                 raise TypeError('nn.Module.to only accepts floating point '
                                 'dtypes, but got desired dtype={}'.format(dtype))
 
+        # Moving to a CUDA device one tensor at a time is dominated by
+        # per-copy launch latency for models with many small parameters, so
+        # batch the dense CPU tensors that need a plain device copy through
+        # pinned staging buffers up front; convert() below picks up the
+        # precomputed results and falls back to Tensor.to for the rest.
+        prestaged = {}
+        if device is not None and device.type == 'cuda' and torch.cuda.is_available():
+            candidates = []
+            for param in self.parameters():
+                candidates.append(param)
+                if param.grad is not None:
+                    candidates.append(param.grad)
+            candidates.extend(self.buffers())
+            eligible = [
+                t for t in candidates
+                if t.device.type == 'cpu' and not t.is_sparse and
+                not t.is_quantized and not t.is_pinned() and
+                not (dtype is not None and t.is_floating_point()) and
+                not (convert_to_format is not None and t.dim() == 4)
+            ]
+            if len(eligible) > 1:
+                with torch.no_grad():
+                    copies = torch._utils._batch_copy_to_device(
+                        eligible, device, non_blocking)
+                prestaged = {id(t): copy for t, copy in zip(eligible, copies)}
+
         def convert(t):
+            copied = prestaged.get(id(t))
+            if copied is not None:
+                return copied
             if convert_to_format is not None and t.dim() == 4:
                 return t.to(device, dtype if t.is_floating_point() else None, non_blocking, memory_format=convert_to_format)
             return t.to(device, dtype if t.is_floating_point() else None, non_blocking)
@@ -217,6 +217,14 @@ class DistributedDataParallel(Module):
                          are getting different gradients, which should not
                          happen if DistributedDataParallel is correctly used.
                          (default: ``False``)
+        gradient_as_bucket_view (bool): when setting to ``True``, gradients
+                      will be views pointing to different offsets of
+                      allreduce communication buckets. This can reduce peak
+                      memory usage, and it also skips the copy between
+                      gradients and communication buckets after every
+                      backward pass. When gradients are views,
+                      ``detach_()`` cannot be called on the gradients.
+                      (default: ``False``)
 
     Attributes:
         module (Module): the module to be parallelized
@@ -230,7 +238,8 @@ class DistributedDataParallel(Module):
                  output_device=None, dim=0, broadcast_buffers=True,
                  process_group=None, bucket_cap_mb=25,
                  find_unused_parameters=False,
-                 check_reduction=False):
+                 check_reduction=False,
+                 gradient_as_bucket_view=False):
 
         super(DistributedDataParallel, self).__init__()
 
@@ -280,6 +289,7 @@ class DistributedDataParallel(Module):
         self.find_unused_parameters = find_unused_parameters
         self.require_backward_grad_sync = True
         self.require_forward_param_sync = True
+        self.gradient_as_bucket_view = gradient_as_bucket_view
 
         if check_reduction:
             # This argument is no longer used since the reducer
@@ -379,7 +389,8 @@ class DistributedDataParallel(Module):
             parameters,
             list(reversed(bucket_indices)),
             self.process_group,
-            expect_sparse_gradient)
+            expect_sparse_gradient,
+            self.gradient_as_bucket_view)
 
         # passing a handle to torch.nn.SyncBatchNorm layer
         self._passing_sync_batchnorm_handle(self._module_copies)
@@ -397,6 +408,7 @@ class DistributedDataParallel(Module):
         super(DistributedDataParallel, self).__setstate__(state)
         self.__dict__.setdefault('require_forward_param_sync', True)
         self.__dict__.setdefault('require_backward_grad_sync', True)
+        self.__dict__.setdefault('gradient_as_bucket_view', False)
         self._ddp_init_helper()
 
     def _check_default_group(self):
@@ -1,8 +1,9 @@
 
 from .linear import Linear
-from .rnn import LSTM
+from .rnn import LSTM, GRU
 
 __all__ = [
     'Linear',
     'LSTM',
+    'GRU',
 ]
@@ -315,6 +315,67 @@ def pad_packed_sequence(sequence, batch_first=False, padding_value=0.0, total_le
     return padded_output, lengths
 
 
+def pack_ragged_sequence(input, lengths, batch_first=False):
+    # type: (Tensor, Tensor, bool) -> Tuple[Tensor, Tensor]
+    r"""Packs a Tensor containing padded sequences into a ragged batch.
+
+    Returns a tuple of ``(data, offsets)``. ``data`` holds the real (non-pad)
+    tokens of every sequence back to back in batch order: the tokens of
+    sequence ``b`` occupy rows ``offsets[b]:offsets[b + 1]``, and ``offsets``
+    is a CPU int64 tensor of size ``B + 1``.
+
+    Unlike :func:`pack_padded_sequence`, the layout is batch-major and the
+    lengths do not need to be sorted, so the result is meant for non-recurrent
+    sequence models: token-wise modules (:class:`~torch.nn.Linear`, embedding
+    lookups, pointwise activations) can be applied to ``data`` directly,
+    computing only on real tokens, and per-sequence softmax over ragged scores
+    is available as ``torch._ragged_softmax(scores, offsets)``.
+
+    Arguments:
+        input (Tensor): padded batch of variable length sequences, of size
+            ``T x B x *`` (or ``B x T x *`` if :attr:`batch_first` is ``True``).
+        lengths (Tensor): list of sequence lengths of each batch element.
+        batch_first (bool, optional): if ``True``, the input is expected in
+            ``B x T x *`` format.
+
+    Returns:
+        Tuple of the packed ``data`` Tensor and the ``offsets`` Tensor.
+    """
+    lengths = torch.as_tensor(lengths, dtype=torch.int64)
+    return _VF._pack_ragged_sequence(input, lengths, batch_first)
+
+
+def pad_ragged_sequence(data, offsets, batch_first=False, padding_value=0.0, total_length=None):
+    # type: (Tensor, Tensor, bool, float, Optional[int]) -> Tuple[Tensor, Tensor]
+    r"""Pads a ragged batch of variable length sequences.
+
+    It is an inverse operation to :func:`pack_ragged_sequence`.
+
+    The returned Tensor's data will be of size ``T x B x *``, where `T` is the
+    length of the longest sequence and `B` is the batch size. If
+    ``batch_first`` is True, the data will be transposed into ``B x T x *``
+    format.
+
+    Arguments:
+        data (Tensor): the packed tokens, as returned by
+            :func:`pack_ragged_sequence`.
+        offsets (Tensor): CPU int64 tensor of size ``B + 1`` with the exclusive
+            prefix sum of the sequence lengths.
+        batch_first (bool, optional): if ``True``, the output will be in
+            ``B x T x *`` format.
+        padding_value (float, optional): values for padded elements.
+        total_length (int, optional): if not ``None``, the output will be padded to
+            have length :attr:`total_length`.
+
+    Returns:
+        Tuple of Tensor containing the padded sequence, and a Tensor
+        containing the list of lengths of each sequence in the batch.
+    """
+    if total_length is None:
+        total_length = -1
+    return _VF._pad_ragged_sequence(data, offsets, batch_first, padding_value, total_length)
+
+
 def pad_sequence(sequences, batch_first=False, padding_value=0):
     r"""Pad a list of variable length Tensors with ``padding_value``
 
@@ -12,9 +12,9 @@ from torch._utils import ExceptionWrapper
 
 
 def _pin_memory_loop(in_queue, out_queue, device_id, done_event):
-    # This setting is thread local, and prevents the copy in pin_memory from
-    # consuming all CPU cores.
-    torch.set_num_threads(1)
+    # This setting is thread local. A small pool is enough to overlap the pin
+    # copies of one sample's tensors without starving the training threads.
+    torch.set_num_threads(min(4, torch.get_num_threads()))
 
     torch.cuda.set_device(device_id)
 
@@ -42,6 +42,26 @@ def _pin_memory_loop(in_queue, out_queue, device_id, done_event):
         del r  # save memory
 
 
+_pin_memory_executor = None
+
+
+def pin_memory_async(data):
+    r"""Pins ``data`` on a background thread and returns a
+    :class:`concurrent.futures.Future` whose ``result()`` is the pinned
+    sample.
+
+    Lets a hand-rolled input pipeline overlap pinning of one sample with CPU
+    work (decoding, augmentation) on the next instead of serializing on the
+    pin copy. A single worker is enough because :func:`pin_memory` already
+    spreads the copies of one sample over the intra-op thread pool.
+    """
+    global _pin_memory_executor
+    if _pin_memory_executor is None:
+        from concurrent.futures import ThreadPoolExecutor
+        _pin_memory_executor = ThreadPoolExecutor(max_workers=1)
+    return _pin_memory_executor.submit(pin_memory, data)
+
+
 def pin_memory(data):
     if isinstance(data, torch.Tensor):
         return data.pin_memory()
@@ -50,8 +70,15 @@ def pin_memory(data):
     elif isinstance(data, container_abcs.Mapping):
         return {k: pin_memory(sample) for k, sample in data.items()}
     elif isinstance(data, tuple) and hasattr(data, '_fields'):  # namedtuple
+        if data and all(isinstance(sample, torch.Tensor) for sample in data):
+            return type(data)(*torch._pin_memory_batch(list(data)))
         return type(data)(*(pin_memory(sample) for sample in data))
     elif isinstance(data, container_abcs.Sequence):
+        # The common case of a sample that is a sequence of tensors is pinned
+        # in a single batched call, so the copies share one pass over the
+        # thread pool.
+        if data and all(isinstance(sample, torch.Tensor) for sample in data):
+            return list(torch._pin_memory_batch(list(data)))
         return [pin_memory(sample) for sample in data]
     elif hasattr(data, "pin_memory"):
         return data.pin_memory()